@@ -0,0 +1,263 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "RDF.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/chemistry/Atom.h>
+#ifndef INTER_NOPAIR
+#include <ddMd/potentials/pair/PairPotential.h>
+#endif
+#include <ddMd/neighbor/CellList.h>
+#include <ddMd/neighbor/Cell.h>
+#include <util/boundary/Boundary.h>
+#include <util/space/Vector.h>
+#include <util/math/feq.h>
+#include <util/misc/ioUtil.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   RDF::RDF(Simulation& simulation)
+    : Analyzer(simulation),
+      outputFile_(),
+      accumulator_(),
+      histogram_(),
+      max_(1.0),
+      normSum_(0.0),
+      nBin_(1),
+      atom1TypeId_(-1),
+      atom2TypeId_(-1),
+      isInitialized_(false)
+   {  setClassName("RDF"); }
+
+   /*
+   * Destructor.
+   */
+   RDF::~RDF()
+   {}
+
+   /*
+   * Read parameters from file, and allocate histograms.
+   */
+   void RDF::readParameters(std::istream& in)
+   {
+      readInterval(in);
+      readOutputFileName(in);
+      read<double>(in, "max", max_);
+      read<int>(in, "nBin", nBin_);
+      read<int>(in, "atom1TypeId", atom1TypeId_);
+      read<int>(in, "atom2TypeId", atom2TypeId_);
+
+      #ifdef INTER_NOPAIR
+      UTIL_THROW("RDF requires a pair potential");
+      #else
+      if (max_ > simulation().pairPotential().maxPairCutoff()) {
+         UTIL_THROW("RDF max exceeds the maximum pair potential cutoff");
+      }
+      #endif
+      accumulator_.setParam(max_, nBin_);
+      histogram_.setParam(0.0, max_, nBin_);
+      normSum_ = 0.0;
+
+      isInitialized_ = true;
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void RDF::loadParameters(Serializable::IArchive &ar)
+   {
+      loadInterval(ar);
+      loadOutputFileName(ar);
+      loadParameter<double>(ar, "max", max_);
+      loadParameter<int>(ar, "nBin", nBin_);
+      loadParameter<int>(ar, "atom1TypeId", atom1TypeId_);
+      loadParameter<int>(ar, "atom2TypeId", atom2TypeId_);
+
+      #ifdef INTER_NOPAIR
+      UTIL_THROW("RDF requires a pair potential");
+      #else
+      if (max_ > simulation().pairPotential().maxPairCutoff()) {
+         UTIL_THROW("RDF max exceeds the maximum pair potential cutoff");
+      }
+      #endif
+      histogram_.setParam(0.0, max_, nBin_);
+
+      // Load accumulators that are used only on master
+      if (simulation().domain().isMaster()) {
+         ar >> accumulator_;
+         ar >> normSum_;
+         if (nBin_ != accumulator_.nBin()) {
+            UTIL_THROW("Inconsistent nBin values");
+         }
+         if (!feq(max_, accumulator_.max())) {
+            UTIL_THROW("Inconsistent max values");
+         }
+      } else {
+         accumulator_.setParam(max_, nBin_);
+         normSum_ = 0.0;
+      }
+
+      isInitialized_ = true;
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void RDF::save(Serializable::OArchive &ar)
+   {
+      saveInterval(ar);
+      saveOutputFileName(ar);
+      ar << max_;
+      ar << nBin_;
+      ar << atom1TypeId_;
+      ar << atom2TypeId_;
+      ar << accumulator_;
+      ar << normSum_;
+   }
+
+   /*
+   * Clear accumulator.
+   */
+   void RDF::clear()
+   {
+      if (!isInitialized_) {
+         UTIL_THROW("Error: object is not initialized");
+      }
+      accumulator_.clear();
+      histogram_.clear();
+      normSum_ = 0.0;
+   }
+
+   /*
+   * Add pairs to histogram.
+   */
+   void RDF::sample(long iStep)
+   {
+      if (!isAtInterval(iStep))  {
+         UTIL_THROW("Time step index not a multiple of interval");
+      }
+
+      #ifndef INTER_NOPAIR
+      // Iterate over local cells of the pair potential cell list. Pairs of
+      // local atoms, and pairs found only by this processor when reverse
+      // communication is enabled, are owned by this processor. Otherwise,
+      // a local-ghost pair is found by both processors, and is owned by
+      // the processor with the lower atom id.
+      const CellList& cellList = simulation().pairPotential().cellList();
+      bool reverseUpdateFlag = simulation().reverseUpdateFlag();
+      double maxSq = max_*max_;
+      Cell::NeighborArray neighbors;
+      Vector dr;
+      double dRsq;
+      const Cell* cellPtr;
+      Atom* atomPtr0;
+      Atom* atomPtr1;
+      int na, nn, i, j;
+
+      histogram_.clear();
+      cellPtr = cellList.begin();
+      while (cellPtr) {
+         cellPtr->getNeighbors(neighbors, reverseUpdateFlag);
+         na = cellPtr->nAtom();
+         nn = neighbors.size();
+         for (i = 0; i < na; ++i) {
+            atomPtr0 = neighbors[i]->ptr();
+
+            // Loop over atoms in this cell
+            for (j = 0; j < na; ++j) {
+               atomPtr1 = neighbors[j]->ptr();
+               if (atomPtr1 > atomPtr0) {
+                  dr.subtract(atomPtr0->position(), atomPtr1->position());
+                  dRsq = dr.square();
+                  if (dRsq < maxSq) {
+                     samplePair(*atomPtr0, *atomPtr1, dRsq);
+                  }
+               }
+            }
+
+            // Loop over atoms in neighboring cells
+            for (j = na; j < nn; ++j) {
+               atomPtr1 = neighbors[j]->ptr();
+               if (!reverseUpdateFlag && atomPtr1->isGhost()) {
+                  if (atomPtr1->id() <= atomPtr0->id()) continue;
+               }
+               dr.subtract(atomPtr0->position(), atomPtr1->position());
+               dRsq = dr.square();
+               if (dRsq < maxSq) {
+                  samplePair(*atomPtr0, *atomPtr1, dRsq);
+               }
+            }
+
+         }
+         cellPtr = cellPtr->nextCellPtr();
+      }
+      #endif
+
+      // Add histograms from all processors on the master
+      #ifdef UTIL_MPI
+      histogram_.reduce(simulation().domain().communicator(), 0);
+      simulation().atomStorage().computeNAtomTotal(
+                                  simulation().domain().communicator());
+      #endif
+
+      if (simulation().domain().isMaster()) {
+         accumulator_.beginSnapshot();
+         accumulator_.add(histogram_);
+         double number = double(simulation().atomStorage().nAtomTotal());
+         normSum_ += number*number/simulation().boundary().volume();
+      }
+   }
+
+   /*
+   * Add a pair to the histogram once for each order that matches.
+   */
+   void RDF::samplePair(const Atom& atom1, const Atom& atom2, double dRsq)
+   {
+      double dR = sqrt(dRsq);
+      int type1 = atom1.typeId();
+      int type2 = atom2.typeId();
+      if (atom1TypeId_ < 0 || type1 == atom1TypeId_) {
+         if (atom2TypeId_ < 0 || type2 == atom2TypeId_) {
+            histogram_.sample(dR);
+         }
+      }
+      if (atom1TypeId_ < 0 || type2 == atom1TypeId_) {
+         if (atom2TypeId_ < 0 || type1 == atom2TypeId_) {
+            histogram_.sample(dR);
+         }
+      }
+   }
+
+   /*
+   * Output results to file after simulation is completed.
+   */
+   void RDF::output()
+   {
+      if (simulation().domain().isMaster()) {
+         simulation().fileMaster().openOutputFile(outputFileName(".prm"),
+                                                  outputFile_);
+         writeParam(outputFile_);
+         outputFile_.close();
+
+         simulation().fileMaster().openOutputFile(outputFileName(".dat"),
+                                                  outputFile_);
+         double nSnapshot = double(accumulator_.nSnapshot());
+         accumulator_.setNorm(normSum_/nSnapshot);
+         accumulator_.setOutputIntegral(true);
+         accumulator_.output(outputFile_);
+         outputFile_.close();
+      }
+   }
+
+}
@@ -0,0 +1,151 @@
+#ifndef DDMD_RDF_H
+#define DDMD_RDF_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/analyzers/Analyzer.h>
+#include <ddMd/simulation/Simulation.h>
+#include <util/accumulators/RadialDistribution.h>  // member
+#include <util/accumulators/Distribution.h>        // member
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   class Atom;
+
+   /**
+   * RDF evaluates an atomic radial distribution function.
+   *
+   * Pairs are found by iterating over the cell list of the pair potential,
+   * which contains local and ghost atoms. Each processor makes a histogram
+   * of the pairs that it owns, and these histograms are added on the
+   * master processor. The cost of each sample is thus of order N/P for N
+   * atoms on P processors. Because ghost atoms exist only within the pair
+   * list cutoff of each domain, the maximum radius must not exceed the
+   * maximum pair potential cutoff.
+   *
+   * Pairs may be selected by the types of the two atoms. The histogram
+   * and its normalization are the same as those of McMd::RDF, with a
+   * PairSelector that accepts all intra- and inter-molecular pairs.
+   *
+   * \sa \ref ddMd_analyzer_RDF_page "param file format"
+   *
+   * \ingroup DdMd_Analyzer_Scattering_Module
+   */
+   class RDF : public Analyzer
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param simulation parent Simulation object.
+      */
+      RDF(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      virtual ~RDF();
+
+      /**
+      * Read parameters from file.
+      *
+      * \param in input parameter file
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Clear accumulator.
+      */
+      virtual void clear();
+
+      /**
+      * Add pairs to histogram (call on all processors).
+      *
+      * \param iStep MD step index
+      */
+      virtual void sample(long iStep);
+
+      /**
+      * Output results to file (master only).
+      */
+      virtual void output();
+
+      /**
+      * Get the RadialDistribution accumulator (valid only on master).
+      */
+      const RadialDistribution& accumulator() const;
+
+   private:
+
+      /// Output file stream.
+      std::ofstream  outputFile_;
+
+      /// Accumulator, with histogram summed over processors (master).
+      RadialDistribution  accumulator_;
+
+      /// Histogram of pairs owned by this processor in one sample.
+      Distribution  histogram_;
+
+      /// Maximum radius in histogram.
+      double  max_;
+
+      /// Sum of snapshot values of N*N/V (master).
+      double  normSum_;
+
+      /// Number of bins in histogram.
+      int  nBin_;
+
+      /// Type of atom 1 (-1 to accept all types).
+      int  atom1TypeId_;
+
+      /// Type of atom 2 (-1 to accept all types).
+      int  atom2TypeId_;
+
+      /// Has readParam or loadParam been called?
+      bool  isInitialized_;
+
+      /**
+      * Add a pair to the histogram once for each order that matches.
+      *
+      * \param atom1  first atom
+      * \param atom2  second atom
+      * \param dRsq  square of separation
+      */
+      void samplePair(const Atom& atom1, const Atom& atom2, double dRsq);
+
+   };
+
+   // Inline member function
+
+   /*
+   * Get the RadialDistribution accumulator.
+   */
+   inline const RadialDistribution& RDF::accumulator() const
+   {  return accumulator_; }
+
+}
+#endif
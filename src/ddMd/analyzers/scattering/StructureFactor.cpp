@@ -16,6 +16,7 @@
 #include <util/space/Dimension.h>
 #include <util/space/IntVector.h>
 #include <util/misc/ioUtil.h>
+#include <util/misc/Log.h>
 #include <util/mpi/MpiLoader.h>
 #include <util/format/Int.h>
 #include <util/format/Dbl.h>
@@ -29,7 +30,11 @@ namespace DdMd
    StructureFactor::StructureFactor(Simulation& simulation) 
     : Analyzer(simulation),
       isInitialized_(false),
-      isFirstStep_(true)
+      isFirstStep_(true),
+      mesh_(),
+      meshDimensions_(0),
+      meshOrder_(0),
+      hasMesh_(false)
    {  setClassName("StructureFactor"); }
 
    StructureFactor::~StructureFactor() 
@@ -63,6 +68,8 @@ namespace DdMd
          }
       }
 
+      readMesh(in);
+
       isInitialized_ = true;
    }
 
@@ -98,6 +105,8 @@ namespace DdMd
       fourierModes_.allocate(nWave_, nMode_);
       totalFourierModes_.allocate(nWave_, nMode_);
 
+      loadMesh(ar);
+
       isInitialized_ = true;
    }
 
@@ -114,6 +123,62 @@ namespace DdMd
       ar << waveIntVectors_;
       ar << nSample_;
       ar << structureFactors_;
+      saveMesh(ar);
+   }
+
+   /*
+   * Read optional mesh parameters.
+   */
+   void StructureFactor::readMesh(std::istream& in)
+   {
+      hasMesh_ = readOptional<IntVector>(in, "meshDimensions", 
+                                         meshDimensions_).isActive();
+      if (hasMesh_) {
+         read<int>(in, "meshOrder", meshOrder_);
+         setupMesh();
+      }
+   }
+
+   /*
+   * Load optional mesh parameters.
+   */
+   void StructureFactor::loadMesh(Serializable::IArchive& ar)
+   {
+      hasMesh_ = false;
+      if (ar.version() > 0) {
+         hasMesh_ = loadParameter<IntVector>(ar, "meshDimensions", 
+                                             meshDimensions_, false).isActive();
+      }
+      if (hasMesh_) {
+         loadParameter<int>(ar, "meshOrder", meshOrder_);
+         setupMesh();
+      }
+   }
+
+   /*
+   * Save optional mesh parameters.
+   */
+   void StructureFactor::saveMesh(Serializable::OArchive& ar)
+   {
+      Parameter::saveOptional(ar, meshDimensions_, hasMesh_);
+      if (hasMesh_) {
+         ar << meshOrder_;
+      }
+   }
+
+   /*
+   * Allocate the mesh, and check that all wavevectors are resolved.
+   */
+   void StructureFactor::setupMesh()
+   {
+      mesh_.setParam(meshDimensions_, meshOrder_, nAtomType_);
+      for (int i = 0; i < nWave_; ++i) {
+         if (!mesh_.isValidWave(waveIntVectors_[i])) {
+            Log::file() << "waveIntVector = " << waveIntVectors_[i] 
+                        << std::endl;
+            UTIL_THROW("Wavevector not resolved by mesh: need 2|m_j| < n_j");
+         }
+      }
    }
   
    /*
@@ -157,14 +222,57 @@ namespace DdMd
       }
 
       isFirstStep_ = false;
+      int i, j;
+
+      makeWaveVectors();
+      if (hasMesh_) {
+         computeMeshModes();
+      } else {
+         computeExactModes();
+      }
+
+      if (simulation().domain().isMaster()) {
+         // Increment structure factors
+         double volume = simulation().boundary().volume();
+         double norm, maxValue, maxQ;
+         IntVector maxIntVector;
+         for (j = 0; j < nMode_; ++j) {
+            maxValue = 0.0;
+            maxQ = 0.0;
+            for (i = 1; i < nWave_; ++i) {
+               norm = std::norm(totalFourierModes_(i, j));
+               norm = norm/volume;
+               if ( norm >= maxValue ) {
+                  maxValue = norm;
+                  maxIntVector = waveIntVectors_[i];
+                  maxQ = waveVectors_[i].abs();
+               }
+               structureFactors_(i, j) += norm;
+            }
+            outputFile_ << maxIntVector;
+            outputFile_ << Dbl(maxQ,20,8);
+            outputFile_ << Dbl(maxValue,20,8);
+            outputFile_ << std::endl;
+         }
+         outputFile_ << std::endl;
+         outputFile_.close();
+      }
+
+      ++nSample_;
+
+   }
+
+   /*
+   * Compute Fourier modes by an exact sum over atoms and wavevectors.
+   */
+   void StructureFactor::computeExactModes() 
+   {
       Vector position;
       std::complex<double> expFactor;
       double  product;
       AtomIterator  atomIter;
       int i, j, typeId;
 
-      makeWaveVectors();
-
       // Set all Fourier modes to zero
       for (i = 0; i < nWave_; ++i) {
          for (j = 0; j < nMode_; ++j) {
@@ -188,59 +296,58 @@ namespace DdMd
          }
       }
 
-      for (i = 0; i < nWave_; ++i) {
-         for (j = 0; j < nMode_; ++j) {
-            totalFourierModes_(i, j) = std::complex<double>(0.0, 0.0);
-         }
-      }
- 
       #ifdef UTIL_MPI
-      // Loop over wavevectors
-      for (int i = 0; i < nWave_; ++i) {
-         for (int j = 0; j < nMode_; ++j) {
-         //Sum values from all processors.
-         simulation().domain().communicator().
-                      Reduce(&fourierModes_(i, j), &totalFourierModes_(i, j),
-                             1, MPI::DOUBLE_COMPLEX, MPI::SUM, 0);
-         }
-      }
+      // Sum values from all processors, in one reduction.
+      simulation().domain().communicator().
+                   Reduce(&fourierModes_(0, 0), &totalFourierModes_(0, 0),
+                          nWave_*nMode_, MPI::DOUBLE_COMPLEX, MPI::SUM, 0);
       #else
-      for (int i = 0; i < nWave_; ++i) {
-         for (int j = 0; j < nMode_; ++j) {
+      for (i = 0; i < nWave_; ++i) {
+         for (j = 0; j < nMode_; ++j) {
             totalFourierModes_(i, j) = fourierModes_(i, j);
          }
       }
       #endif
+   }
+
+   /*
+   * Compute Fourier modes from Fourier transformed type densities.
+   */
+   void StructureFactor::computeMeshModes() 
+   {
+      Vector position;
+      AtomIterator  atomIter;
+      int i, j, typeId;
+
+      // Assign local atoms of each type to the corresponding field
+      const Boundary& boundary = simulation().boundary();
+      mesh_.clear();
+      simulation().atomStorage().begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         boundary.transformCartToGen(atomIter->position(), position);
+         mesh_.spread(position, atomIter->typeId());
+      }
 
+      #ifdef UTIL_MPI
+      mesh_.reduce(simulation().domain().communicator(), 0);
+      #endif
+
+      // Transform, and project type amplitudes onto modes
       if (simulation().domain().isMaster()) {
-         // Increment structure factors
-         double volume = simulation().boundary().volume();
-         double norm, maxValue, maxQ;
-         IntVector maxIntVector;
-         for (j = 0; j < nMode_; ++j) {
-            maxValue = 0.0;
-            maxQ = 0.0;
-            for (i = 1; i < nWave_; ++i) {
-               norm = std::norm(totalFourierModes_(i, j));
-               norm = norm/volume;
-               if ( norm >= maxValue ) {
-                  maxValue = norm;
-                  maxIntVector = waveIntVectors_[i];
-                  maxQ = waveVectors_[i].abs();
+         mesh_.transform();
+         std::complex<double> amplitude;
+         for (i = 0; i < nWave_; ++i) {
+            for (j = 0; j < nMode_; ++j) {
+               totalFourierModes_(i, j) = std::complex<double>(0.0, 0.0);
+            }
+            for (typeId = 0; typeId < nAtomType_; ++typeId) {
+               amplitude = mesh_.amplitude(typeId, waveIntVectors_[i]);
+               for (j = 0; j < nMode_; ++j) {
+                  totalFourierModes_(i, j) += modes_(j, typeId)*amplitude;
                }
-               structureFactors_(i, j) += norm;
             }
-            outputFile_ << maxIntVector;
-            outputFile_ << Dbl(maxQ,20,8);
-            outputFile_ << Dbl(maxValue,20,8);
-            outputFile_ << std::endl;
          }
-         outputFile_ << std::endl;
-         outputFile_.close();
       }
-
-      ++nSample_;
-
    }
 
    /*
@@ -12,6 +12,7 @@
 #include <ddMd/simulation/Simulation.h>
 #include <util/containers/DMatrix.h>              // member template
 #include <util/containers/DArray.h>               // member template
+#include <util/space/ParticleMesh.h>              // member
 
 #include <util/global.h>
 
@@ -74,6 +75,15 @@ namespace DdMd
    * magnitude of the wavevector, and a list of structure factor
    * values for the wavevector, one for each mode.
    *
+   * By default, Fourier amplitudes are computed by an exact sum over
+   * atoms for each wavevector. If the optional meshDimensions and 
+   * meshOrder parameters are present, each processor instead assigns 
+   * the density of each atom type to a ParticleMesh, the meshes are
+   * summed on the master processor, and amplitudes for all wavevectors
+   * are obtained from one set of fast Fourier transforms. Each 
+   * wavevector must then satisfy 2|m_j| < n_j, where m_j is a Miller 
+   * index and n_j is the corresponding mesh dimension.
+   *
    * \sa \ref ddMd_analyzer_StructureFactor_page "param file format"
    * 
    * \ingroup DdMd_Analyzer_Scattering_Module
@@ -204,6 +214,58 @@ namespace DdMd
       */
       void makeWaveVectors();
 
+      /**
+      * Read optional mesh parameters, and set up the mesh if present.
+      *
+      * Call at the end of readParameters, after waveIntVectors_ is set.
+      *
+      * \param in  input parameter stream
+      */
+      void readMesh(std::istream& in);
+
+      /**
+      * Load optional mesh parameters, and set up the mesh if present.
+      *
+      * \param ar  input/loading archive
+      */
+      void loadMesh(Serializable::IArchive &ar);
+
+      /**
+      * Save optional mesh parameters.
+      *
+      * \param ar  output/saving archive
+      */
+      void saveMesh(Serializable::OArchive &ar);
+
+   private:
+
+      /// Particle mesh (used iff hasMesh_).
+      ParticleMesh mesh_;
+
+      /// Number of mesh points along each axis.
+      IntVector meshDimensions_;
+
+      /// Order of mesh assignment function.
+      int meshOrder_;
+
+      /// Are Fourier amplitudes computed on a mesh?
+      bool hasMesh_;
+
+      /**
+      * Check wavevectors and set up the mesh.
+      */
+      void setupMesh();
+
+      /**
+      * Compute totalFourierModes_ on the master by exact summation.
+      */
+      void computeExactModes();
+
+      /**
+      * Compute totalFourierModes_ on the master using the mesh.
+      */
+      void computeMeshModes();
+
    };
 
 }
@@ -233,6 +233,8 @@ namespace DdMd
       }
       nSample_ = 0;
 
+      readMesh(in);
+
       isInitialized_ = true;
    }
 
@@ -274,6 +276,8 @@ namespace DdMd
       fourierModes_.allocate(nWave_, nMode_);
       totalFourierModes_.allocate(nWave_, nMode_);
 
+      loadMesh(ar);
+
       isInitialized_ = true;
    }
 
@@ -297,6 +301,7 @@ namespace DdMd
       ar << nSample_;
 
       ar << structureFactors_;
+      saveMesh(ar);
    }
 
    void StructureFactorGrid::clear()
@@ -1,7 +1,8 @@
 ddMd_analyzers_scattering_=\
      ddMd/analyzers/scattering/StructureFactor.cpp\
      ddMd/analyzers/scattering/StructureFactorGrid.cpp\
-     ddMd/analyzers/scattering/VanHove.cpp
+     ddMd/analyzers/scattering/VanHove.cpp\
+     ddMd/analyzers/scattering/RDF.cpp
 
 ddMd_analyzers_scattering_SRCS=\
      $(addprefix $(SRC_DIR)/, $(ddMd_analyzers_scattering_))
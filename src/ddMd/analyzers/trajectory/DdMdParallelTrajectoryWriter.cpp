@@ -0,0 +1,235 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "DdMdParallelTrajectoryWriter.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/communicate/Domain.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <ddMd/chemistry/Atom.h>
+#include <util/archives/BinaryFileOArchive.h>
+#include <util/boundary/Boundary.h>
+#include <util/space/Vector.h>
+
+#include <climits>
+#include <cmath>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   DdMdParallelTrajectoryWriter::DdMdParallelTrajectoryWriter(Simulation& simulation)
+    : Analyzer(simulation),
+      buffer_(std::ios_base::out | std::ios_base::binary),
+      stream_(),
+      blockSizes_(),
+      file_(),
+      offset_(0),
+      domainPtr_(&simulation.domain()),
+      atomStoragePtr_(&simulation.atomStorage()),
+      isOpen_(false)
+   {
+      setClassName("DdMdParallelTrajectoryWriter");
+      stream_.std::ios::rdbuf(&buffer_);
+   }
+
+   /*
+   * Destructor.
+   */
+   DdMdParallelTrajectoryWriter::~DdMdParallelTrajectoryWriter()
+   {
+      if (isOpen_) {
+         file_.Close();
+      }
+      stream_.std::ios::rdbuf(0);
+   }
+
+   /*
+   * Read interval and outputFileName.
+   */
+   void DdMdParallelTrajectoryWriter::readParameters(std::istream& in)
+   {
+      readInterval(in);
+      readOutputFileName(in);
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void DdMdParallelTrajectoryWriter::loadParameters(Serializable::IArchive &ar)
+   {
+      loadInterval(ar);
+      loadOutputFileName(ar);
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void DdMdParallelTrajectoryWriter::save(Serializable::OArchive &ar)
+   {
+      saveInterval(ar);
+      saveOutputFileName(ar);
+   }
+
+   /*
+   * Open the trajectory file on all processors, and write the header.
+   */
+   void DdMdParallelTrajectoryWriter::setup()
+   {
+      clear();
+
+      MPI::Intracomm& communicator = domainPtr_->communicator();
+      std::string filename
+                = simulation().fileMaster().outputFileName(outputFileName());
+
+      // Open file (the C binding is used to obtain the error code)
+      MPI_File fh;
+      int error = MPI_File_open(communicator,
+                                const_cast<char*>(filename.c_str()),
+                                MPI_MODE_WRONLY | MPI_MODE_CREATE,
+                                MPI_INFO_NULL, &fh);
+      if (error != MPI_SUCCESS) {
+         std::string message;
+         message = "Error opening trajectory file. Filename: " + filename;
+         UTIL_THROW(message.c_str());
+      }
+      file_ = fh;
+      file_.Set_errhandler(MPI::ERRORS_ARE_FATAL);
+      file_.Set_size(0);
+      isOpen_ = true;
+      offset_ = 0;
+
+      int nProc = communicator.Get_size();
+      if (blockSizes_.capacity() != nProc) {
+         if (blockSizes_.isAllocated()) {
+            blockSizes_.deallocate();
+         }
+         blockSizes_.allocate(nProc);
+      }
+
+      // Write total number of atoms (master only)
+      AtomStorage& storage = *atomStoragePtr_;
+      storage.computeNAtomTotal(communicator);
+      buffer_.str("");
+      if (domainPtr_->isMaster()) {
+         BinaryFileOArchive ar(stream_);
+         int nAtom = storage.nAtomTotal();
+         ar << nAtom;
+      }
+      writeBuffer(0);
+      offset_ += sizeof(int);
+   }
+
+   /*
+   * Write a frame.
+   */
+   void DdMdParallelTrajectoryWriter::sample(long iStep)
+   {
+      if (!isAtInterval(iStep)) {
+         return;
+      }
+      if (!isOpen_) {
+         UTIL_THROW("Trajectory file is not open");
+      }
+
+      MPI::Intracomm& communicator = domainPtr_->communicator();
+      AtomStorage& storage = *atomStoragePtr_;
+      Boundary& boundary = simulation().boundary();
+      int nProc = communicator.Get_size();
+      int rank = communicator.Get_rank();
+
+      // Build the index block: number of atoms on each processor
+      int nAtom = storage.nAtom();
+      communicator.Allgather(&nAtom, 1, MPI::INT,
+                             &blockSizes_[0], 1, MPI::INT);
+
+      BinaryFileOArchive ar(stream_);
+
+      // Serialize iStep, boundary and index block on all processors, to
+      // compute their length. Only the master retains the data.
+      buffer_.str("");
+      ar << iStep;
+      ar << boundary;
+      ar << nProc;
+      int i;
+      for (i = 0; i < nProc; ++i) {
+         ar << blockSizes_[i];
+      }
+      const MPI::Offset recordSize = sizeof(int)
+                                   + Dimension*sizeof(unsigned int);
+      MPI::Offset frameSize = buffer_.str().size();
+      MPI::Offset shift = 0;
+      for (i = 0; i < nProc; ++i) {
+         if (i == rank) {
+            shift = frameSize;
+         }
+         frameSize += recordSize*blockSizes_[i];
+      }
+      if (rank == 0) {
+         shift = 0;
+      } else {
+         buffer_.str("");
+      }
+
+      // Serialize local atoms
+      AtomIterator atomIter;
+      Vector r;
+      int id, j;
+      unsigned int ir;
+      bool isCartesian = storage.isCartesian();
+      for (storage.begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         id = atomIter->id();
+         ar << id;
+         if (isCartesian) {
+            boundary.transformCartToGen(atomIter->position(), r);
+         } else {
+            r = atomIter->position();
+         }
+         for (j = 0; j < Dimension; ++j) {
+            if (r[j] >= 1.0) r[j] -= 1.0;
+            if (r[j] <  0.0) r[j] += 1.0;
+            ir = floor( UINT_MAX*r[j] + r[j] + 0.5 );
+            ar << ir;
+         }
+      }
+
+      writeBuffer(shift);
+      offset_ += frameSize;
+   }
+
+   /*
+   * Close the trajectory file.
+   */
+   void DdMdParallelTrajectoryWriter::clear()
+   {
+      if (isOpen_) {
+         file_.Close();
+         isOpen_ = false;
+      }
+   }
+
+   /*
+   * Close the trajectory file.
+   */
+   void DdMdParallelTrajectoryWriter::output()
+   {  clear(); }
+
+   /*
+   * Write contents of buffer_ at offset_ + shift (collective).
+   */
+   void DdMdParallelTrajectoryWriter::writeBuffer(MPI::Offset shift)
+   {
+      const std::string& data = buffer_.str();
+      file_.Write_at_all(offset_ + shift, data.c_str(), int(data.size()),
+                         MPI::BYTE);
+   }
+
+}
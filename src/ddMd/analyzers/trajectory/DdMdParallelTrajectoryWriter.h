@@ -0,0 +1,149 @@
+#ifndef DDMD_DDMD_PARALLEL_TRAJECTORY_WRITER_H
+#define DDMD_DDMD_PARALLEL_TRAJECTORY_WRITER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <ddMd/analyzers/Analyzer.h>        // base class
+#include <util/containers/DArray.h>         // member template
+
+#include <fstream>
+#include <sstream>
+
+namespace DdMd
+{
+
+   class Domain;
+   class AtomStorage;
+
+   using namespace Util;
+
+   /**
+   * Binary trajectory writer in which each processor writes its own atoms.
+   *
+   * This writer produces an indexed variant of the DdMd binary trajectory
+   * format without gathering atoms on the master processor. All processors
+   * open the file with MPI-IO, and each frame is written by one collective
+   * call to MPI::File::Write_at_all, in which each processor writes the
+   * atoms that it owns to a contiguous block. The file layout is:
+   *
+   *  - Header: int nAtom.
+   *
+   *  - Each frame: long iStep, the Boundary, an index block containing
+   *    int nBlock followed by the number of atoms in each of nBlock atom
+   *    blocks, and then the atom blocks. Each atom is represented by an
+   *    int id and three unsigned ints, in the encoding used by
+   *    DdMdTrajectoryWriter.
+   *
+   * Atoms appear in blocks in processor order, and in arbitrary order
+   * within each block. Readers use the atom ids to reorder atoms.
+   *
+   * \ingroup DdMd_Analyzer_Trajectory_Module
+   */
+   class DdMdParallelTrajectoryWriter : public Analyzer
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param simulation parent Simulation object
+      */
+      DdMdParallelTrajectoryWriter(Simulation& simulation);
+
+      /**
+      * Destructor.
+      *
+      * Closes the file, if open.
+      */
+      virtual ~DdMdParallelTrajectoryWriter();
+
+      /**
+      * Read parameters interval and outputFileName.
+      *
+      * \param in input parameter file
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Open the trajectory file and write the header.
+      *
+      * Must be called on all processors.
+      */
+      virtual void setup();
+
+      /**
+      * Write a frame, if iStep is a multiple of interval.
+      *
+      * Must be called on all processors.
+      *
+      * \param iStep MD time step index
+      */
+      virtual void sample(long iStep);
+
+      /**
+      * Close the trajectory file.
+      */
+      virtual void clear();
+
+      /**
+      * Close the trajectory file.
+      */
+      virtual void output();
+
+   private:
+
+      /// Buffer for data written by this processor.
+      std::stringbuf buffer_;
+
+      /// Stream associated with buffer_, used by a BinaryFileOArchive.
+      std::ofstream stream_;
+
+      /// Number of atoms in each block (i.e., on each processor).
+      DArray<int> blockSizes_;
+
+      /// Trajectory file.
+      MPI::File file_;
+
+      /// Offset of the end of the file (equal on all processors).
+      MPI::Offset offset_;
+
+      /// Pointer to associated Domain.
+      Domain* domainPtr_;
+
+      /// Pointer to associated AtomStorage.
+      AtomStorage* atomStoragePtr_;
+
+      /// Is the file open?
+      bool isOpen_;
+
+      /**
+      * Write the contents of buffer_ at offset_ + shift (collective).
+      *
+      * \param shift offset of this processor's data, relative to offset_
+      */
+      void writeBuffer(MPI::Offset shift);
+
+   };
+
+}
+#endif
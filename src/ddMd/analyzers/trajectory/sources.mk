@@ -3,6 +3,7 @@ ddMd_analyzers_trajectory_=\
      ddMd/analyzers/trajectory/TrajectoryWriter.cpp\
      ddMd/analyzers/trajectory/DdMdTrajectoryWriter.cpp\
      ddMd/analyzers/trajectory/DdMdGroupTrajectoryWriter.cpp\
+     ddMd/analyzers/trajectory/DdMdParallelTrajectoryWriter.cpp\
      ddMd/analyzers/trajectory/LammpsDumpWriter.cpp
 
 ddMd_analyzers_trajectory_SRCS=\
@@ -12,6 +12,8 @@
 #include <ddMd/chemistry/Group.h>
 #include <util/format/Int.h>
 
+#include <string.h>
+
 namespace DdMd
 {
    using namespace Util;
@@ -22,6 +24,8 @@ namespace DdMd
    Buffer::Buffer()
     : ParamComposite(),
       #ifdef UTIL_MPI
+      sendMemory_(0),
+      recvMemory_(0),
       sendBufferBegin_(0),
       recvBufferBegin_(0),
       sendBufferEnd_(0),
@@ -31,7 +35,8 @@ namespace DdMd
       recvBlockEnd_(0),
       sendPtr_(0),
       recvPtr_(0),
-      bufferCapacity_(-1),
+      sendCapacity_(0),
+      recvCapacity_(0),
       dataCapacity_(-1),
       sendSize_(0),
       recvSize_(0),
@@ -40,19 +45,43 @@ namespace DdMd
       atomCapacity_(-1),
       ghostCapacity_(-1),
       maxSendLocal_(0),
+      maxCapacity_(0),
       isInitialized_(false)
-   {  setClassName("Buffer"); }
+      #ifdef UTIL_MPI
+      , pendingChannel_(-1),
+      pendingSendBytes_(0),
+      isPending_(false)
+      #endif
+   {
+      setClassName("Buffer");
+      for (int i = 0; i < NChannel; ++i) {
+         maxChannelSendLocal_[i] = 0;
+         maxChannelSend_[i] = 0;
+         #ifdef UTIL_MPI
+         channelComms_[i] = 0;
+         channelSources_[i] = -1;
+         channelDests_[i] = -1;
+         channelBytes_[i] = -1;
+         #endif
+      }
+   }
 
    /*
    * Destructor.
    */
    Buffer::~Buffer()
    {
-      if (sendBufferBegin_) {
-         Memory::deallocate<char>(sendBufferBegin_, bufferCapacity_);
+      #ifdef UTIL_MPI
+      // Persistent requests can only be freed before MPI::Finalize.
+      if (!MPI::Is_finalized()) {
+         freeChannels();
+      }
+      #endif
+      if (sendMemory_) {
+         Memory::deallocate<char>(sendMemory_, sendCapacity_ + PageSize);
       }
-      if (recvBufferBegin_) {
-         Memory::deallocate<char>(recvBufferBegin_, bufferCapacity_);
+      if (recvMemory_) {
+         Memory::deallocate<char>(recvMemory_, recvCapacity_ + PageSize);
       }
    }
 
@@ -192,20 +221,124 @@ namespace DdMd
           atomCapacity_ = dataCapacity_/Atom::packedAtomSize();
       }
 
-      // Leave space for a 4 byte header
-      bufferCapacity_ += dataCapacity_ + 4 * sizeof(int);
+      // Leave space for a 4 int header
+      int capacity = dataCapacity_ + 4 * sizeof(int);
 
       // Allocate memory for the send buffer
-      Memory::allocate<char>(sendBufferBegin_, bufferCapacity_);
-      sendBufferEnd_ = sendBufferBegin_ + bufferCapacity_;
+      allocateBlock(sendMemory_, sendBufferBegin_, capacity);
+      sendCapacity_ = capacity;
+      sendBufferEnd_ = sendBufferBegin_ + sendCapacity_;
 
       // Allocate memory for the receive buffer
-      Memory::allocate<char>(recvBufferBegin_, bufferCapacity_);
-      recvBufferEnd_ = recvBufferBegin_ + bufferCapacity_;
+      allocateBlock(recvMemory_, recvBufferBegin_, capacity);
+      recvCapacity_ = capacity;
+      recvBufferEnd_ = recvBufferBegin_ + recvCapacity_;
+
+      sendPtr_ = sendBufferBegin_;
+      recvPtr_ = recvBufferBegin_;
+   }
+
+   /*
+   * Allocate a block of memory with a page-aligned buffer (private).
+   *
+   * On return, memory is the address of the allocated block, which must
+   * later be deallocated with a size capacity + PageSize, and begin is
+   * the first page boundary within this block.
+   */
+   void Buffer::allocateBlock(char*& memory, char*& begin, int capacity)
+   {
+      memory = 0;
+      Memory::allocate<char>(memory, capacity + PageSize);
+      size_t offset = ((size_t) memory) % PageSize;
+      begin = memory;
+      if (offset) {
+         begin += PageSize - offset;
+      }
+   }
+
+   /*
+   * Enlarge the send buffer, preserving packed data (private).
+   */
+   void Buffer::growSendBuffer(int capacity)
+   {
+      if (!isAllocated()) {
+         UTIL_THROW("Buffer not allocated");
+      }
+      if (isPending_) {
+         UTIL_THROW("Cannot enlarge send buffer during a sendRecv");
+      }
+      if (capacity <= sendCapacity_) return;
+      if (capacity < 2*sendCapacity_) {
+         capacity = 2*sendCapacity_;
+      }
+
+      // Persistent requests refer to the old buffer.
+      freeChannels();
+
+      // Allocate new buffer and copy packed data
+      char* memory;
+      char* begin;
+      allocateBlock(memory, begin, capacity);
+      int sendBytes = (int)(sendPtr_ - sendBufferBegin_);
+      memcpy(begin, sendBufferBegin_, sendBytes);
+
+      // Rebase pointers into the send buffer
+      sendPtr_ = begin + sendBytes;
+      if (sendBlockBegin_) {
+         sendBlockBegin_ = begin + (sendBlockBegin_ - sendBufferBegin_);
+      }
+      Memory::deallocate<char>(sendMemory_, sendCapacity_ + PageSize);
+      sendMemory_ = memory;
+      sendBufferBegin_ = begin;
+      sendCapacity_ = capacity;
+      sendBufferEnd_ = sendBufferBegin_ + sendCapacity_;
+   }
+
+   /*
+   * Enlarge the recv buffer, discarding its contents (private).
+   */
+   void Buffer::growRecvBuffer(int capacity)
+   {
+      if (!isAllocated()) {
+         UTIL_THROW("Buffer not allocated");
+      }
+      if (isPending_) {
+         UTIL_THROW("Cannot enlarge recv buffer during a sendRecv");
+      }
+      if (capacity <= recvCapacity_) return;
+      if (capacity < 2*recvCapacity_) {
+         capacity = 2*recvCapacity_;
+      }
+
+      // Persistent requests refer to the old buffer.
+      freeChannels();
 
+      Memory::deallocate<char>(recvMemory_, recvCapacity_ + PageSize);
+      allocateBlock(recvMemory_, recvBufferBegin_, capacity);
+      recvCapacity_ = capacity;
+      recvBufferEnd_ = recvBufferBegin_ + recvCapacity_;
       recvPtr_ = recvBufferBegin_;
    }
 
+   /*
+   * Free all persistent requests (private).
+   */
+   void Buffer::freeChannels()
+   {
+      for (int i = 0; i < NChannel; ++i) {
+         if (sendRequests_[i] != MPI::REQUEST_NULL) {
+            sendRequests_[i].Free();
+         }
+         if (recvRequests_[i] != MPI::REQUEST_NULL) {
+            recvRequests_[i].Free();
+         }
+         channelComms_[i] = 0;
+         channelSources_[i] = -1;
+         channelDests_[i] = -1;
+         channelBytes_[i] = -1;
+      }
+   }
+
    /*
    * Clear the send buffer prior to packing, and set the sendType.
    */
@@ -316,11 +449,59 @@ namespace DdMd
    /*
    * Send and receive buffer.
    */
-   void Buffer::sendRecv(MPI::Intracomm& comm, int source, int dest)
+   void Buffer::sendRecv(MPI::Intracomm& comm, int source, int dest,
+                         int channel)
    {
+      int  myRank    = comm.Get_rank();
+      int  comm_size = comm.Get_size();
 
-      MPI::Request request[2];
-      int  sendBytes = 0;
+      // Preconditions
+      if (dest > comm_size - 1 || dest < 0) {
+         UTIL_THROW("Destination rank out of bounds");
+      }
+      if (source > comm_size - 1 || source < 0) {
+         UTIL_THROW("Source rank out of bounds");
+      }
+      if (dest == myRank) {
+         UTIL_THROW("Destination and my rank are identical");
+      }
+      if (source == myRank) {
+         UTIL_THROW("Source and my rank are identical");
+      }
+      if (channel < -1 || channel >= NChannel) {
+         UTIL_THROW("Invalid channel index");
+      }
+      if (isPending_) {
+         UTIL_THROW("A nonblocking sendRecv is in progress");
+      }
+
+      // Start nonblocking send.
+      int sendBytes = sendPtr_ - sendBufferBegin_;
+      MPI::Request request;
+      request = comm.Isend(sendBufferBegin_, sendBytes, MPI::CHAR, dest, 5);
+
+      // Probe size of incoming message, enlarge recv buffer if needed.
+      MPI::Status status;
+      comm.Probe(source, 5, status);
+      int recvBytes = status.Get_count(MPI::CHAR);
+      if (recvBytes > recvCapacity_) {
+         growRecvBuffer(recvBytes);
+      }
+
+      // Receive, and wait for completion of send.
+      comm.Recv(recvBufferBegin_, recvCapacity_, MPI::CHAR, source, 5);
+      recvPtr_ = recvBufferBegin_;
+      request.Wait();
+
+      recordSend(sendBytes, channel);
+   }
+
+   /*
+   * Begin nonblocking send and receive of buffers on a persistent channel.
+   */
+   void Buffer::beginSendRecv(MPI::Intracomm& comm, int source, int dest,
+                              int channel)
+   {
       int  myRank    = comm.Get_rank();
       int  comm_size = comm.Get_size();
 
@@ -337,26 +518,84 @@ namespace DdMd
       if (source == myRank) {
          UTIL_THROW("Source and my rank are identical");
       }
+      if (channel < 0 || channel >= NChannel) {
+         UTIL_THROW("Invalid channel index");
+      }
+      if (isPending_) {
+         UTIL_THROW("A nonblocking sendRecv is already in progress");
+      }
 
-      // Start nonblocking receive.
-      request[0] = comm.Irecv(recvBufferBegin_, bufferCapacity_ ,
-                              MPI::CHAR, source, 5);
+      // Keep recv buffer at least as large as the send buffer. Force
+      // messages received in reverse communication are then no larger
+      // than the ghost messages previously sent in the same direction.
+      if (recvCapacity_ < sendCapacity_) {
+         growRecvBuffer(sendCapacity_);
+      }
 
-      // Start nonblocking send.
-      sendBytes = sendPtr_ - sendBufferBegin_;
-      request[1] = comm.Isend(sendBufferBegin_, sendBytes , MPI::CHAR, dest, 5);
+      // Create persistent requests, if necessary.
+      int sendBytes = sendPtr_ - sendBufferBegin_;
+      if (channelComms_[channel] != &comm 
+          || channelSources_[channel] != source
+          || channelDests_[channel] != dest
+          || channelBytes_[channel] != sendBytes) {
+         if (sendRequests_[channel] != MPI::REQUEST_NULL) {
+            sendRequests_[channel].Free();
+         }
+         if (recvRequests_[channel] != MPI::REQUEST_NULL) {
+            recvRequests_[channel].Free();
+         }
+         recvRequests_[channel] = comm.Recv_init(recvBufferBegin_, 
+                                     recvCapacity_, MPI::CHAR, source, 5);
+         sendRequests_[channel] = comm.Send_init(sendBufferBegin_, 
+                                     sendBytes, MPI::CHAR, dest, 5);
+         channelComms_[channel] = &comm;
+         channelSources_[channel] = source;
+         channelDests_[channel] = dest;
+         channelBytes_[channel] = sendBytes;
+      }
+
+      // Start receive and send.
+      recvRequests_[channel].Start();
+      sendRequests_[channel].Start();
+      pendingChannel_ = channel;
+      pendingSendBytes_ = sendBytes;
+      isPending_ = true;
+   }
+
+   /*
+   * Complete nonblocking send and receive of buffers.
+   */
+   void Buffer::endSendRecv()
+   {
+      if (!isPending_) {
+         UTIL_THROW("No nonblocking sendRecv is in progress");
+      }
 
       // Wait for completion of receive.
-      request[0].Wait();
+      recvRequests_[pendingChannel_].Wait();
       recvPtr_ = recvBufferBegin_;
 
       // Wait for completion of send.
-      request[1].Wait();
+      sendRequests_[pendingChannel_].Wait();
+      isPending_ = false;
+
+      recordSend(pendingSendBytes_, pendingChannel_);
+      pendingChannel_ = -1;
+   }
 
-      // Update statistics.
+   /*
+   * Update statistics for one message (private).
+   */
+   void Buffer::recordSend(int sendBytes, int channel)
+   {
       if (sendBytes > maxSendLocal_) {
          maxSendLocal_ = sendBytes;
       }
+      if (channel >= 0) {
+         if (sendBytes > maxChannelSendLocal_[channel]) {
+            maxChannelSendLocal_[channel] = sendBytes;
+         }
+      }
    }
 
    /*
@@ -381,10 +620,7 @@ namespace DdMd
       request = comm.Isend(sendBufferBegin_, sendBytes, MPI::CHAR, dest, 5);
       request.Wait();
 
-      // Update statistics.
-      if (sendBytes > maxSendLocal_) {
-         maxSendLocal_ = sendBytes;
-      }
+      recordSend(sendBytes, -1);
    }
 
    /*
@@ -392,7 +628,7 @@ namespace DdMd
    */
    void Buffer::recv(MPI::Intracomm& comm, int source)
    {
-      MPI::Request request;
+      MPI::Status status;
       int  myRank     = comm.Get_rank();
       int  comm_size  = comm.Get_size();
 
@@ -404,9 +640,18 @@ namespace DdMd
          UTIL_THROW("Source and destination identical");
       }
 
-      request = comm.Irecv(recvBufferBegin_, bufferCapacity_,
-                           MPI::CHAR, source, 5);
-      request.Wait();
+      if (isPending_) {
+         UTIL_THROW("A nonblocking sendRecv is in progress");
+      }
+
+      // Probe size of incoming message, enlarge recv buffer if needed.
+      comm.Probe(source, 5, status);
+      int recvBytes = status.Get_count(MPI::CHAR);
+      if (recvBytes > recvCapacity_) {
+         growRecvBuffer(recvBytes);
+      }
+
+      comm.Recv(recvBufferBegin_, recvCapacity_, MPI::CHAR, source, 5);
       recvType_ = NONE;
       recvPtr_ = recvBufferBegin_;
    }
@@ -431,14 +676,14 @@ namespace DdMd
          sendType_ = NONE;
       } else {
          comm.Bcast(&sendBytes, 1, MPI::INT, source);
+         if (sendBytes > recvCapacity_) {
+            growRecvBuffer(sendBytes);
+         }
          comm.Bcast(recvBufferBegin_, sendBytes, MPI::CHAR, source);
          recvPtr_ = recvBufferBegin_;
          recvType_ = NONE;
       }
-      if (sendBytes > maxSendLocal_) {
-         maxSendLocal_ = sendBytes;
-      }
-
+      recordSend(sendBytes, -1);
    }
    #endif
 
@@ -451,13 +696,30 @@ namespace DdMd
    void Buffer::computeStatistics()
    #endif
    {
+      // Pack local maxima: message size, buffer capacity, channels
+      const int n = NChannel + 2;
+      int localMax[n];
+      int globalMax[n];
+      localMax[0] = maxSendLocal_;
+      localMax[1] = sendCapacity_ > recvCapacity_ ? 
+                    sendCapacity_ : recvCapacity_;
+      for (int i = 0; i < NChannel; ++i) {
+         localMax[i+2] = maxChannelSendLocal_[i];
+      }
+
       #ifdef UTIL_MPI
-      int globalSendMax;
-      comm.Allreduce(&maxSendLocal_, &globalSendMax, 1, MPI::INT, MPI::MAX);
-      maxSend_.set(globalSendMax);
+      comm.Allreduce(localMax, globalMax, n, MPI::INT, MPI::MAX);
       #else
-      maxSend_.set(maxSendLocal_);
+      for (int i = 0; i < n; ++i) {
+         globalMax[i] = localMax[i];
+      }
       #endif
+
+      maxSend_.set(globalMax[0]);
+      maxCapacity_ = globalMax[1];
+      for (int i = 0; i < NChannel; ++i) {
+         maxChannelSend_[i] = globalMax[i+2];
+      }
    }
 
    /*
@@ -467,6 +729,11 @@ namespace DdMd
    {
       maxSendLocal_ = 0;
       maxSend_.unset();
+      maxCapacity_ = 0;
+      for (int i = 0; i < NChannel; ++i) {
+         maxChannelSendLocal_[i] = 0;
+         maxChannelSend_[i] = 0;
+      }
    }
 
    /*
@@ -479,8 +746,43 @@ namespace DdMd
       out << "Buffer" << std::endl;
       out << "sendBytes: max, capacity "
           << Int(maxSend_.value(), 10)
-          << Int(bufferCapacity_, 10)
+          << Int(maxCapacity_, 10)
+          << std::endl;
+
+      // Peak message size for each direction (i, j)
+      out << "Peak sendBytes by direction: i, j, forward, reverse" 
           << std::endl;
+      for (int i = 0; i < Dimension; ++i) {
+         for (int j = 0; j < 2; ++j) {
+            out << Int(i, 5) << Int(j, 5)
+                << Int(maxChannelSend_[2*i + j], 12)
+                << Int(maxChannelSend_[2*Dimension + 2*i + j], 12)
+                << std::endl;
+         }
+      }
+   }
+
+   /*
+   * Current capacity of send buffer, in bytes.
+   */
+   int Buffer::sendCapacity() const
+   {  return sendCapacity_; }
+
+   /*
+   * Current capacity of recv buffer, in bytes.
+   */
+   int Buffer::recvCapacity() const
+   {  return recvCapacity_; }
+
+   /*
+   * Maximum number of bytes sent through a channel.
+   */
+   int Buffer::maxChannelSend(int channel) const
+   {
+      if (channel < 0 || channel >= NChannel) {
+         UTIL_THROW("Invalid channel index");
+      }
+      return maxChannelSend_[channel];
    }
 
    /*
@@ -499,7 +801,7 @@ namespace DdMd
    * Has this buffer been allocated?
    */
    bool Buffer::isAllocated() const
-   {  return (bufferCapacity_ > 0); }
+   {  return (sendCapacity_ > 0); }
    #endif
 
 }
@@ -10,6 +10,7 @@
 
 #include <util/param/ParamComposite.h>  // base class
 #include <util/misc/Setable.h>          // member
+#include <util/space/Dimension.h>       // constant expression
 #include <util/global.h>
 
 namespace DdMd
@@ -209,9 +210,33 @@ namespace DdMd
    * Group::packedSize() static functions. 
    *
    * This idiom for dividing large blocks is used in the implementation
-   * of all the DdMd Distributor and Collector classes (AtomDistributor, 
+   * of all the DdMd Distributor and Collector classes (AtomDistributor,
    * AtomCollector, GroupDistributor and GroupCollector).
    *
+   * \section Buffer_memory_sec Memory and persistent communication
+   *
+   * The send and receive buffers are page-aligned blocks of memory with
+   * capacities measured in bytes. The initial capacity is large enough
+   * for atomCapacity atoms or ghostCapacity ghosts. The send buffer grows
+   * automatically if data is packed past its end, and the receive buffer
+   * grows as needed to receive any message sent by sendRecv(), send() or
+   * bcast(). The values of atomCapacity(), ghostCapacity() and
+   * groupCapacity() are not changed by this growth, and are used by the
+   * Distributor and Collector classes to divide data into messages of a
+   * predictable size.
+   *
+   * Messages between neighboring processors may be associated with one
+   * of NChannel channels. By convention, channel 2*i + j is used for
+   * messages sent in direction (i, j) of the processor grid, and channel
+   * 2*Dimension + 2*i + j is used for reverse communication of forces
+   * in this direction. The maximum number of bytes sent through each
+   * channel is reported by outputStatistics(). The split beginSendRecv()
+   * and endSendRecv() operations use persistent MPI requests (created by
+   * MPI_Send_init and MPI_Recv_init) for each channel. These are reused
+   * as long as the source, destination, and message length remain the
+   * same, as for ghost position updates between successive exchanges of
+   * atoms, and are rebuilt otherwise.
+   *
    * \ingroup DdMd_Communicate_Module
    */
    class Buffer: public ParamComposite 
@@ -222,9 +247,14 @@ namespace DdMd
       /**
       * Enumeration of types of data to be sent in blocks. 
       */
-      enum BlockDataType {NONE, ATOM, GHOST, UPDATE, FORCE, 
+      enum BlockDataType {NONE, ATOM, GHOST, UPDATE, FORCE,
                           GROUP2, GROUP3, GROUP4, SPECIAL};
 
+      /**
+      * Number of channels for communication with neighbors.
+      */
+      static const int NChannel = 4*Dimension;
+
       /**
       * Constructor.
       */
@@ -300,6 +330,24 @@ namespace DdMd
       template <typename T>
       void pack(const T& data);
 
+      /**
+      * Reserve space for a contiguous array in the send buffer.
+      *
+      * Returns a pointer to space for n variables of type T at the end
+      * of the packed data, advances the send cursor past this space, and 
+      * adds nItem to sendSize(). The send buffer is enlarged if needed.
+      * All n elements must be assigned before the buffer is sent. This
+      * allows arrays of primitive variables (e.g., coordinates of many
+      * atoms) to be packed by a simple loop, without a bounds check for 
+      * each variable. The returned pointer is invalidated by any later
+      * call to pack() or packArray().
+      *
+      * \param n     number of variables of type T
+      * \param nItem number of items (e.g., atoms) represented by array
+      */
+      template <typename T>
+      T* packArray(int n, int nItem);
+
       /**
       * Increment sendSize counter after packing an item (an Atom or Group).
       */
@@ -350,6 +398,19 @@ namespace DdMd
       template <typename T>
       void unpack(T& data);
 
+      /**
+      * Unpack a contiguous array from the receive buffer.
+      *
+      * Returns a pointer to n variables of type T at the receive cursor,
+      * advances the cursor past them, and subtracts nItem from recvSize().
+      * This is the inverse of packArray().
+      *
+      * \param n     number of variables of type T
+      * \param nItem number of items (e.g., atoms) represented by array
+      */
+      template <typename T>
+      const T* unpackArray(int n, int nItem);
+
       /**
       * Decrement recvSize counter after completely unpacking an item.
       */
@@ -380,11 +441,56 @@ namespace DdMd
       *
       * Throws an Exception if atomType() == NONE or sendSize() == 0.
       *
-      * \param comm   MPI communicator object
-      * \param source MPI rank of processor from which data is sent
-      * \param dest   MPI rank of processor to which data is sent
+      * The receive buffer is enlarged if necessary to hold the incoming
+      * message. If a channel index 0 <= channel < NChannel is given, the
+      * number of bytes sent is recorded in statistics for that channel.
+      *
+      * \param comm    MPI communicator object
+      * \param source  MPI rank of processor from which data is sent
+      * \param dest    MPI rank of processor to which data is sent
+      * \param channel channel index, or -1 for none
+      */
+      void sendRecv(MPI::Intracomm& comm, int source, int dest,
+                    int channel = -1);
+
+      /**
+      * Begin a nonblocking sendRecv operation on a persistent channel.
+      *
+      * Starts a receive from processor source into the recv buffer and
+      * a send of the send buffer to processor dest, using persistent
+      * requests for the specified channel, and returns immediately. The
+      * requests are created when first needed, and are recreated if the
+      * source, destination or length of the message differ from those of
+      * the previous call for this channel. The operation must be completed
+      * by a matching call to endSendRecv(). Neither buffer may be accessed
+      * between these two calls.
+      *
+      * Unlike sendRecv(), this function cannot enlarge the receive buffer,
+      * which must already be large enough for the incoming message. This
+      * is guaranteed for ghost position and force updates, which are
+      * always preceded by larger ghost messages between the same pair
+      * of processors.
+      *
+      * \param comm    MPI communicator object
+      * \param source  MPI rank of processor from which data is sent
+      * \param dest    MPI rank of processor to which data is sent
+      * \param channel channel index, 0 <= channel < NChannel
       */
-      void sendRecv(MPI::Intracomm& comm, int source, int dest);
+      void beginSendRecv(MPI::Intracomm& comm, int source, int dest,
+                         int channel);
+
+      /**
+      * Complete a nonblocking sendRecv operation.
+      *
+      * Waits for completion of the send and receive operations posted
+      * by beginSendRecv(), and sets the receive buffer for unpacking.
+      */
+      void endSendRecv();
+
+      /**
+      * Is a nonblocking sendRecv operation in progress?
+      */
+      bool isPending() const;
 
       /**
       * Send a complete buffer.
@@ -400,6 +506,8 @@ namespace DdMd
       /**
       * Receive a buffer.
       *
+      * The receive buffer is enlarged if necessary.
+      *
       * \param comm   MPI communicator
       * \param source rank of processor from which data is sent.
       */
@@ -485,10 +593,38 @@ namespace DdMd
       template <int N>
       int groupCapacity() const;
 
+      /**
+      * Current capacity of the send buffer, in bytes.
+      */
+      int sendCapacity() const;
+
+      /**
+      * Current capacity of the receive buffer, in bytes.
+      */
+      int recvCapacity() const;
+
+      /**
+      * Maximum number of bytes sent through a channel by any processor.
+      *
+      * Call only after computeStatistics().
+      *
+      * \param channel channel index, 0 <= channel < NChannel
+      */
+      int maxChannelSend(int channel) const;
+
       //@}
 
    private:
 
+      /// Alignment of send and receive buffers, in bytes.
+      static const int PageSize = 4096;
+
+      /// Memory block containing the send buffer.
+      char* sendMemory_;
+
+      /// Memory block containing the recv buffer.
+      char* recvMemory_;
+
       /// Pointer to send buffer.
       char* sendBufferBegin_;
 
@@ -516,10 +652,13 @@ namespace DdMd
       /// Address one past end of the unpacked portion of the send buffer.
       char* recvPtr_;
 
-      /// Allocated capacity of send and recv buffers, in bytes.
-      int bufferCapacity_;
+      /// Allocated capacity of send buffer, in bytes.
+      int sendCapacity_;
+
+      /// Allocated capacity of recv buffer, in bytes.
+      int recvCapacity_;
 
-      /// Capacity of buffers, in bytes, without 4 int envelope.
+      /// Initial capacity of buffers, in bytes, without 4 int envelope.
       int dataCapacity_;
 
       /// Number of items packed thus far into current block of send buffer.
@@ -549,14 +688,79 @@ namespace DdMd
       /// Maximum size used for send buffers on any processor, in bytes.
       Setable<int> maxSend_;
 
+      /// Maximum capacity of send or recv buffer on any processor.
+      int maxCapacity_;
+
+      /// Maximum bytes sent through each channel on this processor.
+      int maxChannelSendLocal_[NChannel];
+
+      /// Maximum bytes sent through each channel on any processor.
+      int maxChannelSend_[NChannel];
+
       /// Has this buffer been initialized ?
       bool isInitialized_;
 
+      #ifdef UTIL_MPI
+      /// Persistent send request for each channel.
+      MPI::Prequest sendRequests_[NChannel];
+
+      /// Persistent receive request for each channel.
+      MPI::Prequest recvRequests_[NChannel];
+
+      /// Communicator used by the requests for each channel.
+      MPI::Intracomm* channelComms_[NChannel];
+
+      /// Source rank of the receive request for each channel.
+      int channelSources_[NChannel];
+
+      /// Destination rank of the send request for each channel.
+      int channelDests_[NChannel];
+
+      /// Number of bytes sent by the send request for each channel.
+      int channelBytes_[NChannel];
+
+      /// Channel of a pending nonblocking sendRecv.
+      int pendingChannel_;
+
+      /// Number of bytes sent by a pending nonblocking send.
+      int pendingSendBytes_;
+
+      /// Is a nonblocking sendRecv in progress?
+      bool isPending_;
+      #endif
+
       /*
       * Allocate send and recv buffers, using preset capacities.
       */
       void allocate();
 
+      /*
+      * Allocate a page-aligned block with capacity bytes.
+      */
+      void allocateBlock(char*& memory, char*& begin, int capacity);
+
+      /*
+      * Enlarge the send buffer to hold at least capacity bytes.
+      */
+      void growSendBuffer(int capacity);
+
+      /*
+      * Enlarge the recv buffer to hold at least capacity bytes.
+      */
+      void growRecvBuffer(int capacity);
+
+      #ifdef UTIL_MPI
+      /*
+      * Free persistent requests for all channels.
+      */
+      void freeChannels();
+      #endif
+
+      /*
+      * Update statistics for a message of sendBytes bytes.
+      */
+      void recordSend(int sendBytes, int channel);
+
    };
 
    /*
@@ -566,7 +770,7 @@ namespace DdMd
    inline void Buffer::pack(const T& data)
    {
       if (sendPtr_ + sizeof(data) > sendBufferEnd_) {
-         UTIL_THROW("Attempted write past end of send buffer");
+         growSendBuffer((int)(sendPtr_ - sendBufferBegin_ + sizeof(data)));
       }
       T* ptr = (T *)sendPtr_;
       *ptr = data;
@@ -574,6 +778,22 @@ namespace DdMd
       sendPtr_ = (char *)ptr;
    }
 
+   /*
+   * Reserve space for an array of n objects of type T in send buffer.
+   */
+   template <typename T>
+   inline T* Buffer::packArray(int n, int nItem)
+   {
+      int bytes = n*sizeof(T);
+      if (sendPtr_ + bytes > sendBufferEnd_) {
+         growSendBuffer((int)(sendPtr_ - sendBufferBegin_) + bytes);
+      }
+      T* ptr = (T *)sendPtr_;
+      sendPtr_ += bytes;
+      sendSize_ += nItem;
+      return ptr;
+   }
+
    /*
    * Unpack an object of type T from recvBuffer.
    */
@@ -589,6 +809,25 @@ namespace DdMd
       recvPtr_ = (char *)ptr;
    }
 
+   /*
+   * Unpack an array of n objects of type T from recvBuffer.
+   */
+   template <typename T>
+   inline const T* Buffer::unpackArray(int n, int nItem)
+   {
+      int bytes = n*sizeof(T);
+      if (recvPtr_ + bytes > recvBufferEnd_) {
+         UTIL_THROW("Attempted read past end of recv buffer");
+      }
+      if (nItem > recvSize_) {
+         UTIL_THROW("Attempted to unpack more items than remain in block");
+      }
+      const T* ptr = (const T *)recvPtr_;
+      recvPtr_ += bytes;
+      recvSize_ -= nItem;
+      return ptr;
+   }
+
    /*
    * Maximum number of Group<N> objects that can fit buffer.
    */
@@ -601,6 +840,14 @@ namespace DdMd
       return (dataCapacity_/Group<N>::packedSize()); 
    }
 
+   #ifdef UTIL_MPI
+   /*
+   * Is a nonblocking sendRecv operation in progress?
+   */
+   inline bool Buffer::isPending() const
+   {  return isPending_; }
+   #endif
+
    /*
    * Increment sendSize counter after packing an item.
    */
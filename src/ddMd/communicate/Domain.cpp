@@ -25,6 +25,7 @@ namespace DdMd
       gridCoordinates_(),
       gridRank_(-1),
       gridIsPeriodic_(),
+      bounds_(),
       #if UTIL_MPI
       intracommPtr_(0),
       #endif
@@ -147,6 +148,20 @@ namespace DdMd
       // Find grid coordinates for this processor
       gridCoordinates_ = grid_.position(gridRank_);
 
+      // Initialize uniformly spaced domain boundaries
+      double dL;
+      int n;
+      for (int i = 0; i < Dimension; i++) {
+         n = gridDimensions_[i];
+         dL = 1.0 / double(n);
+         if (!bounds_[i].isAllocated()) {
+            bounds_[i].allocate(n + 1);
+         }
+         for (int k = 0; k <= n; ++k) {
+            bounds_[i][k] = k*dL;
+         }
+      }
+
       IntVector sourceCoordinates;
       int       i, j, k, jp;
 
@@ -184,6 +199,32 @@ namespace DdMd
       isInitialized_ = true;
    }
 
+   /*
+   * Set positions of the planes separating domains along axis i.
+   */
+   void Domain::setBounds(int i, const DArray<double>& bounds)
+   {
+      assert(isInitialized_);
+      assert(i >= 0);
+      assert(i < Dimension);
+
+      int n = gridDimensions_[i];
+      if (bounds.capacity() != n + 1) {
+         UTIL_THROW("Incorrect number of domain bounds");
+      }
+      if (bounds[0] != bounds_[i][0] || bounds[n] != bounds_[i][n]) {
+         UTIL_THROW("Outer domain bounds may not be changed");
+      }
+      for (int k = 0; k < n; ++k) {
+         if (bounds[k+1] <= bounds[k]) {
+            UTIL_THROW("Domain bounds are not increasing");
+         }
+      }
+      for (int k = 1; k < n; ++k) {
+         bounds_[i][k] = bounds[k];
+      }
+   }
+
    /*
    * Return one of the boundaries of the domain owned by this processor.
    */
@@ -197,9 +238,7 @@ namespace DdMd
       assert(j >= 0);
       assert(j < 2);
 
-      double dL;
-      dL = 1.0 / double(gridDimensions_[i]);
-      return (gridCoordinates_[i] + j)*dL;
+      return bounds_[i][gridCoordinates_[i] + j];
    }
 
    /*
@@ -211,15 +250,19 @@ namespace DdMd
       assert(isInitialized_);
       assert(boundaryPtr_);
 
-      double dL;
       IntVector r;
+      double x;
+      int n;
       for (int i = 0; i < Dimension; ++i) {
-         dL = 1.0 / double(gridDimensions_[i]);
-         r[i] = int(position[i] / dL);
-         if (r[i] < 0 || r[i] >= gridDimensions_[i]) {
+         x = position[i];
+         n = gridDimensions_[i];
+         r[i] = 0;
+         while (r[i] < n && x >= bounds_[i][r[i] + 1]) {
+            ++r[i];
+         }
+         if (x < bounds_[i][0] || r[i] >= n) {
             Log::file() << "Cart i   = " << i << std::endl;
             Log::file() << "position = " << position[i] << std::endl;
-            Log::file() << "dL       = " << dL << std::endl;
             Log::file() << "r        = " << r[i] << std::endl;
             Log::file() << "gridDim  = " << gridDimensions_[i] << std::endl;
             UTIL_THROW("Invalid grid coordinate");
@@ -237,14 +280,12 @@ namespace DdMd
       assert(isInitialized_);
       assert(boundaryPtr_);
 
-      double dL;
       bool isIn = true;
       for (int i = 0; i < Dimension; ++i) {  
-         dL = 1.0 / double(gridDimensions_[i]);
-         if (position[i] <   gridCoordinates_[i]*dL) {
+         if (position[i] <  bounds_[i][gridCoordinates_[i]]) {
             isIn = false;
          }
-         if (position[i] >= (gridCoordinates_[i] + 1)*dL) {
+         if (position[i] >= bounds_[i][gridCoordinates_[i] + 1]) {
             isIn = false;
          }
       }
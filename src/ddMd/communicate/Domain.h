@@ -12,6 +12,7 @@
 #include <util/boundary/Boundary.h>     // typedef used in interface
 #include <util/containers/FMatrix.h>    // member template
 #include <util/containers/FArray.h>     // member template
+#include <util/containers/DArray.h>     // member template parameter
 #include <util/space/IntVector.h>        // member
 #include <util/space/Grid.h>             // member
 #include <util/space/Dimension.h>        // constant expression
@@ -86,6 +87,25 @@ namespace DdMd
       * \param ar output/saving archive
       */
       virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Set positions of the planes that separate domains along one axis.
+      *
+      * Domains with grid coordinate k along axis i contain generalized
+      * coordinates bounds[k] <= x[i] < bounds[k+1]. The array must have
+      * gridDimension(i) + 1 elements, which must increase monotonically. 
+      * The outer planes, bounds[0] and bounds[gridDimension(i)], may not
+      * be changed. Planes are uniformly spaced after readParameters or
+      * loadParameters, and are not saved to a restart archive. 
+      *
+      * This function must be called with the same bounds on all 
+      * processors. It does not move atoms between processors: A call
+      * to Exchanger::exchange() is required after any change.
+      *
+      * \param i index of Cartesian direction 0 <= i < Dimension
+      * \param bounds array of plane positions, in generalized coordinates
+      */
+      void setBounds(int i, const DArray<double>& bounds);
   
       // Accessors
 
@@ -174,6 +194,19 @@ namespace DdMd
       */
       double domainBound(int i, int j) const;
 
+      /**
+      * Get position of one plane separating domains along axis i.
+      *
+      * Domains with grid coordinate k along axis i lie between planes 
+      * k and k + 1, so that domainBound(i, j) = bound(i, gridCoordinate(i) 
+      * + j). See setBounds().
+      *
+      * \param i index of Cartesian direction 0 <= i < Dimension
+      * \param k index of plane, 0 <= k <= gridDimension(i)
+      * \return generalized coordinate of plane
+      */
+      double bound(int i, int k) const;
+
       /**
       * Return rank of the processor whose domain contains a position.
       *
@@ -226,6 +259,9 @@ namespace DdMd
       // Is each direction periodic (1 = true, 0 = false).
       FArray<bool, Dimension> gridIsPeriodic_;
 
+      // Positions of planes separating domains along each axis.
+      FArray< DArray<double>, Dimension> bounds_;
+
       #if UTIL_MPI
 
       // Pointer to Intracommunicator.
@@ -342,6 +378,15 @@ namespace DdMd
       return shift_(i, j);  
    }
 
+   /*
+   * Position of plane k along axis i.
+   */
+   inline double Domain::bound(int i, int k) const
+   {  
+      assert(isInitialized_);
+      return bounds_[i][k];  
+   }
+
    /*
    * Has this Domain been initialized by calling readParam?
    */
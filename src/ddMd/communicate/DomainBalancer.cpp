@@ -0,0 +1,198 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "DomainBalancer.h"
+#include "Domain.h"
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <util/containers/DArray.h>
+#include <util/space/Dimension.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   DomainBalancer::DomainBalancer()
+    : domainPtr_(0),
+      storagePtr_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   DomainBalancer::~DomainBalancer()
+   {}
+
+   /*
+   * Create associations.
+   */
+   void DomainBalancer::associate(Domain& domain, AtomStorage& storage)
+   {
+      domainPtr_ = &domain;
+      storagePtr_ = &storage;
+   }
+
+   /*
+   * Move domain boundaries so as to balance the load.
+   */
+   void DomainBalancer::balance(double load, const Vector& minWidths, 
+                                const Vector& maxShifts)
+   {
+      // Preconditions
+      if (!domainPtr_) {
+         UTIL_THROW("DomainBalancer is not associated");
+      }
+      if (storagePtr_->isCartesian()) {
+         UTIL_THROW("Atomic coordinates are Cartesian");
+      }
+
+      // Divide local load equally among local atoms
+      int nAtom = storagePtr_->nAtom();
+      double weight = 0.0;
+      if (nAtom > 0 && load > 0.0) {
+         weight = load/double(nAtom);
+      }
+
+      DArray<double> localHistogram;
+      DArray<double> histogram;
+      DArray<double> oldBounds;
+      DArray<double> newBounds;
+      AtomIterator atomIter;
+      double lower, upper, binWidth, total, goal, sum, frac, x;
+      double below, above, minWidth;
+      int i, k, n, nBin, bin;
+      for (i = 0; i < Dimension; ++i) {
+         n = domainPtr_->gridDimension(i);
+         if (n < 2) continue;
+
+         // Minimum width cannot be satisfied: leave this axis alone
+         lower = domainPtr_->bound(i, 0);
+         upper = domainPtr_->bound(i, n);
+         minWidth = minWidths[i];
+         if (n*minWidth > upper - lower) continue;
+
+         // Histogram load along axis i, summed over all processors
+         nBin = BinsPerDomain*n;
+         binWidth = (upper - lower)/double(nBin);
+         localHistogram.allocate(nBin);
+         histogram.allocate(nBin);
+         for (bin = 0; bin < nBin; ++bin) {
+            localHistogram[bin] = 0.0;
+         }
+         storagePtr_->begin(atomIter);
+         for ( ; atomIter.notEnd(); ++atomIter) {
+            x = atomIter->position()[i];
+            bin = int((x - lower)/binWidth);
+            if (bin < 0) bin = 0;
+            if (bin >= nBin) bin = nBin - 1;
+            localHistogram[bin] += weight;
+         }
+         #ifdef UTIL_MPI
+         domainPtr_->communicator().Allreduce(&localHistogram[0], 
+                                              &histogram[0], nBin,
+                                              MPI::DOUBLE, MPI::SUM);
+         #else
+         for (bin = 0; bin < nBin; ++bin) {
+            histogram[bin] = localHistogram[bin];
+         }
+         #endif
+         total = 0.0;
+         for (bin = 0; bin < nBin; ++bin) {
+            total += histogram[bin];
+         }
+
+         if (total > 0.0) {
+
+            // Place planes at quantiles of the cumulative load. 
+            // All processors compute identical values.
+            oldBounds.allocate(n + 1);
+            newBounds.allocate(n + 1);
+            for (k = 0; k <= n; ++k) {
+               oldBounds[k] = domainPtr_->bound(i, k);
+               newBounds[k] = oldBounds[k];
+            }
+            sum = 0.0;
+            bin = 0;
+            for (k = 1; k < n; ++k) {
+               goal = total*double(k)/double(n);
+               while (bin < nBin - 1 && sum + histogram[bin] < goal) {
+                  sum += histogram[bin];
+                  ++bin;
+               }
+               frac = 0.0;
+               if (histogram[bin] > 0.0) {
+                  frac = (goal - sum)/histogram[bin];
+                  if (frac > 1.0) frac = 1.0;
+                  if (frac < 0.0) frac = 0.0;
+               }
+               newBounds[k] = lower + (double(bin) + frac)*binWidth;
+            }
+
+            // Enforce minimum width of slabs
+            for (k = 1; k < n; ++k) {
+               if (newBounds[k] < newBounds[k-1] + minWidth) {
+                  newBounds[k] = newBounds[k-1] + minWidth;
+               }
+            }
+            for (k = n - 1; k > 0; --k) {
+               if (newBounds[k] > newBounds[k+1] - minWidth) {
+                  newBounds[k] = newBounds[k+1] - minWidth;
+               }
+            }
+
+            // Limit displacement of each plane to maxShifts[i] and to
+            // half the width of either adjoining slab. This preserves 
+            // the minimum width, if it is satisfied by the old slabs.
+            for (k = 1; k < n; ++k) {
+               below = oldBounds[k] - 0.5*(oldBounds[k] - oldBounds[k-1]);
+               above = oldBounds[k] + 0.5*(oldBounds[k+1] - oldBounds[k]);
+               if (below < oldBounds[k] - maxShifts[i]) {
+                  below = oldBounds[k] - maxShifts[i];
+               }
+               if (above > oldBounds[k] + maxShifts[i]) {
+                  above = oldBounds[k] + maxShifts[i];
+               }
+               if (newBounds[k] < below) newBounds[k] = below;
+               if (newBounds[k] > above) newBounds[k] = above;
+            }
+
+            domainPtr_->setBounds(i, newBounds);
+            oldBounds.deallocate();
+            newBounds.deallocate();
+         }
+
+         localHistogram.deallocate();
+         histogram.deallocate();
+      }
+   }
+
+   /*
+   * Return ratio of maximum to mean of a value over all processors.
+   */
+   double DomainBalancer::imbalance(double value) const
+   {
+      double max = value;
+      double sum = value;
+      int nProc = 1;
+      #ifdef UTIL_MPI
+      MPI::Intracomm& communicator = domainPtr_->communicator();
+      communicator.Allreduce(&value, &max, 1, MPI::DOUBLE, MPI::MAX);
+      communicator.Allreduce(&value, &sum, 1, MPI::DOUBLE, MPI::SUM);
+      nProc = communicator.Get_size();
+      #endif
+      if (sum > 0.0) {
+         return max*double(nProc)/sum;
+      } else {
+         return 1.0;
+      }
+   }
+
+}
@@ -0,0 +1,118 @@
+#ifndef DDMD_DOMAIN_BALANCER_H
+#define DDMD_DOMAIN_BALANCER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/space/Vector.h>           // argument type
+#include <util/global.h>
+
+namespace DdMd
+{
+
+   class Domain;
+   class AtomStorage;
+
+   using namespace Util;
+
+   /**
+   * Moves domain boundaries to balance the load among processors.
+   *
+   * A DomainBalancer shifts the planes that separate domains along each
+   * axis of the processor grid so that each slab of domains carries an
+   * equal share of the total load. The load on each processor is given
+   * by the caller (e.g., the time spent computing forces or the number
+   * of local atoms) and is divided equally among its local atoms. The
+   * load is then histogrammed along each axis in generalized coordinates
+   * and summed over processors, and new planes are placed at the 
+   * quantiles of the cumulative load. The domain grid thus remains a 
+   * Cartesian product of slabs, so each processor still exchanges atoms
+   * and ghosts with only its face-sharing neighbors.
+   *
+   * Exchanger::exchange() sends each atom at most one domain along each
+   * axis, and identifies ghosts of an atom that crosses a boundary only
+   * if it lies within the pair list cutoff of that boundary. To preserve
+   * both conditions, each plane is moved by no more than a specified 
+   * maximum shift (e.g., the pair potential cutoff, less than the pair 
+   * list cutoff by the skin) and no more than half the width of either
+   * adjoining slab in a single call. Balancing a strongly inhomogeneous 
+   * system may thus require several calls. No slab is made narrower than
+   * a specified minimum width, which must exceed the pair list cutoff.
+   *
+   * Usage:
+   * \code
+   *    balancer.associate(domain, storage);
+   *
+   *    // Atomic coordinates must be generalized
+   *    balancer.balance(load, minWidths, maxShifts);
+   *    exchanger.exchange();
+   * \endcode
+   *
+   * \ingroup DdMd_Communicate_Module
+   */
+   class DomainBalancer
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      DomainBalancer();
+
+      /**
+      * Destructor.
+      */
+      ~DomainBalancer();
+
+      /**
+      * Create associations with Domain and AtomStorage.
+      *
+      * \param domain  associated Domain object
+      * \param storage associated AtomStorage object
+      */
+      void associate(Domain& domain, AtomStorage& storage);
+
+      /**
+      * Move domain boundaries to balance load.
+      *
+      * Must be called on all processors, with atomic coordinates in
+      * generalized form. Atoms are not moved between processors, so
+      * this must be followed by a call to Exchanger::exchange().
+      *
+      * \param load  load on this processor (arbitrary units)
+      * \param minWidths minimum width of domains (generalized coordinates)
+      * \param maxShifts maximum shift of planes (generalized coordinates)
+      */
+      void balance(double load, const Vector& minWidths, 
+                   const Vector& maxShifts);
+
+      /**
+      * Return the ratio of the maximum to the mean of a value.
+      *
+      * Must be called on all processors. Returns the ratio on all 
+      * processors, or 1.0 if the sum of values is not positive.
+      *
+      * \param value value of a load measure on this processor.
+      */
+      double imbalance(double value) const;
+
+   private:
+
+      /// Number of histogram bins per domain along each axis.
+      static const int BinsPerDomain = 32;
+
+      /// Pointer to associated Domain.
+      Domain* domainPtr_;
+
+      /// Pointer to associated AtomStorage.
+      AtomStorage* storagePtr_;
+
+   };
+
+}
+#endif
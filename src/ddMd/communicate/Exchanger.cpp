@@ -44,6 +44,12 @@ namespace DdMd
       groupExchangers_(),
       bufferPtr_(0),
       pairCutoff_(-1.0),
+      sortInterval_(0),
+      sortCounter_(0),
+      updateId_(-1),
+      floatUpdateFlag_(false),
+      hasReference_(false),
+      isFloatUpdate_(false),
       timer_(Exchanger::NTime)
    {  groupExchangers_.reserve(8); }
 
@@ -99,6 +105,27 @@ namespace DdMd
    void Exchanger::setPairCutoff(double pairCutoff)
    {  pairCutoff_ = pairCutoff; }
 
+   /*
+   * Set interval for spatial sorting of atoms.
+   */
+   void Exchanger::setSortInterval(int sortInterval)
+   {
+      if (sortInterval < 0) {
+         UTIL_THROW("Negative sortInterval");
+      }
+      sortInterval_ = sortInterval;
+      sortCounter_ = 0;
+   }
+
+   /*
+   * Enable or disable single precision ghost position updates.
+   */
+   void Exchanger::setFloatUpdateFlag(bool floatUpdateFlag)
+   {
+      floatUpdateFlag_ = floatUpdateFlag;
+      hasReference_ = false;
+   }
+
    #ifdef UTIL_MPI
    /**
    * Exchange local atoms and ghosts.
@@ -110,6 +137,9 @@ namespace DdMd
       }
       exchangeAtoms();
       exchangeGhosts();
+
+      // Reference positions must be reset by the next update
+      hasReference_ = false;
    }
 
    /*
@@ -142,6 +172,10 @@ namespace DdMd
    *      }
    *
    *    - Clear all ghosts from the AtomStorage
+   *
+   *    - If a spatial sort is due (see setSortInterval), reorder local 
+   *      atoms in memory, then reset pointers to local atoms in groups
+   *      and in the ghost send arrays (see sortAtoms).
    * 
    *    - Main loop over transfer directions:
    * 
@@ -339,6 +373,16 @@ namespace DdMd
       atomStoragePtr_->clearGhosts();
       stamp(CLEAR_GHOSTS);
 
+      // Periodically reorder local atoms along a space-filling curve
+      if (sortInterval_ > 0) {
+         if (sortCounter_ % sortInterval_ == 0) {
+            sortAtoms();
+            sortCounter_ = 0;
+         }
+         ++sortCounter_;
+         stamp(SORT_ATOMS);
+      }
+
       #ifdef UTIL_DEBUG
       #ifdef DDMD_EXCHANGER_DEBUG
       int nAtomTotal;
@@ -483,7 +527,7 @@ namespace DdMd
 
                // Send to processor dest and receive from processor source
                bufferPtr_->sendRecv(domainPtr_->communicator(),
-                                    source, dest);
+                                    source, dest, 2*i + j);
                stamp(SEND_RECV_ATOMS);
 
                // Unpack atoms into atomStorage
@@ -590,6 +634,73 @@ namespace DdMd
       stamp(MARK_GROUP_GHOSTS);
    }
 
+   /*
+   * Reorder local atoms along a space-filling curve (private).
+   *
+   * Called within exchangeAtoms(), after ghosts have been cleared, at
+   * which point all groups contain only pointers to local atoms, and 
+   * sendArray_ contains local atoms that will be retained by this 
+   * processor but are marked for sending as ghosts.
+   */
+   void Exchanger::sortAtoms()
+   {
+      // Use a grid of cells of width >= pairCutoff_ within the domain
+      Vector lengths = boundaryPtr_->lengths();
+      Vector lower;
+      Vector upper;
+      IntVector nCell;
+      int i, j;
+      for (i = 0; i < Dimension; ++i) {
+         lower[i] = bound_(i, 0);
+         upper[i] = bound_(i, 1);
+         nCell[i] = int((upper[i] - lower[i])*lengths[i]/pairCutoff_);
+         if (nCell[i] < 1) nCell[i] = 1;
+         if (nCell[i] > 1024) nCell[i] = 1024;
+      }
+      atomStoragePtr_->sortAtoms(lower, upper, nCell);
+
+      // Reset pointers to local atoms within groups
+      for (int k = 0; k < groupExchangers_.size(); ++k) {
+         groupExchangers_[k].findLocalAtoms(*atomStoragePtr_);
+      }
+
+      // Rebuild sendArray_, using the ghost plans set in exchangeAtoms
+      for (i = 0; i < Dimension; ++i) {
+         for (j = 0; j < 2; ++j) {
+            sendArray_(i, j).clear();
+         }
+      }
+      AtomIterator atomIter;
+      Plan* planPtr;
+      bool isHome;
+      bool isGhost;
+      atomStoragePtr_->begin(atomIter);
+      for ( ; atomIter.notEnd(); ++atomIter) {
+         planPtr = &atomIter->plan();
+         isHome  = true;
+         isGhost = false;
+         for (i = 0; i < Dimension; ++i) {
+            for (j = 0; j < 2; ++j) {
+               if (planPtr->exchange(i, j) && gridFlags_[i]) {
+                  isHome = false;
+               }
+               if (planPtr->ghost(i, j)) {
+                  isGhost = true;
+               }
+            }
+         }
+         if (isGhost && isHome) {
+            for (i = 0; i < Dimension; ++i) {
+               for (j = 0; j < 2; ++j) {
+                  if (planPtr->ghost(i, j)) {
+                     sendArray_(i, j).append(*atomIter);
+                  }
+               }
+            }
+         }
+      }
+   }
+
    /*
    * Exchange ghost atoms.
    *
@@ -739,7 +850,8 @@ namespace DdMd
 
                source = domainPtr_->sourceRank(i, j);
                dest   = domainPtr_->destRank(i, j);
-               bufferPtr_->sendRecv(domainPtr_->communicator(), source, dest);
+               bufferPtr_->sendRecv(domainPtr_->communicator(), 
+                                    source, dest, 2*i + j);
                stamp(SEND_RECV_GHOSTS);
 
                // Unpack ghosts and add to recvArray
@@ -816,75 +928,238 @@ namespace DdMd
    * Call on time steps for which no reneighboring is required.
    */
    void Exchanger::update()
+   {
+      beginUpdate();
+      endUpdate();
+   }
+
+   /*
+   * Begin split-phase update of ghost atom coordinates.
+   *
+   * Completes any transmissions that do not require communication, up to
+   * the first that does, and posts a nonblocking send and receive for it.
+   */
+   void Exchanger::beginUpdate()
    {
       stamp(START);
       if (!atomStoragePtr_->isCartesian()) {
          UTIL_THROW("Error: Coordinates not Cartesian on entry to update");
       }
+      if (updateId_ >= 0) {
+         UTIL_THROW("Error: Update already in progress");
+      }
 
-      Atom*  atomPtr;
-      int    i, j, k, source, dest, size, shift;
+      int i, j, source, dest;
 
-      for (i = 0; i < Dimension; ++i) {
-         for (j = 0; j < 2; ++j) {
+      // Send displacements iff reference positions have been set
+      isFloatUpdate_ = floatUpdateFlag_ && hasReference_;
 
-            // Shift on receiving processor for periodic boundary conditions
-            shift = domainPtr_->shift(i, j);
+      for (updateId_ = 0; updateId_ < 2*Dimension; ++updateId_) {
+         i = updateId_/2;
+         j = updateId_%2;
+         if (gridFlags_[i]) {
 
-            if (gridFlags_[i]) {
+            packUpdate(i, j);
+            stamp(PACK_UPDATE);
 
-               // Pack ghost positions for sending
-               bufferPtr_->clearSendBuffer();
-               bufferPtr_->beginSendBlock(Buffer::UPDATE);
-               size = sendArray_(i, j).size();
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &sendArray_(i, j)[k];
-                  atomPtr->packUpdate(*bufferPtr_);
-               }
-               bufferPtr_->endSendBlock();
-               stamp(PACK_UPDATE);
+            // Post nonblocking send and receive, and return
+            source = domainPtr_->sourceRank(i, j);
+            dest   = domainPtr_->destRank(i, j);
+            bufferPtr_->beginSendRecv(domainPtr_->communicator(), 
+                                      source, dest, updateId_);
+            stamp(SEND_RECV_UPDATE);
+            return;
 
-               // Send and receive buffers
-               source = domainPtr_->sourceRank(i, j);
-               dest   = domainPtr_->destRank(i, j);
-               bufferPtr_->sendRecv(domainPtr_->communicator(), source, dest);
-               stamp(SEND_RECV_UPDATE);
+         } else {
+            localUpdate(i, j);
+            stamp(LOCAL_UPDATE);
+         }
+      }
+   }
 
-               // Unpack ghost positions
-               bufferPtr_->beginRecvBlock();
-               size = recvArray_(i, j).size();
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &recvArray_(i, j)[k];
-                  atomPtr->unpackUpdate(*bufferPtr_);
-                  if (shift) {
-                     boundaryPtr_->applyShift(atomPtr->position(), i, shift);
-                  }
-               }
-               bufferPtr_->endRecvBlock();
-               stamp(UNPACK_UPDATE);
+   /*
+   * Complete split-phase update of ghost atom coordinates.
+   */
+   void Exchanger::endUpdate()
+   {
+      // Time since beginUpdate() returned, during which the first message
+      // was in flight, is recorded as overlapped communication time.
+      stamp(OVERLAP_UPDATE);
+      if (updateId_ < 0) {
+         UTIL_THROW("Error: endUpdate called without beginUpdate");
+      }
 
-            } else {
+      int i, j, source, dest;
+
+      // Complete the transmission posted by beginUpdate(), if any
+      if (updateId_ < 2*Dimension) {
+         i = updateId_/2;
+         j = updateId_%2;
+         bufferPtr_->endSendRecv();
+         stamp(SEND_RECV_UPDATE);
+         unpackUpdate(i, j);
+         stamp(UNPACK_UPDATE);
+         ++updateId_;
+      }
 
-               // If grid().dimension(i) == 1, then copy positions of atoms
-               // listed in sendArray to those listed in the recvArray.
+      // Remaining transmissions (blocking)
+      for ( ; updateId_ < 2*Dimension; ++updateId_) {
+         i = updateId_/2;
+         j = updateId_%2;
+         if (gridFlags_[i]) {
 
-               size = sendArray_(i, j).size();
-               assert(size == recvArray_(i, j).size());
-               for (k = 0; k < size; ++k) {
-                  atomPtr = &recvArray_(i, j)[k];
-                  atomPtr->position() = sendArray_(i, j)[k].position();
-                  if (shift) {
-                     boundaryPtr_->applyShift(atomPtr->position(), i, shift);
-                  }
-               }
-               stamp(LOCAL_UPDATE);
+            packUpdate(i, j);
+            stamp(PACK_UPDATE);
+
+            source = domainPtr_->sourceRank(i, j);
+            dest   = domainPtr_->destRank(i, j);
+            bufferPtr_->beginSendRecv(domainPtr_->communicator(), 
+                                      source, dest, updateId_);
+            bufferPtr_->endSendRecv();
+            stamp(SEND_RECV_UPDATE);
+
+            unpackUpdate(i, j);
+            stamp(UNPACK_UPDATE);
+
+         } else {
+            localUpdate(i, j);
+            stamp(LOCAL_UPDATE);
+         }
+      }
+      updateId_ = -1;
+
+      // Positions sent by the first update are the new references.
+      if (floatUpdateFlag_) {
+         hasReference_ = true;
+      }
+   }
 
+   /*
+   * Pack positions of ghosts in sendArray_(i, j) (private).
+   */
+   void Exchanger::packUpdate(int i, int j)
+   {
+      GPArray<Atom>& sendArray = sendArray_(i, j);
+      int k, size = sendArray.size();
+
+      bufferPtr_->clearSendBuffer();
+      bufferPtr_->beginSendBlock(Buffer::UPDATE);
+      if (isFloatUpdate_) {
+
+         // Pack displacements from reference positions
+         GArray<Vector>& reference = sendReference_(i, j);
+         assert(reference.size() == size);
+         float* ptr = bufferPtr_->packArray<float>(3*size, size);
+         for (k = 0; k < size; ++k) {
+            const Vector& r = sendArray[k].position();
+            const Vector& r0 = reference[k];
+            ptr[0] = (float)(r[0] - r0[0]);
+            ptr[1] = (float)(r[1] - r0[1]);
+            ptr[2] = (float)(r[2] - r0[2]);
+            ptr += 3;
+         }
+
+      } else {
+
+         // Pack positions 
+         double* ptr = bufferPtr_->packArray<double>(3*size, size);
+         for (k = 0; k < size; ++k) {
+            const Vector& r = sendArray[k].position();
+            ptr[0] = r[0];
+            ptr[1] = r[1];
+            ptr[2] = r[2];
+            ptr += 3;
+         }
+
+         // Store reference positions for later displacement updates
+         if (floatUpdateFlag_) {
+            GArray<Vector>& reference = sendReference_(i, j);
+            reference.resize(size);
+            for (k = 0; k < size; ++k) {
+               reference[k] = sendArray[k].position();
+            }
+         }
+
+      }
+      bufferPtr_->endSendBlock();
+   }
+
+   /*
+   * Unpack positions of ghosts received along axis i in direction j.
+   */
+   void Exchanger::unpackUpdate(int i, int j)
+   {
+      GPArray<Atom>& recvArray = recvArray_(i, j);
+      int k, size = recvArray.size();
+
+      // Shift on receiving processor for periodic boundary conditions
+      int shift = domainPtr_->shift(i, j);
+
+      bufferPtr_->beginRecvBlock();
+      if (isFloatUpdate_) {
+
+         // Add displacements to unshifted reference positions
+         GArray<Vector>& reference = recvReference_(i, j);
+         assert(reference.size() == size);
+         const float* ptr = bufferPtr_->unpackArray<float>(3*size, size);
+         for (k = 0; k < size; ++k) {
+            Vector& r = recvArray[k].position();
+            const Vector& r0 = reference[k];
+            r[0] = r0[0] + ptr[0];
+            r[1] = r0[1] + ptr[1];
+            r[2] = r0[2] + ptr[2];
+            ptr += 3;
+            if (shift) {
+               boundaryPtr_->applyShift(r, i, shift);
             }
+         }
 
-         } // transmit direction j = 0, 1
+      } else {
 
-      } // Cartesian direction i = 0, ..., Dimension - 1
+         if (floatUpdateFlag_) {
+            recvReference_(i, j).resize(size);
+         }
+         const double* ptr = bufferPtr_->unpackArray<double>(3*size, size);
+         for (k = 0; k < size; ++k) {
+            Vector& r = recvArray[k].position();
+            r[0] = ptr[0];
+            r[1] = ptr[1];
+            r[2] = ptr[2];
+            ptr += 3;
+            if (floatUpdateFlag_) {
+               recvReference_(i, j)[k] = r;
+            }
+            if (shift) {
+               boundaryPtr_->applyShift(r, i, shift);
+            }
+         }
 
+      }
+      bufferPtr_->endRecvBlock();
+   }
+
+   /*
+   * Copy ghost positions from sendArray_(i, j) to recvArray_(i, j). 
+   *
+   * Used if grid().dimension(i) == 1 (private).
+   */
+   void Exchanger::localUpdate(int i, int j)
+   {
+      Atom* atomPtr;
+      int k;
+      int size = sendArray_(i, j).size();
+      assert(size == recvArray_(i, j).size());
+
+      // Shift for periodic boundary conditions
+      int shift = domainPtr_->shift(i, j);
+
+      for (k = 0; k < size; ++k) {
+         atomPtr = &recvArray_(i, j)[k];
+         atomPtr->position() = sendArray_(i, j)[k].position();
+         if (shift) {
+            boundaryPtr_->applyShift(atomPtr->position(), i, shift);
+         }
+      }
    }
 
    /*
@@ -897,6 +1172,8 @@ namespace DdMd
    {
       stamp(START);
       Atom*  atomPtr;
+      double*  sendPtr;
+      const double*  recvPtr;
       int    i, j, k, source, dest, size;
 
       for (i = Dimension - 1; i >= 0; --i) {
@@ -908,9 +1185,13 @@ namespace DdMd
                bufferPtr_->clearSendBuffer();
                bufferPtr_->beginSendBlock(Buffer::FORCE);
                size = recvArray_(i, j).size();
+               sendPtr = bufferPtr_->packArray<double>(3*size, size);
                for (k = 0; k < size; ++k) {
-                  atomPtr = &recvArray_(i, j)[k];
-                  atomPtr->packForce(*bufferPtr_);
+                  const Vector& f = recvArray_(i, j)[k].force();
+                  sendPtr[0] = f[0];
+                  sendPtr[1] = f[1];
+                  sendPtr[2] = f[2];
+                  sendPtr += 3;
                }
                bufferPtr_->endSendBlock();
                stamp(PACK_FORCE);
@@ -918,16 +1199,21 @@ namespace DdMd
                // Send and receive buffers (reverse direction)
                source  = domainPtr_->destRank(i, j);
                dest    = domainPtr_->sourceRank(i, j);
-               bufferPtr_->sendRecv(domainPtr_->communicator(),
-                                    source, dest);
+               bufferPtr_->beginSendRecv(domainPtr_->communicator(),
+                                    source, dest, 2*Dimension + 2*i + j);
+               bufferPtr_->endSendRecv();
                stamp(SEND_RECV_FORCE);
 
                // Unpack ghost forces
                bufferPtr_->beginRecvBlock();
                size = sendArray_(i, j).size();
+               recvPtr = bufferPtr_->unpackArray<double>(3*size, size);
                for (k = 0; k < size; ++k) {
-                  atomPtr = &sendArray_(i, j)[k];
-                  atomPtr->unpackForce(*bufferPtr_);
+                  Vector& f = sendArray_(i, j)[k].force();
+                  f[0] += recvPtr[0];
+                  f[1] += recvPtr[1];
+                  f[2] += recvPtr[2];
+                  recvPtr += 3;
                }
                bufferPtr_->endRecvBlock();
                stamp(UNPACK_FORCE);
@@ -1011,6 +1297,12 @@ namespace DdMd
           << Dbl(ClearGhostsT*factor1, 12, 6) << "   " 
           << Dbl(ClearGhostsT*factor2, 12, 6) << "   " 
           << Dbl(ClearGhostsT*factor3, 12, 6, true) << std::endl;
+      double SortAtomsT = timer_.time(Exchanger::SORT_ATOMS);
+      atomExchangeT += SortAtomsT;
+      out << "SortAtoms            " 
+          << Dbl(SortAtomsT*factor1, 12, 6) << "   " 
+          << Dbl(SortAtomsT*factor2, 12, 6) << "   " 
+          << Dbl(SortAtomsT*factor3, 12, 6, true) << std::endl;
       double PackAtomsT = timer_.time(Exchanger::PACK_ATOMS);
       atomExchangeT += PackAtomsT;
       out << "PackAtoms            " 
@@ -1125,6 +1417,14 @@ namespace DdMd
           << Dbl(updateT*factor1, 12, 6) << "   " 
           << Dbl(updateT*factor2, 12, 6) << "   " 
           << Dbl(updateT*factor3, 12, 6, true) << std::endl;
+
+      // Time between beginUpdate() and endUpdate(), spent in computation
+      // by the caller while a message was in flight (not included above).
+      double OverlapUpdateT = timer_.time(Exchanger::OVERLAP_UPDATE);
+      out << "OverlapUpdate        " 
+          << Dbl(OverlapUpdateT*factor1, 12, 6) << "   " 
+          << Dbl(OverlapUpdateT*factor2, 12, 6) << "   " 
+          << Dbl(OverlapUpdateT*factor3, 12, 6, true) << std::endl;
       out << std::endl;
 
    }
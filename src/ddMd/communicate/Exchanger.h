@@ -13,6 +13,7 @@
 #include <util/boundary/Boundary.h>
 #include <util/containers/FMatrix.h>
 #include <util/containers/GPArray.h>
+#include <util/containers/GArray.h>
 
 
 namespace DdMd
@@ -78,6 +79,34 @@ namespace DdMd
       */
       void setPairCutoff(double pairCutoff);
 
+      /**
+      * Set interval for spatial sorting of local atoms.
+      *
+      * If sortInterval > 0, local atoms are reordered in memory along a
+      * space-filling curve (see AtomStorage::sortAtoms) on the first 
+      * call to exchange() and on every sortInterval-th call thereafter.
+      * Sorting is disabled if sortInterval == 0 (the default).
+      *
+      * \param sortInterval number of exchanges per sort (0 to disable)
+      */
+      void setSortInterval(int sortInterval);
+
+      /**
+      * Enable or disable single precision ghost position updates.
+      *
+      * If enabled, each ghost position update except the first after 
+      * each exchange() sends the displacement of each ghost since that
+      * first update as three floats, rather than its position as three
+      * doubles. The receiving processor adds this displacement to a 
+      * stored reference position. This halves the size of update 
+      * messages, but introduces errors in ghost positions of order 
+      * 1.0E-7 times the displacement since the reference update. It is
+      * disabled by default.
+      *
+      * \param floatUpdateFlag true to enable, false to disable
+      */
+      void setFloatUpdateFlag(bool floatUpdateFlag);
+
       /**
       * Exchange local atoms and ghosts.
       * 
@@ -95,10 +124,50 @@ namespace DdMd
       * This method should be called every time step for which there is
       * no exhange of atom ownership. It communicates ghost coordinates
       * for the same ghosts as those sent by the most recent call to
-      * the exchangeGhosts() methods.
+      * the exchangeGhosts() methods. Coordinates of all ghosts sent in 
+      * each direction are packed into a single contiguous array, either
+      * as positions or, if enabled by setFloatUpdateFlag(), as single
+      * precision displacements.
       */
       void update();
 
+      /**
+      * Begin a split-phase update of ghost atom coordinates.
+      *
+      * This method and endUpdate() together perform the same operation
+      * as update(), but allow computation that does not depend on ghost
+      * positions (e.g., forces between pairs of local atoms) to overlap
+      * communication. This method packs ghost positions for the first 
+      * transmission that requires interprocessor communication, posts 
+      * a nonblocking send and receive of this message, and returns 
+      * without waiting for it to complete. 
+      *
+      * Because ghosts received in one Cartesian direction may be 
+      * forwarded in later directions, later transmissions cannot begin
+      * until earlier ones are complete. Only the first transmission is
+      * thus overlapped with work done between beginUpdate() and 
+      * endUpdate(). The associated Buffer may not be used for any other
+      * purpose until endUpdate() returns.
+      */
+      void beginUpdate();
+
+      /**
+      * Complete a split-phase update of ghost atom coordinates.
+      *
+      * Waits for completion of the transmission posted by beginUpdate(),
+      * and completes the remaining transmissions. On return, all ghost 
+      * positions are updated. Throws an Exception if beginUpdate() was 
+      * not called previously.
+      */
+      void endUpdate();
+
+      /**
+      * Is a split-phase update in progress?
+      *
+      * Returns true after beginUpdate() and before endUpdate().
+      */
+      bool isUpdatePending() const;
+
       /**
       * Update ghost atom forces.
       * 
@@ -125,12 +194,12 @@ namespace DdMd
       * Enumeration of time stamp identifiers.
       */
       enum timeId {START, ATOM_PLAN, INIT_GROUP_PLAN, CLEAR_GHOSTS,
-                   PACK_ATOMS, PACK_GROUPS, REMOVE_ATOMS, 
+                   SORT_ATOMS, PACK_ATOMS, PACK_GROUPS, REMOVE_ATOMS, 
                    SEND_RECV_ATOMS, UNPACK_ATOMS, UNPACK_GROUPS, 
                    MARK_GROUP_GHOSTS, INIT_SEND_ARRAYS, PACK_GHOSTS, 
                    SEND_RECV_GHOSTS, UNPACK_GHOSTS, FIND_GROUP_GHOSTS, 
-                   PACK_UPDATE, SEND_RECV_UPDATE, UNPACK_UPDATE, 
-                   LOCAL_UPDATE, PACK_FORCE, SEND_RECV_FORCE, 
+                   PACK_UPDATE, SEND_RECV_UPDATE, OVERLAP_UPDATE,
+                   UNPACK_UPDATE, LOCAL_UPDATE, PACK_FORCE, SEND_RECV_FORCE, 
                    UNPACK_FORCE, LOCAL_FORCE, NTime};
 
    private:
@@ -198,6 +267,43 @@ namespace DdMd
       /// Cutoff for pair list (potential cutoff + skin).
       double pairCutoff_;
 
+      /// Number of calls to exchange() per spatial sort (0 if none).
+      int sortInterval_;
+
+      /// Number of calls to exchange() since last spatial sort.
+      int sortCounter_;
+
+      /**
+      * Reference positions of ghosts sent in each direction.
+      *
+      * Used only if floatUpdateFlag_ is true. Element sendReference_(i, j)
+      * stores positions of the atoms in sendArray_(i, j), as sent by the
+      * first update after the most recent exchange.
+      */
+      FMatrix< GArray<Vector>, Dimension, 2>  sendReference_;
+
+      /**
+      * Reference positions of ghosts received in each direction.
+      *
+      * Used only if floatUpdateFlag_ is true. Element recvReference_(i, j)
+      * stores positions of the atoms in recvArray_(i, j) received in the
+      * first update after the most recent exchange, before any shift for
+      * periodic boundary conditions.
+      */
+      FMatrix< GArray<Vector>, Dimension, 2>  recvReference_;
+
+      /// Index i*2 + j of next update transmission (-1 if none pending).
+      int updateId_;
+
+      /// Send single precision displacements in ghost updates?
+      bool floatUpdateFlag_;
+
+      /// Have reference positions been set since the last exchange?
+      bool hasReference_;
+
+      /// Does the current update send single precision displacements?
+      bool isFloatUpdate_;
+
       /// Timer
       DdTimer timer_;
 
@@ -210,6 +316,16 @@ namespace DdMd
       */
       void exchangeAtoms();
 
+      /**
+      * Reorder local atoms along a space-filling curve.
+      *
+      * Called by exchangeAtoms() after ghosts are cleared. Sorts local
+      * atoms by cell, using cells of width >= pairCutoff that span the
+      * processor domain, then resets pointers to local atoms in groups
+      * and in arrays of atoms to be sent as ghosts.
+      */
+      void sortAtoms();
+
       /**
       * Exchange ghosts.
       *
@@ -220,6 +336,26 @@ namespace DdMd
       */
       void exchangeGhosts();
 
+      /**
+      * Pack positions of ghosts sent along axis i in direction j.
+      *
+      * Packs positions as a single array of 3*size doubles, or packs 
+      * displacements from reference positions as an array of floats 
+      * if isFloatUpdate_ is true.
+      */
+      void packUpdate(int i, int j);
+
+      /**
+      * Unpack positions of ghosts received along axis i in direction j.
+      */
+      void unpackUpdate(int i, int j);
+
+      /**
+      * Copy positions of ghosts along axis i, direction j, if the grid
+      * dimension along axis i is 1.
+      */
+      void localUpdate(int i, int j);
+
       /**
       * Stamp internal timer.
       */
@@ -233,6 +369,10 @@ namespace DdMd
    inline DdTimer& Exchanger::timer()
    {  return timer_; }
 
+   // Is a split-phase update in progress?
+   inline bool Exchanger::isUpdatePending() const
+   {  return (updateId_ >= 0); }
+
    // Stamp internal timer (private)
    inline void Exchanger::stamp(unsigned int timeId) 
    {  timer_.stamp(timeId); }
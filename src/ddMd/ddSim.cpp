@@ -20,7 +20,7 @@ using namespace Util;
 *
 * Usage:
 *
-*    mpirun -np P ddSim [-e] [-s nSystem] 
+*    mpirun -np P ddSim [-e] [-s nSystem] [-t nThread]
 *                       [-p paramFile] [-r restartFile] [-c command] 
 *
 *    Here, P is the number of processors and paramFile is a parameter 
@@ -40,6 +40,12 @@ using namespace Util;
 *   to a different physical system to allow nSystem independent simulations. 
 *   The total communicator rank must be a multiple of nSystem.
 *
+*  -t nThread
+*
+*   Use nThread OpenMP threads within each MPI process to compute forces
+*   and integrate the equations of motion. Requires compilation with the
+*   DDMD_OPENMP makefile variable defined. The default is one thread.
+*
 *  -p paramFile
 *
 *   Specifies the name of parameter file used for initialization.
@@ -12,6 +12,7 @@
 #include <ddMd/storage/GroupStorage.tpp>
 #include <ddMd/communicate/Exchanger.h>
 #include <ddMd/analyzers/AnalyzerManager.h>
+#include <ddMd/misc/Threads.h>
 #include <ddMd/potentials/pair/PairPotential.h>
 #ifdef INTER_BOND
 #include <ddMd/potentials/bond/BondPotential.h>
@@ -31,6 +32,7 @@
 #include <util/format/Dbl.h>
 #include <util/format/Int.h>
 #include <util/format/Bool.h>
+#include <util/misc/Log.h>
 #include <util/global.h>
 
 namespace DdMd
@@ -46,8 +48,13 @@ namespace DdMd
        timer_(Integrator::NTime),
        isSetup_(false),
        saveFileName_(),
-       saveInterval_(0)
-   {}
+       saveInterval_(0),
+       overlapUpdate_(false),
+       balancer_(),
+       balanceInterval_(0),
+       balanceByTime_(false),
+       balanceTime_(0.0)
+   {  balancer_.associate(domain(), atomStorage()); }
 
    /*
    * Destructor.
@@ -56,7 +63,7 @@ namespace DdMd
    {}
 
    /*
-   * Read saveInterval and saveFileName.
+   * Read saveInterval, saveFileName and optional parameters.
    */
    void Integrator::readParameters(std::istream& in)
    {
@@ -71,6 +78,14 @@ namespace DdMd
          }
          read<std::string>(in, "saveFileName", saveFileName_);
       }
+      overlapUpdate_ = false; // Default value for optional parameter
+      readOptional<bool>(in, "overlapUpdate", overlapUpdate_);
+      balanceInterval_ = 0;
+      readOptional<int>(in, "balanceInterval", balanceInterval_);
+      balanceByTime_ = false;
+      if (balanceInterval_ > 0) {
+         readOptional<bool>(in, "balanceByTime", balanceByTime_);
+      }
    }
 
    /*
@@ -89,6 +104,16 @@ namespace DdMd
          }
          loadParameter<std::string>(ar, "saveFileName", saveFileName_);
       }
+      overlapUpdate_ = false;
+      balanceInterval_ = 0;
+      balanceByTime_ = false;
+      if (ar.version() > 0) {
+         loadParameter<bool>(ar, "overlapUpdate", overlapUpdate_, false);
+         loadParameter<int>(ar, "balanceInterval", balanceInterval_, false);
+         if (balanceInterval_ > 0) {
+            loadParameter<bool>(ar, "balanceByTime", balanceByTime_, false);
+         }
+      }
 
       MpiLoader<Serializable::IArchive> loader(*this, ar);
       loader.load(iStep_);
@@ -104,6 +129,11 @@ namespace DdMd
       if (saveInterval_ > 0) {
          ar << saveFileName_;
       }
+      Parameter::saveOptional(ar, overlapUpdate_, overlapUpdate_);
+      Parameter::saveOptional(ar, balanceInterval_, balanceInterval_ > 0);
+      if (balanceInterval_ > 0) {
+         Parameter::saveOptional(ar, balanceByTime_, balanceByTime_);
+      }
       ar << iStep_;
       ar << isSetup_;
    }
@@ -118,6 +148,25 @@ namespace DdMd
          UTIL_THROW("Atom coordinates are Cartesian");
       }
 
+      // Record per-thread times of force calculations
+      timer_.setNThread(Threads::nThread());
+      pairPotential().setThreadTimer(timer_, PAIR_FORCE);
+      #ifdef INTER_BOND
+      if (nBondType()) {
+         bondPotential().setThreadTimer(timer_, BOND_FORCE);
+      }
+      #endif
+      #ifdef INTER_ANGLE
+      if (nAngleType()) {
+         anglePotential().setThreadTimer(timer_, ANGLE_FORCE);
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (nDihedralType()) {
+         dihedralPotential().setThreadTimer(timer_, DIHEDRAL_FORCE);
+      }
+      #endif
+
       atomStorage().clearSnapshot();
       exchanger().exchange();
       pairPotential().buildCellList();
@@ -134,6 +183,9 @@ namespace DdMd
       if (!atomStorage().isCartesian()) {
          UTIL_THROW("Atom coordinates are not Cartesian");
       }
+
+      // Force time at start of the first balancing interval
+      balanceTime_ = forceTime();
    }
 
    /*
@@ -149,7 +201,17 @@ namespace DdMd
       timer_.stamp(MISC);
       simulation().zeroForces();
       timer_.stamp(ZERO_FORCE);
-      pairPotential().computeForces();
+      if (exchanger().isUpdatePending()) {
+         // Compute forces between local atoms while ghost positions 
+         // are in flight, then complete the update.
+         pairPotential().computeInteriorForces();
+         timer_.stamp(PAIR_FORCE);
+         exchanger().endUpdate();
+         timer_.stamp(UPDATE);
+         pairPotential().computeBoundaryForces();
+      } else {
+         pairPotential().computeForces();
+      }
       timer_.stamp(PAIR_FORCE);
       #ifdef INTER_BOND
       if (nBondType()) {
@@ -263,6 +325,67 @@ namespace DdMd
       #endif
    }
 
+   /*
+   * Move domain boundaries to balance load, and exchange atoms.
+   */
+   void Integrator::balanceDomains()
+   {
+      // Precondition
+      if (atomStorage().isCartesian()) {
+         UTIL_THROW("Atom coordinates are Cartesian");
+      }
+
+      double load = double(atomStorage().nAtom());
+      if (balanceByTime_) {
+         double time = forceTime();
+         load = time - balanceTime_;
+         balanceTime_ = time;
+      }
+      double loadRatio = balancer_.imbalance(load);
+      double atomRatio = balancer_.imbalance(double(atomStorage().nAtom()));
+
+      // Keep domains at least twice as wide as the pair list cutoff, so
+      // that bonded groups still span at most one boundary along each 
+      // axis, and so that a flexible boundary may contract. Move planes
+      // by at most the potential cutoff, so that atoms that cross a 
+      // boundary (by at most this plus half the skin) lie within the 
+      // pair list cutoff of it, as required by the Exchanger.
+      Vector minWidths;
+      Vector maxShifts;
+      double length;
+      for (int i = 0; i < Dimension; ++i) {
+         length = boundary().length(i);
+         minWidths[i] = 2.0*pairPotential().cutoff()/length;
+         maxShifts[i] = pairPotential().maxPairCutoff()/length;
+      }
+      balancer_.balance(load, minWidths, maxShifts);
+      timer_.stamp(BALANCE);
+
+      exchanger().exchange();
+      timer_.stamp(EXCHANGE);
+
+      double newAtomRatio = balancer_.imbalance(double(atomStorage().nAtom()));
+      if (domain().isMaster()) {
+         Log::file() << "Balance iStep = " << Int(iStep_, 10)
+                     << "  load (max/mean) = " << Dbl(loadRatio, 10, 4)
+                     << "  atoms (max/mean) = " << Dbl(atomRatio, 10, 4)
+                     << " -> " << Dbl(newAtomRatio, 10, 4) << std::endl;
+      }
+      timer_.stamp(BALANCE);
+   }
+
+   /*
+   * Return accumulated force computation time on this processor.
+   */
+   double Integrator::forceTime() const
+   {
+      double time = 0.0;
+      for (int id = PAIR_FORCE; id <= EXTERNAL_FORCE; ++id) {
+         time += timer_.time(id);
+      }
+      return time;
+   }
+
    #if 0
    /*
    * Determine whether an atom exchange and reneighboring is needed.
@@ -389,6 +512,15 @@ namespace DdMd
           << "   "
           << Dbl(transformFT*factor2, 12, 6)
           << "   " << Dbl(100.0*transformFT/time, 12, 6, true) << std::endl;
+      if (balanceInterval_ > 0) {
+         double balanceT = timer().time(BALANCE);
+         totalT += balanceT;
+         out << "Balance              " 
+             << Dbl(balanceT*factor1, 12, 6)
+             << "   "
+             << Dbl(balanceT*factor2, 12, 6)
+             << "   " << Dbl(100.0*balanceT/time, 12, 6, true) << std::endl;
+      }
       double exchangeT = timer().time(EXCHANGE);
       totalT += exchangeT;
       out << "Exchange             " 
@@ -507,6 +639,63 @@ namespace DdMd
       #endif
       out << std::endl;
 
+      // Output per-thread load balance, if multiple threads were used
+      int nThread = timer().nThread();
+      if (nThread > 1) {
+         int ids[6];
+         std::string names[6];
+         int nId = 0;
+         ids[nId] = INTEGRATE1; 
+         names[nId++] = "Integrate1           ";
+         ids[nId] = PAIR_FORCE; 
+         names[nId++] = "Pair Forces          ";
+         #ifdef INTER_BOND
+         if (nBondType()) {
+            ids[nId] = BOND_FORCE; 
+            names[nId++] = "Bond Forces          ";
+         }
+         #endif
+         #ifdef INTER_ANGLE
+         if (nAngleType()) {
+            ids[nId] = ANGLE_FORCE; 
+            names[nId++] = "Angle Forces         ";
+         }
+         #endif
+         #ifdef INTER_DIHEDRAL
+         if (nDihedralType()) {
+            ids[nId] = DIHEDRAL_FORCE; 
+            names[nId++] = "Dihedral Forces      ";
+         }
+         #endif
+         ids[nId] = INTEGRATE2; 
+         names[nId++] = "Integrate2           ";
+
+         double maxT, meanT;
+         out << "Thread load balance, nThread = " << nThread << std::endl;
+         out << "Tmax, Tmean = max and mean of busy time per thread" 
+             << std::endl << std::endl;
+         out << "                     " 
+             << " Tmax/M [sec]  "
+             << " Tmean/M [sec] "
+             << "  Tmax/Tmean" << std::endl;
+         for (int i = 0; i < nId; ++i) {
+            maxT = timer().maxThreadTime(ids[i]);
+            meanT = timer().threadTime(ids[i]);
+            out << names[i]
+                << Dbl(maxT*factor1, 12, 6)
+                << "   "
+                << Dbl(meanT*factor1, 12, 6)
+                << "   ";
+            if (meanT > 0.0) {
+               out << Dbl(maxT/meanT, 12, 6);
+            } else {
+               out << Dbl(1.0, 12, 6);
+            }
+            out << std::endl;
+         }
+         out << std::endl;
+      }
+
       // Output info about timer resolution
       double tick = MPI::Wtick();
       out << "Timer resolution     " 
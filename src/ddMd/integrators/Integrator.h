@@ -4,6 +4,7 @@
 #include <util/param/ParamComposite.h>          // base class
 #include <ddMd/simulation/SimulationAccess.h>   // base class
 #include <ddMd/misc/DdTimer.h>                  // member
+#include <ddMd/communicate/DomainBalancer.h>    // member
 
 #include <iostream>
 
@@ -42,14 +43,17 @@ namespace DdMd
       ~Integrator();
 
       /**
-      * Read saveInterval and saveFileName.
+      * Read saveInterval, saveFileName and optional parameters.
+      *
+      * Optional parameters are overlapUpdate, balanceInterval and, if 
+      * balanceInterval > 0, balanceByTime.
       *
       * \param in input parameter stream
       */   
       void readParameters(std::istream& in);
 
       /**
-      * Load saveInterval and saveFileName from restart archive.
+      * Load saveInterval, saveFileName and optional parameters.
       *
       * \param ar input archive
       */   
@@ -117,7 +121,7 @@ namespace DdMd
 
       /// Timestamps for loop timing.
       enum TimeId {ANALYZER, INTEGRATE1, CHECK, ALLREDUCE, TRANSFORM_F, 
-                   EXCHANGE, CELLLIST, TRANSFORM_R, PAIRLIST, UPDATE, 
+                   BALANCE, EXCHANGE, CELLLIST, TRANSFORM_R, PAIRLIST, UPDATE, 
                    ZERO_FORCE, PAIR_FORCE, BOND_FORCE, ANGLE_FORCE, 
                    DIHEDRAL_FORCE, EXTERNAL_FORCE, INTEGRATE2, 
                    MODIFIER, DEBUG, SIGNAL, MISC, NTime};
@@ -167,8 +171,10 @@ namespace DdMd
       * Upon return, forces are correct for all local atoms. Values
       * of the forces on ghost atoms are undefined. Executes reverse
       * communication if needed, and emits Simulation::forceSignal().
+      * Virtual so that multiple time step integrators may store slow 
+      * and fast forces separately.
       */
-      void computeForces();
+      virtual void computeForces();
 
       /**
       * Compute forces for all local atoms and virial, with timing.
@@ -178,7 +184,7 @@ namespace DdMd
       * of the forces on ghost atoms are undefined. Executes reverse
       * communication if needed, and emits Simulation::forceSignal().
       */
-      void computeForcesAndVirial();
+      virtual void computeForcesAndVirial();
 
       /**
       * Determine whether an atom exchange and reneighboring is needed.
@@ -198,6 +204,33 @@ namespace DdMd
       */
       int saveInterval() const;
 
+      /**
+      * Overlap ghost updates with computation of interior pair forces?
+      *
+      * If true, on steps with no exchange of atoms, integrators may begin
+      * the ghost position update with Exchanger::beginUpdate() rather 
+      * than Exchanger::update(). The update is then completed within 
+      * computeForces(), after computing forces for pairs of local atoms. 
+      */
+      bool overlapUpdate() const;
+
+      /**
+      * Get interval for moving domain boundaries (no balancing if 0).
+      */
+      int balanceInterval() const;
+
+      /**
+      * Move domain boundaries to balance load, and exchange atoms.
+      *
+      * Call on all processors in place of Exchanger::exchange(), with
+      * generalized atomic coordinates. The load on each processor is 
+      * the time spent computing forces since the previous call (or since
+      * setupAtoms()) if balanceByTime is true, or the number of local 
+      * atoms otherwise. Imbalances before and after are written to the
+      * log file by the master processor.
+      */
+      void balanceDomains();
+
       /*
       * Return the timer by reference.
       */
@@ -220,6 +253,24 @@ namespace DdMd
       /// Interval for writing restart files (no output if 0)
       int saveInterval_;
 
+      /// Overlap ghost update with interior pair forces?
+      bool overlapUpdate_;
+
+      /// Moves domain boundaries to balance load.
+      DomainBalancer balancer_;
+
+      /// Interval for moving domain boundaries (no balancing if 0).
+      int balanceInterval_;
+
+      /// Use force computation time as the load measure?
+      bool balanceByTime_;
+
+      /// Accumulated force computation time at previous balance.
+      double balanceTime_;
+
+      /// Return accumulated force computation time on this processor.
+      double forceTime() const;
+
    };
 
    /*
@@ -265,5 +316,17 @@ namespace DdMd
    inline int Integrator::saveInterval() const
    { return saveInterval_; }
 
+   /*
+   * Overlap ghost updates with interior pair force computation?
+   */
+   inline bool Integrator::overlapUpdate() const
+   { return overlapUpdate_; }
+
+   /*
+   * Get interval for moving domain boundaries.
+   */
+   inline int Integrator::balanceInterval() const
+   { return balanceInterval_; }
+
 }
 #endif
@@ -9,6 +9,7 @@
 #include <ddMd/simulation/Simulation.h>
 #include <ddMd/storage/AtomStorage.h>
 #include <ddMd/storage/AtomIterator.h>
+#include <ddMd/misc/Threads.h>
 #include <ddMd/communicate/Exchanger.h>
 #include <ddMd/potentials/pair/PairPotential.h>
 #include <util/space/Vector.h>
@@ -101,21 +102,31 @@ namespace DdMd
    */
    void NveIntegrator::integrateStep1()
    {
-      Vector dv;
-      Vector dr;
-      double prefactor; // = 0.5*dt/mass
-      AtomIterator atomIter;
+      int nAtom = atomStorage().nAtom();
 
       // 1st half of velocity Verlet.
-      atomStorage().begin(atomIter);
-      for ( ; atomIter.notEnd(); ++atomIter) {
-         prefactor = prefactors_[atomIter->typeId()];
-
-         dv.multiply(atomIter->force(), prefactor);
-         atomIter->velocity() += dv;
-
-         dr.multiply(atomIter->velocity(), dt_);
-         atomIter->position() += dr;
+      #ifdef DDMD_OPENMP
+      #pragma omp parallel num_threads(Threads::nThread())
+      #endif
+      {
+         Vector dv;
+         Vector dr;
+         double prefactor; // = 0.5*dt/mass
+         int i;
+         #ifdef DDMD_OPENMP
+         #pragma omp for schedule(static) nowait
+         #endif
+         for (i = 0; i < nAtom; ++i) {
+            Atom& atom = atomStorage().atom(i);
+            prefactor = prefactors_[atom.typeId()];
+
+            dv.multiply(atom.force(), prefactor);
+            atom.velocity() += dv;
+
+            dr.multiply(atom.velocity(), dt_);
+            atom.position() += dr;
+         }
+         timer().stampThread(INTEGRATE1);
       }
    }
 
@@ -124,16 +135,26 @@ namespace DdMd
    */
    void NveIntegrator::integrateStep2()
    {
-      Vector dv;
-      double prefactor; // = 0.5*dt/mass
-      AtomIterator atomIter;
+      int nAtom = atomStorage().nAtom();
 
       // 2nd half of velocity Verlet
-      atomStorage().begin(atomIter);
-      for ( ; atomIter.notEnd(); ++atomIter) {
-         prefactor = prefactors_[atomIter->typeId()];
-         dv.multiply(atomIter->force(), prefactor);
-         atomIter->velocity() += dv;
+      #ifdef DDMD_OPENMP
+      #pragma omp parallel num_threads(Threads::nThread())
+      #endif
+      {
+         Vector dv;
+         double prefactor; // = 0.5*dt/mass
+         int i;
+         #ifdef DDMD_OPENMP
+         #pragma omp for schedule(static) nowait
+         #endif
+         for (i = 0; i < nAtom; ++i) {
+            Atom& atom = atomStorage().atom(i);
+            prefactor = prefactors_[atom.typeId()];
+            dv.multiply(atom.force(), prefactor);
+            atom.velocity() += dv;
+         }
+         timer().stampThread(INTEGRATE2);
       }
 
       // Notify observers of change in velocity
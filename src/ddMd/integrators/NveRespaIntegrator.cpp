@@ -0,0 +1,99 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "NveRespaIntegrator.h"
+#include <ddMd/simulation/Simulation.h>
+#include <util/global.h>
+
+#include <iostream>
+
+namespace DdMd
+{
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   NveRespaIntegrator::NveRespaIntegrator(Simulation& simulation)
+    : RespaIntegrator(simulation)
+   {  setClassName("NveRespaIntegrator"); }
+
+   /*
+   * Destructor.
+   */
+   NveRespaIntegrator::~NveRespaIntegrator()
+   {}
+
+   /*
+   * Read outer time step dt and number of inner steps.
+   */
+   void NveRespaIntegrator::readParameters(std::istream& in)
+   {
+      read<double>(in, "dt", dt_);
+      read<int>(in, "nSubStep", nSubStep_);
+      Integrator::readParameters(in);
+   }
+
+   /**
+   * Load internal state from an archive.
+   */
+   void NveRespaIntegrator::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<double>(ar, "dt", dt_);
+      loadParameter<int>(ar, "nSubStep", nSubStep_);
+      Integrator::loadParameters(ar);
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void NveRespaIntegrator::save(Serializable::OArchive &ar)
+   {
+      ar << dt_;
+      ar << nSubStep_;
+      Integrator::save(ar);
+   }
+ 
+   /*
+   * Setup at beginning of run, before entering main loop.
+   */ 
+   void NveRespaIntegrator::setup()
+   {
+      // Initialize state and clear statistics on first usage.
+      if (!isSetup()) {
+         clear();
+         setIsSetup();
+      }
+
+      // Exchange atoms, build pair list, compute slow and fast forces.
+      setupAtoms();
+      setupRespa();
+   }
+
+   /*
+   * First half kick, and all inner steps.
+   */
+   void NveRespaIntegrator::integrateStep1()
+   {
+      double dtHalf = 0.5*dt_;
+      kick(dtHalf, dtHalf/double(nSubStep_));
+      integrateSubSteps();
+   }
+
+   /*
+   * Final half kick.
+   */
+   void NveRespaIntegrator::integrateStep2()
+   {
+      double dtHalf = 0.5*dt_;
+      kick(dtHalf, dtHalf/double(nSubStep_));
+
+      // Notify observers of change in velocity
+      simulation().velocitySignal().notify();
+   }
+
+}
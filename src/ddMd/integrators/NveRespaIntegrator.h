@@ -0,0 +1,88 @@
+#ifndef DDMD_NVE_RESPA_INTEGRATOR_H
+#define DDMD_NVE_RESPA_INTEGRATOR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "RespaIntegrator.h"      // base class
+
+namespace DdMd
+{
+
+   class Simulation;
+   using namespace Util;
+
+   /**
+   * A multiple time step (r-RESPA) constant energy integrator.
+   *
+   * \sa \ref ddMd_integrator_NveRespaIntegrator_page "param file format"
+   *
+   * \ingroup DdMd_Integrator_Module
+   */
+   class NveRespaIntegrator : public RespaIntegrator
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      NveRespaIntegrator(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      ~NveRespaIntegrator();
+
+      /**
+      * Read required parameters.
+      *
+      * Reads the outer time step dt and number of inner steps nSubStep.
+      */
+      void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+  
+   protected:
+
+      /**
+      * Setup state just before main loop.
+      *
+      * Calls Integrator::setupAtoms() and RespaIntegrator::setupRespa().
+      */
+      void setup();
+
+      /**
+      * Execute first step of two-step integrator.
+      *
+      * Half-update velocities with slow forces, and execute inner steps.
+      */
+      virtual void integrateStep1();
+
+      /**
+      * Execute second step of two-step integrator.
+      *
+      * Second half-update of velocities with fast and slow forces.
+      */
+      virtual void integrateStep2();
+
+   };
+
+}
+#endif
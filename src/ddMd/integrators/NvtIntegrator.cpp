@@ -10,6 +10,7 @@
 #include <ddMd/simulation/Simulation.h>
 #include <ddMd/storage/AtomStorage.h>
 #include <ddMd/storage/AtomIterator.h>
+#include <ddMd/misc/Threads.h>
 #include <ddMd/communicate/Exchanger.h>
 #include <ddMd/potentials/pair/PairPotential.h>
 #include <util/space/Vector.h>
@@ -150,47 +151,66 @@ namespace DdMd
 
    void NvtIntegrator::integrateStep1()
    {
-      Vector dv;
-      Vector dr;
-      double prefactor; // = 0.5*dt/mass
       double dtHalf = 0.5*dt_;
       double factor;
-      AtomIterator atomIter;
+      int nAtom = atomStorage().nAtom();
 
-   
       T_target_ = simulation().energyEnsemble().temperature();
       factor = exp(-dtHalf*(xi_ + xiDot_*dtHalf));
 
       // 1st half of velocity Verlet.
-      atomStorage().begin(atomIter);
-      for ( ; atomIter.notEnd(); ++atomIter) {
-         atomIter->velocity() *= factor;
-         prefactor = prefactors_[atomIter->typeId()];
-         dv.multiply(atomIter->force(), prefactor);
-         atomIter->velocity() += dv;
-         dr.multiply(atomIter->velocity(), dt_);
-         atomIter->position() += dr;
+      #ifdef DDMD_OPENMP
+      #pragma omp parallel num_threads(Threads::nThread())
+      #endif
+      {
+         Vector dv;
+         Vector dr;
+         double prefactor; // = 0.5*dt/mass
+         int i;
+         #ifdef DDMD_OPENMP
+         #pragma omp for schedule(static) nowait
+         #endif
+         for (i = 0; i < nAtom; ++i) {
+            Atom& atom = atomStorage().atom(i);
+            atom.velocity() *= factor;
+            prefactor = prefactors_[atom.typeId()];
+            dv.multiply(atom.force(), prefactor);
+            atom.velocity() += dv;
+            dr.multiply(atom.velocity(), dt_);
+            atom.position() += dr;
+         }
+         timer().stampThread(INTEGRATE1);
       }
    }
 
    void NvtIntegrator::integrateStep2()
    {
-      Vector dv;
-      double prefactor; // = 0.5*dt/mass
       double dtHalf = 0.5*dt_;
       double factor;
-      AtomIterator atomIter;
+      int nAtom = atomStorage().nAtom();
 
       T_target_ = simulation().energyEnsemble().temperature();
       factor = exp(-dtHalf*(xi_ + xiDot_*dtHalf));
 
       // 2nd half of velocity Verlet
-      atomStorage().begin(atomIter);
-      for ( ; atomIter.notEnd(); ++atomIter) {
-         prefactor = prefactors_[atomIter->typeId()];
-         dv.multiply(atomIter->force(), prefactor);
-         atomIter->velocity() += dv;
-         atomIter->velocity() *=factor;
+      #ifdef DDMD_OPENMP
+      #pragma omp parallel num_threads(Threads::nThread())
+      #endif
+      {
+         Vector dv;
+         double prefactor; // = 0.5*dt/mass
+         int i;
+         #ifdef DDMD_OPENMP
+         #pragma omp for schedule(static) nowait
+         #endif
+         for (i = 0; i < nAtom; ++i) {
+            Atom& atom = atomStorage().atom(i);
+            prefactor = prefactors_[atom.typeId()];
+            dv.multiply(atom.force(), prefactor);
+            atom.velocity() += dv;
+            atom.velocity() *= factor;
+         }
+         timer().stampThread(INTEGRATE2);
       }
 
       // Notify observers of change in velocity
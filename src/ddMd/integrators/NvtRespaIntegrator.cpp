@@ -0,0 +1,185 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "NvtRespaIntegrator.h"
+#include <util/ensembles/EnergyEnsemble.h>
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/misc/Threads.h>
+#include <util/mpi/MpiLoader.h>
+#include <util/global.h>
+
+#include <iostream>
+
+namespace DdMd
+{
+   using namespace Util;
+
+   /* 
+   * Constructor.
+   */
+   NvtRespaIntegrator::NvtRespaIntegrator(Simulation& simulation)
+    : RespaIntegrator(simulation),
+      T_target_(1.0),
+      T_kinetic_(1.0),
+      xi_(0.0),
+      xiDot_(0.0),
+      tauT_(1.0),
+      nuT_(1.0)
+   {
+      setClassName("NvtRespaIntegrator");
+
+      // Precondition
+      if (!simulation.energyEnsemble().isIsothermal() ) {
+         UTIL_THROW("Simulation energy ensemble is not isothermal");
+      }
+   }
+
+   /*
+   * Destructor.
+   */
+   NvtRespaIntegrator::~NvtRespaIntegrator()
+   {}
+
+   /* 
+   * Read parameters.
+   */
+   void NvtRespaIntegrator::readParameters(std::istream &in) 
+   {
+      read<double>(in, "dt", dt_);
+      read<int>(in, "nSubStep", nSubStep_);
+      read<double>(in, "tauT", tauT_);
+      Integrator::readParameters(in);
+      nuT_ = 1.0/tauT_;
+   }
+
+   /**
+   * Load internal state from an archive.
+   */
+   void NvtRespaIntegrator::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<double>(ar, "dt", dt_);
+      loadParameter<int>(ar, "nSubStep", nSubStep_);
+      loadParameter<double>(ar, "tauT", tauT_);
+      Integrator::loadParameters(ar);
+
+      MpiLoader<Serializable::IArchive> loader(*this, ar);
+      loader.load(nuT_);
+      loader.load(xi_);
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void NvtRespaIntegrator::save(Serializable::OArchive &ar)
+   {
+      ar << dt_;
+      ar << nSubStep_;
+      ar << tauT_;
+      Integrator::save(ar);
+      ar << nuT_;
+      ar << xi_;
+   }
+
+   /*
+   * Initialize xi_ to zero.
+   */
+   void NvtRespaIntegrator::initDynamicalState()
+   {  xi_ = 0.0; }
+
+   /*
+   * Setup parameters before beginning of run. 
+   */
+   void NvtRespaIntegrator::setup()
+   {
+      // Initialize state and clear statistics on first usage.
+      if (!isSetup()) {
+         clear();
+         setIsSetup();
+      }
+
+      // Exchange atoms, build pair list, compute slow and fast forces.
+      setupAtoms();
+      setupRespa();
+
+      // Initialize nAtom_, xiDot_
+      simulation().computeKineticEnergy();
+      #ifdef UTIL_MPI
+      atomStorage().computeNAtomTotal(domain().communicator());
+      #endif
+      if (domain().isMaster()) {
+         T_target_ = simulation().energyEnsemble().temperature();
+         nAtom_  = atomStorage().nAtomTotal();
+         T_kinetic_ = simulation().kineticEnergy()*2.0/double(3*nAtom_);
+         xiDot_ = (T_kinetic_/T_target_ -1.0)*nuT_*nuT_;
+      }
+      #ifdef UTIL_MPI
+      bcast(domain().communicator(), xiDot_, 0);
+      #endif
+   }
+
+   /*
+   * Thermostat, first half kick, and all inner steps.
+   */
+   void NvtRespaIntegrator::integrateStep1()
+   {
+      double dtHalf = 0.5*dt_;
+      T_target_ = simulation().energyEnsemble().temperature();
+      scaleVelocities(exp(-dtHalf*(xi_ + xiDot_*dtHalf)));
+      kick(dtHalf, dtHalf/double(nSubStep_));
+      integrateSubSteps();
+   }
+
+   /*
+   * Final half kick, thermostat, and update of thermostat variables.
+   */
+   void NvtRespaIntegrator::integrateStep2()
+   {
+      double dtHalf = 0.5*dt_;
+      T_target_ = simulation().energyEnsemble().temperature();
+      kick(dtHalf, dtHalf/double(nSubStep_));
+      scaleVelocities(exp(-dtHalf*(xi_ + xiDot_*dtHalf)));
+
+      // Notify observers of change in velocity
+      simulation().velocitySignal().notify();
+
+      // Update xiDot_ and xi_
+      simulation().computeKineticEnergy();
+      if (domain().isMaster()) {
+         xi_ += xiDot_*dtHalf;
+         T_kinetic_ = simulation().kineticEnergy()*2.0/double(3*nAtom_);
+         xiDot_ = (T_kinetic_/T_target_  - 1.0)*nuT_*nuT_;
+         xi_ += xiDot_*dtHalf;
+      }
+      #ifdef UTIL_MPI
+      bcast(domain().communicator(), xiDot_, 0);
+      bcast(domain().communicator(), xi_, 0);
+      #endif
+   }
+
+   /*
+   * Multiply velocities of all local atoms by a factor.
+   */
+   void NvtRespaIntegrator::scaleVelocities(double factor)
+   {
+      int nAtom = atomStorage().nAtom();
+
+      #ifdef DDMD_OPENMP
+      #pragma omp parallel num_threads(Threads::nThread())
+      #endif
+      {
+         int i;
+         #ifdef DDMD_OPENMP
+         #pragma omp for schedule(static) nowait
+         #endif
+         for (i = 0; i < nAtom; ++i) {
+            atomStorage().atom(i).velocity() *= factor;
+         }
+      }
+   }
+
+}
@@ -0,0 +1,237 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "RespaIntegrator.h"
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/storage/AtomStorage.h>
+#include <ddMd/misc/Threads.h>
+#include <ddMd/communicate/Exchanger.h>
+#ifdef DDMD_MODIFIERS
+#include <ddMd/modifiers/ModifierManager.h>
+#endif
+#include <ddMd/potentials/pair/PairPotential.h>
+#ifdef INTER_BOND
+#include <ddMd/potentials/bond/BondPotential.h>
+#endif
+#ifdef INTER_ANGLE
+#include <ddMd/potentials/angle/AnglePotential.h>
+#endif
+#ifdef INTER_DIHEDRAL
+#include <ddMd/potentials/dihedral/DihedralPotential.h>
+#endif
+#ifdef INTER_EXTERNAL
+#include <ddMd/potentials/external/ExternalPotential.h>
+#endif
+#include <util/ensembles/BoundaryEnsemble.h>
+#include <util/global.h>
+
+namespace DdMd
+{
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   RespaIntegrator::RespaIntegrator(Simulation& simulation)
+    : TwoStepIntegrator(simulation),
+      dt_(0.0),
+      nSubStep_(1),
+      massInverses_(),
+      slowForces_()
+   {}
+
+   /*
+   * Destructor.
+   */
+   RespaIntegrator::~RespaIntegrator()
+   {}
+
+   /*
+   * Check preconditions, allocate memory and split forces.
+   */
+   void RespaIntegrator::setupRespa()
+   {
+      if (nSubStep_ < 1) {
+         UTIL_THROW("nSubStep < 1");
+      }
+      if (!simulation().boundaryEnsemble().isRigid()) {
+         UTIL_THROW("RESPA integrators require a rigid boundary");
+      }
+      #ifdef DDMD_MODIFIERS
+      if (simulation().modifierManager().size() > 0) {
+         UTIL_THROW("RESPA integrators do not support modifiers");
+      }
+      #endif
+
+      int nAtomType = simulation().nAtomType();
+      if (!massInverses_.isAllocated()) {
+         massInverses_.allocate(nAtomType);
+      }
+      for (int i = 0; i < nAtomType; ++i) {
+         massInverses_[i] = 1.0/simulation().atomType(i).mass();
+      }
+      if (!slowForces_.isAllocated()) {
+         slowForces_.allocate(atomStorage().atomCapacity());
+      }
+
+      // Forces set by setupAtoms() are total forces. Recompute them
+      // separately, to initialize the slow forces.
+      computeForces();
+   }
+
+   /*
+   * Compute slow forces, store them, then compute fast forces.
+   */
+   void RespaIntegrator::computeForces()
+   {
+      // Precondition
+      if (!atomStorage().isCartesian()) {
+         UTIL_THROW("Atom coordinates are not Cartesian");
+      }
+
+      // Slow forces
+      timer().stamp(MISC);
+      simulation().zeroForces();
+      timer().stamp(ZERO_FORCE);
+      if (exchanger().isUpdatePending()) {
+         pairPotential().computeInteriorForces();
+         timer().stamp(PAIR_FORCE);
+         exchanger().endUpdate();
+         timer().stamp(UPDATE);
+         pairPotential().computeBoundaryForces();
+      } else {
+         pairPotential().computeForces();
+      }
+      timer().stamp(PAIR_FORCE);
+      #ifdef INTER_EXTERNAL
+      if (hasExternal()) {
+         externalPotential().computeForces();
+         timer().stamp(EXTERNAL_FORCE);
+      }
+      #endif
+      if (reverseUpdateFlag()) {
+         exchanger().reverseUpdate();
+      }
+
+      // Store slow forces
+      int nAtom = atomStorage().nAtom();
+      for (int i = 0; i < nAtom; ++i) {
+         slowForces_[i] = atomStorage().atom(i).force();
+      }
+      timer().stamp(MISC);
+
+      // Fast forces
+      computeFastForces();
+   }
+
+   /*
+   * Compute forces and virial (not supported).
+   */
+   void RespaIntegrator::computeForcesAndVirial()
+   {  UTIL_THROW("RESPA integrators require a rigid boundary"); }
+
+   /*
+   * Compute fast (bonded) forces for all local atoms.
+   */
+   void RespaIntegrator::computeFastForces()
+   {
+      simulation().zeroForces();
+      timer().stamp(ZERO_FORCE);
+      #ifdef INTER_BOND
+      if (nBondType()) {
+         bondPotential().computeForces();
+         timer().stamp(BOND_FORCE);
+      }
+      #endif
+      #ifdef INTER_ANGLE
+      if (nAngleType()) {
+         anglePotential().computeForces();
+         timer().stamp(ANGLE_FORCE);
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (nDihedralType()) {
+         dihedralPotential().computeForces();
+         timer().stamp(DIHEDRAL_FORCE);
+      }
+      #endif
+      if (reverseUpdateFlag()) {
+         exchanger().reverseUpdate();
+      }
+   }
+
+   /*
+   * Update velocities using slow and fast forces.
+   */
+   void RespaIntegrator::kick(double slowDt, double fastDt)
+   {
+      int nAtom = atomStorage().nAtom();
+
+      #ifdef DDMD_OPENMP
+      #pragma omp parallel num_threads(Threads::nThread())
+      #endif
+      {
+         Vector dv;
+         double massInverse;
+         int i;
+         #ifdef DDMD_OPENMP
+         #pragma omp for schedule(static) nowait
+         #endif
+         for (i = 0; i < nAtom; ++i) {
+            Atom& atom = atomStorage().atom(i);
+            massInverse = massInverses_[atom.typeId()];
+            dv.multiply(slowForces_[i], slowDt*massInverse);
+            atom.velocity() += dv;
+            dv.multiply(atom.force(), fastDt*massInverse);
+            atom.velocity() += dv;
+         }
+      }
+   }
+
+   /*
+   * Update positions of all local atoms.
+   */
+   void RespaIntegrator::drift(double dt)
+   {
+      int nAtom = atomStorage().nAtom();
+
+      #ifdef DDMD_OPENMP
+      #pragma omp parallel num_threads(Threads::nThread())
+      #endif
+      {
+         Vector dr;
+         int i;
+         #ifdef DDMD_OPENMP
+         #pragma omp for schedule(static) nowait
+         #endif
+         for (i = 0; i < nAtom; ++i) {
+            Atom& atom = atomStorage().atom(i);
+            dr.multiply(atom.velocity(), dt);
+            atom.position() += dr;
+         }
+      }
+   }
+
+   /*
+   * Execute inner steps, with fast forces only.
+   */
+   void RespaIntegrator::integrateSubSteps()
+   {
+      double h = dt_/double(nSubStep_);
+      drift(h);
+      timer().stamp(INTEGRATE1);
+      for (int i = 1; i < nSubStep_; ++i) {
+         exchanger().update();
+         timer().stamp(UPDATE);
+         computeFastForces();
+         kick(0.0, h);
+         drift(h);
+         timer().stamp(INTEGRATE1);
+      }
+   }
+
+}
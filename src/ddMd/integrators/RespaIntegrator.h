@@ -0,0 +1,152 @@
+#ifndef DDMD_RESPA_INTEGRATOR_H
+#define DDMD_RESPA_INTEGRATOR_H
+
+#include "TwoStepIntegrator.h"           // base class
+#include <util/containers/DArray.h>      // member
+#include <util/space/Vector.h>           // member template argument
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+namespace DdMd
+{
+
+   class Simulation;
+   using namespace Util;
+
+   /**
+   * Base class for multiple time step (r-RESPA) integrators.
+   *
+   * A RespaIntegrator splits the force on each atom into a slow part,
+   * arising from pair and external potentials, and a fast part, arising
+   * from bond, angle and dihedral potentials. Each outer time step dt
+   * is divided into nSubStep inner steps of length h = dt/nSubStep.
+   * Slow forces are computed once per outer step, and are applied as
+   * half-kicks of length dt/2 at its beginning and end. Fast forces are
+   * recomputed after every inner step, and are integrated by velocity
+   * Verlet with time step h. The sequence of operations in each outer
+   * step is:
+   *
+   *   - v += (dt/2)*Fs/m + (h/2)*Ff/m, x += h*v
+   *   - repeat nSubStep - 1 times: update ghosts, compute Ff,
+   *     v += h*Ff/m, x += h*v
+   *   - exchange atoms or update ghosts, compute Fs and Ff
+   *   - v += (h/2)*Ff/m + (dt/2)*Fs/m
+   *
+   * in which Fs and Ff denote slow and fast forces. Adjacent half kicks
+   * of the inner velocity-Verlet steps are combined into full kicks.
+   *
+   * Atom exchange and pair list updates occur only at outer steps, since
+   * the pair list skin need only accommodate the total displacement in
+   * one outer step. The number of pair force evaluations per unit of
+   * simulated time is thus reduced by a factor of nSubStep, relative to
+   * a single step integrator with time step h.
+   *
+   * Subclasses implement integrateStep1() and integrateStep2() using the
+   * protected kick(), drift() and integrateSubSteps() functions. Upon
+   * return from computeForces(), atom forces contain only the fast forces,
+   * and slow forces are stored separately. RESPA integrators require a
+   * rigid boundary, and may not be used with modifiers.
+   *
+   * \ingroup DdMd_Integrator_Module
+   */
+   class RespaIntegrator : public TwoStepIntegrator
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      RespaIntegrator(Simulation& simulation);
+
+      /**
+      * Destructor.
+      */
+      ~RespaIntegrator();
+
+   protected:
+
+      /// Outer time step.
+      double dt_;
+
+      /// Number of inner steps per outer step.
+      int nSubStep_;
+
+      /**
+      * Setup force splitting just before the main loop.
+      *
+      * Must be called in the setup() function of each subclass, after
+      * Integrator::setupAtoms(). Checks preconditions, computes inverse
+      * masses, and computes separate slow and fast forces.
+      */
+      void setupRespa();
+
+      /**
+      * Compute slow and fast forces, with timing.
+      *
+      * Computes pair and external forces, stores these as slow forces,
+      * and then replaces the atom forces by the fast (bonded) forces.
+      * Completes a pending ghost update, if any, as for the base class.
+      */
+      virtual void computeForces();
+
+      /**
+      * Compute forces and virial (not supported).
+      *
+      * RESPA integrators require a rigid boundary, so this function
+      * always throws an Exception.
+      */
+      virtual void computeForcesAndVirial();
+
+      /**
+      * Compute fast (bonded) forces on all local atoms, with timing.
+      *
+      * Zeros all atom forces, and then adds bond, angle and dihedral
+      * forces. Executes reverse communication if needed.
+      */
+      void computeFastForces();
+
+      /**
+      * Update velocities of all local atoms using slow and fast forces.
+      *
+      * Adds (slowDt*Fs + fastDt*Ff)/m to the velocity of each atom.
+      *
+      * \param slowDt time increment for slow forces
+      * \param fastDt time increment for fast forces
+      */
+      void kick(double slowDt, double fastDt);
+
+      /**
+      * Update positions of all local atoms, x += dt*v.
+      *
+      * \param dt time increment
+      */
+      void drift(double dt);
+
+      /**
+      * Execute all inner steps of an outer step, except the last kick.
+      *
+      * On entry, velocities must have been updated by the first slow
+      * and fast half kicks. On exit, positions have been advanced by a
+      * full outer step dt. Ghost positions are updated and fast forces
+      * are recomputed between inner steps, but not after the last.
+      */
+      void integrateSubSteps();
+
+   private:
+
+      /// Inverse masses of atom types.
+      DArray<double> massInverses_;
+
+      /// Slow forces on local atoms, indexed by local atom index.
+      DArray<Vector> slowForces_;
+
+   };
+
+}
+#endif
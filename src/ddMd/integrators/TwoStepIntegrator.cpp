@@ -70,12 +70,25 @@ namespace DdMd
       #endif
       analyzerManager.setup();
 
+      // Overlap ghost updates with interior pair forces, if enabled. This
+      // is disabled if forces are computed with the virial (flexible 
+      // boundaries) or if any modifiers are present, because modifiers 
+      // may require updated ghost positions before the force calculation.
+      bool overlap = overlapUpdate() 
+                     && simulation().boundaryEnsemble().isRigid();
+      #ifdef DDMD_MODIFIERS 
+      if (modifierManager.size() > 0) {
+         overlap = false;
+      }
+      #endif
+
       // Main MD loop
       timer().start();
       exchanger().timer().start();
       int  beginStep = iStep_;
       int  endStep = iStep_ + nStep;
       bool needExchange;
+      bool needBalance;
       for ( ; iStep_ < endStep; ++iStep_) {
 
          // Atomic coordinates must be Cartesian on entry to loop body.
@@ -123,6 +136,15 @@ namespace DdMd
          // Note: Integrate::isExchangeNeeded uses timer.
          needExchange = isExchangeNeeded(pairPotential().skin());
 
+         // Move domain boundaries, if scheduled. This requires exchange.
+         needBalance = false;
+         if (balanceInterval() > 0) {
+            if (iStep_ % balanceInterval() == 0) {
+               needBalance = true;
+               needExchange = true;
+            }
+         }
+
          if (!atomStorage().isCartesian()) {
             UTIL_THROW("Error: atomic coordinates are not Cartesian");
          }
@@ -146,7 +168,11 @@ namespace DdMd
             #endif
       
             // Exchange atom ownership, reidentify ghosts
-            exchanger().exchange();
+            if (needBalance) {
+               balanceDomains();
+            } else {
+               exchanger().exchange();
+            }
             timer().stamp(Integrator::EXCHANGE);
 
             #ifdef DDMD_MODIFIERS 
@@ -179,8 +205,13 @@ namespace DdMd
             timer().stamp(MODIFIER);
             #endif
      
-            // Update all ghost atom positions 
-            exchanger().update();
+            // Update all ghost atom positions. If overlap is enabled,
+            // the update is begun here and completed in computeForces().
+            if (overlap) {
+               exchanger().beginUpdate();
+            } else {
+               exchanger().update();
+            }
             timer().stamp(UPDATE);
 
             #ifdef DDMD_MODIFIERS 
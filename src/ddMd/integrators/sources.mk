@@ -3,6 +3,9 @@ ddMd_integrators_=\
    ddMd/integrators/TwoStepIntegrator.cpp \
    ddMd/integrators/NveIntegrator.cpp \
    ddMd/integrators/NvtIntegrator.cpp \
+   ddMd/integrators/RespaIntegrator.cpp \
+   ddMd/integrators/NveRespaIntegrator.cpp \
+   ddMd/integrators/NvtRespaIntegrator.cpp \
    ddMd/integrators/NvtLangevinIntegrator.cpp \
    ddMd/integrators/NptIntegrator.cpp \
    ddMd/integrators/NphIntegrator.cpp \
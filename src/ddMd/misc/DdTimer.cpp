@@ -6,11 +6,13 @@
 */
 
 #include "DdTimer.h"
+#include "Threads.h"
 
 namespace DdMd
 {
 
    DdTimer::DdTimer(int size)
+    : nThread_(1)
    {
       times_.allocate(size);
       size_ = size;
@@ -25,9 +27,34 @@ namespace DdMd
       for (int i = 0; i < size_; i++) {
          times_[i] = 0.0;
       }
+      if (threadTimes_.isAllocated()) {
+         for (int i = 0; i < size_*nThread_; i++) {
+            threadTimes_[i] = 0.0;
+         }
+      }
       time_ = 0.0;
    }
 
+   void DdTimer::setNThread(int nThread)
+   {
+      if (nThread < 1) {
+         UTIL_THROW("nThread must be positive");
+      }
+      if (threadTimes_.isAllocated()) {
+         if (nThread == nThread_) {
+            return;
+         }
+         threadTimes_.deallocate();
+      }
+      nThread_ = nThread;
+      if (nThread_ > 1) {
+         threadTimes_.allocate(size_*nThread_);
+         for (int i = 0; i < size_*nThread_; i++) {
+            threadTimes_[i] = 0.0;
+         }
+      }
+   }
+
    void DdTimer::start()
    {
       begin_ = MPI_Wtime(); 
@@ -41,6 +68,15 @@ namespace DdMd
       previous_ = current;
    }
 
+   void DdTimer::stampThread(int id)
+   {
+      if (threadTimes_.isAllocated()) {
+         int threadId = Threads::threadId();
+         assert(threadId < nThread_);
+         threadTimes_[id*nThread_ + threadId] += MPI_Wtime() - previous_;
+      }
+   }
+
    void DdTimer::stop()
    {  time_ += MPI_Wtime() - begin_; }
 
@@ -53,6 +89,13 @@ namespace DdMd
          communicator.Allreduce(&times_[i], &sum, 1, MPI::DOUBLE, MPI::SUM);
          times_[i] = sum/double(procs);
       }
+      if (threadTimes_.isAllocated()) {
+         for (int i = 0; i < size_*nThread_; i++) {
+            communicator.Allreduce(&threadTimes_[i], &sum, 1, 
+                                   MPI::DOUBLE, MPI::SUM);
+            threadTimes_[i] = sum/double(procs);
+         }
+      }
       communicator.Allreduce(&time_, &sum, 1, MPI::DOUBLE, MPI::SUM);
       time_ = sum/double(procs);
    }
@@ -64,4 +107,33 @@ namespace DdMd
    double DdTimer::time() const
    {  return time_; }
 
+   double DdTimer::maxThreadTime(int id) const
+   {
+      if (!threadTimes_.isAllocated()) {
+         return times_[id];
+      }
+      double max = 0.0;
+      for (int i = 0; i < nThread_; i++) {
+         if (threadTimes_[id*nThread_ + i] > max) {
+            max = threadTimes_[id*nThread_ + i];
+         }
+      }
+      return max;
+   }
+
+   double DdTimer::threadTime(int id) const
+   {
+      if (!threadTimes_.isAllocated()) {
+         return times_[id];
+      }
+      double sum = 0.0;
+      for (int i = 0; i < nThread_; i++) {
+         sum += threadTimes_[id*nThread_ + i];
+      }
+      return sum/double(nThread_);
+   }
+
+   int DdTimer::nThread() const
+   {  return nThread_; }
+
 }
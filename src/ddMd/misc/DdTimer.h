@@ -49,11 +49,51 @@ namespace DdMd
       */ 
       void stop();
 
+      /**
+      * Allocate and clear per-thread times, for nThread threads.
+      *
+      * \param nThread number of threads per processor
+      */
+      void setNThread(int nThread);
+
+      /**
+      * Mark end of the work of the calling thread within interval id.
+      *
+      * This may be called by every thread within a parallel region
+      * before the stamp(id) call that ends the interval. It adds the
+      * time since the previous stamp to an accumulator for the calling
+      * thread, and so measures the time spent by each thread before
+      * reaching the barrier at the end of the region. Does nothing if
+      * setNThread() has not been called with nThread > 1.
+      *
+      * \param id interval id
+      */
+      void stampThread(int id);
+
       /**
       * Get accumulated time for interval i, average per processor.
       */ 
       double time(int id) const;
 
+      /**
+      * Get maximum over threads of per-thread times for interval id.
+      *
+      * \param id interval id
+      */ 
+      double maxThreadTime(int id) const;
+
+      /**
+      * Get average over threads of per-thread times for interval id.
+      *
+      * \param id interval id
+      */ 
+      double threadTime(int id) const;
+
+      /**
+      * Get number of threads for which times are recorded.
+      */ 
+      int nThread() const;
+
       /**
       * Get total time since start time, average per processor.
       */ 
@@ -69,10 +109,12 @@ namespace DdMd
    private:
    
       DArray<double> times_;
+      DArray<double> threadTimes_;
       double previous_;
       double begin_;
       double time_;
       int    size_;
+      int    nThread_;
 
    };
 
@@ -0,0 +1,36 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "Threads.h"
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   // Define and initialize static member.
+   int Threads::nThread_ = 1;
+
+   /*
+   * Set the number of threads per processor.
+   */
+   void Threads::setNThread(int nThread)
+   {
+      if (nThread < 1) {
+         UTIL_THROW("Number of threads must be positive");
+      }
+      #ifdef DDMD_OPENMP
+      omp_set_num_threads(nThread);
+      #else
+      if (nThread > 1) {
+         UTIL_THROW("Multiple threads require compilation with DDMD_OPENMP");
+      }
+      #endif
+      nThread_ = nThread;
+   }
+
+}
@@ -0,0 +1,100 @@
+#ifndef DDMD_THREADS_H
+#define DDMD_THREADS_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/global.h>
+
+#ifdef DDMD_OPENMP
+#include <omp.h>
+#endif
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /**
+   * Number of shared-memory threads used by each processor.
+   *
+   * If the DdMd library is compiled with DDMD_OPENMP defined, loops
+   * over pairs, groups and atoms in force and integrator calculations
+   * are divided among nThread() OpenMP threads within each MPI process.
+   * The number of threads is set by the -t command line option of the
+   * ddSim program, and is 1 by default. If DDMD_OPENMP is not defined,
+   * nThread() is always 1 and threadId() is always 0.
+   */
+   class Threads
+   {
+
+   public:
+
+      /**
+      * Set the number of threads per processor.
+      *
+      * Throws an Exception if nThread < 1, or if nThread > 1 and
+      * DDMD_OPENMP is not defined.
+      *
+      * \param nThread number of threads per MPI process.
+      */
+      static void setNThread(int nThread);
+
+      /**
+      * Get the number of threads per processor.
+      */
+      static int nThread();
+
+      /**
+      * Get the id of the calling thread (0 <= id < nThread).
+      *
+      * Returns 0 if called outside a parallel region.
+      */
+      static int threadId();
+
+      /**
+      * Get the number of threads in the current team.
+      *
+      * Inside a parallel region, this may be less than nThread() if the
+      * OpenMP runtime provides fewer threads than requested, so work
+      * must be divided among nTeamThread() threads. Returns 1 outside 
+      * a parallel region.
+      */
+      static int nTeamThread();
+
+   private:
+
+      /// Number of threads per processor.
+      static int nThread_;
+
+   };
+
+   // Inline functions
+
+   inline int Threads::nThread()
+   {  return nThread_; }
+
+   inline int Threads::threadId()
+   {
+      #ifdef DDMD_OPENMP
+      return omp_get_thread_num();
+      #else
+      return 0;
+      #endif
+   }
+
+   inline int Threads::nTeamThread()
+   {
+      #ifdef DDMD_OPENMP
+      return omp_get_num_threads();
+      #else
+      return 1;
+      #endif
+   }
+
+}
+#endif
@@ -1,5 +1,6 @@
 ddMd_misc_=\
    ddMd/misc/DdTimer.cpp \
+   ddMd/misc/Threads.cpp \
    ddMd/misc/initStatic.cpp
 
 ddMd_misc_SRCS=\
@@ -100,25 +100,34 @@ namespace DdMd
 
    private:
  
-      /// Array of const pointers to primary atom in each pair.
-      Atom* const* atom1Ptrs_;  
+      /// Array of indices of primary atom in each pair.
+      const int*   atom1Ids_;  
 
-      /// Array of const pointers to secondary atom in each pair.
-      Atom* const* atom2Ptrs_;  
+      /// Array of indices of secondary atom in each pair.
+      const int*   atom2Ids_;  
 
-      /// Pointer to const index in atom2Ptrs_ of first neighbor of an Atom.
+      /// Pointer to const index in atom2Ids_ of first neighbor of an Atom.
       const int*   first_; 
 
-      /// Number of primary atoms in atom1Ptrs_.
+      /// Address of first element of local atom array.
+      Atom*  atoms_;
+
+      /// Address of first element of ghost atom array.
+      Atom*  ghosts_;
+
+      /// Number of elements in local atom array (index offset for ghosts).
+      int    atomCapacity_;
+
+      /// Number of primary atoms in atom1Ids_.
       int    nAtom1_;      
   
-      /// Number of secondary atoms in atom2Ptrs_.
+      /// Number of secondary atoms in atom2Ids_.
       int    nAtom2_;      
   
-      /// Current index of first atom in atom1Ptrs_.
+      /// Current index of first atom in atom1Ids_.
       int    atom1Id_;
 
-      /// Current index of second atom in atom2Ptrs_.
+      /// Current index of second atom in atom2Ids_.
       int    atom2Id_;
 
    // friends:
@@ -131,9 +140,12 @@ namespace DdMd
    * Default constructor.
    */
    inline PairIterator::PairIterator()
-    : atom1Ptrs_(0),
-      atom2Ptrs_(0),
+    : atom1Ids_(0),
+      atom2Ids_(0),
       first_(0),
+      atoms_(0),
+      ghosts_(0),
+      atomCapacity_(0),
       nAtom1_(0),
       nAtom2_(0),
       atom1Id_(0),
@@ -144,9 +156,12 @@ namespace DdMd
    * Constructor, initialized iterator.
    */
    inline PairIterator::PairIterator(const PairList &pairList)
-    : atom1Ptrs_(0),
-      atom2Ptrs_(0),
+    : atom1Ids_(0),
+      atom2Ids_(0),
       first_(0),
+      atoms_(0),
+      ghosts_(0),
+      atomCapacity_(0),
       nAtom1_(0),
       nAtom2_(0),
       atom1Id_(0),
@@ -162,8 +177,12 @@ namespace DdMd
       assert(atom1Id_ < nAtom1_);
       assert(atom2Id_ >=0);
       assert(atom2Id_ < nAtom2_);
-      atom1Ptr = atom1Ptrs_[atom1Id_];
-      atom2Ptr = atom2Ptrs_[atom2Id_];
+      int id = atom1Ids_[atom1Id_];
+      atom1Ptr = (id < atomCapacity_) ? atoms_ + id 
+                                      : ghosts_ + (id - atomCapacity_);
+      id = atom2Ids_[atom2Id_];
+      atom2Ptr = (id < atomCapacity_) ? atoms_ + id 
+                                      : ghosts_ + (id - atomCapacity_);
    }
  
    /*
@@ -10,8 +10,11 @@
 #include <ddMd/chemistry/Atom.h>
 #include <util/space/Vector.h>
 #include <util/format/Int.h>
+#include <util/format/Dbl.h>
 #include <util/global.h>
 
+#include <cstdlib>
+
 namespace DdMd
 {
 
@@ -21,10 +24,14 @@ namespace DdMd
    * Default constructor.
    */
    PairList::PairList()
-    : atom1Ptrs_(),
-      atom2Ptrs_(),
+    : atom1Ids_(),
+      atom2Ids_(),
       first_(),
+      firstGhost_(),
+      atoms_(0),
+      ghosts_(0),
       cutoff_(0.0),
+      nInteriorPair_(0),
       atomCapacity_(0),
       pairCapacity_(0),
       maxNAtomLocal_(0),
@@ -32,6 +39,9 @@ namespace DdMd
       buildCounter_(0),
       maxNAtom_(0),
       maxNPair_(0),
+      separationSumLocal_(0.0),
+      separationCountLocal_(0.0),
+      meanLocalSeparation_(),
       isAllocated_(false)
    {}
    
@@ -50,21 +60,33 @@ namespace DdMd
       pairCapacity_ = pairCapacity;
       cutoff_       = cutoff;
 
-      atom1Ptrs_.reserve(atomCapacity_);
-      atom2Ptrs_.reserve(pairCapacity_);
+      atom1Ids_.reserve(atomCapacity_);
+      atom2Ids_.reserve(pairCapacity_);
       first_.reserve(atomCapacity_ + 1);
+      firstGhost_.reserve(atomCapacity_);
   
       isAllocated_ = true;
    }
 
+   /*
+   * Set addresses of local and ghost atom arrays.
+   */
+   void PairList::setAtomArrays(Atom* atoms, Atom* ghosts)
+   {
+      atoms_  = atoms;
+      ghosts_ = ghosts;
+   }
+
    /*
    * Clear the PairList.
    */
    void PairList::clear()
    { 
-      atom1Ptrs_.clear();
-      atom2Ptrs_.clear();
+      atom1Ids_.clear();
+      atom2Ids_.clear();
       first_.clear();
+      firstGhost_.clear();
+      nInteriorPair_ = 0;
    }
  
    /*
@@ -72,11 +94,17 @@ namespace DdMd
    */
    void PairList::build(CellList& cellList, bool reverseUpdateFlag)
    {
-      // Precondition
+      // Preconditions
       assert(isAllocated());
+      if (atoms_ == 0) {
+         UTIL_THROW("Atom arrays not set");
+      }
  
       Cell::NeighborArray neighbors;
+      int ghostIds[Cell::MaxNeighborAtom];
       double cutoffSq;
+      double separationSum = 0.0;
+      double separationCount = 0.0;
       const Cell* cellPtr;
       CellAtom* atom1Ptr;
       CellAtom* atom2Ptr;
@@ -84,17 +112,21 @@ namespace DdMd
       Vector dr;
       int na;                 // number of atoms in this cell
       int nn;                 // number of neighbors for a cell
+      int ng;                 // number of ghost neighbors of atom1
       int i, j;
+      int id1, id2;
       bool hasNeighbor;
   
       // Set maximum squared-separation for pairs in Pairlist
       cutoffSq = cutoff_*cutoff_;
    
       // Initialize counters for primary atoms and neighbors
-      atom1Ptrs_.clear();
-      atom2Ptrs_.clear();
+      atom1Ids_.clear();
+      atom2Ids_.clear();
       first_.clear();
+      firstGhost_.clear();
       first_.append(0);
+      nInteriorPair_ = 0;
 
       // Copy positions and ids into cell list
       cellList.update();
@@ -112,22 +144,39 @@ namespace DdMd
             for (i = 0; i < na; ++i) {
                atom1Ptr = neighbors[i];
                maskPtr  = atom1Ptr->maskPtr();
+               id1 = atomId(atom1Ptr->ptr());
    
-               // Loop over secondary atoms
+               // Loop over secondary atoms. Append local neighbors to
+               // atom2Ids_, and hold ghost neighbors in ghostIds.
                hasNeighbor = false;
+               ng = 0;
                for (j = i + 1; j < nn; ++j) {
                   atom2Ptr = neighbors[j];
                   dr.subtract(atom2Ptr->position(), atom1Ptr->position()); 
                   if (dr.square() < cutoffSq && !maskPtr->isMasked(atom2Ptr->id())) {
-                     atom2Ptrs_.append(atom2Ptr->ptr());
+                     id2 = atomId(atom2Ptr->ptr());
+                     if (id2 < atomCapacity_) {
+                        atom2Ids_.append(id2);
+                        separationSum += double(std::abs(id2 - id1));
+                        separationCount += 1.0;
+                     } else {
+                        ghostIds[ng] = id2;
+                        ++ng;
+                     }
                      hasNeighbor = true;
                   }
                }
 
-               // Complete processing of atom1.
+               // Complete processing of atom1: Append ghost neighbors
+               // after local neighbors.
                if (hasNeighbor) {
-                  atom1Ptrs_.append(atom1Ptr->ptr());
-                  first_.append(atom2Ptrs_.size());
+                  atom1Ids_.append(id1);
+                  firstGhost_.append(atom2Ids_.size());
+                  nInteriorPair_ += atom2Ids_.size() - first_[first_.size()-1];
+                  for (j = 0; j < ng; ++j) {
+                     atom2Ids_.append(ghostIds[j]);
+                  }
+                  first_.append(atom2Ids_.size());
                }
 
             } // for ia 
@@ -138,14 +187,14 @@ namespace DdMd
       }
 
       // Postconditions
-      if (atom1Ptrs_.size()) {
-         if (first_.size() != atom1Ptrs_.size() + 1) {
+      if (atom1Ids_.size()) {
+         if (first_.size() != atom1Ids_.size() + 1) {
             UTIL_THROW("Array size problem");
          }
          if (first_[0] != 0) {
             UTIL_THROW("Incorrect first element of first_");
          }
-         if (first_[atom1Ptrs_.size()] != atom2Ptrs_.size()) {
+         if (first_[atom1Ids_.size()] != atom2Ids_.size()) {
             UTIL_THROW("Incorrect last element of first_");
          }
       }
@@ -154,25 +203,86 @@ namespace DdMd
       ++buildCounter_;
  
       // Increment maxima
-      if (atom1Ptrs_.size() > maxNAtomLocal_) {
-         maxNAtomLocal_ = atom1Ptrs_.size();
+      if (atom1Ids_.size() > maxNAtomLocal_) {
+         maxNAtomLocal_ = atom1Ids_.size();
       }
-      if (atom2Ptrs_.size() > maxNPairLocal_) {
-         maxNPairLocal_ = atom2Ptrs_.size();
+      if (atom2Ids_.size() > maxNPairLocal_) {
+         maxNPairLocal_ = atom2Ids_.size();
+      }
+
+      // Increment locality statistics
+      separationSumLocal_ += separationSum;
+      separationCountLocal_ += separationCount;
+   }
+
+   /*
+   * Return index of a local or ghost atom (private).
+   */
+   int PairList::atomId(const Atom* ptr) const
+   {
+      if (ptr >= atoms_ && ptr < atoms_ + atomCapacity_) {
+         return int(ptr - atoms_);
+      } else {
+         assert(ptr >= ghosts_);
+         return atomCapacity_ + int(ptr - ghosts_);
       }
    }
 
+   /*
+   * Get a range of primary atoms containing a share of the pairs.
+   */
+   void 
+   PairList::getAtomRange(int nRange, int iRange, int& begin, int& end) const
+   {
+      assert(nRange > 0);
+      assert(iRange >= 0);
+      assert(iRange < nRange);
+      int nPair = atom2Ids_.size();
+      if (iRange == 0) {
+         begin = 0;
+      } else {
+         begin = firstAtom((long)nPair*iRange/nRange);
+      }
+      if (iRange == nRange - 1) {
+         end = atom1Ids_.size();
+      } else {
+         end = firstAtom((long)nPair*(iRange + 1)/nRange);
+      }
+   }
+
+   /*
+   * Binary search for first primary atom with first_[i] >= nPairMin.
+   */
+   int PairList::firstAtom(int nPairMin) const
+   {
+      int lower = 0;
+      int upper = atom1Ids_.size();
+      int mid;
+      while (lower < upper) {
+         mid = (lower + upper)/2;
+         if (first_[mid] < nPairMin) {
+            lower = mid + 1;
+         } else {
+            upper = mid;
+         }
+      }
+      return lower;
+   }
+
    /*
    * Initialize a pair iterator.
    */
    void PairList::begin(PairIterator& iterator) const
    {
-      if (atom1Ptrs_.size()) {
-         iterator.atom1Ptrs_ = &atom1Ptrs_[0];
-         iterator.atom2Ptrs_ = &atom2Ptrs_[0];
+      if (atom1Ids_.size()) {
+         iterator.atom1Ids_  = &atom1Ids_[0];
+         iterator.atom2Ids_  = &atom2Ids_[0];
          iterator.first_     = &first_[0];
-         iterator.nAtom1_    = atom1Ptrs_.size();
-         iterator.nAtom2_    = atom2Ptrs_.size();
+         iterator.atoms_     = atoms_;
+         iterator.ghosts_    = ghosts_;
+         iterator.atomCapacity_ = atomCapacity_;
+         iterator.nAtom1_    = atom1Ids_.size();
+         iterator.nAtom2_    = atom2Ids_.size();
          iterator.atom1Id_   = 0;
          iterator.atom2Id_   = 0;
       }
@@ -198,9 +308,26 @@ namespace DdMd
       maxNPair_.set(maxNPairGlobal);
       maxNAtomLocal_ = maxNAtomGlobal;
       maxNPairLocal_ = maxNPairGlobal;
+
+      double separationLocal[2];
+      double separationGlobal[2];
+      separationLocal[0] = separationSumLocal_;
+      separationLocal[1] = separationCountLocal_;
+      communicator.Allreduce(separationLocal, separationGlobal, 2, 
+                             MPI::DOUBLE, MPI::SUM);
+      if (separationGlobal[1] > 0.0) {
+         meanLocalSeparation_.set(separationGlobal[0]/separationGlobal[1]);
+      } else {
+         meanLocalSeparation_.set(0.0);
+      }
       #else
       maxNAtom_.set(maxNAtomLocal_);
       maxNPair_.set(maxNPairLocal_);
+      if (separationCountLocal_ > 0.0) {
+         meanLocalSeparation_.set(separationSumLocal_/separationCountLocal_);
+      } else {
+         meanLocalSeparation_.set(0.0);
+      }
       #endif
    }
 
@@ -213,6 +340,9 @@ namespace DdMd
       maxNPairLocal_ = 0;
       maxNAtom_.unset();
       maxNPair_.unset();
+      separationSumLocal_ = 0.0;
+      separationCountLocal_ = 0.0;
+      meanLocalSeparation_.unset();
       buildCounter_ = 0;
    }
 
@@ -232,6 +362,24 @@ namespace DdMd
                   << Int(maxNAtom_.value(), 10)
                   << Int(atomCapacity_, 10)
                   << std::endl;
+      out << "Bytes per pair           " 
+                  << Dbl(bytesPerPair(), 10, 3)
+                  << std::endl;
+      out << "Mean local separation    " 
+                  << Dbl(meanLocalSeparation_.value(), 10, 3)
+                  << std::endl;
+   }
+
+   /*
+   * Return memory usage per pair, in bytes.
+   */
+   double PairList::bytesPerPair() const
+   {
+      int nPair = maxNPair_.value();
+      int nAtom = maxNAtom_.value();
+      if (nPair == 0) return 0.0;
+      double bytes = double(sizeof(int))*double(nPair + 3*nAtom + 1);
+      return bytes/double(nPair);
    }
 
 } 
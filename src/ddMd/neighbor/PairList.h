@@ -36,6 +36,11 @@ namespace DdMd
    * A PairIterator object must be used to iterate over all of the pairs in
    * in completed PairList (see documentation of PairIterator for usage).
    *
+   * Pairs are stored in compact form as 32 bit integer atom indices, 
+   * rather than Atom* pointers. Before building, setAtomArrays() must be
+   * called to define the arrays of local and ghost atoms to which these
+   * indices refer.
+   *
    * \ingroup DdMd_Neighbor_Module
    */
    class PairList 
@@ -45,6 +50,17 @@ namespace DdMd
       static const int NullIndex = -1;   
 
    public:
+
+      /**
+      * Subsets of the neighbors of a primary atom.
+      *
+      * Neighbors of each primary atom are stored with all local atoms 
+      * before all ghost atoms. INTERIOR pairs are those in which both 
+      * atoms are local, BOUNDARY pairs are those in which the neighbor is 
+      * a ghost, and ALL includes both. Forces for INTERIOR pairs may be 
+      * computed before ghost positions are updated.
+      */
+      enum PairSet {ALL, INTERIOR, BOUNDARY};
   
       /**
       * Default constructor.
@@ -68,6 +84,22 @@ namespace DdMd
       */
       void allocate(int atomCapacity, int pairCapacity, double cutoff);
 
+      /**
+      * Set the arrays of local and ghost atoms indexed by this list.
+      *
+      * Atoms are identified within the list by integer indices: The atom
+      * at element k of the local atom array has index k, and the atom at
+      * element k of the ghost atom array has index atomCapacity + k, where
+      * atomCapacity is the value passed to allocate(). This is the same
+      * scheme used to index the AtomStorage mirror, so that the indices
+      * returned by getNeighbors() may be used to access mirror arrays
+      * (see AtomStorage::mirrorId).
+      *
+      * \param atoms  address of first element of local atom array
+      * \param ghosts address of first element of ghost atom array
+      */
+      void setAtomArrays(Atom* atoms, Atom* ghosts);
+
       /**
       * Reset this to empty state.
       */  
@@ -91,6 +123,59 @@ namespace DdMd
       * \param iterator a PairList, initialized on output
       */
       void begin(PairIterator &iterator) const;
+
+      /**
+      * Get a primary atom and the contiguous run of its neighbors.
+      *
+      * This provides direct access to the list in the form used by the
+      * force kernels that operate on an AtomMirror, which process all
+      * neighbors of one primary atom as a single block. Atoms are 
+      * identified by indices (see setAtomArrays).
+      *
+      * \param i        index of primary atom, 0 <= i < nAtom()
+      * \param atom1Id  on output, index of primary atom i
+      * \param atom2Ids on output, C array of indices of its neighbors
+      * \return number of neighbors of primary atom i
+      */
+      int getNeighbors(int i, int& atom1Id, const int*& atom2Ids) const;
+
+      /**
+      * Get a primary atom and the run of its neighbors in a subset.
+      *
+      * Identical to getNeighbors(i, atom1Id, atom2Ids) for set == ALL.
+      * For set == INTERIOR or BOUNDARY, returns only neighbors that are
+      * local or ghost atoms, respectively.
+      *
+      * \param i        index of primary atom, 0 <= i < nAtom()
+      * \param atom1Id  on output, index of primary atom i
+      * \param atom2Ids on output, C array of indices of neighbors in set
+      * \param set      subset of neighbors (ALL, INTERIOR or BOUNDARY)
+      * \return number of neighbors of primary atom i in set
+      */
+      int getNeighbors(int i, int& atom1Id, const int*& atom2Ids, 
+                       PairSet set) const;
+
+      /**
+      * Get a contiguous range of primary atoms containing a share of pairs.
+      *
+      * Divides the primary atoms into nRange contiguous ranges that each
+      * contain approximately nPair()/nRange pairs, and returns the range
+      * with index iRange, as primary atom indices begin <= i < end. This
+      * is used to divide the list among threads. 
+      *
+      * \param nRange  number of ranges
+      * \param iRange  index of the desired range, 0 <= iRange < nRange
+      * \param begin   on output, index of first primary atom in range
+      * \param end     on output, index one past the last atom in range
+      */
+      void getAtomRange(int nRange, int iRange, int& begin, int& end) const;
+
+      /**
+      * Return a pointer to the atom with a specified index.
+      *
+      * \param id atom index, as stored in this list
+      */
+      Atom* atomPtr(int id) const;
  
       /**
       * Get the number of primary atoms in the PairList.
@@ -102,6 +187,11 @@ namespace DdMd
       */
       int nPair() const;
 
+      /**
+      * Get the number of INTERIOR pairs (pairs of local atoms).
+      */
+      int nInteriorPair() const;
+
       /**
       * Get the maximum number of pairs. 
       */
@@ -160,6 +250,25 @@ namespace DdMd
       */
       int maxNPair() const;
 
+      /**
+      * Get memory used by the list, in bytes per pair.
+      *
+      * Computed from maxNPair() and maxNAtom(). Call only on master.
+      */
+      double bytesPerPair() const;
+
+      /**
+      * Get mean index separation of local pairs since stats cleared.
+      *
+      * This is the average of |i - j| for pairs of local atoms with
+      * indices i and j, which is a measure of the locality in memory of
+      * the atoms visited by a loop over pairs. It decreases when atoms
+      * are sorted in space (see AtomStorage::sortAtoms). 
+      *
+      * Call only on master, after computeStatistics().
+      */
+      double meanLocalSeparation() const;
+
       /**
       * Return number of times the PairList has been built thus far.
       */
@@ -169,22 +278,34 @@ namespace DdMd
 
    private:
   
-      /// Array of pointers to 1st (or primary) atom in each pair.
-      GArray<Atom*>  atom1Ptrs_;  
+      /// Array of indices of 1st (or primary) atom in each pair.
+      GArray<int>  atom1Ids_;  
 
-      /// Array of pointers to neighbor (or secondary) atom in each pair.
-      GArray<Atom*>  atom2Ptrs_;  
+      /// Array of indices of neighbor (or secondary) atom in each pair.
+      GArray<int>  atom2Ids_;  
 
-      /// Array of indices in atom2Ptrs_ of first neighbor of an Atom.
+      /// Array of indices in atom2Ids_ of first neighbor of an Atom.
       GArray<int>  first_; 
 
+      /// Array of indices in atom2Ids_ of first ghost neighbor of an Atom.
+      GArray<int>  firstGhost_; 
+
+      /// Address of first element of local atom array.
+      Atom*  atoms_;
+
+      /// Address of first element of ghost atom array.
+      Atom*  ghosts_;
+
       /// Pair list cutoff radius (pair potential cutoff + skin_).
       double cutoff_;
+
+      /// Number of pairs in which both atoms are local.
+      int  nInteriorPair_;
    
-      /// Maximum number of atoms (dimension of atom1Ptrs_).
+      /// Maximum number of atoms (dimension of atom1Ids_).
       int  atomCapacity_;     
    
-      /// Maximum number of distinct pairs (dimension of atom2Ptrs_).
+      /// Maximum number of distinct pairs (dimension of atom2Ids_).
       int  pairCapacity_;     
    
       /// Maximum number of primary atoms on this proc since stats cleared.
@@ -201,23 +322,49 @@ namespace DdMd
    
       /// Maximum of number of pairs on all procs (defined only on master).
       Setable<int>  maxNPair_;     
+
+      /// Sum of |i - j| for local pairs on this proc since stats cleared.
+      double  separationSumLocal_;
+
+      /// Number of local pairs on this proc since stats cleared.
+      double  separationCountLocal_;
+
+      /// Mean of |i - j| for local pairs on all procs (master only).
+      Setable<double>  meanLocalSeparation_;
    
       /// Has memory been allocated?
       bool  isAllocated_;
+
+      /**
+      * Return the index of a local or ghost atom.
+      *
+      * \param ptr pointer to an atom in the local or ghost array
+      */
+      int atomId(const Atom* ptr) const;
+
+      /**
+      * Return smallest primary atom index i with first_[i] >= nPairMin.
+      */
+      int firstAtom(int nPairMin) const;
   
       /* 
       * Implementation Notes:
       *
-      * The pair list is stored in Atom* pointer arrays atom1Ptrs_, atom2Ptrs_, 
-      * and in an integer array first_. Each element of atom1Ptrs_ contains a 
-      * pointer to the first atom in a pair (the primary Atom). Each element 
-      * of atom2Ptrs_ contains a pointer to the second atom in a pair (the 
-      * secondary Atom).  Secondary atoms that are neighbors of the same 
-      * primary atom are listed consecutively.  Element first_[i] contains the 
-      * array index of the first element in atom2Ptrs_ that contains a neighbor 
-      * of primary atom atom1Ptrs_[i]. Pointers to neighbors of primary atom
-      * *atom1Ptrs_[i] are thus stored in elements first_[i] <= j < first_[i+1]
-      * of atom2Ptrs_.  Each pair is included only once.
+      * The pair list is stored in integer arrays atom1Ids_, atom2Ids_, 
+      * and first_. Each element of atom1Ids_ contains the index of the 
+      * first atom in a pair (the primary Atom). Each element of atom2Ids_
+      * contains the index of the second atom in a pair (the secondary 
+      * Atom). Indices are converted to Atom* pointers by atomPtr(), using 
+      * the arrays set by setAtomArrays(). Secondary atoms that are 
+      * neighbors of the same primary atom are listed consecutively. 
+      * Element first_[i] contains the array index of the first element in
+      * atom2Ids_ that contains a neighbor of primary atom atom1Ids_[i]. 
+      * Indices of neighbors of primary atom atom1Ids_[i] are thus stored 
+      * in elements first_[i] <= j < first_[i+1] of atom2Ids_.  Each pair 
+      * is included only once. Within this range, neighbors that are local
+      * atoms precede those that are ghosts, and element firstGhost_[i] 
+      * contains the index of the first ghost neighbor (or first_[i+1] if
+      * there is none).
       *
       * The only way legal way to loop over all atom pairs, using the public 
       * interface of a PairList, is to use a PairListIterator. See the 
@@ -230,12 +377,12 @@ namespace DdMd
       *    Atom* atom2Ptr;
       *
       *    \\ Loop over primary Atoms
-      *    for (i = 0; i < atom1Ptrs_.size(); ++i) {
-      *       atom1Ptr = atom1Ptrs_[i];
+      *    for (i = 0; i < atom1Ids_.size(); ++i) {
+      *       atom1Ptr = atomPtr(atom1Ids_[i]);
       *
       *       // Loop over secondary atoms
       *       for (j = first_[i]; j < first_[i+1]; ++j) {
-      *           atom2Ptr = atom2Ptrs_[j];
+      *           atom2Ptr = atomPtr(atom2Ids_[j]);
       *
       *           // ... Do something with Atoms *atom1Ptr and *atom2Ptr.
       *
@@ -243,7 +390,7 @@ namespace DdMd
       *    }
       *
       * Note that GArray<int> first_ contains one more elements than 
-      * atom1Ptrs_. The element first_[0] is equal to 0, and the last 
+      * atom1Ids_. The element first_[0] is equal to 0, and the last 
       * element is always equal to the total number of pairs.
       */
 
@@ -253,13 +400,60 @@ namespace DdMd
    * Get the current number of primary atoms in the pairlist.
    */ 
    inline int PairList::nAtom() const
-   {  return atom1Ptrs_.size(); }
+   {  return atom1Ids_.size(); }
 
    /*
    * Get the current number of pairs.
    */ 
    inline int PairList::nPair() const
-   {  return atom2Ptrs_.size(); }
+   {  return atom2Ids_.size(); }
+
+   /*
+   * Get a primary atom and the run of its neighbors.
+   */ 
+   inline 
+   int PairList::getNeighbors(int i, int& atom1Id, const int*& atom2Ids) const
+   {
+      assert(i >= 0);
+      assert(i < atom1Ids_.size());
+      atom1Id  = atom1Ids_[i];
+      atom2Ids = &atom2Ids_[first_[i]];
+      return first_[i+1] - first_[i];
+   }
+
+   /*
+   * Get a primary atom and the run of its neighbors in a subset.
+   */ 
+   inline 
+   int PairList::getNeighbors(int i, int& atom1Id, const int*& atom2Ids,
+                              PairSet set) const
+   {
+      assert(i >= 0);
+      assert(i < atom1Ids_.size());
+      int begin = (set == BOUNDARY) ? firstGhost_[i] : first_[i];
+      int end = (set == INTERIOR) ? firstGhost_[i] : first_[i+1];
+      atom1Id  = atom1Ids_[i];
+      atom2Ids = &atom2Ids_[0] + begin;
+      return end - begin;
+   }
+
+   /*
+   * Get the number of pairs of local atoms.
+   */ 
+   inline int PairList::nInteriorPair() const
+   {  return nInteriorPair_; }
+
+   /*
+   * Return pointer to the atom with a specified index.
+   */ 
+   inline Atom* PairList::atomPtr(int id) const
+   {
+      if (id < atomCapacity_) {
+         return atoms_ + id;
+      } else {
+         return ghosts_ + (id - atomCapacity_);
+      }
+   }
 
    /**
    * Get the maximum number of pairs. 
@@ -285,6 +479,12 @@ namespace DdMd
    inline int PairList::maxNPair() const
    { return maxNPair_.value(); }
 
+   /*
+   * Get the mean index separation of local pairs.
+   */ 
+   inline double PairList::meanLocalSeparation() const
+   { return meanLocalSeparation_.value(); }
+
    /*
    * Get the number of times this PairList has been built.
    */ 
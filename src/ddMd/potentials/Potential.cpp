@@ -18,7 +18,9 @@ namespace DdMd
    Potential::Potential()
     : stress_(),
       energy_(),
-      reverseUpdateFlag_(false)
+      reverseUpdateFlag_(false),
+      threadTimerPtr_(0),
+      threadTimerId_(0)
    { setClassName("Potential"); }
 
    /*
@@ -33,6 +35,15 @@ namespace DdMd
    void Potential::setReverseUpdateFlag(bool reverseUpdateFlag)
    { reverseUpdateFlag_ = reverseUpdateFlag; }
 
+   /*
+   * Set a timer for per-thread times.
+   */
+   void Potential::setThreadTimer(DdTimer& timer, int timerId)
+   {
+      threadTimerPtr_ = &timer;
+      threadTimerId_ = timerId;
+   }
+
    /*
    * Get the value of the total energy.
    */
@@ -4,6 +4,7 @@
 #include <util/param/ParamComposite.h>  // base class
 #include <util/misc/Setable.h>          // template for members
 #include <util/space/Tensor.h>          // parameter for member
+#include <ddMd/misc/DdTimer.h>          // inline function
 
 /*
 * Simpatico - Simulation Package for Polymeric and Molecular Liquids
@@ -52,6 +53,17 @@ namespace DdMd
       */
       bool reverseUpdateFlag() const;
 
+      /**
+      * Set a timer in which to record per-thread force computation times.
+      *
+      * If set, computeForces() records the time spent by each thread in 
+      * interval timerId of the timer. See DdTimer::stampThread().
+      *
+      * \param timer    associated timer (usually owned by an Integrator)
+      * \param timerId  index of interval for force computation
+      */
+      void setThreadTimer(DdTimer& timer, int timerId);
+
       /// \name Total Energy, Force and Stress 
       //@{
 
@@ -212,6 +224,14 @@ namespace DdMd
       void reduceStress();
       #endif
 
+      /**
+      * Record time for the calling thread, if a thread timer is set.
+      *
+      * Call from all threads within a parallel region of computeForces,
+      * after each thread completes its share of the work.
+      */
+      void stampThread();
+
    private:
 
       /// Total stress.
@@ -223,11 +243,27 @@ namespace DdMd
       /// Is reverse update communication enabled?
       bool reverseUpdateFlag_;
 
+      /// Pointer to timer for per-thread times (null if not set).
+      DdTimer* threadTimerPtr_;
+
+      /// Interval index of per-thread times in the timer.
+      int threadTimerId_;
+
    };
 
    inline bool Potential::reverseUpdateFlag() const
    {  return reverseUpdateFlag_; }
 
+   /*
+   * Record time for calling thread (protected).
+   */
+   inline void Potential::stampThread()
+   {
+      if (threadTimerPtr_) {
+         threadTimerPtr_->stampThread(threadTimerId_);
+      }
+   }
+
    /*
    * Add a pair contribution to the virial tensor (protected).
    */
@@ -185,6 +185,18 @@ namespace DdMd
       */
       bool isInitialized_;
 
+      #ifdef DDMD_OPENMP
+      /**
+      * Derivatives f1, f2 for each angle (used with multiple threads).
+      */
+      DArray<Vector> groupForces_;
+
+      /**
+      * Compute angle forces using multiple threads.
+      */
+      void computeForcesThreads();
+      #endif
+
    };
 
 }
@@ -193,8 +205,10 @@ namespace DdMd
 #include <ddMd/simulation/Simulation.h>
 #include <ddMd/storage/GroupStorage.h>
 #include <ddMd/storage/GroupIterator.h>
+#include <ddMd/misc/Threads.h>
 
 #include <util/boundary/Boundary.h>
+#include <util/containers/DArray.h>
 #include <util/space/Dimension.h>
 #include <util/space/Vector.h>
 #include <util/space/Tensor.h>
@@ -328,6 +342,13 @@ namespace DdMd
    template <class Interaction>
    void AnglePotentialImpl<Interaction>::computeForces()
    {  
+      #ifdef DDMD_OPENMP
+      if (Threads::nThread() > 1) {
+         computeForcesThreads();
+         return;
+      }
+      #endif
+
       Vector dr1; // R[1] - R[0]
       Vector dr2; // R[2] - R[1]
       Vector f1;  // d(energy)/d(dr1)
@@ -363,6 +384,63 @@ namespace DdMd
       }
    }
 
+   #ifdef DDMD_OPENMP
+   /*
+   * Increment atomic forces using multiple threads (private).
+   *
+   * Derivatives for each angle are computed in parallel and stored in
+   * groupForces_, then added to atomic forces by a serial loop in the
+   * same order as in computeForces(), giving identical results.
+   */
+   template <class Interaction>
+   void AnglePotentialImpl<Interaction>::computeForcesThreads()
+   {
+      if (!groupForces_.isAllocated()) {
+         groupForces_.allocate(2*storage().capacity());
+      }
+      int nGroup = storage().size();
+      #pragma omp parallel num_threads(Threads::nThread())
+      {
+         Vector dr1; // R[1] - R[0]
+         Vector dr2; // R[2] - R[1]
+         int i;
+         #pragma omp for schedule(static) nowait
+         for (i = 0; i < nGroup; ++i) {
+            Group<3>& group = storage().group(i);
+            boundary().distanceSq(group.atomPtr(1)->position(),
+                                  group.atomPtr(0)->position(), dr1);
+            boundary().distanceSq(group.atomPtr(2)->position(),
+                                  group.atomPtr(1)->position(), dr2);
+            interaction().force(dr1, dr2, groupForces_[2*i], 
+                                groupForces_[2*i+1], group.typeId());
+         }
+         stampThread();
+      }
+
+      Atom* atom0Ptr;
+      Atom* atom1Ptr;
+      Atom* atom2Ptr;
+      for (int i = 0; i < nGroup; ++i) {
+         Group<3>& group = storage().group(i);
+         const Vector& f1 = groupForces_[2*i];
+         const Vector& f2 = groupForces_[2*i+1];
+         atom0Ptr = group.atomPtr(0);
+         atom1Ptr = group.atomPtr(1);
+         atom2Ptr = group.atomPtr(2);
+         if (!atom0Ptr->isGhost()) {
+            atom0Ptr->force() += f1;
+         }
+         if (!atom1Ptr->isGhost()) {
+            atom1Ptr->force() -= f1;
+            atom1Ptr->force() += f2;
+         }
+         if (!atom2Ptr->isGhost()) {
+            atom2Ptr->force() -= f2;
+         }
+      }
+   }
+   #endif
+
    /*
    * Compute total angle energy on all processors.
    */
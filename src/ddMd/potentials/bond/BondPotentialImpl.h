@@ -206,6 +206,18 @@ namespace DdMd
       */
       bool isInitialized_;
 
+      #ifdef DDMD_OPENMP
+      /**
+      * Force on atom 0 of each bond (used with multiple threads).
+      */
+      DArray<Vector> groupForces_;
+
+      /**
+      * Compute bond forces using multiple threads.
+      */
+      void computeForcesThreads();
+      #endif
+
    };
 
 }
@@ -214,7 +226,9 @@ namespace DdMd
 #include <ddMd/simulation/Simulation.h>
 #include <ddMd/storage/GroupStorage.h>
 #include <ddMd/storage/GroupIterator.h>
+#include <ddMd/misc/Threads.h>
 #include <util/boundary/Boundary.h>
+#include <util/containers/DArray.h>
 #include <util/space/Vector.h>
 #include <util/global.h>
 
@@ -374,6 +388,13 @@ namespace DdMd
    template <class Interaction>
    void BondPotentialImpl<Interaction>::computeForces()
    {  
+      #ifdef DDMD_OPENMP
+      if (Threads::nThread() > 1) {
+         computeForcesThreads();
+         return;
+      }
+      #endif
+
       Vector f;
       double rsq;
       GroupIterator<2> iter;
@@ -402,6 +423,52 @@ namespace DdMd
       }
    }
 
+   #ifdef DDMD_OPENMP
+   /*
+   * Increment atomic forces using multiple threads (private).
+   *
+   * Bond forces are computed in parallel and stored in groupForces_, 
+   * then added to atomic forces by a serial loop in the same order as
+   * in computeForces(), giving results identical to the serial loop.
+   */
+   template <class Interaction>
+   void BondPotentialImpl<Interaction>::computeForcesThreads()
+   {
+      if (!groupForces_.isAllocated()) {
+         groupForces_.allocate(storage().capacity());
+      }
+      int nGroup = storage().size();
+      #pragma omp parallel num_threads(Threads::nThread())
+      {
+         double rsq;
+         int i;
+         #pragma omp for schedule(static) nowait
+         for (i = 0; i < nGroup; ++i) {
+            Group<2>& group = storage().group(i);
+            Vector& f = groupForces_[i];
+            rsq = boundary().distanceSq(group.atomPtr(0)->position(), 
+                                        group.atomPtr(1)->position(), f);
+            f *= interactionPtr_->forceOverR(rsq, group.typeId());
+         }
+         stampThread();
+      }
+
+      Atom* atom0Ptr;
+      Atom* atom1Ptr;
+      for (int i = 0; i < nGroup; ++i) {
+         Group<2>& group = storage().group(i);
+         atom0Ptr = group.atomPtr(0);
+         atom1Ptr = group.atomPtr(1);
+         if (!atom0Ptr->isGhost()) {
+            atom0Ptr->force() += groupForces_[i];
+         }
+         if (!atom1Ptr->isGhost()) {
+            atom1Ptr->force() -= groupForces_[i];
+         }
+      }
+   }
+   #endif
+
    /*
    * Compute total bond energy on all processors, store result on master.
    */
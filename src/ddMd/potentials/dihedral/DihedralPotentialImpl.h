@@ -212,6 +212,18 @@ namespace DdMd
       */
       bool isInitialized_;
 
+      #ifdef DDMD_OPENMP
+      /**
+      * Derivatives f1, f2, f3 for each dihedral (used with threads).
+      */
+      DArray<Vector> groupForces_;
+
+      /**
+      * Compute dihedral forces using multiple threads.
+      */
+      void computeForcesThreads();
+      #endif
+
    };
 
 }
@@ -220,7 +232,9 @@ namespace DdMd
 #include <ddMd/simulation/Simulation.h>
 #include <ddMd/storage/GroupStorage.h>
 #include <ddMd/storage/GroupIterator.h>
+#include <ddMd/misc/Threads.h>
 #include <util/boundary/Boundary.h>
+#include <util/containers/DArray.h>
 #include <util/space/Vector.h>
 #include <util/global.h>
 
@@ -374,6 +388,13 @@ namespace DdMd
    {
       UTIL_CHECK(isInitialized_);
 
+      #ifdef DDMD_OPENMP
+      if (Threads::nThread() > 1) {
+         computeForcesThreads();
+         return;
+      }
+      #endif
+
       Vector dr1; // R[1] - R[0]
       Vector dr2; // R[2] - R[1]
       Vector dr3; // R[3] - R[2]
@@ -420,6 +441,74 @@ namespace DdMd
       }
    }
 
+   #ifdef DDMD_OPENMP
+   /*
+   * Increment atomic forces using multiple threads (private).
+   *
+   * Derivatives for each dihedral are computed in parallel and stored
+   * in groupForces_, then added to atomic forces by a serial loop in 
+   * the same order as in computeForces(), giving identical results.
+   */
+   template <class Interaction>
+   void DihedralPotentialImpl<Interaction>::computeForcesThreads()
+   {
+      if (!groupForces_.isAllocated()) {
+         groupForces_.allocate(3*storage().capacity());
+      }
+      int nGroup = storage().size();
+      #pragma omp parallel num_threads(Threads::nThread())
+      {
+         Vector dr1; // R[1] - R[0]
+         Vector dr2; // R[2] - R[1]
+         Vector dr3; // R[3] - R[2]
+         int i;
+         #pragma omp for schedule(static) nowait
+         for (i = 0; i < nGroup; ++i) {
+            Group<4>& group = storage().group(i);
+            boundary().distanceSq(group.atomPtr(1)->position(),
+                                  group.atomPtr(0)->position(), dr1);
+            boundary().distanceSq(group.atomPtr(2)->position(),
+                                  group.atomPtr(1)->position(), dr2);
+            boundary().distanceSq(group.atomPtr(3)->position(),
+                                  group.atomPtr(2)->position(), dr3);
+            interaction().force(dr1, dr2, dr3, groupForces_[3*i], 
+                                groupForces_[3*i+1], groupForces_[3*i+2], 
+                                group.typeId());
+         }
+         stampThread();
+      }
+
+      Atom* atom0Ptr;
+      Atom* atom1Ptr;
+      Atom* atom2Ptr;
+      Atom* atom3Ptr;
+      for (int i = 0; i < nGroup; ++i) {
+         Group<4>& group = storage().group(i);
+         const Vector& f1 = groupForces_[3*i];
+         const Vector& f2 = groupForces_[3*i+1];
+         const Vector& f3 = groupForces_[3*i+2];
+         atom0Ptr = group.atomPtr(0);
+         atom1Ptr = group.atomPtr(1);
+         atom2Ptr = group.atomPtr(2);
+         atom3Ptr = group.atomPtr(3);
+         if (!atom0Ptr->isGhost()) {
+            atom0Ptr->force() += f1;
+         }
+         if (!atom1Ptr->isGhost()) {
+            atom1Ptr->force() -= f1;
+            atom1Ptr->force() += f2;
+         }
+         if (!atom2Ptr->isGhost()) {
+            atom2Ptr->force() -= f2;
+            atom2Ptr->force() += f3;
+         }
+         if (!atom3Ptr->isGhost()) {
+            atom3Ptr->force() -= f3;
+         }
+      }
+   }
+   #endif
+
    /*
    * Compute total dihedral energy on all processors.
    */
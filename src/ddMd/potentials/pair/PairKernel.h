@@ -0,0 +1,348 @@
+#ifndef DDMD_PAIR_KERNEL_H
+#define DDMD_PAIR_KERNEL_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <inter/pair/LJPair.h>
+#include <inter/pair/WcaPair.h>
+#include <inter/pair/DpdPair.h>
+#include <util/global.h>
+
+#include <math.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /**
+   * Block evaluation of pair forces for a pair interaction class.
+   *
+   * A PairKernel evaluates the force / distance for a block of pairs
+   * that share a common primary atom, given arrays of squared distances
+   * and neighbor atom types. It is used by PairPotentialImpl to compute
+   * forces using the structure-of-arrays AtomMirror.
+   *
+   * The generic template simply calls Interaction::forceOverR for each
+   * pair within the cutoff. Specializations for particular interaction
+   * classes copy the required parameters into flat tables and evaluate
+   * the force with a loop that contains no function calls or branches,
+   * which the compiler can vectorize.
+   *
+   * Each kernel also provides a single-precision version of forceOverR,
+   * for use in the mixed-precision mode of PairPotentialImpl, in which
+   * separations are computed from float positions relative to a local
+   * origin and pair forces are accumulated in double precision.
+   *
+   * Usage:
+   * \code
+   *    PairKernel<Interaction> kernel;
+   *    kernel.setInteraction(interaction, nAtomType);
+   *    kernel.forceOverR(type0, types, rsq, fOverR, n);
+   * \endcode
+   * The setInteraction() function must be called again after any change
+   * in the parameters of the interaction.
+   *
+   * \ingroup DdMd_Pair_Module
+   */
+   template <class Interaction>
+   class PairKernel
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      PairKernel()
+       : interactionPtr_(0)
+      {}
+
+      /**
+      * Set the associated interaction and copy parameters.
+      *
+      * \param interaction pair interaction object
+      * \param nAtomType   number of atom types
+      */
+      void setInteraction(const Interaction& interaction, int nAtomType)
+      {  interactionPtr_ = &interaction; }
+
+      /**
+      * Compute force / distance for a block of pairs.
+      *
+      * Sets fOverR[k] to the force over distance for pairs within the
+      * cutoff, and to zero for pairs outside the cutoff.
+      *
+      * \param type0  type id of the primary atom
+      * \param types  array of type ids of the neighbor atoms
+      * \param rsq    array of squared separations
+      * \param fOverR array of force / distance (output)
+      * \param n      number of pairs in the block
+      */
+      void forceOverR(int type0, const int* types, const double* rsq,
+                      double* fOverR, int n) const
+      {
+         int k, type1;
+         for (k = 0; k < n; ++k) {
+            type1 = types[k];
+            if (rsq[k] < interactionPtr_->cutoffSq(type0, type1)) {
+               fOverR[k] = interactionPtr_->forceOverR(rsq[k], type0, type1);
+            } else {
+               fOverR[k] = 0.0;
+            }
+         }
+      }
+
+      /**
+      * Compute force / distance for a block of pairs, in single precision.
+      *
+      * \param type0  type id of the primary atom
+      * \param types  array of type ids of the neighbor atoms
+      * \param rsq    array of squared separations
+      * \param fOverR array of force / distance (output)
+      * \param n      number of pairs in the block
+      */
+      void forceOverR(int type0, const int* types, const float* rsq,
+                      float* fOverR, int n) const
+      {
+         double r2;
+         int k, type1;
+         for (k = 0; k < n; ++k) {
+            type1 = types[k];
+            r2 = rsq[k];
+            if (r2 < interactionPtr_->cutoffSq(type0, type1)) {
+               fOverR[k] =
+                    (float) interactionPtr_->forceOverR(r2, type0, type1);
+            } else {
+               fOverR[k] = 0.0f;
+            }
+         }
+      }
+
+   private:
+
+      const Interaction* interactionPtr_;
+
+   };
+
+   /**
+   * PairKernel specialization for the cutoff Lennard-Jones interaction.
+   *
+   * \ingroup DdMd_Pair_Module
+   */
+   template <>
+   class PairKernel<Inter::LJPair>
+   {
+
+   public:
+
+      /**
+      * Copy parameters from an LJPair (or WcaPair) interaction.
+      *
+      * \param interaction pair interaction object
+      * \param nAtomType   number of atom types
+      */
+      void setInteraction(const Inter::LJPair& interaction, int nAtomType)
+      {
+         double sigma;
+         int i, j, k;
+         for (i = 0; i < nAtomType; ++i) {
+            for (j = 0; j < nAtomType; ++j) {
+               k = i*MaxAtomType + j;
+               sigma = interaction.sigma(i, j);
+               sigmaSq_[k] = sigma*sigma;
+               eps48_[k] = 48.0*interaction.epsilon(i, j);
+               cutoffSq_[k] = interaction.cutoffSq(i, j);
+               sigmaSqF_[k] = (float) sigmaSq_[k];
+               eps48F_[k] = (float) eps48_[k];
+               cutoffSqF_[k] = (float) cutoffSq_[k];
+            }
+         }
+      }
+
+      /**
+      * Compute force / distance for a block of pairs.
+      *
+      * \param type0  type id of the primary atom
+      * \param types  array of type ids of the neighbor atoms
+      * \param rsq    array of squared separations
+      * \param fOverR array of force / distance (output)
+      * \param n      number of pairs in the block
+      */
+      void forceOverR(int type0, const int* types, const double* rsq,
+                      double* fOverR, int n) const
+      {
+         const double* sigmaSq = &sigmaSq_[type0*MaxAtomType];
+         const double* eps48 = &eps48_[type0*MaxAtomType];
+         const double* cutoffSq = &cutoffSq_[type0*MaxAtomType];
+         double r2i, r6i, f;
+         int k, t;
+         for (k = 0; k < n; ++k) {
+            t = types[k];
+            r2i = 1.0/rsq[k];
+            r6i = sigmaSq[t]*r2i;
+            r6i = r6i*r6i*r6i;
+            f = eps48[t]*(r6i - 0.5)*r6i*r2i;
+            fOverR[k] = (rsq[k] < cutoffSq[t]) ? f : 0.0;
+         }
+      }
+
+      /**
+      * Compute force / distance for a block of pairs, in single precision.
+      *
+      * \param type0  type id of the primary atom
+      * \param types  array of type ids of the neighbor atoms
+      * \param rsq    array of squared separations
+      * \param fOverR array of force / distance (output)
+      * \param n      number of pairs in the block
+      */
+      void forceOverR(int type0, const int* types, const float* rsq,
+                      float* fOverR, int n) const
+      {
+         const float* sigmaSq = &sigmaSqF_[type0*MaxAtomType];
+         const float* eps48 = &eps48F_[type0*MaxAtomType];
+         const float* cutoffSq = &cutoffSqF_[type0*MaxAtomType];
+         float r2i, r6i, f;
+         int k, t;
+         for (k = 0; k < n; ++k) {
+            t = types[k];
+            r2i = 1.0f/rsq[k];
+            r6i = sigmaSq[t]*r2i;
+            r6i = r6i*r6i*r6i;
+            f = eps48[t]*(r6i - 0.5f)*r6i*r2i;
+            fOverR[k] = (rsq[k] < cutoffSq[t]) ? f : 0.0f;
+         }
+      }
+
+   private:
+
+      static const int MaxAtomType = 4;
+
+      double sigmaSq_[MaxAtomType*MaxAtomType];
+      double eps48_[MaxAtomType*MaxAtomType];
+      double cutoffSq_[MaxAtomType*MaxAtomType];
+
+      // Single precision copies of parameters.
+      float sigmaSqF_[MaxAtomType*MaxAtomType];
+      float eps48F_[MaxAtomType*MaxAtomType];
+      float cutoffSqF_[MaxAtomType*MaxAtomType];
+
+   };
+
+   /**
+   * PairKernel specialization for the WCA interaction.
+   *
+   * The WcaPair class is a subclass of LJPair that differs only in the
+   * choice of cutoff, and so can use the same kernel.
+   *
+   * \ingroup DdMd_Pair_Module
+   */
+   template <>
+   class PairKernel<Inter::WcaPair> : public PairKernel<Inter::LJPair>
+   {};
+
+   /**
+   * PairKernel specialization for the DPD soft-core interaction.
+   *
+   * \ingroup DdMd_Pair_Module
+   */
+   template <>
+   class PairKernel<Inter::DpdPair>
+   {
+
+   public:
+
+      /**
+      * Copy parameters from a DpdPair interaction.
+      *
+      * \param interaction pair interaction object
+      * \param nAtomType   number of atom types
+      */
+      void setInteraction(const Inter::DpdPair& interaction, int nAtomType)
+      {
+         double sigma;
+         int i, j, k;
+         for (i = 0; i < nAtomType; ++i) {
+            for (j = 0; j < nAtomType; ++j) {
+               k = i*MaxAtomType + j;
+               sigma = interaction.sigma(i, j);
+               sigma_[k] = sigma;
+               sigmaSq_[k] = sigma*sigma;
+               cf_[k] = interaction.epsilon(i, j)/(sigma*sigma);
+               sigmaF_[k] = (float) sigma_[k];
+               sigmaSqF_[k] = (float) sigmaSq_[k];
+               cfF_[k] = (float) cf_[k];
+            }
+         }
+      }
+
+      /**
+      * Compute force / distance for a block of pairs.
+      *
+      * \param type0  type id of the primary atom
+      * \param types  array of type ids of the neighbor atoms
+      * \param rsq    array of squared separations
+      * \param fOverR array of force / distance (output)
+      * \param n      number of pairs in the block
+      */
+      void forceOverR(int type0, const int* types, const double* rsq,
+                      double* fOverR, int n) const
+      {
+         const double* sigma = &sigma_[type0*MaxAtomType];
+         const double* sigmaSq = &sigmaSq_[type0*MaxAtomType];
+         const double* cf = &cf_[type0*MaxAtomType];
+         double f;
+         int k, t;
+         for (k = 0; k < n; ++k) {
+            t = types[k];
+            f = cf[t]*(sigma[t]/sqrt(rsq[k]) - 1.0);
+            fOverR[k] = (rsq[k] < sigmaSq[t]) ? f : 0.0;
+         }
+      }
+
+      /**
+      * Compute force / distance for a block of pairs, in single precision.
+      *
+      * \param type0  type id of the primary atom
+      * \param types  array of type ids of the neighbor atoms
+      * \param rsq    array of squared separations
+      * \param fOverR array of force / distance (output)
+      * \param n      number of pairs in the block
+      */
+      void forceOverR(int type0, const int* types, const float* rsq,
+                      float* fOverR, int n) const
+      {
+         const float* sigma = &sigmaF_[type0*MaxAtomType];
+         const float* sigmaSq = &sigmaSqF_[type0*MaxAtomType];
+         const float* cf = &cfF_[type0*MaxAtomType];
+         float f;
+         int k, t;
+         for (k = 0; k < n; ++k) {
+            t = types[k];
+            f = cf[t]*(sigma[t]/sqrtf(rsq[k]) - 1.0f);
+            fOverR[k] = (rsq[k] < sigmaSq[t]) ? f : 0.0f;
+         }
+      }
+
+   private:
+
+      static const int MaxAtomType = 4;
+
+      double sigma_[MaxAtomType*MaxAtomType];
+      double sigmaSq_[MaxAtomType*MaxAtomType];
+      double cf_[MaxAtomType*MaxAtomType];
+
+      // Single precision copies of parameters.
+      float sigmaF_[MaxAtomType*MaxAtomType];
+      float sigmaSqF_[MaxAtomType*MaxAtomType];
+      float cfF_[MaxAtomType*MaxAtomType];
+
+   };
+
+}
+#endif
@@ -14,6 +14,7 @@
 #include <ddMd/neighbor/PairList.h>
 #include <ddMd/neighbor/CellList.h>
 #include <ddMd/communicate/Domain.h>
+#include <ddMd/misc/Threads.h>
 #include <util/mpi/MpiLoader.h>
 #include <util/space/Vector.h>
 #include <util/global.h>
@@ -33,6 +34,8 @@ namespace DdMd
       boundaryPtr_(0),
       storagePtr_(0),
       methodId_(0),
+      useMirror_(false),
+      useFloat_(false),
       nPair_(0),
       pairEnergies_()
    {  setClassName("PairPotential"); } 
@@ -48,6 +51,8 @@ namespace DdMd
       boundaryPtr_(&simulation.boundary()),
       storagePtr_(&simulation.atomStorage()),
       methodId_(0),
+      useMirror_(false),
+      useFloat_(false),
       nPair_(0),
       pairEnergies_()
    {  setClassName("PairPotential"); } 
@@ -93,6 +98,10 @@ namespace DdMd
       readOptional<int>(in, "nCellCut", nCellCut_); 
       read<int>(in, "pairCapacity", pairCapacity_);
       read<Boundary>(in, "maxBoundary", maxBoundary_);
+      useMirror_ = false; // Default value for optional parameter
+      readOptional<bool>(in, "useMirror", useMirror_); 
+      useFloat_ = false; // Default value for optional parameter
+      readOptional<bool>(in, "useFloat", useFloat_); 
       cutoff_ = maxPairCutoff() + skin_;
       allocate();
    }
@@ -107,6 +116,12 @@ namespace DdMd
       loadParameter<int>(ar, "nCellCut", nCellCut_, false);
       loadParameter<int>(ar, "pairCapacity", pairCapacity_);
       loadParameter<Boundary>(ar, "maxBoundary", maxBoundary_);
+      useMirror_ = false;
+      useFloat_ = false;
+      if (ar.version() > 0) {
+         loadParameter<bool>(ar, "useMirror", useMirror_, false);
+         loadParameter<bool>(ar, "useFloat", useFloat_, false);
+      }
 
       MpiLoader<Serializable::IArchive> loader(*this, ar);
       loader.load(cutoff_);
@@ -123,6 +138,8 @@ namespace DdMd
       Parameter::saveOptional(ar, nCellCut_, true);
       ar << pairCapacity_;
       ar << maxBoundary_;
+      Parameter::saveOptional(ar, useMirror_, useMirror_);
+      Parameter::saveOptional(ar, useFloat_, useFloat_);
       ar << cutoff_;
       ar << methodId_;
    }
@@ -137,6 +154,8 @@ namespace DdMd
       // Allocate PairList
       int localCapacity = storage().atomCapacity();
       pairList_.allocate(localCapacity, pairCapacity_, cutoff_);
+      pairList_.setAtomArrays(storage().mirrorAtomPtr(0), 
+                              storage().mirrorAtomPtr(localCapacity));
 
       // Calculate cell list cutoff lengths for all directions
       Vector cutoffs;
@@ -151,6 +170,53 @@ namespace DdMd
       // Allocate CellList
       int totalCapacity = localCapacity + storage().ghostCapacity();
       cellList_.allocate(totalCapacity, lower, upper, cutoffs, nCellCut_);
+
+      // Allocate AtomMirror, if needed. Threaded force calculations
+      // with a pair list always use the mirror.
+      if (useMirror_ || useFloat_ || Threads::nThread() > 1) {
+         storage().allocateMirror();
+      }
+      if (useFloat_) {
+         storage().mirror().allocateFloat();
+      }
+   }
+
+   /*
+   * Enable or disable use of the AtomMirror.
+   */
+   void PairPotential::setUseMirror(bool useMirror)
+   {
+      useMirror_ = useMirror;
+      if (useMirror_) {
+         storage().allocateMirror();
+      }
+   }
+
+   /*
+   * Enable or disable mixed-precision force calculation.
+   */
+   void PairPotential::setUseFloat(bool useFloat)
+   {
+      useFloat_ = useFloat;
+      if (useFloat_) {
+         storage().allocateMirror();
+         storage().mirror().allocateFloat();
+      }
+   }
+
+   /*
+   * Set the origin for single precision positions in the AtomMirror.
+   */
+   void PairPotential::setMirrorOrigin()
+   {
+      Vector center;
+      Vector origin;
+      for (int i = 0; i < Dimension; ++i) {
+         center[i] = 0.5*(domain().domainBound(i, 0) 
+                        + domain().domainBound(i, 1));
+      }
+      boundary().transformGenToCart(center, origin);
+      storage().mirror().setOrigin(origin);
    }
 
    /*
@@ -140,6 +140,34 @@ namespace DdMd
       */
       void setMethodId(int methodId);
 
+      /**
+      * Enable or disable use of the structure-of-arrays AtomMirror.
+      *
+      * If enabled, forces computed with the pair list (methodId == 0)
+      * are evaluated by vectorizable kernels that operate on a copy of
+      * positions and forces in the AtomMirror owned by the AtomStorage.
+      * Enabling the mirror allocates it, if necessary. The mirror is
+      * always used if more than one thread is used (Threads::nThread()).
+      *
+      * \param useMirror true to enable, false to disable
+      */
+      void setUseMirror(bool useMirror);
+
+      /**
+      * Enable or disable mixed-precision evaluation of pair forces.
+      *
+      * If enabled, forces computed with the pair list (methodId == 0)
+      * use the AtomMirror, as for setUseMirror(true), but separations
+      * and pair forces are computed in single precision from positions
+      * relative to the center of the processor domain. Forces on each
+      * atom are accumulated in double precision. Energies and stresses
+      * are always computed in double precision. Enabling this mode 
+      * allocates the mirror and its single precision arrays.
+      *
+      * \param useFloat true to enable, false to disable
+      */
+      void setUseFloat(bool useFloat);
+
       //@}
       /// \name Interaction interface
       //@{
@@ -219,6 +247,28 @@ namespace DdMd
       */
       void buildPairList();
 
+      /**
+      * Compute forces for pairs in which both atoms are local.
+      *
+      * This and computeBoundaryForces() together add the same forces as
+      * computeForces(). This function does not access ghost positions, 
+      * and may thus be called while ghost positions are being updated 
+      * (see Exchanger::beginUpdate). It must be followed by a call to
+      * computeBoundaryForces(), after ghost positions are updated. Forces
+      * are divided in this way only if the pair list is used (methodId 
+      * == 0). Otherwise, this function does nothing and all forces are 
+      * computed by computeBoundaryForces().
+      */
+      virtual void computeInteriorForces() = 0;
+
+      /**
+      * Compute forces for pairs in which one atom is a ghost.
+      *
+      * Must be called after computeInteriorForces(), after updating 
+      * ghost positions. See computeInteriorForces().
+      */
+      virtual void computeBoundaryForces() = 0;
+
       /**
       * Compute pair energies on all processors.
       *
@@ -295,6 +345,16 @@ namespace DdMd
       */
       int methodId() const;
 
+      /**
+      * Is the structure-of-arrays AtomMirror used to compute forces?
+      */
+      bool useMirror() const;
+
+      /**
+      * Are pair forces computed in mixed precision?
+      */
+      bool useFloat() const;
+
    protected:
 
       /// CellList to construct PairList or calculate nonbonded pair forces.
@@ -338,6 +398,11 @@ namespace DdMd
       */
       void setPairEnergies(DMatrix<double> pairEnergies);
 
+      /**
+      * Set AtomMirror origin to the center of the processor domain.
+      */
+      void setMirrorOrigin();
+
    private:
 
       /// Pointer to associated Domain object.
@@ -352,6 +417,12 @@ namespace DdMd
       /// Index for method used to calculate forces / energies.
       int methodId_;
 
+      /// Use AtomMirror and PairKernel to compute pair list forces?
+      bool useMirror_;
+
+      /// Compute pair list forces in mixed precision?
+      bool useFloat_;
+
       /// Number of pairs within specified cutoff.
       int nPair_;
 
@@ -397,5 +468,11 @@ namespace DdMd
    inline int PairPotential::methodId() const
    {  return methodId_; }
 
+   inline bool PairPotential::useMirror() const
+   {  return useMirror_; }
+
+   inline bool PairPotential::useFloat() const
+   {  return useFloat_; }
+
 }
 #endif
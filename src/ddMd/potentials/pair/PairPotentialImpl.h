@@ -9,12 +9,14 @@
 */
 
 #include <ddMd/potentials/pair/PairPotential.h>
+#include <ddMd/potentials/pair/PairKernel.h>
 #include <util/space/Tensor.h>
 #include <util/global.h>
 
 #include <algorithm>
 
 #define PAIR_BLOCK_SIZE 16
+#define PAIR_MIRROR_BLOCK_SIZE 64
 
 namespace DdMd
 {
@@ -192,6 +194,20 @@ namespace DdMd
       */
       virtual void computeForces();
 
+      /**
+      * Compute pair forces for pairs of local atoms.
+      *
+      * See PairPotential::computeInteriorForces().
+      */
+      virtual void computeInteriorForces();
+
+      /**
+      * Compute pair forces for pairs that include a ghost atom.
+      *
+      * See PairPotential::computeBoundaryForces().
+      */
+      virtual void computeBoundaryForces();
+
       /**
       * Compute the total nonBonded pair energy for all processors
       * 
@@ -265,6 +281,11 @@ namespace DdMd
       PairForce* inPairs_[PAIR_BLOCK_SIZE];
       #endif
 
+      /**
+      * Vectorizable force kernel, used with the AtomMirror.
+      */
+      PairKernel<Interaction> kernel_;
+
       /**
       * Initialized to false, set true in readParameters or loadParameters.
       */ 
@@ -280,6 +301,50 @@ namespace DdMd
       */
       void computeForcesList();
 
+      /**
+      * Compute atomic pair forces for a subset of pairs, using PairList.
+      *
+      * \param set subset of pairs (ALL, INTERIOR or BOUNDARY)
+      */
+      void computeForcesList(PairList::PairSet set);
+
+      /**
+      * Compute atomic pair forces, using PairList and AtomMirror.
+      *
+      * \param set subset of pairs (ALL, INTERIOR or BOUNDARY)
+      */
+      void computeForcesMirror(PairList::PairSet set = PairList::ALL);
+
+      /**
+      * Accumulate mirror forces for a range of primary atoms in PairList.
+      *
+      * \param begin index of first primary atom
+      * \param end   index one past the last primary atom
+      * \param set   subset of pairs (ALL, INTERIOR or BOUNDARY)
+      * \param fx    array of x force components (output)
+      * \param fy    array of y force components (output)
+      * \param fz    array of z force components (output)
+      */
+      void mirrorForces(int begin, int end, PairList::PairSet set,
+                        double* fx, double* fy, double* fz);
+
+      /**
+      * Accumulate mirror forces in mixed precision.
+      *
+      * Separations and pair forces are computed in single precision
+      * and forces are accumulated in double precision. Parameters are
+      * the same as for mirrorForces().
+      *
+      * \param begin index of first primary atom
+      * \param end   index one past the last primary atom
+      * \param set   subset of pairs (ALL, INTERIOR or BOUNDARY)
+      * \param fx    array of x force components (output)
+      * \param fy    array of y force components (output)
+      * \param fz    array of z force components (output)
+      */
+      void mirrorForcesFloat(int begin, int end, PairList::PairSet set,
+                             double* fx, double* fy, double* fz);
+
       /**
       * Compute atomic pair forces and/or pair potential energy.
       */
@@ -312,6 +377,7 @@ namespace DdMd
 #include <ddMd/storage/GhostIterator.h>
 #include <ddMd/neighbor/PairIterator.h>
 #include <ddMd/communicate/Domain.h>
+#include <ddMd/misc/Threads.h>
 
 #include <util/space/Dimension.h>
 #include <util/space/Vector.h>
@@ -459,7 +525,11 @@ namespace DdMd
    void PairPotentialImpl<Interaction>::computeForces()
    {  
        if (methodId() == 0) {
-          computeForcesList(); 
+          if (useMirror() || useFloat() || Threads::nThread() > 1) {
+             computeForcesMirror();
+          } else {
+             computeForcesList(); 
+          }
        } else
        if (methodId() == 1) {
           computeForcesCell(); 
@@ -468,6 +538,38 @@ namespace DdMd
        }
    }
 
+   /*
+   * Increment atomic forces for pairs of local atoms.
+   */
+   template <class Interaction>
+   void PairPotentialImpl<Interaction>::computeInteriorForces()
+   {  
+       if (methodId() == 0) {
+          if (useMirror() || useFloat() || Threads::nThread() > 1) {
+             computeForcesMirror(PairList::INTERIOR);
+          } else {
+             computeForcesList(PairList::INTERIOR); 
+          }
+       } 
+   }
+
+   /*
+   * Increment atomic forces for pairs that include a ghost.
+   */
+   template <class Interaction>
+   void PairPotentialImpl<Interaction>::computeBoundaryForces()
+   {  
+       if (methodId() == 0) {
+          if (useMirror() || useFloat() || Threads::nThread() > 1) {
+             computeForcesMirror(PairList::BOUNDARY);
+          } else {
+             computeForcesList(PairList::BOUNDARY); 
+          }
+       } else {
+          computeForces();
+       }
+   }
+
    /*
    * Compute total pair energy on all processors.
    */
@@ -656,6 +758,309 @@ namespace DdMd
       }
    }
 
+   /*
+   * Increment atomic forces for a subset of pairs (private).
+   *
+   * Loops over primary atoms and the neighbors in the subset, without 
+   * the PairIterator. Forces on ghosts are incremented only if reverse
+   * communication is enabled.
+   */
+   template <class Interaction>
+   void 
+   PairPotentialImpl<Interaction>::computeForcesList(PairList::PairSet set)
+   {
+      Vector f;
+      double rsq;
+      Atom*  atom0Ptr;
+      Atom*  atom1Ptr;
+      const int* atom1Ids;
+      int    i, i0, k, n, type0, type1;
+      bool   addGhost = reverseUpdateFlag();
+
+      for (i = 0; i < pairList_.nAtom(); ++i) {
+         n = pairList_.getNeighbors(i, i0, atom1Ids, set);
+         atom0Ptr = pairList_.atomPtr(i0);
+         type0 = atom0Ptr->typeId();
+         for (k = 0; k < n; ++k) {
+            atom1Ptr = pairList_.atomPtr(atom1Ids[k]);
+            f.subtract(atom0Ptr->position(), atom1Ptr->position());
+            rsq = f.square();
+            type1 = atom1Ptr->typeId();
+            if (rsq < interactionPtr_->cutoffSq(type0, type1)) {
+               f *= interactionPtr_->forceOverR(rsq, type0, type1);
+               atom0Ptr->force() += f;
+               if (addGhost || !atom1Ptr->isGhost()) {
+                  atom1Ptr->force() -= f;
+               }
+            }
+         }
+      }
+   }
+
+   /*
+   * Increment atomic forces using the AtomMirror (private).
+   *
+   * Positions are copied into the structure-of-arrays AtomMirror, and
+   * forces are accumulated in the mirror by mirrorForces(). If more
+   * than one thread is used, the primary atoms of the PairList are
+   * divided into contiguous ranges with similar numbers of pairs. Each
+   * thread accumulates forces for its range in its own mirror force
+   * arrays, which are then added to the main mirror force arrays. The 
+   * result is independent of thread scheduling for a given number of 
+   * threads.
+   *
+   * If set == INTERIOR, only local atoms are copied to the mirror, and 
+   * forces are left in the mirror. A subsequent call with set == BOUNDARY 
+   * copies ghosts to the mirror, adds forces for the remaining pairs, and
+   * then adds all mirror forces to the atoms. 
+   *
+   * If useFloat() is true, the mirror origin is reset to the center of
+   * the processor domain before local atoms are copied, and forces are
+   * computed by mirrorForcesFloat().
+   */
+   template <class Interaction>
+   void 
+   PairPotentialImpl<Interaction>::computeForcesMirror(PairList::PairSet set)
+   {
+      AtomStorage& atomStorage = storage();
+      if (set != PairList::BOUNDARY) {
+         if (useFloat()) {
+            setMirrorOrigin();
+         }
+         atomStorage.fillLocalMirror();
+         kernel_.setInteraction(*interactionPtr_, nAtomType_);
+      }
+      if (set != PairList::INTERIOR) {
+         atomStorage.fillGhostMirror();
+      }
+      AtomMirror& mirror = atomStorage.mirror();
+
+      #ifdef DDMD_OPENMP
+      int nThread = Threads::nThread();
+      if (nThread > 1) {
+         mirror.allocateThreadForces(nThread);
+         int capacity = mirror.capacity();
+         #pragma omp parallel num_threads(nThread)
+         {
+            // Divide work among the threads actually in the team
+            int nTeam = Threads::nTeamThread();
+            int threadId = Threads::threadId();
+            int begin, end;
+            if (threadId > 0) {
+               mirror.zeroForces(threadId);
+            }
+            pairList_.getAtomRange(nTeam, threadId, begin, end);
+            mirrorForces(begin, end, set, mirror.fx(threadId), 
+                         mirror.fy(threadId), mirror.fz(threadId));
+            stampThread();
+            #pragma omp barrier
+            begin = (capacity*threadId)/nTeam;
+            end = (capacity*(threadId + 1))/nTeam;
+            mirror.reduceThreadForces(begin, end, nTeam);
+         }
+      } else {
+         mirrorForces(0, pairList_.nAtom(), set,
+                      mirror.fx(), mirror.fy(), mirror.fz());
+      }
+      #else
+      mirrorForces(0, pairList_.nAtom(), set,
+                   mirror.fx(), mirror.fy(), mirror.fz());
+      #endif
+
+      // Add mirror forces to atoms. Forces on ghosts are added only 
+      // if reverse communication of forces is enabled.
+      if (set != PairList::INTERIOR) {
+         atomStorage.addMirrorForces(reverseUpdateFlag());
+      }
+   }
+
+   /*
+   * Accumulate forces for a range of primary atoms in the mirror (private).
+   *
+   * Neighbors of each primary atom are processed in blocks. Indices in
+   * the PairList are also indices in the AtomMirror arrays. The loops
+   * that compute separations, evaluate PairKernel<Interaction> and
+   * accumulate forces within each block contain no function calls or
+   * branches, and operate on contiguous work arrays.
+   */
+   template <class Interaction>
+   void 
+   PairPotentialImpl<Interaction>::mirrorForces(int begin, int end, 
+                                       PairList::PairSet set,
+                                       double* fx, double* fy, double* fz)
+   {
+      if (useFloat()) {
+         mirrorForcesFloat(begin, end, set, fx, fy, fz);
+         return;
+      }
+
+      const AtomMirror& mirror = storage().mirror();
+      const double* x = mirror.x();
+      const double* y = mirror.y();
+      const double* z = mirror.z();
+      const int* typeIds = mirror.typeIds();
+
+      // Work arrays for a block of neighbors
+      int    mTypes[PAIR_MIRROR_BLOCK_SIZE];
+      double mDx[PAIR_MIRROR_BLOCK_SIZE];
+      double mDy[PAIR_MIRROR_BLOCK_SIZE];
+      double mDz[PAIR_MIRROR_BLOCK_SIZE];
+      double mRsq[PAIR_MIRROR_BLOCK_SIZE];
+      double mFr[PAIR_MIRROR_BLOCK_SIZE];
+
+      const int* atom1Ids;
+      double x0, y0, z0, fx0, fy0, fz0;
+      int i, i0, j, k, m, n, type0;
+      for (i = begin; i < end; ++i) {
+         n = pairList_.getNeighbors(i, i0, atom1Ids, set);
+         x0 = x[i0];
+         y0 = y[i0];
+         z0 = z[i0];
+         type0 = typeIds[i0];
+         fx0 = 0.0;
+         fy0 = 0.0;
+         fz0 = 0.0;
+         while (n) {
+
+            // Determine m = number of pairs in this block
+            m = std::min(PAIR_MIRROR_BLOCK_SIZE, n);
+
+            // Gather types and separations of neighbors
+            for (k = 0; k < m; ++k) {
+               j = atom1Ids[k];
+               mTypes[k] = typeIds[j];
+               mDx[k] = x0 - x[j];
+               mDy[k] = y0 - y[j];
+               mDz[k] = z0 - z[j];
+            }
+
+            // Compute squared separations
+            for (k = 0; k < m; ++k) {
+               mRsq[k] = mDx[k]*mDx[k] + mDy[k]*mDy[k] + mDz[k]*mDz[k];
+            }
+
+            // Compute force / distance (zero beyond cutoff)
+            kernel_.forceOverR(type0, mTypes, mRsq, mFr, m);
+
+            // Compute pair forces and increment primary atom force
+            for (k = 0; k < m; ++k) {
+               mDx[k] *= mFr[k];
+               mDy[k] *= mFr[k];
+               mDz[k] *= mFr[k];
+               fx0 += mDx[k];
+               fy0 += mDy[k];
+               fz0 += mDz[k];
+            }
+
+            // Scatter forces on neighbors 
+            for (k = 0; k < m; ++k) {
+               j = atom1Ids[k];
+               fx[j] -= mDx[k];
+               fy[j] -= mDy[k];
+               fz[j] -= mDz[k];
+            }
+
+            atom1Ids += m;
+            n -= m;
+         }
+         fx[i0] += fx0;
+         fy[i0] += fy0;
+         fz[i0] += fz0;
+      }
+   }
+
+   /*
+   * Accumulate forces in the mirror in mixed precision (private).
+   *
+   * The loop structure is identical to that of mirrorForces(). The work
+   * arrays and kernel are single precision, which doubles the number of
+   * pairs per vector register. The force on each primary atom is summed 
+   * in double precision, and neighbor forces are scattered to the double
+   * precision mirror force arrays, so that round-off errors in forces do
+   * not accumulate over many pairs.
+   */
+   template <class Interaction>
+   void 
+   PairPotentialImpl<Interaction>::mirrorForcesFloat(int begin, int end, 
+                                       PairList::PairSet set,
+                                       double* fx, double* fy, double* fz)
+   {
+      const AtomMirror& mirror = storage().mirror();
+      const float* x = mirror.xf();
+      const float* y = mirror.yf();
+      const float* z = mirror.zf();
+      const int* typeIds = mirror.typeIds();
+
+      // Work arrays for a block of neighbors
+      int   mTypes[PAIR_MIRROR_BLOCK_SIZE];
+      float mDx[PAIR_MIRROR_BLOCK_SIZE];
+      float mDy[PAIR_MIRROR_BLOCK_SIZE];
+      float mDz[PAIR_MIRROR_BLOCK_SIZE];
+      float mRsq[PAIR_MIRROR_BLOCK_SIZE];
+      float mFr[PAIR_MIRROR_BLOCK_SIZE];
+
+      const int* atom1Ids;
+      float  x0, y0, z0;
+      double fx0, fy0, fz0;
+      int i, i0, j, k, m, n, type0;
+      for (i = begin; i < end; ++i) {
+         n = pairList_.getNeighbors(i, i0, atom1Ids, set);
+         x0 = x[i0];
+         y0 = y[i0];
+         z0 = z[i0];
+         type0 = typeIds[i0];
+         fx0 = 0.0;
+         fy0 = 0.0;
+         fz0 = 0.0;
+         while (n) {
+
+            // Determine m = number of pairs in this block
+            m = std::min(PAIR_MIRROR_BLOCK_SIZE, n);
+
+            // Gather types and separations of neighbors
+            for (k = 0; k < m; ++k) {
+               j = atom1Ids[k];
+               mTypes[k] = typeIds[j];
+               mDx[k] = x0 - x[j];
+               mDy[k] = y0 - y[j];
+               mDz[k] = z0 - z[j];
+            }
+
+            // Compute squared separations
+            for (k = 0; k < m; ++k) {
+               mRsq[k] = mDx[k]*mDx[k] + mDy[k]*mDy[k] + mDz[k]*mDz[k];
+            }
+
+            // Compute force / distance (zero beyond cutoff)
+            kernel_.forceOverR(type0, mTypes, mRsq, mFr, m);
+
+            // Compute pair forces and increment primary atom force
+            for (k = 0; k < m; ++k) {
+               mDx[k] *= mFr[k];
+               mDy[k] *= mFr[k];
+               mDz[k] *= mFr[k];
+               fx0 += mDx[k];
+               fy0 += mDy[k];
+               fz0 += mDz[k];
+            }
+
+            // Scatter forces on neighbors 
+            for (k = 0; k < m; ++k) {
+               j = atom1Ids[k];
+               fx[j] -= mDx[k];
+               fy[j] -= mDy[k];
+               fz[j] -= mDz[k];
+            }
+
+            atom1Ids += m;
+            n -= m;
+         }
+         fx[i0] += fx0;
+         fy[i0] += fy0;
+         fz[i0] += fz0;
+      }
+   }
+
    /*
    * Increment atomic forces and/or pair energy (private).
    */
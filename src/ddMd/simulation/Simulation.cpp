@@ -16,6 +16,7 @@
 #include <ddMd/configIos/DdMdConfigIo.h>
 #include <ddMd/configIos/SerializeConfigIo.h>
 #include <ddMd/analyzers/AnalyzerManager.h>
+#include <ddMd/misc/Threads.h>
 #ifdef DDMD_MODIFIERS
 #include <ddMd/modifiers/ModifierManager.h>
 #endif
@@ -166,8 +167,10 @@ namespace DdMd
       hasExternal_(false),
       #endif
       hasAtomContext_(false),
+      sortInterval_(0),
       maskedPairPolicy_(MaskBonded),
       reverseUpdateFlag_(false),
+      floatUpdateFlag_(false),
       #ifdef UTIL_MPI
       communicator_(communicator),
       #endif
@@ -309,6 +312,7 @@ namespace DdMd
       bool cFlag = false; // command file name
       bool iFlag = false; // input prefix
       bool oFlag = false; // output prefix
+      bool tFlag = false; // number of threads
       char* sArg = 0;
       char* rArg = 0;
       char* pArg = 0;
@@ -316,11 +320,12 @@ namespace DdMd
       char* iArg = 0;
       char* oArg = 0;
       int  nSystem = 1;
+      int  nThread = 1;
 
       // Read command-line arguments
       int c;
       opterr = 0;
-      while ((c = getopt(argc, argv, "es:p:r:c:i:o:")) != -1) {
+      while ((c = getopt(argc, argv, "es:p:r:c:i:o:t:")) != -1) {
          switch (c) {
          case 'e': // echo parameters
             eFlag = true;
@@ -350,6 +355,10 @@ namespace DdMd
             oFlag = true;
             oArg  = optarg;
             break;
+         case 't': // number of threads
+            tFlag = true;
+            nThread = atoi(optarg);
+            break;
          case '?':
             Log::file() << "Unknown option -" << optopt << std::endl;
          }
@@ -382,6 +391,15 @@ namespace DdMd
          Log::setFile(logFile_);
       }
 
+      // If option -t, set number of threads per processor
+      if (tFlag) {
+         Threads::setNThread(nThread);
+         if (isIoProcessor()) {
+            Log::file() << "Using " << nThread 
+                        << " threads per processor" << std::endl;
+         }
+      }
+
       // If option -e, enable echoing of parameters as they are read
       if (eFlag) {
          ParamComponent::setEcho(true);
@@ -501,6 +519,8 @@ namespace DdMd
       hasAtomContext_ = false;
       readOptional<bool>(in, "hasAtomContext", hasAtomContext_); 
       Atom::setHasAtomContext(hasAtomContext_);
+      sortInterval_ = 0;
+      readOptional<int>(in, "sortInterval", sortInterval_); 
 
       // Read array of atom type descriptors
       atomTypes_.allocate(nAtomType_);
@@ -613,6 +633,8 @@ namespace DdMd
       // Finished reading parameter file. Now finish initialization:
 
       exchanger_.setPairCutoff(pairPotential().cutoff());
+      exchanger_.setSortInterval(sortInterval_);
+      exchanger_.setFloatUpdateFlag(floatUpdateFlag_);
       exchanger_.allocate();
 
       // Set signal observers (i.e., call-back functions for Signal::notify)
@@ -661,6 +683,17 @@ namespace DdMd
       }
       isRestarting_ = true;
 
+      // Read file header, if any, and set archive version on all processors
+      unsigned int version = 0;
+      if (isIoProcessor()) {
+         version = ar.readHeader();
+      }
+      bcast<unsigned int>(domain_.communicator(), version, 0);
+      ar.setVersion(version);
+      if (version > RestartVersion) {
+         UTIL_THROW("Restart file version is newer than this program");
+      }
+
       loadParamComposite(ar, domain_);
       loadFileMaster(ar);
 
@@ -695,6 +728,10 @@ namespace DdMd
       hasAtomContext_ = false;
       loadParameter<bool>(ar, "hasAtomContext", hasAtomContext_, false); // opt
       Atom::setHasAtomContext(hasAtomContext_);
+      sortInterval_ = 0;
+      if (ar.version() > 0) {
+         loadParameter<int>(ar, "sortInterval", sortInterval_, false); // opt
+      }
 
       atomTypes_.allocate(nAtomType_);
       for (int i = 0; i < nAtomType_; ++i) {
@@ -804,6 +841,8 @@ namespace DdMd
       // Finished loading data from archive. Now finish initialization:
 
       exchanger_.setPairCutoff(pairPotential().cutoff());
+      exchanger_.setSortInterval(sortInterval_);
+      exchanger_.setFloatUpdateFlag(floatUpdateFlag_);
       exchanger_.allocate();
 
       // Set signal observers (i.e., call-back functions for Signal::notify)
@@ -880,6 +919,7 @@ namespace DdMd
    */
    void Simulation::save(Serializable::OArchive& ar)
    {
+      ar.writeHeader(RestartVersion);
       domain_.save(ar);
       saveFileMaster(ar);
 
@@ -898,6 +938,7 @@ namespace DdMd
       Parameter::saveOptional(ar, hasExternal_, hasExternal_);
       #endif
       Parameter::saveOptional(ar, hasAtomContext_, hasAtomContext_);
+      Parameter::saveOptional(ar, sortInterval_, (bool)sortInterval_);
       ar << atomTypes_;
 
       // Read storage capacities
@@ -1065,6 +1106,10 @@ namespace DdMd
       // Reverse communication (true) or not (false)?
       read<bool>(in, "reverseUpdateFlag", reverseUpdateFlag_);
 
+      // Single precision ghost position updates (optional)
+      floatUpdateFlag_ = false;
+      readOptional<bool>(in, "floatUpdateFlag", floatUpdateFlag_);
+
    }
 
    /*
@@ -1097,6 +1142,10 @@ namespace DdMd
       #endif
       loadParameter<MaskPolicy>(ar, "maskedPairPolicy", maskedPairPolicy_);
       loadParameter<bool>(ar, "reverseUpdateFlag", reverseUpdateFlag_);
+      floatUpdateFlag_ = false;
+      if (ar.version() > 0) {
+         loadParameter<bool>(ar, "floatUpdateFlag", floatUpdateFlag_, false);
+      }
 
       isInitialized_ = true;
    }
@@ -1131,6 +1180,7 @@ namespace DdMd
       #endif
       ar << maskedPairPolicy_;
       ar << reverseUpdateFlag_;
+      Parameter::saveOptional(ar, floatUpdateFlag_, floatUpdateFlag_);
    }
 
    /*
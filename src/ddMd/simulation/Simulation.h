@@ -85,6 +85,15 @@ namespace DdMd
       using ParamComposite::readParam;
       using ParamComposite::load;
 
+      /**
+      * Version of the restart file format written by save().
+      *
+      * Version 0 denotes files written before a version header was 
+      * added. Data added to the format since then is loaded only if
+      * the version of the archive is greater than 0.
+      */
+      static const unsigned int RestartVersion = 1;
+
       // Lifetime
 
       #ifdef UTIL_MPI
@@ -139,6 +148,11 @@ namespace DdMd
       *       the command file name may be specified in the FileMaster block
       *       of the parameter file. 
       *
+      *   -t  nThread [int]
+      *       Sets the number of OpenMP threads used by each processor to
+      *       compute forces and integrate the equations of motion. Values
+      *       greater than 1 require compilation with DDMD_OPENMP defined.
+      *
       * The -p (parameter file) and -r (restart) options are incompatible:
       * A simulation may either be initialized from a parameter file or a 
       * restart file, but not both. A command file is required in both cases.
@@ -209,7 +223,8 @@ namespace DdMd
       *
       * Call on all processors, but loads from archive only on ioProcessor.
       * This function loads both parameter information and the system
-      * configuration.
+      * configuration. It first reads the file header, if any, and sets
+      * the archive version on all processors.
       *
       * Do not call this directly. Instead call load(const std::string&)
       * or load(Serializable::IArchive& ).
@@ -231,7 +246,8 @@ namespace DdMd
       /**
       * Save internal state to restart archive.
       *
-      * Used to implement save(std::string).
+      * Used to implement save(std::string). Begins with a file header 
+      * containing RestartVersion.
       */
       virtual void save(Serializable::OArchive& ar);
 
@@ -761,6 +777,21 @@ namespace DdMd
       */
       bool reverseUpdateFlag() const;
 
+      /**
+      * Are ghost position updates sent in single precision?
+      *
+      * See Exchanger::setFloatUpdateFlag().
+      */
+      bool floatUpdateFlag() const;
+
+      /**
+      * Get number of atom exchanges between spatial sorts of atoms.
+      *
+      * A value of zero (the default) indicates that atoms are never
+      * sorted. See Exchanger::setSortInterval().
+      */
+      int sortInterval() const;
+
       //@}
       /// \name Signals
       //@{
@@ -1035,6 +1066,9 @@ namespace DdMd
       /// Does this simulation keep track of AtomContext info?
       bool hasAtomContext_;
 
+      /// Number of atom exchanges (pair list builds) per spatial sort.
+      int sortInterval_;
+
       /**
       * Policy for suppressing pair interactions for some atom pairs.
       *
@@ -1048,6 +1082,9 @@ namespace DdMd
       /// Is reverse communication enabled?
       bool reverseUpdateFlag_;
 
+      /// Are ghost updates sent as single precision displacements?
+      bool floatUpdateFlag_;
+
       #ifdef UTIL_MPI
       /// Communicator for this system.
       MPI::Intracomm communicator_;
@@ -1276,6 +1313,13 @@ namespace DdMd
    inline bool Simulation::reverseUpdateFlag() const
    {  return reverseUpdateFlag_; }
 
+   inline bool Simulation::floatUpdateFlag() const
+   {  return floatUpdateFlag_; }
+
+   /// Get the interval for spatial sorting of atoms.
+   inline int Simulation::sortInterval() const
+   {  return sortInterval_; }
+
    // Signals
 
    /// Signal to force unsetting of all computed quantities.
@@ -0,0 +1,171 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "AtomMirror.h"
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   AtomMirror::AtomMirror()
+    : x_(),
+      y_(),
+      z_(),
+      fx_(),
+      fy_(),
+      fz_(),
+      typeIds_(),
+      threadForces_(),
+      xf_(),
+      yf_(),
+      zf_(),
+      origin_(Vector::Zero),
+      capacity_(0),
+      nThread_(1)
+   {}
+
+   /*
+   * Destructor.
+   */
+   AtomMirror::~AtomMirror()
+   {}
+
+   /*
+   * Allocate all arrays.
+   */
+   void AtomMirror::allocate(int capacity)
+   {
+      if (isAllocated()) {
+         UTIL_THROW("AtomMirror is already allocated");
+      }
+      capacity_ = capacity;
+      x_.allocate(capacity);
+      y_.allocate(capacity);
+      z_.allocate(capacity);
+      fx_.allocate(capacity);
+      fy_.allocate(capacity);
+      fz_.allocate(capacity);
+      typeIds_.allocate(capacity);
+      for (int i = 0; i < capacity; ++i) {
+         x_[i] = 0.0;
+         y_[i] = 0.0;
+         z_[i] = 0.0;
+         typeIds_[i] = 0;
+      }
+      zeroForces();
+   }
+
+   /*
+   * Allocate private force arrays for threads 1 <= t < nThread.
+   */
+   void AtomMirror::allocateThreadForces(int nThread)
+   {
+      if (!isAllocated()) {
+         UTIL_THROW("AtomMirror is not allocated");
+      }
+      if (nThread < 1) {
+         UTIL_THROW("nThread must be positive");
+      }
+      if (nThread == nThread_) {
+         return;
+      }
+      if (threadForces_.isAllocated()) {
+         threadForces_.deallocate();
+      }
+      nThread_ = nThread;
+      if (nThread_ > 1) {
+         threadForces_.allocate(3*(nThread_ - 1)*capacity_);
+         for (int t = 1; t < nThread_; ++t) {
+            zeroForces(t);
+         }
+      }
+   }
+
+   /*
+   * Allocate single precision position arrays.
+   */
+   void AtomMirror::allocateFloat()
+   {
+      if (!isAllocated()) {
+         UTIL_THROW("AtomMirror is not allocated");
+      }
+      if (hasFloat()) {
+         return;
+      }
+      xf_.allocate(capacity_);
+      yf_.allocate(capacity_);
+      zf_.allocate(capacity_);
+      for (int i = 0; i < capacity_; ++i) {
+         xf_[i] = 0.0f;
+         yf_[i] = 0.0f;
+         zf_[i] = 0.0f;
+      }
+   }
+
+   /*
+   * Set all force components to zero.
+   */
+   void AtomMirror::zeroForces()
+   {
+      double* fx = fx_.cArray();
+      double* fy = fy_.cArray();
+      double* fz = fz_.cArray();
+      for (int i = 0; i < capacity_; ++i) {
+         fx[i] = 0.0;
+         fy[i] = 0.0;
+         fz[i] = 0.0;
+      }
+   }
+
+   /*
+   * Set all force components for one thread to zero.
+   */
+   void AtomMirror::zeroForces(int threadId)
+   {
+      assert(threadId < nThread_);
+      double* fx = this->fx(threadId);
+      double* fy = this->fy(threadId);
+      double* fz = this->fz(threadId);
+      for (int i = 0; i < capacity_; ++i) {
+         fx[i] = 0.0;
+         fy[i] = 0.0;
+         fz[i] = 0.0;
+      }
+   }
+
+   /*
+   * Add private thread forces to main force arrays, for a range.
+   */
+   void AtomMirror::reduceThreadForces(int begin, int end, int nTeam)
+   {
+      assert(begin >= 0);
+      assert(end <= capacity_);
+      assert(nTeam <= nThread_);
+      double* fx = fx_.cArray();
+      double* fy = fy_.cArray();
+      double* fz = fz_.cArray();
+      const double* tfx;
+      const double* tfy;
+      const double* tfz;
+      int i;
+      for (int t = 1; t < nTeam; ++t) {
+         tfx = this->fx(t);
+         tfy = this->fy(t);
+         tfz = this->fz(t);
+         for (i = begin; i < end; ++i) {
+            fx[i] += tfx[i];
+            fy[i] += tfy[i];
+            fz[i] += tfz[i];
+         }
+      }
+   }
+
+}
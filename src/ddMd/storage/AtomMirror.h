@@ -0,0 +1,363 @@
+#ifndef DDMD_ATOM_MIRROR_H
+#define DDMD_ATOM_MIRROR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/DArray.h>       // member template
+#include <util/space/Vector.h>            // member
+#include <util/global.h>
+
+namespace DdMd
+{
+
+   using namespace Util;
+
+   /**
+   * A structure-of-arrays mirror of atom positions, forces and types.
+   *
+   * An AtomMirror stores the Cartesian components of the position and
+   * force of each atom in separate contiguous arrays of doubles (x, y,
+   * z and fx, fy, fz), along with a separate integer array of atom type
+   * ids. This layout allows inner loops of nonbonded force calculations
+   * to load coordinates for a run of neighbors with unit stride, rather
+   * than reading fields of interleaved Atom objects, so that the loops
+   * can be vectorized by the compiler.
+   *
+   * An AtomMirror is owned by the AtomStorage, which also defines the
+   * indexing scheme: Local atoms occupy elements 0 <= i < atomCapacity,
+   * in the order of the underlying local AtomArray, and ghost atoms
+   * occupy elements atomCapacity <= i < atomCapacity + ghostCapacity.
+   * See AtomStorage::mirrorId(), AtomStorage::fillMirror() and
+   * AtomStorage::addMirrorForces().
+   *
+   * For use with multiple threads, an AtomMirror may also hold private
+   * force arrays for threads 1 <= t < nThread, which are accessed by
+   * fx(t), fy(t) and fz(t). Thread 0 uses the main force arrays. Each
+   * thread accumulates forces in its own arrays, which are then added 
+   * to the main arrays by reduceThreadForces().
+   *
+   * For mixed-precision force calculations, an AtomMirror may also hold
+   * single precision copies of the position components (xf, yf, zf),
+   * which are allocated by allocateFloat(). These store positions 
+   * relative to an origin set by setOrigin(), which is normally chosen
+   * near the center of the processor domain, so that the precision of
+   * separations between nearby atoms is independent of the size of the
+   * system. Forces are always stored in double precision.
+   *
+   * \ingroup DdMd_Storage_Atom_Module
+   */
+   class AtomMirror
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      AtomMirror();
+
+      /**
+      * Destructor.
+      */
+      ~AtomMirror();
+
+      /**
+      * Allocate all arrays.
+      *
+      * \param capacity number of elements in each array
+      */
+      void allocate(int capacity);
+
+      /**
+      * Allocate private force arrays for threads 1 <= t < nThread.
+      *
+      * May be called more than once. Reallocates only if nThread has
+      * changed. Must be called after allocate().
+      *
+      * \param nThread number of threads
+      */
+      void allocateThreadForces(int nThread);
+
+      /**
+      * Allocate single precision position arrays.
+      *
+      * May be called more than once. Allocates only if not already
+      * allocated. Must be called after allocate().
+      */
+      void allocateFloat();
+
+      /**
+      * Set the origin for single precision positions.
+      *
+      * \param origin Cartesian position of origin
+      */
+      void setOrigin(const Vector& origin);
+
+      /**
+      * Set all force components to zero.
+      */
+      void zeroForces();
+
+      /**
+      * Set all force components in the arrays of one thread to zero.
+      *
+      * \param threadId thread index, 0 <= threadId < nThread
+      */
+      void zeroForces(int threadId);
+
+      /**
+      * Add private thread forces to the main force arrays.
+      *
+      * Adds forces for elements begin <= i < end from the arrays of 
+      * threads 1 <= t < nTeam to the main arrays. Arrays of threads that
+      * did not take part in the current calculation are ignored. Different
+      * threads may call this simultaneously for non-overlapping ranges.
+      *
+      * \param begin index of first element
+      * \param end   index one past the last element
+      * \param nTeam number of threads that computed forces, <= nThread
+      */
+      void reduceThreadForces(int begin, int end, int nTeam);
+
+      /// \name Array accessors (non-const)
+      //@{
+
+      /// Get array of x position components.
+      double* x();
+
+      /// Get array of y position components.
+      double* y();
+
+      /// Get array of z position components.
+      double* z();
+
+      /// Get array of x force components.
+      double* fx();
+
+      /// Get array of y force components.
+      double* fy();
+
+      /// Get array of z force components.
+      double* fz();
+
+      /// Get array of atom type ids.
+      int* typeIds();
+
+      /// Get array of x force components for a thread.
+      double* fx(int threadId);
+
+      /// Get array of y force components for a thread.
+      double* fy(int threadId);
+
+      /// Get array of z force components for a thread.
+      double* fz(int threadId);
+
+      /// Get array of x components of position relative to origin.
+      float* xf();
+
+      /// Get array of y components of position relative to origin.
+      float* yf();
+
+      /// Get array of z components of position relative to origin.
+      float* zf();
+
+      //@}
+      /// \name Array accessors (const)
+      //@{
+
+      /// Get array of x position components.
+      const double* x() const;
+
+      /// Get array of y position components.
+      const double* y() const;
+
+      /// Get array of z position components.
+      const double* z() const;
+
+      /// Get array of x force components.
+      const double* fx() const;
+
+      /// Get array of y force components.
+      const double* fy() const;
+
+      /// Get array of z force components.
+      const double* fz() const;
+
+      /// Get array of atom type ids.
+      const int* typeIds() const;
+
+      /// Get array of x components of position relative to origin.
+      const float* xf() const;
+
+      /// Get array of y components of position relative to origin.
+      const float* yf() const;
+
+      /// Get array of z components of position relative to origin.
+      const float* zf() const;
+
+      //@}
+
+      /**
+      * Return number of elements in each array.
+      */
+      int capacity() const;
+
+      /**
+      * Return number of threads for which force arrays exist.
+      */
+      int nThread() const;
+
+      /**
+      * Has memory been allocated?
+      */
+      bool isAllocated() const;
+
+      /**
+      * Have single precision position arrays been allocated?
+      */
+      bool hasFloat() const;
+
+      /**
+      * Get the origin for single precision positions.
+      */
+      const Vector& origin() const;
+
+   private:
+
+      // Position components.
+      DArray<double> x_;
+      DArray<double> y_;
+      DArray<double> z_;
+
+      // Force components.
+      DArray<double> fx_;
+      DArray<double> fy_;
+      DArray<double> fz_;
+
+      // Atom type ids.
+      DArray<int> typeIds_;
+
+      // Private force arrays of threads 1 <= t < nThread.
+      DArray<double> threadForces_;
+
+      // Single precision position components, relative to origin_.
+      DArray<float> xf_;
+      DArray<float> yf_;
+      DArray<float> zf_;
+
+      // Origin for single precision positions.
+      Vector origin_;
+
+      // Number of elements in each array.
+      int capacity_;
+
+      // Number of threads (1 + number of sets of private force arrays).
+      int nThread_;
+
+   };
+
+   // Inline member functions
+
+   inline double* AtomMirror::x()
+   {  return x_.cArray(); }
+
+   inline double* AtomMirror::y()
+   {  return y_.cArray(); }
+
+   inline double* AtomMirror::z()
+   {  return z_.cArray(); }
+
+   inline double* AtomMirror::fx()
+   {  return fx_.cArray(); }
+
+   inline double* AtomMirror::fy()
+   {  return fy_.cArray(); }
+
+   inline double* AtomMirror::fz()
+   {  return fz_.cArray(); }
+
+   inline int* AtomMirror::typeIds()
+   {  return typeIds_.cArray(); }
+
+   inline double* AtomMirror::fx(int threadId)
+   {
+      if (threadId == 0) return fx_.cArray();
+      return threadForces_.cArray() + (3*threadId - 3)*capacity_; 
+   }
+
+   inline double* AtomMirror::fy(int threadId)
+   {
+      if (threadId == 0) return fy_.cArray();
+      return threadForces_.cArray() + (3*threadId - 2)*capacity_; 
+   }
+
+   inline double* AtomMirror::fz(int threadId)
+   {
+      if (threadId == 0) return fz_.cArray();
+      return threadForces_.cArray() + (3*threadId - 1)*capacity_; 
+   }
+
+   inline float* AtomMirror::xf()
+   {  return xf_.cArray(); }
+
+   inline float* AtomMirror::yf()
+   {  return yf_.cArray(); }
+
+   inline float* AtomMirror::zf()
+   {  return zf_.cArray(); }
+
+   inline const double* AtomMirror::x() const
+   {  return x_.cArray(); }
+
+   inline const double* AtomMirror::y() const
+   {  return y_.cArray(); }
+
+   inline const double* AtomMirror::z() const
+   {  return z_.cArray(); }
+
+   inline const double* AtomMirror::fx() const
+   {  return fx_.cArray(); }
+
+   inline const double* AtomMirror::fy() const
+   {  return fy_.cArray(); }
+
+   inline const double* AtomMirror::fz() const
+   {  return fz_.cArray(); }
+
+   inline const int* AtomMirror::typeIds() const
+   {  return typeIds_.cArray(); }
+
+   inline const float* AtomMirror::xf() const
+   {  return xf_.cArray(); }
+
+   inline const float* AtomMirror::yf() const
+   {  return yf_.cArray(); }
+
+   inline const float* AtomMirror::zf() const
+   {  return zf_.cArray(); }
+
+   inline void AtomMirror::setOrigin(const Vector& origin)
+   {  origin_ = origin; }
+
+   inline const Vector& AtomMirror::origin() const
+   {  return origin_; }
+
+   inline int AtomMirror::capacity() const
+   {  return capacity_; }
+
+   inline int AtomMirror::nThread() const
+   {  return nThread_; }
+
+   inline bool AtomMirror::isAllocated() const
+   {  return x_.isAllocated(); }
+
+   inline bool AtomMirror::hasFloat() const
+   {  return xf_.isAllocated(); }
+
+}
+#endif
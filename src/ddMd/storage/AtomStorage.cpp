@@ -15,11 +15,27 @@
 #include <util/mpi/MpiLoader.h>
 #include <util/global.h>
 
+#include <algorithm>
+
 namespace DdMd
 {
 
    using namespace Util;
 
+   /*
+   * Spread the 10 lowest bits of an integer so that there are two zero 
+   * bits between each pair of bits, for use in a 3D Morton index.
+   */
+   static unsigned int spreadBits(unsigned int i)
+   {
+      i &= 0x000003ff;
+      i = (i | (i << 16)) & 0xff0000ff;
+      i = (i | (i <<  8)) & 0x0300f00f;
+      i = (i | (i <<  4)) & 0x030c30c3;
+      i = (i | (i <<  2)) & 0x09249249;
+      return i;
+   }
+
    /*
    * Default constructor.
    */
@@ -270,6 +286,128 @@ namespace DdMd
       }
    }
 
+   /*
+   * Reorder local atoms along a Morton space-filling curve.
+   */
+   void AtomStorage::sortAtoms(const Vector& lower, const Vector& upper,
+                               const IntVector& nCell)
+   {
+      // Preconditions
+      if (locked_) {
+         UTIL_THROW("AtomStorage is locked");
+      }
+      if (newAtomPtr_ != 0) {
+         UTIL_THROW("Unregistered newAtomPtr_ still active");
+      }
+      if (ghostSet_.size() != 0) {
+         UTIL_THROW("Ghosts must be cleared before sortAtoms");
+      }
+
+      // Allocate work space on first use
+      if (!sortKeys_.isAllocated()) {
+         sortKeys_.allocate(atomCapacity_);
+         sortSource_.allocate(atomCapacity_);
+         sortDest_.allocate(atomCapacity_);
+         sortTemp_.allocate(1);
+      }
+
+      // Compute Morton key for each local atom
+      double scale[Dimension];
+      unsigned int c[Dimension];
+      double x;
+      int i, j, k, n;
+      for (j = 0; j < Dimension; ++j) {
+         if (nCell[j] < 1 || nCell[j] > 1024) {
+            UTIL_THROW("Number of sorting cells out of range");
+         }
+         scale[j] = double(nCell[j])/(upper[j] - lower[j]);
+      }
+      n = atomSet_.size();
+      for (k = 0; k < n; ++k) {
+         const Vector& r = atomSet_[k].position();
+         for (j = 0; j < Dimension; ++j) {
+            x = (r[j] - lower[j])*scale[j];
+            if (x < 0.0) {
+               c[j] = 0;
+            } else 
+            if (x >= double(nCell[j])) {
+               c[j] = nCell[j] - 1;
+            } else {
+               c[j] = (unsigned int)x;
+            }
+         }
+         sortKeys_[k].first = spreadBits(c[0]) | (spreadBits(c[1]) << 1)
+                            | (spreadBits(c[2]) << 2);
+         sortKeys_[k].second = int(&atomSet_[k] - atoms_.cArray());
+      }
+
+      // Sort by key (ties are broken by array index)
+      std::sort(&sortKeys_[0], &sortKeys_[0] + n);
+
+      // Construct a permutation of the entire atom array: Element i of 
+      // the new array is element sortSource_[i] of the old array. Atoms
+      // are moved to elements 0,...,n-1, and unused elements fill the
+      // remainder in order of increasing index.
+      for (i = 0; i < atomCapacity_; ++i) {
+         sortDest_[i] = -1;
+      }
+      for (k = 0; k < n; ++k) {
+         sortSource_[k] = sortKeys_[k].second;
+         sortDest_[sortKeys_[k].second] = k;
+      }
+      k = n;
+      for (i = 0; i < atomCapacity_; ++i) {
+         if (sortDest_[i] < 0) {
+            sortSource_[k] = i;
+            sortDest_[i] = k;
+            ++k;
+         }
+      }
+      assert(k == atomCapacity_);
+
+      // Remove all local atoms from the map and the atom set.
+      for (k = 0; k < n; ++k) {
+         map_.removeLocal(&atomSet_[k]);
+      }
+      atomSet_.clear();
+
+      // Apply the permutation in place, one cycle at a time.
+      // Elements that have been moved are marked by sortSource_[i] = -1.
+      Atom& temp = sortTemp_[0];
+      int first;
+      for (first = 0; first < atomCapacity_; ++first) {
+         if (sortSource_[first] < 0) continue;
+         if (sortSource_[first] == first) {
+            sortSource_[first] = -1;
+            continue;
+         }
+         temp = atoms_[first];
+         i = first;
+         while (true) {
+            j = sortSource_[i];
+            sortSource_[i] = -1;
+            if (j == first) {
+               atoms_[i] = temp;
+               break;
+            }
+            atoms_[i] = atoms_[j];
+            i = j;
+         }
+      }
+
+      // Restore the atom set, map and reservoir.
+      for (k = 0; k < n; ++k) {
+         atomSet_.append(atoms_[k]);
+         map_.addLocal(&atoms_[k]);
+      }
+      while (atomReservoir_.size() > 0) {
+         atomReservoir_.pop();
+      }
+      for (i = atomCapacity_ - 1; i >= n; --i) {
+         atomReservoir_.push(atoms_[i]);
+      }
+   }
+
    // Ghost atom mutators
 
    /*
@@ -424,6 +562,150 @@ namespace DdMd
       return max;
    }
 
+   // Structure-of-arrays mirror
+
+   /*
+   * Allocate the mirror arrays, if not already allocated.
+   */
+   void AtomStorage::allocateMirror()
+   {
+      if (!isInitialized_) {
+         UTIL_THROW("AtomStorage not initialized in allocateMirror");
+      }
+      if (!mirror_.isAllocated()) {
+         mirror_.allocate(atomCapacity_ + ghostCapacity_);
+      }
+   }
+
+   /*
+   * Copy positions and types of atoms and ghosts into the mirror.
+   */
+   void AtomStorage::fillMirror()
+   {
+      fillLocalMirror();
+      fillGhostMirror();
+   }
+
+   /*
+   * Copy positions and types of local atoms into the mirror.
+   */
+   void AtomStorage::fillLocalMirror()
+   {
+      assert(mirror_.isAllocated());
+      double* x = mirror_.x();
+      double* y = mirror_.y();
+      double* z = mirror_.z();
+      double* fx = mirror_.fx();
+      double* fy = mirror_.fy();
+      double* fz = mirror_.fz();
+      int* typeIds = mirror_.typeIds();
+      int i;
+
+      AtomIterator atomIter;
+      for (begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         i = mirrorId(atomIter.get());
+         const Vector& r = atomIter->position();
+         x[i] = r[0];
+         y[i] = r[1];
+         z[i] = r[2];
+         fx[i] = 0.0;
+         fy[i] = 0.0;
+         fz[i] = 0.0;
+         typeIds[i] = atomIter->typeId();
+      }
+
+      // Copy positions relative to origin in single precision
+      if (mirror_.hasFloat()) {
+         float* xf = mirror_.xf();
+         float* yf = mirror_.yf();
+         float* zf = mirror_.zf();
+         const Vector& origin = mirror_.origin();
+         for (begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            i = mirrorId(atomIter.get());
+            const Vector& r = atomIter->position();
+            xf[i] = (float)(r[0] - origin[0]);
+            yf[i] = (float)(r[1] - origin[1]);
+            zf[i] = (float)(r[2] - origin[2]);
+         }
+      }
+   }
+
+   /*
+   * Copy positions and types of ghost atoms into the mirror.
+   */
+   void AtomStorage::fillGhostMirror()
+   {
+      assert(mirror_.isAllocated());
+      double* x = mirror_.x();
+      double* y = mirror_.y();
+      double* z = mirror_.z();
+      double* fx = mirror_.fx();
+      double* fy = mirror_.fy();
+      double* fz = mirror_.fz();
+      int* typeIds = mirror_.typeIds();
+      int i;
+
+      GhostIterator ghostIter;
+      for (begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+         i = mirrorId(ghostIter.get());
+         const Vector& r = ghostIter->position();
+         x[i] = r[0];
+         y[i] = r[1];
+         z[i] = r[2];
+         fx[i] = 0.0;
+         fy[i] = 0.0;
+         fz[i] = 0.0;
+         typeIds[i] = ghostIter->typeId();
+      }
+
+      // Copy positions relative to origin in single precision
+      if (mirror_.hasFloat()) {
+         float* xf = mirror_.xf();
+         float* yf = mirror_.yf();
+         float* zf = mirror_.zf();
+         const Vector& origin = mirror_.origin();
+         for (begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+            i = mirrorId(ghostIter.get());
+            const Vector& r = ghostIter->position();
+            xf[i] = (float)(r[0] - origin[0]);
+            yf[i] = (float)(r[1] - origin[1]);
+            zf[i] = (float)(r[2] - origin[2]);
+         }
+      }
+   }
+
+   /*
+   * Add forces accumulated in the mirror to atomic forces.
+   */
+   void AtomStorage::addMirrorForces(bool addGhosts)
+   {
+      assert(mirror_.isAllocated());
+      const double* fx = mirror_.fx();
+      const double* fy = mirror_.fy();
+      const double* fz = mirror_.fz();
+      int i;
+
+      AtomIterator atomIter;
+      for (begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         i = mirrorId(atomIter.get());
+         Vector& f = atomIter->force();
+         f[0] += fx[i];
+         f[1] += fy[i];
+         f[2] += fz[i];
+      }
+
+      if (addGhosts) {
+         GhostIterator ghostIter;
+         for (begin(ghostIter); ghostIter.notEnd(); ++ghostIter) {
+            i = mirrorId(ghostIter.get());
+            Vector& f = ghostIter->force();
+            f[0] += fx[i];
+            f[1] += fy[i];
+            f[2] += fz[i];
+         }
+      }
+   }
+
    // Accessors
 
    /*
@@ -11,6 +11,7 @@
 #include <util/param/ParamComposite.h>        // base class
 #include <ddMd/chemistry/AtomArray.h>         // member
 #include <ddMd/storage/AtomMap.h>             // member
+#include <ddMd/storage/AtomMirror.h>          // member
 #include <ddMd/communicate/AtomDistributor.h> // member
 #include <ddMd/communicate/AtomCollector.h>   // member
 #include <ddMd/chemistry/Atom.h>              // member template argument
@@ -20,8 +21,11 @@
 #include <util/containers/ArrayStack.h>       // member template
 #include <util/misc/Setable.h>                // member template
 #include <util/boundary/Boundary.h>           // typedef
+#include <util/space/IntVector.h>             // function parameter
 #include <util/global.h>
 
+#include <utility>
+
 class AtomStorageTest;
 
 namespace DdMd
@@ -200,6 +204,30 @@ namespace DdMd
       */
       void clearAtoms(); 
 
+      /**
+      * Reorder local atoms in memory along a space-filling curve.
+      *
+      * Local atoms are sorted by the Morton (Z-order) index of the cell
+      * that contains each atom, in a grid of nCell[0] x nCell[1] x 
+      * nCell[2] cells that spans the region lower <= r < upper, and are
+      * then moved into a contiguous block at the beginning of the local 
+      * atom array, in this order. Atoms outside this region are assigned
+      * to the nearest cell. Subsequent iteration over local atoms visits
+      * them in the new order. Positions, lower and upper must all use 
+      * the same coordinate system.
+      *
+      * This function may only be called when there are no ghosts. All 
+      * pointers to local atoms that are held outside of this AtomStorage,
+      * e.g., by Group objects, are invalidated, and must be reset by the
+      * caller (e.g., by AtomMap::findGroupLocalAtoms).
+      *
+      * \param lower lower bounds of the region
+      * \param upper upper bounds of the region
+      * \param nCell number of cells in each direction (each <= 1024)
+      */
+      void sortAtoms(const Vector& lower, const Vector& upper, 
+                     const IntVector& nCell);
+
       /**
       * Return number of local atoms on this procesor (excluding ghosts)
       */
@@ -379,6 +407,93 @@ namespace DdMd
       */
       void begin(ConstGhostIterator& iterator) const;
 
+      /**
+      * Return the local atom with index i in the order of iteration.
+      *
+      * Provides random access to the set of local atoms, for loops 
+      * that are divided among threads.
+      *
+      * \param i index of atom in set, 0 <= i < nAtom()
+      */
+      Atom& atom(int i);
+
+      //@}
+      /// \name Structure-of-Arrays Mirror
+      //@{
+
+      /**
+      * Allocate memory for the AtomMirror, if not already allocated.
+      *
+      * The mirror has atomCapacity + ghostCapacity elements. This 
+      * function may be called repeatedly, and only allocates on the
+      * first call. It must be called after initialization.
+      */
+      void allocateMirror();
+
+      /**
+      * Copy positions and type ids of all atoms and ghosts to the mirror.
+      *
+      * Also zeros the mirror forces for all local and ghost atoms. 
+      * Positions must be Cartesian if the mirror is to be used for 
+      * force calculation. If single precision arrays have been 
+      * allocated (AtomMirror::allocateFloat), they are also filled
+      * with positions relative to AtomMirror::origin().
+      */
+      void fillMirror();
+
+      /**
+      * Copy positions and type ids of local atoms to the mirror.
+      *
+      * Also zeros the mirror forces for local atoms. This and 
+      * fillGhostMirror() together are equivalent to fillMirror(), but
+      * allow the mirror to be filled with local atoms before ghost 
+      * positions are updated.
+      */
+      void fillLocalMirror();
+
+      /**
+      * Copy positions and type ids of ghost atoms to the mirror.
+      *
+      * Also zeros the mirror forces for ghost atoms. 
+      */
+      void fillGhostMirror();
+
+      /**
+      * Add forces accumulated in the mirror to atomic forces.
+      *
+      * Forces are always added to local atoms. Forces are added to
+      * ghost atoms only if addGhosts is true.
+      *
+      * \param addGhosts if true, also add ghost forces.
+      */
+      void addMirrorForces(bool addGhosts);
+
+      /**
+      * Return the index of an atom or ghost within the AtomMirror.
+      *
+      * Local atoms have indices 0 <= i < atomCapacity and ghosts have
+      * indices atomCapacity <= i < atomCapacity + ghostCapacity. The
+      * index is computed from the address of the Atom, and does not
+      * require access to the Atom object itself.
+      *
+      * \param atomPtr pointer to a local or ghost Atom in this storage
+      */
+      int mirrorId(const Atom* atomPtr) const;
+
+      /**
+      * Return a pointer to the atom or ghost with a given mirror index.
+      *
+      * This is the inverse of mirrorId(). 
+      *
+      * \param id index of an element in the mirror arrays
+      */
+      Atom* mirrorAtomPtr(int id);
+
+      /**
+      * Get the AtomMirror by reference.
+      */
+      AtomMirror& mirror();
+
       //@}
       /// \name Global Atom Counting
       //@{
@@ -550,6 +665,19 @@ namespace DdMd
       // Array of stored old positions.
       DArray<Vector>  snapshot_;
 
+      // Structure-of-arrays mirror of positions, forces and types.
+      AtomMirror  mirror_;
+
+      // Pairs of (Morton key, array index) used by sortAtoms.
+      DArray< std::pair<unsigned int, int> >  sortKeys_;
+
+      // Permutation work arrays used by sortAtoms.
+      DArray<int>  sortSource_;
+      DArray<int>  sortDest_;
+
+      // Temporary Atom used by sortAtoms.
+      AtomArray  sortTemp_;
+
       // Pointer to space for a new local Atom
       Atom*  newAtomPtr_;
 
@@ -635,6 +763,41 @@ namespace DdMd
    inline const AtomMap& AtomStorage::map() const
    { return map_; }
 
+   inline Atom& AtomStorage::atom(int i)
+   { return atomSet_[i]; }
+
+   inline AtomMirror& AtomStorage::mirror()
+   { return mirror_; }
+
+   /*
+   * Return index of a local or ghost atom within the mirror arrays.
+   */
+   inline int AtomStorage::mirrorId(const Atom* atomPtr) const
+   {
+      const Atom* begin = atoms_.cArray();
+      if (atomPtr >= begin && atomPtr < begin + atomCapacity_) {
+         return int(atomPtr - begin);
+      } else {
+         assert(atomPtr >= ghosts_.cArray());
+         assert(atomPtr < ghosts_.cArray() + ghostCapacity_);
+         return atomCapacity_ + int(atomPtr - ghosts_.cArray());
+      }
+   }
+
+   /*
+   * Return pointer to a local or ghost atom with a given mirror index.
+   */
+   inline Atom* AtomStorage::mirrorAtomPtr(int id)
+   {
+      assert(id >= 0);
+      assert(id < atomCapacity_ + ghostCapacity_);
+      if (id < atomCapacity_) {
+         return atoms_.cArray() + id;
+      } else {
+         return ghosts_.cArray() + (id - atomCapacity_);
+      }
+   }
+
    /*
    * On master processor (rank=0), stored value of total number of atoms.
    */
@@ -110,6 +110,16 @@ namespace DdMd
       * \param atomStorage AtomStorage object used to find atom pointers
       */
       virtual void findGhosts(AtomStorage& atomStorage) = 0;
+
+      /**
+      * Reset pointers to all local members of groups.
+      *
+      * Usage: This is called after local atoms have been reordered by
+      * AtomStorage::sortAtoms(), when the storage contains no ghosts.
+      *
+      * \param atomStorage AtomStorage object used to find atom pointers
+      */
+      virtual void findLocalAtoms(AtomStorage& atomStorage) = 0;
    
       /**
       * Return true if the container is valid, or throw an Exception.
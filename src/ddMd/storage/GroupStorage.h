@@ -238,6 +238,16 @@ namespace DdMd
       */
       Group<N>* find(int id) const;
 
+      /**
+      * Return the local group with index i in the order of iteration.
+      *
+      * Provides random access to the set of local groups, for loops 
+      * that are divided among threads.
+      *
+      * \param i index of group in set, 0 <= i < size()
+      */
+      Group<N>& group(int i);
+
       //@}
       /// \name Global Group Counting
       //@{
@@ -353,6 +363,17 @@ namespace DdMd
       */
       virtual
       void findGhosts(AtomStorage& atomStorage);
+
+      /**
+      * Reset pointers to all local members of groups.
+      *
+      * Usage: This is called after local atoms have been reordered by
+      * AtomStorage::sortAtoms(), when the storage contains no ghosts.
+      *
+      * \param atomStorage AtomStorage object used to find atom pointers
+      */
+      virtual
+      void findLocalAtoms(AtomStorage& atomStorage);
    
       /**
       * Return true if the container is valid, or throw an Exception.
@@ -505,6 +526,13 @@ namespace DdMd
    inline Group<N>* GroupStorage<N>::find(int id) const
    {  return groupPtrs_[id]; }
 
+   /*
+   * Return local group with index i in the set.
+   */
+   template <int N>
+   inline Group<N>& GroupStorage<N>::group(int i)
+   {  return groupSet_[i]; }
+
    /*
    * Set iterator to beginning of the set of local groups.
    */
@@ -823,5 +823,18 @@ namespace DdMd
       }
    }
 
+   /*
+   * Reset pointers to local members of groups after reordering atoms.
+   */
+   template <int N>
+   void GroupStorage<N>::findLocalAtoms(AtomStorage& atomStorage)
+   {
+      GroupIterator<N> groupIter;
+      const AtomMap& atomMap = atomStorage.map();
+      for (begin(groupIter); groupIter.notEnd(); ++groupIter) {
+         atomMap.findGroupLocalAtoms(*groupIter);
+      }
+   }
+
 } // namespace DdMd
 #endif
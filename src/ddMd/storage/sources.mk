@@ -1,6 +1,7 @@
 ddMd_storage_=\
    ddMd/storage/AtomMap.cpp \
    ddMd/storage/AtomStorage.cpp \
+   ddMd/storage/AtomMirror.cpp \
    ddMd/storage/GroupExchanger.cpp \
    ddMd/storage/BondStorage.cpp \
 
@@ -0,0 +1,20 @@
+#include "TrajectoryWriterTest.h"
+
+int main()
+{
+
+   #ifdef UTIL_MPI 
+   MPI::Init();
+   IntVector::commitMpiType();
+   Vector::commitMpiType();
+   #endif
+
+   TEST_RUNNER(TrajectoryWriterTest) runner;
+   runner.run();
+
+   #ifdef UTIL_MPI 
+   MPI::Finalize();
+   #endif
+
+}
+
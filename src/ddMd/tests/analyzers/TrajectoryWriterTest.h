@@ -0,0 +1,188 @@
+#ifndef DDMD_TRAJECTORY_WRITER_TEST_H
+#define DDMD_TRAJECTORY_WRITER_TEST_H
+
+#include <ddMd/simulation/Simulation.h>
+#include <ddMd/analyzers/trajectory/DdMdTrajectoryWriter.h>
+#include <ddMd/analyzers/trajectory/DdMdParallelTrajectoryWriter.h>
+#include <ddMd/communicate/Exchanger.h>
+#include <ddMd/storage/AtomIterator.h>
+#include <tools/storage/Configuration.h>
+#include <tools/chemistry/Atom.h>
+#include <tools/trajectory/DdMdTrajectoryReader.h>
+#include <tools/trajectory/DdMdParallelTrajectoryReader.h>
+#include <util/boundary/Boundary.h>
+#include <util/random/Random.h>
+
+#ifdef UTIL_MPI
+#ifndef TEST_MPI
+#define TEST_MPI
+#endif
+#endif
+
+#include <test/ParamFileTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <fstream>
+
+using namespace Util;
+using namespace DdMd;
+
+/*
+* Tests of trajectory writers. Must be run on 6 processors, as required
+* by the Domain gridDimensions in file in/param.
+*/
+class TrajectoryWriterTest : public ParamFileTest
+{
+
+public:
+
+   virtual void setUp()
+   {  Label::clear(); }
+
+   virtual void tearDown()
+   {  Label::clear(); }
+
+   void testParallelTrajectory();
+
+private:
+
+   void displaceAtoms(Simulation& simulation, double range);
+   void readParam(Tools::Configuration& configuration);
+
+};
+
+/*
+* Randomly displace all local atoms, and exchange them among processors.
+*/
+inline
+void TrajectoryWriterTest::displaceAtoms(Simulation& simulation, double range)
+{
+   const Boundary& boundary = simulation.boundary();
+   Random& random = simulation.random();
+   Vector ranges;
+   int i;
+   for (i = 0; i < Dimension; ++i) {
+      ranges[i] = range/boundary.length(i);
+   }
+   AtomIterator atomIter;
+   simulation.atomStorage().begin(atomIter);
+   for ( ; atomIter.notEnd(); ++atomIter) {
+      for (i = 0; i < Dimension; ++i) {
+         atomIter->position()[i] += random.uniform(-ranges[i], ranges[i]);
+      }
+   }
+   simulation.exchanger().exchange();
+}
+
+/*
+* Read parameters of a Tools::Configuration, and add atoms with all ids.
+*/
+inline
+void TrajectoryWriterTest::readParam(Tools::Configuration& configuration)
+{
+   std::ifstream in;
+   openInputFile("in/Configuration", in);
+   configuration.readParam(in);
+   in.close();
+
+   Tools::Atom* atomPtr;
+   for (int i = 0; i < configuration.atoms().capacity(); ++i) {
+      atomPtr = configuration.atoms().newPtr();
+      atomPtr->id = i;
+      configuration.atoms().add();
+   }
+}
+
+/*
+* Write frames with DdMdTrajectoryWriter and DdMdParallelTrajectoryWriter,
+* and check that the files contain the same frames when read by the
+* corresponding Tools trajectory readers.
+*/
+inline void TrajectoryWriterTest::testParallelTrajectory()
+{
+   printMethod(TEST_FUNC);
+
+   Simulation simulation;
+   simulation.fileMaster().setRootPrefix(filePrefix());
+   openFile("in/param");
+   simulation.readParam(file());
+   closeFile();
+   std::string filename("config");
+   simulation.readConfig(filename);
+
+   DdMdTrajectoryWriter writer(simulation);
+   DdMdParallelTrajectoryWriter parallelWriter(simulation);
+   #ifdef UTIL_MPI
+   writer.setIoCommunicator(simulation.domain().communicator());
+   parallelWriter.setIoCommunicator(simulation.domain().communicator());
+   #endif
+   openFile("in/DdMdTrajectoryWriter");
+   writer.readParam(file());
+   closeFile();
+   openFile("in/DdMdParallelTrajectoryWriter");
+   parallelWriter.readParam(file());
+   closeFile();
+
+   // Write frames, moving atoms among processors between frames
+   const int nFrame = 3;
+   int i;
+   writer.setup();
+   parallelWriter.setup();
+   for (i = 0; i < nFrame; ++i) {
+      writer.sample(10*i);
+      parallelWriter.sample(10*i);
+      displaceAtoms(simulation, 0.8);
+   }
+   writer.output();
+   parallelWriter.output();
+
+   // Read both files on the master processor
+   if (simulation.domain().isMaster()) {
+      Tools::Configuration configuration;
+      Tools::Configuration parallelConfiguration;
+      readParam(configuration);
+      readParam(parallelConfiguration);
+      Tools::DdMdTrajectoryReader reader(configuration);
+      Tools::DdMdParallelTrajectoryReader
+                                   parallelReader(parallelConfiguration);
+      Tools::AtomStorage& atoms = configuration.atoms();
+      Tools::AtomStorage& parallelAtoms = parallelConfiguration.atoms();
+      int nAtom = atoms.capacity();
+
+      std::ifstream file;
+      std::ifstream parallelFile;
+      openInputFile("serial.trj", file);
+      openInputFile("parallel.trj", parallelFile);
+      reader.readHeader(file);
+      parallelReader.readHeader(parallelFile);
+
+      // Positions of atom 0 in previous frame
+      Vector prior;
+      int nFrameRead = 0;
+      int id;
+      while (reader.readFrame(file)) {
+         TEST_ASSERT(parallelReader.readFrame(parallelFile));
+         TEST_ASSERT(parallelConfiguration.boundary().lengths()
+                     == configuration.boundary().lengths());
+         for (id = 0; id < nAtom; ++id) {
+            TEST_ASSERT(parallelAtoms.ptr(id)->position
+                        == atoms.ptr(id)->position);
+         }
+         if (nFrameRead > 0) {
+            TEST_ASSERT(!(atoms.ptr(0)->position == prior));
+         }
+         prior = atoms.ptr(0)->position;
+         ++nFrameRead;
+      }
+      TEST_ASSERT(!parallelReader.readFrame(parallelFile));
+      TEST_ASSERT(nFrameRead == nFrame);
+      file.close();
+      parallelFile.close();
+   }
+}
+
+TEST_BEGIN(TrajectoryWriterTest)
+TEST_ADD(TrajectoryWriterTest, testParallelTrajectory)
+TEST_END(TrajectoryWriterTest)
+
+#endif
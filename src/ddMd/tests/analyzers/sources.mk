@@ -0,0 +1,7 @@
+ddMd_tests_analyzers_=ddMd/tests/analyzers/Test.cc
+
+ddMd_tests_analyzers_SRCS=\
+     $(addprefix $(SRC_DIR)/, $(ddMd_tests_analyzers_))
+ddMd_tests_analyzers_OBJS=\
+     $(addprefix $(BLD_DIR)/, $(ddMd_tests_analyzers_:.cc=.o))
+
@@ -339,6 +339,109 @@ public:
 
    }
 
+   void testGrowSendRecv()
+   {
+      printMethod(TEST_FUNC);
+
+      int myrank   = MPI::COMM_WORLD.Get_rank();
+      int commsize = MPI::COMM_WORLD.Get_size();
+      int source = (myrank + commsize - 1) % commsize;
+      int dest   = (myrank + commsize + 1) % commsize;
+
+      // Pack more atoms than the initial capacity of the buffer
+      int capacity = buffer_.sendCapacity();
+      int nAtom = 3*buffer_.atomCapacity() + 1;
+      AtomArray atoms;
+      atoms.allocate(nAtom + 1);
+      Vector pos;
+      int k;
+      buffer_.clearSendBuffer();
+      buffer_.beginSendBlock(Buffer::ATOM);
+      for (k = 0; k < nAtom; ++k) {
+         atoms[k].setId(k);
+         atoms[k].setTypeId(0);
+         pos[0] = myrank + k;
+         pos[1] = 2.0*k;
+         pos[2] = 3.0*k;
+         atoms[k].position() = pos;
+         atoms[k].velocity() = pos;
+         atoms[k].plan().setFlags(1);
+         atoms[k].packAtom(buffer_);
+      }
+      buffer_.endSendBlock();
+      TEST_ASSERT(buffer_.sendCapacity() > capacity);
+
+      buffer_.sendRecv(MPI::COMM_WORLD, source, dest, 0);
+      TEST_ASSERT(buffer_.recvCapacity() > capacity);
+
+      // Unpack atoms
+      buffer_.beginRecvBlock();
+      TEST_ASSERT(buffer_.recvSize() == nAtom);
+      for (k = 0; k < nAtom; ++k) {
+         atoms[nAtom].unpackAtom(buffer_);
+         TEST_ASSERT(atoms[nAtom].id() == k);
+         TEST_ASSERT(feq(atoms[nAtom].position()[0], double(source + k)));
+         TEST_ASSERT(feq(atoms[nAtom].position()[2], 3.0*k));
+      }
+      buffer_.endRecvBlock();
+
+      buffer_.computeStatistics(MPI::COMM_WORLD);
+      TEST_ASSERT(buffer_.maxChannelSend(0) > capacity);
+      TEST_ASSERT(buffer_.maxChannelSend(1) == 0);
+   }
+
+   void testPersistentSendRecv()
+   {
+      printMethod(TEST_FUNC);
+
+      int myrank   = MPI::COMM_WORLD.Get_rank();
+      int commsize = MPI::COMM_WORLD.Get_size();
+      int source = (myrank + commsize - 1) % commsize;
+      int dest   = (myrank + commsize + 1) % commsize;
+
+      // Repeat a fixed size message, so the persistent requests for
+      // a channel are reused, then change its size.
+      AtomArray atoms;
+      atoms.allocate(3);
+      Vector pos;
+      int channel = Buffer::NChannel - 1;
+      int n, m, k;
+      for (m = 0; m < 4; ++m) {
+         n = (m < 3) ? 2 : 3;
+         buffer_.clearSendBuffer();
+         buffer_.beginSendBlock(Buffer::GHOST);
+         for (k = 0; k < n; ++k) {
+            atoms[k].setId(k);
+            atoms[k].setTypeId(0);
+            pos[0] = 10.0*myrank + m;
+            pos[1] = k;
+            pos[2] = 0.0;
+            atoms[k].position() = pos;
+            atoms[k].plan().setFlags(0);
+            atoms[k].packGhost(buffer_);
+         }
+         buffer_.endSendBlock();
+
+         buffer_.beginSendRecv(MPI::COMM_WORLD, source, dest, channel);
+         TEST_ASSERT(buffer_.isPending());
+         buffer_.endSendRecv();
+         TEST_ASSERT(!buffer_.isPending());
+
+         buffer_.beginRecvBlock();
+         TEST_ASSERT(buffer_.recvSize() == n);
+         for (k = 0; k < n; ++k) {
+            atoms[k].unpackGhost(buffer_);
+            TEST_ASSERT(atoms[k].id() == k);
+            TEST_ASSERT(feq(atoms[k].position()[0], 10.0*source + m));
+            TEST_ASSERT(feq(atoms[k].position()[1], double(k)));
+         }
+         buffer_.endRecvBlock();
+      }
+
+      buffer_.computeStatistics(MPI::COMM_WORLD);
+      TEST_ASSERT(buffer_.maxChannelSend(channel) > 0);
+   }
+
    //Test Method for MPI Send and MPI Recv methods for local atoms
    void testAtomSend_Recv()
    {
@@ -861,6 +964,8 @@ TEST_ADD(BufferTest, testPackAtom)
 TEST_ADD(BufferTest, testPackGhost)
 TEST_ADD(BufferTest, testAtomSendRecv)
 TEST_ADD(BufferTest, testGhostSendRecv)
+TEST_ADD(BufferTest, testGrowSendRecv)
+TEST_ADD(BufferTest, testPersistentSendRecv)
 TEST_ADD(BufferTest, testAtomSend_Recv)
 TEST_ADD(BufferTest, testGhostSend_Recv)
 TEST_ADD(BufferTest, testAtomGhostSend_Recv)
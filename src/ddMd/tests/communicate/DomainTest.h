@@ -130,6 +130,60 @@ public:
 
    }
 
+   void testSetBounds()
+   {  
+      printMethod(TEST_FUNC); 
+
+      Boundary boundary;
+      #ifdef UTIL_MPI
+      openFile("in/Domain"); 
+      #else
+      openFile("in/Domain.111"); 
+      domain_.setRank(0);
+      #endif
+      domain_.setBoundary(boundary);
+      domain_.readParam(file()); 
+
+      // Move inner planes along each axis towards the origin
+      int i, k, n;
+      for (i = 0; i < Dimension; ++i) {
+         n = domain_.gridDimension(i);
+         DArray<double> bounds;
+         bounds.allocate(n + 1);
+         for (k = 0; k <= n; ++k) {
+            bounds[k] = domain_.bound(i, k);
+            if (k > 0 && k < n) {
+               bounds[k] -= 0.25/double(n);
+            }
+         }
+         domain_.setBounds(i, bounds);
+         for (k = 0; k <= n; ++k) {
+            TEST_ASSERT(eq(domain_.bound(i, k), bounds[k]));
+         }
+         for (k = 0; k < 2; ++k) {
+            TEST_ASSERT(eq(domain_.domainBound(i, k), 
+                           bounds[domain_.gridCoordinate(i) + k]));
+         }
+      }
+
+      // Check consistency of ownerRank and isInDomain
+      Vector position;
+      double frac;
+      int j, m;
+      for (j = 0; j < 5; ++j) {
+         for (m = 0; m < 5; ++m) {
+            frac = 0.1 + 0.2*double(j);
+            for (i = 0; i < Dimension; ++i) {
+               position[i] = (1.0 - frac)*domain_.domainBound(i, 0) 
+                           + frac*domain_.domainBound(i, 1);
+               frac = 0.1 + 0.2*double(m);
+            }
+            TEST_ASSERT(domain_.isInDomain(position));
+            TEST_ASSERT(domain_.ownerRank(position) == domain_.gridRank());
+         }
+      }
+   }
+
    #if UTIL_MPI
    void testPing()
    {  
@@ -185,6 +239,7 @@ public:
 
 TEST_BEGIN(DomainTest)
 TEST_ADD(DomainTest, testReadParam)
+TEST_ADD(DomainTest, testSetBounds)
 #ifdef UTIL_MPI
 TEST_ADD(DomainTest, testPing)
 #endif
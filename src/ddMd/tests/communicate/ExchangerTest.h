@@ -5,6 +5,7 @@
 #include <ddMd/communicate/Domain.h>
 #include <ddMd/communicate/Buffer.h>
 #include <ddMd/communicate/Exchanger.h>
+#include <ddMd/communicate/DomainBalancer.h>
 #include <ddMd/communicate/GroupDistributor.h>
 #include <ddMd/communicate/GroupDistributor.tpp>
 #include <ddMd/communicate/GroupCollector.h>
@@ -72,6 +73,8 @@ public:
    void testGhostUpdate();
    void testGhostUpdateCycle();
    void testExchangeUpdateCycle();
+   void testFloatUpdate();
+   void testBalance();
 
 };
 
@@ -622,12 +625,132 @@ bool ExchangerTest::isExchangeNeeded(double skin)
    #endif
 }
 
+void ExchangerTest::testFloatUpdate()
+{
+   printMethod(TEST_FUNC);
+
+   GhostIterator  ghostIter;
+   int  nGhost, k;
+
+   exchanger.setFloatUpdateFlag(true);
+   exchanger.exchange();
+   exchangeNotify();
+   nGhost = atomStorage.nGhost();
+   atomStorage.transformGenToCart(boundary);
+
+   // First update sets reference positions, later updates send floats
+   exchanger.update();
+   for (int i = 0; i < 3; ++i) {
+      displaceAtoms(2.0);
+      exchanger.update();
+      TEST_ASSERT(nGhost == atomStorage.nGhost());
+   }
+
+   // Record ghost positions obtained from displacements
+   DArray<Vector> positions;
+   positions.allocate(nGhost);
+   k = 0;
+   atomStorage.begin(ghostIter);
+   for ( ; ghostIter.notEnd(); ++ghostIter) {
+      positions[k] = ghostIter->position();
+      ++k;
+   }
+
+   // Compare to positions sent in double precision
+   exchanger.setFloatUpdateFlag(false);
+   exchanger.update();
+   k = 0;
+   atomStorage.begin(ghostIter);
+   for ( ; ghostIter.notEnd(); ++ghostIter) {
+      for (int i = 0; i < Dimension; ++i) {
+         TEST_ASSERT(fabs(positions[k][i] - ghostIter->position()[i]) 
+                     < 1.0E-5);
+      }
+      ++k;
+   }
+}
+
+void ExchangerTest::testBalance()
+{
+   printMethod(TEST_FUNC);
+
+   int  nAtom = 0;     // Number of atoms on this processor.
+   int  nAtomAll  = 0; // Number of atoms on all processors.
+   int  myRank = domain.gridRank();
+   int  i, k;
+
+   exchanger.exchange();
+   exchangeNotify();
+
+   // Assign a load that increases with processor rank
+   DomainBalancer balancer;
+   balancer.associate(domain, atomStorage);
+   // Planes may move by pairCutoff minus the maximum displacement
+   Vector minWidths;
+   Vector maxShifts;
+   for (i = 0; i < Dimension; ++i) {
+      minWidths[i] = 2.0/boundary.length(i);
+      maxShifts[i] = 0.2/boundary.length(i);
+   }
+   DArray<double> oldBounds;
+   oldBounds.allocate(domain.gridDimension(2) + 1);
+   for (k = 0; k <= domain.gridDimension(2); ++k) {
+      oldBounds[k] = domain.bound(2, k);
+   }
+   double load = double(atomStorage.nAtom()*(myRank + 1));
+   TEST_ASSERT(balancer.imbalance(load) >= 1.0);
+   balancer.balance(load, minWidths, maxShifts);
+
+   // Check domain bounds
+   for (i = 0; i < Dimension; ++i) {
+      for (k = 0; k < domain.gridDimension(i); ++k) {
+         TEST_ASSERT(domain.bound(i, k+1) - domain.bound(i, k) 
+                     >= minWidths[i] - 1.0E-10);
+      }
+   }
+   for (k = 0; k <= domain.gridDimension(2); ++k) {
+      TEST_ASSERT(fabs(domain.bound(2, k) - oldBounds[k]) 
+                  <= maxShifts[2] + 1.0E-10);
+   }
+
+   // Displace atoms and exchange, with non-uniform domains
+   displaceAtoms(0.25);
+   exchanger.exchange();
+   exchangeNotify();
+
+   // Check that all atoms are accounted for
+   nAtom = atomStorage.nAtom();
+   communicator().Reduce(&nAtom, &nAtomAll, 1, MPI::INT, MPI::SUM, 0);
+   if (myRank == 0) {
+      TEST_ASSERT(nAtomAll == atomCount);
+   }
+
+   // Check that atoms are inside and ghosts outside the domain.
+   AtomIterator  atomIter;
+   atomStorage.begin(atomIter);
+   for ( ; atomIter.notEnd(); ++atomIter) {
+      TEST_ASSERT(domain.isInDomain(atomIter->position()));
+   }
+   GhostIterator ghostIter;
+   atomStorage.begin(ghostIter);
+   for ( ; ghostIter.notEnd(); ++ghostIter) {
+      TEST_ASSERT(!domain.isInDomain(ghostIter->position()));
+   }
+
+   TEST_ASSERT(atomStorage.isValid());
+   TEST_ASSERT(bondStorage.isValid(atomStorage, domain.communicator(), 
+               true));
+
+}
+
 TEST_BEGIN(ExchangerTest)
 TEST_ADD(ExchangerTest, testDistribute)
 TEST_ADD(ExchangerTest, testExchange)
 TEST_ADD(ExchangerTest, testGhostUpdate)
 TEST_ADD(ExchangerTest, testGhostUpdateCycle)
 TEST_ADD(ExchangerTest, testExchangeUpdateCycle)
+TEST_ADD(ExchangerTest, testFloatUpdate)
+TEST_ADD(ExchangerTest, testBalance)
 TEST_END(ExchangerTest)
 
 #endif /* EXCHANGER_TEST_H */
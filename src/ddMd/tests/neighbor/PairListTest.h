@@ -89,6 +89,7 @@ public:
 
       // Allocate atom arrays
       atoms.allocate(nAtom);
+      pairList.setAtomArrays(&atoms[0], &atoms[0]);
       locals.allocate(nAtom);
       ghosts.allocate(nAtom);
 
@@ -363,12 +364,84 @@ public:
 
    }
 
+   void testGetAtomRange()
+   {
+      printMethod(TEST_FUNC);
+
+      makeConfiguration();
+      pairList.build(cellList);
+      TEST_ASSERT(pairList.nPair() > 0);
+
+      // Check that ranges are contiguous and cover all atoms and pairs
+      const int* atom2Ids;
+      int nRange = 3;
+      int begin, end, prevEnd, i, j, nPair, atom1Id;
+      int nPairTotal = 0;
+      prevEnd = 0;
+      for (i = 0; i < nRange; ++i) {
+         pairList.getAtomRange(nRange, i, begin, end);
+         TEST_ASSERT(begin == prevEnd);
+         TEST_ASSERT(end >= begin);
+         nPair = 0;
+         for (j = begin; j < end; ++j) {
+            nPair += pairList.getNeighbors(j, atom1Id, atom2Ids);
+         }
+         nPairTotal += nPair;
+         prevEnd = end;
+      }
+      TEST_ASSERT(prevEnd == pairList.nAtom());
+      TEST_ASSERT(nPairTotal == pairList.nPair());
+   }
+
+   void testPairSets()
+   {
+      printMethod(TEST_FUNC);
+
+      makeConfiguration();
+      pairList.build(cellList);
+      TEST_ASSERT(pairList.nPair() > 0);
+
+      // Check that interior and boundary neighbors partition all
+      // neighbors, with local atoms first
+      const int* atom2Ids;
+      const int* interiorIds;
+      const int* boundaryIds;
+      int atomCapacity = pairList.atomCapacity();
+      int i, k, n, nInterior, nBoundary, atom1Id, id;
+      int nInteriorTotal = 0;
+      int nBoundaryTotal = 0;
+      for (i = 0; i < pairList.nAtom(); ++i) {
+         n = pairList.getNeighbors(i, atom1Id, atom2Ids);
+         nInterior = pairList.getNeighbors(i, id, interiorIds, 
+                                           PairList::INTERIOR);
+         TEST_ASSERT(id == atom1Id);
+         nBoundary = pairList.getNeighbors(i, id, boundaryIds, 
+                                           PairList::BOUNDARY);
+         TEST_ASSERT(id == atom1Id);
+         TEST_ASSERT(nInterior + nBoundary == n);
+         TEST_ASSERT(interiorIds == atom2Ids);
+         TEST_ASSERT(boundaryIds == atom2Ids + nInterior);
+         for (k = 0; k < nInterior; ++k) {
+            TEST_ASSERT(interiorIds[k] < atomCapacity);
+         }
+         for (k = 0; k < nBoundary; ++k) {
+            TEST_ASSERT(boundaryIds[k] >= atomCapacity);
+         }
+         nInteriorTotal += nInterior;
+         nBoundaryTotal += nBoundary;
+      }
+      TEST_ASSERT(nInteriorTotal == pairList.nInteriorPair());
+      TEST_ASSERT(nInteriorTotal + nBoundaryTotal == pairList.nPair());
+   }
+
 };
 
 TEST_BEGIN(PairListTest)
 TEST_ADD(PairListTest, testCountNeighbors)
 TEST_ADD(PairListTest, testCountNeighbors2)
 TEST_ADD(PairListTest, testPairIterator)
+TEST_ADD(PairListTest, testGetAtomRange)
+TEST_ADD(PairListTest, testPairSets)
 TEST_END(PairListTest)
 
 #endif
@@ -8,9 +8,11 @@
 #include <ddMd/storage/GhostIterator.h>
 #include <ddMd/communicate/Domain.h>
 #include <ddMd/chemistry/Atom.h>
+#include <ddMd/misc/Threads.h>
 #include <inter/pair/DpdPair.h>
 #include <util/boundary/Boundary.h>
 #include <util/random/Random.h>
+#include <util/containers/DArray.h>
 
 #ifdef UTIL_MPI
 #ifndef TEST_MPI
@@ -182,6 +184,110 @@ public:
 
    }
 
+   /*
+   * Total energy of local atoms, with no ghosts (unit masses).
+   */
+   double totalEnergy()
+   {
+      AtomIterator iter, jter;
+      Vector dr;
+      double energy = 0.0;
+      storage.begin(iter);
+      for ( ; iter.notEnd(); ++iter) {
+         energy += 0.5*iter->velocity().square();
+         for (jter = iter, ++jter; jter.notEnd(); ++jter) {
+            dr.subtract(iter->position(), jter->position());
+            energy += pairPotential.pairEnergy(dr.square(), 0, 0);
+         }
+      }
+      return energy;
+   }
+
+   /*
+   * Integrate an isolated cluster of atoms by velocity Verlet.
+   *
+   * Atoms start on a lattice in the interior of the processor domain, 
+   * with random velocities, and no ghosts. Returns the maximum magnitude 
+   * of the change in total energy per atom over nStep steps.
+   */
+   double nveEnergyDrift(bool useFloat, int nStep, double dt)
+   {
+      Vector upper(6.0, 3.0, 9.0);
+      boundary.setOrthorhombic(upper);
+
+      // Place 27 atoms on a lattice with spacing 0.8, with random 
+      // velocities. Positions are set in generalized coordinates.
+      Random random;
+      random.setSeed(21);
+      Vector lower;
+      Atom* ptr;
+      int i, j, k, m;
+      for (m = 0; m < Dimension; ++m) {
+         lower[m] = domain.domainBound(m, 0)*upper[m] + 0.5;
+      }
+      int id = 0;
+      storage.clearGhosts();
+      storage.clearAtoms();
+      if (storage.isCartesian()) {
+         storage.transformCartToGen(boundary);
+      }
+      for (i = 0; i < 3; ++i) {
+         for (j = 0; j < 3; ++j) {
+            for (k = 0; k < 3; ++k) {
+               ptr = storage.newAtomPtr();
+               ptr->setId(id);
+               ptr->setTypeId(0);
+               ptr->position()[0] = (lower[0] + 0.8*i)/upper[0];
+               ptr->position()[1] = (lower[1] + 0.8*j)/upper[1];
+               ptr->position()[2] = (lower[2] + 0.8*k)/upper[2];
+               for (m = 0; m < Dimension; ++m) {
+                  ptr->velocity()[m] = random.uniform(-0.3, 0.3);
+               }
+               storage.addNewAtom();
+               ++id;
+            }
+         }
+      }
+
+      pairPotential.setMethodId(0);
+      pairPotential.setUseFloat(useFloat);
+      pairPotential.buildCellList();
+      storage.transformGenToCart(boundary);
+      pairPotential.buildPairList();
+      zeroForces();
+      pairPotential.computeForces();
+
+      AtomIterator iter;
+      Vector dv;
+      double energy0 = totalEnergy();
+      double error, maxError = 0.0;
+      for (int iStep = 0; iStep < nStep; ++iStep) {
+         for (storage.begin(iter); iter.notEnd(); ++iter) {
+            dv.multiply(iter->force(), 0.5*dt);
+            iter->velocity() += dv;
+            dv.multiply(iter->velocity(), dt);
+            iter->position() += dv;
+         }
+
+         // Rebuild the cell and pair lists at every step
+         storage.transformCartToGen(boundary);
+         pairPotential.buildCellList();
+         storage.transformGenToCart(boundary);
+         pairPotential.buildPairList();
+         zeroForces();
+         pairPotential.computeForces();
+
+         for (storage.begin(iter); iter.notEnd(); ++iter) {
+            dv.multiply(iter->force(), 0.5*dt);
+            iter->velocity() += dv;
+         }
+         error = fabs(totalEnergy() - energy0)/double(id);
+         if (error > maxError) maxError = error;
+      }
+      pairPotential.setUseFloat(false);
+      return maxError;
+   }
+
    #if 0
    void saveForces()
    {
@@ -259,11 +365,220 @@ public:
 
    }
 
+   void testMirror1()
+   {
+      printMethod(TEST_FUNC);
+
+      const int nAtom = 120;
+      double cutoff   = 1.2;
+      Vector lower(0.0);
+      Vector upper(4.0, 3.0, 6.0);
+
+      boundary.setOrthorhombic(upper);
+      randomAtoms(nAtom, lower, upper, cutoff);
+
+      pairPotential.buildCellList();
+      storage.transformGenToCart(boundary);
+      pairPotential.buildPairList();
+      TEST_ASSERT(pairPotential.pairList().nPair() > 0);
+
+      // Compute forces on local atoms with the pair list
+      DArray<Vector> forces;
+      forces.allocate(nAtom);
+      AtomIterator iter;
+      zeroForces();
+      pairPotential.setMethodId(0);
+      pairPotential.setUseMirror(false);
+      pairPotential.computeForces();
+      for (storage.begin(iter); iter.notEnd(); ++iter) {
+         forces[iter->id()] = iter->force();
+      }
+
+      // Recompute using the AtomMirror, and compare
+      zeroForces();
+      pairPotential.setUseMirror(true);
+      TEST_ASSERT(storage.mirror().isAllocated());
+      pairPotential.computeForces();
+      Vector df;
+      for (storage.begin(iter); iter.notEnd(); ++iter) {
+         df.subtract(iter->force(), forces[iter->id()]);
+         TEST_ASSERT(df.square() < 1.0E-20);
+      }
+      pairPotential.setUseMirror(false);
+   }
+
+   void testSplitForces1()
+   {
+      printMethod(TEST_FUNC);
+
+      const int nAtom = 120;
+      double cutoff   = 1.2;
+      Vector lower(0.0);
+      Vector upper(4.0, 3.0, 6.0);
+
+      boundary.setOrthorhombic(upper);
+      randomAtoms(nAtom, lower, upper, cutoff);
+
+      pairPotential.buildCellList();
+      storage.transformGenToCart(boundary);
+      pairPotential.buildPairList();
+      TEST_ASSERT(pairPotential.pairList().nPair() > 0);
+
+      // Compute forces on local atoms in one pass
+      DArray<Vector> forces;
+      forces.allocate(nAtom);
+      AtomIterator iter;
+      zeroForces();
+      pairPotential.setMethodId(0);
+      pairPotential.setUseMirror(false);
+      pairPotential.computeForces();
+      for (storage.begin(iter); iter.notEnd(); ++iter) {
+         forces[iter->id()] = iter->force();
+      }
+
+      // Recompute as interior and boundary pairs, with and without
+      // the AtomMirror, and compare
+      Vector df;
+      int i;
+      for (i = 0; i < 2; ++i) {
+         pairPotential.setUseMirror(i == 1);
+         zeroForces();
+         pairPotential.computeInteriorForces();
+         pairPotential.computeBoundaryForces();
+         for (storage.begin(iter); iter.notEnd(); ++iter) {
+            df.subtract(iter->force(), forces[iter->id()]);
+            TEST_ASSERT(df.square() < 1.0E-20);
+         }
+      }
+      pairPotential.setUseMirror(false);
+   }
+
+   void testFloat1()
+   {
+      printMethod(TEST_FUNC);
+
+      const int nAtom = 120;
+      double cutoff   = 1.2;
+      Vector lower(0.0);
+      Vector upper(4.0, 3.0, 6.0);
+
+      boundary.setOrthorhombic(upper);
+      randomAtoms(nAtom, lower, upper, cutoff);
+
+      pairPotential.buildCellList();
+      storage.transformGenToCart(boundary);
+      pairPotential.buildPairList();
+      TEST_ASSERT(pairPotential.pairList().nPair() > 0);
+
+      // Compute forces on local atoms in double precision
+      DArray<Vector> forces;
+      forces.allocate(nAtom);
+      AtomIterator iter;
+      zeroForces();
+      pairPotential.setMethodId(0);
+      pairPotential.setUseMirror(false);
+      pairPotential.computeForces();
+      for (storage.begin(iter); iter.notEnd(); ++iter) {
+         forces[iter->id()] = iter->force();
+      }
+
+      // Recompute in mixed precision, in one pass and as interior and
+      // boundary pairs. Compare using a relative tolerance.
+      Vector df;
+      double error, maxError;
+      int i;
+      pairPotential.setUseFloat(true);
+      TEST_ASSERT(storage.mirror().hasFloat());
+      for (i = 0; i < 2; ++i) {
+         zeroForces();
+         if (i == 0) {
+            pairPotential.computeForces();
+         } else {
+            pairPotential.computeInteriorForces();
+            pairPotential.computeBoundaryForces();
+         }
+         maxError = 0.0;
+         for (storage.begin(iter); iter.notEnd(); ++iter) {
+            df.subtract(iter->force(), forces[iter->id()]);
+            error = sqrt(df.square());
+            error /= sqrt(forces[iter->id()].square()) + 1.0;
+            if (error > maxError) maxError = error;
+         }
+         TEST_ASSERT(maxError < 1.0E-5);
+         if (verbose() > 1) {
+            std::cout << std::endl << "Max relative force error = " 
+                      << maxError;
+         }
+      }
+      pairPotential.setUseFloat(false);
+
+      // Compare energy conservation in NVE simulations in double and 
+      // mixed precision. Only pair forces use single precision.
+      double doubleDrift = nveEnergyDrift(false, 100, 0.01);
+      double floatDrift = nveEnergyDrift(true, 100, 0.01);
+      if (verbose() > 1) {
+         std::cout << std::endl << "Energy drift (double, float) = " 
+                   << doubleDrift << "  " << floatDrift;
+      }
+      TEST_ASSERT(doubleDrift < 1.0E-5);
+      TEST_ASSERT(floatDrift < 1.1*doubleDrift + 1.0E-8);
+   }
+
+   #ifdef DDMD_OPENMP
+   void testThreads1()
+   {
+      printMethod(TEST_FUNC);
+
+      const int nAtom = 120;
+      double cutoff   = 1.2;
+      Vector lower(0.0);
+      Vector upper(4.0, 3.0, 6.0);
+
+      boundary.setOrthorhombic(upper);
+      randomAtoms(nAtom, lower, upper, cutoff);
+
+      pairPotential.buildCellList();
+      storage.transformGenToCart(boundary);
+      pairPotential.buildPairList();
+      TEST_ASSERT(pairPotential.pairList().nPair() > 0);
+
+      // Compute forces on local atoms with one thread
+      DArray<Vector> forces;
+      forces.allocate(nAtom);
+      AtomIterator iter;
+      zeroForces();
+      pairPotential.setMethodId(0);
+      pairPotential.setUseMirror(true);
+      pairPotential.computeForces();
+      for (storage.begin(iter); iter.notEnd(); ++iter) {
+         forces[iter->id()] = iter->force();
+      }
+
+      // Recompute using three threads, and compare
+      Threads::setNThread(3);
+      zeroForces();
+      pairPotential.computeForces();
+      Threads::setNThread(1);
+      Vector df;
+      for (storage.begin(iter); iter.notEnd(); ++iter) {
+         df.subtract(iter->force(), forces[iter->id()]);
+         TEST_ASSERT(df.square() < 1.0E-20);
+      }
+      pairPotential.setUseMirror(false);
+   }
+   #endif
+
 };
 
 TEST_BEGIN(PairPotentialTest)
 TEST_ADD(PairPotentialTest, testRead1)
 TEST_ADD(PairPotentialTest, testRandom1)
+TEST_ADD(PairPotentialTest, testMirror1)
+TEST_ADD(PairPotentialTest, testSplitForces1)
+TEST_ADD(PairPotentialTest, testFloat1)
+#ifdef DDMD_OPENMP
+TEST_ADD(PairPotentialTest, testThreads1)
+#endif
 TEST_END(PairPotentialTest)
 
 #endif 
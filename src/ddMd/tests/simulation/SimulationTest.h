@@ -6,6 +6,9 @@
 #include <ddMd/storage/GhostIterator.h>
 #include <ddMd/potentials/pair/PairPotential.h>
 #include <ddMd/integrators/Integrator.h>
+#include <ddMd/analyzers/scattering/RDF.h>
+#include <util/accumulators/Distribution.h>
+#include <util/containers/DArray.h>
 #include <util/random/Random.h>
 #include <util/format/Dbl.h>
 #include <util/mpi/MpiLogger.h>
@@ -21,6 +24,8 @@
 #include <test/UnitTestRunner.h>
 #include <test/CommandLine.h>
 
+#include <vector>
+
 using namespace Util;
 using namespace DdMd;
 
@@ -33,6 +38,11 @@ private:
    void displaceAtoms(AtomStorage& atomStorage, const Boundary& boundary, 
                       Random& random, double range);
 
+   void setVelocities(DdMd::Simulation& simulation);
+
+   void gatherPositions(DdMd::Simulation& simulation, 
+                        DArray<Vector>& positions);
+
 public:
 
    virtual void setUp()
@@ -60,6 +70,12 @@ public:
 
    void testIntegrate1();
 
+   void testNveRespa1();
+
+   void testNveRespa2();
+
+   void testRDF();
+
 };
 
 
@@ -84,6 +100,63 @@ SimulationTest::displaceAtoms(AtomStorage& atomStorage,
    }
 }
 
+/*
+* Assign velocities that depend only on atom ids.
+*
+* Unlike setBoltzmannVelocities, this gives identical initial states in
+* two Simulation objects, independent of the order of random draws.
+*/
+inline void 
+SimulationTest::setVelocities(DdMd::Simulation& simulation)
+{
+   AtomIterator iter;
+   int i, j;
+   for (simulation.atomStorage().begin(iter); iter.notEnd(); ++iter) {
+      i = iter->id();
+      for (j = 0; j < Dimension; ++j) {
+         iter->velocity()[j] = sin(1.7*double(i) + 2.3*double(j));
+      }
+   }
+}
+
+/*
+* Gather Cartesian positions of all atoms on the master, indexed by id.
+*/
+inline void 
+SimulationTest::gatherPositions(DdMd::Simulation& simulation, 
+                                DArray<Vector>& positions)
+{
+   AtomStorage& atomStorage = simulation.atomStorage();
+   if (!atomStorage.isCartesian()) {
+      atomStorage.transformGenToCart(simulation.boundary());
+   }
+
+   // Each atom is local on exactly one processor, so a sum of arrays
+   // that are zero except for local atoms yields all positions.
+   int capacity = atomStorage.totalAtomCapacity();
+   DArray<Vector> localPositions;
+   localPositions.allocate(capacity);
+   positions.allocate(capacity);
+   int i;
+   for (i = 0; i < capacity; ++i) {
+      localPositions[i].zero();
+   }
+   AtomIterator iter;
+   for (atomStorage.begin(iter); iter.notEnd(); ++iter) {
+      localPositions[iter->id()] = iter->position();
+   }
+   #ifdef UTIL_MPI
+   simulation.domain().communicator().Reduce(&localPositions[0][0], 
+                                             &positions[0][0], 
+                                             Dimension*capacity,
+                                             MPI::DOUBLE, MPI::SUM, 0);
+   #else
+   for (i = 0; i < capacity; ++i) {
+      positions[i] = localPositions[i];
+   }
+   #endif
+}
+
 inline void SimulationTest::testReadParam()
 {  
    printMethod(TEST_FUNC); 
@@ -347,6 +420,201 @@ inline void SimulationTest::testIntegrate1()
 
 }
 
+/*
+* With nSubStep = 1, NveRespaIntegrator must reproduce NveIntegrator.
+*/
+inline void SimulationTest::testNveRespa1()
+{
+   printMethod(TEST_FUNC); 
+   const int nStep = 100;
+   std::string filename("config3");
+
+   // Reference trajectory, computed with NveIntegrator
+   openFile("in/param3"); 
+   simulation_.readParam(file()); 
+   closeFile();
+   simulation_.readConfig(filename);
+   setVelocities(simulation_);
+   simulation_.integrator().run(nStep);
+   DArray<Vector> positions0;
+   gatherPositions(simulation_, positions0);
+
+   // Same initial state, integrated with NveRespaIntegrator
+   Label::clear();
+   DdMd::Simulation respa;
+   respa.fileMaster().setRootPrefix(filePrefix()); 
+   openFile("in/param4"); 
+   respa.readParam(file()); 
+   closeFile();
+   respa.readConfig(filename);
+   setVelocities(respa);
+   respa.integrator().run(nStep);
+   DArray<Vector> positions;
+   gatherPositions(respa, positions);
+
+   if (simulation_.domain().gridRank() == 0) {
+      const Boundary& boundary = simulation_.boundary();
+      double diff, maxDiff = 0.0;
+      for (int i = 0; i < positions.capacity(); ++i) {
+         diff = boundary.distanceSq(positions[i], positions0[i]);
+         if (diff > maxDiff) maxDiff = diff;
+      }
+      maxDiff = sqrt(maxDiff);
+      if (verbose() > 1) {
+         std::cout << std::endl << "Max difference = " << maxDiff;
+      }
+      TEST_ASSERT(maxDiff < 1.0E-8);
+   }
+}
+
+/*
+* Check energy conservation by NveRespaIntegrator with nSubStep = 4.
+*/
+inline void SimulationTest::testNveRespa2()
+{
+   printMethod(TEST_FUNC); 
+
+   openFile("in/param5"); 
+   simulation_.readParam(file()); 
+   closeFile();
+   std::string filename("config3");
+   simulation_.readConfig(filename);
+   setVelocities(simulation_);
+
+   Domain& domain = simulation_.domain();
+   AtomStorage& atomStorage = simulation_.atomStorage();
+   const Boundary& boundary = simulation_.boundary();
+   int myRank = domain.gridRank();
+   atomStorage.computeNAtomTotal(domain.communicator());
+   double energy, energy0 = 0.0;
+   double error, maxError = 0.0;
+   for (int i = 0; i < 5; ++i) {
+      simulation_.integrator().run(20);
+      TEST_ASSERT(simulation_.isValid());
+
+      // Energies must be computed in Cartesian coordinates.
+      atomStorage.transformGenToCart(boundary);
+      simulation_.computeKineticEnergy();
+      simulation_.computePotentialEnergies();
+      atomStorage.transformCartToGen(boundary);
+      if (myRank == 0) {
+         energy = simulation_.kineticEnergy();
+         energy += simulation_.potentialEnergy();
+         if (i == 0) {
+            energy0 = energy;
+         }
+         error = fabs(energy - energy0)/double(atomStorage.nAtomTotal());
+         if (error > maxError) maxError = error;
+         if (verbose() > 1) {
+            std::cout << std::endl << Dbl(energy) << Dbl(error);
+         }
+      }
+   }
+   if (myRank == 0) {
+      TEST_ASSERT(maxError < 1.0E-3);
+   }
+}
+
+/*
+* Compare an RDF histogram computed from the distributed cell lists with
+* one computed on the master by a double loop over all atoms.
+*/
+inline void SimulationTest::testRDF()
+{
+   printMethod(TEST_FUNC); 
+
+   openFile("in/param1"); 
+   simulation_.readParam(file()); 
+   closeFile();
+
+   Domain&  domain  = simulation_.domain();
+   AtomStorage& atomStorage = simulation_.atomStorage();
+   const Boundary& boundary = simulation_.boundary();
+   int myRank = domain.gridRank();
+
+   std::string filename("config1");
+   simulation_.readConfig(filename);
+   simulation_.pairPotential().buildCellList();
+   atomStorage.transformGenToCart(boundary);
+
+   RDF rdf(simulation_);
+   #ifdef UTIL_MPI
+   rdf.setIoCommunicator(domain.communicator());
+   #endif
+   openFile("in/RDF"); 
+   rdf.readParam(file()); 
+   closeFile();
+   rdf.clear();
+   rdf.sample(0);
+
+   // Gather positions of all local atoms on the master
+   std::vector<double> positions;
+   AtomIterator iter;
+   int i, j;
+   for (atomStorage.begin(iter); iter.notEnd(); ++iter) {
+      for (j = 0; j < Dimension; ++j) {
+         positions.push_back(iter->position()[j]);
+      }
+   }
+   int nCoord = positions.size();
+   std::vector<double> allPositions;
+   #ifdef UTIL_MPI
+   int nProc = domain.communicator().Get_size();
+   std::vector<int> counts(nProc), displs(nProc);
+   domain.communicator().Gather(&nCoord, 1, MPI::INT, 
+                                &counts[0], 1, MPI::INT, 0);
+   int total = 0;
+   if (myRank == 0) {
+      for (i = 0; i < nProc; ++i) {
+         displs[i] = total;
+         total += counts[i];
+      }
+   }
+   allPositions.resize(total > 0 ? total : 1);
+   domain.communicator().Gatherv(&positions[0], nCoord, MPI::DOUBLE, 
+                                 &allPositions[0], &counts[0], &displs[0],
+                                 MPI::DOUBLE, 0);
+   allPositions.resize(total);
+   #else
+   allPositions = positions;
+   #endif
+
+   if (myRank == 0) {
+      const Distribution& histogram = rdf.accumulator();
+      Distribution expected;
+      expected.setParam(0.0, histogram.max(), histogram.nBin());
+      expected.clear();
+      double maxSq = histogram.max()*histogram.max();
+      int nAtom = allPositions.size()/Dimension;
+      TEST_ASSERT(nAtom == 100);
+      Vector r1, r2;
+      double dRsq;
+      int k;
+      for (i = 0; i < nAtom; ++i) {
+         for (k = 0; k < Dimension; ++k) {
+            r1[k] = allPositions[i*Dimension + k];
+         }
+         for (j = i + 1; j < nAtom; ++j) {
+            for (k = 0; k < Dimension; ++k) {
+               r2[k] = allPositions[j*Dimension + k];
+            }
+            dRsq = boundary.distanceSq(r1, r2);
+            if (dRsq < maxSq) {
+               // All atoms have type 0, so both orders match
+               expected.sample(sqrt(dRsq));
+               expected.sample(sqrt(dRsq));
+            }
+         }
+      }
+      long sum = 0;
+      for (i = 0; i < histogram.nBin(); ++i) {
+         TEST_ASSERT(histogram.data()[i] == expected.data()[i]);
+         sum += expected.data()[i];
+      }
+      TEST_ASSERT(sum > 0);
+   }
+}
+
 TEST_BEGIN(SimulationTest)
 TEST_ADD(SimulationTest, testReadParam)
 TEST_ADD(SimulationTest, testReadConfig)
@@ -355,6 +623,9 @@ TEST_ADD(SimulationTest, testExchange)
 TEST_ADD(SimulationTest, testUpdate)
 TEST_ADD(SimulationTest, testCalculateForces)
 TEST_ADD(SimulationTest, testIntegrate1)
+TEST_ADD(SimulationTest, testNveRespa1)
+TEST_ADD(SimulationTest, testNveRespa2)
+TEST_ADD(SimulationTest, testRDF)
 TEST_END(SimulationTest)
 
 #endif
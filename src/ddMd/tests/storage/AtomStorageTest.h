@@ -8,6 +8,7 @@
 #include <util/containers/DPArray.h>
 #include <util/containers/DArray.h>
 #include <util/random/Random.h>
+#include <util/space/IntVector.h>
 
 #ifdef UTIL_MPI
 #ifndef TEST_MPI
@@ -60,6 +61,8 @@ public:
 
    void testTransforms();
 
+   void testSortAtoms();
+
 };
 
 inline void AtomStorageTest::testReadParam()
@@ -501,6 +504,76 @@ void AtomStorageTest::testTransforms()
 
 }
 
+void AtomStorageTest::testSortAtoms()
+{
+   printMethod(TEST_FUNC);
+
+   DArray<Vector> positions;
+   Random random;
+   positions.allocate(100);
+   random.setSeed(274454136);
+
+   // Add local atoms, leaving holes in the atom array
+   int ids[7] = {53, 18, 44, 82, 39, 21, 76};
+   int i, j;
+   Atom* ptr;
+   for (i = 0; i < 7; ++i) {
+      ptr = storage_.addAtom(ids[i]);
+      ptr->setTypeId(i % 2);
+      ptr->velocity() = Vector(double(i));
+      for (j = 0; j < Dimension; ++j) {
+         ptr->position()[j] = random.uniform(0.0, 1.0);
+      }
+      positions[ids[i]] = ptr->position();
+   }
+   storage_.removeAtom(map_.find(44));
+   storage_.removeAtom(map_.find(53));
+   TEST_ASSERT(storage_.nAtom() == 5);
+
+   Vector lower(0.0);
+   Vector upper(1.0);
+   IntVector nCell(4);
+   storage_.sortAtoms(lower, upper, nCell);
+   TEST_ASSERT(storage_.isValid());
+   TEST_ASSERT(storage_.nAtom() == 5);
+   TEST_ASSERT(storage_.atomReservoir_.size() == storage_.atomCapacity() - 5);
+
+   // Check that atoms are contiguous, in order of cell
+   AtomIterator iter;
+   int prev = -1;
+   int key, c;
+   i = 0;
+   for (storage_.begin(iter); iter.notEnd(); ++iter) {
+      TEST_ASSERT(iter.get() == &storage_.atoms_[i]);
+      TEST_ASSERT(map_.find(iter->id()) == iter.get());
+      TEST_ASSERT(iter->position() == positions[iter->id()]);
+      key = 0;
+      for (j = 0; j < Dimension; ++j) {
+         c = int(iter->position()[j]*4.0);
+         key |= ((c & 1) << j) | ((c & 2) << (j + 2));
+      }
+      TEST_ASSERT(key >= prev);
+      prev = key;
+      ++i;
+   }
+
+   // Check that other pseudo-members moved with atoms
+   for (i = 0; i < 7; ++i) {
+      ptr = map_.find(ids[i]);
+      if (ids[i] == 44 || ids[i] == 53) {
+         TEST_ASSERT(ptr == 0);
+      } else {
+         TEST_ASSERT(ptr->typeId() == i % 2);
+         TEST_ASSERT(eq(ptr->velocity()[1], double(i)));
+      }
+   }
+
+   // Check that new atoms fill the remaining elements in order
+   ptr = storage_.addAtom(3);
+   TEST_ASSERT(ptr == &storage_.atoms_[5]);
+   TEST_ASSERT(storage_.isValid());
+}
+
 TEST_BEGIN(AtomStorageTest)
 TEST_ADD(AtomStorageTest, testReadParam)
 TEST_ADD(AtomStorageTest, testAddAtoms)
@@ -509,6 +582,7 @@ TEST_ADD(AtomStorageTest, testClear)
 TEST_ADD(AtomStorageTest, testIterators)
 TEST_ADD(AtomStorageTest, testSnapshot)
 TEST_ADD(AtomStorageTest, testTransforms)
+TEST_ADD(AtomStorageTest, testSortAtoms)
 TEST_END(AtomStorageTest)
 
 #endif
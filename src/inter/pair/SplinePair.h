@@ -0,0 +1,205 @@
+#ifndef INTER_SPLINE_PAIR_H
+#define INTER_SPLINE_PAIR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <inter/pair/TabulatedPair.h>
+#include <util/global.h>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /**
+   * Tabulated version of another pair interaction.
+   *
+   * A SplinePair<Interaction> reads the parameters of an interaction of
+   * class Interaction (e.g., DpdPair), followed by a minimum separation
+   * rMin and a number of points nPoint, and then tabulates the energy
+   * and force of that interaction for each type pair, using the same
+   * cutoff. Energies and forces are then evaluated by the cubic splines
+   * of the TabulatedPair base class, at a cost that is independent of the
+   * complexity of the underlying interaction. The tables are rebuilt
+   * whenever a parameter is modified by set().
+   *
+   * \sa \ref inter_pair_SplinePair_page
+   * \sa \ref inter_pair_interface_page
+   *
+   * \ingroup Inter_Pair_Module
+   */
+   template <class Interaction>
+   class SplinePair : public TabulatedPair
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      SplinePair();
+
+      /**
+      * Set nAtomType value.
+      *
+      * \param nAtomType number of atom types.
+      */
+      void setNAtomType(int nAtomType);
+
+      /**
+      * Read parameters of the underlying interaction, rMin and nPoint.
+      *
+      * \pre nAtomType must be set, by calling setNAtomType().
+      *
+      * \param in  input parameter stream
+      */
+      virtual void readParameters(std::istream &in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Modify a parameter of the underlying interaction, and retabulate.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      * \param value  new value of parameter
+      */
+      void set(std::string name, int i, int j, double value);
+
+      /**
+      * Get a parameter value of the underlying interaction.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      */
+      double get(std::string name, int i, int j) const;
+
+      /**
+      * Get the underlying interaction by const reference.
+      */
+      const Interaction& interaction() const;
+
+   private:
+
+      /// Underlying interaction.
+      Interaction interaction_;
+
+      /// Minimum separation in tables.
+      double rMin_;
+
+   };
+
+   /*
+   * Constructor.
+   */
+   template <class Interaction>
+   SplinePair<Interaction>::SplinePair()
+    : TabulatedPair(),
+      interaction_(),
+      rMin_(0.0)
+   {
+      std::string name = "SplinePair<" + interaction_.className() + ">";
+      setClassName(name.c_str());
+   }
+
+   /*
+   * Set nAtomType for this and the underlying interaction.
+   */
+   template <class Interaction>
+   void SplinePair<Interaction>::setNAtomType(int nAtomType)
+   {
+      TabulatedPair::setNAtomType(nAtomType);
+      interaction_.setNAtomType(nAtomType);
+   }
+
+   /*
+   * Read interaction parameters, and tabulate.
+   */
+   template <class Interaction>
+   void SplinePair<Interaction>::readParameters(std::istream &in)
+   {
+      // Read Interaction parameters without indent or brackets
+      bool nextIndent = false;
+      addParamComposite(interaction_, nextIndent);
+      interaction_.readParameters(in);
+
+      int nPoint;
+      read<double>(in, "rMin", rMin_);
+      read<int>(in, "nPoint", nPoint);
+      tabulate(interaction_, rMin_, nPoint);
+   }
+
+   /*
+   * Load internal state from an archive, and tabulate.
+   */
+   template <class Interaction>
+   void SplinePair<Interaction>::loadParameters(Serializable::IArchive &ar)
+   {
+      bool nextIndent = false;
+      addParamComposite(interaction_, nextIndent);
+      interaction_.loadParameters(ar);
+
+      int nPoint;
+      loadParameter<double>(ar, "rMin", rMin_);
+      loadParameter<int>(ar, "nPoint", nPoint);
+      tabulate(interaction_, rMin_, nPoint);
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   template <class Interaction>
+   void SplinePair<Interaction>::save(Serializable::OArchive &ar)
+   {
+      int nPoint = TabulatedPair::nPoint();
+      interaction_.save(ar);
+      ar << rMin_;
+      ar << nPoint;
+   }
+
+   /*
+   * Modify a parameter of the underlying interaction, and retabulate.
+   */
+   template <class Interaction>
+   void
+   SplinePair<Interaction>::set(std::string name, int i, int j, double value)
+   {
+      interaction_.set(name, i, j, value);
+      tabulate(interaction_, rMin_, nPoint());
+   }
+
+   /*
+   * Get a parameter of the underlying interaction.
+   */
+   template <class Interaction>
+   double SplinePair<Interaction>::get(std::string name, int i, int j) const
+   {  return interaction_.get(name, i, j); }
+
+   /*
+   * Get the underlying interaction.
+   */
+   template <class Interaction>
+   inline const Interaction& SplinePair<Interaction>::interaction() const
+   {  return interaction_; }
+
+}
+#endif
@@ -0,0 +1,372 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "TabulatedPair.h"
+#include <util/misc/Log.h>
+#ifdef UTIL_MPI
+#include <util/mpi/MpiSendRecv.h>
+#endif
+
+#include <fstream>
+#include <math.h>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   namespace
+   {
+
+      /*
+      * Compute coefficients of a clamped cubic spline through n equally
+      * spaced points y[k], using the interval as the unit of length.
+      *
+      * On output, the spline in interval k is given by c[0] + c[1]*t
+      * + c[2]*t^2 + c[3]*t^3, where c = &coeffs[4*k] and 0 <= t <= 1.
+      * Interval k = n - 1 is given the constant value y[n-1], so coeffs
+      * must have 4*n elements. End slopes are estimated by one-sided
+      * 4 point differences. The arrays m, cp and dp are work arrays of
+      * n elements.
+      */
+      void computeSpline(const double* y, int n, double* coeffs,
+                         double* m, double* cp, double* dp)
+      {
+         double slope0 = (-11.0*y[0] + 18.0*y[1] - 9.0*y[2] + 2.0*y[3])/6.0;
+         double slope1 = (11.0*y[n-1] - 18.0*y[n-2]
+                          + 9.0*y[n-3] - 2.0*y[n-4])/6.0;
+         double a, b, denom;
+         int k;
+
+         // Forward sweep of tridiagonal system for second derivatives m
+         b = 2.0;
+         cp[0] = 1.0/b;
+         dp[0] = 6.0*((y[1] - y[0]) - slope0)/b;
+         for (k = 1; k < n - 1; ++k) {
+            denom = 4.0 - cp[k-1];
+            cp[k] = 1.0/denom;
+            a = 6.0*(y[k+1] - 2.0*y[k] + y[k-1]);
+            dp[k] = (a - dp[k-1])/denom;
+         }
+         denom = 2.0 - cp[n-2];
+         a = 6.0*(slope1 - (y[n-1] - y[n-2]));
+         dp[n-1] = (a - dp[n-2])/denom;
+
+         // Back substitution
+         m[n-1] = dp[n-1];
+         for (k = n - 2; k >= 0; --k) {
+            m[k] = dp[k] - cp[k]*m[k+1];
+         }
+
+         // Polynomial coefficients for each interval
+         double* c;
+         for (k = 0; k < n - 1; ++k) {
+            c = coeffs + 4*k;
+            c[0] = y[k];
+            c[1] = (y[k+1] - y[k]) - (2.0*m[k] + m[k+1])/6.0;
+            c[2] = 0.5*m[k];
+            c[3] = (m[k+1] - m[k])/6.0;
+         }
+         c = coeffs + 4*(n - 1);
+         c[0] = y[n-1];
+         c[1] = 0.0;
+         c[2] = 0.0;
+         c[3] = 0.0;
+      }
+
+   }
+
+   /*
+   * Constructor.
+   */
+   TabulatedPair::TabulatedPair()
+    : nAtomType_(0),
+      energies_(),
+      forces_(),
+      eCoeffs_(),
+      fCoeffs_(),
+      fileName_(),
+      maxPairCutoff_(0.0),
+      nPoint_(0),
+      nTable_(0)
+   {  setClassName("TabulatedPair"); }
+
+   /*
+   * Destructor.
+   */
+   TabulatedPair::~TabulatedPair()
+   {}
+
+   /*
+   * Set nAtomType and assign a table to each type pair.
+   */
+   void TabulatedPair::setNAtomType(int nAtomType)
+   {
+      if (nAtomType <= 0) {
+         UTIL_THROW("nAtomType <= 0");
+      }
+      if (nAtomType > MaxAtomType) {
+         UTIL_THROW("nAtomType > TabulatedPair::MaxAtomType");
+      }
+      nAtomType_ = nAtomType;
+      nTable_ = 0;
+      int i, j;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = i; j < nAtomType_; ++j) {
+            tableId_[i][j] = nTable_;
+            tableId_[j][i] = nTable_;
+            ++nTable_;
+         }
+      }
+   }
+
+   /*
+   * Read table file name, and read tables.
+   */
+   void TabulatedPair::readParameters(std::istream &in)
+   {
+      if (nAtomType_ <= 0) {
+         UTIL_THROW("nAtomType must be set before readParam");
+      }
+      read<std::string>(in, "fileName", fileName_);
+      if (isIoProcessor()) {
+         std::ifstream file(fileName_.c_str());
+         if (!file.is_open()) {
+            Log::file() << "Table file name: " << fileName_ << std::endl;
+            UTIL_THROW("Error opening pair table file");
+         }
+         readTables(file);
+         file.close();
+      }
+      #ifdef UTIL_MPI
+      if (hasIoCommunicator()) {
+         bcastTables();
+         if (!isIoProcessor()) {
+            computeSplines();
+         }
+      }
+      #endif
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void TabulatedPair::loadParameters(Serializable::IArchive &ar)
+   {
+      if (nAtomType_ <= 0) {
+         UTIL_THROW("nAtomType must be set before loadParameters");
+      }
+      loadParameter<std::string>(ar, "fileName", fileName_);
+      if (isIoProcessor()) {
+         int nPoint;
+         ar >> nPoint;
+         allocateTables(nPoint);
+         ar.unpack(rsqMin_[0], nAtomType_, nAtomType_, MaxAtomType);
+         ar.unpack(cutoffSq_[0], nAtomType_, nAtomType_, MaxAtomType);
+         ar >> energies_;
+         ar >> forces_;
+      }
+      #ifdef UTIL_MPI
+      if (hasIoCommunicator()) {
+         bcastTables();
+      }
+      #endif
+      computeSplines();
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void TabulatedPair::save(Serializable::OArchive &ar)
+   {
+      ar << fileName_;
+      ar << nPoint_;
+      ar.pack(rsqMin_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar.pack(cutoffSq_[0], nAtomType_, nAtomType_, MaxAtomType);
+      ar << energies_;
+      ar << forces_;
+   }
+
+   /*
+   * Read tables from a file.
+   */
+   void TabulatedPair::readTables(std::istream& in)
+   {
+      std::string label;
+      int nPoint;
+      in >> label >> nPoint;
+      if (in.fail() || label != "nPoint") {
+         UTIL_THROW("Expected label nPoint in pair table file");
+      }
+      allocateTables(nPoint);
+
+      double rsqMin, rsqMax;
+      double* energies;
+      double* forces;
+      int i, j, ti, tj, k;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = i; j < nAtomType_; ++j) {
+            in >> ti >> tj >> rsqMin >> rsqMax;
+            if (in.fail()) {
+               UTIL_THROW("Error reading header of pair table");
+            }
+            if (ti != i || tj != j) {
+               Log::file() << "Expected types " << i << " " << j
+                           << ", found " << ti << " " << tj << std::endl;
+               UTIL_THROW("Incorrect type indices in pair table file");
+            }
+            if (rsqMin <= 0.0 || rsqMax <= rsqMin) {
+               UTIL_THROW("Invalid rsq range in pair table file");
+            }
+            setRange(i, j, rsqMin, rsqMax);
+            energies = energyTable(i, j);
+            forces = forceTable(i, j);
+            for (k = 0; k < nPoint; ++k) {
+               in >> energies[k] >> forces[k];
+            }
+            if (in.fail()) {
+               UTIL_THROW("Error reading values in pair table file");
+            }
+         }
+      }
+      computeSplines();
+   }
+
+   /*
+   * Allocate tables with nPoint points per type pair.
+   */
+   void TabulatedPair::allocateTables(int nPoint)
+   {
+      if (nTable_ <= 0) {
+         UTIL_THROW("nAtomType must be set before allocating tables");
+      }
+      if (nPoint < 4) {
+         UTIL_THROW("Pair tables require nPoint >= 4");
+      }
+      if (energies_.isAllocated()
+          && energies_.capacity() != nTable_*nPoint) {
+         energies_.deallocate();
+         forces_.deallocate();
+         eCoeffs_.deallocate();
+         fCoeffs_.deallocate();
+      }
+      nPoint_ = nPoint;
+      if (!energies_.isAllocated()) {
+         energies_.allocate(nTable_*nPoint_);
+         forces_.allocate(nTable_*nPoint_);
+         eCoeffs_.allocate(4*nTable_*nPoint_);
+         fCoeffs_.allocate(4*nTable_*nPoint_);
+      }
+   }
+
+   /*
+   * Set range of the table for a type pair.
+   */
+   void TabulatedPair::setRange(int i, int j, double rsqMin, double rsqMax)
+   {
+      rsqMin_[i][j] = rsqMin;
+      rsqMin_[j][i] = rsqMin;
+      cutoffSq_[i][j] = rsqMax;
+      cutoffSq_[j][i] = rsqMax;
+   }
+
+   /*
+   * Get pointer to energy table for a type pair.
+   */
+   double* TabulatedPair::energyTable(int i, int j)
+   {  return &energies_[tableId_[i][j]*nPoint_]; }
+
+   /*
+   * Get pointer to force / distance table for a type pair.
+   */
+   double* TabulatedPair::forceTable(int i, int j)
+   {  return &forces_[tableId_[i][j]*nPoint_]; }
+
+   /*
+   * Compute spline coefficients from tables.
+   */
+   void TabulatedPair::computeSplines()
+   {
+      DArray<double> m, cp, dp;
+      m.allocate(nPoint_);
+      cp.allocate(nPoint_);
+      dp.allocate(nPoint_);
+
+      double cutoff;
+      int i, j, id;
+      maxPairCutoff_ = 0.0;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = 0; j < nAtomType_; ++j) {
+            dRsqInv_[i][j] = double(nPoint_ - 1)
+                             /(cutoffSq_[i][j] - rsqMin_[i][j]);
+            cutoff = sqrt(cutoffSq_[i][j]);
+            if (cutoff > maxPairCutoff_) {
+               maxPairCutoff_ = cutoff;
+            }
+            id = tableId_[i][j];
+            coeffOffset_[i][j] = 4*id*nPoint_;
+            if (j >= i) {
+               computeSpline(&energies_[id*nPoint_], nPoint_,
+                             &eCoeffs_[4*id*nPoint_],
+                             &m[0], &cp[0], &dp[0]);
+               computeSpline(&forces_[id*nPoint_], nPoint_,
+                             &fCoeffs_[4*id*nPoint_],
+                             &m[0], &cp[0], &dp[0]);
+            }
+         }
+      }
+   }
+
+   #ifdef UTIL_MPI
+   /*
+   * Broadcast tables from the ioProcessor (private).
+   */
+   void TabulatedPair::bcastTables()
+   {
+      MPI::Intracomm& comm = ioCommunicator();
+      int nPoint = nPoint_;
+      bcast<int>(comm, nPoint, 0);
+      if (!isIoProcessor()) {
+         allocateTables(nPoint);
+      }
+      bcast<double>(comm, rsqMin_[0], MaxAtomType*MaxAtomType, 0);
+      bcast<double>(comm, cutoffSq_[0], MaxAtomType*MaxAtomType, 0);
+      bcast<double>(comm, energies_, nTable_*nPoint_, 0);
+      bcast<double>(comm, forces_, nTable_*nPoint_, 0);
+   }
+   #endif
+
+   /*
+   * Get maximum of pair cutoff distance, for all atom type pairs.
+   */
+   double TabulatedPair::maxPairCutoff() const
+   {  return maxPairCutoff_; }
+
+   /*
+   * Modify a parameter (not supported).
+   */
+   void TabulatedPair::set(std::string name, int i, int j, double value)
+   {  UTIL_THROW("Parameters of a tabulated pair interaction are fixed"); }
+
+   /*
+   * Get a parameter value, identified by a string.
+   */
+   double TabulatedPair::get(std::string name, int i, int j) const
+   {
+      double value = 0.0;
+      if (name == "cutoff") {
+         value = sqrt(cutoffSq_[i][j]);
+      } else
+      if (name == "rMin") {
+         value = sqrt(rsqMin_[i][j]);
+      } else {
+         UTIL_THROW("Unrecognized parameter name");
+      }
+      return value;
+   }
+
+}
@@ -0,0 +1,383 @@
+#ifndef INTER_TABULATED_PAIR_H
+#define INTER_TABULATED_PAIR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>
+#include <util/containers/DArray.h>
+#include <util/global.h>
+
+#include <string>
+
+namespace Inter
+{
+
+   using namespace Util;
+
+   /**
+   * Pair interaction evaluated by cubic spline interpolation of tables.
+   *
+   * A TabulatedPair stores tables of the pair energy and force / distance
+   * at nPoint equally spaced values of the squared separation rsq, for
+   * each distinct pair of atom types. Both functions are interpolated by
+   * clamped cubic splines in rsq, so that evaluation requires one table
+   * lookup and a cubic polynomial, independent of the functional form.
+   * The cutoff for each type pair is the square root of the upper limit
+   * of its table.
+   *
+   * Tables may be read from a file, whose name is given in the parameter
+   * file, or constructed from any other pair interaction class by the
+   * tabulate() function template. The SplinePair template uses tabulate()
+   * to provide a tabulated version of any other pair interaction.
+   *
+   * \sa \ref inter_pair_TabulatedPair_page
+   * \sa \ref inter_pair_interface_page
+   *
+   * \ingroup Inter_Pair_Module
+   */
+   class TabulatedPair : public ParamComposite
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      TabulatedPair();
+
+      /**
+      * Destructor.
+      */
+      virtual ~TabulatedPair();
+
+      /// \name Mutators
+      //@{
+
+      /**
+      * Set nAtomType value.
+      *
+      * \param nAtomType number of atom types.
+      */
+      void setNAtomType(int nAtomType);
+
+      /**
+      * Read name of table file, and read tables from that file.
+      *
+      * \pre nAtomType must be set, by calling setNAtomType().
+      *
+      * \param in  input parameter stream
+      */
+      virtual void readParameters(std::istream &in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Modify a parameter, identified by a string.
+      *
+      * Tabulated interactions have no modifiable parameters, so this
+      * function always throws an Exception.
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      * \param value  new value of parameter
+      */
+      void set(std::string name, int i, int j, double value);
+
+      /**
+      * Read tables from a file stream.
+      *
+      * See \ref inter_pair_TabulatedPair_page for the file format.
+      * Spline coefficients are computed after all tables are read.
+      *
+      * \param in input file stream
+      */
+      void readTables(std::istream& in);
+
+      /**
+      * Construct tables from another pair interaction.
+      *
+      * For each pair of atom types, the table extends from rsq = rMin*rMin
+      * to the square of the cutoff of the interaction for that pair.
+      *
+      * \param interaction pair interaction object
+      * \param rMin        minimum separation in tables
+      * \param nPoint      number of points in each table (>= 4)
+      */
+      template <class Interaction>
+      void tabulate(const Interaction& interaction, double rMin, int nPoint);
+
+      //@}
+      /// \name Accessors (required)
+      //@{
+
+      /**
+      * Returns interaction energy for a single pair of particles.
+      *
+      * \param rsq square of distance between particles
+      * \param i   type of particle 1
+      * \param j   type of particle 2
+      * \return    pair interaction energy
+      */
+      double energy(double rsq, int i, int j) const;
+
+      /**
+      * Returns ratio of scalar pair interaction force to pair separation.
+      *
+      * Precondition: rsq must be less than cutoffSq(i, j). Values of rsq
+      * less than the lower limit of the table are extrapolated using the
+      * spline for the first interval.
+      *
+      * \param rsq square of distance between particles
+      * \param i type of particle 1
+      * \param j type of particle 2
+      * \return  force divided by distance
+      */
+      double forceOverR(double rsq, int i, int j) const;
+
+      /**
+      * Get square of cutoff distance for specific type pair.
+      *
+      * \param i   type of Atom 1
+      * \param j   type of Atom 2
+      */
+      double cutoffSq(int i, int j) const;
+
+      /**
+      * Get maximum of pair cutoff distance, for all atom type pairs.
+      */
+      double maxPairCutoff() const;
+
+      /**
+      * Get a parameter value, identified by a string.
+      *
+      * Allowed names are "cutoff" and "rMin".
+      *
+      * \param name   parameter name
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      */
+      double get(std::string name, int i, int j) const;
+
+      //@}
+
+      /**
+      * Get number of points in each table.
+      */
+      int nPoint() const;
+
+   protected:
+
+      /// Maximum allowed value for nAtomType (# of particle types)
+      static const int MaxAtomType = 4;
+
+      /// Number of possible atom types.
+      int nAtomType_;
+
+      /**
+      * Allocate tables with nPoint points per type pair.
+      *
+      * \param nPoint number of points in each table
+      */
+      void allocateTables(int nPoint);
+
+      /**
+      * Set the range of the table for a type pair (and its transpose).
+      *
+      * \param i      atom type index 1
+      * \param j      atom type index 2
+      * \param rsqMin lower limit of table
+      * \param rsqMax upper limit of table (square of cutoff)
+      */
+      void setRange(int i, int j, double rsqMin, double rsqMax);
+
+      /**
+      * Get pointer to energy table for a type pair (nPoint elements).
+      */
+      double* energyTable(int i, int j);
+
+      /**
+      * Get pointer to force / distance table for a type pair.
+      */
+      double* forceTable(int i, int j);
+
+      /**
+      * Compute spline coefficients and maxPairCutoff from tables.
+      */
+      void computeSplines();
+
+   private:
+
+      // Lower limit of rsq in table for each type pair.
+      double rsqMin_[MaxAtomType][MaxAtomType];
+
+      // Upper limit of rsq in table (square of cutoff) for each pair.
+      double cutoffSq_[MaxAtomType][MaxAtomType];
+
+      // Inverse of rsq spacing of table for each pair.
+      double dRsqInv_[MaxAtomType][MaxAtomType];
+
+      // Index of the table for each pair (symmetric).
+      int tableId_[MaxAtomType][MaxAtomType];
+
+      // Offset of the spline coefficients of each pair, 4*nPoint*tableId.
+      int coeffOffset_[MaxAtomType][MaxAtomType];
+
+      // Tabulated energies, nPoint_ values per table.
+      DArray<double> energies_;
+
+      // Tabulated force / distance values, nPoint_ values per table.
+      DArray<double> forces_;
+
+      // Energy spline coefficients, 4 per interval, nPoint_ intervals
+      // per table (the last is a constant end value, see interpolate).
+      DArray<double> eCoeffs_;
+
+      // Force / distance spline coefficients, in the same layout.
+      DArray<double> fCoeffs_;
+
+      // Name of input table file.
+      std::string fileName_;
+
+      // Maximum pair potential cutoff radius, for all type pairs.
+      double maxPairCutoff_;
+
+      // Number of points per table.
+      int nPoint_;
+
+      // Number of distinct tables, nAtomType*(nAtomType+1)/2.
+      int nTable_;
+
+      /*
+      * Evaluate a cubic spline with coefficients coeffs, for rsq < cutoffSq.
+      */
+      double interpolate(const double* coeffs, double rsq, int i, int j) 
+      const;
+
+      #ifdef UTIL_MPI
+      /*
+      * Broadcast tables from the ioProcessor.
+      */
+      void bcastTables();
+      #endif
+
+   };
+
+   // Inline methods
+
+   /*
+   * Evaluate a cubic spline with coefficients coeffs (private).
+   *
+   * Callers guarantee that rsq < cutoffSq_[i][j], so that k <= nPoint - 1.
+   * The extra interval k = nPoint - 1, which is reached only by roundoff,
+   * holds the end value of the table. Separations below the table are
+   * extrapolated from the first interval.
+   */
+   inline double
+   TabulatedPair::interpolate(const double* coeffs, 
+                              double rsq, int i, int j) const
+   {
+      double x = (rsq - rsqMin_[i][j])*dRsqInv_[i][j];
+      int k = (x > 0.0) ? int(x) : 0;
+      const double* c = coeffs + coeffOffset_[i][j] + 4*k;
+      double t = x - k;
+      return c[0] + t*(c[1] + t*(c[2] + t*c[3]));
+   }
+
+   /*
+   * Calculate interaction energy for a pair, as function of squared distance.
+   */
+   inline double TabulatedPair::energy(double rsq, int i, int j) const
+   {
+      if (rsq < cutoffSq_[i][j]) {
+         return interpolate(eCoeffs_.cArray(), rsq, i, j);
+      } else {
+         return 0.0;
+      }
+   }
+
+   /*
+   * Calculate force/distance for a pair as function of squared distance.
+   */
+   inline double TabulatedPair::forceOverR(double rsq, int i, int j) const
+   {  return interpolate(fCoeffs_.cArray(), rsq, i, j); }
+
+   /*
+   * Return square of cutoff for a specific atom type pair.
+   */
+   inline double TabulatedPair::cutoffSq(int i, int j) const
+   {  return cutoffSq_[i][j]; }
+
+   /*
+   * Get number of points in each table.
+   */
+   inline int TabulatedPair::nPoint() const
+   {  return nPoint_; }
+
+   // Template method
+
+   /*
+   * Construct tables from another pair interaction.
+   */
+   template <class Interaction>
+   void
+   TabulatedPair::tabulate(const Interaction& interaction, double rMin,
+                           int nPoint)
+   {
+      if (nAtomType_ <= 0) {
+         UTIL_THROW("nAtomType must be set before tabulate");
+      }
+      if (rMin <= 0.0) {
+         UTIL_THROW("rMin must be positive");
+      }
+      allocateTables(nPoint);
+
+      double rsqMin = rMin*rMin;
+      double rsqMax, dRsq, rsq;
+      double* energies;
+      double* forces;
+      int i, j, k;
+      for (i = 0; i < nAtomType_; ++i) {
+         for (j = i; j < nAtomType_; ++j) {
+            rsqMax = interaction.cutoffSq(i, j);
+            if (rsqMax <= rsqMin) {
+               UTIL_THROW("Cutoff must be greater than rMin");
+            }
+            setRange(i, j, rsqMin, rsqMax);
+            energies = energyTable(i, j);
+            forces = forceTable(i, j);
+            dRsq = (rsqMax - rsqMin)/double(nPoint - 1);
+            for (k = 0; k < nPoint; ++k) {
+               // Evaluate the last point just inside the cutoff
+               if (k < nPoint - 1) {
+                  rsq = rsqMin + k*dRsq;
+               } else {
+                  rsq = rsqMax - 1.0E-10*dRsq;
+               }
+               energies[k] = interaction.energy(rsq, i, j);
+               forces[k] = interaction.forceOverR(rsq, i, j);
+            }
+         }
+      }
+      computeSplines();
+   }
+
+}
+#endif
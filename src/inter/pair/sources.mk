@@ -1,6 +1,7 @@
 inter_pair_=\
     inter/pair/DpdPair.cpp \
     inter/pair/LJPair.cpp \
+    inter/pair/TabulatedPair.cpp \
     inter/pair/WcaPair.cpp 
 
 inter_pair_SRCS=\
@@ -5,10 +5,12 @@
 
 #include "LJPairTest.h"
 #include "DpdPairTest.h"
+#include "SplinePairTest.h"
 
 TEST_COMPOSITE_BEGIN(PairTestComposite)
 TEST_COMPOSITE_ADD_UNIT(LJPairTest);
 TEST_COMPOSITE_ADD_UNIT(DpdPairTest);
+TEST_COMPOSITE_ADD_UNIT(SplinePairTest);
 TEST_COMPOSITE_END
 
 #endif
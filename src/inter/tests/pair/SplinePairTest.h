@@ -0,0 +1,212 @@
+#ifndef SPLINE_PAIR_TEST_H
+#define SPLINE_PAIR_TEST_H
+
+#include <inter/pair/SplinePair.h>
+#include <inter/pair/TabulatedPair.h>
+#include <inter/pair/LJPair.h>
+#include <inter/pair/DpdPair.h>
+#include <inter/tests/pair/PairTestTemplate.h>
+
+#include <iostream>
+#include <fstream>
+
+using namespace Util;
+using namespace Inter;
+
+class SplinePairTest : public PairTestTemplate< SplinePair<LJPair> >
+{
+
+protected:
+
+   PairTestTemplate< SplinePair<LJPair> >::setNAtomType;
+   PairTestTemplate< SplinePair<LJPair> >::readParamFile;
+   PairTestTemplate< SplinePair<LJPair> >::forceOverR;
+   PairTestTemplate< SplinePair<LJPair> >::energy;
+
+   /*
+   * Return maximum relative error of energy and force of the spline
+   * relative to the underlying interaction, for type pair (i, j).
+   */
+   double maxError(int i, int j)
+   {
+      const LJPair& lj = interaction_.interaction();
+      double rsqMin = 0.81;
+      double rsqMax = lj.cutoffSq(i, j);
+      double rsq, e0, e1, f0, f1, error;
+      double max = 0.0;
+      for (int k = 0; k < 997; ++k) {
+         rsq = rsqMin + (rsqMax - rsqMin)*k/997.0;
+         e0 = lj.energy(rsq, i, j);
+         e1 = interaction_.energy(rsq, i, j);
+         f0 = lj.forceOverR(rsq, i, j);
+         f1 = interaction_.forceOverR(rsq, i, j);
+         error = fabs(e1 - e0)/(fabs(e0) + 1.0);
+         if (error > max) max = error;
+         error = fabs(f1 - f0)/(fabs(f0) + 1.0);
+         if (error > max) max = error;
+      }
+      return max;
+   }
+
+public:
+
+   void setUp()
+   {
+      eps_ = 1.0E-6;
+      setNAtomType(2);
+      readParamFile("in/SplinePair");
+   }
+
+   void testSetUp() 
+   {
+      printMethod(TEST_FUNC);
+      if (verbose() > 0) {
+         std::cout << std::endl; 
+         interaction_.writeParam(std::cout);
+      }
+      TEST_ASSERT(interaction_.className() == "SplinePair<LJPair>");
+      TEST_ASSERT(interaction_.nPoint() == 2000);
+      TEST_ASSERT(eq(interaction_.maxPairCutoff(), 2.5));
+      TEST_ASSERT(eq(interaction_.cutoffSq(0, 1), 1.122462048*1.122462048));
+   }
+
+   void testAccuracy() 
+   {
+      printMethod(TEST_FUNC);
+      double e00 = maxError(0, 0);
+      double e01 = maxError(0, 1);
+      if (verbose() > 0) {
+         std::cout << std::endl; 
+         std::cout << "Max relative error (0, 0) = " << e00 << std::endl;
+         std::cout << "Max relative error (0, 1) = " << e01 << std::endl;
+      }
+      TEST_ASSERT(e00 < 1.0E-6);
+      TEST_ASSERT(e01 < 1.0E-6);
+      TEST_ASSERT(eq(energy(2.5*2.5 + 0.01, 0, 0), 0.0));
+   }
+
+   void testForceOverR() 
+   {
+      printMethod(TEST_FUNC);
+ 
+      type1_ = 0;
+      type2_ = 0;
+      rsq_ = 0.95;
+      TEST_ASSERT(testForce());
+      rsq_ = 2.1;
+      TEST_ASSERT(testForce());
+
+      type1_ = 0;
+      type2_ = 1;
+      rsq_ = 0.95;
+      TEST_ASSERT(testForce());
+   }
+
+   void testModify() 
+   {
+      printMethod(TEST_FUNC);
+
+      interaction_.set("epsilon", 0, 1, 1.5);
+      TEST_ASSERT(eq(interaction_.get("epsilon", 0, 1), 1.5));
+      TEST_ASSERT(eq(interaction_.get("epsilon", 1, 0), 1.5));
+      TEST_ASSERT(maxError(0, 1) < 1.0E-6);
+   }
+
+   void testSaveLoad() 
+   {
+      printMethod(TEST_FUNC);
+
+      Serializable::OArchive oar;
+      openOutputFile("out/serial", oar.file());
+      interaction_.save(oar);
+      oar.file().close();
+
+      Serializable::IArchive iar;
+      openInputFile("out/serial", iar.file());
+
+      SplinePair<LJPair> clone;
+      clone.setNAtomType(2);
+      clone.loadParameters(iar);
+
+      TEST_ASSERT(clone.nPoint() == interaction_.nPoint());
+      TEST_ASSERT(eq(interaction_.energy(0.95, 0, 1), 
+                     clone.energy(0.95, 0, 1)));
+      TEST_ASSERT(eq(interaction_.forceOverR(0.95, 0, 1), 
+                     clone.forceOverR(0.95, 0, 1)));
+      TEST_ASSERT(eq(interaction_.energy(3.0, 0, 0), 
+                     clone.energy(3.0, 0, 0)));
+      TEST_ASSERT(eq(interaction_.forceOverR(3.0, 0, 0), 
+                     clone.forceOverR(3.0, 0, 0)));
+   }
+
+   void testReadTables() 
+   {
+      printMethod(TEST_FUNC);
+
+      // Write a table file for a DpdPair interaction
+      DpdPair dpd;
+      dpd.setNAtomType(2);
+      std::ifstream in;
+      openInputFile("in/DpdPair", in);
+      dpd.readParameters(in);
+      in.close();
+
+      const int nPoint = 500;
+      double rsqMin = 0.04;
+      double rsqMax, rsq;
+      std::ofstream out;
+      openOutputFile("out/DpdTable", out);
+      out.precision(16);
+      out << "nPoint  " << nPoint << std::endl;
+      int i, j, k;
+      for (i = 0; i < 2; ++i) {
+         for (j = i; j < 2; ++j) {
+            rsqMax = dpd.cutoffSq(i, j);
+            out << i << "  " << j << "  " << rsqMin << "  " 
+                << rsqMax << std::endl;
+            for (k = 0; k < nPoint; ++k) {
+               rsq = rsqMin + (rsqMax - rsqMin)*k/double(nPoint - 1);
+               out << dpd.energy(rsq, i, j) << "  " 
+                   << dpd.forceOverR(rsq, i, j) << std::endl;
+            }
+         }
+      }
+      out.close();
+
+      // Read tables, and compare to DpdPair
+      TabulatedPair table;
+      table.setNAtomType(2);
+      openInputFile("out/DpdTable", in);
+      table.readTables(in);
+      in.close();
+      TEST_ASSERT(table.nPoint() == nPoint);
+      
+      double de, df;
+      double max = 0.0;
+      for (k = 0; k < 101; ++k) {
+         rsq = 0.09 + 0.9*k/101.0;
+         de = fabs(table.energy(rsq, 0, 1) - dpd.energy(rsq, 0, 1));
+         df = fabs(table.forceOverR(rsq, 0, 1) - dpd.forceOverR(rsq, 0, 1));
+         if (de > max) max = de;
+         if (df > max) max = df;
+      }
+      if (verbose() > 0) {
+         std::cout << std::endl; 
+         std::cout << "Max error of DPD table = " << max << std::endl;
+      }
+      TEST_ASSERT(max < 1.0E-6);
+      TEST_ASSERT(eq(table.get("cutoff", 0, 1), 1.0));
+   }
+
+};
+
+TEST_BEGIN(SplinePairTest)
+TEST_ADD(SplinePairTest, testSetUp)
+TEST_ADD(SplinePairTest, testAccuracy)
+TEST_ADD(SplinePairTest, testForceOverR)
+TEST_ADD(SplinePairTest, testModify)
+TEST_ADD(SplinePairTest, testSaveLoad)
+TEST_ADD(SplinePairTest, testReadTables)
+TEST_END(SplinePairTest)
+
+#endif
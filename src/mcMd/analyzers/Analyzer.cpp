@@ -37,6 +37,12 @@ namespace McMd
    Analyzer::~Analyzer()
    {}
    
+   /*
+   * Sample a snapshot, default implementation.
+   */
+   void Analyzer::sampleSnapshot(const Snapshot& snapshot)
+   {  UTIL_THROW("Analyzer is not snapshot-safe"); }
+
    /*
    * Read parameters from stream, default implementation.
    */
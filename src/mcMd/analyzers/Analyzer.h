@@ -18,6 +18,8 @@
 namespace McMd
 {
 
+   class Snapshot;
+
    using namespace Util;
 
    /**
@@ -129,6 +131,32 @@ namespace McMd
       */
       virtual void sample(long iStep) = 0;
 
+      /**
+      * Is this analyzer snapshot-safe?
+      *
+      * A snapshot-safe analyzer implements sampleSnapshot(), and obtains
+      * all of the data about the configuration that it needs from the
+      * snapshot passed to that function, rather than from the parent
+      * System. An AnalyzerManager with an active pipeline may then call 
+      * sampleSnapshot() from a background thread while the simulation 
+      * continues. The default implementation returns false.
+      */
+      virtual bool isSnapshotSafe() const
+      {  return false; }
+
+      /**
+      * Calculate, analyze and/or output a property of a snapshot.
+      *
+      * This function is called only for snapshot-safe analyzers, only
+      * when snapshot.iStep() is a multiple of interval, and with
+      * snapshots in order of increasing step index. It must not access
+      * the parent System or Simulation, or write to the log file. The
+      * default implementation throws an Exception.
+      *
+      * \param snapshot copy of the system configuration
+      */
+      virtual void sampleSnapshot(const Snapshot& snapshot);
+
       /**
       * Output any results at the end of the simulation.
       *
@@ -5,10 +5,16 @@
 * Distributed under the terms of the GNU General Public License.
 */
 
-#include "AnalyzerManager.h" 
-#include "Analyzer.h" 
+#include "AnalyzerManager.h"
+#include "Analyzer.h"
 #include <util/archives/Serializable_includes.h>
 
+#ifdef MCMD_PTHREAD
+#include <mcMd/simulation/System.h>
+#include <util/format/Int.h>
+#include <util/misc/Log.h>
+#endif
+
 namespace McMd
 {
 
@@ -18,17 +24,73 @@ namespace McMd
    * Constructor.
    */
    AnalyzerManager::AnalyzerManager()
-   : Manager<Analyzer>()
+    : Manager<Analyzer>(),
+      systemPtr_(0),
+      nThread_(0)
+      #ifdef MCMD_PTHREAD
+      , nSnapshot_(0),
+      nThrottle_(0),
+      firstSnapshotId_(0),
+      nQueued_(0),
+      nStarted_(0),
+      isStopping_(false),
+      hasError_(false)
+      #endif
+   {  setClassName("AnalyzerManager"); }
+
+   /*
+   * Constructor.
+   */
+   AnalyzerManager::AnalyzerManager(System& system)
+    : Manager<Analyzer>(),
+      systemPtr_(&system),
+      nThread_(0)
+      #ifdef MCMD_PTHREAD
+      , nSnapshot_(0),
+      nThrottle_(0),
+      firstSnapshotId_(0),
+      nQueued_(0),
+      nStarted_(0),
+      isStopping_(false),
+      hasError_(false)
+      #endif
    {  setClassName("AnalyzerManager"); }
 
    /*
    * Destructor.
    */
    AnalyzerManager::~AnalyzerManager()
-   {} 
+   {
+      #ifdef MCMD_PTHREAD
+      stopThreads();
+      #endif
+   }
+
+   /*
+   * Set the number of background threads.
+   */
+   void AnalyzerManager::setNThread(int nThread)
+   {
+      if (nThread < 0) {
+         UTIL_THROW("nThread < 0");
+      }
+      #ifdef MCMD_PTHREAD
+      if (nThread > 0 && !systemPtr_) {
+         UTIL_THROW("Analyzer pipeline requires an associated System");
+      }
+      if (nThread != nThread_) {
+         stopThreads();
+      }
+      #else
+      if (nThread > 0) {
+         UTIL_THROW("Analyzer pipeline requires compilation with MCMD_PTHREAD");
+      }
+      #endif
+      nThread_ = nThread;
+   }
 
    /*
-   * Read parameter file. 
+   * Read parameter file.
    *
    * \param in input parameter file stream.
    */
@@ -41,33 +103,61 @@ namespace McMd
    /*
    * Call initialize method of each analyzer.
    */
-   void AnalyzerManager::setup() 
+   void AnalyzerManager::setup()
    {
+      flush();
       for (int i = 0; i < size(); ++i) {
          (*this)[i].setup();
       }
+      #ifdef MCMD_PTHREAD
+      nSnapshot_ = 0;
+      nThrottle_ = 0;
+      #endif
    }
- 
+
    /*
    * Call sample method of each analyzer.
    */
-   void AnalyzerManager::sample(long iStep) 
+   void AnalyzerManager::sample(long iStep)
    {
-      if (iStep % Analyzer::baseInterval == 0) { 
+      if (iStep % Analyzer::baseInterval == 0) {
+         #ifdef MCMD_PTHREAD
+         if (nThread_ > 0) {
+            if (nStarted_ == 0) {
+               startThreads();
+            }
+            queueSnapshot(iStep);
+         }
+         #endif
          for (int i=0; i < size(); ++i) {
-            (*this)[i].sample(iStep);
+            if (!isPipelined(i)) {
+               (*this)[i].sample(iStep);
+            }
          }
       }
    }
- 
+
    /*
    * Call output method of each analyzer.
    */
-   void AnalyzerManager::output() 
+   void AnalyzerManager::output()
    {
+      flush();
       for (int i=0; i < size(); ++i) {
          (*this)[i].output();
       }
+      #ifdef MCMD_PTHREAD
+      if (nStarted_ > 0) {
+         Log::file() << "Analyzer pipeline:" << std::endl;
+         Log::file() << "nThread                  " << Int(nStarted_)
+                     << std::endl;
+         Log::file() << "nSnapshot                " << Int(nSnapshot_)
+                     << std::endl;
+         Log::file() << "nThrottle                " << Int(nThrottle_)
+                     << std::endl;
+         Log::file() << std::endl;
+      }
+      #endif
    }
 
    /*
@@ -84,8 +174,252 @@ namespace McMd
    */
    void AnalyzerManager::save(Serializable::OArchive &ar)
    {
+      flush();
       ar << Analyzer::baseInterval;
       Manager<Analyzer>::save(ar);
    }
 
+   /*
+   * Is analyzer i executed by the background pipeline?
+   */
+   bool AnalyzerManager::isPipelined(int i)
+   {
+      #ifdef MCMD_PTHREAD
+      return (nStarted_ > 0 && (*this)[i].isSnapshotSafe());
+      #else
+      return false;
+      #endif
+   }
+
+   /*
+   * Wait until all pending snapshots have been processed.
+   */
+   void AnalyzerManager::flush()
+   {
+      #ifdef MCMD_PTHREAD
+      if (nStarted_ == 0) {
+         return;
+      }
+      pthread_mutex_lock(&mutex_);
+      while (nQueued_ > 0) {
+         pthread_cond_wait(&condition_, &mutex_);
+      }
+      bool hasError = hasError_;
+      std::string message = errorMessage_;
+      hasError_ = false;
+      pthread_mutex_unlock(&mutex_);
+      if (hasError) {
+         Log::file() << message << std::endl;
+         UTIL_THROW("Error in background analyzer");
+      }
+      #endif
+   }
+
+   #ifdef MCMD_PTHREAD
+   /*
+   * Allocate pipeline data and start background threads.
+   */
+   void AnalyzerManager::startThreads()
+   {
+      if (nStarted_ > 0) {
+         return;
+      }
+
+      // Allocate pipeline data (the list of analyzers is fixed)
+      if (!snapshots_.isAllocated()) {
+         snapshots_.allocate(NSnapshot);
+         isPending_.allocate(NSnapshot, size());
+         nPending_.allocate(NSnapshot);
+         isBusy_.allocate(size());
+         isBlocked_.allocate(size());
+      } else 
+      if (isBusy_.capacity() != size()) {
+         UTIL_THROW("Number of analyzers changed");
+      }
+      if (threads_.isAllocated()) {
+         threads_.deallocate();
+      }
+      threads_.allocate(nThread_);
+      int i, j;
+      for (i = 0; i < NSnapshot; ++i) {
+         for (j = 0; j < size(); ++j) {
+            isPending_(i, j) = false;
+         }
+         nPending_[i] = 0;
+      }
+      for (j = 0; j < size(); ++j) {
+         isBusy_[j] = false;
+      }
+      firstSnapshotId_ = 0;
+      nQueued_ = 0;
+      isStopping_ = false;
+      hasError_ = false;
+
+      // Start threads
+      pthread_mutex_init(&mutex_, 0);
+      pthread_cond_init(&condition_, 0);
+      for (i = 0; i < nThread_; ++i) {
+         if (pthread_create(&threads_[i], 0, &AnalyzerManager::run, this)) {
+            break;
+         }
+         ++nStarted_;
+      }
+      if (nStarted_ == 0) {
+         pthread_cond_destroy(&condition_);
+         pthread_mutex_destroy(&mutex_);
+         UTIL_THROW("Failed to create analyzer pipeline thread");
+      }
+   }
+
+   /*
+   * Wait for pending snapshots and join background threads.
+   */
+   void AnalyzerManager::stopThreads()
+   {
+      if (nStarted_ == 0) {
+         return;
+      }
+      pthread_mutex_lock(&mutex_);
+      isStopping_ = true;
+      pthread_cond_broadcast(&condition_);
+      pthread_mutex_unlock(&mutex_);
+      for (int i = 0; i < nStarted_; ++i) {
+         pthread_join(threads_[i], 0);
+      }
+      nStarted_ = 0;
+      pthread_cond_destroy(&condition_);
+      pthread_mutex_destroy(&mutex_);
+   }
+
+   /*
+   * Copy a snapshot and queue it for due snapshot-safe analyzers.
+   */
+   void AnalyzerManager::queueSnapshot(long iStep)
+   {
+      // Is any snapshot-safe analyzer due to sample?
+      int j;
+      bool isDue = false;
+      for (j = 0; j < size(); ++j) {
+         if ((*this)[j].isSnapshotSafe() && (*this)[j].isAtInterval(iStep)) {
+            isDue = true;
+            break;
+         }
+      }
+      if (!isDue) {
+         return;
+      }
+
+      // Wait for a free buffer
+      pthread_mutex_lock(&mutex_);
+      if (nQueued_ == NSnapshot) {
+         ++nThrottle_;
+         while (nQueued_ == NSnapshot) {
+            pthread_cond_wait(&condition_, &mutex_);
+         }
+      }
+      int s = (firstSnapshotId_ + nQueued_) % NSnapshot;
+      pthread_mutex_unlock(&mutex_);
+
+      // Buffer s is not accessed by background threads until queued
+      snapshots_[s].copy(*systemPtr_, iStep);
+
+      // Queue the snapshot
+      pthread_mutex_lock(&mutex_);
+      nPending_[s] = 0;
+      for (j = 0; j < size(); ++j) {
+         if ((*this)[j].isSnapshotSafe() && (*this)[j].isAtInterval(iStep)) {
+            isPending_(s, j) = true;
+            ++nPending_[s];
+         }
+      }
+      ++nQueued_;
+      ++nSnapshot_;
+      pthread_cond_broadcast(&condition_);
+      pthread_mutex_unlock(&mutex_);
+   }
+
+   /*
+   * Process tasks until stopped.
+   *
+   * A task is a pair (s, j) of a snapshot buffer s and an analyzer j.
+   * Queued snapshots are scanned from oldest to newest, and a task is
+   * taken only if analyzer j is idle and has no task for an older
+   * snapshot, so that each analyzer samples snapshots in order.
+   */
+   void AnalyzerManager::work()
+   {
+      int q, s, j, taskS, taskJ;
+      pthread_mutex_lock(&mutex_);
+      while (true) {
+
+         // Find a task
+         taskS = -1;
+         taskJ = -1;
+         for (j = 0; j < size(); ++j) {
+            isBlocked_[j] = isBusy_[j];
+         }
+         for (q = 0; q < nQueued_ && taskS < 0; ++q) {
+            s = (firstSnapshotId_ + q) % NSnapshot;
+            for (j = 0; j < size(); ++j) {
+               if (isPending_(s, j)) {
+                  if (!isBlocked_[j]) {
+                     taskS = s;
+                     taskJ = j;
+                     break;
+                  }
+                  isBlocked_[j] = true;
+               }
+            }
+         }
+
+         if (taskS >= 0) {
+
+            // Execute the task without holding the lock
+            isPending_(taskS, taskJ) = false;
+            isBusy_[taskJ] = true;
+            pthread_mutex_unlock(&mutex_);
+            std::string message;
+            bool hasError = false;
+            try {
+               (*this)[taskJ].sampleSnapshot(snapshots_[taskS]);
+            } catch (Exception& e) {
+               hasError = true;
+               message = e.message();
+            }
+            pthread_mutex_lock(&mutex_);
+
+            // Record completion, and release finished buffers in order
+            if (hasError && !hasError_) {
+               hasError_ = true;
+               errorMessage_ = message;
+            }
+            isBusy_[taskJ] = false;
+            --nPending_[taskS];
+            while (nQueued_ > 0 && nPending_[firstSnapshotId_] == 0) {
+               firstSnapshotId_ = (firstSnapshotId_ + 1) % NSnapshot;
+               --nQueued_;
+            }
+            pthread_cond_broadcast(&condition_);
+
+         } else
+         if (isStopping_ && nQueued_ == 0) {
+            break;
+         } else {
+            pthread_cond_wait(&condition_, &mutex_);
+         }
+
+      }
+      pthread_mutex_unlock(&mutex_);
+   }
+
+   /*
+   * Entry point of a background thread.
+   */
+   void* AnalyzerManager::run(void* ptr)
+   {
+      static_cast<AnalyzerManager*>(ptr)->work();
+      return 0;
+   }
+   #endif
+
 }
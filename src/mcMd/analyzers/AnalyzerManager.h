@@ -11,14 +11,50 @@
 #include "Analyzer.h"                  // template parameter
 #include <util/param/Manager.h>          // base class template
 
+#ifdef MCMD_PTHREAD
+#include "Snapshot.h"                  // member template parameter
+#include <util/containers/DArray.h>    // member template
+#include <util/containers/DMatrix.h>   // member template
+#include <pthread.h>
+#include <string>
+#endif
+
 namespace McMd
 {
 
+   class System;
+
    using namespace Util;
 
    /**
    * Manager for a list of Analyzer objects.
    *
+   * By default, the sample() function of each Analyzer is called by the
+   * main simulation loop. If the code is compiled with MCMD_PTHREAD
+   * defined and setNThread() is called with nThread > 0, snapshot-safe
+   * analyzers (see Analyzer::isSnapshotSafe()) are instead executed by
+   * a pipeline of nThread background POSIX threads:
+   *
+   *  - At each step at which one or more snapshot-safe analyzers are
+   *    due to sample, the positions, atom types and boundary of the
+   *    System are copied into one of two Snapshot buffers, and the
+   *    simulation then continues.
+   *
+   *  - Background threads call Analyzer::sampleSnapshot() for each due
+   *    analyzer. Different analyzers may run concurrently, but each
+   *    analyzer processes snapshots one at a time, in order of
+   *    increasing step index. Results are thus identical to those
+   *    obtained without the pipeline.
+   *
+   *  - If analyzers fall behind, so that both buffers are in use when
+   *    a new snapshot is needed, the main thread waits for a buffer to
+   *    be released. The number of such waits is reported by output().
+   *
+   * All pending snapshots are processed before setup(), output() or
+   * save() call any analyzer, so that these functions see the same
+   * state as in a run without the pipeline. Analyzers that are not
+   * snapshot-safe are always called by the main thread.
+   *
    * \ingroup McMd_Manager_Module
    * \ingroup McMd_Analyzer_Module
    */
@@ -32,13 +68,34 @@ namespace McMd
       */
       AnalyzerManager();
 
+      /**
+      * Constructor.
+      *
+      * \param system System from which snapshots are copied
+      */
+      AnalyzerManager(System& system);
+
       /**
       * Destructor.
+      *
+      * Waits for pending snapshots, and stops any background threads.
       */
       virtual ~AnalyzerManager();
 
       /**
-      * Read parameter file. 
+      * Set the number of background threads for snapshot-safe analyzers.
+      *
+      * A value nThread = 0 (the default) disables the pipeline. A value
+      * nThread > 0 requires compilation with MCMD_PTHREAD defined, and
+      * construction with a System. Threads are started by the first
+      * subsequent call to sample().
+      *
+      * \param nThread number of background threads (nThread >= 0)
+      */
+      void setNThread(int nThread);
+
+      /**
+      * Read parameter file.
       *
       * \param in input parameter file stream.
       */
@@ -60,24 +117,144 @@ namespace McMd
 
       /**
       * Call initialize method of each Analyzer.
-      * 
+      *
       * This method should be called just before the main
       * simulation loop, after an initial configuration is
       * known.
       */
       void setup();
- 
+
       /**
       * Call sample method of each Analyzer.
       */
       void sample(long iStep);
- 
+
       /**
       * Call output method of each analyzer.
       */
       void output();
 
+      /**
+      * Wait until all pending snapshots have been processed.
+      *
+      * Throws an Exception if a background analyzer failed. Does
+      * nothing if the pipeline is not active.
+      */
+      void flush();
+
+      /**
+      * Get the number of background threads (0 if none).
+      */
+      int nThread() const;
+
+   private:
+
+      /// Pointer to System from which snapshots are copied.
+      System* systemPtr_;
+
+      /// Number of background threads.
+      int nThread_;
+
+      #ifdef MCMD_PTHREAD
+
+      /// Number of snapshot buffers.
+      static const int NSnapshot = 2;
+
+      /// Snapshot buffers, used in circular order.
+      DArray<Snapshot> snapshots_;
+
+      /// Does analyzer j need to sample snapshot s? Indexed by (s, j).
+      DMatrix<bool> isPending_;
+
+      /// Number of analyzers not yet finished with each snapshot.
+      DArray<int> nPending_;
+
+      /// Is each analyzer being executed by a background thread?
+      DArray<bool> isBusy_;
+
+      /// Workspace used to find the next task.
+      DArray<bool> isBlocked_;
+
+      /// Background threads.
+      DArray<pthread_t> threads_;
+
+      /// Mutex that protects all pipeline state.
+      pthread_mutex_t mutex_;
+
+      /// Condition signalled by any change in pipeline state.
+      pthread_cond_t condition_;
+
+      /// Message from the first failed background analyzer.
+      std::string errorMessage_;
+
+      /// Number of snapshots queued since setup.
+      long nSnapshot_;
+
+      /// Number of times the main thread waited for a free buffer.
+      long nThrottle_;
+
+      /// Index of oldest queued snapshot buffer.
+      int firstSnapshotId_;
+
+      /// Number of queued snapshot buffers.
+      int nQueued_;
+
+      /// Number of started background threads.
+      int nStarted_;
+
+      /// Should background threads exit?
+      bool isStopping_;
+
+      /// Has a background analyzer failed?
+      bool hasError_;
+
+      /**
+      * Allocate pipeline data and start background threads.
+      */
+      void startThreads();
+
+      /**
+      * Wait for pending snapshots and join background threads.
+      */
+      void stopThreads();
+
+      /**
+      * Copy a snapshot and queue it for due snapshot-safe analyzers.
+      *
+      * \param iStep step index
+      */
+      void queueSnapshot(long iStep);
+
+      /**
+      * Process tasks until stopped (executed by background threads).
+      */
+      void work();
+
+      /**
+      * Entry point of a background thread.
+      *
+      * \param ptr pointer to this AnalyzerManager
+      */
+      static void* run(void* ptr);
+
+      #endif
+
+      /**
+      * Is analyzer i executed by the background pipeline?
+      *
+      * \param i analyzer index
+      */
+      bool isPipelined(int i);
+
    };
 
+   // Inline functions
+
+   /*
+   * Get the number of background threads.
+   */
+   inline int AnalyzerManager::nThread() const
+   {  return nThread_; }
+
 }
 #endif
@@ -0,0 +1,89 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "Snapshot.h"
+#include <mcMd/simulation/System.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   Snapshot::Snapshot()
+    : positions_(),
+      typeIds_(),
+      firstAtomIds_(),
+      boundary_(),
+      iStep_(0),
+      nAtom_(0),
+      nSpecies_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   Snapshot::~Snapshot()
+   {}
+
+   /*
+   * Copy positions, atom types and boundary from a System.
+   */
+   void Snapshot::copy(const System& system, long iStep)
+   {
+      // Reallocate arrays only if necessary
+      int nAtom = system.nAtom();
+      if (positions_.capacity() < nAtom) {
+         if (positions_.isAllocated()) {
+            positions_.deallocate();
+            typeIds_.deallocate();
+         }
+         positions_.allocate(nAtom);
+         typeIds_.allocate(nAtom);
+      }
+      int nSpecies = system.simulation().nSpecies();
+      if (firstAtomIds_.capacity() < nSpecies + 1) {
+         if (firstAtomIds_.isAllocated()) {
+            firstAtomIds_.deallocate();
+         }
+         firstAtomIds_.allocate(nSpecies + 1);
+      }
+
+      // Copy atoms in species, molecule, atom order
+      System::ConstMoleculeIterator molIter;
+      Molecule::ConstAtomIterator atomIter;
+      int iSpecies;
+      int i = 0;
+      for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         firstAtomIds_[iSpecies] = i;
+         system.begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            molIter->begin(atomIter);
+            for ( ; atomIter.notEnd(); ++atomIter) {
+               if (i >= nAtom) {
+                  UTIL_THROW("Number of atoms exceeds System::nAtom()");
+               }
+               positions_[i] = atomIter->position();
+               typeIds_[i] = atomIter->typeId();
+               ++i;
+            }
+         }
+      }
+      firstAtomIds_[nSpecies] = i;
+
+      boundary_ = system.boundary();
+      iStep_ = iStep;
+      nAtom_ = i;
+      nSpecies_ = nSpecies;
+   }
+
+}
@@ -0,0 +1,158 @@
+#ifndef MCMD_SNAPSHOT_H
+#define MCMD_SNAPSHOT_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/boundary/Boundary.h>        // member (typedef)
+#include <util/containers/DArray.h>        // member template
+#include <util/space/Vector.h>             // template parameter
+#include <util/global.h>
+
+namespace McMd
+{
+
+   class System;
+
+   using namespace Util;
+
+   /**
+   * A copy of the atomic positions, atom types and boundary of a System.
+   *
+   * A Snapshot stores the state of a System at one step in a form that
+   * remains valid while the System continues to evolve. Atoms are stored
+   * in contiguous arrays, ordered by species, then by molecule within a
+   * species, then by atom within a molecule. This is the order in which
+   * atoms are visited by nested species, molecule and atom iterators, so
+   * that sums over atoms of a snapshot are evaluated in the same order as
+   * sums over atoms of the parent System.
+   *
+   * Snapshots are used to run snapshot-safe analyzers in a background
+   * pipeline (see AnalyzerManager and Analyzer::isSnapshotSafe()).
+   *
+   * \ingroup McMd_Analyzer_Module
+   */
+   class Snapshot
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      Snapshot();
+
+      /**
+      * Destructor.
+      */
+      ~Snapshot();
+
+      /**
+      * Copy positions, atom types and boundary from a System.
+      *
+      * Arrays are reallocated only if the number of atoms or species
+      * exceeds the current capacity.
+      *
+      * \param system  parent System
+      * \param iStep  step index at which the copy is made
+      */
+      void copy(const System& system, long iStep);
+
+      /**
+      * Get the step index at which this snapshot was made.
+      */
+      long iStep() const;
+
+      /**
+      * Get the total number of atoms.
+      */
+      int nAtom() const;
+
+      /**
+      * Get the number of species.
+      */
+      int nSpecies() const;
+
+      /**
+      * Get the index of the first atom of a species.
+      *
+      * Atoms of species speciesId have indices in the range
+      * firstAtomId(speciesId) <= i < firstAtomId(speciesId + 1).
+      *
+      * \param speciesId  species index, 0 <= speciesId <= nSpecies()
+      */
+      int firstAtomId(int speciesId) const;
+
+      /**
+      * Get the position of an atom.
+      *
+      * \param i  atom index, 0 <= i < nAtom()
+      */
+      const Vector& position(int i) const;
+
+      /**
+      * Get the atom type index of an atom.
+      *
+      * \param i  atom index, 0 <= i < nAtom()
+      */
+      int typeId(int i) const;
+
+      /**
+      * Get the boundary.
+      */
+      const Boundary& boundary() const;
+
+   private:
+
+      /// Atomic positions.
+      DArray<Vector> positions_;
+
+      /// Atom type indices.
+      DArray<int> typeIds_;
+
+      /// Index of first atom of each species, with nSpecies + 1 elements.
+      DArray<int> firstAtomIds_;
+
+      /// Periodic boundary.
+      Boundary boundary_;
+
+      /// Step index.
+      long iStep_;
+
+      /// Number of atoms.
+      int nAtom_;
+
+      /// Number of species.
+      int nSpecies_;
+
+   };
+
+   // Inline member functions
+
+   inline long Snapshot::iStep() const
+   {  return iStep_; }
+
+   inline int Snapshot::nAtom() const
+   {  return nAtom_; }
+
+   inline int Snapshot::nSpecies() const
+   {  return nSpecies_; }
+
+   inline int Snapshot::firstAtomId(int speciesId) const
+   {  return firstAtomIds_[speciesId]; }
+
+   inline const Vector& Snapshot::position(int i) const
+   {  return positions_[i]; }
+
+   inline int Snapshot::typeId(int i) const
+   {  return typeIds_[i]; }
+
+   inline const Boundary& Snapshot::boundary() const
+   {  return boundary_; }
+
+}
+#endif
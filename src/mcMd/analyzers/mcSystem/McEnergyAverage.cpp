@@ -26,12 +26,12 @@ namespace McMd
 
 
    /* 
-   * Evaluate energy, and add to accumulator.
+   * Add cached energy to accumulator.
    */
    void McEnergyAverage::sample(long iStep) 
    {
       if (isAtInterval(iStep))  {
-         accumulator_.sample(system().potentialEnergy(), outputFile_);
+         accumulator_.sample(system().cachedPotentialEnergy(), outputFile_);
       }
    }
    
@@ -19,6 +19,9 @@ namespace McMd
    /**
    * Analyzer to output total potential energy.
    *
+   * Each component of the energy is recomputed at each sample, because
+   * McSystem::cachedPotentialEnergy() caches only the total.
+   *
    * \ingroup McMd_Analyzer_Mc_Module
    */
    class McEnergyOutput : public SystemAnalyzer<McSystem>
@@ -115,85 +115,106 @@ namespace McMd
             UTIL_THROW("nMolecule has changed since setup");
          }
 
-         McPairPotential& potential = system().pairPotential();
-         const CellList& cellList = potential.cellList();
-         System::MoleculeIterator molIter;
-         Atom* ptr0 = 0;    // Pointer to first atom in molecule
-         Atom* ptr1 = 0;    // Pointer to flipped atom
-         Atom* ptr2 = 0;    // Pointer to neighboring atom
-         Mask* maskPtr = 0; // Mask of flipped atom
-         double rsq, dE, beta, boltzmann;
-         int j, k, nNeighbor, nFlip;
-         int i1, i2, id1, id2, t1, t2, t1New, iMol;
-         beta = system().energyEnsemble().beta();
-         nFlip = flipAtomIds_.size();
-
-         // Loop over molecules in species
-         iMol = 0;
-         system().begin(speciesId_, molIter); 
-         for ( ; molIter.notEnd(); ++molIter) {
-            dE = 0.0;
-            ptr0 = &molIter->atom(0);
-
-            // Loop over flipped atoms
-            for (j = 0; j < nFlip; ++j) {
-               i1 = flipAtomIds_[j];
-               t1New = newTypeIds_[i1];
-               ptr1 = &molIter->atom(i1);
-               id1 = ptr1->id();
-               t1 = ptr1->typeId();
-               maskPtr = &(ptr1->mask());
-
-               // Loop over neighboring atoms
-               cellList.getNeighbors(ptr1->position(), neighbors_);
-               nNeighbor = neighbors_.size();
-               for (k = 0; k < nNeighbor; ++k) {
-                  ptr2 = neighbors_[k];
-                  id2 = ptr2->id();
-
-                  // Check if atoms are identical
-                  if (id2 != id1) {
-          
-                     // Check if pair is masked
-                     if (!maskPtr->isMasked(*ptr2)) {
-
-                        rsq = boundary().distanceSq(ptr1->position(), 
-                                                    ptr2->position());
-                        t2 = ptr2->typeId();
-                        if (&(ptr1->molecule()) != &(ptr2->molecule())) {
-
-                           // Intermolecular atom pair 
+         double beta = system().energyEnsemble().beta();
+
+         // Molecules may be divided among threads, each with its own 
+         // neighbor array. Each molecule has its own accumulator.
+         #ifdef MCMD_OPENMP
+         int nThread = simulation().nThread();
+         #pragma omp parallel num_threads(nThread) if (nThread > 1)
+         #endif
+         {
+            CellList::NeighborArray neighbors;
+            double dE;
+            int iMol;
+
+            #ifdef MCMD_OPENMP
+            #pragma omp for schedule(static)
+            #endif
+            for (iMol = 0; iMol < nMolecule_; ++iMol) {
+               dE = exchangeEnergy(system().molecule(speciesId_, iMol), 
+                                   neighbors);
+               accumulators_[iMol].sample(exp(-beta*dE));
+            }
+         }
+      }
+   }
+
+   /*
+   * Compute change in pair energy for exchange of one molecule.
+   */
+   double McMuExchange::exchangeEnergy(Molecule& molecule, 
+                                       CellList::NeighborArray& neighbors)
+   {
+      const McPairPotential& potential = system().pairPotential();
+      const CellList& cellList = potential.cellList();
+      Atom* ptr0 = 0;    // Pointer to first atom in molecule
+      Atom* ptr1 = 0;    // Pointer to flipped atom
+      Atom* ptr2 = 0;    // Pointer to neighboring atom
+      Mask* maskPtr = 0; // Mask of flipped atom
+      double rsq;
+      double dE = 0.0;
+      int j, k, nNeighbor;
+      int i1, i2, id1, id2, t1, t2, t1New;
+      int nFlip = flipAtomIds_.size();
+
+      ptr0 = &molecule.atom(0);
+
+      // Loop over flipped atoms
+      for (j = 0; j < nFlip; ++j) {
+         i1 = flipAtomIds_[j];
+         t1New = newTypeIds_[i1];
+         ptr1 = &molecule.atom(i1);
+         id1 = ptr1->id();
+         t1 = ptr1->typeId();
+         maskPtr = &(ptr1->mask());
+
+         // Loop over neighboring atoms
+         cellList.getNeighbors(ptr1->position(), neighbors);
+         nNeighbor = neighbors.size();
+         for (k = 0; k < nNeighbor; ++k) {
+            ptr2 = neighbors[k];
+            id2 = ptr2->id();
+
+            // Check if atoms are identical
+            if (id2 != id1) {
+    
+               // Check if pair is masked
+               if (!maskPtr->isMasked(*ptr2)) {
+
+                  rsq = boundary().distanceSq(ptr1->position(), 
+                                              ptr2->position());
+                  t2 = ptr2->typeId();
+                  if (&(ptr1->molecule()) != &(ptr2->molecule())) {
+
+                     // Intermolecular atom pair 
+                     dE -= potential.energy(rsq, t1, t2);
+                     dE += potential.energy(rsq, t1New, t2);
+
+                  } else {
+
+                     // Intramolecular atom pair 
+                     if (id2 > id1) {
+                        dE -= potential.energy(rsq, t1, t2);
+                        i2 = (int)(ptr2 - ptr0);
+                        t2 = newTypeIds_[i2];
+                        dE += potential.energy(rsq, t1New, t2);
+                     } else {
+                        i2 = (int)(ptr2 - ptr0);
+                        if (!isAtomFlipped_[i2]) {
                            dE -= potential.energy(rsq, t1, t2);
+                           t2 = newTypeIds_[i2];
                            dE += potential.energy(rsq, t1New, t2);
-
-                        } else {
-
-                           // Intramolecular atom pair 
-                           if (id2 > id1) {
-                              dE -= potential.energy(rsq, t1, t2);
-                              i2 = (int)(ptr2 - ptr0);
-                              t2 = newTypeIds_[i2];
-                              dE += potential.energy(rsq, t1New, t2);
-                           } else {
-                              i2 = (int)(ptr2 - ptr0);
-                              if (!isAtomFlipped_[i2]) {
-                                 dE -= potential.energy(rsq, t1, t2);
-                                 t2 = newTypeIds_[i2];
-                                 dE += potential.energy(rsq, t1New, t2);
-                              }
-                           }
-
                         }
                      }
+
                   }
-               } // end loop over neighbors
-            } // end loop over flipped atoms
+               }
+            }
+         } // end loop over neighbors
+      } // end loop over flipped atoms
 
-            boltzmann = exp(-beta*dE);
-            accumulators_[iMol].sample(boltzmann);
-            ++iMol;
-         } // end loop over molecules
-      }
+      return dE;
    }
 
    /*
@@ -33,6 +33,9 @@ namespace McMd
    * transformation of the atom types of some or all atoms
    * in the molecule. 
    *
+   * If the parent Simulation has more than one thread, molecules are
+   * divided among threads when compiled with MCMD_OPENMP defined.
+   *
    * \ingroup McMd_Analyzer_Mc_Module
    */
    class McMuExchange : public SystemAnalyzer<McSystem>
@@ -96,6 +99,16 @@ namespace McMd
       /// Get Boundary object of parent McSystem.
       Boundary& boundary();
 
+      /**
+      * Compute change in pair energy for transformation of one molecule.
+      *
+      * \param molecule  molecule to be transformed
+      * \param neighbors neighbor array workspace for the calling thread
+      * \return change in pair energy
+      */
+      double exchangeEnergy(Molecule& molecule, 
+                            CellList::NeighborArray& neighbors);
+
       /// Pointer to Simulation of parent System.
       Simulation  *simulationPtr_;
 
@@ -117,9 +130,6 @@ namespace McMd
       /// Array of ids for atoms that change type.
       DSArray<int> flipAtomIds_;
 
-      /// Array to hold pointers to neighboring atoms.
-      CellList::NeighborArray neighbors_;
-
       /// Actual number of trial positions for each regrown atom.
       int  speciesId_; 
 
@@ -42,12 +42,20 @@ namespace McMd
       randomPtr_(&system.simulation().random()),
       outputFile_(),
       accumulator_(),
+      insertPositions_(),
+      insertEnergies_(),
       nTrial_(-1),
       nMoleculeTrial_(-1),
       nSamplePerBlock_(1),
       isInitialized_(false)
    {}
 
+   /*
+   * Destructor.
+   */
+   McNVTChemicalPotential::~McNVTChemicalPotential()
+   {}
+
 
    /*
    * Read parameters and initialize.
@@ -119,216 +127,104 @@ namespace McMd
       if (isAtInterval(iStep))  {
 
          Molecule* molPtr;
-         Atom* endPtr, *pvt1Ptr;
-         Vector trialPos[MaxTrial_], bondVec, pvt1Pos;
-         #ifdef INTER_ANGLE
-         double angle;
-         Atom* pvt2Ptr;
-         Vector pvt2Pos;
-         #endif
-         double beta, length;
-         // Rosenbluth factor and energy of inserted bonds at each stage.
-         double w = 0, de = 0;
-         // Total rosenbluth factor and energy of inserted polymer.
-         double rosenbluth = 1, energy = 0;
-         double trialProb[MaxTrial_], trialEnergy[MaxTrial_];
-         int    iTrial;
-
-         beta = energyEnsemble().beta();
+         Atom* firstPtr;
+         Vector* trialPos;
+         double* trialEnergy;
+         // Rosenbluth factor and energy of inserted atom at each stage.
+         double w, de;
+         // Total rosenbluth factor of inserted polymer.
+         double rosenbluth;
+         double trialProb[MaxTrial_];
+         int    i, k, iTrial, atomId, nAtom, nAdded;
+
          molPtr = &(simulation().getMolecule(speciesId_));
          system().addMolecule(*molPtr);
-
-         // Main molecule inserting loop:
-         for (int i = 0; i < nMoleculeTrial_; i++) {
-
-            // Inserting the first atom.
-            endPtr = &molPtr->atom(0);
-            for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
-               // trialPos = pvtPos + bondVec
-               boundary().randomPosition(random(), trialPos[iTrial]);
-               boundary().shift(trialPos[iTrial]);
-               #ifndef INTER_NOPAIR
-               trialEnergy[iTrial] = 
-                  system().pairPotential().atomEnergy(*endPtr);
-               #else
-               trialEnergy[iTrial] = 0.0;
-               #endif
-
-               #ifdef INTER_EXTERNAL
-               trialEnergy[iTrial] += 
-                  system().externalPotential().atomEnergy(*endPtr);
-               #endif
-
-               trialProb[iTrial] = boltzmann(trialEnergy[iTrial]);
-               w += trialProb[iTrial];
-            }
-
-            // Normalize trial probabilities
-            for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
-               trialProb[iTrial] = trialProb[iTrial]/rosenbluth;
+         nAtom = molPtr->nAtom();
+         firstPtr = &molPtr->atom(0);
+
+         // Generate trial positions for the first atoms of all trial 
+         // molecules, and evaluate their energies in a single batch.
+         int nPosition = nMoleculeTrial_*nTrial_;
+         if (!insertPositions_.isAllocated()) {
+            insertPositions_.allocate(nPosition);
+            insertEnergies_.allocate(nPosition);
+         }
+         for (k = 0; k < nPosition; ++k) {
+            boundary().randomPosition(random(), insertPositions_[k]);
+         }
+         #ifndef INTER_NOPAIR
+         system().pairPotential().insertionEnergies(firstPtr->typeId(), 
+                                                    &insertPositions_[0], 
+                                                    nPosition,
+                                                    &insertEnergies_[0]);
+         #else
+         for (k = 0; k < nPosition; ++k) {
+            insertEnergies_[k] = 0.0;
+         }
+         #endif
+         #ifdef INTER_EXTERNAL
+         if (system().hasExternalPotential()) {
+            for (k = 0; k < nPosition; ++k) {
+               firstPtr->position() = insertPositions_[k];
+               insertEnergies_[k] += 
+                  system().externalPotential().atomEnergy(*firstPtr);
             }
-            // Choose trial position
-            iTrial = random().drawFrom(trialProb, nTrial_);
-            // Calculate total energy for chosen trial
-            de = trialEnergy[iTrial];
-            // Set position of new end atom to chosen trialPos Vector
-            endPtr->position() = trialPos[iTrial];
-            system().pairPotential().addAtom(*endPtr);
-            rosenbluth *= w;
-            energy += de;
-
-            // Inserting the second atom.
-            int bondTypeId = molPtr->bond(0).typeId();
-            length = system().bondPotential().randomBondLength(&random(), 
-                                                               beta, 
-                                                               bondTypeId);
-
-            w = 0;
-            de = 0;
-
-            pvt1Ptr = &molPtr->atom(0);
-            endPtr = &molPtr->atom(1);
+         }
+         #endif
 
-            pvt1Pos = pvt1Ptr->position();
+         // Main molecule inserting loop:
+         for (i = 0; i < nMoleculeTrial_; i++) {
 
+            // Rosenbluth factor of the first atom.
+            trialPos = &insertPositions_[i*nTrial_];
+            trialEnergy = &insertEnergies_[i*nTrial_];
+            w = 0.0;
             for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
-               // trialPos = pvtPos + bondVec
-               random().unitVector(bondVec);
-               bondVec *= length;
-               // trialPos = pvtPos + bondVec
-               trialPos[iTrial].add(pvt1Pos, bondVec);
-               boundary().shift(trialPos[iTrial]);
-               endPtr->position() = trialPos[iTrial];
-
-               #ifndef INTER_NOPAIR
-               trialEnergy[iTrial] =
-                  system().pairPotential().atomEnergy(*endPtr);
-               #else
-               trialEnergy[iTrial] = 0.0;
-               #endif
-
-               #ifdef INTER_EXTERNAL
-               trialEnergy[iTrial] += 
-                  system().externalPotential().atomEnergy(*endPtr);
-               #endif
-
                trialProb[iTrial] = boltzmann(trialEnergy[iTrial]);
                w += trialProb[iTrial];
             }
+            rosenbluth = w;
 
-            // Normalize trial probabilities
-            for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
-               trialProb[iTrial] = trialProb[iTrial]/rosenbluth;
-            }
-            // Choose trial position
-            iTrial = random().drawFrom(trialProb, nTrial_);
-            // Calculate total energy for chosen trial
-            de = trialEnergy[iTrial];
-            // Calculate total energy for chosen trial.
-            de += system().bondPotential().energy(length*length, bondTypeId);
-
-            // Set position of new end atom to chosen trialPos Vector
-            endPtr->position() = trialPos[iTrial];
-            system().pairPotential().addAtom(*endPtr);
-            rosenbluth *= w;
-            energy += de;
-
-            // Inserting the third atom.
-            bondTypeId = molPtr->bond(1).typeId();
-            length = 
-               system().bondPotential().randomBondLength(&random(), 
-                                                         beta, bondTypeId);
-
-            #ifdef INTER_ANGLE
-            int angleTypeId = molPtr->angle(0).typeId();
-            angle = 
-               system().anglePotential().randomAngle(&random(), 
-                                                     beta, angleTypeId);
-            pvt2Ptr = &molPtr->atom(0);
-            pvt2Pos = pvt2Ptr->position();
-            Vector n = pvt1Pos;
-            n -= pvt2Pos;
-            #endif
-
-            w = 0;
-            de = 0;
-            pvt1Ptr = &molPtr->atom(1);
-            pvt1Pos = pvt1Ptr->position();
-            endPtr = &molPtr->atom(2);
+            // Grow remaining atoms by configuration bias, if any.
+            nAdded = 0;
+            if (nAtom > 1 && w > 0.0) {
 
-            for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
-               // trialPos = pvtPos + bondVec
-               #ifdef INTER_ANGLE
-               if (system().hasAnglePotential()) {
-                  uniformCone(length, angle, n, bondVec);
-               } else {
-                  random().unitVector(bondVec);
-                  bondVec *= length;
+               // Choose position of first atom
+               for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+                  trialProb[iTrial] = trialProb[iTrial]/w;
                }
-               #else
-               random().unitVector(bondVec);
-               bondVec *= length;
-               #endif
-
-               // trialPos = pvtPos + bondVec
-               trialPos[iTrial].add(pvt1Pos, bondVec);
-               boundary().shift(trialPos[iTrial]);
-               endPtr->position() = trialPos[iTrial];
-
+               iTrial = random().drawFrom(trialProb, nTrial_);
+               firstPtr->position() = trialPos[iTrial];
                #ifndef INTER_NOPAIR
-               trialEnergy[iTrial] = 
-                  system().pairPotential().atomEnergy(*endPtr);
-               #else
-               trialEnergy[iTrial] = 0.0;
-               #endif
-
-               #ifdef INTER_EXTERNAL
-               trialEnergy[iTrial] += 
-                  system().externalPotential().atomEnergy(*endPtr);
+               system().pairPotential().addAtom(*firstPtr);
                #endif
-
-               trialProb[iTrial] = boltzmann(trialEnergy[iTrial]);
-               w += trialProb[iTrial];
-            }
-            // Normalize trial probabilities
-            for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
-               trialProb[iTrial] = trialProb[iTrial]/rosenbluth;
-            }
-            // Choose trial position
-            iTrial = random().drawFrom(trialProb, nTrial_);
-            // Calculate total energy for chosen trial
-            de = trialEnergy[iTrial];
-            // Calculate total energy for chosen trial.
-            de += system().bondPotential().energy(length*length, bondTypeId);
-            #ifdef INTER_ANGLE
-            de += system().anglePotential().energy(cos(angle), angleTypeId);
-            #endif
-
-            // Set position of new end atom to chosen trialPos Vector
-            endPtr->position() = trialPos[iTrial];
-            system().pairPotential().addAtom(*endPtr);
-            rosenbluth *= w;
-            energy += de;
-
-            for (int atomId = 3; atomId < molPtr->nAtom(); ++atomId) {
-                addEndAtom(molPtr, atomId, w, de);
-                rosenbluth *= w;
-                energy += de;
-                system().pairPotential().addAtom(molPtr->atom(atomId));
+               nAdded = 1;
+
+               for (atomId = 1; atomId < nAtom; ++atomId) {
+                  addEndAtom(molPtr, atomId, w, de);
+                  rosenbluth *= w;
+                  if (w == 0.0) break;
+                  #ifndef INTER_NOPAIR
+                  system().pairPotential().addAtom(molPtr->atom(atomId));
+                  #endif
+                  ++nAdded;
+               }
             }
 
-            rosenbluth = rosenbluth / pow(nTrial_,molPtr->nAtom());
+            rosenbluth = rosenbluth / pow(nTrial_, nAtom);
             accumulator_.sample(rosenbluth, outputFile_);
 
-            for (int atomId = 0; atomId < molPtr->nAtom(); ++atomId) {
+            #ifndef INTER_NOPAIR
+            for (atomId = 0; atomId < nAdded; ++atomId) {
                 system().pairPotential().deleteAtom(molPtr->atom(atomId));
             }
+            #endif
          }
 
          system().removeMolecule(*molPtr);
          simulation().returnMolecule(*molPtr);
 
-         }
+      }
    }
 
    /*
@@ -379,7 +275,7 @@ namespace McMd
    { ar & *this; }
 
 
-    /*
+   /*
    * Configuration bias algorithm for adding one atom to a chain end.
    */
    void
@@ -391,52 +287,49 @@ namespace McMd
       Vector trialPos[MaxTrial_];
       Vector bondVec;
       Vector pvt1Pos = molPtr->atom(atomId-1).position();
-
-      #ifdef INTER_ANGLE
-      Vector pvt2Pos = molPtr->atom(atomId-2).position();
-      #endif
-
-      #ifdef INTER_DIHEDRAL
-      Vector pvt3Pos = molPtr->atom(atomId-3).position();
-      #endif
-
       double trialProb[MaxTrial_], trialEnergy[MaxTrial_];
       double beta, length;
       int bondTypeId = molPtr->bond(atomId - 1).typeId();
-
-      #ifdef INTER_ANGLE
-      double angle;
-      int angleTypeId = molPtr->angle(atomId - 2).typeId();
-      #endif
-
       int    iTrial;
       double eMin = 0;
 
-      // Generate a random bond-length and bond-angle.
+      // Generate a random bond-length.
       beta   = energyEnsemble().beta();
       length = system().bondPotential().randomBondLength(&random(), beta, 
-                                        molPtr->bond(atomId-1).typeId());
+                                                         bondTypeId);
+
+      // Generate a random bond-angle, if the end atom has an angle.
       #ifdef INTER_ANGLE
-      Vector n = pvt1Pos;
-      n -= pvt2Pos;
-      angle = system().anglePotential().randomAngle(&random(), beta, 
-                                        molPtr->angle(atomId-2).typeId());
+      bool hasAngle = (atomId > 1 && system().hasAnglePotential());
+      int angleTypeId = -1;
+      double angle = 0.0;
+      Vector n;
+      if (hasAngle) {
+         angleTypeId = molPtr->angle(atomId - 2).typeId();
+         boundary().distanceSq(pvt1Pos, molPtr->atom(atomId-2).position(), 
+                               n);
+         angle = system().anglePotential().randomAngle(&random(), beta, 
+                                                       angleTypeId);
+      }
       #endif
+
       #ifdef INTER_DIHEDRAL
-      Vector dR1 = pvt3Pos;
-      Vector dR2 = pvt2Pos;
-      Vector dR3 = pvt1Pos;
-      dR1 -= pvt2Pos;
-      dR2 -= pvt1Pos;
-      dR3 -= endPtr->position();
+      bool hasDihedral = (atomId > 2 && system().hasDihedralPotential());
+      int dihedralTypeId = -1;
+      Vector dR1, dR2;
+      if (hasDihedral) {
+         dihedralTypeId = molPtr->dihedral(atomId - 3).typeId();
+         boundary().distanceSq(molPtr->atom(atomId-2).position(),
+                               molPtr->atom(atomId-3).position(), dR1);
+         boundary().distanceSq(pvt1Pos, 
+                               molPtr->atom(atomId-2).position(), dR2);
+      }
       #endif
 
-      // Loop over nTrial trial positions:
-      rosenbluth = 0.0;
+      // Generate nTrial trial positions:
       for (iTrial=0; iTrial < nTrial_; ++iTrial) {
-
          #ifdef INTER_ANGLE
-         if (system().hasAnglePotential()) {
+         if (hasAngle) {
             uniformCone(length, angle, n, bondVec);
          } else {
             random().unitVector(bondVec);
@@ -446,41 +339,61 @@ namespace McMd
          random().unitVector(bondVec);
          bondVec *= length;
          #endif
-
          trialPos[iTrial].add(pvt1Pos, bondVec);
          boundary().shift(trialPos[iTrial]);
-         endPtr->position() = trialPos[iTrial];
+      }
 
-         #ifndef INTER_NOPAIR
-         trialEnergy[iTrial] = system().pairPotential().atomEnergy(*endPtr);
-         #else
+      // Compute nonbonded pair energies of all trial positions.
+      #ifndef INTER_NOPAIR
+      system().pairPotential().trialEnergies(*endPtr, trialPos, nTrial_,
+                                             trialEnergy);
+      #else
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
          trialEnergy[iTrial] = 0.0;
-         #endif
+      }
+      #endif
+
+      // Add dihedral and external energies, and Boltzmann factors.
+      rosenbluth = 0.0;
+      for (iTrial=0; iTrial < nTrial_; ++iTrial) {
 
          #ifdef INTER_DIHEDRAL
-         if (system().hasDihedralPotential()) {
+         if (hasDihedral) {
+            boundary().distanceSq(trialPos[iTrial], pvt1Pos, bondVec);
             trialEnergy[iTrial] += 
-               system().dihedralPotential().energy(dR1, dR2, dR3, 
-                                        molPtr->dihedral(atomId-3).typeId());
+               system().dihedralPotential().energy(dR1, dR2, bondVec, 
+                                                   dihedralTypeId);
          }
          #endif
 
          #ifdef INTER_EXTERNAL
-         trialEnergy[iTrial] += 
-            system().externalPotential().atomEnergy(*endPtr);
+         if (system().hasExternalPotential()) {
+            endPtr->position() = trialPos[iTrial];
+            trialEnergy[iTrial] += 
+               system().externalPotential().atomEnergy(*endPtr);
+         }
          #endif
 
-         // Finding the Minimum of the trialEnergy vector
-         if (eMin > trialEnergy[iTrial])
-            eMin = trialEnergy[iTrial];
-         Eaccumulator_.sample(trialEnergy[iTrial]);
+         // Record energy distributions for atoms beyond the third
+         if (atomId > 2) {
+            if (eMin > trialEnergy[iTrial])
+               eMin = trialEnergy[iTrial];
+            Eaccumulator_.sample(trialEnergy[iTrial]);
+         }
 
          trialProb[iTrial] = boltzmann(trialEnergy[iTrial]);
          rosenbluth += trialProb[iTrial];
       }
 
-      Emaccumulator_.sample(eMin);
-      BRaccumulator_.sample(rosenbluth);
+      if (atomId > 2) {
+         Emaccumulator_.sample(eMin);
+         BRaccumulator_.sample(rosenbluth);
+      }
+      if (rosenbluth == 0.0) {
+         energy = 0.0;
+         return;
+      }
+
       // Normalize trial probabilities
       for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
          trialProb[iTrial] = trialProb[iTrial]/rosenbluth;
@@ -492,11 +405,15 @@ namespace McMd
       // Calculate total energy for chosen trial.
       energy = system().bondPotential().energy(length*length, bondTypeId);
       #ifdef INTER_ANGLE
-      energy += system().anglePotential().energy(cos(angle), angleTypeId);
+      if (hasAngle) {
+         energy += system().anglePotential().energy(cos(angle), 
+                                                    angleTypeId);
+      }
       #endif
-
       energy += trialEnergy[iTrial];
-      Ecaccumulator_.sample(energy);
+      if (atomId > 2) {
+         Ecaccumulator_.sample(energy);
+      }
 
       // Set position of new end atom to chosen value
       endPtr->position() = trialPos[iTrial];
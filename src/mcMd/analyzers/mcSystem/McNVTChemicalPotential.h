@@ -13,6 +13,8 @@
 #include <util/accumulators/Average.h>      // member
 #include <util/accumulators/Distribution.h> // member
 #include <util/random/Random.h>             // member
+#include <util/containers/DArray.h>         // member
+#include <util/space/Vector.h>              // member template argument
 #include <util/ensembles/EnergyEnsemble.h>  // inline function
 #include <util/archives/Serializable.h>     // typedef
 
@@ -29,6 +31,16 @@ namespace McMd
    * McNVTChemicalPotential uses configuration bias algorithm
    * to calculate the chemical potential of a linear chain.
    *
+   * At each sample, nMoleculeTrial ghost molecules are inserted one
+   * at a time. The nTrial trial positions of the first atom of every
+   * ghost molecule are generated together, and their pair energies are
+   * evaluated in one batch by McPairPotential::insertionEnergies(), 
+   * which sorts positions by cell and may divide them among threads.
+   * Remaining atoms are grown by configuration bias, using 
+   * McPairPotential::trialEnergies() for the trials of each atom. 
+   * For a molecule with one atom, this reduces to Widom test particle 
+   * insertion with nMoleculeTrial*nTrial test positions per sample.
+   *
    * \ingroup McMd_Analyzer_Mc_Module
    */
    class McNVTChemicalPotential : public SystemAnalyzer<McSystem>
@@ -41,6 +53,11 @@ namespace McMd
       */
       McNVTChemicalPotential(McSystem& system);
 
+      /**
+      * Destructor.
+      */
+      virtual ~McNVTChemicalPotential();
+
       /**
       * Read parameters and initialize.
       */
@@ -230,6 +247,12 @@ namespace McMd
       /// Number of bins in range
       double BRnBin_;
 
+      /// Trial positions of first atoms of all trial molecules.
+      DArray<Vector> insertPositions_;
+
+      /// Energies of first atoms at insertPositions_.
+      DArray<double> insertEnergies_;
+
       /// Actual number of trial positions for each regrown atom.
       int  nTrial_; 
 
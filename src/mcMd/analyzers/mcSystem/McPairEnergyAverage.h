@@ -25,6 +25,10 @@ namespace McMd
    /**
    * McPairEnergyAverage averages of total potential energy.
    *
+   * The pair energy of pairs accepted by a PairSelector is recomputed 
+   * at each sample. The cached McSystem::cachedPotentialEnergy() is not
+   * used, since it includes all pairs and all other potentials.
+   *
    * \ingroup McMd_Analyzer_Mc_Module
    */
    class McPairEnergyAverage : public SystemAnalyzer<McSystem>
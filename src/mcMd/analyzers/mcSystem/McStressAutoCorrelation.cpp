@@ -32,17 +32,20 @@ namespace McMd
       double pressure;
       double temperature;
       McSystem& sys=system(); 
-      sys.computeStress(pressure);
 
       DArray<double> elements;
       elements.allocate(9);
 
-      Tensor total;
-
       if (isAtInterval(iStep)){
-         sys.computeVirialStress(total);
+         const Tensor& total = sys.virialStress();
          temperature = sys.energyEnsemble().temperature();
 
+         // Total pressure, including the ideal gas contribution
+         pressure = sys.virialPressure();
+         if (sys.energyEnsemble().isIsothermal()) {
+            pressure += temperature*sys.nAtom()/sys.boundary().volume();
+         }
+
          elements[0] = (total(0,0) - pressure / 3.0) / (10.0 * temperature);
          elements[1] = (total(0,1) + total(1,0)) / 2.0 / (10.0 * temperature);
          elements[2] = (total(0,2) + total(2,0)) / 2.0 / (10.0 * temperature);
@@ -125,8 +125,7 @@ namespace McMd
    {
       if (isAtInterval(iStep))  {
 
-         Tensor virial;
-         system().computeVirialStress<Tensor>(virial);
+         const Tensor& virial = system().virialStress();
  
          sxxAccumulator_.sample(virial(0,0));
          sxyAccumulator_.sample(virial(0,1));
@@ -12,6 +12,7 @@
 #include <mcMd/perturb/LinearPerturbation.h>  
 #include <mcMd/simulation/Simulation.h>
 #include <mcMd/simulation/System.h>
+#include <mcMd/perturb/ReplicaMove.h>
 #include <util/mpi/MpiSendRecv.h>
 #include <util/format/Dbl.h>
 #ifdef UTIL_MPI
@@ -172,6 +173,13 @@ namespace McMd
          UTIL_THROW("Object is not initialized");
       }
 
+      // Neighboring states must remain on neighboring processors
+      if (system().hasReplicaMove()) {
+         if (system().replicaMove().swapsParameters()) {
+            UTIL_THROW("BennettsMethod requires replica configuration swaps");
+         }
+      }
+
       communicatorPtr_->Bcast((void*)&shifts_[0], nProcs_, MPI::DOUBLE, 0);
       if ( myId_ != 0 ) {
          lowerShift_ = shifts_[lowerId_];
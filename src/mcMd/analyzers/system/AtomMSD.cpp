@@ -28,6 +28,7 @@ namespace McMd
     : SystemAnalyzer<System>(system),
       outputFile_(),
       accumulator_(),
+      multiTau_(),
       truePositions_(),
       oldPositions_(),
       shifts_(),
@@ -35,6 +36,8 @@ namespace McMd
       atomId_(-1),
       nMolecule_(-1),
       capacity_(-1),
+      blockFactor_(0),
+      hasBlockFactor_(false),
       isInitialized_(false)
    {  setClassName("AtomMSD"); }
 
@@ -50,6 +53,8 @@ namespace McMd
       read<int>(in, "speciesId", speciesId_);
       read<int>(in, "atomId", atomId_);
       read<int>(in, "capacity", capacity_);
+      hasBlockFactor_ = readOptional<int>(in, "blockFactor", blockFactor_)
+                                         .isActive();
 
       // Validate parameters
       if (speciesId_ < 0)
@@ -74,8 +79,13 @@ namespace McMd
       oldPositions_.allocate(speciesCapacity);
       shifts_.allocate(speciesCapacity);
 
-      // Allocate memory for the AutoCorrArray accumulator
-      accumulator_.setParam(speciesCapacity, capacity_);
+      // Allocate memory for the accumulator
+      if (hasBlockFactor_) {
+         multiTau_.setParam(speciesCapacity, capacity_, blockFactor_);
+         multiTau_.setMeanSqDisp(true);
+      } else {
+         accumulator_.setParam(speciesCapacity, capacity_);
+      }
 
       isInitialized_ = true;
    }
@@ -90,6 +100,11 @@ namespace McMd
       loadParameter<int>(ar, "speciesId", speciesId_);
       loadParameter<int>(ar, "atomId", atomId_);
       loadParameter<int>(ar, "capacity", capacity_);
+      hasBlockFactor_ = false;
+      if (ar.version() > 0) {
+         hasBlockFactor_ = loadParameter<int>(ar, "blockFactor", 
+                                              blockFactor_, false).isActive();
+      }
 
       // Validate parameters
       if (speciesId_ < 0)
@@ -114,10 +129,13 @@ namespace McMd
       oldPositions_.allocate(speciesCapacity);
       shifts_.allocate(speciesCapacity);
 
-      // Allocate memory for the AutoCorrArray accumulator
-      accumulator_.setParam(speciesCapacity, capacity_);
-
-      ar & accumulator_;
+      // Allocate memory for, and load, the accumulator
+      if (hasBlockFactor_) {
+         ar & multiTau_;
+      } else {
+         accumulator_.setParam(speciesCapacity, capacity_);
+         ar & accumulator_;
+      }
       ar & truePositions_;
       ar & oldPositions_;
       ar & shifts_;
@@ -130,7 +148,22 @@ namespace McMd
    * Save state to archive.
    */
    void AtomMSD::save(Serializable::OArchive& ar)
-   { ar & (*this); }
+   { 
+      Analyzer::save(ar);
+      ar & speciesId_;
+      ar & atomId_;
+      ar & capacity_;
+      Parameter::saveOptional(ar, blockFactor_, hasBlockFactor_);
+      if (hasBlockFactor_) {
+         ar & multiTau_;
+      } else {
+         ar & accumulator_;
+      }
+      ar & truePositions_;
+      ar & oldPositions_;
+      ar & shifts_;
+      ar & nMolecule_;
+   }
 
    /*
    * Initialize at beginning of simulation.
@@ -143,8 +176,13 @@ namespace McMd
 
       // Set number of molecules of this species in the System. 
       nMolecule_ = system().nMolecule(speciesId_);
-      accumulator_.setNEnsemble(nMolecule_);
-      accumulator_.clear();
+      if (hasBlockFactor_) {
+         multiTau_.setNEnsemble(nMolecule_);
+         multiTau_.clear();
+      } else {
+         accumulator_.setNEnsemble(nMolecule_);
+         accumulator_.clear();
+      }
 
       // Store initial positions, and set initial shift vectors.
       Vector r;
@@ -196,7 +234,11 @@ namespace McMd
          oldPositions_[i] = r;
   
       }
-      accumulator_.sample(truePositions_);
+      if (hasBlockFactor_) {
+         multiTau_.sample(truePositions_);
+      } else {
+         accumulator_.sample(truePositions_);
+      }
 
    }
 
@@ -209,12 +251,21 @@ namespace McMd
       writeParam(outputFile_); 
       outputFile_ << std::endl;
       outputFile_ << std::endl;
-      outputFile_ << "nMolecule      " << accumulator_.nEnsemble() 
-                  << std::endl;
-      outputFile_ << "buffercapacity " << accumulator_.bufferCapacity()  
-                  << std::endl;
-      outputFile_ << "nSample        " << accumulator_.nSample() 
-                  << std::endl;
+      if (hasBlockFactor_) {
+         outputFile_ << "nMolecule      " << multiTau_.nEnsemble() 
+                     << std::endl;
+         outputFile_ << "buffercapacity " << multiTau_.bufferCapacity()  
+                     << std::endl;
+         outputFile_ << "nSample        " << multiTau_.nSample() 
+                     << std::endl;
+      } else {
+         outputFile_ << "nMolecule      " << accumulator_.nEnsemble() 
+                     << std::endl;
+         outputFile_ << "buffercapacity " << accumulator_.bufferCapacity()  
+                     << std::endl;
+         outputFile_ << "nSample        " << accumulator_.nSample() 
+                     << std::endl;
+      }
       outputFile_ << std::endl;
       //outputFile_ << "Format of *.dat file:" << std::endl;
       //outputFile_ << "[i]  [MSD]" << std::endl;
@@ -222,7 +273,11 @@ namespace McMd
 
       // Output statistical analysis to separate data file
       fileMaster().openOutputFile(outputFileName(".dat"), outputFile_);
-      accumulator_.output(outputFile_); 
+      if (hasBlockFactor_) {
+         multiTau_.output(outputFile_); 
+      } else {
+         accumulator_.output(outputFile_); 
+      }
       outputFile_.close();
 
    }
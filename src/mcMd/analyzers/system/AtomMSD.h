@@ -11,6 +11,7 @@
 #include <mcMd/analyzers/SystemAnalyzer.h>  // base class template
 #include <mcMd/simulation/System.h>             // base class template parameter
 #include <util/accumulators/MeanSqDispArray.h>  // member template 
+#include <util/accumulators/MultiTauArray.h>    // member template 
 #include <util/space/Vector.h>                   // member template parameter
 #include <util/containers/DArray.h>             // member template
 
@@ -20,7 +21,14 @@ namespace McMd
    using namespace Util;
 
    /**
-   * Autocorrelation for vector separation of two atoms on a molecule.  
+   * Mean-squared displacement of one atom within each molecule.  
+   *
+   * By default, the MSD is computed for all delays up to capacity - 1
+   * samples, at a cost proportional to capacity per molecule per 
+   * sample. If the optional blockFactor parameter is present, the MSD
+   * is instead computed by a MultiTauArray with bufferCapacity equal 
+   * to capacity, for approximately logarithmically spaced delays up to 
+   * the length of the simulation.
    *
    * \sa \ref mcMd_analyzer_AtomMSD_page "parameter file format"
    * \ingroup McMd_Analyzer_McMd_Module
@@ -58,15 +66,6 @@ namespace McMd
       */
       virtual void save(Serializable::OArchive& ar);
 
-      /**
-      * Serialize to/from an archive. 
-      *
-      * \param ar      saving or loading archive
-      * \param version archive version id
-      */
-      template <class Archive>
-      void serialize(Archive& ar, const unsigned int version);
-
       /** 
       * Determine number of molecules and allocate memory.
       */
@@ -93,6 +92,9 @@ namespace McMd
       /// Statistical accumulator
       MeanSqDispArray<Vector> accumulator_;
 
+      /// Multiple-tau accumulator (used iff hasBlockFactor_).
+      MultiTauArray<Vector, double> multiTau_;
+
       /// Array of position vectors, one per molecule of species.
       DArray<Vector>    truePositions_;
    
@@ -113,28 +115,17 @@ namespace McMd
    
       /// Maximum length of each sequence in AutoCorrArray.
       int     capacity_;
+
+      /// Ratio of sampling intervals of multiple-tau stages.
+      int     blockFactor_;
+
+      /// Is the multiple-tau accumulator used?
+      bool    hasBlockFactor_;
    
       /// Has readParam been called?
       int     isInitialized_;
    
    };
 
-   /*
-   * Serialize to/from an archive. 
-   */
-   template <class Archive>
-   void AtomMSD::serialize(Archive& ar, const unsigned int version)
-   {
-      Analyzer::serialize(ar, version);
-      ar & speciesId_;
-      ar & atomId_;
-      ar & capacity_;
-      ar & accumulator_;
-      ar & truePositions_;
-      ar & oldPositions_;
-      ar & shifts_;
-      ar & nMolecule_;
-   }
-
 }
 #endif
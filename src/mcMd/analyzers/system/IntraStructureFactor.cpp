@@ -29,6 +29,7 @@ namespace McMd
    */
    IntraStructureFactor::IntraStructureFactor(System& system) 
     : SystemAnalyzer<System>(system),
+      maxIndex_(0),
       isInitialized_(false)
    {  setClassName("IntraStructureFactor"); }
 
@@ -61,6 +62,7 @@ namespace McMd
       fourierModes_.allocate(nWave_, nAtomType_ + 1);
       structureFactors_.allocate(nWave_, nAtomTypeIdPair_);
       structureFactorDelta_.allocate(nWave_, nAtomTypeIdPair_);
+      allocatePhases();
 
       isInitialized_ = true; 
    }
@@ -94,6 +96,8 @@ namespace McMd
       ar & nSample_;
 
       waveVectors_.allocate(nWave_);
+      structureFactorDelta_.allocate(nWave_, nAtomTypeIdPair_);
+      allocatePhases();
       isInitialized_ = true; 
    }
 
@@ -136,8 +140,9 @@ namespace McMd
          Vector  position;
          std::complex<double> rho[2];
          std::complex<double> expFactor;
-         double  volume = system().boundary().volume();
-         double  product, dS;
+         const Boundary& boundary = system().boundary();
+         double  volume = boundary.volume();
+         double  dS;
          System::ConstMoleculeIterator molIter;
          Molecule::ConstAtomIterator   atomIter;
          int  typeId, i, j, k;
@@ -165,13 +170,16 @@ namespace McMd
             // Loop over all atoms in one molecule
             molIter->begin(atomIter); 
             for ( ; atomIter.notEnd(); ++atomIter) {
-               position = atomIter->position();
-               typeId   = atomIter->typeId();
+               boundary.transformCartToGen(atomIter->position(), position);
+               typeId = atomIter->typeId();
+               computePhases(position);
  
                // Loop over wavevectors
                for (i = 0; i < nWave_; ++i) {
-                  product = position.dot(waveVectors_[i]);
-                  expFactor = exp( product*Constants::Im );
+                  const IntVector& m = waveIntVectors_[i];
+                  expFactor = phases_(0, m[0] + maxIndex_)
+                            * phases_(1, m[1] + maxIndex_)
+                            * phases_(2, m[2] + maxIndex_);
                   fourierModes_(i, typeId)     += expFactor;
                   fourierModes_(i, nAtomType_) += expFactor;
                }
@@ -224,6 +232,40 @@ namespace McMd
       }
    }
 
+   /*
+   * Find the maximum Miller index, and allocate the phase factor table.
+   */
+   void IntraStructureFactor::allocatePhases() 
+   {
+      int i, j, m;
+      maxIndex_ = 0;
+      for (i = 0; i < nWave_; ++i) {
+         for (j = 0; j < Dimension; ++j) {
+            m = waveIntVectors_[i][j];
+            if (m < 0) m = -m;
+            if (m > maxIndex_) maxIndex_ = m;
+         }
+      }
+      phases_.allocate(Dimension, 2*maxIndex_ + 1);
+   }
+
+   /*
+   * Compute powers exp(2 pi i m s_j) for one atom, by recursion in m.
+   */
+   void IntraStructureFactor::computePhases(const Vector& position) 
+   {
+      std::complex<double> factor;
+      int j, m;
+      for (j = 0; j < Dimension; ++j) {
+         factor = exp(2.0*Constants::Pi*position[j]*Constants::Im);
+         phases_(j, maxIndex_) = std::complex<double>(1.0, 0.0);
+         for (m = 1; m <= maxIndex_; ++m) {
+            phases_(j, maxIndex_ + m) = phases_(j, maxIndex_ + m - 1)*factor;
+            phases_(j, maxIndex_ - m) = std::conj(phases_(j, maxIndex_ + m));
+         }
+      }
+   }
+
    void IntraStructureFactor::output() 
    {
       double      value;
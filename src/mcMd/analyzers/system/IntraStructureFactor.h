@@ -209,8 +209,27 @@ namespace McMd
       /// Number of atom types, copied from Simulation::nAtomType().
       int  nAtomType_;
 
+      /**
+      * Find the maximum Miller index, and allocate phase factor table.
+      *
+      * Call after waveIntVectors_ is set.
+      */
+      void allocatePhases();
+
 
    private:
+
+      /**
+      * Powers of per-axis phase factors for one atom.
+      *
+      * Element (j, m + maxIndex_) is exp(2 pi i m s_j), where s_j is
+      * a generalized coordinate of the atom and m is a Miller index.
+      */
+      DMatrix< std::complex<double> >  phases_;
+
+      /// Maximum absolute value of any Miller index in waveIntVectors_.
+      int  maxIndex_;
+
       /// Has readParam been called?
       bool isInitialized_;
 
@@ -219,6 +238,13 @@ namespace McMd
       */
       void makeWaveVectors();
 
+      /**
+      * Compute the phases_ table for one atom.
+      *
+      * \param position atom position, in generalized coordinates
+      */
+      void computePhases(const Vector& position);
+
    };
 
    /*
@@ -182,6 +182,7 @@ namespace McMd
 
       nSample_ = 0;
 
+      allocatePhases();
       isInitialized_ = true;
    }
 
@@ -225,6 +226,7 @@ namespace McMd
       waveVectors_.allocate(nWave_);
       fourierModes_.allocate(nWave_, nAtomTypeIdPair_);
 
+      allocatePhases();
       isInitialized_ = true;
    }
 
@@ -11,6 +11,7 @@
 #include <mcMd/chemistry/Molecule.h>
 #include <mcMd/chemistry/Atom.h>
 #include <util/math/feq.h>
+#include <util/space/Dimension.h>
 #include <util/misc/FileMaster.h>
 #include <util/archives/Serializable_includes.h>
 
@@ -27,6 +28,11 @@ namespace McMd
    */
    RDF::RDF(System& system) 
     : SystemAnalyzer<System>(system),
+      nCells_(),
+      cellAtoms_(),
+      cellBegins_(),
+      atomCells_(),
+      threadHistograms_(),
       outputFile_(),
       accumulator_(),
       typeNumbers_(),
@@ -109,75 +115,218 @@ namespace McMd
       if (isAtInterval(iStep))  {
 
          accumulator_.beginSnapshot();
+         makeCells();
+         const Boundary& boundary = system().boundary();
+
+         // Allocate one partial histogram per thread
+         int nThread = system().simulation().nThread();
+         int i;
+         if (threadHistograms_.isAllocated()) {
+            if (threadHistograms_.capacity() != nThread) {
+               threadHistograms_.deallocate();
+            }
+         }
+         if (!threadHistograms_.isAllocated()) {
+            threadHistograms_.allocate(nThread);
+            for (i = 0; i < nThread; ++i) {
+               threadHistograms_[i].setParam(0.0, max_, nBin_);
+            }
+         }
 
-         System::ConstMoleculeIterator molIter1, molIter2;
-         Molecule::ConstAtomIterator   atomIter1, atomIter2;
-         Vector    r1, r2;
-         double    dRsq, dR;
-         Boundary* boundaryPtr;
-         int       iSpecies1, iSpecies2, nSpecies, i;
-   
-         for (i = 0; i < nAtomType_; ++i) {
-            typeNumbers_[i] = 0;
+         int nCell = cellBegins_.size() - 1;
+         if (nThread == 1) {
+            Distribution& histogram = threadHistograms_[0];
+            histogram.clear();
+            for (i = 0; i < nCell; ++i) {
+               sampleCell(i, boundary, histogram);
+            }
+         } else {
+            #ifdef MCMD_OPENMP
+            #pragma omp parallel num_threads(nThread)
+            #endif
+            {
+               Distribution& histogram 
+                    = threadHistograms_[Simulation::threadId()];
+               histogram.clear();
+               int m;
+               #ifdef MCMD_OPENMP
+               #pragma omp for schedule(static)
+               #endif
+               for (m = 0; m < nCell; ++m) {
+                  sampleCell(m, boundary, histogram);
+               }
+            }
+         }
+         for (i = 0; i < nThread; ++i) {
+            accumulator_.add(threadHistograms_[i]);
          }
 
-         boundaryPtr = &system().boundary();
-         nSpecies    = system().simulation().nSpecies();
+         // Increment normSum_
+         double number = 0;
+         for (i = 0; i < nAtomType_; ++i) {
+            number  += typeNumbers_[i];
+         }
+         normSum_ += number*number/boundary.volume();
 
-         // Loop over atom 1
-         for (iSpecies1 = 0; iSpecies1 < nSpecies; ++iSpecies1) {
-            system().begin(iSpecies1, molIter1); 
-            for ( ; molIter1.notEnd(); ++molIter1) {
-               molIter1->begin(atomIter1); 
-               for ( ; atomIter1.notEnd(); ++atomIter1) {
-                  r1 = atomIter1->position();
- 
-                  ++typeNumbers_[atomIter1->typeId()];
-  
-                  // Loop over atom 2 
-                  for (iSpecies2 = 0; iSpecies2 < nSpecies; ++iSpecies2) {
-                     system().begin(iSpecies2, molIter2); 
-                     for ( ; molIter2.notEnd(); ++molIter2) {
+      } // if isAtInterval
 
-                        //Check if molecules are the same  
-                        //if ( &(*molIter2) != &(*molIter1)) {
+   }
 
-                           molIter2->begin(atomIter2);
-                           for ( ; atomIter2.notEnd(); ++atomIter2) {
+   /*
+   * Build the cell grid, sort atoms by cell, and count atom types.
+   */
+   void RDF::makeCells()
+   {
+      const Boundary& boundary = system().boundary();
+      const Vector& lengths = boundary.lengths();
+      int nAtom = system().nAtom();
+      int i;
+
+      // Choose cells of length >= max_, but no more cells than atoms
+      double cellLength = max_;
+      int nCell;
+      for (;;) {
+         nCell = 1;
+         for (i = 0; i < Dimension; ++i) {
+            nCells_[i] = int(lengths[i]/cellLength);
+            if (nCells_[i] < 1) {
+               nCells_[i] = 1;
+            }
+            nCell *= nCells_[i];
+         }
+         if (nCell <= nAtom + 1) break;
+         cellLength *= 1.25;
+      }
 
-                              if (selector_.match(*atomIter1, *atomIter2)) {
-                                 r2 = atomIter2->position();
-   
-                                 dRsq = boundaryPtr->distanceSq(r1, r2);
-                                 dR   = sqrt(dRsq);
+      for (i = 0; i < nAtomType_; ++i) {
+         typeNumbers_[i] = 0;
+      }
 
-                                 accumulator_.sample(dR);
+      // Count atoms in each cell
+      System::ConstMoleculeIterator molIter;
+      Molecule::ConstAtomIterator   atomIter;
+      int nSpecies = system().simulation().nSpecies();
+      int iSpecies, j, cellId;
+      cellBegins_.resize(nCell + 1);
+      for (i = 0; i <= nCell; ++i) {
+         cellBegins_[i] = 0;
+      }
+      atomCells_.clear();
+      for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter); 
+         for ( ; molIter.notEnd(); ++molIter) {
+            molIter->begin(atomIter); 
+            for ( ; atomIter.notEnd(); ++atomIter) {
+               ++typeNumbers_[atomIter->typeId()];
+               const Vector& r = atomIter->position();
+               cellId = 0;
+               for (i = 0; i < Dimension; ++i) {
+                  j = int(r[i]*nCells_[i]/lengths[i]);
+                  if (j < 0) j = 0;
+                  if (j >= nCells_[i]) j = nCells_[i] - 1;
+                  cellId = cellId*nCells_[i] + j;
+               }
+               atomCells_.append(cellId);
+               ++cellBegins_[cellId + 1];
+            }
+         }
+      }
+      for (i = 0; i < nCell; ++i) {
+         cellBegins_[i + 1] += cellBegins_[i];
+      }
 
-                              }
-               
-                           }
+      // Sort atoms by cell, using cellBegins_ as a running end index
+      cellAtoms_.resize(atomCells_.size());
+      int k = 0;
+      for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter); 
+         for ( ; molIter.notEnd(); ++molIter) {
+            molIter->begin(atomIter); 
+            for ( ; atomIter.notEnd(); ++atomIter) {
+               cellId = atomCells_[k];
+               cellAtoms_[cellBegins_[cellId]] = atomIter.get();
+               ++cellBegins_[cellId];
+               ++k;
+            }
+         }
+      }
+      for (i = nCell; i > 0; --i) {
+         cellBegins_[i] = cellBegins_[i - 1];
+      }
+      cellBegins_[0] = 0;
+   }
 
-                        //}
+   /*
+   * Add pairs with a first atom in one cell to a histogram.
+   */
+   void RDF::sampleCell(int cellId, const Boundary& boundary,
+                        Distribution& histogram) const
+   {
+      double maxSq = max_*max_;
+
+      // Coordinates of this cell, and of neighboring cells along each
+      // axis. If there are fewer than 3 cells along an axis, include each
+      // cell along that axis once.
+      IntVector c;
+      int neighbors[Dimension][3];
+      int nNeighbor[Dimension];
+      int i, j, k, n;
+      n = cellId;
+      for (i = Dimension - 1; i >= 0; --i) {
+         c[i] = n % nCells_[i];
+         n /= nCells_[i];
+      }
+      for (i = 0; i < Dimension; ++i) {
+         if (nCells_[i] < 3) {
+            nNeighbor[i] = nCells_[i];
+            for (j = 0; j < nCells_[i]; ++j) {
+               neighbors[i][j] = j;
+            }
+         } else {
+            nNeighbor[i] = 3;
+            for (j = 0; j < 3; ++j) {
+               neighbors[i][j] = (c[i] + j - 1 + nCells_[i]) % nCells_[i];
+            }
+         }
+      }
 
+      const Atom* atom1Ptr;
+      const Atom* atom2Ptr;
+      double dRsq, dR;
+      int begin1 = cellBegins_[cellId];
+      int end1 = cellBegins_[cellId + 1];
+      int i0, i1, i2, otherId, begin2, end2, a1, a2;
+      for (i0 = 0; i0 < nNeighbor[0]; ++i0) {
+         for (i1 = 0; i1 < nNeighbor[1]; ++i1) {
+            for (i2 = 0; i2 < nNeighbor[2]; ++i2) {
+               otherId = neighbors[2][i2] + nCells_[2]*(neighbors[1][i1]
+                         + nCells_[1]*neighbors[0][i0]);
+               if (otherId < cellId) continue;
+               begin2 = cellBegins_[otherId];
+               end2 = cellBegins_[otherId + 1];
+               for (a1 = begin1; a1 < end1; ++a1) {
+                  atom1Ptr = cellAtoms_[a1];
+                  k = (otherId == cellId) ? a1 + 1 : begin2;
+                  for (a2 = k; a2 < end2; ++a2) {
+                     atom2Ptr = cellAtoms_[a2];
+                     dRsq = boundary.distanceSq(atom1Ptr->position(), 
+                                                atom2Ptr->position());
+                     if (dRsq < maxSq) {
+                        dR = sqrt(dRsq);
+                        if (selector_.match(*atom1Ptr, *atom2Ptr)) {
+                           histogram.sample(dR);
+                        }
+                        if (selector_.match(*atom2Ptr, *atom1Ptr)) {
+                           histogram.sample(dR);
+                        }
                      }
-                  } // for iSpecies2
-   
+                  }
                }
             }
-         } // for iSpecies1
-
-         // Increment normSum_
-         double number = 0;
-         for (i = 0; i < nAtomType_; ++i) {
-            number  += typeNumbers_[i];
          }
-         normSum_ += number*number/boundaryPtr->volume();
-
-      } // if isAtInterval
-
+      }
    }
 
-
    /// Output results to file after simulation is completed.
    void RDF::output() 
    {  
@@ -13,6 +13,8 @@
 #include <mcMd/analyzers/util/PairSelector.h>     // member
 #include <util/accumulators/RadialDistribution.h>   // member
 #include <util/containers/DArray.h>                 // member template
+#include <util/containers/GArray.h>                 // member template
+#include <util/space/IntVector.h>                   // member
 
 #include <util/global.h>
 
@@ -25,10 +27,14 @@ namespace McMd
    * RDF evaluates the atomic radial distribution function.
    *
    * This class evaluates a radial distribution function in real space,
-   * by making a histogram of particle pairs. The algorithm is expensive:
-   * It simply executes a double loop over particles, at a cost of order
-   * N^2. 
-   * 
+   * by making a histogram of particle pairs. Pairs are found using a 
+   * private cell list, with cells of length at least max, which is rebuilt
+   * for each sample. The cost of each sample is thus of order N at fixed
+   * density, rather than the N^2 cost of a double loop over particles.
+   * If Simulation::nThread() > 1, cells are divided among threads, each
+   * of which accumulates a private histogram. These partial histograms 
+   * are added to the accumulator at the end of each sample.
+   *
    * Different types of RDF may be calculated by setting a PairSelector
    * too specify which types of particles pairs should be accepted: The
    * user may specify atomic types for the two particles or accept all 
@@ -99,8 +105,28 @@ namespace McMd
       */
       virtual void output();
 
+      /**
+      * Get the RadialDistribution accumulator.
+      */
+      const RadialDistribution& accumulator() const;
+
    private:
 
+      /// Number of cells along each axis.
+      IntVector nCells_;
+
+      /// Pointers to all atoms, sorted by cell.
+      GArray<const Atom*> cellAtoms_;
+
+      /// Index in cellAtoms_ of first atom of each cell (size nCell + 1).
+      GArray<int> cellBegins_;
+
+      /// Cell index of each atom, in the order of iteration over atoms.
+      GArray<int> atomCells_;
+
+      /// Partial histograms, one per thread.
+      DArray<Distribution> threadHistograms_;
+
       // Output file stream
       std::ofstream outputFile_;
 
@@ -128,8 +154,34 @@ namespace McMd
       /// Is this initialized (Has readParam or loadParam been called?)
       bool    isInitialized_;
 
+      /**
+      * Build the cell grid, sort atoms by cell, and count atom types.
+      */
+      void makeCells();
+
+      /**
+      * Add pairs with a first atom in one cell to a histogram.
+      *
+      * Each pair of atoms is visited once, from the cell with the lower
+      * index, and is added once for each order that matches selector_.
+      *
+      * \param cellId  index of cell 
+      * \param boundary  periodic boundary of the parent system
+      * \param histogram  partial histogram for the calling thread
+      */
+      void sampleCell(int cellId, const Boundary& boundary,
+                      Distribution& histogram) const;
+
    };
 
+   // Inline member function
+
+   /*
+   * Get the RadialDistribution accumulator.
+   */
+   inline const RadialDistribution& RDF::accumulator() const
+   {  return accumulator_; }
+
    /*
    * Serialize to/from an archive. 
    */
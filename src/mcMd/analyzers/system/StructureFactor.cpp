@@ -9,11 +9,10 @@
 #include <mcMd/simulation/Simulation.h>
 #include <mcMd/simulation/McMd_mpi.h>
 #include <util/boundary/Boundary.h>
-#include <mcMd/chemistry/Molecule.h>
-#include <mcMd/chemistry/Atom.h>
 #include <util/math/Constants.h>
 #include <util/space/Dimension.h>
 #include <util/misc/FileMaster.h>
+#include <util/misc/Log.h>
 #include <util/archives/Serializable_includes.h>
 #include <util/misc/ioUtil.h>
 #include <util/format/Int.h>
@@ -30,6 +29,10 @@ namespace McMd
    StructureFactor::StructureFactor(System& system) 
     : SystemAnalyzer<System>(system),
       isFirstStep_(true),
+      mesh_(),
+      meshDimensions_(0),
+      meshOrder_(0),
+      hasMesh_(false),
       isInitialized_(false)
    {  setClassName("StructureFactor"); }
 
@@ -58,6 +61,8 @@ namespace McMd
       fourierModes_.allocate(nWave_, nMode_);
       structureFactors_.allocate(nWave_, nMode_);
 
+      readMesh(in);
+
       isInitialized_ = true;
    }
 
@@ -93,6 +98,8 @@ namespace McMd
       waveVectors_.allocate(nWave_);
       fourierModes_.allocate(nWave_, nMode_);
 
+      loadMesh(ar);
+
       isInitialized_ = true;
    }
 
@@ -100,7 +107,65 @@ namespace McMd
    * Save state to archive.
    */
    void StructureFactor::save(Serializable::OArchive& ar)
-   {  ar & *this; }
+   {
+      ar & *this;
+      saveMesh(ar);
+   }
+
+   /*
+   * Read optional mesh parameters.
+   */
+   void StructureFactor::readMesh(std::istream& in)
+   {
+      hasMesh_ = readOptional<IntVector>(in, "meshDimensions", 
+                                         meshDimensions_).isActive();
+      if (hasMesh_) {
+         read<int>(in, "meshOrder", meshOrder_);
+         setupMesh();
+      }
+   }
+
+   /*
+   * Load optional mesh parameters.
+   */
+   void StructureFactor::loadMesh(Serializable::IArchive& ar)
+   {
+      hasMesh_ = false;
+      if (ar.version() > 0) {
+         hasMesh_ = loadParameter<IntVector>(ar, "meshDimensions", 
+                                             meshDimensions_, false).isActive();
+      }
+      if (hasMesh_) {
+         loadParameter<int>(ar, "meshOrder", meshOrder_);
+         setupMesh();
+      }
+   }
+
+   /*
+   * Save optional mesh parameters.
+   */
+   void StructureFactor::saveMesh(Serializable::OArchive& ar)
+   {
+      Parameter::saveOptional(ar, meshDimensions_, hasMesh_);
+      if (hasMesh_) {
+         ar << meshOrder_;
+      }
+   }
+
+   /*
+   * Allocate the mesh, and check that all wavevectors are resolved.
+   */
+   void StructureFactor::setupMesh()
+   {
+      mesh_.setParam(meshDimensions_, meshOrder_, nAtomType_);
+      for (int i = 0; i < nWave_; ++i) {
+         if (!mesh_.isValidWave(waveIntVectors_[i])) {
+            Log::file() << "waveIntVector = " << waveIntVectors_[i] 
+                        << std::endl;
+            UTIL_THROW("Wavevector not resolved by mesh: need 2|m_j| < n_j");
+         }
+      }
+   }
 
    /*
    * Clear accumulators.
@@ -129,104 +194,143 @@ namespace McMd
    void StructureFactor::sample(long iStep) 
    {
       if (isAtInterval(iStep))  {
+         snapshot_.copy(system(), iStep);
+         sampleSnapshot(snapshot_);
+      }
+   }
 
-         std::ios_base::openmode mode = std::ios_base::out;
-         if (!isFirstStep_) {
-           mode = std::ios_base::out | std::ios_base::app; 
-         }
-         fileMaster().openOutputFile(outputFileName("_max.dat"), 
-                                     outputFile_, mode);
-
-         //fileMaster().openOutputFile(outputFileName("_max.dat"), 
-         //                            outputFile_, !isFirstStep_);
-         isFirstStep_ = false;
+   /* 
+   * Increment structure factors using a snapshot.
+   */
+   void StructureFactor::sampleSnapshot(const Snapshot& snapshot) 
+   {
+      std::ios_base::openmode mode = std::ios_base::out;
+      if (!isFirstStep_) {
+        mode = std::ios_base::out | std::ios_base::app; 
+      }
+      fileMaster().openOutputFile(outputFileName("_max.dat"), 
+                                  outputFile_, mode);
 
-         Vector position;
-         std::complex<double> expFactor;
-         double product;
-         System::ConstMoleculeIterator molIter;
-         Molecule::ConstAtomIterator atomIter;
-         int nSpecies, iSpecies, typeId, i, j;
+      //fileMaster().openOutputFile(outputFileName("_max.dat"), 
+      //                            outputFile_, !isFirstStep_);
+      isFirstStep_ = false;
 
-         makeWaveVectors();
+      int i, j;
+      makeWaveVectors(snapshot.boundary());
+      if (hasMesh_) {
+         computeMeshModes(snapshot);
+      } else {
+         computeExactModes(snapshot);
+      }
 
-         // Set all Fourier modes to zero
+      // Increment structure factors
+      double volume = snapshot.boundary().volume();
+      double norm;
+      for (j = 0; j < nMode_; ++j) {
+         double maxValue = 0.0;
+         double maxQ = 0.0;
+         IntVector maxIntVector;
          for (i = 0; i < nWave_; ++i) {
-            for (j = 0; j < nMode_; ++j) {
-               fourierModes_(i, j) = std::complex<double>(0.0, 0.0);
+            norm = std::norm(fourierModes_(i, j));
+            if (double(norm/volume) >= maxValue) {
+               maxValue = double(norm/volume);
+               maxIntVector = waveIntVectors_[i];
+               maxQ = waveVectors_[i].abs();
             }
+            structureFactors_(i, j) += norm/volume;
          }
- 
-         // Loop over all atoms
-         nSpecies = system().simulation().nSpecies();
-         for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
-            system().begin(iSpecies, molIter); 
-            for ( ; molIter.notEnd(); ++molIter) {
-               molIter->begin(atomIter); 
-               for ( ; atomIter.notEnd(); ++atomIter) {
-                  position = atomIter->position();
-                  typeId   = atomIter->typeId();
- 
-		  // Loop over wavevectors
-                  for (i = 0; i < nWave_; ++i) {
-               
-                     product = position.dot(waveVectors_[i]);
-                     expFactor = exp( product*Constants::Im );
-                     for (j = 0; j < nMode_; ++j) {
-                        fourierModes_(i, j) += modes_(j, typeId)*expFactor;
-                     }
-		 
-                  }
-  
-               }
-            }
 
-         }
+         // Output current maximum S(q)
+         outputFile_ << maxIntVector;
+         outputFile_ << Dbl(maxQ, 20, 8);
+         outputFile_ << Dbl(maxValue, 20, 8);
+         outputFile_ << std::endl;
+      }
+
+      ++nSample_;
 
-         // Increment structure factors
-         double volume = system().boundary().volume();
-         double norm;
+      outputFile_ << std::endl;
+      outputFile_.close();
+   }
+
+   /*
+   * Compute Fourier modes by an exact sum over atoms and wavevectors.
+   */
+   void StructureFactor::computeExactModes(const Snapshot& snapshot) 
+   {
+      std::complex<double> expFactor;
+      double product;
+      int nAtom, iAtom, typeId, i, j;
+
+      // Set all Fourier modes to zero
+      for (i = 0; i < nWave_; ++i) {
          for (j = 0; j < nMode_; ++j) {
-            double maxValue = 0.0;
-            double maxQ = 0.0;
-            IntVector maxIntVector;
-            for (i = 0; i < nWave_; ++i) {
-               norm = std::norm(fourierModes_(i, j));
-               if (double(norm/volume) >= maxValue) {
-                  maxValue = double(norm/volume);
-                  maxIntVector = waveIntVectors_[i];
-                  maxQ = waveVectors_[i].abs();
-               }
-               structureFactors_(i, j) += norm/volume;
-            }
+            fourierModes_(i, j) = std::complex<double>(0.0, 0.0);
+         }
+      }
 
-            // Output current maximum S(q)
-            outputFile_ << maxIntVector;
-            outputFile_ << Dbl(maxQ, 20, 8);
-            outputFile_ << Dbl(maxValue, 20, 8);
-            outputFile_ << std::endl;
+      // Loop over all atoms
+      nAtom = snapshot.nAtom();
+      for (iAtom = 0; iAtom < nAtom; ++iAtom) {
+         const Vector& position = snapshot.position(iAtom);
+         typeId = snapshot.typeId(iAtom);
+
+         // Loop over wavevectors
+         for (i = 0; i < nWave_; ++i) {
+            product = position.dot(waveVectors_[i]);
+            expFactor = exp( product*Constants::Im );
+            for (j = 0; j < nMode_; ++j) {
+               fourierModes_(i, j) += modes_(j, typeId)*expFactor;
+            }
          }
 
-         ++nSample_;
+      }
+   }
 
-         outputFile_ << std::endl;
-         outputFile_.close();
+   /*
+   * Compute Fourier modes from the Fourier transformed type densities.
+   */
+   void StructureFactor::computeMeshModes(const Snapshot& snapshot) 
+   {
+      Vector position;
+      int nAtom, iAtom, typeId, i, j;
+
+      // Assign atoms of each type to the corresponding field
+      const Boundary& boundary = snapshot.boundary();
+      mesh_.clear();
+      nAtom = snapshot.nAtom();
+      for (iAtom = 0; iAtom < nAtom; ++iAtom) {
+         boundary.transformCartToGen(snapshot.position(iAtom), position);
+         mesh_.spread(position, snapshot.typeId(iAtom));
       }
+      mesh_.transform();
 
+      // Project type amplitudes onto modes
+      std::complex<double> amplitude;
+      for (i = 0; i < nWave_; ++i) {
+         for (j = 0; j < nMode_; ++j) {
+            fourierModes_(i, j) = std::complex<double>(0.0, 0.0);
+         }
+         for (typeId = 0; typeId < nAtomType_; ++typeId) {
+            amplitude = mesh_.amplitude(typeId, waveIntVectors_[i]);
+            for (j = 0; j < nMode_; ++j) {
+               fourierModes_(i, j) += modes_(j, typeId)*amplitude;
+            }
+         }
+      }
    }
 
    /*
-   * Calculate floating point wavevectors, using current boundary.
+   * Calculate floating point wavevectors, using a boundary.
    */
-   void StructureFactor::makeWaveVectors() 
+   void StructureFactor::makeWaveVectors(const Boundary& boundary) 
    {
-      Boundary* boundaryPtr = &system().boundary();
       Vector  dWave;
       int  i, j;
       for (i = 0; i < nWave_; ++i) {
          waveVectors_[i] = Vector::Zero;
          for (j = 0; j < Dimension; ++j) {
-            dWave  = boundaryPtr->reciprocalBasisVector(j);
+            dWave  = boundary.reciprocalBasisVector(j);
             dWave *= waveIntVectors_[i][j];
             waveVectors_[i] += dWave;
          }
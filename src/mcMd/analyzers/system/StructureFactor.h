@@ -9,9 +9,11 @@
 */
 
 #include <mcMd/analyzers/SystemAnalyzer.h>    // base class template
+#include <mcMd/analyzers/Snapshot.h>          // member
 #include <mcMd/simulation/System.h>               // base class template parameter
 #include <util/containers/DMatrix.h>              // member template
 #include <util/containers/DArray.h>               // member template
+#include <util/space/ParticleMesh.h>              // member
 
 #include <util/global.h>
 
@@ -48,6 +50,19 @@ namespace McMd
    * an expansion of a reciprocal lattice wavevector as a sum of
    * recprocal lattice basis vectors for the periodic unit cell.
    *
+   * By default, Fourier amplitudes are computed by an exact sum over
+   * atoms for each wavevector, at a cost proportional to the product of
+   * the number of atoms and the number of wavevectors. If the optional
+   * meshDimensions and meshOrder parameters are present, the density of
+   * each atom type is instead assigned to a grid and Fourier transformed
+   * by a ParticleMesh, at a cost nearly independent of the number of 
+   * wavevectors. Each wavevector must then satisfy 2|m_j| < n_j, where
+   * m_j is a Miller index and n_j is the corresponding mesh dimension.
+   *
+   * This analyzer is snapshot-safe: Fourier amplitudes are computed from
+   * a Snapshot of the system, so sampling may be done by a background
+   * thread of the AnalyzerManager.
+   *
    * \sa \ref mcMd_analyzer_StructureFactor_page "parameter file format"
    * 
    * \ingroup McMd_Analyzer_McMd_Module
@@ -107,10 +122,26 @@ namespace McMd
       /**
       * Add particles to StructureFactor accumulators.
       *
+      * Copies the system into a private snapshot, and calls 
+      * sampleSnapshot().
+      *
       * \param iStep step counter
       */
       virtual void sample(long iStep);
 
+      /**
+      * Is this analyzer snapshot-safe? (returns true).
+      */
+      virtual bool isSnapshotSafe() const
+      {  return true; }
+
+      /**
+      * Add particles of a snapshot to StructureFactor accumulators.
+      *
+      * \param snapshot copy of the system configuration
+      */
+      virtual void sampleSnapshot(const Snapshot& snapshot);
+
       /**
       * Output results to predefined output file.
       */
@@ -168,16 +199,76 @@ namespace McMd
 
       /**
       * Update wavevectors.
+      *
+      * \param boundary periodic boundary
+      */
+      void makeWaveVectors(const Boundary& boundary);
+
+      /**
+      * Read optional mesh parameters, and set up the mesh if present.
+      *
+      * Call at the end of readParameters, after nAtomType_ and the
+      * waveIntVectors_ array are set.
+      *
+      * \param in input parameter stream
+      */
+      void readMesh(std::istream& in);
+
+      /**
+      * Load optional mesh parameters, and set up the mesh if present.
+      *
+      * \param ar loading (input) archive.
       */
-      void makeWaveVectors();
+      void loadMesh(Serializable::IArchive& ar);
+
+      /**
+      * Save optional mesh parameters.
+      *
+      * \param ar saving (output) archive.
+      */
+      void saveMesh(Serializable::OArchive& ar);
 
       /// Is this the first step?
       bool isFirstStep_;
 
    private:
 
+      /// Copy of the system, used by sample(long).
+      Snapshot snapshot_;
+
+      /// Particle mesh (used iff hasMesh_).
+      ParticleMesh mesh_;
+
+      /// Number of mesh points along each axis.
+      IntVector meshDimensions_;
+
+      /// Order of mesh assignment function.
+      int meshOrder_;
+
+      /// Are Fourier amplitudes computed on a mesh?
+      bool hasMesh_;
+
       /// Has readParam been called?
       bool isInitialized_;
+
+      /**
+      * Check wavevectors and set up the mesh.
+      */
+      void setupMesh();
+
+      /**
+      * Compute fourierModes_ by an exact sum over atoms.
+      *
+      * \param snapshot copy of the system configuration
+      */
+      void computeExactModes(const Snapshot& snapshot);
+
+      /**
+      * Compute fourierModes_ using the particle mesh.
+      *
+      * \param snapshot copy of the system configuration
+      */
+      void computeMeshModes(const Snapshot& snapshot);
    };
 
    /**
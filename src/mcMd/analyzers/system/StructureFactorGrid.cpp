@@ -226,6 +226,8 @@ namespace McMd
 
       nSample_ = 0;
 
+      readMesh(in);
+
       isInitialized_ = true;
    }
 
@@ -277,6 +279,8 @@ namespace McMd
       waveVectors_.allocate(nWave_);
       fourierModes_.allocate(nWave_, nMode_);
 
+      loadMesh(ar);
+
       isInitialized_ = true;
    }
 
@@ -284,12 +288,15 @@ namespace McMd
    * Save state to archive.
    */
    void StructureFactorGrid::save(Serializable::OArchive& ar)
-   {  ar & *this; }
+   {
+      ar & *this;
+      saveMesh(ar);
+   }
 
    void StructureFactorGrid::setup() 
    {}
 
-   void StructureFactorGrid::sample(long iStep)
+   void StructureFactorGrid::sampleSnapshot(const Snapshot& snapshot)
    {
 
       std::ios_base::openmode mode = std::ios_base::out;
@@ -300,10 +307,10 @@ namespace McMd
 
       // fileMaster().openOutputFile(outputFileName(".dat"), logFile_, !isFirstStep_);
 
-      StructureFactor::sample(iStep);
+      StructureFactor::sampleSnapshot(snapshot);
 
       // Log structure factors
-      double volume = system().boundary().volume();
+      double volume = snapshot.boundary().volume();
       double norm;
       for (int i = 0; i < nStar_; ++i) {
          int size = starSizes_[i];
@@ -119,11 +119,11 @@ namespace McMd
       virtual void output();
 
       /**
-      * Add particles to StructureFactor accumulators.
+      * Add particles of a snapshot to StructureFactor accumulators.
       *
-      * \param iStep step counter
+      * \param snapshot copy of the system configuration
       */
-      virtual void sample(long iStep);
+      virtual void sampleSnapshot(const Snapshot& snapshot);
 
    private:
 
@@ -9,8 +9,6 @@
 #include <mcMd/simulation/Simulation.h>
 #include <mcMd/simulation/McMd_mpi.h>
 #include <util/boundary/Boundary.h>
-#include <mcMd/chemistry/Molecule.h>
-#include <mcMd/chemistry/Atom.h>
 #include <util/math/Constants.h>
 #include <util/space/Dimension.h>
 #include <util/misc/FileMaster.h>
@@ -124,69 +122,62 @@ namespace McMd
    void VanHove::sample(long iStep) 
    {
       if (isAtInterval(iStep))  {
+         snapshot_.copy(system(), iStep);
+         sampleSnapshot(snapshot_);
+      }
+   }
 
-         Vector  position;
-         std::complex<double>  expFactor;
-         double  product, coeff;
-         System::ConstMoleculeIterator  molIter;
-         Molecule::ConstAtomIterator  atomIter;
-         int  nSpecies, iSpecies, i;
+   /*
+   * Add Fourier modes of a snapshot to autocorrelation accumulators.
+   */
+   void VanHove::sampleSnapshot(const Snapshot& snapshot) 
+   {
+      std::complex<double>  expFactor;
+      double  product, coeff;
+      int  nAtom, iAtom, i;
 
-         makeWaveVectors();
+      makeWaveVectors(snapshot.boundary());
 
-         // Set all Fourier modes to zero
-         for (i = 0; i < nWave_; ++i) {
-            fourierModes_[i] = std::complex<double>(0.0, 0.0);
-         }
- 
-         // Loop over all atoms to calculate Fourier modes
-         nSpecies = system().simulation().nSpecies();
-         for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
-            system().begin(iSpecies, molIter); 
-            for ( ; molIter.notEnd(); ++molIter) {
-               molIter->begin(atomIter); 
-               for ( ; atomIter.notEnd(); ++atomIter) {
-                  position = atomIter->position();
-                  coeff    = atomTypeCoeffs_[atomIter->typeId()];
- 
-		  // Loop over wavevectors
-                  for (i = 0; i < nWave_; ++i) {
-               
-                     product = position.dot(waveVectors_[i]);
-                     expFactor = exp( product*Constants::Im );
-                     fourierModes_[i] += (coeff*expFactor);
-		 
-                  }
-  
-               }
-            }
+      // Set all Fourier modes to zero
+      for (i = 0; i < nWave_; ++i) {
+         fourierModes_[i] = std::complex<double>(0.0, 0.0);
+      }
 
-         }
+      // Loop over all atoms to calculate Fourier modes
+      nAtom = snapshot.nAtom();
+      for (iAtom = 0; iAtom < nAtom; ++iAtom) {
+         const Vector& position = snapshot.position(iAtom);
+         coeff = atomTypeCoeffs_[snapshot.typeId(iAtom)];
 
-         // Add Fourier modes to autocorrelation accumulators
-         double sqrtV = sqrt(system().boundary().volume());
+         // Loop over wavevectors
          for (i = 0; i < nWave_; ++i) {
-            accumulators_[i].sample(fourierModes_[i]/sqrtV);
+            product = position.dot(waveVectors_[i]);
+            expFactor = exp( product*Constants::Im );
+            fourierModes_[i] += (coeff*expFactor);
          }
 
       }
 
+      // Add Fourier modes to autocorrelation accumulators
+      double sqrtV = sqrt(snapshot.boundary().volume());
+      for (i = 0; i < nWave_; ++i) {
+         accumulators_[i].sample(fourierModes_[i]/sqrtV);
+      }
    }
 
    /**
    * Calculate floating point wavevectors.
    */
-   void VanHove::makeWaveVectors() 
+   void VanHove::makeWaveVectors(const Boundary& boundary) 
    {
       Vector    dWave;
-      Boundary* boundaryPtr = &system().boundary();
       int       i, j;
 
       // Calculate wavevectors
       for (i = 0; i < nWave_; ++i) {
          waveVectors_[i] = Vector::Zero;
          for (j = 0; j < Dimension; ++j) {
-            dWave  = boundaryPtr->reciprocalBasisVector(j);
+            dWave  = boundary.reciprocalBasisVector(j);
             dWave *= waveIntVectors_[i][j];
             waveVectors_[i] += dWave;
          }
@@ -9,6 +9,7 @@
 */
 
 #include <mcMd/analyzers/SystemAnalyzer.h>  // base class template
+#include <mcMd/analyzers/Snapshot.h>        // member
 #include <mcMd/simulation/System.h>             // base class template parameter
 #include <util/containers/DArray.h>             // member template
 #include <util/accumulators/AutoCorr.h>         // member template parameter
@@ -70,6 +71,9 @@ namespace McMd
    * contains the 3 Miller indices of a wavevector, the absolute
    * magnitude of the wavevector, and a list of nAtomTypeIdPair structure 
    * factor values for the wavevector, one for each atomTypeId pair.
+   *
+   * This analyzer is snapshot-safe, and may thus be sampled by a 
+   * background thread of the AnalyzerManager.
    * 
    * \sa \ref mcMd_analyzer_VanHove_page "parameter file format"
    *
@@ -138,10 +142,26 @@ namespace McMd
       /**
       * Add particle pairs to VanHove histogram.
       *
+      * Copies the system into a private snapshot, and calls 
+      * sampleSnapshot().
+      *
       * \param iStep step counter
       */
       void sample(long iStep);
 
+      /**
+      * Is this analyzer snapshot-safe? (returns true).
+      */
+      virtual bool isSnapshotSafe() const
+      {  return true; }
+
+      /**
+      * Add Fourier modes of a snapshot to autocorrelation accumulators.
+      *
+      * \param snapshot copy of the system configuration
+      */
+      virtual void sampleSnapshot(const Snapshot& snapshot);
+
       /**
       * Output results to predefined output file.
       */
@@ -152,6 +172,9 @@ namespace McMd
       /// Output file stream.
       std::ofstream outputFile_;
 
+      /// Copy of the system, used by sample(long).
+      Snapshot snapshot_;
+
       /// Autocorrelation function accumulators.
       DArray< AutoCorr< std::complex<double>, std::complex<double> >  >
               accumulators_;
@@ -183,8 +206,8 @@ namespace McMd
       /// Has readParam been called?
       bool isInitialized_;
 
-      /// Update wavevectors.
-      void makeWaveVectors();
+      /// Update wavevectors, using a periodic boundary.
+      void makeWaveVectors(const Boundary& boundary);
 
    };
 
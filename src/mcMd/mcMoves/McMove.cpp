@@ -8,6 +8,7 @@
 #include "McMove.h"
 #include <mcMd/simulation/Simulation.h>
 #include <util/archives/Serializable_includes.h>
+#include <util/space/Vector.h>
 
 namespace McMd
 {
@@ -36,6 +37,34 @@ namespace McMd
    void McMove::readParameters(std::istream &in)
    {}
    
+   /*
+   * Generate an array of random unit vectors.
+   */
+   void McMove::randomUnitVectors(Vector* vectors, int n)
+   {
+      int nThread = simulation().nThread();
+      if (nThread == 1 || n < MinParallelVectors) {
+         for (int i = 0; i < n; ++i) {
+            random().unitVector(vectors[i]);
+         }
+      } else {
+         #ifdef MCMD_OPENMP
+         #pragma omp parallel num_threads(nThread)
+         #endif
+         {
+            Random& threadRandom = 
+                    simulation().threadRandom(Simulation::threadId());
+            int i;
+            #ifdef MCMD_OPENMP
+            #pragma omp for schedule(static)
+            #endif
+            for (i = 0; i < n; ++i) {
+               threadRandom.unitVector(vectors[i]);
+            }
+         }
+      }
+   }
+
    /*
    * Read the probability from file.
    */
@@ -80,6 +109,33 @@ namespace McMd
       return false; 
    }
 
+   /*
+   * Default implementation - no step size.
+   */
+   bool McMove::hasStepSize() const
+   {  return false; }
+
+   /*
+   * Default implementation - throws an Exception.
+   */
+   double McMove::stepSize() const
+   {
+      UTIL_THROW("McMove has no step size");
+      return 0.0;
+   }
+
+   /*
+   * Default implementation - throws an Exception.
+   */
+   void McMove::setStepSize(double stepSize)
+   {  UTIL_THROW("McMove has no step size"); }
+
+   /*
+   * Default implementation - energy changes are not reported.
+   */
+   bool McMove::tracksEnergy() const
+   {  return false; }
+
    /*
    * Trivial default implementation - do nothing
    */
@@ -10,8 +10,13 @@
 
 #include <util/param/ParamComposite.h>
 #include <util/random/Random.h>
+#ifdef MCMD_PROFILE
+#include <mcMd/mcMoves/McMoveProfile.h>
+#endif
 #include <util/global.h>
 
+namespace Util { class Vector; }
+
 namespace McMd
 {
 
@@ -101,6 +106,45 @@ namespace McMd
       */
       virtual bool move();
 
+      /**
+      * Does this move have a step size that may be tuned?
+      *
+      * A step size is a continuous parameter, such as a maximum
+      * displacement, that controls the acceptance rate of the move.
+      * Subclasses that return true must also override stepSize() and
+      * setStepSize(). The default implementation returns false.
+      */
+      virtual bool hasStepSize() const;
+
+      /**
+      * Get the step size.
+      *
+      * The default implementation throws an Exception.
+      */
+      virtual double stepSize() const;
+
+      /**
+      * Set the step size.
+      *
+      * Implementations may impose an upper bound on the step size.
+      * The default implementation throws an Exception.
+      *
+      * \param stepSize new value of the step size
+      */
+      virtual void setStepSize(double stepSize);
+
+      /**
+      * Does this move report the energy change of accepted moves?
+      *
+      * A subclass that returns true must call
+      * McSystem::shiftPotentialEnergy() with the change in the total
+      * potential energy whenever move() changes the configuration.
+      * The McMoveManager discards the cached potential energy of the
+      * McSystem after any accepted move for which this returns false.
+      * The default implementation returns false.
+      */
+      virtual bool tracksEnergy() const;
+
       // Accessor Functions
 
       /**
@@ -118,11 +162,32 @@ namespace McMd
       */
       long nAccept() const;
 
+      /**
+      * Set the numbers of attempted and accepted moves.
+      *
+      * Used by McMoveManager::tune() to restore the statistics of a
+      * run, so that attempts made while tuning are not counted.
+      *
+      * \param nAttempt number of attempted moves
+      * \param nAccept  number of accepted moves
+      */
+      void setStatistics(long nAttempt, long nAccept);
+
       /**
       * Output statistics for this move (called at the end of the simulation)
       */
       virtual void output();
 
+      #ifdef MCMD_PROFILE
+      /**
+      * Get the accumulated cost of calls to move().
+      *
+      * Defined only if MCMD_PROFILE is defined. The profile is filled
+      * by McMoveManager::move().
+      */
+      McMoveProfile& profile();
+      #endif
+
    protected:
 
       /**
@@ -150,6 +215,32 @@ namespace McMd
       */
       void readProbability(std::istream& in);
 
+      /**
+      * Generate an array of random unit vectors.
+      *
+      * If the parent Simulation uses a single thread, or if n is less 
+      * than MinParallelVectors, vectors are drawn in order from random().
+      * Otherwise, the array is divided into contiguous blocks, one per
+      * thread, and the vectors of each block are drawn from the generator
+      * of the corresponding thread. The result is thus reproducible for
+      * a given seed and thread count.
+      *
+      * \param vectors  array of n unit vectors (output)
+      * \param n        number of vectors
+      */
+      void randomUnitVectors(Vector* vectors, int n);
+
+      /**
+      * Minimum number of vectors generated in parallel.
+      *
+      * Smaller arrays are generated by one thread, since the cost of
+      * starting a parallel region would exceed the time saved. This is
+      * well below the typical number of configuration bias trials, so
+      * that the trial bond vectors of CfbEndBase and CfbLinear moves are
+      * generated in parallel.
+      */
+      static const int MinParallelVectors = 8;
+
    private:
 
       /// Pointer to parent Simulation object
@@ -167,6 +258,11 @@ namespace McMd
       /// Number of moves that have been accepted by this object.
       long  nAccept_;
 
+      #ifdef MCMD_PROFILE
+      /// Accumulated cost of calls to move().
+      McMoveProfile profile_;
+      #endif
+
    };
 
    // Public inline methods
@@ -183,6 +279,23 @@ namespace McMd
    inline long McMove::nAccept() const
    {  return nAccept_; }
 
+   /*
+   * Set the numbers of attempted and accepted moves.
+   */
+   inline void McMove::setStatistics(long nAttempt, long nAccept)
+   {
+      nAttempt_ = nAttempt;
+      nAccept_ = nAccept;
+   }
+
+   #ifdef MCMD_PROFILE
+   /*
+   * Get the accumulated cost of calls to move().
+   */
+   inline McMoveProfile& McMove::profile()
+   {  return profile_; }
+   #endif
+
    // Protected inline methods
 
    /*
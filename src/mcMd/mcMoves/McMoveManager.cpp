@@ -9,6 +9,22 @@
 #include <mcMd/mcMoves/McMoveManager.h>
 #include <mcMd/mcMoves/McMoveFactory.h>
 #include <mcMd/mcSimulation/McSimulation.h>
+#include <mcMd/mcSimulation/McSystem.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/boundary/Boundary.h>
+#include <util/space/Vector.h>
+#include <util/misc/Timer.h>
+#include <util/misc/Log.h>
+#include <util/format/Str.h>
+#include <util/format/Dbl.h>
+
+#ifdef MCMD_PROFILE
+#ifndef INTER_NOPAIR
+#include <mcMd/potentials/pair/McPairPotential.h>
+#endif
+#include <iomanip>
+#endif
 
 #include <util/random/Random.h>
 
@@ -23,6 +39,9 @@ namespace McMd
      simulationPtr_(&simulation),
      systemPtr_(&simulation.system()),
      randomPtr_(&simulation.random())
+     #ifdef MCMD_PROFILE
+     , profileCountdown_(0)
+     #endif
    {  setClassName("McMoveManager"); }
 
    // Destructor
@@ -83,7 +102,14 @@ namespace McMd
    {
       for (int iMove = 0; iMove < size(); ++iMove) {
          (*this)[iMove].setup();
+         #ifdef MCMD_PROFILE
+         (*this)[iMove].profile().clear();
+         #endif
       }
+      #ifdef MCMD_PROFILE
+      perfEvents_.open();
+      profileCountdown_ = 0;
+      #endif
    }
 
    /*
@@ -96,6 +122,256 @@ namespace McMd
       return (*this)[iMove];
    }
 
+   /*
+   * Choose a McMove at random, and attempt it.
+   */
+   bool McMoveManager::move()
+   {
+      McMove& move = chooseMove();
+      #ifndef MCMD_PROFILE
+      bool accept = move.move();
+      #else
+      bool accept;
+      if (profileCountdown_ > 0) {
+         --profileCountdown_;
+         accept = move.move();
+         move.profile().count();
+      } else {
+         // Sample one attempt in each batch of ProfileInterval
+         profileCountdown_ = ProfileInterval - 1;
+         McMoveProfile::Sample begin, end;
+         Timer timer;
+         readCounters(move, begin);
+         timer.start();
+         accept = move.move();
+         timer.stop();
+         readCounters(move, end);
+         begin[McMoveProfile::Time] = 0.0;
+         end[McMoveProfile::Time] = timer.time();
+         move.profile().add(begin, end);
+      }
+      #endif
+
+      // Discard cached values invalidated by an accepted move
+      if (accept) {
+         if (!move.tracksEnergy()) {
+            systemPtr_->unsetPotentialEnergy();
+         }
+         systemPtr_->unsetVirialStress();
+      }
+      return accept;
+   }
+
+   /*
+   * Tune step sizes and probabilities.
+   */
+   void McMoveManager::tune(int nStep, int interval, double acceptRatio,
+                            double maxWeightRatio)
+   {
+      if (nStep <= 0) {
+         UTIL_THROW("nStep <= 0");
+      }
+      if (interval <= 0) {
+         UTIL_THROW("interval <= 0");
+      }
+      if (acceptRatio <= 0.0 || acceptRatio >= 1.0) {
+         UTIL_THROW("acceptRatio must be between 0 and 1");
+      }
+      if (maxWeightRatio < 1.0) {
+         UTIL_THROW("maxWeightRatio < 1");
+      }
+
+      // Per-move accumulators
+      int nMove = size();
+      DArray<double> times;
+      DArray<double> msds;
+      DArray<long> nTimes;
+      DArray<long> nMsds;
+      DArray<long> nAttempts;
+      DArray<long> nAccepts;
+      times.allocate(nMove);
+      msds.allocate(nMove);
+      nTimes.allocate(nMove);
+      nMsds.allocate(nMove);
+      nAttempts.allocate(nMove);
+      nAccepts.allocate(nMove);
+
+      // Statistics of the current run, restored after tuning. Moves are
+      // set up individually, so that move profiles are also unchanged.
+      DArray<long> runAttempts;
+      DArray<long> runAccepts;
+      runAttempts.allocate(nMove);
+      runAccepts.allocate(nMove);
+      int iMove;
+      for (iMove = 0; iMove < nMove; ++iMove) {
+         runAttempts[iMove] = (*this)[iMove].nAttempt();
+         runAccepts[iMove] = (*this)[iMove].nAccept();
+         (*this)[iMove].setup();
+      }
+
+      for (iMove = 0; iMove < nMove; ++iMove) {
+         times[iMove] = 0.0;
+         msds[iMove] = 0.0;
+         nTimes[iMove] = 0;
+         nMsds[iMove] = 0;
+         nAttempts[iMove] = (*this)[iMove].nAttempt();
+         nAccepts[iMove] = (*this)[iMove].nAccept();
+      }
+
+      // Measure displacements on one step in every stride. Copying 
+      // positions costs roughly as much as 32 single atom moves.
+      DArray<Vector> positions;
+      positions.allocate(simulationPtr_->atomCapacity());
+      int stride = 1 + systemPtr_->nAtom()/32;
+
+      McMove* movePtr;
+      Timer timer;
+      double ratio, factor;
+      long nAttempt, nAccept;
+      bool isSampled;
+      for (int iStep = 0; iStep < nStep; ++iStep) {
+
+         iMove = randomPtr_->drawFrom(&probabilities_[0], nMove);
+         movePtr = &(*this)[iMove];
+         isSampled = (iStep % stride == 0);
+         if (isSampled) {
+            savePositions(positions);
+         }
+         timer.clear();
+         timer.start();
+         movePtr->move();
+         timer.stop();
+         times[iMove] += timer.time();
+         ++nTimes[iMove];
+         if (isSampled) {
+            msds[iMove] += displacementSq(positions);
+            ++nMsds[iMove];
+         }
+
+         // Adjust step sizes toward the target acceptance ratio
+         if ((iStep + 1) % interval == 0) {
+            for (iMove = 0; iMove < nMove; ++iMove) {
+               movePtr = &(*this)[iMove];
+               nAttempt = movePtr->nAttempt() - nAttempts[iMove];
+               nAccept = movePtr->nAccept() - nAccepts[iMove];
+               if (movePtr->hasStepSize() && nAttempt > 0) {
+                  ratio = double(nAccept)/double(nAttempt);
+                  factor = ratio/acceptRatio;
+                  if (factor < 0.5) factor = 0.5;
+                  if (factor > 2.0) factor = 2.0;
+                  movePtr->setStepSize(factor*movePtr->stepSize());
+               }
+               nAttempts[iMove] = movePtr->nAttempt();
+               nAccepts[iMove] = movePtr->nAccept();
+            }
+         }
+
+      }
+      systemPtr_->unsetPotentialEnergy();
+      systemPtr_->unsetVirialStress();
+      for (iMove = 0; iMove < nMove; ++iMove) {
+         (*this)[iMove].setStatistics(runAttempts[iMove], runAccepts[iMove]);
+      }
+
+      // Compute mean-squared displacement per CPU second for each move
+      DArray<double> efficiencies;
+      efficiencies.allocate(nMove);
+      double average = 0.0;
+      double norm = 0.0;
+      for (iMove = 0; iMove < nMove; ++iMove) {
+         efficiencies[iMove] = -1.0;
+         if (nMsds[iMove] > 0 && times[iMove] > 0.0) {
+            efficiencies[iMove] = (msds[iMove]/double(nMsds[iMove]))
+                                / (times[iMove]/double(nTimes[iMove]));
+            average += probabilities_[iMove]*efficiencies[iMove];
+            norm += probabilities_[iMove];
+         }
+      }
+
+      // Reweight probabilities. Moves without data are unchanged.
+      if (maxWeightRatio > 1.0 && average > 0.0) {
+         average = average/norm;
+         double total = 0.0;
+         for (iMove = 0; iMove < nMove; ++iMove) {
+            if (efficiencies[iMove] >= 0.0) {
+               factor = efficiencies[iMove]/average;
+               if (factor < 1.0/maxWeightRatio) factor = 1.0/maxWeightRatio;
+               if (factor > maxWeightRatio) factor = maxWeightRatio;
+               probabilities_[iMove] *= factor;
+            }
+            total += probabilities_[iMove];
+         }
+         for (iMove = 0; iMove < nMove; ++iMove) {
+            probabilities_[iMove] = probabilities_[iMove]/total;
+            (*this)[iMove].setProbability(probabilities_[iMove]);
+         }
+      }
+
+      // Output tuned parameters
+      Log::file() << std::endl;
+      Log::file() << "Tuned Moves:" << std::endl << std::endl;
+      Log::file() << Str("Move Name", 32) << Str("Probability", 20)
+                  << Str("StepSize", 20) << Str("Msd / CPU sec", 20)
+                  << std::endl;
+      for (iMove = 0; iMove < nMove; ++iMove) {
+         movePtr = &(*this)[iMove];
+         Log::file() << Str(className(iMove), 32)
+                     << Dbl(probabilities_[iMove]);
+         if (movePtr->hasStepSize()) {
+            Log::file() << Dbl(movePtr->stepSize());
+         } else {
+            Log::file() << Str("-", 20);
+         }
+         if (efficiencies[iMove] >= 0.0) {
+            Log::file() << Dbl(efficiencies[iMove]);
+         } else {
+            Log::file() << Str("-", 20);
+         }
+         Log::file() << std::endl;
+      }
+      Log::file() << std::endl;
+   }
+
+   /*
+   * Copy positions of all atoms, indexed by atom id.
+   */
+   void McMoveManager::savePositions(DArray<Vector>& positions)
+   {
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      int nSpecies = simulationPtr_->nSpecies();
+      for (int iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         systemPtr_->begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               positions[atomIter->id()] = atomIter->position();
+            }
+         }
+      }
+   }
+
+   /*
+   * Return sum of squared atomic displacements since savePositions().
+   */
+   double McMoveManager::displacementSq(const DArray<Vector>& positions)
+   {
+      const Boundary& boundary = systemPtr_->boundary();
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      double sum = 0.0;
+      int nSpecies = simulationPtr_->nSpecies();
+      for (int iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         systemPtr_->begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               sum += boundary.distanceSq(atomIter->position(), 
+                                          positions[atomIter->id()]);
+            }
+         }
+      }
+      return sum;
+   }
+
    /*
    * Output statistics for every move.
    */
@@ -104,6 +380,130 @@ namespace McMd
       for (int i=0; i< size(); i++) {
          (*this)[i].output();
       }
+      #ifdef MCMD_PROFILE
+      outputProfile(Log::file());
+      #endif
+   }
+
+   #ifdef MCMD_PROFILE
+   /*
+   * Read all profile counters except time.
+   */
+   void 
+   McMoveManager::readCounters(McMove& move, McMoveProfile::Sample& sample)
+   {
+      // Hardware counters are stored contiguously, in PerfEvents order
+      perfEvents_.read(&sample[McMoveProfile::Cycles]);
+      sample[McMoveProfile::NAttempt] = double(move.nAttempt());
+      sample[McMoveProfile::NAccept] = double(move.nAccept());
+      #ifndef INTER_NOPAIR
+      const McPairPotential& pair = systemPtr_->pairPotential();
+      sample[McMoveProfile::NEnergy] = pair.nEnergy();
+      sample[McMoveProfile::NNeighbor] = pair.nNeighbor();
+      sample[McMoveProfile::NCellUpdate] = pair.nCellUpdate();
+      #else
+      sample[McMoveProfile::NEnergy] = 0.0;
+      sample[McMoveProfile::NNeighbor] = 0.0;
+      sample[McMoveProfile::NCellUpdate] = 0.0;
+      #endif
+   }
+
+   /*
+   * Write a table of the costs of all moves.
+   */
+   void McMoveManager::outputProfile(std::ostream& out)
+   {
+      int nMove = size();
+      int iMove, i;
+      double total = 0.0;
+      for (iMove = 0; iMove < nMove; ++iMove) {
+         total += (*this)[iMove].profile().estimate(McMoveProfile::Time);
+      }
+
+      // Times are in seconds, counts are per sampled attempt. Shares of
+      // the total time are estimated from all attempts.
+      out << std::endl;
+      out << "Move Profile:" << std::endl << std::endl;
+      out << std::setw(32) << std::left << "Move Name" << std::right
+          << std::setw(9) << "time(%)"
+          << std::setw(14) << "time/attempt"
+          << std::setw(14) << "time/accept"
+          << std::setw(14) << "attempts/sec"
+          << std::setw(14) << "energies"
+          << std::setw(14) << "neighbors"
+          << std::setw(14) << "cellUpdates"
+          << std::endl;
+      McMoveProfile* profilePtr;
+      double time, nAttempt, nAccept;
+      for (iMove = 0; iMove < nMove; ++iMove) {
+         profilePtr = &(*this)[iMove].profile();
+         time = profilePtr->total(McMoveProfile::Time);
+         nAttempt = profilePtr->total(McMoveProfile::NAttempt);
+         nAccept = profilePtr->total(McMoveProfile::NAccept);
+         out << std::setw(32) << std::left << className(iMove) 
+             << std::right
+             << std::setw(9) << std::fixed << std::setprecision(2)
+             << (total > 0.0 ? 
+                 100.0*profilePtr->estimate(McMoveProfile::Time)/total : 0.0);
+         out.unsetf(std::ios::floatfield);
+         if (nAttempt > 0.0) {
+            out << Dbl(time/nAttempt, 14, 4);
+         } else {
+            out << std::setw(14) << "-";
+         }
+         if (nAccept > 0.0) {
+            out << Dbl(time/nAccept, 14, 4);
+         } else {
+            out << std::setw(14) << "-";
+         }
+         if (time > 0.0) {
+            out << Dbl(nAttempt/time, 14, 4);
+         } else {
+            out << std::setw(14) << "-";
+         }
+         for (i = McMoveProfile::NEnergy; i <= McMoveProfile::NCellUpdate;
+              ++i) {
+            if (nAttempt > 0.0) {
+               out << Dbl(profilePtr->total(McMoveProfile::Counter(i))
+                          /nAttempt, 14, 4);
+            } else {
+               out << std::setw(14) << "-";
+            }
+         }
+         out << std::endl;
+      }
+      out << std::endl;
+
+      // Hardware event counts per attempt, if available
+      if (perfEvents_.isOpen()) {
+         out << "Hardware events per attempt (main thread only):" 
+             << std::endl << std::endl;
+         out << std::setw(32) << std::left << "Move Name" << std::right;
+         for (i = 0; i < PerfEvents::NEvent; ++i) {
+            out << std::setw(14) << PerfEvents::name(PerfEvents::Event(i));
+         }
+         out << std::endl;
+         for (iMove = 0; iMove < nMove; ++iMove) {
+            profilePtr = &(*this)[iMove].profile();
+            nAttempt = profilePtr->total(McMoveProfile::NAttempt);
+            out << std::setw(32) << std::left << className(iMove)
+                << std::right;
+            for (i = 0; i < PerfEvents::NEvent; ++i) {
+               if (nAttempt > 0.0) {
+                  out << Dbl(profilePtr->total(
+                             McMoveProfile::Counter(McMoveProfile::Cycles + i))
+                             /nAttempt, 14, 4);
+               } else {
+                  out << std::setw(14) << "-";
+               }
+            }
+            out << std::endl;
+         }
+      } else {
+         out << "Hardware event counters are not available" << std::endl;
+      }
+      out << std::endl;
    }
+   #endif
 
 }
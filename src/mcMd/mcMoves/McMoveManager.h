@@ -11,8 +11,11 @@
 #include <util/param/Manager.h>          // base class template
 #include "McMove.h"                      // base class template parameter
 #include <util/containers/DArray.h>      // member template
+#ifdef MCMD_PROFILE
+#include <util/misc/PerfEvents.h>        // member
+#endif
 
-namespace Util { class Random; }
+namespace Util { class Random; class Vector; }
 
 namespace McMd
 {
@@ -80,6 +83,28 @@ namespace McMd
       */
       McMove& chooseMove();
 
+      /**
+      * Choose an McMove at random, and attempt it.
+      *
+      * If MCMD_PROFILE is defined, every call is counted by the 
+      * McMoveProfile of the chosen move, but profile counters are read 
+      * only once per batch of ProfileInterval calls, just before and
+      * after one attempt. The wall clock time, the work done by the 
+      * McPairPotential and hardware event counts (if available) of this
+      * sampled attempt are added to the profile of its move. Because the
+      * choice of move is random and independent of the position in the
+      * batch, sampled attempts of each move are an unbiased subset of 
+      * all its attempts. Hardware events are counted for the main 
+      * thread only (see Util::PerfEvents).
+      *
+      * If the move is accepted, the cached virial stress of the McSystem
+      * is discarded, as is the cached potential energy unless the move
+      * tracks energy changes (see McMove::tracksEnergy()).
+      *
+      * \return true if the move was accepted, false otherwise
+      */
+      bool move();
+
       /**
       * Return probability of move i.
       *
@@ -88,8 +113,44 @@ namespace McMd
       */
       double probability(int i) const;
 
+      /**
+      * Tune step sizes and move probabilities during equilibration.
+      *
+      * Performs nStep Monte Carlo steps, with no analyzers or restart 
+      * output. After every interval steps, the step size of each move 
+      * for which McMove::hasStepSize() is true is multiplied by the
+      * ratio of its acceptance rate during the interval to the target
+      * acceptRatio, limited to the range [1/2, 2].
+      *
+      * The CPU time of each attempted move is measured, as is the 
+      * mean-squared atomic displacement that it produces, using a 
+      * subset of attempts chosen so that copying positions does not
+      * dominate the run time. At the end, the probability of each move
+      * is multiplied by the ratio of its displacement per CPU second to
+      * the probability weighted average over all moves, limited to the
+      * range [1/maxWeightRatio, maxWeightRatio], and the probabilities 
+      * are renormalized. If maxWeightRatio = 1, probabilities are left 
+      * unchanged.
+      *
+      * Tuned values are retained by subsequent simulations, are saved 
+      * to restart files, and are output by writeParam(). Attempts made
+      * while tuning are not included in the statistics of any move:
+      * the numbers of attempted and accepted moves, and move profiles,
+      * are left as they were before tuning.
+      *
+      * \param nStep          number of steps
+      * \param interval       number of steps between step size updates
+      * \param acceptRatio    target acceptance ratio, 0 < acceptRatio < 1
+      * \param maxWeightRatio maximum change factor for probabilities
+      */
+      void tune(int nStep, int interval, double acceptRatio, 
+                double maxWeightRatio);
+
       /**
       * Output statistics for all moves.
+      *
+      * If MCMD_PROFILE is defined, also writes a table of the costs of
+      * all moves to the log file.
       */
       void output();
 
@@ -107,6 +168,46 @@ namespace McMd
       /// Pointer to random number generator.
       Random* randomPtr_;
 
+      /**
+      * Copy positions of all atoms into an array indexed by atom id.
+      *
+      * \param positions array of atom positions (output)
+      */
+      void savePositions(DArray<Vector>& positions);
+
+      /**
+      * Return sum of squared atomic displacements since savePositions().
+      *
+      * \param positions array of atom positions (input)
+      */
+      double displacementSq(const DArray<Vector>& positions);
+
+      #ifdef MCMD_PROFILE
+      /// Number of calls to move() per sampled call.
+      static const int ProfileInterval = 16;
+
+      /// Hardware event counters for the main thread.
+      PerfEvents perfEvents_;
+
+      /// Number of calls to move() before the next sampled call.
+      int profileCountdown_;
+
+      /**
+      * Read all profile counters except time.
+      *
+      * \param move   McMove of interest
+      * \param sample array of counter values (output)
+      */
+      void readCounters(McMove& move, McMoveProfile::Sample& sample);
+
+      /**
+      * Write a table of the costs of all moves.
+      *
+      * \param out output stream
+      */
+      void outputProfile(std::ostream& out);
+      #endif
+
       /// Return pointer to a new McMoveFactory.
       virtual Factory<McMove>* newDefaultFactory() const;
 
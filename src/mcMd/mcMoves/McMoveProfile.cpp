@@ -0,0 +1,57 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "McMoveProfile.h"
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   McMoveProfile::McMoveProfile()
+    : totals_(),
+      nCall_(0),
+      nSample_(0)
+   {  clear(); }
+
+   /*
+   * Set all accumulated values to zero.
+   */
+   void McMoveProfile::clear()
+   {
+      for (int i = 0; i < NCounter; ++i) {
+         totals_[i] = 0.0;
+      }
+      nCall_ = 0;
+      nSample_ = 0;
+   }
+
+   /*
+   * Count one sampled call to move(), and add its cost.
+   */
+   void McMoveProfile::add(const Sample& begin, const Sample& end)
+   {
+      for (int i = 0; i < NCounter; ++i) {
+         totals_[i] += end[i] - begin[i];
+      }
+      ++nCall_;
+      ++nSample_;
+   }
+
+   /*
+   * Estimate the total value of one counter over all calls.
+   */
+   double McMoveProfile::estimate(Counter counter) const
+   {
+      if (nSample_ == 0) return 0.0;
+      return totals_[counter]*double(nCall_)/double(nSample_);
+   }
+
+}
@@ -0,0 +1,140 @@
+#ifndef MCMD_MC_MOVE_PROFILE_H
+#define MCMD_MC_MOVE_PROFILE_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/FArray.h>      // member template
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * Accumulated cost of the calls to move() of one McMove.
+   *
+   * An McMoveProfile counts all calls to McMove::move(), and accumulates
+   * the differences between values of a set of counters read just before
+   * and just after a sampled subset of these calls. Values of the counters
+   * are stored in an array of NCounter double precision numbers, indexed 
+   * by the Counter enum. The Cycles, CacheMisses and BranchMisses counters
+   * are hardware counters that are zero if these are unavailable.
+   *
+   * \ingroup McMd_McMove_Module
+   */
+   class McMoveProfile
+   {
+
+   public:
+
+      /**
+      * Identifiers for counters.
+      */
+      enum Counter {Time, NAttempt, NAccept, NEnergy, NNeighbor, 
+                    NCellUpdate, Cycles, CacheMisses, BranchMisses, 
+                    NCounter};
+
+      /**
+      * Array of values of all counters.
+      */
+      typedef FArray<double, NCounter> Sample;
+
+      /**
+      * Constructor.
+      */
+      McMoveProfile();
+
+      /**
+      * Set all accumulated values to zero.
+      */
+      void clear();
+
+      /**
+      * Count one call to move() that is not sampled.
+      */
+      void count();
+
+      /**
+      * Count one sampled call to move(), and add its cost.
+      *
+      * \param begin values of counters just before the call
+      * \param end   values of counters just after the call
+      */
+      void add(const Sample& begin, const Sample& end);
+
+      /**
+      * Get the total accumulated value of one counter.
+      *
+      * This is the total over sampled calls only.
+      *
+      * \param counter counter identifier
+      */
+      double total(Counter counter) const;
+
+      /**
+      * Get an estimate of the total value of one counter over all calls.
+      *
+      * Returns total(counter)*nCall()/nSample(), or zero if no calls 
+      * have been sampled.
+      *
+      * \param counter counter identifier
+      */
+      double estimate(Counter counter) const;
+
+      /**
+      * Get the number of calls to move().
+      */
+      long nCall() const;
+
+      /**
+      * Get the number of sampled calls to move().
+      */
+      long nSample() const;
+
+   private:
+
+      /// Accumulated values of counters for sampled calls.
+      Sample totals_;
+
+      /// Number of calls.
+      long nCall_;
+
+      /// Number of sampled calls.
+      long nSample_;
+
+   };
+
+   // Inline functions
+
+   /*
+   * Get the total accumulated value of one counter.
+   */
+   inline double McMoveProfile::total(Counter counter) const
+   {  return totals_[counter]; }
+
+   /*
+   * Get the number of calls to move().
+   */
+   inline long McMoveProfile::nCall() const
+   {  return nCall_; }
+
+   /*
+   * Get the number of sampled calls to move().
+   */
+   inline long McMoveProfile::nSample() const
+   {  return nSample_; }
+
+   /*
+   * Count one call to move() that is not sampled.
+   */
+   inline void McMoveProfile::count()
+   {  ++nCall_; }
+
+}
+#endif
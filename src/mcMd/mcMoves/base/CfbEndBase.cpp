@@ -61,19 +61,34 @@ namespace McMd
    CfbEndBase::deleteEndAtom(Atom* endPtr, Atom* pvtPtr, int bondType,
                             double &rosenbluth, double &energy)
    {
-      Vector bondVec;
+      Vector trialPos[MaxTrial_];
+      Vector bondVec[MaxTrial_];
       Vector pvtPos = pvtPtr->position();
-      double trialEnergy, lengthSq, length;
+      double trialEnergy[MaxTrial_];
+      double lengthSq, length;
+      int    iTrial;
    
       // Calculate bond length of pvt-end bond
       lengthSq = boundary().distanceSq(pvtPos, endPtr->position());
       length   = sqrt(lengthSq);
 
-      // Calculate current nonbonded pair energy of end atom
+      // The current position is trial 0. Generate nTrial - 1 others.
+      trialPos[0] = endPtr->position();
+      randomUnitVectors(&bondVec[1], nTrial_ - 1);
+      for (iTrial = 1; iTrial < nTrial_; ++iTrial) {
+         bondVec[iTrial] *= length;
+         trialPos[iTrial].add(pvtPos, bondVec[iTrial]);  
+         boundary().shift(trialPos[iTrial]);
+      }
+
+      // Calculate nonbonded pair energies of end atom for all trials
       #ifndef INTER_NOPAIR
-      energy = system().pairPotential().atomEnergy(*endPtr);
+      system().pairPotential().
+               trialEnergies(*endPtr, trialPos, nTrial_, trialEnergy);
       #else
-      energy = 0.0;
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         trialEnergy[iTrial] = 0.0;
+      }
       #endif
 
       #ifdef INTER_ANGLE
@@ -84,9 +99,8 @@ namespace McMd
       int    iAngle, angleTypeId(0);
       double rsq1, rsq2, cosTheta;
 
+      // Get the angle type and pointers of atoms forming the angle.
       if (system().hasAnglePotential()) {
-
-         // Get the angle type and pointers of atoms forming the angle.
          getAtomAngles(*endPtr, angles);
          for (iAngle = 0; iAngle < angles.size(); ++iAngle) {
             anglePtr = angles[iAngle];
@@ -99,85 +113,42 @@ namespace McMd
                angleTypeId = anglePtr->typeId();
             }
          }
-   
-         // Calculate angle energy. 
-         rsq1 = boundary().distanceSq(pvtPtr->position(),
-                                      pvtPtr2->position(), dr1);
-         rsq2 = boundary().distanceSq(endPtr->position(),
-                                      pvtPtr->position(), dr2);
-         cosTheta = dr1.dot(dr2) / sqrt(rsq1 * rsq2);
-   
-         energy += system().anglePotential().energy(cosTheta, angleTypeId);
-
       }
       #endif
 
-      #ifdef INTER_EXTERNAL
-      if (system().hasExternalPotential()) {
-         energy += system().externalPotential().atomEnergy(*endPtr);
-      }
-      #endif
-
-      // Rosenbluth factor = exp(-beta*(pair + angle + external))
-      rosenbluth = boltzmann(energy);
-      
-      // Add bond energy of current pvt-end bond to energy.
-      // This is the final value of inout energy parameter.
-      energy += system().bondPotential().energy(lengthSq, bondType);
-
-      // Loop over nTrial - 1 additional trial positions:
-      for (int iTrial=0; iTrial < nTrial_ - 1; ++iTrial) {
-
-         random().unitVector(bondVec);
-         bondVec *= length;
-         endPtr->position().add(pvtPos, bondVec);  
-         boundary().shift(endPtr->position());
-
-         #ifndef INTER_NOPAIR
-         trialEnergy = system().pairPotential().atomEnergy(*endPtr);
-         #else
-         trialEnergy = 0.0;
-         #endif
+      // Loop over all trials, including the current position. 
+      // On exit, endPtr->position() is the last trial position.
+      rosenbluth = 0.0;
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         endPtr->position() = trialPos[iTrial];
 
          #ifdef INTER_ANGLE
          if (system().hasAnglePotential()) {
-
-            // Get the angle type and atom pointer at the angle.
-            getAtomAngles(*endPtr, angles);
-            for (iAngle = 0; iAngle < angles.size(); ++iAngle) {
-               anglePtr = angles[iAngle];
-               if (&anglePtr->atom(1) == pvtPtr) {
-                  if (&anglePtr->atom(0) == endPtr) {
-                     pvtPtr2 = &anglePtr->atom(2);
-                  } else {
-                     pvtPtr2 = &anglePtr->atom(0);
-                  }
-                  angleTypeId = anglePtr->typeId();
-               }
-            }
-
-            // Calculate energy.
             rsq1 = boundary().distanceSq(pvtPtr->position(),
                                          pvtPtr2->position(), dr1);
             rsq2 = boundary().distanceSq(endPtr->position(),
                                          pvtPtr->position(), dr2);
             cosTheta = dr1.dot(dr2) / sqrt(rsq1 * rsq2);
-   
-            trialEnergy += system().anglePotential()
-                                   .energy(cosTheta, angleTypeId);
+            trialEnergy[iTrial] += system().anglePotential()
+                                           .energy(cosTheta, angleTypeId);
          }
          #endif
 
          #ifdef INTER_EXTERNAL
          if (system().hasExternalPotential()) {
-            trialEnergy += system().externalPotential()
-                                   .atomEnergy(*endPtr);
+            trialEnergy[iTrial] += system().externalPotential()
+                                           .atomEnergy(*endPtr);
          }
          #endif
 
-         rosenbluth += boltzmann(trialEnergy);
+         // Rosenbluth factor = sum of exp(-beta*(pair + angle + external))
+         rosenbluth += boltzmann(trialEnergy[iTrial]);
       }
-
+      
+      // Total energy of the current position, including bond energy.
+      // This is the final value of inout energy parameter.
+      energy = trialEnergy[0];
+      energy += system().bondPotential().energy(lengthSq, bondType);
    }
    
   
@@ -189,7 +160,7 @@ namespace McMd
                           double &rosenbluth, double &energy)
    {
       Vector trialPos[MaxTrial_];
-      Vector bondVec;
+      Vector bondVec[MaxTrial_];
       Vector pvtPos = pvtPtr->position();
       double trialProb[MaxTrial_], trialEnergy[MaxTrial_];
       double beta, length;
@@ -209,36 +180,49 @@ namespace McMd
       length = 
          system().bondPotential().randomBondLength(&random(), beta, bondType);
    
-      // Loop over nTrial trial positions:
-      rosenbluth = 0.0;
+      // Generate nTrial trial positions
+      randomUnitVectors(bondVec, nTrial_);
       for (iTrial=0; iTrial < nTrial_; ++iTrial) {
-         random().unitVector(bondVec);
-         bondVec *= length;
+         bondVec[iTrial] *= length;
          // trialPos = pvtPos + bondVec
-         trialPos[iTrial].add(pvtPos, bondVec); 
+         trialPos[iTrial].add(pvtPos, bondVec[iTrial]); 
          boundary().shift(trialPos[iTrial]);
-         endPtr->position() = trialPos[iTrial];
-         #ifndef INTER_NOPAIR
-         trialEnergy[iTrial] = system().pairPotential().atomEnergy(*endPtr);
-         #else
-         trialEnergy[iTrial] = 0.0;
-         #endif
+      }
 
-         #ifdef INTER_ANGLE
-         if (system().hasAnglePotential()) {
+      // Calculate nonbonded pair energies for all trial positions
+      #ifndef INTER_NOPAIR
+      system().pairPotential().
+               trialEnergies(*endPtr, trialPos, nTrial_, trialEnergy);
+      #else
+      for (iTrial=0; iTrial < nTrial_; ++iTrial) {
+         trialEnergy[iTrial] = 0.0;
+      }
+      #endif
 
-            getAtomAngles(*endPtr, angles);
-            for (iAngle = 0; iAngle < angles.size(); ++iAngle) {
-               anglePtr = angles[iAngle];
-               if (&anglePtr->atom(1) == pvtPtr) {
-                  if (&anglePtr->atom(0) == endPtr) {
-                     pvtPtr2 = &anglePtr->atom(2);
-                  } else {
-                     pvtPtr2 = &anglePtr->atom(0);
-                  }
-                  angleTypeId = anglePtr->typeId();
+      #ifdef INTER_ANGLE
+      if (system().hasAnglePotential()) {
+         getAtomAngles(*endPtr, angles);
+         for (iAngle = 0; iAngle < angles.size(); ++iAngle) {
+            anglePtr = angles[iAngle];
+            if (&anglePtr->atom(1) == pvtPtr) {
+               if (&anglePtr->atom(0) == endPtr) {
+                  pvtPtr2 = &anglePtr->atom(2);
+               } else {
+                  pvtPtr2 = &anglePtr->atom(0);
                }
+               angleTypeId = anglePtr->typeId();
             }
+         }
+      }
+      #endif
+
+      // Loop over nTrial trial positions:
+      rosenbluth = 0.0;
+      for (iTrial=0; iTrial < nTrial_; ++iTrial) {
+         endPtr->position() = trialPos[iTrial];
+
+         #ifdef INTER_ANGLE
+         if (system().hasAnglePotential()) {
    
             // Get the angle spanned.
             rsq1 = boundary().distanceSq(pvtPtr->position(),
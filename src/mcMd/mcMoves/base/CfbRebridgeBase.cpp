@@ -8,6 +8,7 @@
 #include "CfbRebridgeBase.h"
 #include <mcMd/mcSimulation/McSystem.h>
 #include <mcMd/mcSimulation/mc_potentials.h>
+#include <mcMd/simulation/Simulation.h>
 #include <mcMd/chemistry/Atom.h>
 #include <mcMd/chemistry/Bond.h>
 #include <util/global.h>
@@ -132,6 +133,70 @@ namespace McMd
                            normalTable[MaxBin_-1]);
    }
 
+   /*
+   * Generate trial positions of a middle atom, with an orientation bias.
+   */
+   void CfbRebridgeBase::generateMiddleTrials(
+                const Vector& prevPos, const Vector& u_20, double length,
+                double prefAng, double kappaAng, 
+                Vector* trialPos, double* bias, int nTrial)
+   {
+      int nThread = simulation().nThread();
+      if (nThread == 1) {
+         for (int iTrial = 0; iTrial < nTrial; ++iTrial) {
+            generateMiddleTrial(random(), prevPos, u_20, length, 
+                                prefAng, kappaAng, 
+                                trialPos[iTrial], bias[iTrial]);
+         }
+      } else {
+         #ifdef MCMD_OPENMP
+         #pragma omp parallel num_threads(nThread)
+         #endif
+         {
+            Random& threadRandom = 
+                    simulation().threadRandom(Simulation::threadId());
+            int iTrial;
+            #ifdef MCMD_OPENMP
+            #pragma omp for schedule(static)
+            #endif
+            for (iTrial = 0; iTrial < nTrial; ++iTrial) {
+               generateMiddleTrial(threadRandom, prevPos, u_20, length, 
+                                   prefAng, kappaAng, 
+                                   trialPos[iTrial], bias[iTrial]);
+            }
+         }
+      }
+   }
+
+   /*
+   * Generate one trial position of a middle atom by the rejection method.
+   */
+   void CfbRebridgeBase::generateMiddleTrial(
+                Random& random, const Vector& prevPos, const Vector& u_20, 
+                double length, double prefAng, double kappaAng,
+                Vector& trialPos, double& bias)
+   {
+      Vector bondVec, u_21;
+      double lengthSq, l_21;
+      bool   ready = false;
+      while (!ready) {
+         random.unitVector(bondVec);
+         bondVec *= length;
+         trialPos.add(prevPos, bondVec);
+         boundary().shift(trialPos);
+
+         lengthSq = boundary().distanceSq(trialPos, prevPos, u_21);
+         l_21  = sqrt(lengthSq);
+         u_21 /= l_21;
+         orientationBias(u_21, u_20, prefAng, kappaAng, bias);
+
+         // Rejection method
+         if (bias > random.uniform(0.0, 1.0)) {
+            ready = true;
+         }
+      }
+   }
+
    /* 
    * Configuration bias algorithm for deleting the last particle of an interior
    * bridge. 
@@ -156,12 +221,13 @@ namespace McMd
       Vector  prevPos = prevPtr->position();
       Vector  nextPos = nextPtr->position();
       Vector  partPos = partPtr->position();
-      Vector  bondVec, trialPos, u_20, u_21;
-      double  trialEnergy, bondEnergy, wExt, length, lengthSq;
-      double  l_20, l_21, bias;
+      Vector  u_20, u_21;
+      Vector  trialPos[MaxTrial_];
+      double  trialEnergy[MaxTrial_], bias[MaxTrial_];
+      double  bondEnergy, wExt, lengthSq;
+      double  l_20, l_21;
       double  prefAng, kappaAng, normConst;
       int     iTrial;
-      bool    ready;
       
       // Bond length and bonding vector 2 --> 0
       lengthSq = boundary().distanceSq(nextPos, prevPos, u_20);
@@ -174,86 +240,60 @@ namespace McMd
       u_21 /= l_21;
       energy = system().bondPotential().energy(lengthSq, prevBType);
    
-      // Bond length between 1 and 0 & bonding energy
-      lengthSq   = boundary().distanceSq(partPos, nextPos);
-      bondEnergy = system().bondPotential().energy(lengthSq, nextBType);
-      energy    += bondEnergy;
+      // Compute orientation/Angle bias factor and the normalization factor.
+      getAngKappaNorm(l_20, prefAng, kappaAng, normConst);
+      orientationBias(u_21, u_20, prefAng, kappaAng, bias[0]);
+   
+      // remove normalized orientation bias
+      rosenbluth = normConst / bias[0];
    
-      // Nonbonded pair energy of current position 
+      // The current position is trial 0. Generate "nTrial-1" others 
+      // based on 1-0 bonding.
+      trialPos[0] = partPos;
+      generateMiddleTrials(prevPos, u_20, l_21, prefAng, kappaAng, 
+                           &trialPos[1], &bias[1], nTrial_ - 1);
+
+      // Nonbonded pair energies of all trials
       #ifndef INTER_NOPAIR
-      trialEnergy = system().pairPotential().atomEnergy(*partPtr);
+      system().pairPotential().
+               trialEnergies(*partPtr, trialPos, nTrial_, trialEnergy);
       #else
-      trialEnergy = 0.0;
-      #endif
-
-      #ifdef INTER_ANGLE
-      if (system().hasAnglePotential()) {
-         trialEnergy += system().anglePotential().atomEnergy(*partPtr);
+      for (iTrial=0; iTrial < nTrial_; iTrial++) {
+         trialEnergy[iTrial] = 0.0;
       }
       #endif
 
-      #ifdef INTER_EXTERNAL
-      if (system().hasExternalPotential()) {
-         trialEnergy += system().externalPotential().atomEnergy(*partPtr);
-      }
-      #endif
+      // Accumulate Rosenbluth factor. On exit, partPtr->position() is 
+      // the last trial position.
+      wExt = 0.0;
+      for (iTrial=0; iTrial < nTrial_; iTrial++) {
+         partPtr->position() = trialPos[iTrial];
 
-      energy += trialEnergy;
-    
-      // Compute orientation/Angle bias factor and the normalization factor.
-      getAngKappaNorm(l_20, prefAng, kappaAng, normConst);
-      orientationBias(u_21, u_20, prefAng, kappaAng, bias);
-   
-      // remove normalized orientation bias
-      rosenbluth = normConst / bias;
-   
-      // start to accumulate Rosenbluth factor
-      wExt = boltzmann(trialEnergy + bondEnergy);
-      
-      // Generate "nTrial-1" trial positions based on 1-0 bonding.
-      length = l_21;
-      for (iTrial=0; iTrial < nTrial_ - 1; iTrial++) {
-         ready = false;
-         while (!ready) {
-            random().unitVector(bondVec);
-            bondVec *= length;
-            trialPos.add(prevPos, bondVec);
-            boundary().shift(trialPos);
-   
-            lengthSq = boundary().distanceSq(trialPos, prevPos, u_21);
-            l_21  = sqrt(lengthSq);
-            u_21 /= l_21;
-            orientationBias(u_21, u_20, prefAng, kappaAng, bias);
-   
-   	    // Rejection method
-   	    if (bias > random().uniform(0.0, 1.0)) {
-               ready = true;
-            }
-         }
-         
          // Bond 1-0 potential energy
-         lengthSq   = boundary().distanceSq(trialPos, nextPos);
+         lengthSq   = boundary().distanceSq(trialPos[iTrial], nextPos);
          bondEnergy = system().bondPotential().energy(lengthSq, nextBType);
-         partPtr->position() = trialPos;
-         #ifndef INTER_NOPAIR
-         trialEnergy = system().pairPotential().atomEnergy(*partPtr);
-         #else
-         trialEnergy = 0.0;
-         #endif
 
          #ifdef INTER_ANGLE
          if (system().hasAnglePotential()) {
-            trialEnergy += system().anglePotential().atomEnergy(*partPtr);
+            trialEnergy[iTrial] += 
+                  system().anglePotential().atomEnergy(*partPtr);
          }
          #endif
 
          #ifdef INTER_EXTERNAL
          if (system().hasExternalPotential()) {
-            trialEnergy += system().externalPotential().atomEnergy(*partPtr);
+            trialEnergy[iTrial] += 
+                  system().externalPotential().atomEnergy(*partPtr);
          }
          #endif
 
-         wExt += boltzmann(trialEnergy + bondEnergy);
+         // Energy of the current position
+         if (iTrial == 0) {
+            energy += bondEnergy;
+            energy += trialEnergy[0];
+         }
+
+         wExt += boltzmann(trialEnergy[iTrial] + bondEnergy);
       }
    
       // Update Rosenbluth weight (orientation bias has been removed earlier)
@@ -272,7 +312,7 @@ namespace McMd
    {
       Vector  prevPos = prevPtr->position();
       Vector  nextPos = nextPtr->position();
-      Vector  u_20, u_21, bondVec;
+      Vector  u_20;
       Vector  trialPos[MaxTrial_];
       double  trialEnergy[MaxTrial_], bondEnergy[MaxTrial_];
       double  trialProb[MaxTrial_], bias[MaxTrial_];
@@ -280,7 +320,6 @@ namespace McMd
       double  beta, length, lengthSq, wExt;
       double  prefAng, kappaAng, normConst;
       int     iTrial;
-      bool    ready;
 
       // Bond 2 --> 0
       lengthSq = boundary().distanceSq(nextPos, prevPos, u_20);
@@ -301,24 +340,20 @@ namespace McMd
       getAngKappaNorm(l_20, prefAng, kappaAng, normConst);
    
       // Generating trial orientations
+      generateMiddleTrials(prevPos, u_20, length, prefAng, kappaAng, 
+                           trialPos, bias, nTrial_);
+
+      // Nonbonded pair energies of all trials
+      #ifndef INTER_NOPAIR
+      system().pairPotential().
+               trialEnergies(*partPtr, trialPos, nTrial_, trialEnergy);
+      #else
+      for (iTrial=0; iTrial < nTrial_; iTrial++) {
+         trialEnergy[iTrial] = 0.0;
+      }
+      #endif
+
       for (iTrial=0; iTrial < nTrial_; iTrial++) {
-         ready = false;
-         while (!ready) {
-            random().unitVector(bondVec);
-            bondVec *= length;
-            trialPos[iTrial].add(prevPos, bondVec);
-            boundary().shift(trialPos[iTrial]);
-   
-            lengthSq = boundary().distanceSq(trialPos[iTrial], prevPos, u_21);
-            l_21  = sqrt(lengthSq);
-            u_21 /= l_21;
-            orientationBias(u_21, u_20, prefAng, kappaAng, bias[iTrial]);
-   
-   	    // Rejection method
-   	    if (bias[iTrial] > random().uniform(0.0, 1.0)) {
-               ready = true;
-            }
-         }
          
          // Bond 1-0 potential energy 
          lengthSq = boundary().distanceSq(trialPos[iTrial], nextPos);
@@ -326,12 +361,6 @@ namespace McMd
             system().bondPotential().energy(lengthSq, nextBType);
          partPtr->position() = trialPos[iTrial];
 
-         #ifndef INTER_NOPAIR
-         trialEnergy[iTrial] = system().pairPotential().atomEnergy(*partPtr);
-         #else
-         trialEnergy[iTrial] = 0.0;
-         #endif
-
          #ifdef INTER_ANGLE
          if (system().hasAnglePotential()) {
             trialEnergy[iTrial] += 
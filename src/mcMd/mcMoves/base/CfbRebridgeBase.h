@@ -157,6 +157,26 @@ namespace McMd
       */
       void computeNormalization
          (double prefAng, double kappaAng, double &normConst);
+
+      /**
+      * Generate nTrial trial positions of atom 1, with orientation bias.
+      *
+      * Each trial is drawn by the rejection method. If the Simulation 
+      * has nThread > 1, trials are divided among threads, each of which
+      * uses its own random number generator.
+      */
+      void generateMiddleTrials(const Vector& prevPos, const Vector& u_20,
+                                double length, double prefAng, 
+                                double kappaAng, Vector* trialPos, 
+                                double* bias, int nTrial);
+
+      /**
+      * Generate one trial position of atom 1, using a specified generator.
+      */
+      void generateMiddleTrial(Random& random, const Vector& prevPos, 
+                               const Vector& u_20, double length, 
+                               double prefAng, double kappaAng,
+                               Vector& trialPos, double& bias);
  
    };
 
@@ -60,6 +60,33 @@ namespace McMd
       ar << speciesId_;
       ar << delta_;
    }
+
+   /*
+   * The maximum displacement is a tunable step size.
+   */
+   bool AtomDisplaceMove::hasStepSize() const
+   {  return true; }
+
+   /*
+   * Get the maximum displacement.
+   */
+   double AtomDisplaceMove::stepSize() const
+   {  return delta_; }
+
+   /*
+   * Set the maximum displacement, limited to half the minimum box length.
+   */
+   void AtomDisplaceMove::setStepSize(double stepSize)
+   {
+      double maxDelta = 0.5*boundary().minLength();
+      delta_ = stepSize < maxDelta ? stepSize : maxDelta;
+   }
+
+   /*
+   * The energy change of each accepted move is reported to the system.
+   */
+   bool AtomDisplaceMove::tracksEnergy() const
+   {  return true; }
    
    /* 
    * Generate, attempt and accept or reject a move.
@@ -96,6 +123,7 @@ namespace McMd
          #ifndef INTER_NOPAIR
          system().pairPotential().updateAtomCell(*atomPtr);
          #endif
+         system().shiftPotentialEnergy(newEnergy - oldEnergy);
          incrementNAccept();
       } else {
          atomPtr->position() = oldPos;
@@ -0,0 +1,344 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "CheckerboardDisplaceMove.h"
+#include <mcMd/mcSimulation/McSystem.h>
+#include <mcMd/simulation/Simulation.h>
+#ifndef INTER_NOPAIR
+#include <mcMd/potentials/pair/McPairPotential.h>
+#endif
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/boundary/Boundary.h>
+#include <util/random/Random.h>
+#include <util/space/Vector.h>
+#include <util/global.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor
+   */
+   CheckerboardDisplaceMove::CheckerboardDisplaceMove(McSystem& system)
+    : SystemMove(system),
+      threadNeighbors_(),
+      cellDomains_(),
+      domainAtoms_(),
+      domainBegins_(),
+      domainEnds_(),
+      colorDomains_(),
+      colorBegins_(),
+      nDomains_(),
+      delta_(0.0),
+      speciesId_(-1)
+   { setClassName("CheckerboardDisplaceMove"); }
+
+   /*
+   * Read speciesId and delta.
+   */
+   void CheckerboardDisplaceMove::readParameters(std::istream& in)
+   {
+      readProbability(in);
+      read<int>(in, "speciesId", speciesId_);
+      read<double>(in, "delta", delta_);
+   }
+
+   /*
+   * Load internal state from an archive.
+   */
+   void
+   CheckerboardDisplaceMove::loadParameters(Serializable::IArchive &ar)
+   {
+      McMove::loadParameters(ar);
+      loadParameter<int>(ar, "speciesId", speciesId_);
+      loadParameter<double>(ar, "delta", delta_);
+   }
+
+   /*
+   * Save internal state to an archive.
+   */
+   void CheckerboardDisplaceMove::save(Serializable::OArchive &ar)
+   {
+      McMove::save(ar);
+      ar << speciesId_;
+      ar << delta_;
+   }
+
+   /*
+   * The maximum displacement is a tunable step size.
+   */
+   bool CheckerboardDisplaceMove::hasStepSize() const
+   {  return true; }
+
+   /*
+   * Get the maximum displacement.
+   */
+   double CheckerboardDisplaceMove::stepSize() const
+   {  return delta_; }
+
+   /*
+   * Set the maximum displacement, limited to half the minimum box length.
+   */
+   void CheckerboardDisplaceMove::setStepSize(double stepSize)
+   {
+      double maxDelta = 0.5*boundary().minLength();
+      delta_ = stepSize < maxDelta ? stepSize : maxDelta;
+   }
+
+   /*
+   * The total energy change of each sweep is reported to the system.
+   */
+   bool CheckerboardDisplaceMove::tracksEnergy() const
+   {  return true; }
+
+   /*
+   * Check preconditions, and allocate one neighbor array per thread.
+   */
+   void CheckerboardDisplaceMove::setup()
+   {
+      McMove::setup();
+      #ifdef INTER_NOPAIR
+      UTIL_THROW("CheckerboardDisplaceMove requires a pair potential");
+      #endif
+      #ifdef MCMD_LINK
+      if (system().hasLinkPotential()) {
+         UTIL_THROW("CheckerboardDisplaceMove does not allow links");
+      }
+      #endif
+      int nThread = simulation().nThread();
+      if (threadNeighbors_.isAllocated()) {
+         if (threadNeighbors_.capacity() != nThread) {
+            threadNeighbors_.deallocate();
+         }
+      }
+      if (!threadNeighbors_.isAllocated()) {
+         threadNeighbors_.allocate(nThread);
+      }
+   }
+
+   /*
+   * Perform one sweep, visiting domain colors in random order.
+   */
+   bool CheckerboardDisplaceMove::move()
+   {
+      #ifndef INTER_NOPAIR
+      // Allocate workspace if setup() was not called, as after a restart
+      if (!threadNeighbors_.isAllocated()) {
+         threadNeighbors_.allocate(simulation().nThread());
+      }
+
+      makeDomains();
+
+      // Choose a random permutation of the colors
+      FArray<int, NColor> colors;
+      int i, j, k;
+      for (i = 0; i < NColor; ++i) {
+         colors[i] = i;
+      }
+      for (i = NColor - 1; i > 0; --i) {
+         j = random().uniformInt(0, i + 1);
+         k = colors[i];
+         colors[i] = colors[j];
+         colors[j] = k;
+      }
+
+      int nThread = simulation().nThread();
+      int nAccept = 0;
+      double energyChange = 0.0;
+      int color, begin, end;
+      for (i = 0; i < NColor; ++i) {
+         color = colors[i];
+         begin = colorBegins_[color];
+         end = colorBegins_[color + 1];
+         if (nThread == 1) {
+            for (k = begin; k < end; ++k) {
+               nAccept += sweepDomain(colorDomains_[k], random(),
+                                      threadNeighbors_[0], energyChange);
+            }
+         } else {
+            #ifdef MCMD_OPENMP
+            #pragma omp parallel num_threads(nThread) \
+                    reduction(+:nAccept, energyChange)
+            #endif
+            {
+               int threadId = Simulation::threadId();
+               Random& threadRandom = simulation().threadRandom(threadId);
+               CellList::NeighborArray& neighbors
+                                        = threadNeighbors_[threadId];
+               int m;
+               #ifdef MCMD_OPENMP
+               #pragma omp for schedule(static)
+               #endif
+               for (m = begin; m < end; ++m) {
+                  nAccept += sweepDomain(colorDomains_[m], threadRandom,
+                                         neighbors, energyChange);
+               }
+            }
+         }
+      }
+
+      // Every atom of the species is the subject of one attempt per sweep
+      int nAttempt = domainAtoms_.size();
+      for (i = 0; i < nAttempt; ++i) {
+         incrementNAttempt();
+      }
+      for (i = 0; i < nAccept; ++i) {
+         incrementNAccept();
+      }
+      if (nAccept > 0) {
+         system().shiftPotentialEnergy(energyChange);
+      }
+      return (nAccept > 0);
+      #else
+      return false;
+      #endif
+   }
+
+   /*
+   * Assign cells to domains, and sort atoms of the species by domain.
+   */
+   void CheckerboardDisplaceMove::makeDomains()
+   {
+      #ifndef INTER_NOPAIR
+      const CellList& cellList = system().pairPotential().cellList();
+      FArray<int, Dimension> nCells;
+      FArray<int, Dimension> shifts;
+      int i;
+      for (i = 0; i < Dimension; ++i) {
+         nCells[i] = cellList.gridDimension(i);
+         if (nCells[i] < 4) {
+            UTIL_THROW("Fewer than 4 cells along an axis");
+         }
+         nDomains_[i] = 2*(nCells[i]/4);
+         shifts[i] = random().uniformInt(0, nCells[i]);
+      }
+      int nDomain = nDomains_[0]*nDomains_[1]*nDomains_[2];
+
+      // Assign each cell to a domain, after shifting the origin
+      cellDomains_.resize(cellList.totCells());
+      FArray<int, Dimension> c;
+      FArray<int, Dimension> d;
+      int cellId = 0;
+      for (c[0] = 0; c[0] < nCells[0]; ++c[0]) {
+         d[0] = ((c[0] + nCells[0] - shifts[0])%nCells[0])
+                *nDomains_[0]/nCells[0];
+         for (c[1] = 0; c[1] < nCells[1]; ++c[1]) {
+            d[1] = ((c[1] + nCells[1] - shifts[1])%nCells[1])
+                   *nDomains_[1]/nCells[1];
+            for (c[2] = 0; c[2] < nCells[2]; ++c[2]) {
+               d[2] = ((c[2] + nCells[2] - shifts[2])%nCells[2])
+                      *nDomains_[2]/nCells[2];
+               cellDomains_[cellId] = d[2] + nDomains_[2]*(d[1]
+                                      + nDomains_[1]*d[0]);
+               ++cellId;
+            }
+         }
+      }
+
+      // Sort domains by color, defined by the parity of domain coordinates
+      int color, domainId;
+      colorDomains_.clear();
+      for (color = 0; color < NColor; ++color) {
+         colorBegins_[color] = colorDomains_.size();
+         domainId = 0;
+         for (d[0] = 0; d[0] < nDomains_[0]; ++d[0]) {
+            for (d[1] = 0; d[1] < nDomains_[1]; ++d[1]) {
+               for (d[2] = 0; d[2] < nDomains_[2]; ++d[2]) {
+                  if (4*(d[0]%2) + 2*(d[1]%2) + d[2]%2 == color) {
+                     colorDomains_.append(domainId);
+                  }
+                  ++domainId;
+               }
+            }
+         }
+      }
+      colorBegins_[NColor] = colorDomains_.size();
+
+      // Count atoms in each domain
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator atomIter;
+      domainBegins_.resize(nDomain + 1);
+      domainEnds_.resize(nDomain);
+      for (i = 0; i <= nDomain; ++i) {
+         domainBegins_[i] = 0;
+      }
+      for (system().begin(speciesId_, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            cellId = cellList.cellIndexFromPosition(atomIter->position());
+            ++domainBegins_[cellDomains_[cellId] + 1];
+         }
+      }
+      for (i = 0; i < nDomain; ++i) {
+         domainBegins_[i + 1] += domainBegins_[i];
+         domainEnds_[i] = domainBegins_[i];
+      }
+
+      // Sort atoms by domain
+      domainAtoms_.resize(domainBegins_[nDomain]);
+      for (system().begin(speciesId_, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            cellId = cellList.cellIndexFromPosition(atomIter->position());
+            domainId = cellDomains_[cellId];
+            domainAtoms_[domainEnds_[domainId]] = atomIter.get();
+            ++domainEnds_[domainId];
+         }
+      }
+      #endif
+   }
+
+   /*
+   * Attempt displacements of atoms in one domain.
+   */
+   int
+   CheckerboardDisplaceMove::sweepDomain(int domainId, Random& random,
+                                         CellList::NeighborArray& neighbors,
+                                         double& energyChange)
+   {
+      int nAccept = 0;
+      #ifndef INTER_NOPAIR
+      McPairPotential& pairPotential = system().pairPotential();
+      const CellList& cellList = pairPotential.cellList();
+      Vector oldPos;
+      double oldEnergy, newEnergy;
+      Atom* atomPtr;
+      int begin = domainBegins_[domainId];
+      int nAtom = domainBegins_[domainId + 1] - begin;
+      int i, j, cellId;
+      for (i = 0; i < nAtom; ++i) {
+         atomPtr = domainAtoms_[begin + random.uniformInt(0, nAtom)];
+         oldPos = atomPtr->position();
+         oldEnergy = system().atomPotentialEnergy(*atomPtr, neighbors);
+
+         for (j = 0; j < Dimension; ++j) {
+            atomPtr->position()[j] += random.uniform(-delta_, delta_);
+         }
+         boundary().shift(atomPtr->position());
+
+         // Reject any displacement out of the domain
+         cellId = cellList.cellIndexFromPosition(atomPtr->position());
+         if (cellDomains_[cellId] != domainId) {
+            atomPtr->position() = oldPos;
+            continue;
+         }
+
+         newEnergy = system().atomPotentialEnergy(*atomPtr, neighbors);
+         if (random.metropolis(boltzmann(newEnergy - oldEnergy))) {
+            pairPotential.updateAtomCell(*atomPtr);
+            energyChange += newEnergy - oldEnergy;
+            ++nAccept;
+         } else {
+            atomPtr->position() = oldPos;
+         }
+      }
+      #endif
+      return nAccept;
+   }
+
+}
@@ -0,0 +1,185 @@
+#ifndef MCMD_CHECKERBOARD_DISPLACE_MOVE_H
+#define MCMD_CHECKERBOARD_DISPLACE_MOVE_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/mcMoves/SystemMove.h>        // base class
+#include <mcMd/neighbor/CellList.h>         // typedef in member
+#include <util/containers/DArray.h>         // member
+#include <util/containers/GArray.h>         // member
+#include <util/containers/FArray.h>         // member
+#include <util/space/Dimension.h>           // member template argument
+#include <util/global.h>
+
+namespace Util { class Random; }
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   class McSystem;
+   class Atom;
+
+   /**
+   * Domain decomposed sweep of random single atom displacements.
+   *
+   * Each call to move() performs one sweep of N attempted displacements,
+   * where N is the number of atoms of one species. The box is divided
+   * into a grid of domains, each of which is a block of at least two
+   * cells of the CellList of the McPairPotential in each direction. The
+   * number of domains along each axis is even, so that domains may be
+   * colored like a 3D checkerboard with 8 colors, such that domains of
+   * the same color are separated by at least one domain of a different
+   * color. The 8 colors are visited in random order. For each color,
+   * all domains of that color are processed concurrently, by different
+   * threads if the parent McSimulation has more than one thread. Within
+   * each domain, the thread attempts as many random displacements as
+   * there are atoms in the domain, and rejects any displacement that
+   * would move an atom out of the domain. Atoms in different domains of
+   * the same color thus never interact via the pair potential, and the
+   * cells of the CellList modified by different threads are disjoint.
+   *
+   * The origin of the grid of domains is shifted by a random number of
+   * cells along each axis at the beginning of each sweep. This allows
+   * atoms to cross every domain boundary, and so makes the sweep ergodic.
+   * Each displacement within a domain satisfies detailed balance, so the
+   * sweep preserves the Boltzmann distribution.
+   *
+   * Bonded interactions are allowed, but the distance between any two
+   * atoms in the same bond, angle or dihedral group must remain less than
+   * the width of two cells of the CellList, which is at least twice the
+   * pair potential cutoff. Link potentials are not allowed. The CellList
+   * must have at least 4 cells along each axis.
+   *
+   * \sa \ref mcMd_mcMove_CheckerboardDisplaceMove_page "parameter file format"
+   *
+   * \ingroup McMd_McMove_Module
+   */
+   class CheckerboardDisplaceMove : public SystemMove
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      CheckerboardDisplaceMove(McSystem& system);
+
+      /**
+      * Read speciesId and delta.
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Check preconditions, and allocate per-thread workspace.
+      */
+      virtual void setup();
+
+      /**
+      * Perform one checkerboard sweep of attempted displacements.
+      *
+      * \return true if any displacement was accepted, false otherwise
+      */
+      virtual bool move();
+
+      /**
+      * Return true: the maximum displacement delta is a step size.
+      */
+      virtual bool hasStepSize() const;
+
+      /**
+      * Get the maximum displacement delta.
+      */
+      virtual double stepSize() const;
+
+      /**
+      * Set the maximum displacement delta.
+      *
+      * The value is limited to half the minimum length of the boundary.
+      *
+      * \param stepSize new maximum displacement
+      */
+      virtual void setStepSize(double stepSize);
+
+      /**
+      * Return true: accepted moves report their energy change.
+      */
+      virtual bool tracksEnergy() const;
+
+   private:
+
+      /// Number of domain colors (2 per axis).
+      static const int NColor = 8;
+
+      /// Neighbor arrays for threads, indexed by thread id.
+      DArray<CellList::NeighborArray> threadNeighbors_;
+
+      /// Domain index for each cell of the CellList.
+      GArray<int> cellDomains_;
+
+      /// Pointers to atoms of the species, sorted by domain.
+      GArray<Atom*> domainAtoms_;
+
+      /// Index in domainAtoms_ of first atom of each domain (size nDomain+1).
+      GArray<int> domainBegins_;
+
+      /// Index in domainAtoms_ of end of each domain, used while sorting.
+      GArray<int> domainEnds_;
+
+      /// Domain indices, sorted by color.
+      GArray<int> colorDomains_;
+
+      /// Index in colorDomains_ of first domain of each color.
+      FArray<int, NColor + 1> colorBegins_;
+
+      /// Number of domains along each axis.
+      FArray<int, Dimension> nDomains_;
+
+      /// Maximum magnitude of displacement.
+      double delta_;
+
+      /// Integer Id of Species.
+      int speciesId_;
+
+      /**
+      * Assign cells to domains, with a random origin, and sort atoms.
+      */
+      void makeDomains();
+
+      /**
+      * Attempt displacements of atoms in one domain.
+      *
+      * \param domainId   index of domain
+      * \param random     random number generator for this thread
+      * \param neighbors  neighbor array for this thread
+      * \param energyChange  sum of accepted energy changes (incremented)
+      * \return number of accepted displacements
+      */
+      int sweepDomain(int domainId, Random& random,
+                      CellList::NeighborArray& neighbors,
+                      double& energyChange);
+
+   };
+
+}
+#endif
@@ -8,9 +8,12 @@
 #include "HybridMdMove.h"
 #include <mcMd/mcSimulation/McSystem.h>
 #include <mcMd/mdIntegrators/MdIntegrator.h>
+#include <mcMd/mdIntegrators/NveVvIntegrator.h>
 #include <mcMd/mdSimulation/MdSystem.h>
 #include <mcMd/simulation/Simulation.h>
 #include <mcMd/chemistry/Atom.h>
+#include <mcMd/chemistry/AtomType.h>
+#include <util/archives/Serializable_includes.h>
 #ifndef INTER_NOPAIR
 #include <mcMd/potentials/pair/MdPairPotential.h>
 #include <mcMd/potentials/pair/McPairPotential.h>
@@ -27,7 +30,10 @@ namespace McMd
    HybridMdMove::HybridMdMove(McSystem& system) :
       SystemMove(system),
       mdSystemPtr_(0),
-      nStep_(0)
+      shadowCorrection_(0.0),
+      shadowNAtom_(-1),
+      nStep_(0),
+      useShadow_(false)
    {
       setClassName("HybridMdMove");
       mdSystemPtr_ = new MdSystem(system);
@@ -45,13 +51,18 @@ namespace McMd
    }
 
    /*
-   * Read parameter maxDisp
+   * Read parameters nStep, useShadow and MdSystem.
    */
    void HybridMdMove::readParameters(std::istream& in)
    {
       readProbability(in);
       read<int>(in, "nStep", nStep_);
+      useShadow_ = false;
+      readOptional<bool>(in, "useShadow", useShadow_);
       readParamComposite(in, *mdSystemPtr_);
+      if (useShadow_) {
+         allocateShadow();
+      }
    }
 
    /*
@@ -61,7 +72,14 @@ namespace McMd
    {
       McMove::loadParameters(ar);
       loadParameter<int>(ar, "nStep", nStep_);
+      useShadow_ = false;
+      if (ar.version() > 0) {
+         loadParameter<bool>(ar, "useShadow", useShadow_, false);
+      }
       loadParamComposite(ar, *mdSystemPtr_);
+      if (useShadow_) {
+         allocateShadow();
+      }
    }
 
    /*
@@ -71,9 +89,40 @@ namespace McMd
    {
       McMove::save(ar);
       ar << nStep_;
+      Parameter::saveOptional(ar, useShadow_, useShadow_);
       mdSystemPtr_->saveParameters(ar);
    }
 
+   /*
+   * Setup before a run.
+   */
+   void HybridMdMove::setup()
+   {
+      McMove::setup();
+
+      // Probabilities are normalized by the McMoveManager, so this is the
+      // only move with nonzero probability if its probability is 1.
+      if (useShadow_ && probability() < 1.0 - 1.0E-8) {
+         UTIL_THROW("HybridMdMove with useShadow must be the only McMove");
+      }
+   }
+
+   /*
+   * Check integrator, and allocate arrays used by shadowCorrection().
+   */
+   void HybridMdMove::allocateShadow()
+   {
+      if (!dynamic_cast<NveVvIntegrator*>(&mdSystemPtr_->mdIntegrator())) {
+         UTIL_THROW("Shadow Hamiltonian requires an NveVvIntegrator");
+      }
+      if (!shadowPositions_.isAllocated()) {
+         shadowPositions_.allocate(simulation().atomCapacity());
+         shadowForces_.allocate(simulation().atomCapacity());
+         oldVelocities_.allocate(simulation().atomCapacity());
+      }
+      shadowNAtom_ = -1;
+   }
+
    /*
    * Generate, attempt and accept or reject a Hybrid MD/MC move.
    */
@@ -98,17 +147,29 @@ namespace McMd
          }
       }
 
-      // Initialize MdSystem
+      // Initialize MdSystem. The pair list is rebuilt by calculateForces()
+      // if any atom has moved too far, and here if atoms were added.
       #ifndef INTER_NOPAIR
-      mdSystemPtr_->pairPotential().buildPairList();
+      MdPairPotential& pairPotential = mdSystemPtr_->pairPotential();
+      if (pairPotential.pairList().nAtom() != mdSystemPtr_->nAtom()) {
+         pairPotential.buildPairList();
+      }
       #endif
       mdSystemPtr_->calculateForces();
-      mdSystemPtr_->setBoltzmannVelocities(energyEnsemble().temperature());
+      if (useShadow_) {
+         refreshShadowVelocities();
+         copyVelocities(true);
+      } else {
+         mdSystemPtr_->setBoltzmannVelocities(energyEnsemble().temperature());
+      }
       mdSystemPtr_->mdIntegrator().setup();
 
       // Store old energy
       oldEnergy  = mdSystemPtr_->potentialEnergy();
       oldEnergy += mdSystemPtr_->kineticEnergy();
+      if (useShadow_) {
+         oldEnergy += shadowCorrection_;
+      }
 
       // Run a short MD simulation
       for (int iStep = 0; iStep < nStep_; ++iStep) {
@@ -116,8 +177,13 @@ namespace McMd
       }
 
       // Calculate new energy
+      double newCorrection = 0.0;
       newEnergy  = mdSystemPtr_->potentialEnergy();
       newEnergy += mdSystemPtr_->kineticEnergy();
+      if (useShadow_) {
+         newCorrection = shadowCorrection();
+         newEnergy += newCorrection;
+      }
 
       // Decide whether to accept or reject
       accept = random().metropolis( boltzmann(newEnergy-oldEnergy) );
@@ -133,6 +199,10 @@ namespace McMd
          // Increment counter for the number of accepted moves.
          incrementNAccept();
 
+         if (useShadow_) {
+            shadowCorrection_ = newCorrection;
+         }
+
       } else {
 
          // Restore old atom positions
@@ -146,10 +216,167 @@ namespace McMd
             }
          }
 
+         // Restore and reverse velocities. The reversal is required for
+         // detailed balance, because the old velocities may be kept by
+         // refreshShadowVelocities() at the start of the next move.
+         if (useShadow_) {
+            copyVelocities(false);
+            reverseVelocities();
+         }
+
       }
 
       return accept;
 
    }
 
+   /*
+   * Return the importance weight exp(-beta*(H - Ht)) of the current state.
+   */
+   double HybridMdMove::shadowWeight()
+   {
+      if (useShadow_ && shadowNAtom_ >= 0) {
+         return boltzmann(-shadowCorrection_);
+      } else {
+         return 1.0;
+      }
+   }
+
+   /*
+   * Draw new velocities, accepted by a Metropolis test on the change 
+   * in the shadow correction.
+   */
+   void HybridMdMove::refreshShadowVelocities()
+   {
+      double temperature = energyEnsemble().temperature();
+
+      // Velocities are not available before the first move, after a
+      // restart, or after a change in the number of atoms.
+      bool hasVelocities = (shadowNAtom_ == mdSystemPtr_->nAtom());
+      double oldCorrection = 0.0;
+      if (hasVelocities) {
+         copyVelocities(true);
+         oldCorrection = shadowCorrection();
+      }
+
+      // The ratio of shadow and Boltzmann weights of the velocities is 
+      // exp(-beta*C), so an independent Boltzmann proposal is accepted 
+      // with probability min[1, exp(-beta*(newCorrection - oldCorrection))].
+      mdSystemPtr_->setBoltzmannVelocities(temperature);
+      double newCorrection = shadowCorrection();
+      if (hasVelocities) {
+         if (!random().metropolis(boltzmann(newCorrection - oldCorrection))) {
+            copyVelocities(false);
+            newCorrection = oldCorrection;
+         }
+      }
+      shadowCorrection_ = newCorrection;
+      shadowNAtom_ = mdSystemPtr_->nAtom();
+   }
+
+   /*
+   * Copy atom velocities to or from oldVelocities_.
+   */
+   void HybridMdMove::copyVelocities(bool save)
+   {
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator   atomIter;
+      int nSpec = simulation().nSpecies();
+      for (int iSpec = 0; iSpec < nSpec; ++iSpec) {
+         mdSystemPtr_->begin(iSpec, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               if (save) {
+                  oldVelocities_[atomIter->id()] = atomIter->velocity();
+               } else {
+                  atomIter->velocity() = oldVelocities_[atomIter->id()];
+               }
+            }
+         }
+      }
+   }
+
+   /*
+   * Reverse all atom velocities.
+   */
+   void HybridMdMove::reverseVelocities()
+   {
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator   atomIter;
+      int nSpec = simulation().nSpecies();
+      for (int iSpec = 0; iSpec < nSpec; ++iSpec) {
+         mdSystemPtr_->begin(iSpec, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               atomIter->velocity() *= -1.0;
+            }
+         }
+      }
+   }
+
+   /*
+   * Return the leading correction of the velocity Verlet shadow Hamiltonian.
+   */
+   double HybridMdMove::shadowCorrection()
+   {
+      System::MoleculeIterator molIter;
+      Molecule::AtomIterator   atomIter;
+      Vector dr;
+      double dt = mdSystemPtr_->mdIntegrator().dt();
+      double epsilon = 1.0E-4*dt;
+      double forceSq = 0.0;
+      double curvature = 0.0;
+      double mass;
+      int    iSpec, id;
+      int    nSpec = simulation().nSpecies();
+
+      // Store positions and forces, and displace atoms forward along
+      // velocities
+      for (iSpec = 0; iSpec < nSpec; ++iSpec) {
+         mdSystemPtr_->begin(iSpec, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               id = atomIter->id();
+               mass = simulation().atomType(atomIter->typeId()).mass();
+               shadowPositions_[id] = atomIter->position();
+               shadowForces_[id] = atomIter->force();
+               forceSq += atomIter->force().square()/mass;
+               dr.multiply(atomIter->velocity(), epsilon);
+               atomIter->position() += dr;
+            }
+         }
+      }
+
+      // Directional derivative of forces along velocities, v.U''.v, by 
+      // a central difference of forces at forward and backward displacements
+      mdSystemPtr_->calculateForces();
+      for (iSpec = 0; iSpec < nSpec; ++iSpec) {
+         mdSystemPtr_->begin(iSpec, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               id = atomIter->id();
+               curvature -= atomIter->force().dot(atomIter->velocity());
+               dr.multiply(atomIter->velocity(), -epsilon);
+               atomIter->position() = shadowPositions_[id];
+               atomIter->position() += dr;
+            }
+         }
+      }
+      mdSystemPtr_->calculateForces();
+      for (iSpec = 0; iSpec < nSpec; ++iSpec) {
+         mdSystemPtr_->begin(iSpec, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               id = atomIter->id();
+               curvature += atomIter->force().dot(atomIter->velocity());
+               atomIter->position() = shadowPositions_[id];
+               atomIter->force() = shadowForces_[id];
+            }
+         }
+      }
+      curvature /= 2.0*epsilon;
+
+      return dt*dt*(curvature/12.0 - forceSq/24.0);
+   }
+
 }
@@ -24,6 +24,28 @@ namespace McMd
    /**
    * HybridMdMove is a hybrid Molecular Dynamics MC move.
    *
+   * The MdSystem shares atoms with the parent McSystem, so that the MD
+   * integration acts directly on the McSystem configuration. Old atomic
+   * positions are stored before integration, and restored if the move
+   * is rejected.
+   *
+   * If the optional parameter useShadow is true, the acceptance test
+   * uses a shadow Hamiltonian of the velocity Verlet algorithm rather
+   * than the true total energy. Velocities are then kept between moves,
+   * and new Boltzmann velocities are accepted by a Metropolis test on
+   * the change in the shadow Hamiltonian, so that the move samples a
+   * distribution proportional to exp(-beta*Ht), where Ht is the shadow
+   * Hamiltonian. 
+   *
+   * Warning: With useShadow, averages computed by analyzers are averages
+   * over the shadow distribution, which are biased by terms of order
+   * dt^2. Analyzers do not reweight samples. Unbiased canonical averages
+   * must be obtained by weighting each sample by shadowWeight(). Other
+   * moves do not account for the shadow correction, so setup() throws
+   * an Exception unless this is the only McMove.
+   *
+   * \sa \ref mcMd_mcMove_HybridMdMove_page "parameter file format"
+   *
    * \ingroup McMd_McMove_Module MD_Module
    */
    class HybridMdMove : public SystemMove 
@@ -44,7 +66,7 @@ namespace McMd
       ~HybridMdMove();
    
       /**
-      * Read nStep, dt, skin, maxNPair from file.
+      * Read nStep, useShadow (optional) and MdSystem parameters.
       */
       virtual void readParameters(std::istream& in);
    
@@ -62,12 +84,76 @@ namespace McMd
       */
       virtual void save(Serializable::OArchive& ar);
 
+      /**
+      * Setup before a run.
+      *
+      * Throws an Exception if useShadow is true and this is not the only
+      * move with a nonzero probability.
+      */
+      virtual void setup();
+
       /**
       * Generate, attempt and accept or reject a move.
       */
       bool move();
+
+      /**
+      * Return the importance weight of the current state.
+      *
+      * If useShadow is true, returns exp(-beta*(H - Ht)), in which H is
+      * the true and Ht the shadow Hamiltonian, for the positions and 
+      * velocities at the end of the most recent call to move(). The 
+      * canonical average of an observable A is <A*w>/<w>, where w is 
+      * this weight. Returns 1 if useShadow is false, or if move() has 
+      * not been called.
+      */
+      double shadowWeight();
    
    private:
+
+      /**
+      * Return difference between shadow and true Hamiltonians.
+      *
+      * Returns the leading correction of the shadow Hamiltonian for the 
+      * velocity Verlet algorithm,
+      * \f[
+      *    \frac{\Delta t^2}{12} v^{T} U'' v 
+      *  - \frac{\Delta t^2}{24} F^{T} M^{-1} F 
+      * \f]
+      * in which the Hessian product is obtained from a central difference
+      * of the forces after small displacements of all atoms forward and
+      * backward along their velocities.
+      * Positions and forces are restored on return.
+      */
+      double shadowCorrection();
+
+      /**
+      * Allocate arrays required by shadowCorrection().
+      */
+      void allocateShadow();
+
+      /**
+      * Draw new velocities, accepted by a shadow Hamiltonian test.
+      *
+      * New Boltzmann velocities are accepted with probability 
+      * min[1, exp(-beta*dC)], where dC is the change in the value of 
+      * shadowCorrection(). If they are rejected, the old velocities are
+      * restored. On return, shadowCorrection_ is set for the current 
+      * velocities.
+      */
+      void refreshShadowVelocities();
+
+      /**
+      * Copy atom velocities to or from oldVelocities_.
+      *
+      * \param save if true, save velocities, otherwise restore them.
+      */
+      void copyVelocities(bool save);
+
+      /**
+      * Reverse the velocities of all atoms.
+      */
+      void reverseVelocities();
   
       /// MdSystem object used for MD integration
       MdSystem      *mdSystemPtr_;  
@@ -75,8 +161,27 @@ namespace McMd
       /// Array to store old atomic positions.
       DArray<Vector> oldPositions_; 
 
+      /// Array to store positions during shadowCorrection().
+      DArray<Vector> shadowPositions_; 
+
+      /// Array to store forces during shadowCorrection().
+      DArray<Vector> shadowForces_; 
+
+      /// Array to store old velocities, if useShadow is true.
+      DArray<Vector> oldVelocities_; 
+
+      /// Value of shadowCorrection() for the current state.
+      double         shadowCorrection_;
+
+      /// Number of atoms when velocities were set (-1 if not set).
+      int            shadowNAtom_;
+
       /// Number of Md steps per Hybrid MD move
       int            nStep_;
+
+      /// If true, use the shadow Hamiltonian in the acceptance test.
+      bool           useShadow_;
+
    };
 
 }      
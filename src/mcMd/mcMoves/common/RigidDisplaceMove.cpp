@@ -69,6 +69,27 @@ namespace McMd
       ar & delta_;
       ar & nAtom_;
    }
+
+   /*
+   * The maximum displacement is a tunable step size.
+   */
+   bool RigidDisplaceMove::hasStepSize() const
+   {  return true; }
+
+   /*
+   * Get the maximum displacement.
+   */
+   double RigidDisplaceMove::stepSize() const
+   {  return delta_; }
+
+   /*
+   * Set the maximum displacement, limited to half the minimum box length.
+   */
+   void RigidDisplaceMove::setStepSize(double stepSize)
+   {
+      double maxDelta = 0.5*boundary().minLength();
+      delta_ = stepSize < maxDelta ? stepSize : maxDelta;
+   }
    
    /* 
    * Generate, attempt and accept or reject a rigid molecule translation.
@@ -70,6 +70,25 @@ namespace McMd
       */
       virtual bool move();
 
+      /**
+      * Return true: the maximum displacement delta is a step size.
+      */
+      virtual bool hasStepSize() const;
+
+      /**
+      * Get the maximum displacement delta.
+      */
+      virtual double stepSize() const;
+
+      /**
+      * Set the maximum displacement delta.
+      *
+      * The value is limited to half the minimum length of the boundary.
+      *
+      * \param stepSize new maximum displacement
+      */
+      virtual void setStepSize(double stepSize);
+
    private:
 
       /// Array of old positions.
@@ -138,11 +138,30 @@ namespace McMd
       u1 = v1;
       u1 /= r1;      // unit vector
 
+      // The current position is trial 0. Generate nTrial - 1 others.
+      // Store the unit bond vector u1 for each trial position.
+      Vector trialPos[MaxTrial_];
+      Vector trialU[MaxTrial_];
+      double trialEnergy[MaxTrial_];
+      int iTrial;
+      trialPos[0] = pos0;
+      trialU[0] = u1;
+      randomUnitVectors(&trialU[1], nTrial_ - 1);
+      for (iTrial = 1; iTrial < nTrial_; ++iTrial) {
+         v1 = trialU[iTrial];
+         v1 *= r1;
+         trialPos[iTrial].subtract(pos1, v1);
+         boundary().shift(trialPos[iTrial]);
+      }
+
+      // Compute pair energies for all trials
       #ifndef INTER_NOPAIR
       McPairPotential& pairPotential = system().pairPotential();
-      energy = pairPotential.atomEnergy(atom0);
+      pairPotential.trialEnergies(atom0, trialPos, nTrial_, trialEnergy);
       #else
-      energy = 0.0;
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         trialEnergy[iTrial] = 0.0;
+      }
       #endif
 
       #ifdef INTER_ANGLE
@@ -168,59 +187,40 @@ namespace McMd
             r2 = sqrt(r2); // r2 = |v2| = length of bond 2
             u2 = v2;
             u2 /= r2; // unit vector
-            cosTheta = u1.dot(u2);
             angleTypeId = molecule.bond(atomId - 2*shift).typeId();
-            energy += anglePotential.energy(cosTheta, angleTypeId);
          }
       }
       #endif
 
       #ifdef INTER_EXTERNAL
       ExternalPotential& externalPotential = system().externalPotential();
-      if (hasExternal_) {
-         energy += externalPotential.atomEnergy(atom0);
-      }
       #endif
 
-      // Here: energy = total energy - bond energy
-      // Rosenbluth factor = exp(-beta*(pair + angle + external))
-      rosenbluth = boltzmann(energy);
-
-      // Add bond energy to total energy in current position
-      energy += bondEnergy;
-
-      // Loop over nTrial - 1 additional trial positions:
-      double trialEnergy;
-      for (int iTrial = 0; iTrial < nTrial_ - 1; ++iTrial) {
-
-         // Generate trial position
-         random().unitVector(u1);
-         v1 = u1;
-         v1 *= r1;
-         pos0.subtract(pos1, v1);
-         boundary().shift(pos0);
+      // Loop over all trials, including the current position.
+      // On exit, pos0 is the last trial position.
+      rosenbluth = 0.0;
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         pos0 = trialPos[iTrial];
 
          // Compute trial energy (excluding bond energy)
-         #ifndef INTER_NOPAIR
-         trialEnergy = system().pairPotential().atomEnergy(atom0);
-         #else
-         trialEnergy = 0.0;
-         #endif
          #ifdef INTER_ANGLE
          if (hasAngle) {
-            cosTheta = u1.dot(u2);
-            trialEnergy += anglePotential.energy(cosTheta, angleTypeId);
+            cosTheta = trialU[iTrial].dot(u2);
+            trialEnergy[iTrial] += anglePotential.energy(cosTheta, angleTypeId);
          }
          #endif
          #ifdef INTER_EXTERNAL
          if (hasExternal_) {
-            trialEnergy += externalPotential.atomEnergy(atom0);
+            trialEnergy[iTrial] += externalPotential.atomEnergy(atom0);
          }
          #endif
 
-         rosenbluth += boltzmann(trialEnergy);
+         // Rosenbluth factor = sum of exp(-beta*(pair + angle + external))
+         rosenbluth += boltzmann(trialEnergy[iTrial]);
       }
 
+      // Total energy in current position, including bond energy
+      energy = trialEnergy[0] + bondEnergy;
    }
 
    /*
@@ -253,7 +253,7 @@ namespace McMd
       #ifdef INTER_ANGLE
       // Calculate vector v2 = pos2 - pos1, r2 = |v2|
       Vector v2, u2;
-      double r2, cosTheta;
+      double r2;
       Vector* pos2Ptr;
       AnglePotential& anglePotential = system().anglePotential();
       int angleTypeId;
@@ -283,32 +283,46 @@ namespace McMd
                                       = system().externalPotential();
       #endif
 
-      // Loop over nTrial trial positions:
-      Vector v1, u1;
+      // Generate nTrial trial bond vectors and positions
+      Vector v1;
+      Vector trialU[MaxTrial_];
       Vector trialPos[MaxTrial_];
       double trialProb[MaxTrial_], trialEnergy[MaxTrial_];
-      rosenbluth = 0.0;
+      #ifdef INTER_ANGLE
+      double trialCos[MaxTrial_];
+      #endif
+      randomUnitVectors(trialU, nTrial_);
       for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
-
-         // Generate trial bond vector v1 and position pos0
-         random().unitVector(u1);
-         v1 = u1;
+         v1 = trialU[iTrial];
          v1 *= r1;
          trialPos[iTrial].subtract(pos1, v1);
          boundary().shift(trialPos[iTrial]);
+         #ifdef INTER_ANGLE
+         if (hasAngle) {
+            trialCos[iTrial] = trialU[iTrial].dot(u2);
+         }
+         #endif
+      }
+
+      // Compute pair energies for all trials
+      #ifndef INTER_NOPAIR
+      pairPotential.trialEnergies(atom0, trialPos, nTrial_, trialEnergy);
+      #else
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
+         trialEnergy[iTrial] = 0.0;
+      }
+      #endif
+
+      // Loop over nTrial trial positions:
+      rosenbluth = 0.0;
+      for (iTrial = 0; iTrial < nTrial_; ++iTrial) {
          pos0 = trialPos[iTrial];
 
          // Compute trial energy (excluding bond energy)
-         #ifndef INTER_NOPAIR
-         trialEnergy[iTrial] = pairPotential.atomEnergy(atom0);
-         #else
-         trialEnergy[iTrial] = 0.0;
-         #endif
          #ifdef INTER_ANGLE
          if (hasAngle) {
-            cosTheta = u1.dot(u2);
             trialEnergy[iTrial] += 
-                        anglePotential.energy(cosTheta, angleTypeId);
+                        anglePotential.energy(trialCos[iTrial], angleTypeId);
          }
          #endif
          #ifdef INTER_EXTERNAL
@@ -5,6 +5,7 @@ mcMd_mcMoves_=\
     mcMd/mcMoves/McMove.cpp \
     mcMd/mcMoves/McMoveFactory.cpp \
     mcMd/mcMoves/McMoveManager.cpp \
+    mcMd/mcMoves/McMoveProfile.cpp \
     mcMd/mcMoves/SystemMove.cpp \
     $(mcMd_mcMoves_common_) \
     $(mcMd_mcMoves_semigrand_) 
@@ -15,6 +15,7 @@
 * Usage (single processor version, without MPI):
 *
 *    mcSim [-e] [-r file] [-p file] [-c file] [-i prefix] [-o prefix] [-f]
+*          [-t nThread]
 *
 * Options:
 *
@@ -50,6 +51,14 @@
 *
 *   Set replicated mode for parallel simulations.
 *
+*  -t nThread
+*
+*   Set the number of OpenMP threads used to generate and evaluate trial
+*   positions in configuration bias moves, and to compute pair forces in
+*   hybrid MD moves. Requires compilation with
+*   MCMD_OPENMP defined. Results are reproducible for a given random
+*   seed and number of threads. The default is 1.
+*
 * Input and output files:
 *
 * Serial: If compiled in serial mode, with MPI disabled (ifndef UTIL_MPI), 
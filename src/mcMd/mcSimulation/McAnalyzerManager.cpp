@@ -16,14 +16,16 @@ namespace McMd
 
    // Constructor.
    McAnalyzerManager::McAnalyzerManager(McSimulation& simulation)
-    : simulationPtr_(&simulation),
+    : AnalyzerManager(simulation.system()),
+      simulationPtr_(&simulation),
       systemPtr_(&simulation.system())
    {}
 
    // Constructor.
    McAnalyzerManager::McAnalyzerManager(McSimulation& simulation, 
 		                            McSystem &system)
-    : simulationPtr_(&simulation),
+    : AnalyzerManager(system),
+      simulationPtr_(&simulation),
       systemPtr_(&system)
    {}
 
@@ -49,6 +49,7 @@
 #include <sstream>
 #include <string>
 #include <unistd.h>
+#include <stdlib.h>
 
 namespace McMd
 {
@@ -67,6 +68,9 @@ namespace McMd
       paramFilePtr_(0),
       saveFileName_(),
       saveInterval_(0),
+      nSaveCopy_(1),
+      nAnalyzerThread_(0),
+      restartWriter_(),
       isInitialized_(false),
       isRestarting_(false)
    {
@@ -97,6 +101,9 @@ namespace McMd
       paramFilePtr_(0),
       saveFileName_(),
       saveInterval_(0),
+      nSaveCopy_(1),
+      nAnalyzerThread_(0),
+      restartWriter_(),
       isInitialized_(false),
       isRestarting_(false)
    {
@@ -135,6 +142,7 @@ namespace McMd
       bool cFlag = false;  // command file 
       bool iFlag = false;  // input prefix
       bool oFlag = false;  // output prefix
+      bool tFlag = false;  // number of threads
       #ifdef MCMD_PERTURB
       bool  fflag = false;  // free energy perturbation
       #endif
@@ -143,11 +151,12 @@ namespace McMd
       char* cArg = 0;
       char* iArg = 0;
       char* oArg = 0;
+      int   nThread = 1;
    
       // Read program arguments
       int c;
       opterr = 0;
-      while ((c = getopt(argc, argv, "er:p:c:i:o:f")) != -1) {
+      while ((c = getopt(argc, argv, "er:p:c:i:o:ft:")) != -1) {
          switch (c) {
          case 'e':
             eflag = true;
@@ -177,6 +186,10 @@ namespace McMd
            fflag = true;
            break;
          #endif
+         case 't': // number of threads
+           tFlag = true;
+           nThread = atoi(optarg);
+           break;
          case '?':
            Log::file() << "Unknown option -" << optopt << std::endl;
            UTIL_THROW("Invalid command line option");
@@ -188,6 +201,11 @@ namespace McMd
          Util::ParamComponent::setEcho(true);
       }
 
+      // If option -t, set number of threads (before any restart)
+      if (tFlag) {
+         setNThread(nThread);
+      }
+
       #ifdef MCMD_PERTURB
       // Set to use a perturbation.
       if (fflag) {
@@ -272,8 +290,16 @@ namespace McMd
       read<int>(in, "saveInterval", saveInterval_);
       if (saveInterval_ > 0) {
          read<std::string>(in, "saveFileName", saveFileName_);
+         nSaveCopy_ = 1;
+         readOptional<int>(in, "nSaveCopy", nSaveCopy_);
+         restartWriter_.setNCopy(nSaveCopy_);
       }
 
+      // Number of background threads for snapshot-safe analyzers
+      nAnalyzerThread_ = 0;
+      readOptional<int>(in, "nAnalyzerThread", nAnalyzerThread_);
+      analyzerManager().setNThread(nAnalyzerThread_);
+
       isValid();
       isInitialized_ = true;
    }
@@ -320,7 +346,17 @@ namespace McMd
       loadParameter<int>(ar, "saveInterval", saveInterval_);
       if (saveInterval_ > 0) {
          loadParameter<std::string>(ar, "saveFileName", saveFileName_);
+         nSaveCopy_ = 1;
+         if (ar.version() > 0) {
+            loadParameter<int>(ar, "nSaveCopy", nSaveCopy_, false);
+         }
+         restartWriter_.setNCopy(nSaveCopy_);
+      }
+      nAnalyzerThread_ = 0;
+      if (ar.version() > 0) {
+         loadParameter<int>(ar, "nAnalyzerThread", nAnalyzerThread_, false);
       }
+      analyzerManager().setNThread(nAnalyzerThread_);
 
       system().loadConfig(ar);
       ar >> iStep_;
@@ -340,7 +376,9 @@ namespace McMd
       ar << saveInterval_;
       if (saveInterval_ > 0) {
          ar << saveFileName_;
+         Parameter::saveOptional(ar, nSaveCopy_, nSaveCopy_ > 1);
       }
+      Parameter::saveOptional(ar, nAnalyzerThread_, nAnalyzerThread_ > 0);
 
       system().saveConfig(ar);
       ar << iStep_;
@@ -376,18 +414,11 @@ namespace McMd
       isInitialized_ = true;
    }
 
+   /*
+   * Write a restart file, via the RestartWriter.
+   */
    void McSimulation::save(const std::string& filename)
-   {
-      if (saveInterval_ > 0) {
-         if (iStep_ % saveInterval_ == 0) {
-            Serializable::OArchive ar;
-            std::ios_base::openmode mode = std::ios_base::out | std::ios_base::binary;
-            fileMaster().openRestartOFile(filename, ar.file(), mode);
-            save(ar);
-            ar.file().close();
-         }
-      }
-   }
+   {  restartWriter_.write(*this, fileMaster().restartOFileName(filename)); }
 
    /*
    * Read and execute commands from a specified command file.
@@ -484,6 +515,17 @@ namespace McMd
                bool isContinuation = true;
                simulate(endStep, isContinuation);
             } else
+            if (command == "TUNE_MOVES") {
+               int nStep, interval;
+               double acceptRatio, maxWeightRatio;
+               inBuffer >> nStep >> interval >> acceptRatio 
+                        >> maxWeightRatio;
+               Log::file() << "  " << nStep << "  " << interval
+                           << "  " << acceptRatio 
+                           << "  " << maxWeightRatio << std::endl;
+               mcMoveManagerPtr_->tune(nStep, interval, acceptRatio,
+                                       maxWeightRatio);
+            } else
             if (command == "ANALYZE_CONFIGS") {
                int min, max;
                inBuffer >> min >> max >> filename;
@@ -709,22 +751,33 @@ namespace McMd
       int beginStep = iStep_;
       int nStep = endStep - beginStep;
       Log::file() << std::endl;
+      restartWriter_.clearStatistics();
+
+      // Commands may have modified the configuration or the potentials
+      system().unsetPotentialEnergy();
+      system().unsetVirialStress();
 
       // Main Monte Carlo loop
       Timer timer;
       timer.start();
       for ( ; iStep_ < endStep; ++iStep_) {
 
-         // Analyzers and restart outut
+         // Restart output
+         if (saveInterval_ > 0) {
+            if (iStep_ % saveInterval_ == 0) {
+               save(saveFileName_);
+            }
+         }
+
+         // Analyzers
          if (Analyzer::baseInterval > 0) {
             if (iStep_ % Analyzer::baseInterval == 0) {
-               save(saveFileName_);
                analyzerManager().sample(iStep_);
             }
          }
 
          // Choose and attempt an McMove
-         mcMoveManagerPtr_->chooseMove().move();
+         mcMoveManagerPtr_->move();
 
          #ifdef UTIL_MPI
          #ifdef MCMD_PERTURB
@@ -734,10 +787,15 @@ namespace McMd
                if (system().replicaMove().isAtInterval(iStep_)) {
                   bool success = system().replicaMove().move();
                   #ifndef INTER_NOPAIR
-                  if (success) {
+                  // Rebuild cell list if configurations were exchanged
+                  if (success && !system().replicaMove().swapsParameters()) {
                      system().pairPotential().buildCellList();
                   }
                   #endif
+                  if (success) {
+                     system().unsetPotentialEnergy();
+                     system().unsetVirialStress();
+                  }
                }
             }
          }
@@ -750,12 +808,17 @@ namespace McMd
 
       // Final analyzers / save
       assert(iStep_ == endStep);
+      if (saveInterval_ > 0) {
+         if (iStep_ % saveInterval_ == 0) {
+            save(saveFileName_);
+         }
+      }
       if (Analyzer::baseInterval > 0) {
          if (iStep_ % Analyzer::baseInterval == 0) {
-            save(saveFileName_);
             analyzerManager().sample(iStep_);
          }
       }
+      restartWriter_.finish();
 
       // Output results of all analyzers to output files
       analyzerManager().output();
@@ -774,6 +837,9 @@ namespace McMd
                   << " sec" << std::endl;
       Log::file() << std::endl;
 
+      // Output restart file latency statistics, if any
+      restartWriter_.outputStatistics(Log::file());
+
       // Print McMove acceptance statistics
       long attempt;
       long accept;
@@ -927,6 +993,8 @@ namespace McMd
             // Build the system PairList
             system().pairPotential().buildCellList();
             #endif
+            system().unsetPotentialEnergy();
+            system().unsetVirialStress();
             #ifdef UTIL_DEBUG
             isValid();
             #endif
@@ -10,6 +10,7 @@
 
 #include <mcMd/simulation/Simulation.h>   // base class
 #include <mcMd/mcSimulation/McSystem.h>   // class member
+#include <mcMd/simulation/RestartWriter.h> // class member
 #include <util/global.h>
 
 namespace Util { template <typename T> class Factory; }
@@ -63,6 +64,9 @@ namespace McMd
       *
       *   -r filename. Restart a simulation.
       *
+      *   -t nThread. Set the number of threads used to evaluate trial 
+      *       positions of configuration bias moves (requires MCMD_OPENMP).
+      *
       * When restarting a simulation, the required parameter "filename"
       * is the base name for the 3 required input files: filename.prm, 
       * filename.rst, and filename.cmd.
@@ -182,7 +186,12 @@ namespace McMd
                              std::string classname, std::string filename);
 
       /**
-      * Write restart files.
+      * Write a restart file.
+      *
+      * The state is saved to memory and then written by the RestartWriter,
+      * in a background thread if compiled with MCMD_PTHREAD defined.
+      *
+      * \param filename base file name for all restart files.
       */
       void save(const std::string& filename);
 
@@ -247,6 +256,15 @@ namespace McMd
       /// Interval for writing restart files (no output if 0)
       int saveInterval_;
 
+      /// Number of rolling copies of the restart file.
+      int nSaveCopy_;
+
+      /// Number of background analyzer threads (0 if none).
+      int nAnalyzerThread_;
+
+      /// Writer for restart files.
+      RestartWriter restartWriter_;
+
       /// Has readParam been called?
       bool isInitialized_;
 
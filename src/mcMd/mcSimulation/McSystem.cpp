@@ -63,8 +63,12 @@ namespace McMd
    McSystem::McSystem()
     :
       System(),
+      neighbors_(),
+      potentialEnergy_(),
+      virialStress_(),
+      nEnergyShift_(0)
       #ifndef INTER_NOPAIR
-      pairPotentialPtr_(0)
+      , pairPotentialPtr_(0)
       #endif
       #ifdef INTER_BOND
       , bondPotentialPtr_(0)
@@ -382,6 +386,8 @@ namespace McMd
       #ifndef INTER_NOPAIR
       pairPotential().buildCellList();
       #endif
+      unsetPotentialEnergy();
+      unsetVirialStress();
    }
 
    /* 
@@ -393,6 +399,8 @@ namespace McMd
       #ifndef INTER_NOPAIR
       pairPotential().buildCellList();
       #endif
+      unsetPotentialEnergy();
+      unsetVirialStress();
    }
 
    // -------------------------------------------------------------
@@ -402,10 +410,17 @@ namespace McMd
    * Return total potential energy for one Atom.
    */
    double McSystem::atomPotentialEnergy(const Atom &atom) const
+   {  return atomPotentialEnergy(atom, neighbors_); }
+
+   /*
+   * Return total potential energy of one Atom, with a supplied workspace.
+   */
+   double McSystem::atomPotentialEnergy(const Atom &atom, 
+                                 CellList::NeighborArray& neighbors) const
    {
       double energy = 0;
       #ifndef INTER_NOPAIR
-      energy += pairPotential().atomEnergy(atom);
+      energy += pairPotential().atomEnergy(atom, neighbors);
       #endif
       #ifdef INTER_BOND
       if (hasBondPotential()) {
@@ -594,6 +609,75 @@ namespace McMd
       }
    }
 
+   // -------------------------------------------------------------
+   // Cached energy and stress
+
+   /*
+   * Return cached total potential energy, calculating it if needed.
+   */
+   double McSystem::cachedPotentialEnergy() const
+   {
+      if (!potentialEnergy_.isSet()) {
+         potentialEnergy_.set(potentialEnergy());
+         nEnergyShift_ = 0;
+      }
+      return potentialEnergy_.value();
+   }
+
+   /*
+   * Increment cached potential energy, or unset it after MaxNEnergyShift
+   * increments so that the next request recalculates it.
+   */
+   void McSystem::shiftPotentialEnergy(double dE)
+   {
+      if (potentialEnergy_.isSet()) {
+         ++nEnergyShift_;
+         if (nEnergyShift_ < MaxNEnergyShift) {
+            potentialEnergy_.set(potentialEnergy_.value() + dE);
+         } else {
+            potentialEnergy_.unset();
+         }
+      }
+   }
+
+   /*
+   * Discard cached potential energy.
+   */
+   void McSystem::unsetPotentialEnergy()
+   {  potentialEnergy_.unset(); }
+
+   /*
+   * Return cached virial stress tensor, calculating it if needed.
+   */
+   const Tensor& McSystem::virialStress() const
+   {
+      if (!virialStress_.isSet()) {
+         Tensor stress;
+         computeVirialStressImpl(stress);
+         virialStress_.set(stress);
+      }
+      return virialStress_.value();
+   }
+
+   /*
+   * Return cached virial pressure.
+   */
+   double McSystem::virialPressure() const
+   {
+      const Tensor& stress = virialStress();
+      double pressure = 0.0;
+      for (int i = 0; i < Dimension; ++i) {
+         pressure += stress(i, i);
+      }
+      return pressure/3.0;
+   }
+
+   /*
+   * Discard cached virial stress.
+   */
+   void McSystem::unsetVirialStress()
+   {  virialStress_.unset(); }
+
    // -------------------------------------------------------------
    // Miscellaneous
    
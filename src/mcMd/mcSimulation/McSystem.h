@@ -10,6 +10,8 @@
 
 #include <mcMd/simulation/System.h>     // base class
 #include <mcMd/neighbor/CellList.h>     // member
+#include <util/misc/Setable.h>          // member template
+#include <util/space/Tensor.h>          // member template argument
 #include <util/global.h>
 
 namespace McMd
@@ -111,6 +113,21 @@ namespace McMd
       */
       double atomPotentialEnergy(const Atom& atom) const;
 
+      /**
+      * Calculate the total potential energy for one Atom, using a
+      * neighbor array supplied by the caller.
+      *
+      * Returns the same value as atomPotentialEnergy(atom), but uses 
+      * the array neighbors as workspace for the pair energy, so that 
+      * different threads may call this function concurrently.
+      *
+      * \param  atom Atom object of interest
+      * \param  neighbors  workspace array for neighbors (modified)
+      * \return potential energy of atom
+      */
+      double atomPotentialEnergy(const Atom& atom, 
+                                 CellList::NeighborArray& neighbors) const;
+
       /**
       * Return total potential energy of this System.
       */
@@ -226,6 +243,65 @@ namespace McMd
 
       //@}
 
+      /// \name Cached energy and stress
+      //@{
+
+      /**
+      * Return the cached total potential energy of this System.
+      *
+      * The value is calculated by potentialEnergy() when first needed,
+      * and is then updated incrementally by shiftPotentialEnergy(). It
+      * is recalculated from scratch after MaxNEnergyShift increments,
+      * to prevent accumulation of round-off error, and after any call
+      * to unsetPotentialEnergy().
+      */
+      double cachedPotentialEnergy() const;
+
+      /**
+      * Add the energy change of an accepted move to the cached energy.
+      *
+      * Does nothing if the cached energy is not set.
+      *
+      * \param dE change in the total potential energy
+      */
+      void shiftPotentialEnergy(double dE);
+
+      /**
+      * Discard the cached potential energy.
+      *
+      * This must be called after any change in the configuration or the
+      * potential energy functions that is not reported by a call to
+      * shiftPotentialEnergy().
+      */
+      void unsetPotentialEnergy();
+
+      /**
+      * Return the cached virial stress tensor.
+      *
+      * The value is calculated by computeVirialStress() when first
+      * needed after any call to unsetVirialStress().
+      */
+      const Tensor& virialStress() const;
+
+      /**
+      * Return the cached virial pressure (1/3 of the virial stress trace).
+      */
+      double virialPressure() const;
+
+      /**
+      * Discard the cached virial stress.
+      *
+      * This must be called after any change in the configuration.
+      */
+      void unsetVirialStress();
+
+      /**
+      * Maximum number of increments before the energy is recalculated.
+      */
+      static const int MaxNEnergyShift = 10000;
+
+      //@}
+
       /**
       * Return true if McSystem is valid, or throw Exception.
       */
@@ -251,10 +327,19 @@ namespace McMd
 
    private:
 
-      #ifndef INTER_NOPAIR
       /// Array to hold neighbors returned by a CellList.
       mutable CellList::NeighborArray neighbors_;
 
+      /// Cached total potential energy.
+      mutable Setable<double> potentialEnergy_;
+
+      /// Cached virial stress tensor.
+      mutable Setable<Tensor> virialStress_;
+
+      /// Number of increments of potentialEnergy_ since calculation.
+      mutable int nEnergyShift_;
+
+      #ifndef INTER_NOPAIR
       McPairPotential* pairPotentialPtr_;
       #endif
 
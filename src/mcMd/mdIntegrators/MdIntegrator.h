@@ -57,6 +57,11 @@ namespace McMd
       */
       virtual void step() = 0;
 
+      /**
+      * Get the time step.
+      */
+      double dt() const;
+
       /**
       * Get Boundary of parent System by reference.
       */
@@ -92,6 +97,12 @@ namespace McMd
 
    // Inline methods
 
+   /*
+   * Get the time step.
+   */
+   inline double MdIntegrator::dt() const
+   {  return dt_; }
+
    /*
    * Get Boundary of parent System.
    */
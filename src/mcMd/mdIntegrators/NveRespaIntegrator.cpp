@@ -0,0 +1,100 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "NveRespaIntegrator.h"
+#include <mcMd/mdSimulation/MdSystem.h>
+#include <mcMd/potentials/pair/MdPairPotential.h>
+#include <util/archives/Serializable_includes.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /* 
+   * Constructor.   
+   */
+   NveRespaIntegrator::NveRespaIntegrator(MdSystem& system)
+   : RespaIntegrator(system)
+   {  setClassName("NveRespaIntegrator"); }
+
+   /* 
+   * Destructor.   
+   */
+   NveRespaIntegrator::~NveRespaIntegrator() 
+   {}
+
+   /* 
+   * Read parameters.
+   */
+   void NveRespaIntegrator::readParameters(std::istream &in) 
+   {
+      read<double>(in, "dt", dt_);
+      read<int>(in, "nSubStep", nSubStep_);
+      allocateRespa();
+   }
+
+   /*
+   * Load the internal state from an archive.
+   */
+   void NveRespaIntegrator::loadParameters(Serializable::IArchive& ar)
+   {  
+      loadParameter<double>(ar, "dt", dt_);
+      loadParameter<int>(ar, "nSubStep", nSubStep_);
+      allocateRespa();
+   }
+
+   /*
+   * Save the internal state to an archive.
+   */
+   void NveRespaIntegrator::save(Serializable::OArchive& ar)
+   {  
+      ar & dt_;
+      ar & nSubStep_;
+   }
+
+   /* 
+   * Initialize inverse masses, and split forces.
+   */
+   void NveRespaIntegrator::setup() 
+   {  setupRespa(); }
+
+   /*
+   * RESPA NVE integrator step.
+   *
+   * This method implements the algorithm, with h = dt/nSubStep:
+   *
+   *        v += 0.5*dt*as + 0.5*h*af,  x += h*v
+   *
+   *        repeat nSubStep - 1 times:
+   *           calculate fast acceleration af
+   *           v += h*af,  x += h*v
+   *
+   *        calculate slow and fast accelerations as and af
+   *
+   *        v += 0.5*h*af + 0.5*dt*as
+   *
+   * where x is position, v is velocity, and as and af are accelerations
+   * arising from slow and fast forces.
+   */
+   void NveRespaIntegrator::step() 
+   {
+      double dtHalf = 0.5*dt_;
+      double hHalf = dtHalf/double(nSubStep_);
+
+      kick(dtHalf, hHalf);
+      integrateSubSteps();
+      kick(dtHalf, hHalf);
+
+      #ifndef INTER_NOPAIR
+      if (!system().pairPotential().isPairListCurrent()) {
+         system().pairPotential().buildPairList();
+      }
+      #endif
+   }
+
+}
@@ -0,0 +1,75 @@
+#ifndef MCMD_NVE_RESPA_INTEGRATOR_H
+#define MCMD_NVE_RESPA_INTEGRATOR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/mdIntegrators/RespaIntegrator.h>
+
+#include <iostream>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * A multiple time step (r-RESPA) NVE molecular dynamics integrator.
+   *
+   * Forces are split as described for RespaIntegrator. With nSubStep
+   * = 1, this integrator is equivalent to NveVvIntegrator.
+   *
+   * \sa \ref mcMd_integrator_NveRespaIntegrator_page "param file format"
+   *
+   * \ingroup McMd_MdIntegrator_Module
+   */
+   class NveRespaIntegrator : public RespaIntegrator
+   {
+   
+   public:
+
+      /// Constructor. 
+      NveRespaIntegrator(MdSystem& system);
+ 
+      /// Destructor.   
+      virtual ~NveRespaIntegrator();
+
+      /**
+      * Read parameters dt and nSubStep.
+      *
+      * \param in input file stream.
+      */
+      virtual void readParameters(std::istream &in);
+
+      /**
+      * Load the internal state to an archive.
+      *
+      * \param ar archive object.
+      */
+      virtual void loadParameters(Serializable::IArchive& ar);
+
+      /**
+      * Save the internal state to an archive.
+      *
+      * \param ar archive object.
+      */
+      virtual void save(Serializable::OArchive& ar);
+
+      /**
+      * Setup inverse masses, and split forces into slow and fast parts.
+      */
+      virtual void setup();
+
+      /**
+      * Take a complete outer integration step.
+      */
+      virtual void step();
+
+   }; 
+
+} 
+#endif
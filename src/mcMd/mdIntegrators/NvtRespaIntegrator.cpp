@@ -0,0 +1,172 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "NvtRespaIntegrator.h"
+#include <mcMd/mdSimulation/MdSystem.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/potentials/pair/MdPairPotential.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/ensembles/EnergyEnsemble.h>
+#include <util/archives/Serializable_includes.h>
+
+#include <cmath>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /* 
+   * Constructor.   
+   */
+   NvtRespaIntegrator::NvtRespaIntegrator(MdSystem& system)
+   : RespaIntegrator(system),
+     T_target_(1.0),
+     T_kinetic_(1.0),
+     xi_(0.0),
+     xiDot_(0.0),
+     tauT_(1.0),
+     nuT_(1.0),
+     energyEnsemblePtr_(0)
+   {
+      // Precondition
+      if (!system.energyEnsemble().isIsothermal() ) {
+         UTIL_THROW("System energy ensemble is not isothermal");
+      }
+
+      energyEnsemblePtr_ = &(system.energyEnsemble());
+      T_target_          = energyEnsemblePtr_->temperature();
+      T_kinetic_         = T_target_;
+
+      setClassName("NvtRespaIntegrator"); 
+   }
+
+   /* 
+   * Destructor.   
+   */
+   NvtRespaIntegrator::~NvtRespaIntegrator() 
+   {}
+
+   /* 
+   * Read parameters.
+   */
+   void NvtRespaIntegrator::readParameters(std::istream &in) 
+   {
+      read<double>(in, "dt", dt_);
+      read<int>(in, "nSubStep", nSubStep_);
+      read<double>(in, "tauT", tauT_);
+      nuT_ = 1.0/tauT_;
+      T_target_  = energyEnsemblePtr_->temperature();
+      T_kinetic_ = T_target_;
+      xiDot_ = 0.0;
+      xi_    = 0.0;
+      allocateRespa();
+   }
+
+   /*
+   * Load the internal state from an archive.
+   */
+   void NvtRespaIntegrator::loadParameters(Serializable::IArchive& ar)
+   {  
+      loadParameter<double>(ar, "dt", dt_);
+      loadParameter<int>(ar, "nSubStep", nSubStep_);
+      loadParameter<double>(ar, "tauT", tauT_);
+      ar & nuT_;
+      ar & T_target_;
+      ar & T_kinetic_;
+      ar & xiDot_;
+      ar & xi_;
+      allocateRespa();
+   }
+
+   /*
+   * Save the internal state to an archive.
+   */
+   void NvtRespaIntegrator::save(Serializable::OArchive& ar)
+   {  
+      ar & dt_;
+      ar & nSubStep_;
+      ar & tauT_;
+      ar & nuT_;
+      ar & T_target_;
+      ar & T_kinetic_;
+      ar & xiDot_;
+      ar & xi_;
+   }
+
+   /* 
+   * Split forces, and initialize thermostat variables.
+   */
+   void NvtRespaIntegrator::setup() 
+   {
+      setupRespa();
+
+      int nAtom  = system().nAtom();
+      T_kinetic_ = system().kineticEnergy()*2.0/double(3*nAtom);
+      T_target_ = energyEnsemblePtr_->temperature();
+      xiDot_ = (T_kinetic_/T_target_ -1.0)*nuT_*nuT_;
+      xi_ = 0.0;
+   }
+
+   /*
+   * RESPA Nose-Hoover integrator step.
+   *
+   * The thermostat scaling and update of xi are those of NvtNhIntegrator,
+   * and the outer step between them is that of NveRespaIntegrator.
+   */
+   void NvtRespaIntegrator::step() 
+   {
+      double dtHalf = 0.5*dt_;
+      double hHalf = dtHalf/double(nSubStep_);
+      double factor;
+      int nAtom = system().nAtom();
+
+      T_target_ = energyEnsemblePtr_->temperature();
+      factor = exp(-dtHalf*(xi_ + xiDot_*dtHalf));
+
+      scaleVelocities(factor);
+      kick(dtHalf, hHalf);
+
+      // First half of update of xi_
+      xi_ += xiDot_*dtHalf;
+
+      integrateSubSteps();
+      kick(dtHalf, hHalf);
+      scaleVelocities(factor);
+
+      // Update xiDot and complete update of xi_
+      T_kinetic_ = system().kineticEnergy()*2.0/double(3*nAtom);
+      xiDot_ = (T_kinetic_/T_target_ -1.0)*nuT_*nuT_;
+      xi_ += xiDot_*dtHalf;
+
+      #ifndef INTER_NOPAIR
+      if (!system().pairPotential().isPairListCurrent()) {
+         system().pairPotential().buildPairList();
+      }
+      #endif
+   }
+
+   /*
+   * Multiply all velocities by a factor.
+   */
+   void NvtRespaIntegrator::scaleVelocities(double factor)
+   {
+      System::MoleculeIterator molIter;
+      int iSpecies, ia;
+      int nSpecies = simulation().nSpecies();
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter); 
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (ia=0; ia < molIter->nAtom(); ++ia) {
+               molIter->atom(ia).velocity() *= factor;
+            }
+         }
+      }
+   }
+
+}
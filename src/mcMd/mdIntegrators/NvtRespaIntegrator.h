@@ -0,0 +1,107 @@
+#ifndef MCMD_NVT_RESPA_INTEGRATOR_H
+#define MCMD_NVT_RESPA_INTEGRATOR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/mdIntegrators/RespaIntegrator.h>
+
+#include <iostream>
+
+namespace Util{ class EnergyEnsemble; } 
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * A multiple time step (r-RESPA) Nose-Hoover NVT integrator.
+   *
+   * Forces are split as described for RespaIntegrator. The Nose-Hoover
+   * thermostat is applied at the beginning and end of each outer step,
+   * as in NvtNhIntegrator. With nSubStep = 1, this integrator is 
+   * equivalent to NvtNhIntegrator.
+   *
+   * \sa \ref mcMd_integrator_NvtRespaIntegrator_page "param file format"
+   *
+   * \ingroup McMd_MdIntegrator_Module
+   */
+   class NvtRespaIntegrator : public RespaIntegrator
+   {
+   
+   public:
+
+      /// Constructor. 
+      NvtRespaIntegrator(MdSystem& system);
+ 
+      /// Destructor.   
+      virtual ~NvtRespaIntegrator();
+
+      /**
+      * Read parameters dt, nSubStep and tauT.
+      *
+      * \param in input file stream.
+      */
+      virtual void readParameters(std::istream &in);
+
+      /**
+      * Load the internal state to an archive.
+      *
+      * \param ar archive object.
+      */
+      virtual void loadParameters(Serializable::IArchive& ar);
+
+      /**
+      * Save the internal state to an archive.
+      *
+      * \param ar archive object.
+      */
+      virtual void save(Serializable::OArchive& ar);
+
+      /**
+      * Setup force splitting and thermostat, just before main loop.
+      */
+      virtual void setup();
+
+      /**
+      * Take a complete outer integration step.
+      */
+      virtual void step();
+
+   private:
+
+      /// Target temperature
+      double T_target_;
+
+      /// Current temperature from kinetic energy
+      double T_kinetic_;
+
+      /// Nose-Hover thermostat scaling variable.
+      double xi_;
+
+      /// Time derivative of xi
+      double xiDot_;
+
+      /// Relaxation time for energy fluctuations.
+      double tauT_;
+
+      /// Relaxation rate for energy fluctuations.
+      double nuT_;
+
+      /// Pointer to EnergyEnsemble object.
+      EnergyEnsemble* energyEnsemblePtr_;
+
+      /*
+      * Multiply all velocities by a factor.
+      */
+      void scaleVelocities(double factor);
+
+   }; 
+
+} 
+#endif
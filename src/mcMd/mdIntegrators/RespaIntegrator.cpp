@@ -0,0 +1,204 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "RespaIntegrator.h"
+#include <mcMd/mdSimulation/MdSystem.h>
+#include <mcMd/simulation/Simulation.h>
+#ifdef INTER_BOND
+#include <mcMd/potentials/bond/BondPotential.h>
+#endif
+#ifdef INTER_ANGLE
+#include <mcMd/potentials/angle/AnglePotential.h>
+#endif
+#ifdef INTER_DIHEDRAL
+#include <mcMd/potentials/dihedral/DihedralPotential.h>
+#endif
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   RespaIntegrator::RespaIntegrator(MdSystem& system)
+   : MdIntegrator(system),
+     nSubStep_(1),
+     massInverses_(),
+     slowForces_()
+   {}
+
+   /*
+   * Destructor.
+   */
+   RespaIntegrator::~RespaIntegrator()
+   {}
+
+   /*
+   * Allocate arrays of inverse masses and slow forces.
+   */
+   void RespaIntegrator::allocateRespa()
+   {
+      if (nSubStep_ < 1) {
+         UTIL_THROW("nSubStep < 1");
+      }
+      if (!massInverses_.isAllocated()) {
+         massInverses_.allocate(simulation().nAtomType());
+      }
+      if (!slowForces_.isAllocated()) {
+         slowForces_.allocate(simulation().atomCapacity());
+      }
+   }
+
+   /*
+   * Initialize inverse masses, and split forces.
+   */
+   void RespaIntegrator::setupRespa()
+   {
+      int nAtomType = massInverses_.capacity();
+      for (int i = 0; i < nAtomType; ++i) {
+         massInverses_[i] = 1.0/simulation().atomType(i).mass();
+      }
+      computeForces();
+   }
+
+   /*
+   * Compute total forces, then separate slow and fast forces.
+   *
+   * Slow forces are obtained by subtracting fast forces from the total
+   * computed by MdSystem::calculateForces(), so that all potentials
+   * other than bond, angle and dihedral potentials are treated as slow.
+   */
+   void RespaIntegrator::computeForces()
+   {
+      System::MoleculeIterator molIter;
+      Atom* atomPtr;
+      int iSpecies, ia;
+      int nSpecies = simulation().nSpecies();
+
+      system().calculateForces();
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (ia=0; ia < molIter->nAtom(); ++ia) {
+               atomPtr = &molIter->atom(ia);
+               slowForces_[atomPtr->id()] = atomPtr->force();
+            }
+         }
+      }
+
+      computeFastForces();
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (ia=0; ia < molIter->nAtom(); ++ia) {
+               atomPtr = &molIter->atom(ia);
+               slowForces_[atomPtr->id()] -= atomPtr->force();
+            }
+         }
+      }
+   }
+
+   /*
+   * Set atom forces to bond, angle and dihedral forces.
+   */
+   void RespaIntegrator::computeFastForces()
+   {
+      system().setZeroForces();
+      #ifdef INTER_BOND
+      if (system().hasBondPotential()) {
+         system().bondPotential().addForces();
+      }
+      #endif
+      #ifdef INTER_ANGLE
+      if (system().hasAnglePotential()) {
+         system().anglePotential().addForces();
+      }
+      #endif
+      #ifdef INTER_DIHEDRAL
+      if (system().hasDihedralPotential()) {
+         system().dihedralPotential().addForces();
+      }
+      #endif
+   }
+
+   /*
+   * Update all velocities, using slow and fast forces.
+   */
+   void RespaIntegrator::kick(double slowDt, double fastDt)
+   {
+      Vector dv;
+      System::MoleculeIterator molIter;
+      Atom* atomPtr;
+      double massInverse;
+      int iSpecies, ia;
+      int nSpecies = simulation().nSpecies();
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (ia=0; ia < molIter->nAtom(); ++ia) {
+               atomPtr = &molIter->atom(ia);
+               massInverse = massInverses_[atomPtr->typeId()];
+               dv.multiply(slowForces_[atomPtr->id()], slowDt*massInverse);
+               atomPtr->velocity() += dv;
+               dv.multiply(atomPtr->force(), fastDt*massInverse);
+               atomPtr->velocity() += dv;
+            }
+         }
+      }
+   }
+
+   /*
+   * Update all positions.
+   */
+   void RespaIntegrator::drift(double dt)
+   {
+      Vector dr;
+      System::MoleculeIterator molIter;
+      Atom* atomPtr;
+      int iSpecies, ia;
+      int nSpecies = simulation().nSpecies();
+      for (iSpecies=0; iSpecies < nSpecies; ++iSpecies) {
+         system().begin(iSpecies, molIter);
+         for ( ; molIter.notEnd(); ++molIter) {
+            for (ia=0; ia < molIter->nAtom(); ++ia) {
+               atomPtr = &molIter->atom(ia);
+               dr.multiply(atomPtr->velocity(), dt);
+               atomPtr->position() += dr;
+            }
+         }
+      }
+   }
+
+   /*
+   * Inner steps of one outer step, with h = dt/nSubStep:
+   *
+   *        x += h*v
+   *
+   *        repeat nSubStep - 1 times:
+   *           calculate fast acceleration af
+   *           v += h*af,  x += h*v
+   *
+   *        calculate slow and fast accelerations as and af
+   */
+   void RespaIntegrator::integrateSubSteps()
+   {
+      double h = dt_/double(nSubStep_);
+
+      drift(h);
+      for (int i = 1; i < nSubStep_; ++i) {
+         computeFastForces();
+         kick(0.0, h);
+         drift(h);
+      }
+      computeForces();
+   }
+
+}
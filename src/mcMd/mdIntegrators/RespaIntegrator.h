@@ -0,0 +1,108 @@
+#ifndef MCMD_RESPA_INTEGRATOR_H
+#define MCMD_RESPA_INTEGRATOR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/mdIntegrators/MdIntegrator.h>
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * Base class for multiple time step (r-RESPA) integrators.
+   *
+   * Forces are divided into fast forces, arising from bond, angle and
+   * dihedral potentials, and slow forces, which include all others.
+   * Slow forces are computed once per outer time step dt, and applied
+   * as half kicks at its beginning and end. Fast forces are integrated
+   * by velocity Verlet, with nSubStep inner steps of length dt/nSubStep.
+   *
+   * Subclasses implement step() using the protected kick(), drift() and
+   * integrateSubSteps() functions. Upon return from computeForces(),
+   * atom forces contain only the fast forces, and slow forces are stored
+   * separately.
+   *
+   * \ingroup McMd_MdIntegrator_Module
+   */
+   class RespaIntegrator : public MdIntegrator
+   {
+
+   public:
+
+      /// Constructor.
+      RespaIntegrator(MdSystem& system);
+
+      /// Destructor.
+      virtual ~RespaIntegrator();
+
+   protected:
+
+      /// Number of inner steps per outer step.
+      int nSubStep_;
+
+      /**
+      * Allocate arrays, after nSubStep_ has been read or loaded.
+      */
+      void allocateRespa();
+
+      /**
+      * Compute inverse masses, and split forces into slow and fast parts.
+      */
+      void setupRespa();
+
+      /**
+      * Compute slow forces and store them, then compute fast forces.
+      */
+      void computeForces();
+
+      /**
+      * Set atom forces to fast (bonded) forces.
+      */
+      void computeFastForces();
+
+      /**
+      * Add (slowDt*Fs + fastDt*Ff)/m to all velocities.
+      *
+      * \param slowDt time increment for slow forces
+      * \param fastDt time increment for fast forces
+      */
+      void kick(double slowDt, double fastDt);
+
+      /**
+      * Add dt*v to all positions.
+      *
+      * \param dt time increment
+      */
+      void drift(double dt);
+
+      /**
+      * Execute all inner steps of an outer step, except the last kick.
+      *
+      * On entry, velocities must have been updated by the first slow
+      * and fast half kicks. On exit, positions have been advanced by a
+      * full outer step dt, and slow and fast forces have been computed
+      * for the new positions.
+      */
+      void integrateSubSteps();
+
+   private:
+
+      /// Inverse masses for different atom types.
+      DArray<double> massInverses_;
+
+      /// Slow forces, indexed by global atom id.
+      DArray<Vector> slowForces_;
+
+   };
+
+}
+#endif
@@ -2,6 +2,9 @@ mcMd_mdIntegrators_=\
     mcMd/mdIntegrators/MdIntegrator.cpp \
     mcMd/mdIntegrators/MdIntegratorFactory.cpp \
     mcMd/mdIntegrators/NveVvIntegrator.cpp \
+    mcMd/mdIntegrators/RespaIntegrator.cpp \
+    mcMd/mdIntegrators/NveRespaIntegrator.cpp \
+    mcMd/mdIntegrators/NvtRespaIntegrator.cpp \
     mcMd/mdIntegrators/NvtLangevinIntegrator.cpp \
     mcMd/mdIntegrators/NvtDpdVvIntegrator.cpp \
     mcMd/mdIntegrators/NvtNhIntegrator.cpp \
@@ -16,7 +16,8 @@ namespace McMd
 
    // Constructor.
    MdAnalyzerManager::MdAnalyzerManager(MdSimulation& simulation)
-    : simulationPtr_(&simulation),
+    : AnalyzerManager(simulation.system()),
+      simulationPtr_(&simulation),
       systemPtr_(&simulation.system())
    {}
    //{setClassName("MdAnalyzerManager"); }
@@ -24,7 +25,8 @@ namespace McMd
    // Constructor.
    MdAnalyzerManager::MdAnalyzerManager(MdSimulation& simulation, 
 		                            MdSystem& system)
-    : simulationPtr_(&simulation),
+    : AnalyzerManager(system),
+      simulationPtr_(&simulation),
       systemPtr_(&system)
    {}
 
@@ -51,6 +51,9 @@ namespace McMd
       mdAnalyzerManagerPtr_(0),
       saveFileName_(),
       saveInterval_(0),
+      nSaveCopy_(1),
+      nAnalyzerThread_(0),
+      restartWriter_(),
       isInitialized_(false),
       isRestarting_(false)
    {
@@ -73,6 +76,9 @@ namespace McMd
       mdAnalyzerManagerPtr_(0),
       saveFileName_(),
       saveInterval_(0),
+      nSaveCopy_(1),
+      nAnalyzerThread_(0),
+      restartWriter_(),
       isInitialized_(false),
       isRestarting_(false)
    {
@@ -234,8 +240,16 @@ namespace McMd
       read<int>(in, "saveInterval", saveInterval_);
       if (saveInterval_ > 0) {
          read<std::string>(in, "saveFileName", saveFileName_);
+         nSaveCopy_ = 1;
+         readOptional<int>(in, "nSaveCopy", nSaveCopy_);
+         restartWriter_.setNCopy(nSaveCopy_);
       }
 
+      // Number of background threads for snapshot-safe analyzers
+      nAnalyzerThread_ = 0;
+      readOptional<int>(in, "nAnalyzerThread", nAnalyzerThread_);
+      analyzerManager().setNThread(nAnalyzerThread_);
+
       isValid();
       isInitialized_ = true;
    }
@@ -278,7 +292,17 @@ namespace McMd
       loadParameter<int>(ar, "saveInterval", saveInterval_);
       if (saveInterval_ > 0) {
          loadParameter<std::string>(ar, "saveFileName", saveFileName_);
+         nSaveCopy_ = 1;
+         if (ar.version() > 0) {
+            loadParameter<int>(ar, "nSaveCopy", nSaveCopy_, false);
+         }
+         restartWriter_.setNCopy(nSaveCopy_);
       }
+      nAnalyzerThread_ = 0;
+      if (ar.version() > 0) {
+         loadParameter<int>(ar, "nAnalyzerThread", nAnalyzerThread_, false);
+      }
+      analyzerManager().setNThread(nAnalyzerThread_);
 
       system_.loadConfig(ar);
       ar & iStep_;
@@ -298,7 +322,9 @@ namespace McMd
       ar << saveInterval_;
       if (saveInterval_ > 0) {
          ar << saveFileName_;
+         Parameter::saveOptional(ar, nSaveCopy_, nSaveCopy_ > 1);
       }
+      Parameter::saveOptional(ar, nAnalyzerThread_, nAnalyzerThread_ > 0);
       system_.saveConfig(ar);
       ar & iStep_;
    }
@@ -568,6 +594,7 @@ namespace McMd
 
       // Main loop 
       Log::file() << std::endl;
+      restartWriter_.clearStatistics();
       timer.start();
       for ( ; iStep_ < endStep; ++iStep_) {
 
@@ -615,6 +642,7 @@ namespace McMd
             save(saveFileName_);
          }
       }
+      restartWriter_.finish();
 
       // Final analyzer output
       analyzerManager().output();
@@ -634,6 +662,9 @@ namespace McMd
       Log::file() << std::endl;
       Log::file() << std::endl;
 
+      // Output restart file latency statistics, if any
+      restartWriter_.outputStatistics(Log::file());
+
       #ifndef INTER_NOPAIR
       Log::file() << "PairList Statistics" << std::endl;
       Log::file() << "maxNPair           " 
@@ -812,16 +843,10 @@ namespace McMd
    }
 
    /*
-   * Write a restart file with specified filename, if at interval.
+   * Write a restart file with specified filename, via the RestartWriter.
    */
    void MdSimulation::save(const std::string& filename)
-   {
-      Serializable::OArchive ar;
-      std::ios_base::openmode mode = std::ios_base::out | std::ios_base::binary;
-      fileMaster().openRestartOFile(filename, ar.file(), mode);
-      save(ar);
-      ar.file().close();
-   }
+   {  restartWriter_.write(*this, fileMaster().restartOFileName(filename)); }
 
    /* 
    * Return true if this MdSimulation is valid, or throw an Exception.
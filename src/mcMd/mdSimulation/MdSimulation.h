@@ -9,6 +9,7 @@
 */
 
 #include "MdSystem.h"
+#include <mcMd/simulation/RestartWriter.h>
 #include <mcMd/simulation/Simulation.h>
 
 namespace McMd
@@ -187,6 +188,9 @@ namespace McMd
       /**
       * Write a restart file.
       *
+      * The state is saved to memory and then written by the RestartWriter,
+      * in a background thread if compiled with MCMD_PTHREAD defined.
+      *
       * \param filename base file name for all restart files.
       */
       void save(const std::string& filename);
@@ -220,6 +224,15 @@ namespace McMd
       /// Interval for writing restart files (no output if 0)
       int saveInterval_;
 
+      /// Number of rolling copies of the restart file.
+      int nSaveCopy_;
+
+      /// Number of background analyzer threads (0 if none).
+      int nAnalyzerThread_;
+
+      /// Writer for restart files.
+      RestartWriter restartWriter_;
+
       /// Has readParam been called?
       bool isInitialized_;
 
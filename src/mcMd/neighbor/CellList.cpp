@@ -9,6 +9,8 @@
 #include <util/space/Vector.h>
 #include <util/space/Dimension.h>
 
+#include <climits>
+
 namespace McMd
 {
 
@@ -30,6 +32,7 @@ namespace McMd
       YZCells_ = 0;
       totCells_ = 0;
       atomCapacity_ = 0;
+      cellMark_ = 0;
    }
 
    /*
@@ -51,6 +54,14 @@ namespace McMd
          }
       }
 
+      // Clear marks used by getNeighbors(positions, ...)
+      if (cellMarks_.capacity() > 0) {
+         for (i=0; i < cellMarks_.capacity(); ++i) {
+            cellMarks_[i] = 0;
+         }
+      }
+      cellMark_ = 0;
+
       // Clear all CellTag objects
       if (cellTags_.capacity() > 0) {
          for (i = 0; i < cellTags_.capacity(); ++i) {
@@ -127,13 +138,16 @@ namespace McMd
          UTIL_THROW("totCells_ must be > 1");
       } 
 
-      // If necessary, allocate or reallocate cells_ array
+      // If necessary, allocate or reallocate cells_ and cellMarks_ arrays
       if (cells_.capacity() == 0) {
          cells_.allocate(totCells_);
+         cellMarks_.allocate(totCells_);
       } else
       if (totCells_ > cells_.capacity()) {
          cells_.deallocate();
          cells_.allocate(totCells_);
+         cellMarks_.deallocate();
+         cellMarks_.allocate(totCells_);
       }
       clear();
 
@@ -210,6 +224,60 @@ namespace McMd
 
    } 
 
+   /*
+   * Fill an array with pointers to atoms near any of several positions.
+   */
+   void 
+   CellList::getNeighbors(const Vector* positions, int nPosition, 
+                          GArray<Atom*>& neighbors) const
+   {
+      const Cell *cellPtr;
+      Atom *atomPtr;
+      int   ic, icx, icy, icz;
+      int   jc, jcx, jcy, jcz;
+      int   dcx, dcy, dcz, jp, k;
+
+      // Use a new mark value, to identify cells visited in this call.
+      if (cellMark_ == INT_MAX) {
+         for (jc = 0; jc < totCells_; ++jc) {
+            cellMarks_[jc] = 0;
+         }
+         cellMark_ = 0;
+      }
+      ++cellMark_;
+
+      neighbors.clear();
+      for (k = 0; k < nPosition; ++k) {
+         ic = cellIndexFromPosition(positions[k]);
+         cellCoordFromIndex(ic, icx, icy, icz);
+
+         // Loop over this cell and all neighbors
+         for (dcx = minDel_[0]; dcx <= maxDel_[0]; ++dcx) {
+            jcx = shiftCellCoordAxis(0, icx + dcx);
+            for (dcy = minDel_[1]; dcy <= maxDel_[1]; ++dcy) {
+               jcy = shiftCellCoordAxis(1, icy + dcy);
+               for (dcz = minDel_[2]; dcz <= maxDel_[2]; ++dcz) {
+                  jcz = shiftCellCoordAxis(2, icz + dcz);
+                  jc = cellIndexFromCoord(jcx, jcy, jcz);
+
+                  // Add atoms of each cell only once
+                  if (cellMarks_[jc] != cellMark_) {
+                     cellMarks_[jc] = cellMark_;
+                     cellPtr = &cells_[jc];
+                     for (jp=0; jp < cellPtr->firstClearPos(); ++jp) {
+                        atomPtr = cellPtr->atomPtr(jp);
+                        if (atomPtr != 0) {
+                           neighbors.append(atomPtr);
+                        }
+                     }
+                  }
+
+               }
+            }
+         }
+      }
+   }
+
    /*
    * Get the maximum allowed atom index + 1.
    */
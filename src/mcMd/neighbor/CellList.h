@@ -15,6 +15,7 @@
 #include <util/space/IntVector.h>
 #include <util/containers/DArray.h>
 #include <util/containers/FSArray.h>
+#include <util/containers/GArray.h>
 #include <util/global.h>
 
 #include <sstream>
@@ -207,6 +208,22 @@ namespace McMd
       void 
       getCellNeighbors(int ic, NeighborArray &neighbors, int &nInCell) const;
 
+      /**
+      * Fill an array with pointers to atoms near any of several positions.
+      *
+      * Upon return, the array neighbors contains a pointer to every atom 
+      * in the cell containing any of the positions, or in any cell that
+      * neighbors such a cell. Each atom appears exactly once, even if it
+      * is near several positions. This gathers the union of the arrays 
+      * returned by getNeighbors() for each position, in a single pass.
+      *
+      * \param positions  array of position Vectors
+      * \param nPosition  number of positions
+      * \param neighbors  array of pointers to neighboring Atoms
+      */
+      void getNeighbors(const Vector* positions, int nPosition, 
+                        GArray<Atom*>& neighbors) const;
+
       /**
       * Number of cells along axis i.
       *
@@ -248,6 +265,12 @@ namespace McMd
       /// Array of CellTag objects for quick retrieval
       DArray<CellTag> cellTags_;
 
+      /// Last value of cellMark_ for which each cell was visited.
+      mutable DArray<int> cellMarks_;
+
+      /// Counter used to mark visited cells in getNeighbors().
+      mutable int cellMark_;
+
       /**
       * Lengths of Boundary in each direction.
       *
@@ -484,6 +507,7 @@ namespace McMd
       if (ar.is_loading()) {
          cells_.allocate(totCells_);
          cellTags_.allocate(atomCapacity_);
+         cellMarks_.allocate(totCells_);
       }
       clear();
    }
@@ -303,6 +303,23 @@ namespace McMd
       iterator.atom2Id_   = 0;
    }
 
+   /*
+   * Initialize a pair iterator for a range of primary atoms.
+   */
+   void PairList::begin(PairIterator& iterator, int begin, int end) const
+   {
+      assert(begin >= 0);
+      assert(begin <= end);
+      assert(end <= nAtom1_);
+      iterator.atom1Ptrs_ = &atom1Ptrs_[0];
+      iterator.atom2Ptrs_ = &atom2Ptrs_[0];
+      iterator.first_     = &first_[0];
+      iterator.nAtom1_    = end;
+      iterator.nAtom2_    = first_[end];
+      iterator.atom1Id_   = begin;
+      iterator.atom2Id_   = first_[begin];
+   }
+
    
    /*
    * Return false if any atom has moved a distance greater than skin/2,
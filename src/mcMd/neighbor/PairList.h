@@ -156,6 +156,20 @@ namespace McMd
       * \param iterator a PairList, initialized on output
       */
       void begin(PairIterator &iterator) const;
+
+      /**
+      * Initialize a PairIterator over a range of primary atoms.
+      *
+      * The iterator visits all pairs for which the primary atom has an 
+      * index i in the range begin <= i < end, where 0 <= i < nAtom1().
+      * Pairs with disjoint ranges of primary atoms may thus be assigned 
+      * to different threads.
+      *
+      * \param iterator a PairList, initialized on output
+      * \param begin  index of first primary atom
+      * \param end  index one past the last primary atom
+      */
+      void begin(PairIterator &iterator, int begin, int end) const;
  
       //@}
       /// \name Accessors (miscellaneous)
@@ -171,6 +185,11 @@ namespace McMd
       */
       int nPair() const;
 
+      /**
+      * Get the number of primary atoms (atoms with secondary neighbors).
+      */
+      int nAtom1() const;
+
       /**
       * Has the initialize function been called?
       */
@@ -366,6 +385,12 @@ namespace McMd
    inline int PairList::nPair() const
    {  return nAtom2_; }
 
+   /*
+   * Get the current number of primary atoms.
+   */ 
+   inline int PairList::nAtom1() const
+   {  return nAtom1_; }
+
    /*
    * Get the maximum value of aAtom() since instantiation.
    */ 
@@ -15,9 +15,6 @@
 #include <mcMd/simulation/System.h>
 #include <util/boundary/OrthorhombicBoundary.h>
 #include <util/mpi/MpiSendRecv.h>
-#include <util/archives/MemoryOArchive.h>
-#include <util/archives/MemoryIArchive.h>
-#include <util/archives/MemoryCounter.h>
 #include <util/random/Random.h>
 #include <util/misc/Observer.h>
 
@@ -43,6 +40,8 @@ namespace McMd
       nParameters_(0),
       interval_(-1),
       nSampling_(-1),
+      stateId_(-1),
+      swapParameters_(false),
       ptPositionPtr_(0),
       myPositionPtr_(0),
       swapAttempt_(0),
@@ -57,6 +56,7 @@ namespace McMd
       communicatorPtr_ = &(system.simulation().communicator());
       myId_   = communicatorPtr_->Get_rank();
       nProcs_ = communicatorPtr_->Get_size();
+      stateId_ = myId_;
 
       // Generate output file name and open the file.
       //std::stringstream sMyId;
@@ -97,6 +97,8 @@ namespace McMd
       if (nSampling_ <= 0) {
          UTIL_THROW("Invalid value input for nSampling_");
       }
+      swapParameters_ = false;
+      readOptional<bool>(in, "swapParameters", swapParameters_);
 
       // Allocate memory
       int nAtom = system().simulation().atomCapacity();
@@ -112,8 +114,15 @@ namespace McMd
       // Load parameters
       loadParameter<long>(ar, "interval", interval_);
       loadParameter<int>(ar, "nSampling", nSampling_);
+      swapParameters_ = false;
+      if (ar.version() > 0) {
+         loadParameter<bool>(ar, "swapParameters", swapParameters_, false);
+      }
       ar & swapAttempt_;
       ar & swapAccept_;
+      if (swapParameters_) {
+         ar & stateId_;
+      }
 
       // Validate
       if (interval_ <= 0) {
@@ -136,12 +145,62 @@ namespace McMd
    {
       ar & interval_;
       ar & nSampling_;
+      Parameter::saveOptional(ar, swapParameters_, swapParameters_);
       ar & swapAttempt_;
       ar & swapAccept_;
-
-      int nAtom = system().simulation().atomCapacity();
-      ptPositionPtr_ = new Vector[nAtom];
-      myPositionPtr_ = new Vector[nAtom];
+      if (swapParameters_) {
+         ar & stateId_;
+      }
+   }
+   
+   /*
+   * Sample a permutation of states by the Gibbs sampler.
+   */
+   void ReplicaMove::samplePermutation(const DArray<double>& data,
+                                       DArray<int>& permutation)
+   {
+      int nData = 2*nParameters_;
+      Random& random = system().simulation().random();
+
+      // Start with identity permutation
+      for (int i = 0; i < nProcs_; i++)
+         permutation[i] = i;
+
+      // The matrix U_ij = u_i(x_j) is known, permutate nSampling steps 
+      // according to acceptance criterium
+      const double* di;
+      const double* dj;
+      const double* pi;
+      const double* pj;
+      for (int n =0; n < nSampling_; n++) {
+         swapAttempt_++;
+         // choose a pair i,j, i!= j at random
+         int i = random.uniformInt(0,nProcs_);
+         int j = random.uniformInt(0,nProcs_-1);
+         if (i<=j) j++;
+
+         // apply acceptance criterium
+         di = &data[i*nData];
+         dj = &data[j*nData];
+         pi = &data[permutation[i]*nData + nParameters_];
+         pj = &data[permutation[j]*nData + nParameters_];
+         double weight = 0;
+         for (int k = 0; k < nParameters_; k++) {
+            double deltaDerivative = di[k] - dj[k];
+            // the permutations operate on the states (the perturbation parameters)
+            weight += (pj[k] - pi[k])*deltaDerivative;
+         }
+         double exponential = exp(-weight);
+         int accept = random.metropolis(exponential) ? 1 : 0;
+
+         if (accept) {
+            swapAccept_++;
+            // swap states of pair i,j
+            int tmp = permutation[i];
+            permutation[i] = permutation[j];
+            permutation[j] = tmp;
+         }
+      }
    }
    
    /*
@@ -155,109 +214,91 @@ namespace McMd
       Molecule::AtomIterator   atomIter;
       int iA;
       int recvPt, sendPt;
-  
-      DArray<int> permutation;
-      permutation.allocate(nProcs_);
-
-      // Gather all derivatives of the perturbation Hamiltonians and parameters on processor with rank 0
-      DArray<double> myDerivatives;
-      myDerivatives.allocate(nParameters_);
-      DArray<double> myParameters;
-      myParameters.allocate(nParameters_);
 
+      // Gather derivatives of the perturbation Hamiltonians and parameters 
+      // of all processors on processor with rank 0
+      int nData = 2*nParameters_;
+      DArray<double> myData;
+      myData.allocate(nData);
       for (int i=0; i< nParameters_; i++) {
-         myDerivatives[i] = system().perturbation().derivative(i);
-         myParameters[i] = system().perturbation().parameter(i);
+         myData[i] = system().perturbation().derivative(i);
+         myData[nParameters_ + i] = system().perturbation().parameter(i);
       }
+      DArray<double> allData;
+      DArray<int> permutation;
+      double* allDataPtr = 0;
+      if (myId_ == 0) {
+         allData.allocate(nProcs_*nData);
+         permutation.allocate(nProcs_);
+         allDataPtr = &allData[0];
+      }
+      communicatorPtr_->Gather(&myData[0], nData, MPI::DOUBLE,
+                               allDataPtr, nData, MPI::DOUBLE, 0);
 
-      int size = 0;
-      size += memorySize(myDerivatives);
-      size += memorySize(myParameters);
-
-      if (myId_ != 0) {
-
-         MemoryOArchive sendCurrent;
-         sendCurrent.allocate(size);
-
-         sendCurrent << myDerivatives;
-         sendCurrent << myParameters;
+      // Sample permutation of states
+      if (myId_ == 0) {
+         samplePermutation(allData, permutation);
+      }
 
-         sendCurrent.send(*communicatorPtr_, 0);
-      } else {
-         DArray< DArray<double> > allDerivatives;
-         DArray< DArray<double> > allParameters;
-         allDerivatives.allocate(nProcs_);
-         allParameters.allocate(nProcs_);
-   
-         allDerivatives[0].allocate(nParameters_);
-         allDerivatives[0] = myDerivatives;
-         allParameters[0].allocate(nParameters_);
-         allParameters[0] = myParameters;
-
-         for (int i = 1; i<nProcs_; i++) {
-            MemoryIArchive recvPartner;
-            recvPartner.allocate(size);
-            recvPartner.recv(*communicatorPtr_, i);
-            allDerivatives[i].allocate(nParameters_);
-            allParameters[i].allocate(nParameters_);
-            recvPartner >> allDerivatives[i];
-            recvPartner >> allParameters[i];
+      if (swapParameters_) {
+
+         // Scatter the index of the new state of each processor
+         DArray<int> allStates;
+         DArray<int> newStates;
+         int* allStatesPtr = 0;
+         int* newStatesPtr = 0;
+         if (myId_ == 0) {
+            allStates.allocate(nProcs_);
+            newStates.allocate(nProcs_);
+            allStatesPtr = &allStates[0];
+            newStatesPtr = &newStates[0];
          }
-
-         // Now we have the complete matrix U_ij = u_i(x_j), permutate nsampling steps according
-         // to acceptance criterium
-  
-         // start with identity permutation
-         for (int i = 0; i < nProcs_; i++)
-            permutation[i] = i;
-
-         for (int n =0; n < nSampling_; n++) {
-            swapAttempt_++;
-            // choose a pair i,j, i!= j at random
-            int i = system().simulation().random().uniformInt(0,nProcs_);
-            int j = system().simulation().random().uniformInt(0,nProcs_-1);
-            if (i<=j) j++;
-
-            // apply acceptance criterium
-            double weight = 0;
-            for (int k = 0; k < nParameters_; k++) {
-               double deltaDerivative = allDerivatives[i][k] - allDerivatives[j][k];
-               // the permutations operate on the states (the perturbation parameters)
-               weight += (allParameters[permutation[j]][k] - allParameters[permutation[i]][k])*deltaDerivative;
-             }
-            double exponential = exp(-weight);
-            int accept = system().simulation().random(). metropolis(exponential) ? 1 : 0;
-   
-            if (accept) {
-               swapAccept_++;
-               // swap states of pair i,j
-               int tmp = permutation[i];
-               permutation[i] = permutation[j];
-               permutation[j] = tmp;
-               }
+         communicatorPtr_->Gather(&stateId_, 1, MPI::INT,
+                                  allStatesPtr, 1, MPI::INT, 0);
+         if (myId_ == 0) {
+            for (int i = 0; i < nProcs_; i++) {
+               newStates[i] = allStates[permutation[i]];
+            }
          }
-    
-         // send exchange partner information to all other processors
-         for (int i = 0; i < nProcs_; i++) {
-            if (i != 0)
-                communicatorPtr_->Send(&permutation[i], 1, MPI::INT, i, 0);
-            else
-                sendPt = permutation[i];
-
-            if (permutation[i] != 0)
-               communicatorPtr_->Send(&i, 1, MPI::INT, permutation[i], 1);
-            else
-               recvPt = i;
+         int newStateId;
+         communicatorPtr_->Scatter(newStatesPtr, 1, MPI::INT,
+                                   &newStateId, 1, MPI::INT, 0);
+
+         // Adopt the parameters of the new state
+         if (newStateId != stateId_) {
+            DArray<double> newParameters;
+            newParameters.allocate(nParameters_);
+            for (int i = 0; i < nParameters_; i++) {
+               newParameters[i] = 
+                      system().perturbation().parameter(i, newStateId);
+            }
+            system().perturbation().setParameter(newParameters);
+            stateId_ = newStateId;
          }
+
+         // Log index of current state to file
+         outputFile_ << stateId_ << std::endl;
+         return true;
       }
 
-      
-      if (myId_ != 0) {
-         // partner id to receive from
-         communicatorPtr_->Recv(&sendPt, 1, MPI::INT, 0, 0);
-         // partner id to send to
-         communicatorPtr_->Recv(&recvPt, 1, MPI::INT, 0, 1);
+      // Scatter exchange partner information to all other processors
+      DArray<int> inverse;
+      int* permutationPtr = 0;
+      int* inversePtr = 0;
+      if (myId_ == 0) {
+         inverse.allocate(nProcs_);
+         for (int i = 0; i < nProcs_; i++) {
+            inverse[permutation[i]] = i;
+         }
+         permutationPtr = &permutation[0];
+         inversePtr = &inverse[0];
       }
+      // partner id to send to
+      communicatorPtr_->Scatter(permutationPtr, 1, MPI::INT,
+                                &sendPt, 1, MPI::INT, 0);
+      // partner id to receive from
+      communicatorPtr_->Scatter(inversePtr, 1, MPI::INT,
+                                &recvPt, 1, MPI::INT, 0);
 
       if (recvPt == myId_ || sendPt == myId_) {
          // no exchange necessary
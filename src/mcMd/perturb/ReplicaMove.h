@@ -58,6 +58,20 @@ namespace McMd
    *
    * The technique is described in detail in
    * John D. Chodera and Michael R. Shirts, J. Chem. Phys. 135, 194110 (2011)
+   *
+   * By default, an accepted permutation is applied by exchanging atomic
+   * positions and boundary dimensions between processors, after which the
+   * parent McSimulation rebuilds the cell list. If the optional parameter
+   * \b swapParameters is true, each processor instead keeps its
+   * configuration and adopts the perturbation parameters of its new state,
+   * which are taken from the table stored by the Perturbation. Only a few
+   * numbers per processor are then communicated at each exchange, using
+   * one gather and one scatter, independent of the number of atoms. The
+   * index of the state held by each processor is written to the "repx"
+   * output file after every exchange attempt in this mode, and may be
+   * used to sort sampled data by state. Analyzers that assume that the
+   * state of each processor is fixed, such as BennettsMethod, may not be
+   * used in this mode.
    * 
    * \ingroup McMd_Perturb_Module
    */
@@ -88,6 +102,10 @@ namespace McMd
       * Empirically, \b nSampling should be on the order of P^3 .. P^5,
       * where P is the number of processors.
       *
+      * The optional bool parameter \b swapParameters (false by default)
+      * selects exchange of perturbation parameters rather than of
+      * configurations.
+      *
       * \param in input stream from which to read parameters.
       */
       virtual void readParameters(std::istream& in);
@@ -123,6 +141,20 @@ namespace McMd
       */
       bool isAtInterval(long counter) const;
 
+      /**
+      * Are perturbation parameters, rather than configurations, swapped?
+      */
+      bool swapsParameters() const;
+
+      /**
+      * Get index of the perturbation state of this system.
+      *
+      * This is equal to the processor rank unless swapsParameters() is
+      * true, in which case it is the row of the Perturbation parameter
+      * table that is currently assigned to this system.
+      */
+      int stateId() const;
+
       /**
       * Notify observers of a successful replica exchange
       *
@@ -174,6 +206,12 @@ namespace McMd
       /// Number of state swaps before exchanging
       int nSampling_;
 
+      /// Index of the perturbation state of this system.
+      int stateId_;
+
+      /// If true, swap perturbation parameters rather than configurations.
+      bool swapParameters_;
+
       /// Pointer to allocated buffer to store atom positions.
       Vector   *ptPositionPtr_;
 
@@ -186,6 +224,20 @@ namespace McMd
       /// Count of accepted swaps
       long  swapAccept_;
 
+      /**
+      * Sample a permutation of states by the Gibbs sampler (rank 0).
+      *
+      * The array data contains 2*nParameters values for each system,
+      * ordered by rank: the derivatives dW/dp[k] for k = 0,..,
+      * nParameters-1, followed by the parameters p[k]. On return,
+      * system i is to be assigned the state of system permutation[i].
+      *
+      * \param data  derivatives and parameters of all systems
+      * \param permutation  sampled permutation (output)
+      */
+      void samplePermutation(const DArray<double>& data,
+                             DArray<int>& permutation);
+
    };
    // Inline methods
 
@@ -200,6 +252,18 @@ namespace McMd
    */
    inline bool ReplicaMove::isAtInterval(long counter) const
    { return (counter%interval_ == 0); }
+
+   /*
+   * Are perturbation parameters swapped?
+   */
+   inline bool ReplicaMove::swapsParameters() const
+   { return swapParameters_; }
+
+   /*
+   * Return index of the perturbation state of this system.
+   */
+   inline int ReplicaMove::stateId() const
+   { return stateId_; }
    
    /*
    * Number of attempts in given direction.
@@ -15,6 +15,7 @@
 #include <util/global.h> 
 
 #include <fstream>
+#include <cmath>
 
 namespace McMd
 {
@@ -27,6 +28,11 @@ namespace McMd
    McPairPotential::McPairPotential(System& system)
     : ParamComposite(),
       SubSystem(system)
+    #ifdef MCMD_PROFILE
+    , nEnergy_(0.0)
+    , nNeighbor_(0.0)
+    , nCellUpdate_(0.0)
+    #endif
    {  setClassName("McPairPotential"); }
  
    /* 
@@ -54,7 +60,178 @@ namespace McMd
             }
          }
       }
+      #ifdef MCMD_PROFILE
+      countCellUpdate(double(cellList_.nAtom()));
+      #endif
 
    }
 
+   /*
+   * TrialBuffer constructor.
+   */
+   McPairPotential::TrialBuffer::TrialBuffer()
+    : positions(),
+      x(),
+      y(),
+      z(),
+      typeIds()
+   {}
+
+   /*
+   * TrialBuffer destructor.
+   */
+   McPairPotential::TrialBuffer::~TrialBuffer()
+   {}
+
+   /*
+   * Gather neighbors of a set of trial positions for one atom.
+   */
+   double 
+   McPairPotential::gatherTrialNeighbors(const Atom& atom, 
+                                         const Vector* positions, 
+                                         int nTrial) const
+   {
+      const Boundary& bound = boundary();
+      TrialBuffer& buffer = trialBuffer_;
+      Vector  center = positions[0];
+      Vector  dr;
+      Atom   *jAtomPtr;
+      double  rsq, dMax, rangeSq;
+      int     j, k, nNeighbor;
+      int     id = atom.id();
+
+      // Unwrap trial positions, and find the maximum distance of a 
+      // trial position from the first.
+      buffer.positions.clear();
+      buffer.positions.append(center);
+      dMax = 0.0;
+      for (k = 1; k < nTrial; ++k) {
+         rsq = bound.distanceSq(positions[k], center, dr);
+         dr += center;
+         buffer.positions.append(dr);
+         if (rsq > dMax) dMax = rsq;
+      }
+      dMax = sqrt(dMax);
+
+      // Only atoms within this distance of center can interact with any
+      // trial position (by the triangle inequality).
+      rangeSq = maxPairCutoff() + dMax;
+      rangeSq = rangeSq*rangeSq;
+
+      // Gather neighbors into contiguous arrays of unwrapped coordinates
+      // (center + minimum image separation).
+      cellList_.getNeighbors(positions, nTrial, trialNeighbors_);
+      nNeighbor = trialNeighbors_.size();
+      buffer.x.clear();
+      buffer.y.clear();
+      buffer.z.clear();
+      buffer.typeIds.clear();
+      for (j = 0; j < nNeighbor; ++j) {
+         jAtomPtr = trialNeighbors_[j];
+         if (jAtomPtr->id() != id) {
+            if (!atom.mask().isMasked(*jAtomPtr)) {
+               rsq = bound.distanceSq(jAtomPtr->position(), center, dr);
+               if (rsq < rangeSq) {
+                  buffer.x.append(center[0] + dr[0]);
+                  buffer.y.append(center[1] + dr[1]);
+                  buffer.z.append(center[2] + dr[2]);
+                  buffer.typeIds.append(jAtomPtr->typeId());
+               }
+            }
+         }
+      }
+      #ifdef MCMD_PROFILE
+      countEnergy(double(nTrial), 
+                  double(nTrial)*double(buffer.typeIds.size()));
+      #endif
+      return dMax;
+   }
+
+   /*
+   * Sort insertion positions by cell (counting sort).
+   */
+   void McPairPotential::sortInsertionPositions(const Vector* positions, 
+                                                int nPosition) const
+   {
+      int nCell = cellList_.totCells();
+      int ic, k;
+      insertionBegins_.resize(nCell + 1);
+      insertionEnds_.resize(nCell);
+      insertionOrder_.resize(nPosition);
+      for (ic = 0; ic <= nCell; ++ic) {
+         insertionBegins_[ic] = 0;
+      }
+      for (k = 0; k < nPosition; ++k) {
+         ic = cellList_.cellIndexFromPosition(positions[k]);
+         ++insertionBegins_[ic + 1];
+      }
+      insertionCells_.clear();
+      for (ic = 0; ic < nCell; ++ic) {
+         if (insertionBegins_[ic + 1] > 0) {
+            insertionCells_.append(ic);
+         }
+         insertionBegins_[ic + 1] += insertionBegins_[ic];
+         insertionEnds_[ic] = insertionBegins_[ic];
+      }
+      for (k = 0; k < nPosition; ++k) {
+         ic = cellList_.cellIndexFromPosition(positions[k]);
+         insertionOrder_[insertionEnds_[ic]] = k;
+         ++insertionEnds_[ic];
+      }
+   }
+
+   /*
+   * Gather neighbors of the insertion positions in one cell.
+   */
+   double 
+   McPairPotential::gatherInsertionNeighbors(const Vector* positions, 
+                                             int begin, int end,
+                                             CellList::NeighborArray& neighbors,
+                                             TrialBuffer& buffer) const
+   {
+      const Boundary& bound = boundary();
+      Vector center = positions[insertionOrder_[begin]];
+      Vector dr;
+      double rsq, dMax, rangeSq;
+      int    j, n, nNeighbor;
+
+      // Unwrap positions, and find the maximum distance from the first.
+      buffer.positions.clear();
+      buffer.positions.append(center);
+      dMax = 0.0;
+      for (n = begin + 1; n < end; ++n) {
+         rsq = bound.distanceSq(positions[insertionOrder_[n]], center, dr);
+         dr += center;
+         buffer.positions.append(dr);
+         if (rsq > dMax) dMax = rsq;
+      }
+      dMax = sqrt(dMax);
+      rangeSq = maxPairCutoff() + dMax;
+      rangeSq = rangeSq*rangeSq;
+
+      // Copy unwrapped coordinates of neighbors within range of center
+      // into contiguous arrays. All positions lie in the same cell, and
+      // so have the same neighboring cells.
+      cellList_.getNeighbors(center, neighbors);
+      nNeighbor = neighbors.size();
+      buffer.x.clear();
+      buffer.y.clear();
+      buffer.z.clear();
+      buffer.typeIds.clear();
+      for (j = 0; j < nNeighbor; ++j) {
+         rsq = bound.distanceSq(neighbors[j]->position(), center, dr);
+         if (rsq < rangeSq) {
+            buffer.x.append(center[0] + dr[0]);
+            buffer.y.append(center[1] + dr[1]);
+            buffer.z.append(center[2] + dr[2]);
+            buffer.typeIds.append(neighbors[j]->typeId());
+         }
+      }
+      #ifdef MCMD_PROFILE
+      countEnergy(double(end - begin), 
+                  double(end - begin)*double(buffer.typeIds.size()));
+      #endif
+      return dMax;
+   }
+
 }
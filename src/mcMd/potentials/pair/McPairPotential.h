@@ -12,6 +12,7 @@
 #include <mcMd/simulation/SubSystem.h>             // base class
 #include <mcMd/potentials/pair/PairPotential.h>    // base class
 #include <mcMd/neighbor/CellList.h>                // member
+#include <util/containers/GArray.h>                // member
 
 #include <util/global.h>
 
@@ -54,6 +55,23 @@ namespace McMd
       */
       virtual double atomEnergy(const Atom& atom) const = 0;
 
+      /**
+      * Calculate the nonbonded pair energy for one Atom, using a
+      * neighbor array supplied by the caller.
+      *
+      * Returns the same value as atomEnergy(atom), but uses the array
+      * neighbors as workspace instead of an internal array, and does
+      * not modify any member of this object. Different threads may 
+      * thus call this function concurrently, each with its own array.
+      *
+      * \param  atom Atom object of interest
+      * \param  neighbors  workspace array for neighbors (modified)
+      * \return nonbonded pair potential energy of atom
+      */
+      virtual double 
+      atomEnergy(const Atom& atom, CellList::NeighborArray& neighbors) const
+      = 0;
+
       /**
       * Calculate the nonbonded pair energy for an entire Molecule.
       *
@@ -68,6 +86,60 @@ namespace McMd
       */
       virtual double moleculeEnergy(const Molecule& molecule) const = 0;
 
+      /**
+      * Calculate nonbonded pair energies of one Atom at several positions.
+      *
+      * Upon return, energies[k] is the value that atomEnergy(atom) would
+      * return if atom.position() were set to positions[k], for each
+      * 0 <= k < nTrial. The position of the atom itself is not used, and
+      * is not modified. Each position must lie within the primary cell.
+      *
+      * This function is intended for configuration bias moves, which
+      * evaluate the energy of one atom at several trial positions. The
+      * neighbors of all trial positions are retrieved from the CellList
+      * only once, and copied into a compact contiguous buffer that is 
+      * then reused for every trial. Energies are evaluated in blocks by
+      * a PairEnergyKernel, which is branch-free for LJPair, WcaPair and
+      * DpdPair. If the parent Simulation has more than one thread, 
+      * trials are divided among threads. Each energy is independent of 
+      * the number of threads.
+      *
+      * \param atom       Atom object of interest
+      * \param positions  array of nTrial trial positions (input)
+      * \param nTrial     number of trial positions
+      * \param energies   array of nTrial pair energies (output)
+      */
+      virtual 
+      void trialEnergies(const Atom& atom, const Vector* positions, 
+                         int nTrial, double* energies) const = 0;
+
+      /**
+      * Calculate pair energies of a test atom at many random positions.
+      *
+      * Upon return, energies[k] is the nonbonded pair energy of a test 
+      * atom of type typeId at positions[k] with all atoms in the CellList,
+      * for each 0 <= k < nPosition. The test atom is not part of the 
+      * system, so no pair is excluded or masked. Each position must lie 
+      * within the primary cell.
+      *
+      * This function is intended for Widom test particle insertion, in
+      * which positions are uniformly distributed in the box. Positions 
+      * are first sorted by cell of the CellList. The neighbors of each 
+      * occupied cell are then retrieved only once, and copied into a 
+      * compact contiguous buffer that is reused for every position in 
+      * that cell. If the parent Simulation has more than one thread, 
+      * cells are divided among threads. Each energy is independent of 
+      * the number of threads.
+      *
+      * \param typeId     atom type index of test atom
+      * \param positions  array of nPosition positions (input)
+      * \param nPosition  number of positions
+      * \param energies   array of nPosition pair energies (output)
+      */
+      virtual 
+      void insertionEnergies(int typeId, const Vector* positions, 
+                             int nPosition, double* energies) const = 0;
+
       //@}
       /// \name Cell List Management
       //@{
@@ -124,44 +196,259 @@ namespace McMd
       const CellList& cellList() const;
 
       //@}
+      #ifdef MCMD_PROFILE
+      /// \name Work counters (defined only if MCMD_PROFILE is defined)
+      //@{
+
+      /**
+      * Number of pair energy evaluations for an atom or trial position.
+      */
+      double nEnergy() const;
+
+      /**
+      * Number of neighboring atoms visited in energy evaluations.
+      */
+      double nNeighbor() const;
+
+      /**
+      * Number of atoms added to, removed from or moved within CellList.
+      */
+      double nCellUpdate() const;
+
+      //@}
+      #endif
 
    protected:
 
+      /**
+      * Workspace for pair energies of a group of nearby positions.
+      *
+      * Holds the positions, unwrapped relative to the first, and the
+      * unwrapped coordinates and atom types of their neighbors in 
+      * contiguous arrays. The constructor and destructor are defined 
+      * out of line, so that local buffers do not enlarge the code of 
+      * each McPairPotentialImpl template.
+      */
+      class TrialBuffer 
+      {
+      public:
+
+         /// Constructor.
+         TrialBuffer();
+
+         /// Destructor.
+         ~TrialBuffer();
+
+         /// Positions, unwrapped relative to the first.
+         GArray<Vector> positions;
+
+         /// Unwrapped x coordinates of neighbors.
+         GArray<double> x;
+
+         /// Unwrapped y coordinates of neighbors.
+         GArray<double> y;
+
+         /// Unwrapped z coordinates of neighbors.
+         GArray<double> z;
+
+         /// Atom type ids of neighbors.
+         GArray<int> typeIds;
+
+      };
+
+      /**
+      * Gather neighbors of a set of trial positions for one atom.
+      *
+      * On return, trialBuffer_ contains the trial positions, unwrapped
+      * to minimum images of positions[0], and the unwrapped coordinates
+      * and types of all unmasked atoms other than atom that lie within
+      * a distance maxPairCutoff() + dMax of positions[0], where dMax is
+      * the return value. This includes all neighbors of every trial 
+      * position.
+      *
+      * \param atom      atom being moved
+      * \param positions array of trial positions
+      * \param nTrial    number of trial positions (nTrial > 0)
+      * \return maximum distance of a trial position from positions[0]
+      */
+      double
+      gatherTrialNeighbors(const Atom& atom, const Vector* positions,
+                           int nTrial) const;
+
+      /**
+      * Sort insertion positions by cell.
+      *
+      * On return, insertionOrder_ lists the indices of positions sorted
+      * by cell, positions in cell ic occupy elements insertionBegins_[ic]
+      * to insertionBegins_[ic + 1] - 1 of insertionOrder_, and
+      * insertionCells_ lists the occupied cells.
+      *
+      * \param positions  array of insertion positions
+      * \param nPosition  number of insertion positions
+      */
+      void sortInsertionPositions(const Vector* positions, int nPosition)
+      const;
+
+      /**
+      * Gather neighbors of insertion positions in one cell.
+      *
+      * On return, buffer contains positions insertionOrder_[begin] to
+      * insertionOrder_[end - 1], unwrapped to minimum images of the 
+      * first, and the unwrapped coordinates and types of all atoms within
+      * a distance maxPairCutoff() + dMax of the first, where dMax is the
+      * return value. This function is thread safe if each thread passes 
+      * its own neighbors and buffer.
+      *
+      * \param positions array of all insertion positions
+      * \param begin     index in insertionOrder_ of first position
+      * \param end       index in insertionOrder_ of end position
+      * \param neighbors workspace for neighbor atoms
+      * \param buffer    positions and neighbors (output)
+      * \return maximum distance of a position from the first
+      */
+      double
+      gatherInsertionNeighbors(const Vector* positions, int begin, int end,
+                               CellList::NeighborArray& neighbors,
+                               TrialBuffer& buffer) const;
+
       /// Array to hold neighbors returned by a CellList.
       mutable CellList::NeighborArray neighbors_;
 
       /// Cell list for atom positions.
       CellList cellList_;
 
+      /// Array of atoms near any of a set of trial positions.
+      mutable GArray<Atom*> trialNeighbors_;
+
+      /// Trial positions and their neighbors, for trialEnergies().
+      mutable TrialBuffer trialBuffer_;
+
+      /// Indices of insertion positions, sorted by cell.
+      mutable GArray<int> insertionOrder_;
+
+      /// Index in insertionOrder_ of first position in each cell.
+      mutable GArray<int> insertionBegins_;
+
+      /// Index in insertionOrder_ of end of each cell, used while sorting.
+      mutable GArray<int> insertionEnds_;
+
+      /// Indices of cells that contain at least one insertion position.
+      mutable GArray<int> insertionCells_;
+
       /// Alias for global atoms_ DArray of parent simulation.
       // RArray<Atom> atoms_;
 
+      #ifdef MCMD_PROFILE
+      /**
+      * Increment work counters for pair energy evaluations.
+      *
+      * This function is thread safe.
+      *
+      * \param nEnergy   number of atoms or trial positions
+      * \param nNeighbor number of neighbor atoms visited
+      */
+      void countEnergy(double nEnergy, double nNeighbor) const;
+
+      /**
+      * Increment the counter of cell list updates (thread safe).
+      *
+      * \param nUpdate number of atoms added, removed or moved
+      */
+      void countCellUpdate(double nUpdate);
+
+   private:
+
+      /// Number of pair energy evaluations.
+      mutable double nEnergy_;
+
+      /// Number of neighbor atoms visited.
+      mutable double nNeighbor_;
+
+      /// Number of cell list updates.
+      double nCellUpdate_;
+      #endif
+
    };
 
    // Inline functions
   
    // Add an atom to CellList.
    inline void McPairPotential::addAtom(Atom &atom)
-   {  cellList_.addAtom(atom); }
+   {  
+      cellList_.addAtom(atom); 
+      #ifdef MCMD_PROFILE
+      countCellUpdate(1.0);
+      #endif
+   }
 
    // Delete an atom from the CellList.
    inline void McPairPotential::deleteAtom(Atom &atom)
-   {  cellList_.deleteAtom(atom); }
+   {  
+      cellList_.deleteAtom(atom); 
+      #ifdef MCMD_PROFILE
+      countCellUpdate(1.0);
+      #endif
+   }
 
    // Update the cell list to reflect a new Atom position.
    inline void McPairPotential::updateAtomCell(Atom &atom)
-   {  cellList_.updateAtomCell(atom, atom.position()); }
+   {  
+      cellList_.updateAtomCell(atom, atom.position()); 
+      #ifdef MCMD_PROFILE
+      countCellUpdate(1.0);
+      #endif
+   }
 
    // Move atom to a new position.
    inline void McPairPotential::moveAtom(Atom &atom, const Vector &position)
    {
       atom.position() = position;
       cellList_.updateAtomCell(atom, position);
+      #ifdef MCMD_PROFILE
+      countCellUpdate(1.0);
+      #endif
    }
 
    // Get the cellList by const reference.
    inline const CellList& McPairPotential::cellList() const
    { return cellList_; }
 
+   #ifdef MCMD_PROFILE
+   // Get number of pair energy evaluations.
+   inline double McPairPotential::nEnergy() const
+   {  return nEnergy_; }
+
+   // Get number of neighbor atoms visited.
+   inline double McPairPotential::nNeighbor() const
+   {  return nNeighbor_; }
+
+   // Get number of cell list updates.
+   inline double McPairPotential::nCellUpdate() const
+   {  return nCellUpdate_; }
+
+   // Increment energy evaluation counters.
+   inline 
+   void McPairPotential::countEnergy(double nEnergy, double nNeighbor) const
+   {
+      #ifdef MCMD_OPENMP
+      #pragma omp atomic
+      #endif
+      nEnergy_ += nEnergy;
+      #ifdef MCMD_OPENMP
+      #pragma omp atomic
+      #endif
+      nNeighbor_ += nNeighbor;
+   }
+
+   // Increment cell list update counter.
+   inline void McPairPotential::countCellUpdate(double nUpdate)
+   {
+      #ifdef MCMD_OPENMP
+      #pragma omp atomic
+      #endif
+      nCellUpdate_ += nUpdate;
+   }
+   #endif
+
 } 
 #endif
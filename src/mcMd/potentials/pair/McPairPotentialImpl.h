@@ -9,9 +9,12 @@
 */
 
 #include <mcMd/potentials/pair/McPairPotential.h>
+#include <mcMd/potentials/pair/PairEnergyKernel.h>
 #include <util/boundary/Boundary.h>
 #include <util/global.h>
 
+#define PAIR_ENERGY_BLOCK_SIZE 64
+
 namespace Util
 {
    class Vector;
@@ -136,6 +139,17 @@ namespace McMd
       */
       double atomEnergy(const Atom& atom) const;
 
+      /**
+      * Calculate the nonbonded pair energy for one Atom, using a
+      * neighbor array supplied by the caller.
+      *
+      * \param  atom Atom object of interest
+      * \param  neighbors  workspace array for neighbors (modified)
+      * \return nonbonded pair potential energy of atom
+      */
+      double 
+      atomEnergy(const Atom& atom, CellList::NeighborArray& neighbors) const;
+
       /**
       * Calculate the nonbonded pair energy for an entire Molecule.
       *
@@ -144,6 +158,28 @@ namespace McMd
       */
       double moleculeEnergy(const Molecule& molecule) const;
 
+      /**
+      * Calculate nonbonded pair energies of one Atom at several positions.
+      *
+      * \param atom       Atom object of interest
+      * \param positions  array of nTrial trial positions (input)
+      * \param nTrial     number of trial positions
+      * \param energies   array of nTrial pair energies (output)
+      */
+      void trialEnergies(const Atom& atom, const Vector* positions, 
+                         int nTrial, double* energies) const;
+
+      /**
+      * Calculate pair energies of a test atom at many random positions.
+      *
+      * \param typeId     atom type index of test atom
+      * \param positions  array of nPosition positions (input)
+      * \param nPosition  number of positions
+      * \param energies   array of nPosition pair energies (output)
+      */
+      void insertionEnergies(int typeId, const Vector* positions, 
+                             int nPosition, double* energies) const;
+
       /**
       * Return total nonbonded pair potential energy of this System.
       */
@@ -179,6 +215,25 @@ namespace McMd
       template <typename T>
       void computeStressImpl(T& stress) const;
 
+      /**
+      * Return the pair energy of one position with a set of neighbors.
+      *
+      * Neighbor coordinates in buffer must be unwrapped relative to the
+      * position. If isCompact is false, the minimum image convention is 
+      * applied to each separation. Otherwise, separations are used as
+      * given.
+      *
+      * \param kernel    energy kernel for this interaction
+      * \param typeId    atom type id of the position
+      * \param position  unwrapped position
+      * \param buffer    unwrapped coordinates and types of neighbors
+      * \param isCompact true if all separations are minimum images
+      */
+      double positionEnergy(const PairEnergyKernel<Interaction>& kernel,
+                            int typeId, const Vector& position,
+                            const TrialBuffer& buffer, bool isCompact) 
+      const;
+
    };
 
 }
@@ -195,6 +250,7 @@ namespace McMd
 #include <util/accumulators/setToZero.h>
 
 #include <fstream>
+#include <math.h>
 
 namespace McMd
 {
@@ -292,6 +348,15 @@ namespace McMd
    */
    template <class Interaction>
    double McPairPotentialImpl<Interaction>::atomEnergy(const Atom &atom) const
+   {  return atomEnergy(atom, neighbors_); }
+
+   /* 
+   * Return nonbonded pair energy for one Atom, with a supplied workspace.
+   */
+   template <class Interaction>
+   double 
+   McPairPotentialImpl<Interaction>::atomEnergy(const Atom &atom, 
+                                CellList::NeighborArray& neighbors) const
    {
       Atom   *jAtomPtr;
       double  energy;
@@ -300,13 +365,16 @@ namespace McMd
       int     id = atom.id();
 
       // Get array of neighbors
-      cellList_.getNeighbors(atom.position(), neighbors_);
-      nNeighbor = neighbors_.size();
+      cellList_.getNeighbors(atom.position(), neighbors);
+      nNeighbor = neighbors.size();
+      #ifdef MCMD_PROFILE
+      countEnergy(1.0, double(nNeighbor));
+      #endif
 
       // Loop over neighboring atoms
       energy = 0.0;
       for (j = 0; j < nNeighbor; ++j) {
-         jAtomPtr = neighbors_[j];
+         jAtomPtr = neighbors[j];
          jId      = jAtomPtr->id();
 
          // Check if atoms are the same
@@ -324,6 +392,166 @@ namespace McMd
       return energy;
    }
 
+   /* 
+   * Return nonbonded pair energies of one Atom at several positions.
+   */
+   template <class Interaction>
+   void 
+   McPairPotentialImpl<Interaction>::trialEnergies(const Atom& atom, 
+                                                   const Vector* positions, 
+                                                   int nTrial, 
+                                                   double* energies) const
+   {
+      if (nTrial <= 0) return;
+
+      // Unwrap trial positions and gather their neighbors (out of line).
+      double dMax = gatherTrialNeighbors(atom, positions, nTrial);
+      bool isCompact = 
+           (maxPairCutoff() + 2.0*dMax < 0.5*boundary().minLength());
+      int typeId = atom.typeId();
+      int k;
+      PairEnergyKernel<Interaction> kernel;
+      kernel.setInteraction(interaction(), simulation().nAtomType());
+
+      // Trials may be divided among threads. Each energy is computed by
+      // one thread, in the same order, for any number of threads.
+      #ifdef MCMD_OPENMP
+      int nThread = simulation().nThread();
+      #pragma omp parallel for num_threads(nThread) schedule(static) \
+                               if (nThread > 1)
+      #endif
+      for (k = 0; k < nTrial; ++k) {
+         energies[k] = positionEnergy(kernel, typeId, 
+                                      trialBuffer_.positions[k],
+                                      trialBuffer_, isCompact);
+      }
+   }
+
+   /*
+   * Calculate pair energies of a test atom at many random positions.
+   */
+   template <class Interaction>
+   void 
+   McPairPotentialImpl<Interaction>::insertionEnergies(int typeId, 
+                                                 const Vector* positions, 
+                                                 int nPosition, 
+                                                 double* energies) const
+   {
+      if (nPosition <= 0) return;
+
+      // Sort positions by cell (out of line)
+      sortInsertionPositions(positions, nPosition);
+
+      const int* order = &insertionOrder_[0];
+      const int* begins = &insertionBegins_[0];
+      const int* cells = &insertionCells_[0];
+      double minLength = boundary().minLength();
+      double cutoff = maxPairCutoff();
+      int nOccupied = insertionCells_.size();
+      PairEnergyKernel<Interaction> kernel;
+      kernel.setInteraction(interaction(), simulation().nAtomType());
+
+      // Occupied cells may be divided among threads. Each energy is 
+      // computed by one thread, in the same order, for any number of 
+      // threads.
+      #ifdef MCMD_OPENMP
+      int nThread = simulation().nThread();
+      #pragma omp parallel num_threads(nThread) if (nThread > 1)
+      #endif
+      {
+         CellList::NeighborArray neighbors;
+         TrialBuffer buffer;
+         double dMax;
+         int m, n, begin, end;
+         bool isCompact;
+
+         #ifdef MCMD_OPENMP
+         #pragma omp for schedule(dynamic, 16)
+         #endif
+         for (m = 0; m < nOccupied; ++m) {
+            begin = begins[cells[m]];
+            end = begins[cells[m] + 1];
+
+            // Unwrap positions in this cell and gather neighbors of 
+            // all of them (out of line).
+            dMax = gatherInsertionNeighbors(positions, begin, end, 
+                                            neighbors, buffer);
+            isCompact = (cutoff + 2.0*dMax < 0.5*minLength);
+
+            // Loop over positions in this cell
+            for (n = begin; n < end; ++n) {
+               energies[order[n]] = 
+                     positionEnergy(kernel, typeId, 
+                                    buffer.positions[n - begin], 
+                                    buffer, isCompact);
+            }
+         }
+      }
+   }
+
+   /*
+   * Return the pair energy of one position with a set of neighbors.
+   */
+   template <class Interaction>
+   double 
+   McPairPotentialImpl<Interaction>::positionEnergy(
+                              const PairEnergyKernel<Interaction>& kernel,
+                              int typeId, const Vector& position,
+                              const TrialBuffer& buffer, bool isCompact) 
+   const
+   {
+      int nNeighbor = buffer.typeIds.size();
+      if (nNeighbor == 0) return 0.0;
+
+      const double* x = &buffer.x[0];
+      const double* y = &buffer.y[0];
+      const double* z = &buffer.z[0];
+      const int* types = &buffer.typeIds[0];
+      const Vector& lengths = boundary().lengths();
+      double rsqBlock[PAIR_ENERGY_BLOCK_SIZE];
+      double energy = 0.0;
+      double dx, dy, dz;
+      int    i, i0, m;
+
+      // Squared distances are computed for blocks of neighbors, and
+      // passed to the kernel.
+      for (i0 = 0; i0 < nNeighbor; i0 += PAIR_ENERGY_BLOCK_SIZE) {
+         m = nNeighbor - i0;
+         if (m > PAIR_ENERGY_BLOCK_SIZE) m = PAIR_ENERGY_BLOCK_SIZE;
+         if (isCompact) {
+            // All separations within the cutoff are minimum images, so
+            // no boundary conditions are needed.
+            for (i = 0; i < m; ++i) {
+               dx = x[i0 + i] - position[0];
+               dy = y[i0 + i] - position[1];
+               dz = z[i0 + i] - position[2];
+               rsqBlock[i] = dx*dx + dy*dy + dz*dz;
+            }
+         } else {
+            // Small periodic cell: apply the minimum image convention,
+            // using cached box lengths. Unwrapped separations are less 
+            // than one box length, so at most one shift is needed.
+            for (i = 0; i < m; ++i) {
+               dx = x[i0 + i] - position[0];
+               dy = y[i0 + i] - position[1];
+               dz = z[i0 + i] - position[2];
+               if (fabs(dx) > 0.5*lengths[0]) {
+                  dx -= (dx > 0.0) ? lengths[0] : -lengths[0];
+               }
+               if (fabs(dy) > 0.5*lengths[1]) {
+                  dy -= (dy > 0.0) ? lengths[1] : -lengths[1];
+               }
+               if (fabs(dz) > 0.5*lengths[2]) {
+                  dz -= (dz > 0.0) ? lengths[2] : -lengths[2];
+               }
+               rsqBlock[i] = dx*dx + dy*dy + dz*dz;
+            }
+         }
+         energy += kernel.energy(typeId, types + i0, rsqBlock, m);
+      }
+      return energy;
+   }
+
    /* 
    * Return nonbonded pair potential energy for one Molecule.
    */
@@ -344,6 +572,9 @@ namespace McMd
          // Get array of neighbors
          cellList_.getNeighbors(iAtomPtr->position(), neighbors_);
          nNeighbor = neighbors_.size();
+         #ifdef MCMD_PROFILE
+         countEnergy(1.0, double(nNeighbor));
+         #endif
    
          // Loop over neighboring atoms
          for (j = 0; j < nNeighbor; ++j) {
@@ -389,6 +620,9 @@ namespace McMd
          // Get array of neighbors
          cellList_.getCellNeighbors(ic, neighbors_, nInCell);
          nNeighbor = neighbors_.size();
+         #ifdef MCMD_PROFILE
+         countEnergy(double(nInCell), double(nInCell)*double(nNeighbor));
+         #endif
   
          // Loop over primary atoms in this cell
          for (i = 0; i < nInCell; ++i) {
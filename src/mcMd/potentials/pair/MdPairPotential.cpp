@@ -8,6 +8,8 @@
 #include "MdPairPotential.h"
 #include <mcMd/simulation/System.h> 
 #include <mcMd/simulation/Simulation.h> 
+#include <mcMd/chemistry/Molecule.h> 
+#include <mcMd/chemistry/Atom.h> 
 #include <util/boundary/Boundary.h> 
 
 #include <util/global.h> 
@@ -24,7 +26,9 @@ namespace McMd
    */
    MdPairPotential::MdPairPotential(System& system)
     : ParamComposite(),
-      SubSystem(system)
+      SubSystem(system),
+      threadForces_(),
+      threadForceCapacity_(0)
    {  setClassName("MdPairPotential"); }
  
    /* 
@@ -79,4 +83,53 @@ namespace McMd
    bool MdPairPotential::isPairListCurrent() 
    { return pairList_.isCurrent(boundary()); }
 
+   /*
+   * Allocate zeroed force accumulator arrays for nThread threads.
+   */
+   void MdPairPotential::allocateThreadForces(int nThread)
+   {
+      int capacity = simulation().atomCapacity();
+      if (threadForces_.isAllocated()) {
+         if (threadForces_.capacity() == nThread*capacity) {
+            return;
+         }
+         threadForces_.deallocate();
+      }
+      threadForces_.allocate(nThread*capacity);
+      for (int i = 0; i < nThread*capacity; ++i) {
+         threadForces_[i].zero();
+      }
+      threadForceCapacity_ = capacity;
+   }
+
+   /*
+   * Add thread force accumulators to atomic forces, and zero them.
+   */
+   void MdPairPotential::addThreadForces(int nThread)
+   {
+      int nSpecies = simulation().nSpecies();
+      int iSpecies, nMolecule;
+      for (iSpecies = 0; iSpecies < nSpecies; ++iSpecies) {
+         nMolecule = system().nMolecule(iSpecies);
+         #ifdef MCMD_OPENMP
+         #pragma omp parallel for num_threads(nThread) schedule(static)
+         #endif
+         for (int iMol = 0; iMol < nMolecule; ++iMol) {
+            Molecule& molecule = system().molecule(iSpecies, iMol);
+            Vector* forcePtr;
+            int nAtom = molecule.nAtom();
+            int i, j, id;
+            for (i = 0; i < nAtom; ++i) {
+               Atom& atom = molecule.atom(i);
+               id = atom.id();
+               for (j = 0; j < nThread; ++j) {
+                  forcePtr = &threadForces_[j*threadForceCapacity_ + id];
+                  atom.force() += *forcePtr;
+                  forcePtr->zero();
+               }
+            }
+         }
+      }
+   }
+
 }
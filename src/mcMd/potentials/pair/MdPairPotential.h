@@ -12,12 +12,13 @@
 #include <util/param/ParamComposite.h>            // base class
 #include <mcMd/potentials/pair/PairPotential.h>   // base class
 #include <mcMd/neighbor/PairList.h>               // member
+#include <util/containers/DArray.h>               // member template
+#include <util/space/Vector.h>                    // member template argument
 
 #include <util/global.h>
 
 namespace Util
 {
-   class Vector;
    class Tensor;
 }
 
@@ -55,7 +56,8 @@ namespace McMd
       * Adds non-bonded pair forces to the current values of the forces
       * for all atoms in this system. Before calculating forces, this
       * function checks if the pair list is current, and rebuilds it if 
-      * necessary.
+      * necessary. If the parent Simulation has nThread() > 1, pairs are
+      * divided among threads by primary atom (requires MCMD_OPENMP).
       */
       virtual void addForces() = 0;
 
@@ -98,6 +100,42 @@ namespace McMd
       /// Verlet neighbor pair list for nonbonded interactions.
       PairList pairList_;
 
+      /**
+      * Allocate force accumulator arrays for nThread threads, if needed.
+      *
+      * Each thread adds pair forces to its own array, indexed by atom id,
+      * and the arrays are then summed by addThreadForces(). New arrays
+      * are set to zero. Must be called outside of any parallel region.
+      *
+      * \param nThread  number of threads
+      */
+      void allocateThreadForces(int nThread);
+
+      /**
+      * Get the force accumulator array for one thread.
+      *
+      * \param threadId  thread index, 0 <= threadId < nThread
+      */
+      Vector* threadForces(int threadId);
+
+      /**
+      * Add thread force arrays to atomic forces, and zero the arrays.
+      *
+      * This function executes its own parallel region, and must be called
+      * outside of any parallel region.
+      *
+      * \param nThread  number of threads
+      */
+      void addThreadForces(int nThread);
+
+   private:
+
+      /// Force accumulators for all threads, atomCapacity elements each.
+      DArray<Vector> threadForces_;
+
+      /// Number of elements of threadForces_ per thread.
+      int threadForceCapacity_;
+
    };
 
    // Inline functions
@@ -108,5 +146,11 @@ namespace McMd
    inline const PairList& MdPairPotential::pairList() const
    {  return pairList_; }
 
+   /*
+   * Return force accumulator array for one thread.
+   */
+   inline Vector* MdPairPotential::threadForces(int threadId)
+   {  return &threadForces_[threadId*threadForceCapacity_]; }
+
 } 
 #endif
@@ -332,18 +332,30 @@ namespace McMd
          buildPairList();
       }
 
-      // Loop over pairs
-      PairIterator iter;
-      Atom *atom0Ptr;
-      Atom *atom1Ptr;
-      double rsq;
+      // Loop over pairs, divided among threads by primary atom
+      int nAtom1 = pairList_.nAtom1();
       double energy=0;
-      for (pairList_.begin(iter); iter.notEnd(); ++iter) {
-         iter.getPair(atom0Ptr, atom1Ptr);
-         rsq = boundary().
-               distanceSq(atom0Ptr->position(), atom1Ptr->position());
-         energy += interaction().
-                   energy(rsq, atom0Ptr->typeId(), atom1Ptr->typeId());
+      #ifdef MCMD_OPENMP
+      int nThread = simulation().nThread();
+      #pragma omp parallel num_threads(nThread) if (nThread > 1) \
+              reduction(+:energy)
+      #endif
+      {
+         int nTeam = Simulation::nTeamThread();
+         int threadId = Simulation::threadId();
+         PairIterator iter;
+         Atom *atom0Ptr;
+         Atom *atom1Ptr;
+         double rsq;
+         pairList_.begin(iter, threadId*nAtom1/nTeam,
+                         (threadId + 1)*nAtom1/nTeam);
+         for ( ; iter.notEnd(); ++iter) {
+            iter.getPair(atom0Ptr, atom1Ptr);
+            rsq = boundary().
+                  distanceSq(atom0Ptr->position(), atom1Ptr->position());
+            energy += interaction().
+                      energy(rsq, atom0Ptr->typeId(), atom1Ptr->typeId());
+         }
       }
 
       return energy;
@@ -367,6 +379,39 @@ namespace McMd
       Atom        *atom1Ptr;
       int          type0, type1;
 
+      #ifdef MCMD_OPENMP
+      // Divide pairs among threads by primary atom. Each thread adds 
+      // forces to a private array, to avoid races on secondary atoms.
+      int nThread = simulation().nThread();
+      if (nThread > 1) {
+         int nAtom1 = pairList_.nAtom1();
+         allocateThreadForces(nThread);
+         #pragma omp parallel num_threads(nThread) \
+                 private(iter, force, rsq, atom0Ptr, atom1Ptr, type0, type1)
+         {
+            int nTeam = Simulation::nTeamThread();
+            int threadId = Simulation::threadId();
+            Vector* forces = threadForces(threadId);
+            pairList_.begin(iter, threadId*nAtom1/nTeam,
+                            (threadId + 1)*nAtom1/nTeam);
+            for ( ; iter.notEnd(); ++iter) {
+               iter.getPair(atom0Ptr, atom1Ptr);
+               rsq = boundary().distanceSq(atom0Ptr->position(), 
+                                           atom1Ptr->position(), force);
+               type0 = atom0Ptr->typeId();
+               type1 = atom1Ptr->typeId();
+               if (rsq < interaction().cutoffSq(type0, type1)) { 
+                  force *= interaction().forceOverR(rsq, type0, type1);
+                  forces[atom0Ptr->id()] += force;
+                  forces[atom1Ptr->id()] -= force;
+               }
+            }
+         }
+         addThreadForces(nThread);
+         return;
+      }
+      #endif
+
       // Loop over nonbonded neighbor pairs
       for (pairList_.begin(iter); iter.notEnd(); ++iter) {
          iter.getPair(atom0Ptr, atom1Ptr);
@@ -0,0 +1,257 @@
+#ifndef MCMD_PAIR_ENERGY_KERNEL_H
+#define MCMD_PAIR_ENERGY_KERNEL_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <inter/pair/LJPair.h>
+#include <inter/pair/WcaPair.h>
+#include <inter/pair/DpdPair.h>
+#include <util/global.h>
+
+#include <math.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * Block evaluation of pair energies for a pair interaction class.
+   *
+   * A PairEnergyKernel returns the total pair energy of a block of pairs
+   * that share a common first atom, given arrays of squared distances
+   * and of the types of the other atoms. It is used by McPairPotentialImpl
+   * to compute energies of trial positions from contiguous coordinate
+   * arrays.
+   *
+   * The generic template simply calls Interaction::energy for each pair.
+   * Specializations for particular interaction classes copy the required
+   * parameters into flat tables and evaluate the energy with a loop that
+   * contains no function calls or branches, which the compiler can
+   * vectorize.
+   *
+   * Usage:
+   * \code
+   *    PairEnergyKernel<Interaction> kernel;
+   *    kernel.setInteraction(interaction, nAtomType);
+   *    energy = kernel.energy(type0, types, rsq, n);
+   * \endcode
+   * The setInteraction() function must be called again after any change
+   * in the parameters of the interaction.
+   *
+   * \ingroup McMd_Pair_Module
+   */
+   template <class Interaction>
+   class PairEnergyKernel
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      PairEnergyKernel()
+       : interactionPtr_(0)
+      {}
+
+      /**
+      * Set the associated interaction and copy parameters.
+      *
+      * \param interaction pair interaction object
+      * \param nAtomType   number of atom types
+      */
+      void setInteraction(const Interaction& interaction, int nAtomType)
+      {  interactionPtr_ = &interaction; }
+
+      /**
+      * Return the total energy of a block of pairs.
+      *
+      * \param type0  type id of the first atom of every pair
+      * \param types  array of type ids of the other atoms
+      * \param rsq    array of squared separations
+      * \param n      number of pairs in the block
+      */
+      double energy(int type0, const int* types, const double* rsq, int n)
+      const
+      {
+         double sum = 0.0;
+         for (int k = 0; k < n; ++k) {
+            sum += interactionPtr_->energy(rsq[k], type0, types[k]);
+         }
+         return sum;
+      }
+
+   private:
+
+      const Interaction* interactionPtr_;
+
+   };
+
+   /**
+   * PairEnergyKernel specialization for the cutoff Lennard-Jones interaction.
+   *
+   * \ingroup McMd_Pair_Module
+   */
+   template <>
+   class PairEnergyKernel<Inter::LJPair>
+   {
+
+   public:
+
+      /**
+      * Copy parameters from an LJPair (or WcaPair) interaction.
+      *
+      * \param interaction pair interaction object
+      * \param nAtomType   number of atom types
+      */
+      void setInteraction(const Inter::LJPair& interaction, int nAtomType)
+      {
+         double sigma, r6i;
+         int i, j, k;
+         for (i = 0; i < nAtomType; ++i) {
+            for (j = 0; j < nAtomType; ++j) {
+               k = i*MaxAtomType + j;
+               sigma = interaction.sigma(i, j);
+               sigmaSq_[k] = sigma*sigma;
+               rsqMin_[k] = 0.6*sigmaSq_[k];
+               eps4_[k] = 4.0*interaction.epsilon(i, j);
+               cutoffSq_[k] = interaction.cutoffSq(i, j);
+               r6i = sigmaSq_[k]/cutoffSq_[k];
+               r6i = r6i*r6i*r6i;
+               shift_[k] = -eps4_[k]*(r6i*r6i - r6i);
+            }
+         }
+      }
+
+      /**
+      * Return the total energy of a block of pairs.
+      *
+      * As in LJPair::energy, squared separations less than 0.6*sigma^2
+      * are replaced by 0.6*sigma^2.
+      *
+      * \param type0  type id of the first atom of every pair
+      * \param types  array of type ids of the other atoms
+      * \param rsq    array of squared separations
+      * \param n      number of pairs in the block
+      */
+      double energy(int type0, const int* types, const double* rsq, int n)
+      const
+      {
+         const double* sigmaSq = &sigmaSq_[type0*MaxAtomType];
+         const double* rsqMin = &rsqMin_[type0*MaxAtomType];
+         const double* eps4 = &eps4_[type0*MaxAtomType];
+         const double* shift = &shift_[type0*MaxAtomType];
+         const double* cutoffSq = &cutoffSq_[type0*MaxAtomType];
+         double sum = 0.0;
+         double r2, r6i, e;
+         int k, t;
+         for (k = 0; k < n; ++k) {
+            t = types[k];
+            r2 = (rsq[k] < rsqMin[t]) ? rsqMin[t] : rsq[k];
+            r6i = sigmaSq[t]/r2;
+            r6i = r6i*r6i*r6i;
+            e = eps4[t]*(r6i*r6i - r6i) + shift[t];
+            sum += (rsq[k] < cutoffSq[t]) ? e : 0.0;
+         }
+         return sum;
+      }
+
+   private:
+
+      static const int MaxAtomType = 4;
+
+      double sigmaSq_[MaxAtomType*MaxAtomType];
+      double rsqMin_[MaxAtomType*MaxAtomType];
+      double eps4_[MaxAtomType*MaxAtomType];
+      double shift_[MaxAtomType*MaxAtomType];
+      double cutoffSq_[MaxAtomType*MaxAtomType];
+
+   };
+
+   /**
+   * PairEnergyKernel specialization for the WCA interaction.
+   *
+   * The WcaPair class is a subclass of LJPair that differs only in the
+   * choice of cutoff, and so can use the same kernel.
+   *
+   * \ingroup McMd_Pair_Module
+   */
+   template <>
+   class PairEnergyKernel<Inter::WcaPair>
+    : public PairEnergyKernel<Inter::LJPair>
+   {};
+
+   /**
+   * PairEnergyKernel specialization for the DPD soft-core interaction.
+   *
+   * \ingroup McMd_Pair_Module
+   */
+   template <>
+   class PairEnergyKernel<Inter::DpdPair>
+   {
+
+   public:
+
+      /**
+      * Copy parameters from a DpdPair interaction.
+      *
+      * \param interaction pair interaction object
+      * \param nAtomType   number of atom types
+      */
+      void setInteraction(const Inter::DpdPair& interaction, int nAtomType)
+      {
+         double sigma;
+         int i, j, k;
+         for (i = 0; i < nAtomType; ++i) {
+            for (j = 0; j < nAtomType; ++j) {
+               k = i*MaxAtomType + j;
+               sigma = interaction.sigma(i, j);
+               sigma_[k] = sigma;
+               sigmaSq_[k] = sigma*sigma;
+               ce_[k] = 0.5*interaction.epsilon(i, j)/(sigma*sigma);
+            }
+         }
+      }
+
+      /**
+      * Return the total energy of a block of pairs.
+      *
+      * \param type0  type id of the first atom of every pair
+      * \param types  array of type ids of the other atoms
+      * \param rsq    array of squared separations
+      * \param n      number of pairs in the block
+      */
+      double energy(int type0, const int* types, const double* rsq, int n)
+      const
+      {
+         const double* sigma = &sigma_[type0*MaxAtomType];
+         const double* sigmaSq = &sigmaSq_[type0*MaxAtomType];
+         const double* ce = &ce_[type0*MaxAtomType];
+         double sum = 0.0;
+         double dr;
+         int k, t;
+         for (k = 0; k < n; ++k) {
+            t = types[k];
+            dr = sqrt(rsq[k]) - sigma[t];
+            sum += (rsq[k] < sigmaSq[t]) ? ce[t]*dr*dr : 0.0;
+         }
+         return sum;
+      }
+
+   private:
+
+      static const int MaxAtomType = 4;
+
+      double sigma_[MaxAtomType*MaxAtomType];
+      double sigmaSq_[MaxAtomType*MaxAtomType];
+      double ce_[MaxAtomType*MaxAtomType];
+
+   };
+
+}
+#endif
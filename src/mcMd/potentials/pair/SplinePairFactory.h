@@ -0,0 +1,61 @@
+#ifndef MCMD_SPLINE_PAIR_FACTORY_H
+#define MCMD_SPLINE_PAIR_FACTORY_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/potentials/pair/PairFactory.h>  // base class
+
+namespace McMd
+{
+
+   /**
+   * Factory for pair potentials with a SplinePair interaction.
+   *
+   * The default PairFactory uses this class to create McPairPotential
+   * and MdPairPotential objects for the SplinePair<LJPair>, 
+   * SplinePair<WcaPair> and SplinePair<DpdPair> interactions. See
+   * TabulatedPairFactory.
+   *
+   * \ingroup McMd_Pair_Module
+   */
+   class SplinePairFactory : public PairFactory
+   {
+
+   public:
+
+      /**
+      * Return a pointer to a new McPairPotential, if possible.
+      *
+      * \param subclass name of desired interaction class
+      * \param system   associated System
+      */
+      virtual
+      McPairPotential* mcFactory(const std::string& subclass,
+                                 System& system) const;
+
+      /**
+      * Return a pointer to a new MdPairPotential, if possible.
+      *
+      * \param subclass name of desired interaction class
+      * \param system   associated System
+      */
+      virtual
+      MdPairPotential* mdFactory(const std::string& subclass,
+                                 System& system) const;
+
+      /**
+      * Create an MdPairPotential from a McPairPotential, if possible.
+      *
+      * \param potential McPairPotential to be cloned
+      */
+      virtual MdPairPotential* mdFactory(McPairPotential& potential) const;
+
+   };
+
+}
+#endif
@@ -1,7 +1,10 @@
 mcMd_potentials_pair_=\
+    mcMd/potentials/pair/CompensatedPairFactory.cpp \
     mcMd/potentials/pair/McPairPotential.cpp \
     mcMd/potentials/pair/MdPairPotential.cpp \
-    mcMd/potentials/pair/PairFactory.cpp
+    mcMd/potentials/pair/PairFactory.cpp \
+    mcMd/potentials/pair/SplinePairFactory.cpp \
+    mcMd/potentials/pair/TabulatedPairFactory.cpp
 
 mcMd_potentials_pair_SRCS=\
      $(addprefix $(SRC_DIR)/, $(mcMd_potentials_pair_))
@@ -0,0 +1,240 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "RestartWriter.h"
+#include <util/archives/Serializable_includes.h>
+#include <util/format/Int.h>
+#include <util/format/Dbl.h>
+#include <util/misc/Log.h>
+#include <util/misc/Timer.h>
+
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <cerrno>
+#include <unistd.h>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   RestartWriter::RestartWriter()
+    : data_(),
+      filename_(),
+      latency_(0.0),
+      maxLatency_(0.0),
+      fileTime_(0.0),
+      maxFileTime_(0.0),
+      nWrite_(0),
+      nCopy_(1),
+      hasError_(false),
+      isWriting_(false)
+   {}
+
+   /*
+   * Destructor.
+   */
+   RestartWriter::~RestartWriter()
+   {
+      #ifdef MCMD_PTHREAD
+      if (isWriting_) {
+         pthread_join(thread_, 0);
+         isWriting_ = false;
+      }
+      #endif
+   }
+
+   /*
+   * Set number of rolling copies.
+   */
+   void RestartWriter::setNCopy(int nCopy)
+   {
+      if (nCopy < 1) {
+         UTIL_THROW("nCopy < 1");
+      }
+      nCopy_ = nCopy;
+   }
+
+   /*
+   * Save object to memory, then write a restart file.
+   */
+   void RestartWriter::write(Serializable& object,
+                             const std::string& filename)
+   {
+      Timer timer;
+      timer.start();
+
+      // Wait for the previous write, if any
+      finish();
+
+      // Save object state through an archive whose stream writes to memory
+      {
+         std::stringbuf buffer(std::ios_base::out | std::ios_base::binary);
+         Serializable::OArchive ar;
+         ar.file().std::ios::rdbuf(&buffer);
+         object.save(ar);
+         ar.file().std::ios::rdbuf(0);
+         data_ = buffer.str();
+      }
+      filename_ = filename;
+
+      #ifdef MCMD_PTHREAD
+      isWriting_ = true;
+      if (pthread_create(&thread_, 0, &RestartWriter::run, this)) {
+         isWriting_ = false;
+         writeFile();
+      }
+      #else
+      writeFile();
+      #endif
+
+      timer.stop();
+      double latency = timer.time();
+      latency_ += latency;
+      if (latency > maxLatency_) {
+         maxLatency_ = latency;
+      }
+      ++nWrite_;
+
+      #ifndef MCMD_PTHREAD
+      finish();
+      #endif
+   }
+
+   /*
+   * Wait for completion of any pending write.
+   */
+   void RestartWriter::finish()
+   {
+      #ifdef MCMD_PTHREAD
+      if (isWriting_) {
+         pthread_join(thread_, 0);
+         isWriting_ = false;
+      }
+      #endif
+      if (hasError_) {
+         hasError_ = false;
+         Log::file() << "Restart file name: " << filename_ << std::endl;
+         UTIL_THROW("Error writing restart file");
+      }
+   }
+
+   /*
+   * Write data_ to a temporary file, rotate copies, and rename.
+   *
+   * This function may be executed by the background thread. It must not
+   * throw, and does not write to the log file.
+   */
+   void RestartWriter::writeFile()
+   {
+      Timer timer;
+      timer.start();
+
+      std::string tmpname = filename_ + ".tmp";
+      std::ofstream file(tmpname.c_str(),
+                         std::ios_base::out | std::ios_base::binary);
+      if (file.is_open()) {
+         file.write(data_.data(), data_.size());
+         file.close();
+      }
+      if (file.fail()) {
+         hasError_ = true;
+         return;
+      }
+
+      // Shift older copies, name.(k-1) -> name.k, then link name.1 to
+      // the current file, so that a restart file exists at all times.
+      if (nCopy_ > 1) {
+         std::string oldname, newname;
+         for (int k = nCopy_ - 1; k > 1; --k) {
+            std::stringstream ssold, ssnew;
+            ssold << filename_ << "." << k - 1;
+            ssnew << filename_ << "." << k;
+            oldname = ssold.str();
+            newname = ssnew.str();
+            std::rename(oldname.c_str(), newname.c_str());
+         }
+         newname = filename_ + ".1";
+         std::remove(newname.c_str());
+         if (link(filename_.c_str(), newname.c_str())) {
+            // ENOENT: no current file (first write). Otherwise, e.g. if
+            // the file system does not support hard links, move the
+            // current file instead.
+            if (errno != ENOENT) {
+               if (std::rename(filename_.c_str(), newname.c_str())) {
+                  hasError_ = true;
+                  return;
+               }
+            }
+         }
+      }
+
+      // Atomically replace the restart file
+      if (std::rename(tmpname.c_str(), filename_.c_str())) {
+         hasError_ = true;
+      }
+
+      timer.stop();
+      double time = timer.time();
+      fileTime_ += time;
+      if (time > maxFileTime_) {
+         maxFileTime_ = time;
+      }
+   }
+
+   #ifdef MCMD_PTHREAD
+   /*
+   * Entry point of the background thread.
+   */
+   void* RestartWriter::run(void* ptr)
+   {
+      static_cast<RestartWriter*>(ptr)->writeFile();
+      return 0;
+   }
+   #endif
+
+   /*
+   * Clear accumulated statistics.
+   */
+   void RestartWriter::clearStatistics()
+   {
+      latency_ = 0.0;
+      maxLatency_ = 0.0;
+      fileTime_ = 0.0;
+      maxFileTime_ = 0.0;
+      nWrite_ = 0;
+   }
+
+   /*
+   * Output statistics.
+   */
+   void RestartWriter::outputStatistics(std::ostream& out)
+   {
+      // Make sure the file time includes the last write
+      finish();
+      if (nWrite_ == 0) {
+         return;
+      }
+      double rWrite = double(nWrite_);
+      out << "Restart files:" << std::endl;
+      out << "nWrite                   " << Int(nWrite_) << std::endl;
+      out << "latency / write          " << Dbl(latency_/rWrite)
+          << " sec" << std::endl;
+      out << "max latency              " << Dbl(maxLatency_)
+          << " sec" << std::endl;
+      out << "file time / write        " << Dbl(fileTime_/rWrite)
+          << " sec" << std::endl;
+      out << "max file time            " << Dbl(maxFileTime_)
+          << " sec" << std::endl;
+      out << std::endl;
+   }
+
+}
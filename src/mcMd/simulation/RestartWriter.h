@@ -0,0 +1,181 @@
+#ifndef MCMD_RESTART_WRITER_H
+#define MCMD_RESTART_WRITER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/archives/Serializable.h>    // typedef in interface
+#include <util/global.h>
+
+#ifdef MCMD_PTHREAD
+#include <pthread.h>
+#endif
+
+#include <string>
+#include <iostream>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * Writes restart files without stalling the main simulation loop.
+   *
+   * The write() function first saves the state of an object into an
+   * in-memory buffer, using the object's save() function with a
+   * Serializable::OArchive whose stream writes to memory. The buffer
+   * is then written to a temporary file named filename + ".tmp", which
+   * is renamed to filename only after it has been completely written.
+   * A valid restart file thus always exists, even if a run is killed
+   * during output. If nCopy > 1, the previous nCopy - 1 restart files
+   * are retained with names filename + ".1", filename + ".2", etc.,
+   * in which larger suffixes denote older files.
+   *
+   * If the code is compiled with MCMD_PTHREAD defined, the buffer is
+   * written by a background POSIX thread, so that the calling thread
+   * blocks only while saving state to memory. At most one write is in
+   * progress at any time: each call to write() first waits for the
+   * previous write to finish. Otherwise, the file is written before
+   * write() returns.
+   *
+   * The class also accumulates statistics for the time spent by the
+   * calling thread in write(), which is the latency of the checkpoint
+   * as seen by the simulation, and for the time spent writing files.
+   *
+   * \ingroup McMd_Simulation_Module
+   */
+   class RestartWriter
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      RestartWriter();
+
+      /**
+      * Destructor.
+      *
+      * Waits for completion of any pending write.
+      */
+      ~RestartWriter();
+
+      /**
+      * Set the number of restart files to retain (default 1).
+      *
+      * \param nCopy number of rolling copies (nCopy >= 1)
+      */
+      void setNCopy(int nCopy);
+
+      /**
+      * Save the state of an object to a restart file.
+      *
+      * \param object    object to save, by calling object.save(ar)
+      * \param filename  path to the restart file
+      */
+      void write(Serializable& object, const std::string& filename);
+
+      /**
+      * Wait for completion of any pending write.
+      *
+      * Throws an Exception if the most recent write failed.
+      */
+      void finish();
+
+      /**
+      * Clear accumulated statistics.
+      */
+      void clearStatistics();
+
+      /**
+      * Output statistics for restart files written since last clear.
+      *
+      * \param out output stream
+      */
+      void outputStatistics(std::ostream& out);
+
+      /**
+      * Get the number of rolling copies.
+      */
+      int nCopy() const;
+
+      /**
+      * Get number of restart files written since last clear.
+      */
+      int nWrite() const;
+
+   private:
+
+      /// Contents of the restart file being written.
+      std::string data_;
+
+      /// Path to the restart file being written.
+      std::string filename_;
+
+      /// Total time spent in write() by the calling thread.
+      double latency_;
+
+      /// Maximum time spent in one call to write().
+      double maxLatency_;
+
+      /// Total time spent writing and renaming files.
+      double fileTime_;
+
+      /// Maximum time spent writing and renaming one file.
+      double maxFileTime_;
+
+      /// Number of restart files written.
+      int nWrite_;
+
+      /// Number of rolling copies.
+      int nCopy_;
+
+      /// Did the most recent write fail?
+      bool hasError_;
+
+      /// Is a write pending?
+      bool isWriting_;
+
+      #ifdef MCMD_PTHREAD
+      /// Background thread.
+      pthread_t thread_;
+      #endif
+
+      /**
+      * Write data_ to a file, rotate old copies, and rename.
+      */
+      void writeFile();
+
+      #ifdef MCMD_PTHREAD
+      /**
+      * Entry point of the background thread.
+      *
+      * \param ptr pointer to this RestartWriter
+      */
+      static void* run(void* ptr);
+      #endif
+
+   };
+
+   // Inline functions
+
+   /*
+   * Get the number of rolling copies.
+   */
+   inline int RestartWriter::nCopy() const
+   {  return nCopy_; }
+
+   /*
+   * Get number of restart files written since last clear.
+   */
+   inline int RestartWriter::nWrite() const
+   {  return nWrite_; }
+
+}
+#endif
@@ -67,7 +67,9 @@ namespace McMd
       #ifdef INTER_DIHEDRAL
       dihedralCapacity_(0),
       #endif
-      maskedPairPolicy_(MaskBonded)
+      maskedPairPolicy_(MaskBonded),
+      nThread_(1),
+      threadRandoms_()
    {
       setClassName("Simulation");
       Util::initStatic();
@@ -130,7 +132,9 @@ namespace McMd
       #ifdef INTER_DIHEDRAL
       dihedralCapacity_(0),
       #endif
-      maskedPairPolicy_(MaskBonded)
+      maskedPairPolicy_(MaskBonded),
+      nThread_(1),
+      threadRandoms_()
    {
       setClassName("Simulation");
       Util::initStatic();
@@ -248,6 +252,7 @@ namespace McMd
       }
 
       readParamComposite(in, random_);
+      seedThreadRandoms(random_.seed());
 
       // Allocate and initialize all private arrays.
       initialize();
@@ -259,6 +264,10 @@ namespace McMd
    */
    void Simulation::loadParameters(Serializable::IArchive &ar)
    {
+      // Set ar.version() to 0 for files written without a header
+      if (ar.readHeader() > RestartVersion) {
+         UTIL_THROW("Restart file version is newer than this program");
+      }
       loadParamComposite(ar, fileMaster_);
 
       loadParameter<int>(ar, "nAtomType", nAtomType_);
@@ -299,6 +308,7 @@ namespace McMd
          species(iSpecies).setId(iSpecies);
       }
       loadParamComposite(ar, random_);
+      loadThreadRandoms(ar);
 
       // Allocate and initialize all private arrays.
       initialize();
@@ -309,6 +319,7 @@ namespace McMd
    */
    void Simulation::save(Serializable::OArchive &ar)
    {
+      ar.writeHeader(RestartVersion);
       fileMaster_.save(ar);
       ar << nAtomType_;
       #ifdef INTER_BOND
@@ -335,6 +346,88 @@ namespace McMd
       ar & maskedPairPolicy_;
       (*speciesManagerPtr_).save(ar);
       random_.save(ar);
+
+      // Thread random number generators
+      int nThreadRandom = 0;
+      if (threadRandoms_.isAllocated()) {
+         nThreadRandom = threadRandoms_.capacity();
+      }
+      ar << nThreadRandom;
+      for (int i = 0; i < nThreadRandom; ++i) {
+         ar << threadRandoms_[i];
+      }
+   }
+
+   /*
+   * Set the number of threads.
+   */
+   void Simulation::setNThread(int nThread)
+   {
+      if (nThread < 1) {
+         UTIL_THROW("Number of threads must be positive");
+      }
+      #ifdef MCMD_OPENMP
+      omp_set_num_threads(nThread);
+      #else
+      if (nThread > 1) {
+         UTIL_THROW("Multiple threads require compilation with MCMD_OPENMP");
+      }
+      #endif
+      nThread_ = nThread;
+   }
+
+   /*
+   * Seed random number generators of all threads (private).
+   *
+   * The seed for thread i is derived from the base seed, so that thread
+   * streams are reproducible for a given seed and thread count. If the
+   * base seed is 0, a base seed is drawn from random_ instead.
+   */
+   void Simulation::seedThreadRandoms(Random::SeedType seed)
+   {
+      if (nThread_ > 1) {
+         if (threadRandoms_.isAllocated()) {
+            threadRandoms_.deallocate();
+         }
+         threadRandoms_.allocate(nThread_);
+         if (seed == 0) {
+            seed = random_.uniformInt(1, 1000000000);
+         }
+         for (int i = 0; i < nThread_; ++i) {
+            threadRandoms_[i].setSeed(seed + 104729*(i + 1));
+         }
+      }
+   }
+
+   /*
+   * Load states of thread random number generators (private).
+   *
+   * Saved states are used only if the number of threads is unchanged.
+   * Otherwise, or if the archive predates saving of these states, new
+   * seeds are drawn from random_, so that a restarted run does not
+   * repeat the thread streams of the original run.
+   */
+   void Simulation::loadThreadRandoms(Serializable::IArchive &ar)
+   {
+      int nThreadRandom = 0;
+      if (ar.version() > 0) {
+         ar >> nThreadRandom;
+      }
+      if (nThreadRandom > 1 && nThreadRandom == nThread_) {
+         if (threadRandoms_.isAllocated()) {
+            threadRandoms_.deallocate();
+         }
+         threadRandoms_.allocate(nThread_);
+         for (int i = 0; i < nThreadRandom; ++i) {
+            ar >> threadRandoms_[i];
+         }
+      } else {
+         Random discard;
+         for (int i = 0; i < nThreadRandom; ++i) {
+            ar >> discard;
+         }
+         seedThreadRandoms(0);
+      }
    }
 
    /*
@@ -30,6 +30,10 @@
 #include <util/containers/DArray.h>     // member containers (Molecules, Bonds, ...)
 #include <util/containers/ArrayStack.h> // member containers (molecules reservoirs)
 
+#ifdef MCMD_OPENMP
+#include <omp.h>
+#endif
+
 namespace Util 
 {
    template <typename T> class ArraySet;
@@ -95,6 +99,15 @@ namespace McMd
 
    public:
 
+      /**
+      * Version of the restart file format written by save().
+      *
+      * Version 0 denotes files written before a version header was 
+      * added. Data added to the format since then is loaded only if
+      * the version of the archive is greater than 0.
+      */
+      static const unsigned int RestartVersion = 1;
+
       #ifdef UTIL_MPI
       /**
       * Constructor.
@@ -122,6 +135,8 @@ namespace McMd
       /**
       * Load internal state from an archive.
       *
+      * Reads the file header, if any, and so sets the archive version.
+      *
       * \param ar input/loading archive
       */
       virtual void loadParameters(Serializable::IArchive &ar);
@@ -129,6 +144,8 @@ namespace McMd
       /**
       * Save internal state to an archive.
       *
+      * Begins with a file header containing RestartVersion.
+      *
       * \param ar output/saving archive
       */
       virtual void save(Serializable::OArchive &ar);
@@ -197,6 +214,19 @@ namespace McMd
       */
       Random& random();
 
+      /**
+      * Get the random number generator for one thread by reference.
+      *
+      * Each thread has an independent random number generator, which is
+      * seeded from the seed of random() when parameters are read. The
+      * states of these generators are saved to restart files, and are
+      * restored on restart if the number of threads is unchanged. They
+      * are used only if nThread() > 1.
+      *
+      * \param threadId  thread index, 0 <= threadId < nThread()
+      */
+      Random& threadRandom(int threadId);
+
       /**
       * Get a specific Species by reference.
       * 
@@ -227,6 +257,44 @@ namespace McMd
       MPI::Intracomm& communicator();
       #endif
 
+      //@}
+      /// \name Shared memory threads
+      //@{
+
+      /**
+      * Set the number of threads used by each process.
+      *
+      * The number of threads must be set before parameters are read or 
+      * loaded. Throws an Exception if nThread < 1, or if nThread > 1 and
+      * MCMD_OPENMP is not defined.
+      *
+      * \param nThread number of threads
+      */
+      void setNThread(int nThread);
+
+      /**
+      * Get the number of threads (1 by default).
+      */
+      int nThread() const;
+
+      /**
+      * Get the id of the calling thread (0 <= id < nThread).
+      *
+      * Returns 0 if called outside a parallel region, or if MCMD_OPENMP
+      * is not defined.
+      */
+      static int threadId();
+
+      /**
+      * Get the number of threads in the current team.
+      *
+      * Inside a parallel region, this may be less than nThread() if the
+      * OpenMP runtime provides fewer threads than requested, so work
+      * must be divided among nTeamThread() threads. Returns 1 if called
+      * outside a parallel region, or if MCMD_OPENMP is not defined.
+      */
+      static int nTeamThread();
+
       //@}
       /// \name Read-only accessors (return by value or const reference)
       //@{
@@ -641,8 +709,28 @@ namespace McMd
       */
       MaskPolicy maskedPairPolicy_;
 
+      /// Number of threads.
+      int nThread_;
+
+      /// Random number generators for threads (allocated iff nThread_ > 1).
+      DArray<Random> threadRandoms_;
+
       //@}
 
+      /**
+      * Seed the random number generators of all threads.
+      *
+      * \param seed base seed (if 0, a base seed is drawn from random_)
+      */
+      void seedThreadRandoms(Random::SeedType seed);
+
+      /**
+      * Load or reseed the random number generators of all threads.
+      *
+      * \param ar input/loading archive
+      */
+      void loadThreadRandoms(Serializable::IArchive &ar);
+
       /**
       * Initialize all private data structures.
       */
@@ -750,6 +838,30 @@ namespace McMd
    inline Random& Simulation::random()
    {  return random_; }
 
+   inline Random& Simulation::threadRandom(int threadId)
+   {  return threadRandoms_[threadId]; }
+
+   inline int Simulation::nThread() const
+   {  return nThread_; }
+
+   inline int Simulation::threadId()
+   {
+      #ifdef MCMD_OPENMP
+      return omp_get_thread_num();
+      #else
+      return 0;
+      #endif
+   }
+
+   inline int Simulation::nTeamThread()
+   {
+      #ifdef MCMD_OPENMP
+      return omp_get_num_threads();
+      #else
+      return 1;
+      #endif
+   }
+
    inline const AtomType& Simulation::atomType(int i) const
    {  return atomTypes_[i]; }
 
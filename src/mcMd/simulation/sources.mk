@@ -1,5 +1,6 @@
 
 mcMd_simulation_=mcMd/simulation/McMd_mpi.cpp \
+    mcMd/simulation/RestartWriter.cpp \
     mcMd/simulation/Simulation.cpp \
     mcMd/simulation/System.cpp \
     mcMd/simulation/SubSystem.cpp \
@@ -0,0 +1,162 @@
+#ifndef MCMD_ANALYZER_MANAGER_TEST_H
+#define MCMD_ANALYZER_MANAGER_TEST_H
+
+#include <test/ParamFileTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <mcMd/analyzers/Snapshot.h>
+#include <mcMd/mcSimulation/McSimulation.h>
+#include <mcMd/mcSimulation/McSystem.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/boundary/Boundary.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace Util;
+using namespace McMd;
+
+class AnalyzerManagerTest : public ParamFileTest
+{
+
+public:
+
+   void testSnapshotCopy();
+   #ifdef MCMD_PTHREAD
+   void testPipeline();
+   #endif
+
+private:
+
+   std::string readOutput(const std::string& filename);
+   void simulate(const char* paramFile, const char* outputPrefix);
+
+};
+
+/*
+* Return the contents of a file in the test directory.
+*/
+std::string AnalyzerManagerTest::readOutput(const std::string& filename)
+{
+   std::ifstream in;
+   openInputFile(filename, in);
+   std::stringstream buffer;
+   buffer << in.rdbuf();
+   return buffer.str();
+}
+
+/*
+* Run a short simulation with output files named outputPrefix*.
+*/
+void AnalyzerManagerTest::simulate(const char* paramFile,
+                                   const char* outputPrefix)
+{
+   McSimulation simulation;
+   simulation.fileMaster().setRootPrefix(filePrefix());
+   openFile(paramFile);
+   simulation.readParam(file());
+   closeFile();
+   simulation.fileMaster().setOutputPrefix(outputPrefix);
+
+   openFile("in/config");
+   simulation.system().readConfig(file());
+   closeFile();
+
+   simulation.simulate(400);
+}
+
+/*
+* A Snapshot must hold atoms in species, molecule, atom order, and be
+* unaffected by later changes to the System.
+*/
+void AnalyzerManagerTest::testSnapshotCopy()
+{
+   printMethod(TEST_FUNC);
+
+   McSimulation simulation;
+   simulation.fileMaster().setRootPrefix(filePrefix());
+   openFile("in/McSimulation");
+   simulation.readParam(file());
+   closeFile();
+   openFile("in/config");
+   simulation.system().readConfig(file());
+   closeFile();
+   McSystem& system = simulation.system();
+
+   Snapshot snapshot;
+   snapshot.copy(system, 7);
+   TEST_ASSERT(snapshot.iStep() == 7);
+   TEST_ASSERT(snapshot.nAtom() == system.nAtom());
+   TEST_ASSERT(snapshot.nSpecies() == simulation.nSpecies());
+   TEST_ASSERT(snapshot.firstAtomId(0) == 0);
+   TEST_ASSERT(snapshot.firstAtomId(snapshot.nSpecies()) == system.nAtom());
+   TEST_ASSERT(snapshot.boundary().lengths() == system.boundary().lengths());
+
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   int iSpecies, i;
+   i = 0;
+   for (iSpecies = 0; iSpecies < simulation.nSpecies(); ++iSpecies) {
+      TEST_ASSERT(snapshot.firstAtomId(iSpecies) == i);
+      for (system.begin(iSpecies, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            TEST_ASSERT(snapshot.position(i) == atomIter->position());
+            TEST_ASSERT(snapshot.typeId(i) == atomIter->typeId());
+            ++i;
+         }
+      }
+   }
+
+   // Later changes to the System do not change the copy
+   Vector shift(0.1, 0.2, 0.3);
+   Vector first = snapshot.position(0);
+   system.begin(0, molIter);
+   molIter->begin(atomIter);
+   atomIter->position() += shift;
+   Vector lengths = system.boundary().lengths();
+   lengths *= 1.1;
+   system.boundary().setOrthorhombic(lengths);
+   TEST_ASSERT(snapshot.position(0) == first);
+   TEST_ASSERT(!(snapshot.boundary().lengths() == lengths));
+
+   // A new copy, made into the same arrays, sees the changes
+   snapshot.copy(system, 8);
+   TEST_ASSERT(snapshot.iStep() == 8);
+   TEST_ASSERT(snapshot.position(0) == atomIter->position());
+   TEST_ASSERT(snapshot.boundary().lengths() == lengths);
+}
+
+#ifdef MCMD_PTHREAD
+/*
+* Snapshot-safe analyzers executed by background threads must write the
+* same output as when executed by the main thread.
+*/
+void AnalyzerManagerTest::testPipeline()
+{
+   printMethod(TEST_FUNC);
+
+   simulate("in/Pipeline", "inline.");
+   simulate("in/PipelineThreads", "pipeline.");
+
+   const char* names[] = {"StructureFactor.dat", "StructureFactor_max.dat",
+                          "VanHove.dat"};
+   std::string inlineOutput, pipelineOutput;
+   for (int i = 0; i < 3; ++i) {
+      inlineOutput = readOutput(std::string("inline.") + names[i]);
+      pipelineOutput = readOutput(std::string("pipeline.") + names[i]);
+      TEST_ASSERT(inlineOutput.size() > 0);
+      TEST_ASSERT(inlineOutput == pipelineOutput);
+   }
+}
+#endif
+
+TEST_BEGIN(AnalyzerManagerTest)
+TEST_ADD(AnalyzerManagerTest, testSnapshotCopy)
+#ifdef MCMD_PTHREAD
+TEST_ADD(AnalyzerManagerTest, testPipeline)
+#endif
+TEST_END(AnalyzerManagerTest)
+
+#endif
@@ -4,9 +4,13 @@
 #include <test/CompositeTestRunner.h>
 
 #include "ClusterTest.h"
+#include "RDFTest.h"
+#include "AnalyzerManagerTest.h"
 
 TEST_COMPOSITE_BEGIN(AnalyzersTestComposite)
 TEST_COMPOSITE_ADD_UNIT(ClusterTest);
+TEST_COMPOSITE_ADD_UNIT(RDFTest);
+TEST_COMPOSITE_ADD_UNIT(AnalyzerManagerTest);
 TEST_COMPOSITE_END
 
 #endif
@@ -0,0 +1,139 @@
+#ifndef MCMD_RDF_TEST_H
+#define MCMD_RDF_TEST_H
+
+#include <test/ParamFileTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <mcMd/analyzers/system/RDF.h>
+#include <mcMd/analyzers/util/PairSelector.h>
+#include <mcMd/mcSimulation/McSimulation.h>
+#include <mcMd/mcSimulation/McSystem.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/accumulators/Distribution.h>
+#include <util/boundary/Boundary.h>
+#include <util/containers/GArray.h>
+
+#include <sstream>
+
+using namespace Util;
+using namespace McMd;
+
+class RDFTest : public ParamFileTest
+{
+
+public:
+
+   virtual void setUp()
+   {
+      #ifdef MCMD_OPENMP
+      simulation_.setNThread(2);
+      #endif
+      simulation_.fileMaster().setRootPrefix(filePrefix());
+      openFile("in/McSimulation");
+      simulation_.readParam(file());
+      closeFile();
+
+      openFile("in/config");
+      simulation_.system().readConfig(file());
+      closeFile();
+   }
+
+   void testAll();
+   void testInter();
+   void testIntra();
+
+private:
+
+   McSimulation simulation_;
+
+   void compare(const char* filename, const char* selectorString);
+
+};
+
+/*
+* Compare the histogram of one RDF sample, computed with a cell list,
+* to one computed by a double loop over all pairs of atoms.
+*/
+void RDFTest::compare(const char* filename, const char* selectorString)
+{
+   McSystem& system = simulation_.system();
+   RDF rdf(system);
+   openFile(filename);
+   rdf.readParam(file());
+   closeFile();
+   rdf.setup();
+   rdf.sample(0);
+   const Distribution& histogram = rdf.accumulator();
+
+   PairSelector selector;
+   std::istringstream in(selectorString);
+   in >> selector;
+
+   // Pointers to all atoms
+   GArray<const Atom*> atoms;
+   System::ConstMoleculeIterator molIter;
+   Molecule::ConstAtomIterator atomIter;
+   system.begin(0, molIter);
+   for ( ; molIter.notEnd(); ++molIter) {
+      for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+         atoms.append(atomIter.get());
+      }
+   }
+
+   Distribution expected;
+   expected.setParam(0.0, histogram.max(), histogram.nBin());
+   expected.clear();
+   const Boundary& boundary = system.boundary();
+   double maxSq = histogram.max()*histogram.max();
+   double dRsq, dR;
+   int i, j;
+   for (i = 0; i < atoms.size(); ++i) {
+      for (j = i + 1; j < atoms.size(); ++j) {
+         dRsq = boundary.distanceSq(atoms[i]->position(),
+                                    atoms[j]->position());
+         if (dRsq < maxSq) {
+            dR = sqrt(dRsq);
+            if (selector.match(*atoms[i], *atoms[j])) {
+               expected.sample(dR);
+            }
+            if (selector.match(*atoms[j], *atoms[i])) {
+               expected.sample(dR);
+            }
+         }
+      }
+   }
+
+   long total = 0;
+   for (i = 0; i < histogram.nBin(); ++i) {
+      TEST_ASSERT(histogram.data()[i] == expected.data()[i]);
+      total += expected.data()[i];
+   }
+   TEST_ASSERT(total > 0);
+}
+
+void RDFTest::testAll()
+{
+   printMethod(TEST_FUNC);
+   compare("in/RDFAll", "all -1 -1");
+}
+
+void RDFTest::testInter()
+{
+   printMethod(TEST_FUNC);
+   compare("in/RDFInter", "inter 0 1");
+}
+
+void RDFTest::testIntra()
+{
+   printMethod(TEST_FUNC);
+   compare("in/RDFIntra", "intra 1 0");
+}
+
+TEST_BEGIN(RDFTest)
+TEST_ADD(RDFTest, testAll)
+TEST_ADD(RDFTest, testInter)
+TEST_ADD(RDFTest, testIntra)
+TEST_END(RDFTest)
+
+#endif
@@ -10,10 +10,18 @@
 #include <mcMd/chemistry/Activate.h>
 #include <mcMd/potentials/pair/McPairPotential.h>
 #include <mcMd/potentials/bond/BondPotential.h>
+#include <mcMd/mcMoves/McMove.h>
+#include <mcMd/mcMoves/McMoveManager.h>
+#include <mcMd/mcMoves/common/AtomDisplaceMove.h>
+#include <mcMd/mcMoves/common/CheckerboardDisplaceMove.h>
 #ifdef INTER_ANGLE
 #include <mcMd/potentials/angle/AnglePotential.h>
 #endif
 
+#include <util/boundary/Boundary.h>
+#include <util/random/Random.h>
+#include <util/containers/DArray.h>
+#include <util/accumulators/Average.h>
 #include <util/archives/BinaryFileOArchive.h>
 #include <util/archives/BinaryFileIArchive.h>
 #include <util/archives/Serializable_includes.h>
@@ -23,10 +31,32 @@
 
 #include <string>
 #include <fstream>
+#include <sstream>
+#include <iterator>
 
 using namespace Util;
 using namespace McMd;
 
+/*
+* McMove subclass that provides access to randomUnitVectors().
+*/
+class UnitVectorMove : public McMove
+{
+
+public:
+
+   UnitVectorMove(Simulation& simulation)
+    : McMove(simulation)
+   {}
+
+   void generate(Vector* vectors, int n)
+   {  randomUnitVectors(vectors, n); }
+
+   static int minParallelVectors()
+   {  return MinParallelVectors; }
+
+};
+
 class McSimulationTest : public ParamFileTest
 {
 
@@ -39,12 +69,24 @@ public:
    void testReadParamBond();
    void testReadConfigBond();
    void testPairEnergy();
+   void testTrialEnergies();
+   void testInsertionEnergies();
    void testBondEnergy();
    void testActivate();
    void testMdSystemCopy();
    void testSimulateBond();
    void testWriteRestartBond();
    void testReadRestart();
+   void testRestartWriter();
+   void testThreadRandoms();
+   void testCheckerboardReproducible();
+   void testCheckerboardDistribution();
+   void testCachedEnergy();
+   void testCachedEnergyBond();
+   void testTuneStatistics();
+   #ifdef MCMD_PROFILE
+   void testMoveProfile();
+   #endif
 
    #ifdef INTER_ANGLE
    void testReadParamAngle();
@@ -60,6 +102,14 @@ private:
    // Utility functions
    void readParam(const char* filename);
    void readConfig(const char* filename);
+   bool isSameFile(const std::string& name1, const std::string& name2);
+   int  nThreadRandom();
+   void saveRandoms(std::stringbuf& buffer);
+   void restoreRandoms(std::stringbuf& buffer);
+   void savePositions(DArray<Vector>& positions);
+   void restorePositions(const DArray<Vector>& positions);
+   void averageEnergy(McMove& move, int nAttempt, int nSweep, 
+                      double& average, double& error);
 
 };
 
@@ -90,6 +140,123 @@ void McSimulationTest::readConfig(const char* filename)
    file().close();
 }
 
+bool McSimulationTest::isSameFile(const std::string& name1, 
+                                  const std::string& name2)
+{
+   std::ifstream file1(name1.c_str(), std::ios_base::in | std::ios_base::binary);
+   std::ifstream file2(name2.c_str(), std::ios_base::in | std::ios_base::binary);
+   if (!file1.is_open() || !file2.is_open()) {
+      return false;
+   }
+   std::string data1((std::istreambuf_iterator<char>(file1)), 
+                      std::istreambuf_iterator<char>());
+   std::string data2((std::istreambuf_iterator<char>(file2)), 
+                      std::istreambuf_iterator<char>());
+   return (data1.size() > 0 && data1 == data2);
+}
+
+/*
+* Number of thread random number generators (0 if nThread == 1).
+*/
+int McSimulationTest::nThreadRandom()
+{
+   int nThread = simulation_.nThread();
+   return (nThread > 1) ? nThread : 0;
+}
+
+/*
+* Save states of main and thread random number generators to memory.
+*/
+void McSimulationTest::saveRandoms(std::stringbuf& buffer)
+{
+   Serializable::OArchive ar;
+   ar.file().std::ios::rdbuf(&buffer);
+   ar << simulation_.random();
+   for (int i = 0; i < nThreadRandom(); ++i) {
+      ar << simulation_.threadRandom(i);
+   }
+   ar.file().std::ios::rdbuf(0);
+}
+
+/*
+* Restore states of random number generators saved by saveRandoms.
+*/
+void McSimulationTest::restoreRandoms(std::stringbuf& buffer)
+{
+   Serializable::IArchive ar;
+   ar.file().std::ios::rdbuf(&buffer);
+   ar >> simulation_.random();
+   for (int i = 0; i < nThreadRandom(); ++i) {
+      ar >> simulation_.threadRandom(i);
+   }
+   ar.file().std::ios::rdbuf(0);
+}
+
+/*
+* Store positions of all atoms, indexed by atom id.
+*/
+void McSimulationTest::savePositions(DArray<Vector>& positions)
+{
+   if (!positions.isAllocated()) {
+      positions.allocate(simulation_.atomCapacity());
+   }
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   for (int is = 0; is < simulation_.nSpecies(); ++is) {
+      for (system_.begin(is, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            positions[atomIter->id()] = atomIter->position();
+         }
+      }
+   }
+}
+
+/*
+* Restore positions stored by savePositions, and rebuild the cell list.
+*/
+void McSimulationTest::restorePositions(const DArray<Vector>& positions)
+{
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   for (int is = 0; is < simulation_.nSpecies(); ++is) {
+      for (system_.begin(is, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            atomIter->position() = positions[atomIter->id()];
+         }
+      }
+   }
+   system_.pairPotential().buildCellList();
+   system_.unsetPotentialEnergy();
+}
+
+/*
+* Sample the potential energy after each of nSweep sweeps of nAttempt 
+* calls to move.move(), and compute the average and its error, from 
+* the variance of 10 block averages.
+*/
+void McSimulationTest::averageEnergy(McMove& move, int nAttempt, 
+                                     int nSweep, double& average, 
+                                     double& error)
+{
+   const int nBlock = 10;
+   int nSamplePerBlock = nSweep/nBlock;
+   Average blocks;
+   double blockSum;
+   int i, j, k;
+   for (i = 0; i < nBlock; ++i) {
+      blockSum = 0.0;
+      for (j = 0; j < nSamplePerBlock; ++j) {
+         for (k = 0; k < nAttempt; ++k) {
+            move.move();
+         }
+         blockSum += system_.potentialEnergy();
+      }
+      blocks.sample(blockSum/double(nSamplePerBlock));
+   }
+   average = blocks.average();
+   error = blocks.stdDeviation()/sqrt(double(nBlock - 1));
+}
+
 // Test methods
 
 void McSimulationTest::testReadParamBond()
@@ -169,6 +336,112 @@ void McSimulationTest::testPairEnergy()
    TEST_ASSERT(eq(0.5*energy, total));
 }
 
+void McSimulationTest::testTrialEnergies()
+{ 
+   printMethod(TEST_FUNC);
+
+   readParam("in/McSimulation"); 
+   readConfig("in/config");
+
+   // Enlarge the box, so that trial positions near an atom can be 
+   // evaluated without minimum image corrections.
+   Vector lengths(8.0, 8.0, 8.0);
+   system_.boundary().setOrthorhombic(lengths);
+   system_.pairPotential().buildCellList();
+
+   const int nTrial = 8;
+   Vector positions[nTrial];
+   double energies[nTrial];
+   Vector oldPosition;
+   Random& random = simulation_.random();
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   double energy;
+   int i, j, k;
+   for (i = 0; i < 2; ++i) {
+      for (int is=0; is < simulation_.nSpecies(); ++is) {
+         for (system_.begin(is, molIter); molIter.notEnd(); ++molIter) {
+            for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+
+               // Trial positions: first near the atom, then anywhere
+               for (k = 0; k < nTrial; ++k) {
+                  if (i == 0) {
+                     positions[k] = atomIter->position();
+                     for (j = 0; j < Dimension; ++j) {
+                        positions[k][j] += random.uniform(-0.3, 0.3);
+                     }
+                     system_.boundary().shift(positions[k]);
+                  } else {
+                     system_.boundary().randomPosition(random, positions[k]);
+                  }
+               }
+               system_.pairPotential().trialEnergies(*atomIter, positions, 
+                                                     nTrial, energies);
+
+               oldPosition = atomIter->position();
+               for (k = 0; k < nTrial; ++k) {
+                  atomIter->position() = positions[k];
+                  energy = system_.pairPotential().atomEnergy(*atomIter);
+                  TEST_ASSERT(eq(energy, energies[k]));
+               }
+               atomIter->position() = oldPosition;
+
+            }
+         }
+      }
+   }
+}
+
+/*
+* Energies from insertionEnergies() must equal those obtained one 
+* position at a time from trialEnergies(), for an atom of a molecule 
+* from the reservoir, which is not in the cell list.
+*/
+void McSimulationTest::testInsertionEnergies()
+{ 
+   printMethod(TEST_FUNC);
+
+   #ifdef MCMD_OPENMP
+   simulation_.setNThread(2);
+   #endif
+   readParam("in/McSimulation"); 
+   readConfig("in/config");
+
+   const int nPosition = 200;
+   Vector positions[nPosition];
+   double energies[nPosition];
+   Random& random = simulation_.random();
+   double energy;
+   int i, is, k;
+   for (i = 0; i < 2; ++i) {
+
+      // Repeat in an enlarged box, in which neighbors are compacted
+      if (i == 1) {
+         Vector lengths(8.0, 8.0, 8.0);
+         system_.boundary().setOrthorhombic(lengths);
+         system_.pairPotential().buildCellList();
+      }
+
+      for (is = 0; is < simulation_.nSpecies(); ++is) {
+         Molecule& molecule = simulation_.getMolecule(is);
+         const Atom& atom = molecule.atom(0);
+         for (k = 0; k < nPosition; ++k) {
+            system_.boundary().randomPosition(random, positions[k]);
+         }
+         system_.pairPotential().insertionEnergies(atom.typeId(), 
+                                                   positions, nPosition, 
+                                                   energies);
+         for (k = 0; k < nPosition; ++k) {
+            system_.pairPotential().trialEnergies(atom, &positions[k], 1, 
+                                                  &energy);
+            TEST_ASSERT(eq(energy, energies[k]));
+         }
+         simulation_.returnMolecule(molecule);
+      }
+
+   }
+}
+
 void McSimulationTest::testBondEnergy()
 { 
    printMethod(TEST_FUNC);
@@ -395,16 +668,393 @@ void McSimulationTest::testReadRestart()
    simulation_.save(baseFileName);
 }
 
+/*
+* Files written by a RestartWriter (by a background thread, if compiled
+* with MCMD_PTHREAD) must be identical to files written synchronously.
+*/
+void McSimulationTest::testRestartWriter()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McSimulation"); 
+   readConfig("in/config"); 
+
+   FileMaster& fileMaster = simulation_.fileMaster();
+   std::string name = fileMaster.restartOFileName("restartWriter");
+   std::ios_base::openmode mode = std::ios_base::out | std::ios_base::binary;
+   RestartWriter writer;
+   writer.setNCopy(2);
+
+   // Write synchronously, then through writer
+   {
+      Serializable::OArchive ar;
+      fileMaster.openRestartOFile("restartDirect.0", ar.file(), mode);
+      simulation_.save(ar);
+      ar.file().close();
+   }
+   writer.write(simulation_, name);
+
+   simulation_.simulate(10);
+
+   {
+      Serializable::OArchive ar;
+      fileMaster.openRestartOFile("restartDirect.10", ar.file(), mode);
+      simulation_.save(ar);
+      ar.file().close();
+   }
+   writer.write(simulation_, name);
+   writer.finish();
+   TEST_ASSERT(writer.nWrite() == 2);
+
+   // The current file and the retained copy must match
+   TEST_ASSERT(isSameFile(name, 
+                          fileMaster.restartOFileName("restartDirect.10")));
+   TEST_ASSERT(isSameFile(name + ".1",
+                          fileMaster.restartOFileName("restartDirect.0")));
+}
+
+/*
+* Random unit vectors must be reproducible for given generator states
+* and thread count, independent of the scheduling of threads.
+*/
+void McSimulationTest::testThreadRandoms()
+{
+   printMethod(TEST_FUNC);
+
+   #ifdef MCMD_OPENMP
+   simulation_.setNThread(2);
+   #endif
+   readParam("in/McSimulation"); 
+
+   // Save states of all generators to memory
+   std::stringbuf buffer(std::ios_base::in | std::ios_base::out 
+                         | std::ios_base::binary);
+   saveRandoms(buffer);
+
+   const int n = 2*UnitVectorMove::minParallelVectors();
+   DArray<Vector> vectors1, vectors2;
+   vectors1.allocate(n);
+   vectors2.allocate(n);
+   UnitVectorMove move(simulation_);
+   move.generate(&vectors1[0], n);
+
+   // Restore states, and repeat
+   restoreRandoms(buffer);
+   move.generate(&vectors2[0], n);
+
+   for (int i = 0; i < n; ++i) {
+      TEST_ASSERT(vectors1[i] == vectors2[i]);
+      TEST_ASSERT(eq(vectors1[i].square(), 1.0));
+   }
+
+   // Threads must have distinct streams
+   if (nThreadRandom() > 1) {
+      double r0 = simulation_.threadRandom(0).uniform();
+      double r1 = simulation_.threadRandom(1).uniform();
+      TEST_ASSERT(r0 != r1);
+   }
+}
+
+/*
+* Checkerboard sweeps must be reproducible for given generator states
+* and thread count, independent of the scheduling of threads.
+*/
+void McSimulationTest::testCheckerboardReproducible()
+{
+   printMethod(TEST_FUNC);
+
+   #ifdef MCMD_OPENMP
+   simulation_.setNThread(2);
+   #endif
+   readParam("in/Checkerboard"); 
+   readConfig("in/checkerboard.config"); 
+
+   CheckerboardDisplaceMove move(system_);
+   openFile("in/CheckerboardDisplaceMove");
+   move.readParam(file());
+   closeFile();
+   move.setup();
+
+   std::stringbuf buffer(std::ios_base::in | std::ios_base::out 
+                         | std::ios_base::binary);
+   DArray<Vector> positions0, positions1, positions2;
+   saveRandoms(buffer);
+   savePositions(positions0);
+
+   const int nSweep = 20;
+   int i;
+   for (i = 0; i < nSweep; ++i) {
+      move.move();
+   }
+   savePositions(positions1);
+   double energy1 = system_.potentialEnergy();
+   TEST_ASSERT(move.nAccept() > 0);
+   TEST_ASSERT(move.nAccept() < move.nAttempt());
+
+   restoreRandoms(buffer);
+   restorePositions(positions0);
+   for (i = 0; i < nSweep; ++i) {
+      move.move();
+   }
+   savePositions(positions2);
+   double energy2 = system_.potentialEnergy();
+
+   for (i = 0; i < simulation_.atomCapacity(); ++i) {
+      TEST_ASSERT(positions1[i] == positions2[i]);
+   }
+   TEST_ASSERT(energy1 == energy2);
+}
+
+/*
+* Checkerboard sweeps must sample the same distribution as single atom
+* displacements. This tests detailed balance statistically, by comparing
+* average energies from equal numbers of attempted displacements.
+*/
+void McSimulationTest::testCheckerboardDistribution()
+{
+   printMethod(TEST_FUNC);
+
+   #ifdef MCMD_OPENMP
+   simulation_.setNThread(2);
+   #endif
+   readParam("in/Checkerboard"); 
+   readConfig("in/checkerboard.config"); 
+
+   CheckerboardDisplaceMove checkerboard(system_);
+   openFile("in/CheckerboardDisplaceMove");
+   checkerboard.readParam(file());
+   closeFile();
+   checkerboard.setup();
+
+   AtomDisplaceMove single(system_);
+   openFile("in/AtomDisplaceMove");
+   single.readParam(file());
+   closeFile();
+   single.setup();
+
+   // Equilibrate, starting from a lattice
+   int nAtom = system_.nMolecule(0);
+   int i;
+   for (i = 0; i < 200; ++i) {
+      checkerboard.move();
+   }
+
+   const int nSweep = 1000;
+   double average1, error1, average2, error2;
+   averageEnergy(checkerboard, 1, nSweep, average1, error1);
+   averageEnergy(single, nAtom, nSweep, average2, error2);
+
+   double error = sqrt(error1*error1 + error2*error2);
+   if (verbose() > 1) {
+      std::cout << std::endl;
+      std::cout << "Checkerboard  " << average1 << " +- " << error1 << std::endl;
+      std::cout << "Single atom   " << average2 << " +- " << error2 << std::endl;
+   }
+   TEST_ASSERT(error > 0.0);
+   TEST_ASSERT(fabs(average1 - average2) < 4.0*error);
+}
+
+/*
+* After accepted moves that track energy, the incrementally updated 
+* cached energy must equal the energy recomputed from scratch.
+*/
+void McSimulationTest::testCachedEnergy()
+{
+   printMethod(TEST_FUNC);
+
+   #ifdef MCMD_OPENMP
+   simulation_.setNThread(2);
+   #endif
+   readParam("in/Checkerboard"); 
+   readConfig("in/checkerboard.config"); 
+
+   CheckerboardDisplaceMove checkerboard(system_);
+   openFile("in/CheckerboardDisplaceMove");
+   checkerboard.readParam(file());
+   closeFile();
+   checkerboard.setup();
+
+   AtomDisplaceMove single(system_);
+   openFile("in/AtomDisplaceMove");
+   single.readParam(file());
+   closeFile();
+   single.setup();
+
+   TEST_ASSERT(checkerboard.tracksEnergy());
+   TEST_ASSERT(single.tracksEnergy());
+
+   // Set the cached energy, then update it only by increments
+   system_.cachedPotentialEnergy();
+   double cached, energy;
+   long nAccept;
+   int i;
+   for (i = 0; i < 20; ++i) {
+      checkerboard.move();
+      cached = system_.cachedPotentialEnergy();
+      energy = system_.potentialEnergy();
+      TEST_ASSERT(fabs(cached - energy) < 1.0E-10*fabs(energy));
+   }
+   TEST_ASSERT(checkerboard.nAccept() > 0);
+   for (i = 0; i < 2000; ++i) {
+      nAccept = single.nAccept();
+      single.move();
+      if (single.nAccept() > nAccept) {
+         cached = system_.cachedPotentialEnergy();
+         energy = system_.potentialEnergy();
+         TEST_ASSERT(fabs(cached - energy) < 1.0E-10*fabs(energy));
+      }
+   }
+   TEST_ASSERT(single.nAccept() > 0);
+}
+
+/*
+* As testCachedEnergy, for displacements of bonded atoms.
+*/
+void McSimulationTest::testCachedEnergyBond()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McSimulation"); 
+   readConfig("in/config"); 
+
+   AtomDisplaceMove move(system_);
+   openFile("in/AtomDisplaceMove");
+   move.readParam(file());
+   closeFile();
+   move.setup();
+
+   system_.cachedPotentialEnergy();
+   double cached, energy;
+   long nAccept;
+   for (int i = 0; i < 2000; ++i) {
+      nAccept = move.nAccept();
+      move.move();
+      if (move.nAccept() > nAccept) {
+         cached = system_.cachedPotentialEnergy();
+         energy = system_.potentialEnergy();
+         TEST_ASSERT(fabs(cached - energy) < 1.0E-10*fabs(energy));
+      }
+   }
+   TEST_ASSERT(move.nAccept() > 0);
+}
+
+/*
+* Check that attempts made by McMoveManager::tune() are not counted in
+* the statistics of the run in which it is called.
+*/
+void McSimulationTest::testTuneStatistics()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McSimulation"); 
+   readConfig("in/config"); 
+
+   McMoveManager manager(simulation_);
+   openFile("in/McMoveManager");
+   manager.readParam(file());
+   closeFile();
+   manager.setup();
+
+   const int nMove = 500;
+   int i;
+   for (i = 0; i < nMove; ++i) {
+      manager.move();
+   }
+   DArray<long> nAttempts, nAccepts;
+   nAttempts.allocate(manager.size());
+   nAccepts.allocate(manager.size());
+   for (i = 0; i < manager.size(); ++i) {
+      nAttempts[i] = manager[i].nAttempt();
+      nAccepts[i] = manager[i].nAccept();
+   }
+   double delta = manager[0].stepSize();
+
+   manager.tune(2000, 200, 0.3, 2.0);
+
+   // Tuning changed step sizes, but not statistics
+   TEST_ASSERT(manager[0].stepSize() != delta);
+   long nAttempt = 0;
+   for (i = 0; i < manager.size(); ++i) {
+      TEST_ASSERT(manager[i].nAttempt() == nAttempts[i]);
+      TEST_ASSERT(manager[i].nAccept() == nAccepts[i]);
+      nAttempt += manager[i].nAttempt();
+   }
+   TEST_ASSERT(nAttempt == nMove);
+
+   // Later attempts add to the same statistics
+   for (i = 0; i < nMove; ++i) {
+      manager.move();
+   }
+   nAttempt = 0;
+   for (i = 0; i < manager.size(); ++i) {
+      nAttempt += manager[i].nAttempt();
+   }
+   TEST_ASSERT(nAttempt == 2*nMove);
+}
+
+#ifdef MCMD_PROFILE
+/*
+* Check that the profiler counts every attempt, and samples one in each
+* batch of McMoveManager::ProfileInterval attempts.
+*/
+void McSimulationTest::testMoveProfile()
+{
+   printMethod(TEST_FUNC);
+
+   readParam("in/McSimulation"); 
+   readConfig("in/config"); 
+
+   McMoveManager manager(simulation_);
+   openFile("in/McMoveManager");
+   manager.readParam(file());
+   closeFile();
+   manager.setup();
+   const int nMove = 1000;
+   for (int i = 0; i < nMove; ++i) {
+      manager.move();
+   }
+
+   long nCall = 0;
+   long nSample = 0;
+   double nAttempt = 0.0;
+   for (int i = 0; i < manager.size(); ++i) {
+      const McMoveProfile& profile = manager[i].profile();
+      TEST_ASSERT(profile.nCall() == manager[i].nAttempt());
+      TEST_ASSERT(profile.nSample() <= profile.nCall());
+      nCall += profile.nCall();
+      nSample += profile.nSample();
+      nAttempt += profile.total(McMoveProfile::NAttempt);
+      TEST_ASSERT(profile.estimate(McMoveProfile::Time) >= 
+                  profile.total(McMoveProfile::Time));
+   }
+   TEST_ASSERT(nCall == nMove);
+   TEST_ASSERT(nSample == (nMove + 15)/16);
+   TEST_ASSERT(eq(nAttempt, double(nSample)));
+}
+#endif
+
 TEST_BEGIN(McSimulationTest)
 TEST_ADD(McSimulationTest, testReadParamBond)
 TEST_ADD(McSimulationTest, testReadConfigBond)
 TEST_ADD(McSimulationTest, testPairEnergy)
+TEST_ADD(McSimulationTest, testTrialEnergies)
+TEST_ADD(McSimulationTest, testInsertionEnergies)
 TEST_ADD(McSimulationTest, testBondEnergy)
 TEST_ADD(McSimulationTest, testActivate)
 TEST_ADD(McSimulationTest, testMdSystemCopy)
 TEST_ADD(McSimulationTest, testSimulateBond)
 TEST_ADD(McSimulationTest, testWriteRestartBond)
 //TEST_ADD(McSimulationTest, testReadRestart)
+TEST_ADD(McSimulationTest, testRestartWriter)
+TEST_ADD(McSimulationTest, testThreadRandoms)
+TEST_ADD(McSimulationTest, testCheckerboardReproducible)
+TEST_ADD(McSimulationTest, testCheckerboardDistribution)
+TEST_ADD(McSimulationTest, testCachedEnergy)
+TEST_ADD(McSimulationTest, testCachedEnergyBond)
+TEST_ADD(McSimulationTest, testTuneStatistics)
+#ifdef MCMD_PROFILE
+TEST_ADD(McSimulationTest, testMoveProfile)
+#endif
 #ifdef INTER_ANGLE
 TEST_ADD(McSimulationTest, testReadParamAngle)
 TEST_ADD(McSimulationTest, testAngleEnergy)
@@ -9,6 +9,13 @@
 #include <mcMd/mdSimulation/MdSystem.h>
 #include <mcMd/mdIntegrators/MdIntegrator.h>
 #include <mcMd/mdIntegrators/NveVvIntegrator.h>
+#include <mcMd/mdIntegrators/NveRespaIntegrator.h>
+#include <mcMd/mdIntegrators/NvtNhIntegrator.h>
+#include <mcMd/mdIntegrators/NvtRespaIntegrator.h>
+#include <mcMd/potentials/pair/MdPairPotential.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/containers/DArray.h>
 
 #include <iostream>
 #include <fstream>
@@ -28,21 +35,128 @@ public:
 
    virtual void setUp()
    {
+      simulation_.fileMaster().setRootPrefix(filePrefix());
       openFile("in/MdIntegrator");
       simulation_.readParam(file());
+      closeFile();
       systemPtr_ = &simulation_.system();
+
+      openFile("in/config");
+      systemPtr_->readConfig(file());
+      closeFile();
    }
 
    void testReadParam();
    void testIntegrator();
+   void testNveRespaIntegrator();
+   void testNvtRespaIntegrator();
 
 private:
 
    MdSimulation  simulation_;
    MdSystem*     systemPtr_;
 
+   void readIntegrator(MdIntegrator& integrator, const char* filename);
+   void saveState(DArray<Vector>& positions, DArray<Vector>& velocities);
+   void restoreState(const DArray<Vector>& positions, 
+                     const DArray<Vector>& velocities);
+   void run(MdIntegrator& integrator, int nStep);
+   double maxDifference(const DArray<Vector>& positions,
+                        const DArray<Vector>& velocities);
+
 };
 
+/*
+* Read parameters of a separately constructed integrator.
+*/
+void MdIntegratorTest::readIntegrator(MdIntegrator& integrator,
+                                      const char* filename)
+{
+   openFile(filename);
+   integrator.readParam(file());
+   closeFile();
+}
+
+/*
+* Store positions and velocities of all atoms, indexed by atom id.
+*/
+void MdIntegratorTest::saveState(DArray<Vector>& positions, 
+                                 DArray<Vector>& velocities)
+{
+   int capacity = simulation_.atomCapacity();
+   positions.allocate(capacity);
+   velocities.allocate(capacity);
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   for (int iSpecies = 0; iSpecies < simulation_.nSpecies(); ++iSpecies) {
+      systemPtr_->begin(iSpecies, molIter);
+      for ( ; molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            positions[atomIter->id()] = atomIter->position();
+            velocities[atomIter->id()] = atomIter->velocity();
+         }
+      }
+   }
+}
+
+/*
+* Restore positions and velocities stored by saveState().
+*/
+void MdIntegratorTest::restoreState(const DArray<Vector>& positions, 
+                                    const DArray<Vector>& velocities)
+{
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   for (int iSpecies = 0; iSpecies < simulation_.nSpecies(); ++iSpecies) {
+      systemPtr_->begin(iSpecies, molIter);
+      for ( ; molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            atomIter->position() = positions[atomIter->id()];
+            atomIter->velocity() = velocities[atomIter->id()];
+         }
+      }
+   }
+}
+
+/*
+* Setup and run an integrator, starting from current state.
+*/
+void MdIntegratorTest::run(MdIntegrator& integrator, int nStep)
+{
+   systemPtr_->pairPotential().buildPairList();
+   systemPtr_->calculateForces();
+   integrator.setup();
+   for (int i = 0; i < nStep; ++i) {
+      integrator.step();
+   }
+}
+
+/*
+* Return maximum difference of current positions and velocities from
+* those in the arrays.
+*/
+double MdIntegratorTest::maxDifference(const DArray<Vector>& positions,
+                                       const DArray<Vector>& velocities)
+{
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   Vector dr;
+   double max = 0.0;
+   int id;
+   for (int iSpecies = 0; iSpecies < simulation_.nSpecies(); ++iSpecies) {
+      systemPtr_->begin(iSpecies, molIter);
+      for ( ; molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            id = atomIter->id();
+            dr.subtract(atomIter->position(), positions[id]);
+            if (dr.abs() > max) max = dr.abs();
+            dr.subtract(atomIter->velocity(), velocities[id]);
+            if (dr.abs() > max) max = dr.abs();
+         }
+      }
+   }
+   return max;
+}
 
 void MdIntegratorTest::testReadParam()
 {
@@ -67,31 +181,91 @@ void MdIntegratorTest::testIntegrator()
    printMethod(TEST_FUNC);
    double kinetic, potential;
 
-   /// BUG:: A configurition needs to be read or generated at this point.
-
-   systemPtr_->buildPairList();
+   systemPtr_->pairPotential().buildPairList();
    systemPtr_->calculateForces();
    systemPtr_->setBoltzmannVelocities(1.0);
+   systemPtr_->mdIntegrator().setup();
 
    for (int i=0; i < 10; ++i) {
 
-      kinetic   = systemPtr_->kineticEnergy(); 
-      potential = systemPtr_->potentialEnergy(); 
-      std::cout << Dbl(kinetic, 20) << Dbl(potential, 20) 
-           << Dbl(kinetic + potential, 20) << std::endl;
+      kinetic   = systemPtr_->kineticEnergy();
+      potential = systemPtr_->potentialEnergy();
+      if (verbose() > 1) {
+         std::cout << Dbl(kinetic, 20) << Dbl(potential, 20)
+                   << Dbl(kinetic + potential, 20) << std::endl;
+      }
 
       systemPtr_->mdIntegrator().step();
    }
 
-   kinetic   = systemPtr_->kineticEnergy(); 
-   potential = systemPtr_->potentialEnergy(); 
-   std::cout << Dbl(kinetic, 20) <<  Dbl(potential, 20) 
-             << Dbl(kinetic + potential, 20) << std::endl;
+   kinetic   = systemPtr_->kineticEnergy();
+   potential = systemPtr_->potentialEnergy();
+   if (verbose() > 1) {
+      std::cout << Dbl(kinetic, 20) <<  Dbl(potential, 20)
+                << Dbl(kinetic + potential, 20) << std::endl;
+   }
+
+}
 
+/*
+* With nSubStep = 1, NveRespaIntegrator must reproduce NveVvIntegrator.
+*/
+void MdIntegratorTest::testNveRespaIntegrator()
+{
+   printMethod(TEST_FUNC);
+   const int nStep = 50;
+
+   DArray<Vector> positions0, velocities0;
+   DArray<Vector> positions, velocities;
+   saveState(positions0, velocities0);
+   run(systemPtr_->mdIntegrator(), nStep);
+   saveState(positions, velocities);
+
+   restoreState(positions0, velocities0);
+   NveRespaIntegrator respa(*systemPtr_);
+   readIntegrator(respa, "in/NveRespaIntegrator");
+   run(respa, nStep);
+
+   double diff = maxDifference(positions, velocities);
+   if (verbose() > 1) {
+      std::cout << std::endl << "Max difference = " << diff << std::endl;
+   }
+   TEST_ASSERT(diff < 1.0E-8);
+}
+
+/*
+* With nSubStep = 1, NvtRespaIntegrator must reproduce NvtNhIntegrator.
+*/
+void MdIntegratorTest::testNvtRespaIntegrator()
+{
+   printMethod(TEST_FUNC);
+   const int nStep = 50;
+
+   DArray<Vector> positions0, velocities0;
+   DArray<Vector> positions, velocities;
+   saveState(positions0, velocities0);
+   NvtNhIntegrator nh(*systemPtr_);
+   readIntegrator(nh, "in/NvtNhIntegrator");
+   run(nh, nStep);
+   saveState(positions, velocities);
+
+   restoreState(positions0, velocities0);
+   NvtRespaIntegrator respa(*systemPtr_);
+   readIntegrator(respa, "in/NvtRespaIntegrator");
+   run(respa, nStep);
+
+   double diff = maxDifference(positions, velocities);
+   if (verbose() > 1) {
+      std::cout << std::endl << "Max difference = " << diff << std::endl;
+   }
+   TEST_ASSERT(diff < 1.0E-8);
 }
 
 TEST_BEGIN(MdIntegratorTest)
+TEST_ADD(MdIntegratorTest, testReadParam)
 TEST_ADD(MdIntegratorTest, testIntegrator)
+TEST_ADD(MdIntegratorTest, testNveRespaIntegrator)
+TEST_ADD(MdIntegratorTest, testNvtRespaIntegrator)
 TEST_END(MdIntegratorTest)
 
 #endif
@@ -10,6 +10,8 @@
 #include <util/space/Vector.h>
 #include <util/random/Random.h>
 #include <util/containers/RArray.h>
+#include <util/containers/DArray.h>
+#include <util/containers/GArray.h>
 
 #include <iostream>
 
@@ -576,6 +578,73 @@ public:
       Atom::deallocate();
    }
 
+   void testGetNeighborsMultiple()
+   {
+      printMethod(TEST_FUNC);
+      const int  nAtom = 200;
+      const int  nPosition = 3;
+      double     cutoff  = 1.2;
+      int        i, j, k;
+
+      // Set up CellList
+      Vector Lin(6.0, 7.0, 8.0);
+      boundary.setOrthorhombic(Lin);  
+      cellList.setAtomCapacity(nAtom);
+      cellList.setup(boundary, cutoff);
+
+      // Allocate Atoms, place at random, and add to cell list
+      RArray<Atom>  atoms;
+      Atom::allocate(nAtom, atoms);
+      Vector        pos;
+      Random        random;
+      random.setSeed(1098640);
+      cellList.clear();
+      for (i=0; i < nAtom; i++) {
+         boundary.randomPosition(random, pos);
+         atoms[i].setTypeId(0);
+         atoms[i].position() = pos;
+         cellList.addAtom(atoms[i]);
+      }
+
+      // Choose nearby positions, and count neighbors of each
+      Vector positions[nPosition];
+      positions[0] = Vector(0.2, 3.0, 7.9);
+      positions[1] = Vector(1.1, 3.5, 7.2);
+      positions[2] = Vector(5.9, 2.4, 0.3);
+      DArray<int> counts;
+      counts.allocate(nAtom);
+      for (i=0; i < nAtom; i++) {
+         counts[i] = 0;
+      }
+      CellList::NeighborArray neighborPtrs;
+      for (k=0; k < nPosition; ++k) {
+         cellList.getNeighbors(positions[k], neighborPtrs);
+         for (j=0; j < neighborPtrs.size(); ++j) {
+            ++counts[neighborPtrs[j]->id()];
+         }
+      }
+
+      // Check that union contains each neighbor exactly once
+      GArray<Atom*> unionPtrs;
+      for (k=0; k < 2; ++k) {
+         cellList.getNeighbors(positions, nPosition, unionPtrs);
+         int nUnion = 0;
+         for (i=0; i < nAtom; i++) {
+            if (counts[i] > 0) ++nUnion;
+         }
+         TEST_ASSERT(unionPtrs.size() == nUnion);
+         for (j=0; j < unionPtrs.size(); ++j) {
+            i = unionPtrs[j]->id();
+            TEST_ASSERT(counts[i] > 0);
+            for (int m = j + 1; m < unionPtrs.size(); ++m) {
+               TEST_ASSERT(unionPtrs[m] != unionPtrs[j]);
+            }
+         }
+      }
+
+      Atom::deallocate();
+   }
+
    void writeCellConfiguration()
    {
       printf("numCells: %i %i %i \n", 
@@ -601,6 +670,7 @@ TEST_ADD(CellListTest, testAddRandomAtoms)
 TEST_ADD(CellListTest, testBuild)
 TEST_ADD(CellListTest, testUpdateAtomCell)
 TEST_ADD(CellListTest, testGetNeighbors)
+TEST_ADD(CellListTest, testGetNeighborsMultiple)
 TEST_END(CellListTest)
 
 #endif
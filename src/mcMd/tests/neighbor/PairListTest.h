@@ -140,6 +140,29 @@ public:
       }
       TEST_ASSERT(nPair == pairList.nAtom2_);
 
+      // Check that iteration over three ranges of primary atoms visits
+      // the same pairs, in the same order, as a single iteration
+      Atom  *range1Ptr, *range2Ptr;
+      int    nAtom1 = pairList.nAtom1();
+      int    nRange = 3;
+      PairIterator iter(pairList);
+      nPair = 0;
+      for (i = 0; i < nRange; ++i) {
+         PairIterator rangeIter;
+         pairList.begin(rangeIter, i*nAtom1/nRange, (i+1)*nAtom1/nRange);
+         for ( ; rangeIter.notEnd(); ++rangeIter) {
+            TEST_ASSERT(iter.notEnd());
+            rangeIter.getPair(range1Ptr, range2Ptr);
+            iter.getPair(atom1Ptr, atom2Ptr);
+            TEST_ASSERT(range1Ptr == atom1Ptr);
+            TEST_ASSERT(range2Ptr == atom2Ptr);
+            ++iter;
+            ++nPair;
+         }
+      }
+      TEST_ASSERT(iter.isEnd());
+      TEST_ASSERT(nPair == pairList.nPair());
+
       // Verbose output - list atom Ids for all pairs
       if (verbose() > 1) {
          for (PairIterator iter(pairList); iter.notEnd(); ++iter) {
@@ -0,0 +1,19 @@
+#ifdef UTIL_MPI
+#ifdef MCMD_PERTURB
+#include "ReplicaMoveTest.h"
+#include <mcMd/simulation/McMd_mpi.h>
+
+using namespace Util;
+
+int main()
+{
+   MPI::Init();
+   McMd::commitMpiTypes();
+
+   TEST_RUNNER(ReplicaMoveTest) test;
+   test.run();
+
+   MPI::Finalize();
+}
+#endif
+#endif
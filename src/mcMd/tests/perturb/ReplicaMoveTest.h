@@ -0,0 +1,227 @@
+#ifdef  UTIL_MPI
+#ifdef  MCMD_PERTURB
+#ifndef MCMD_REPLICA_MOVE_TEST_H
+#define MCMD_REPLICA_MOVE_TEST_H
+
+#define TEST_MPI
+
+#include <mcMd/mcSimulation/McSimulation.h>
+#include <mcMd/mcSimulation/McSystem.h>
+#include <mcMd/perturb/Perturbation.h>
+#include <mcMd/perturb/ReplicaMove.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+
+#include <test/ParamFileTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <fstream>
+
+using namespace Util;
+using namespace McMd;
+
+/*
+* Tests of ReplicaMove. Must be run on 3 processors, one for each row of
+* the perturbation parameter table, e.g., mpirun -np 3 MpiTest.
+*/
+class ReplicaMoveTest : public ParamFileTest
+{
+
+public:
+
+   void testParameterSwap();
+   void testSameExchange();
+
+private:
+
+   void initialize(McSimulation& simulation, const char* filename);
+   void savePositions(McSimulation& simulation, DArray<Vector>& positions);
+   bool isPermutation(const DArray<int>& states);
+
+};
+
+/*
+* Read a common parameter file, and a separate configuration for each
+* processor, from file r/in/config on processor r.
+*/
+void ReplicaMoveTest::initialize(McSimulation& simulation,
+                                 const char* filename)
+{
+   simulation.fileMaster().setRootPrefix(filePrefix());
+   simulation.system().setExpectPerturbation();
+   simulation.setIoCommunicator();
+   openFile(filename);
+   simulation.readParam(file());
+   closeFile();
+
+   std::ifstream in;
+   simulation.fileMaster().openInputFile("config", in);
+   simulation.system().readConfig(in);
+   in.close();
+}
+
+/*
+* Copy positions of all atoms, in order.
+*/
+void ReplicaMoveTest::savePositions(McSimulation& simulation,
+                                    DArray<Vector>& positions)
+{
+   McSystem& system = simulation.system();
+   if (!positions.isAllocated()) {
+      positions.allocate(simulation.atomCapacity());
+   }
+   System::MoleculeIterator molIter;
+   Molecule::AtomIterator atomIter;
+   int i = 0;
+   for (int iSpecies = 0; iSpecies < simulation.nSpecies(); ++iSpecies) {
+      for (system.begin(iSpecies, molIter); molIter.notEnd(); ++molIter) {
+         for (molIter->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+            positions[i] = atomIter->position();
+            ++i;
+         }
+      }
+   }
+}
+
+/*
+* Is every state index 0,...,states.capacity()-1 present exactly once?
+*/
+bool ReplicaMoveTest::isPermutation(const DArray<int>& states)
+{
+   int n = states.capacity();
+   DArray<int> counts;
+   counts.allocate(n);
+   int i;
+   for (i = 0; i < n; ++i) {
+      counts[i] = 0;
+   }
+   for (i = 0; i < n; ++i) {
+      if (states[i] < 0 || states[i] >= n) return false;
+      ++counts[states[i]];
+   }
+   for (i = 0; i < n; ++i) {
+      if (counts[i] != 1) return false;
+   }
+   return true;
+}
+
+/*
+* In parameter-swap mode, each processor keeps its configuration, the
+* states of all processors form a permutation, and the perturbation
+* parameters are those of the current state.
+*/
+void ReplicaMoveTest::testParameterSwap()
+{
+   printMethod(TEST_FUNC);
+
+   McSimulation simulation(communicator());
+   initialize(simulation, "in/ReplicaMoveSwap");
+   ReplicaMove& move = simulation.system().replicaMove();
+   Perturbation& perturbation = simulation.system().perturbation();
+   TEST_ASSERT(move.swapsParameters());
+   TEST_ASSERT(move.stateId() == mpiRank());
+
+   DArray<Vector> positions0, positions;
+   savePositions(simulation, positions0);
+
+   int nProcs = communicator().Get_size();
+   DArray<int> states;
+   states.allocate(nProcs);
+   int stateId;
+   int nChange = 0;
+   for (int i = 0; i < 10; ++i) {
+      TEST_ASSERT(move.move());
+      stateId = move.stateId();
+      TEST_ASSERT(eq(perturbation.parameter(0),
+                     perturbation.parameter(0, stateId)));
+      perturbation.derivative(0);
+      communicator().Allgather(&stateId, 1, MPI::INT,
+                               &states[0], 1, MPI::INT);
+      TEST_ASSERT(isPermutation(states));
+      if (stateId != mpiRank()) ++nChange;
+   }
+   int nChangeAll;
+   communicator().Allreduce(&nChange, &nChangeAll, 1, MPI::INT, MPI::SUM);
+   TEST_ASSERT(nChangeAll > 0);
+
+   // Configurations are not exchanged
+   savePositions(simulation, positions);
+   for (int i = 0; i < simulation.system().nAtom(); ++i) {
+      TEST_ASSERT(positions[i] == positions0[i]);
+   }
+}
+
+/*
+* For the same seed and configurations, the first exchange must pair
+* each configuration with the same state in both modes.
+*/
+void ReplicaMoveTest::testSameExchange()
+{
+   printMethod(TEST_FUNC);
+
+   int nProcs = communicator().Get_size();
+   int r;
+
+   // Parameter swap: configuration r stays on processor r
+   DArray<int> states;
+   states.allocate(nProcs);
+   {
+      McSimulation simulation(communicator());
+      initialize(simulation, "in/ReplicaMoveSwap");
+      ReplicaMove& move = simulation.system().replicaMove();
+      move.move();
+      int stateId = move.stateId();
+      communicator().Allgather(&stateId, 1, MPI::INT,
+                               &states[0], 1, MPI::INT);
+   }
+
+   // Configuration swap: processor r keeps state r
+   {
+      McSimulation simulation(communicator());
+      initialize(simulation, "in/ReplicaMove");
+      ReplicaMove& move = simulation.system().replicaMove();
+      Perturbation& perturbation = simulation.system().perturbation();
+
+      // Identify configurations by the position of their first atom
+      DArray<Vector> positions;
+      DArray<Vector> firsts;
+      firsts.allocate(nProcs);
+      savePositions(simulation, positions);
+      communicator().Allgather(&positions[0], 1, MpiTraits<Vector>::type,
+                               &firsts[0], 1, MpiTraits<Vector>::type);
+
+      move.move();
+      TEST_ASSERT(!move.swapsParameters());
+      TEST_ASSERT(eq(perturbation.parameter(0),
+                     perturbation.parameter(0, mpiRank())));
+
+      savePositions(simulation, positions);
+      int configId = -1;
+      for (r = 0; r < nProcs; ++r) {
+         if (positions[0] == firsts[r]) {
+            TEST_ASSERT(configId == -1);
+            configId = r;
+         }
+      }
+      TEST_ASSERT(configId >= 0);
+      TEST_ASSERT(states[configId] == mpiRank());
+   }
+
+   // The exchange is not trivial
+   int nChange = 0;
+   for (r = 0; r < nProcs; ++r) {
+      if (states[r] != r) ++nChange;
+   }
+   TEST_ASSERT(nChange > 0);
+}
+
+TEST_BEGIN(ReplicaMoveTest)
+TEST_ADD(ReplicaMoveTest, testParameterSwap)
+TEST_ADD(ReplicaMoveTest, testSameExchange)
+TEST_END(ReplicaMoveTest)
+
+#endif
+#endif
+#endif
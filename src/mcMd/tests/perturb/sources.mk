@@ -1,7 +1,10 @@
+ifdef UTIL_MPI
+mcMd_tests_perturb_=mcMd/tests/perturb/MpiTest.cc 
+else
 mcMd_tests_perturb_=mcMd/tests/perturb/Test.cc 
+endif
 
 mcMd_tests_perturb_SRCS=\
      $(addprefix $(SRC_DIR)/, $(mcMd_tests_perturb_))
 mcMd_tests_perturb_OBJS=\
      $(addprefix $(BLD_DIR)/, $(mcMd_tests_perturb_:.cc=.o))
-
@@ -0,0 +1,151 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "DdMdParallelTrajectoryReader.h"
+#include <mcMd/simulation/System.h>
+#include <mcMd/simulation/Simulation.h>
+#include <mcMd/species/Species.h>
+#include <mcMd/chemistry/Molecule.h>
+#include <mcMd/chemistry/Atom.h>
+#include <util/archives/BinaryFileIArchive.h>
+#include <util/space/Vector.h>
+#include <util/space/IntVector.h>
+#include <util/misc/ioUtil.h>
+
+#include <climits>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   DdMdParallelTrajectoryReader::DdMdParallelTrajectoryReader(System &system)
+   : TrajectoryReader(system)
+   {}
+
+   /*
+   * Destructor.
+   */
+   DdMdParallelTrajectoryReader::~DdMdParallelTrajectoryReader()
+   {}
+
+   /*
+   * Open trajectory file and setup to read.
+   */
+   void DdMdParallelTrajectoryReader::open(std::string filename)
+   {
+      // Open trajectory file
+      file_.open(filename.c_str());
+      if (file_.fail()) {
+         std::string message;
+         message= "Error opening trajectory file. Filename: " + filename;
+         UTIL_THROW(message.c_str());
+      }
+
+      BinaryFileIArchive ar(file_);
+      int nAtom;
+      ar >> nAtom;
+      
+      // Add all molecules to system and check consistency of nAtom.
+      addMolecules();
+      if (nAtom != nAtomTotal_) {
+         UTIL_THROW("Inconsistent values: nAtom != nAtomTotal_");
+      }
+     
+      // Allocate private array of atomic positions_
+      if (!positions_.isAllocated()) {
+         positions_.allocate(nAtomTotal_);
+      } else {
+         if (nAtomTotal_ != positions_.capacity()) {
+            UTIL_THROW("Inconsistent values of atom capacity");
+         }
+      }
+   }
+
+   /*
+   * Read frame, return false if end-of-file
+   */
+   bool DdMdParallelTrajectoryReader::readFrame()
+   {
+      // Preconditions
+      if (!positions_.isAllocated()) {
+         UTIL_THROW("positions_ array is not allocated");
+      }
+
+      BinaryFileIArchive ar(file_);
+
+      // Attempt to read iStep
+      long iStep = -1;  
+      ar >> iStep;
+
+      // Return false if read failed, indicating end of file.
+      if (file_.eof()) {
+         return false;
+      }
+
+      // Read boundary dimensions
+      ar >> boundary();
+
+      // Read index block, and check total number of atoms
+      int nBlock, blockSize, nAtom, i;
+      ar >> nBlock;
+      nAtom = 0;
+      for (i = 0; i < nBlock; ++i) {
+         ar >> blockSize;
+         nAtom += blockSize;
+      }
+      if (nAtom != nAtomTotal_) {
+         UTIL_THROW("Inconsistent values: nAtom in frame != nAtomTotal_");
+      }
+
+      // Loop over atom blocks, store atomic positions by id
+      Vector r;
+      double h = 1.0/(double(UINT_MAX) + 1.0);
+      int id, j;
+      unsigned int ir;
+      for (i = 0; i < nAtomTotal_; ++i) {
+         ar >> id;
+         if (id < 0 || id >= nAtomTotal_) {
+            UTIL_THROW("Invalid atom id");
+         }
+         for (j = 0; j < Dimension; ++j) {
+            ar >> ir;
+            r[j] = ir*h;
+         }
+         boundary().transformGenToCart(r, positions_[id]);
+      }
+
+      // Assign atom positions, assuming ordered atom ids 
+      int iSpecies, iMol;
+      Species *speciesPtr;
+      Molecule::AtomIterator atomIter;
+      Molecule *molPtr;
+      id = 0;
+      for (iSpecies = 0; iSpecies < simulation().nSpecies(); ++iSpecies) {
+         speciesPtr = &simulation().species(iSpecies);
+         for (iMol = 0; iMol < speciesPtr->capacity(); ++iMol) {
+            molPtr = &system().molecule(iSpecies, iMol);
+            for (molPtr->begin(atomIter); atomIter.notEnd(); ++atomIter) {
+               atomIter->position() = positions_[id];
+               id++;
+            }
+         }
+      }
+
+      return true;
+   }
+
+   /*
+   * Close trajectory file.
+   */
+   void DdMdParallelTrajectoryReader::close()
+   {  file_.close(); }
+
+}
@@ -0,0 +1,81 @@
+#ifndef MCMD_DDMD_PARALLEL_TRAJECTORY_READER_H
+#define MCMD_DDMD_PARALLEL_TRAJECTORY_READER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <mcMd/trajectory/TrajectoryReader.h> // base class
+#include <util/containers/DArray.h>           // member 
+#include <util/space/Vector.h>                // member 
+
+#include <iostream>
+
+namespace McMd
+{
+
+   using namespace Util;
+
+   /**
+   * TrajectoryReader for a trajectory written by DdMdParallelTrajectoryWriter.
+   *
+   * Each frame of this format contains an index block that gives the 
+   * number of atoms in each of several atom blocks, which are written 
+   * in arbitrary atom order. Atoms are reordered by id as they are read.
+   *
+   * Like DdMdTrajectoryReader, this class assumes that atom tags are 
+   * ordered by molecule and species, with consecutive ids for atoms in 
+   * the same molecule and consecutive blocks for molecules in the same 
+   * species.
+   *
+   * \ingroup McMd_Trajectory_Module
+   */
+   class DdMdParallelTrajectoryReader : public TrajectoryReader
+   {
+   
+   public:
+
+      /**
+      * Constructor. 
+      */
+      DdMdParallelTrajectoryReader(System& system);
+
+      /** 
+      * Destructor.   
+      */
+      virtual ~DdMdParallelTrajectoryReader();
+ 
+      /**
+      * Open trajectory file, read header, and allocate memory.
+      *
+      * \param filename trajectory file name
+      */
+      void open(std::string filename);
+
+      /**
+      * Read a single frame. Frames are assumed to be read consecutively.
+      *
+      * \return true if this frame is available, false if end of file
+      */
+      bool readFrame();
+
+      /**
+      * Close trajectory file.
+      */
+      void close();
+
+   private:
+
+      /// Trajectory file.
+      std::ifstream file_;
+
+      /// Atom positions, indexed by id.
+      DArray< Vector > positions_;
+
+   }; 
+
+} 
+#endif
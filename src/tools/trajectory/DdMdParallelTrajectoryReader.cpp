@@ -0,0 +1,95 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "DdMdParallelTrajectoryReader.h" 
+#include <tools/storage/Configuration.h>
+#include <util/archives/BinaryFileIArchive.h>
+#include <util/space/Vector.h>
+#include <util/misc/ioUtil.h>
+
+#include <climits>
+
+namespace Tools
+{
+
+   using namespace Util;
+
+   /*
+   * Constructor.
+   */
+   DdMdParallelTrajectoryReader::DdMdParallelTrajectoryReader(Configuration& configuration)
+    : TrajectoryReader(configuration, true)
+   {  setClassName("DdMdParallelTrajectoryReader"); }
+
+   /*
+   * Destructor.
+   */
+   DdMdParallelTrajectoryReader::~DdMdParallelTrajectoryReader()
+   {}
+
+   void DdMdParallelTrajectoryReader::readHeader(std::ifstream &file)
+   {
+      BinaryFileIArchive ar(file);
+      ar >> nAtom_;
+   }
+
+   /*
+   * Read a frame.
+   */
+   bool DdMdParallelTrajectoryReader::readFrame(std::ifstream& file)
+   {
+      BinaryFileIArchive ar(file);
+
+      // Attempt to read iStep
+      long iStep = -1;  
+      ar >> iStep;
+
+      // Return false if read failed, indicating end of file.
+      if (file.eof()) {
+         return false;
+      }
+
+      // Read boundary dimensions
+      Util::Boundary& boundary = configuration().boundary();
+      ar >> boundary;
+
+      // Read index block, and check total number of atoms
+      int nBlock, blockSize, nAtom, i;
+      ar >> nBlock;
+      nAtom = 0;
+      for (i = 0; i < nBlock; ++i) {
+         ar >> blockSize;
+         nAtom += blockSize;
+      }
+      if (nAtom != nAtom_) {
+         UTIL_THROW("Inconsistent number of atoms in frame");
+      }
+
+      // Loop over atom blocks, read atomic positions
+      AtomStorage* storagePtr = &configuration().atoms();
+      Atom* atomPtr;
+      Vector r;
+      double h = 1.0/(double(UINT_MAX) + 1.0);
+      int id, j;
+      unsigned int ir;
+      for (i = 0; i < nAtom_; ++i) {
+         ar >> id;
+         atomPtr = storagePtr->ptr(id);
+         if (atomPtr == 0) {
+            UTIL_THROW("Unknown atom");
+         }
+         for (j = 0; j < Dimension; ++j) {
+            ar >> ir;
+            r[j] = ir*h;
+         }
+         boundary.transformGenToCart(r, atomPtr->position);
+      }
+
+      return true;
+   }
+
+}
@@ -0,0 +1,68 @@
+#ifndef TOOLS_DDMD_PARALLEL_TRAJECTORY_READER_H
+#define TOOLS_DDMD_PARALLEL_TRAJECTORY_READER_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <tools/trajectory/TrajectoryReader.h>  // base class
+
+namespace Tools
+{
+
+   class Configuration;
+   using namespace Util;
+
+   /**
+   * Reader for trajectories written by DdMd::DdMdParallelTrajectoryWriter.
+   *
+   * Each frame of this format contains an index block that gives the
+   * number of atoms in each of several atom blocks, in which atoms appear
+   * in arbitrary order. Atoms are located by id as they are read.
+   *
+   * \ingroup Tools_Trajectory_Module
+   */
+   class DdMdParallelTrajectoryReader  : public TrajectoryReader
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      *
+      * \param configuration parent Configuration object
+      */
+      DdMdParallelTrajectoryReader(Configuration& configuration);
+
+      /**
+      * Destructor.
+      */
+      virtual ~DdMdParallelTrajectoryReader();
+
+      /**
+      * Read the header.
+      *
+      * \param file input file 
+      */
+      virtual void readHeader(std::ifstream& file);
+
+      /**
+      * Read a frame.
+      *
+      * \param file input file 
+      * \return true if a frame was found, false if end of file
+      */
+      virtual bool readFrame(std::ifstream& file);
+
+   private:
+
+      // Number of atoms
+      int nAtom_;
+
+   };
+
+}
+#endif
@@ -178,6 +178,21 @@ namespace Util
          nReject_ += 1;
       }
    }
+
+   /*
+   * Add the histogram and sample counts of another Distribution.
+   */
+   void Distribution::add(const Distribution& other)
+   {
+      if (other.nBin_ != nBin_) {
+         UTIL_THROW("Inconsistent values of nBin");
+      }
+      for (int i=0; i < nBin_; ++i) {
+         histogram_[i] += other.histogram_[i];
+      }
+      nSample_ += other.nSample_;
+      nReject_ += other.nReject_;
+   }
    
    /* 
    * Output histogram
@@ -211,18 +226,18 @@ namespace Util
             histogram_[i] = 0.0;
          }
       }
-      delete totHistogram;
+      delete [] totHistogram;
 
-      long totSample; 
-      communicator.Reduce(&nSample_, &totSample, 1, MPI::LONG, MPI::SUM, root);
+      int totSample; 
+      communicator.Reduce(&nSample_, &totSample, 1, MPI::INT, MPI::SUM, root);
       if (communicator.Get_rank() == root) {
          nSample_ = totSample;
       } else {
          nSample_ = 0;
       }
 
-      long totReject; 
-      communicator.Reduce(&nReject_, &totReject, 1, MPI::LONG, MPI::SUM, root);
+      int totReject; 
+      communicator.Reduce(&nReject_, &totReject, 1, MPI::INT, MPI::SUM, root);
       if (communicator.Get_rank() == root) {
          nReject_ = totReject;
       } else {
@@ -98,6 +98,17 @@ namespace Util
       */
       void sample(double value);
    
+      /**
+      * Add the histogram and sample counts of another Distribution.
+      *
+      * The other Distribution must have the same range and number of 
+      * bins. This is used to merge partial histograms, e.g., histograms
+      * accumulated by different threads.
+      *
+      * \param other Distribution to be added to this one
+      */
+      void add(const Distribution& other);
+   
       /**
       * Clear (i.e., zero) previously allocated histogram.
       */
@@ -137,6 +148,11 @@ namespace Util
       */
       int nBin() const;
 
+      /** 
+      * Get the histogram array, with one count per bin.
+      */
+      const DArray<long>& data() const;
+
       #ifdef UTIL_MPI
       /**
       * Reduce (add) distributions from multiple MPI processors.
@@ -191,6 +207,12 @@ namespace Util
    inline int Distribution::nBin() const
    {  return nBin_; }
 
+   /*
+   * Get the histogram array.
+   */
+   inline const DArray<long>& Distribution::data() const
+   {  return histogram_; }
+
    /*
    * Serialize this Distribution.
    */
@@ -0,0 +1,644 @@
+#ifndef UTIL_MULTI_TAU_ARRAY_H
+#define UTIL_MULTI_TAU_ARRAY_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/param/ParamComposite.h>       // base class
+#include <util/containers/DArray.h>          // member template
+#include <util/containers/Array.h>
+#include <util/accumulators/setToZero.h>
+#include <util/accumulators/product.h>
+#include <util/format/Lng.h>
+#include <util/format/Dbl.h>
+#include <util/global.h>
+
+namespace Util
+{
+
+   /**
+   * Multiple-tau correlation function for an ensemble of sequences.
+   *
+   * This class calculates either an autocorrelation function
+   * C(t) = <x(i), x(i+t)> or a mean-squared displacement
+   * MSD(t) = <|x(i+t) - x(i)|^2> for an ensemble of nEnsemble
+   * statistically equivalent sequences x(i) of values of type Data.
+   * The inner product <A,B> and the zero value are defined for each
+   * Data type by the functions product() and setToZero() defined in
+   * files product.h and setToZero.h, as for AutoCorrArray.
+   *
+   * Values are stored in a set of stages. Stage k stores the most
+   * recent bufferCapacity values with sample indices that are
+   * multiples of blockFactor^k, and accumulates products for delays
+   * t = j*blockFactor^k, with bufferCapacity/blockFactor <= j <
+   * bufferCapacity for k > 0, and 0 <= j < bufferCapacity for k = 0.
+   * Delays are thus spaced approximately logarithmically, up to a
+   * maximum of order bufferCapacity*blockFactor^maxStageId.
+   * Higher stages subsample the sequence rather than averaging blocks
+   * of values, so that the result for each delay is an unbiased
+   * estimate, and mean-squared displacements are exact.
+   *
+   * The memory required for each sequence is proportional to
+   * bufferCapacity times the number of stages, which grows as the
+   * logarithm of the number of samples. The amortized cost of each
+   * sample is less than (1 + 1/blockFactor)*bufferCapacity products
+   * per sequence, independent of the length of the simulation.
+   * Values of all sequences that are sampled at the same time are
+   * stored contiguously, so that the innermost loop over sequences
+   * accesses memory with unit stride.
+   *
+   * \ingroup Accumulators_Module
+   */
+   template <typename Data, typename Product>
+   class MultiTauArray : public ParamComposite
+   {
+
+   public:
+
+      /// Default constructor.
+      MultiTauArray();
+
+      /// Default destructor.
+      ~MultiTauArray();
+
+      /**
+      * Read parameters, allocate memory and clear history.
+      *
+      * Reads parameters ensembleCapacity and bufferCapacity, and
+      * optional parameters blockFactor (default 2) and maxStageId
+      * (default 20), sets nEnsemble = ensembleCapacity and calls
+      * clear().
+      *
+      * \param in input parameter stream
+      */
+      virtual void readParameters(std::istream& in);
+
+      /**
+      * Set parameters, allocate memory, and clear history.
+      *
+      * \param ensembleCapacity maximum number of sequences in ensemble
+      * \param bufferCapacity  number of values stored in each stage
+      * \param blockFactor  ratio of sampling intervals of stages
+      * \param maxStageId  maximum stage index (primary stage = 0)
+      */
+      void setParam(int ensembleCapacity, int bufferCapacity,
+                    int blockFactor = 2, int maxStageId = 20);
+
+      /**
+      * Load internal state from an archive.
+      *
+      * \param ar input/loading archive
+      */
+      virtual void loadParameters(Serializable::IArchive &ar);
+
+      /**
+      * Save internal state to an archive.
+      *
+      * \param ar output/saving archive
+      */
+      virtual void save(Serializable::OArchive &ar);
+
+      /**
+      * Choose between mean-squared displacement and autocorrelation.
+      *
+      * The default is autocorrelation. Call before sampling.
+      *
+      * \param isMeanSqDisp true for mean-squared displacement
+      */
+      void setMeanSqDisp(bool isMeanSqDisp);
+
+      /**
+      * Set actual number of sequences in ensemble.
+      *
+      * \pre nEnsemble <= ensembleCapacity
+      *
+      * \param nEnsemble actual number of sequences in ensemble
+      */
+      void setNEnsemble(int nEnsemble);
+
+      /**
+      * Reset to empty state.
+      */
+      void clear();
+
+      /**
+      * Sample an array of current values.
+      *
+      * \param values Array of current values, one per sequence
+      */
+      void sample(const Array<Data>& values);
+
+      /**
+      * Output delay and average value, one delay per line.
+      *
+      * \param out output stream
+      */
+      void output(std::ostream& out) const;
+
+      /**
+      * Serialize to/from an archive.
+      *
+      * \param ar       input or output archive
+      * \param version  file version id
+      */
+      template <class Archive>
+      void serialize(Archive& ar, const unsigned int version);
+
+      /**
+      * Return number of values stored in each stage.
+      */
+      int bufferCapacity() const;
+
+      /**
+      * Return ratio of sampling intervals of successive stages.
+      */
+      int blockFactor() const;
+
+      /**
+      * Return nEnsemble.
+      */
+      int nEnsemble() const;
+
+      /**
+      * Return the number of samples per sequence thus far.
+      */
+      long nSample() const;
+
+      /**
+      * Return the number of stages that have been created.
+      */
+      int nStage() const;
+
+      /**
+      * Return the sampling interval of a stage, blockFactor^stageId.
+      *
+      * \param stageId stage index, 0 <= stageId <= maxStageId
+      */
+      long stageInterval(int stageId) const;
+
+      /**
+      * Return the smallest delay index j accumulated by a stage.
+      *
+      * \param stageId stage index
+      */
+      int firstDelay(int stageId) const;
+
+      /**
+      * Return the number of products accumulated for one delay.
+      *
+      * \param stageId stage index
+      * \param j delay index, delay = j*stageInterval(stageId)
+      */
+      long nCorr(int stageId, int j) const;
+
+      /**
+      * Return the average value for one delay.
+      *
+      * \pre nCorr(stageId, j) > 0
+      *
+      * \param stageId stage index
+      * \param j delay index, delay = j*stageInterval(stageId)
+      */
+      Product value(int stageId, int j) const;
+
+   private:
+
+      /// Stored values for each stage, bufferCapacity blocks of nEnsemble.
+      DArray< DArray<Data> > buffers_;
+
+      /// Sum of products, index stageId*bufferCapacity + j.
+      DArray<Product> corr_;
+
+      /// Number of values added to corr_, with the same indexing.
+      DArray<long> nCorr_;
+
+      /// Buffer slot of the most recent value, for each stage.
+      DArray<int> heads_;
+
+      /// Number of values stored, for each stage.
+      DArray<int> sizes_;
+
+      /// Maximum number of sequences for which memory is allocated.
+      int  ensembleCapacity_;
+
+      /// Number of values stored by each stage.
+      int  bufferCapacity_;
+
+      /// Ratio of sampling intervals of successive stages.
+      int  blockFactor_;
+
+      /// Maximum stage index.
+      int  maxStageId_;
+
+      /// Actual number of sequences.
+      int  nEnsemble_;
+
+      /// Number of stages created.
+      int  nStage_;
+
+      /// Number of sampled values per sequence.
+      long  nSample_;
+
+      /// Accumulate mean-squared displacement (true) or correlation?
+      bool isMeanSqDisp_;
+
+      /**
+      * Validate parameters, allocate memory and call clear.
+      */
+      void allocate();
+
+      /**
+      * Add current values to one stage, and accumulate products.
+      *
+      * \param stageId stage index
+      * \param values array of current values
+      */
+      void sampleStage(int stageId, const Data* values);
+
+   };
+
+   /*
+   * Default constructor.
+   */
+   template <typename Data, typename Product>
+   MultiTauArray<Data, Product>::MultiTauArray()
+    : buffers_(),
+      corr_(),
+      nCorr_(),
+      heads_(),
+      sizes_(),
+      ensembleCapacity_(0),
+      bufferCapacity_(0),
+      blockFactor_(2),
+      maxStageId_(20),
+      nEnsemble_(0),
+      nStage_(0),
+      nSample_(0),
+      isMeanSqDisp_(false)
+   {  setClassName("MultiTauArray"); }
+
+   /*
+   * Destructor.
+   */
+   template <typename Data, typename Product>
+   MultiTauArray<Data, Product>::~MultiTauArray()
+   {}
+
+   /*
+   * Read parameters from file.
+   */
+   template <typename Data, typename Product>
+   void MultiTauArray<Data, Product>::readParameters(std::istream& in)
+   {
+      read<int>(in, "ensembleCapacity", ensembleCapacity_);
+      read<int>(in, "bufferCapacity", bufferCapacity_);
+      readOptional<int>(in, "blockFactor", blockFactor_);
+      readOptional<int>(in, "maxStageId", maxStageId_);
+      nEnsemble_ = ensembleCapacity_;
+      allocate();
+   }
+
+   /*
+   * Set parameters and initialize.
+   */
+   template <typename Data, typename Product>
+   void
+   MultiTauArray<Data, Product>::setParam(int ensembleCapacity,
+                                          int bufferCapacity,
+                                          int blockFactor, int maxStageId)
+   {
+      ensembleCapacity_ = ensembleCapacity;
+      bufferCapacity_ = bufferCapacity;
+      blockFactor_ = blockFactor;
+      maxStageId_ = maxStageId;
+      nEnsemble_ = ensembleCapacity;
+      allocate();
+   }
+
+   /*
+   * Load internal state from archive.
+   */
+   template <typename Data, typename Product>
+   void
+   MultiTauArray<Data, Product>::loadParameters(Serializable::IArchive &ar)
+   {
+      loadParameter<int>(ar, "ensembleCapacity", ensembleCapacity_);
+      loadParameter<int>(ar, "bufferCapacity", bufferCapacity_);
+      loadParameter<int>(ar, "blockFactor", blockFactor_);
+      loadParameter<int>(ar, "maxStageId", maxStageId_);
+      ar & nEnsemble_;
+      ar & nStage_;
+      ar & nSample_;
+      ar & isMeanSqDisp_;
+      ar & heads_;
+      ar & sizes_;
+      ar & corr_;
+      ar & nCorr_;
+      ar & buffers_;
+   }
+
+   /*
+   * Save internal state to archive.
+   */
+   template <typename Data, typename Product>
+   void MultiTauArray<Data, Product>::save(Serializable::OArchive &ar)
+   {  ar & *this; }
+
+   /*
+   * Choose mean-squared displacement or autocorrelation.
+   */
+   template <typename Data, typename Product>
+   void MultiTauArray<Data, Product>::setMeanSqDisp(bool isMeanSqDisp)
+   {
+      if (nSample_ > 0) {
+         UTIL_THROW("Cannot change type of correlation after sampling");
+      }
+      isMeanSqDisp_ = isMeanSqDisp;
+   }
+
+   /*
+   * Set or reset nEnsemble.
+   */
+   template <typename Data, typename Product>
+   void MultiTauArray<Data, Product>::setNEnsemble(int nEnsemble)
+   {
+      if (ensembleCapacity_ == 0) {
+         UTIL_THROW("No memory has been allocated: ensembleCapacity_ == 0");
+      }
+      if (nEnsemble > ensembleCapacity_) {
+         UTIL_THROW("nEnsemble > ensembleCapacity_");
+      }
+      nEnsemble_ = nEnsemble;
+   }
+
+   /*
+   * Set accumulator to initial empty state.
+   */
+   template <typename Data, typename Product>
+   void MultiTauArray<Data, Product>::clear()
+   {
+      nSample_ = 0;
+      nStage_ = 0;
+      int i;
+      for (i = 0; i < corr_.capacity(); ++i) {
+         setToZero(corr_[i]);
+         nCorr_[i] = 0;
+      }
+      for (i = 0; i < heads_.capacity(); ++i) {
+         heads_[i] = -1;
+         sizes_[i] = 0;
+      }
+   }
+
+   /*
+   * Validate parameters and allocate arrays (private method).
+   *
+   * Stage buffers are allocated only when first needed, by sample().
+   */
+   template <typename Data, typename Product>
+   void MultiTauArray<Data, Product>::allocate()
+   {
+      if (ensembleCapacity_ <= 0) {
+         UTIL_THROW("ensembleCapacity must be positive");
+      }
+      if (blockFactor_ < 2) {
+         UTIL_THROW("blockFactor must be at least 2");
+      }
+      if (bufferCapacity_ <= blockFactor_ ||
+          bufferCapacity_ % blockFactor_ != 0) {
+         UTIL_THROW("bufferCapacity must be a multiple of blockFactor > 1");
+      }
+      if (maxStageId_ < 0) {
+         UTIL_THROW("Negative maxStageId");
+      }
+
+      // Limit maxStageId so that stage intervals fit in a long.
+      long interval = 1;
+      for (int i = 0; i < maxStageId_; ++i) {
+         if (interval > 2147483647L/blockFactor_) {
+            UTIL_THROW("blockFactor^maxStageId is too large");
+         }
+         interval *= blockFactor_;
+      }
+
+      int nStageCapacity = maxStageId_ + 1;
+      buffers_.allocate(nStageCapacity);
+      heads_.allocate(nStageCapacity);
+      sizes_.allocate(nStageCapacity);
+      corr_.allocate(nStageCapacity*bufferCapacity_);
+      nCorr_.allocate(nStageCapacity*bufferCapacity_);
+      clear();
+   }
+
+   /*
+   * Sample an array of current values.
+   */
+   template <typename Data, typename Product>
+   void MultiTauArray<Data, Product>::sample(const Array<Data>& values)
+   {
+      const Data* ptr = &values[0];
+      long interval = 1;
+      int stageId = 0;
+      while (stageId <= maxStageId_ && nSample_ % interval == 0) {
+
+         // Create a new stage when its second value becomes available,
+         // and copy its first value (sample 0) from the previous stage.
+         if (stageId == nStage_) {
+            if (nSample_ == 0 && stageId > 0) break;
+            int size = bufferCapacity_*ensembleCapacity_;
+            if (!buffers_[stageId].isAllocated()) {
+               buffers_[stageId].allocate(size);
+            }
+            if (stageId > 0) {
+               int prevId = stageId - 1;
+               int slot = heads_[prevId] - blockFactor_;
+               if (slot < 0) slot += bufferCapacity_;
+               const Data* first = &buffers_[prevId][slot*ensembleCapacity_];
+               Data* dest = &buffers_[stageId][0];
+               for (int i = 0; i < nEnsemble_; ++i) {
+                  dest[i] = first[i];
+               }
+               heads_[stageId] = 0;
+               sizes_[stageId] = 1;
+            }
+            ++nStage_;
+         }
+
+         sampleStage(stageId, ptr);
+         interval *= blockFactor_;
+         ++stageId;
+      }
+      ++nSample_;
+   }
+
+   /*
+   * Add values to one stage, and accumulate products (private).
+   */
+   template <typename Data, typename Product>
+   void
+   MultiTauArray<Data, Product>::sampleStage(int stageId, const Data* values)
+   {
+      // Append current values to the ring buffer for this stage
+      int head = heads_[stageId] + 1;
+      if (head == bufferCapacity_) head = 0;
+      heads_[stageId] = head;
+      if (sizes_[stageId] < bufferCapacity_) {
+         ++sizes_[stageId];
+      }
+      Data* buffer = &buffers_[stageId][0];
+      Data* current = buffer + head*ensembleCapacity_;
+      int i;
+      for (i = 0; i < nEnsemble_; ++i) {
+         current[i] = values[i];
+      }
+
+      // Accumulate products for each delay
+      Product* corr = &corr_[stageId*bufferCapacity_];
+      long* nCorr = &nCorr_[stageId*bufferCapacity_];
+      const Data* old;
+      Product sum;
+      Data diff;
+      int j, slot;
+      int size = sizes_[stageId];
+      for (j = firstDelay(stageId); j < size; ++j) {
+         slot = head - j;
+         if (slot < 0) slot += bufferCapacity_;
+         old = buffer + slot*ensembleCapacity_;
+         setToZero(sum);
+         if (isMeanSqDisp_) {
+            for (i = 0; i < nEnsemble_; ++i) {
+               diff = values[i];
+               diff -= old[i];
+               sum += product(diff, diff);
+            }
+         } else {
+            for (i = 0; i < nEnsemble_; ++i) {
+               sum += product(old[i], values[i]);
+            }
+         }
+         corr[j] += sum;
+         ++nCorr[j];
+      }
+   }
+
+   /*
+   * Output delay and average value for all accumulated delays.
+   */
+   template <typename Data, typename Product>
+   void MultiTauArray<Data, Product>::output(std::ostream& out) const
+   {
+      int stageId, j;
+      for (stageId = 0; stageId < nStage_; ++stageId) {
+         for (j = firstDelay(stageId); j < bufferCapacity_; ++j) {
+            if (nCorr(stageId, j) > 0) {
+               out << Lng(j*stageInterval(stageId), 10)
+                   << Dbl(value(stageId, j)) << std::endl;
+            }
+         }
+      }
+   }
+
+   /*
+   * Return number of values stored in each stage.
+   */
+   template <typename Data, typename Product>
+   inline int MultiTauArray<Data, Product>::bufferCapacity() const
+   {  return bufferCapacity_; }
+
+   /*
+   * Return ratio of sampling intervals of successive stages.
+   */
+   template <typename Data, typename Product>
+   inline int MultiTauArray<Data, Product>::blockFactor() const
+   {  return blockFactor_; }
+
+   /*
+   * Return number of sequences.
+   */
+   template <typename Data, typename Product>
+   inline int MultiTauArray<Data, Product>::nEnsemble() const
+   {  return nEnsemble_; }
+
+   /*
+   * Return number of sampled values.
+   */
+   template <typename Data, typename Product>
+   inline long MultiTauArray<Data, Product>::nSample() const
+   {  return nSample_; }
+
+   /*
+   * Return number of stages created.
+   */
+   template <typename Data, typename Product>
+   inline int MultiTauArray<Data, Product>::nStage() const
+   {  return nStage_; }
+
+   /*
+   * Return sampling interval of a stage.
+   */
+   template <typename Data, typename Product>
+   long MultiTauArray<Data, Product>::stageInterval(int stageId) const
+   {
+      long interval = 1;
+      for (int i = 0; i < stageId; ++i) {
+         interval *= blockFactor_;
+      }
+      return interval;
+   }
+
+   /*
+   * Return smallest delay index accumulated by a stage.
+   */
+   template <typename Data, typename Product>
+   inline int MultiTauArray<Data, Product>::firstDelay(int stageId) const
+   {  return stageId == 0 ? 0 : bufferCapacity_/blockFactor_; }
+
+   /*
+   * Return number of products accumulated for one delay.
+   */
+   template <typename Data, typename Product>
+   inline long MultiTauArray<Data, Product>::nCorr(int stageId, int j) const
+   {  return nCorr_[stageId*bufferCapacity_ + j]; }
+
+   /*
+   * Return average value for one delay.
+   */
+   template <typename Data, typename Product>
+   Product MultiTauArray<Data, Product>::value(int stageId, int j) const
+   {
+      int k = stageId*bufferCapacity_ + j;
+      assert(nCorr_[k] > 0);
+      Product value = corr_[k];
+      value /= double(nCorr_[k]*nEnsemble_);
+      return value;
+   }
+
+   /*
+   * Serialize this MultiTauArray.
+   */
+   template <typename Data, typename Product>
+   template <class Archive>
+   void MultiTauArray<Data, Product>::serialize(Archive& ar,
+                                                const unsigned int version)
+   {
+      ar & ensembleCapacity_;
+      ar & bufferCapacity_;
+      ar & blockFactor_;
+      ar & maxStageId_;
+      ar & nEnsemble_;
+      ar & nStage_;
+      ar & nSample_;
+      ar & isMeanSqDisp_;
+      ar & heads_;
+      ar & sizes_;
+      ar & corr_;
+      ar & nCorr_;
+      ar & buffers_;
+   }
+
+}
+#endif
@@ -0,0 +1,87 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "fftAutoCorr.h"
+#include <util/math/Fft.h>
+#include <util/containers/DArray.h>
+#include <util/space/IntVector.h>
+
+#include <complex>
+
+namespace Util
+{
+
+   /*
+   * Compute an autocorrelation function of stored sequences by FFT.
+   */
+   void fftAutoCorr(const Array<double>& values, int nSequence, int nTime,
+                    Array<double>& corr)
+   {
+      int nDelay = corr.capacity();
+      if (nSequence <= 0 || nTime <= 0) {
+         UTIL_THROW("nSequence and nTime must be positive");
+      }
+      if (nDelay > nTime) {
+         UTIL_THROW("corr.capacity() > nTime");
+      }
+      if (values.capacity() < nSequence*nTime) {
+         UTIL_THROW("values.capacity() < nSequence*nTime");
+      }
+
+      // Find a padded length with no prime factors larger than 5
+      int n = nTime + nDelay - 1;
+      int m;
+      while (true) {
+         m = n;
+         while (m % 2 == 0) m /= 2;
+         while (m % 3 == 0) m /= 3;
+         while (m % 5 == 0) m /= 5;
+         if (m == 1) break;
+         ++n;
+      }
+      Fft fft;
+      fft.setDimensions(IntVector(1, 1, n));
+
+      // Pack pairs of real sequences into one complex sequence, and
+      // accumulate the power spectrum |X(k)|^2 summed over sequences. 
+      // For z = x + iy, |X(k)|^2 + |Y(k)|^2 = (|Z(k)|^2 + |Z(-k)|^2)/2.
+      DArray< std::complex<double> > data;
+      DArray<double> power;
+      data.allocate(n);
+      power.allocate(n);
+      int i, s, k;
+      for (k = 0; k < n; ++k) {
+         power[k] = 0.0;
+      }
+      double y;
+      for (s = 0; s < nSequence; s += 2) {
+         for (i = 0; i < nTime; ++i) {
+            y = (s + 1 < nSequence) ? values[(s + 1)*nTime + i] : 0.0;
+            data[i] = std::complex<double>(values[s*nTime + i], y);
+         }
+         for (i = nTime; i < n; ++i) {
+            data[i] = std::complex<double>(0.0, 0.0);
+         }
+         fft.transform(&data[0]);
+         for (k = 0; k < n; ++k) {
+            power[k] += 0.5*(std::norm(data[k]) + std::norm(data[(n - k)%n]));
+         }
+      }
+
+      // Inverse transform. The power spectrum is real and symmetric,
+      // so the inverse is the real part of the forward transform / n.
+      for (k = 0; k < n; ++k) {
+         data[k] = std::complex<double>(power[k], 0.0);
+      }
+      fft.transform(&data[0]);
+      for (i = 0; i < nDelay; ++i) {
+         corr[i] = data[i].real()/(double(n)*double(nSequence)
+                                   *double(nTime - i));
+      }
+   }
+
+}
@@ -0,0 +1,47 @@
+#ifndef UTIL_FFT_AUTO_CORR_H
+#define UTIL_FFT_AUTO_CORR_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/Array.h>
+#include <util/global.h>
+
+namespace Util
+{
+
+   /**
+   * Compute an autocorrelation function of stored sequences by FFT.
+   *
+   * This function is intended for post-processing of complete stored
+   * time series, for which the hierarchical on-the-fly algorithms of
+   * AutoCorrelation and MultiTauArray are unnecessary. On output,
+   * \f[
+   *    C(t) = \frac{1}{N_{s}(n - t)} \sum_{s} \sum_{i=0}^{n-t-1}
+   *           x_{s}(i) x_{s}(i + t)
+   * \f]
+   * for each delay 0 <= t < corr.capacity(), in which n = nTime and
+   * the sum over s runs over nSequence sequences. Sequences are zero
+   * padded to a length of at least nTime + corr.capacity() - 1, so
+   * that the result is identical to a direct sum. The cost is of
+   * order nSequence*nTime*log(nTime), independent of the number of
+   * delays. To correlate Vector values, store each Cartesian component
+   * as a separate sequence, and multiply the result by Dimension.
+   *
+   * \param values  values of all sequences, with values[s*nTime + i]
+   *                equal to value i of sequence s
+   * \param nSequence  number of sequences
+   * \param nTime  number of values in each sequence
+   * \param corr  output autocorrelation, with capacity <= nTime
+   *
+   * \ingroup Accumulators_Module
+   */
+   void fftAutoCorr(const Array<double>& values, int nSequence, int nTime,
+                    Array<double>& corr);
+
+}
+#endif
@@ -12,6 +12,11 @@
 namespace Util
 {
 
+   /*
+   * Tag at the beginning of a file header (see BinaryFileOArchive.cpp).
+   */
+   static const char HeaderTag[8] = {'S','P','C','_','A','R','C','H'};
+
    /*
    * Constructor.
    */
@@ -55,6 +60,30 @@ namespace Util
    std::ifstream& BinaryFileIArchive::file()
    {  return *filePtr_; }
 
+   /*
+   * Read header tag and version, if present.
+   */
+   unsigned int BinaryFileIArchive::readHeader()
+   {
+      std::streampos begin = filePtr_->tellg();
+      char tag[8];
+      unpack(tag, 8);
+      bool hasHeader = filePtr_->good();
+      for (int i = 0; hasHeader && i < 8; ++i) {
+         if (tag[i] != HeaderTag[i]) {
+            hasHeader = false;
+         }
+      }
+      if (hasHeader) {
+         unpack(version_);
+      } else {
+         filePtr_->clear();
+         filePtr_->seekg(begin);
+         version_ = 0;
+      }
+      return version_;
+   }
+
    /*
    * Load a std::string from BinaryFileIArchive.
    */
@@ -67,6 +67,30 @@ namespace Util
       */
       std::ifstream& file();
 
+      /**
+      * Read an optional file header, and set the archive version.
+      *
+      * If the file begins with a header written by 
+      * BinaryFileOArchive::writeHeader(), this reads the header and 
+      * sets the version to the value stored in it. Otherwise, the
+      * read position is left unchanged and the version is set to 0.
+      *
+      * \return archive version
+      */
+      unsigned int readHeader();
+
+      /**
+      * Get the archive version.
+      */
+      unsigned int version() const;
+
+      /**
+      * Set the archive version.
+      *
+      * \param version archive version
+      */
+      void setVersion(unsigned int version);
+
       /**
       * Read one object.
       */
@@ -131,6 +155,12 @@ namespace Util
    inline bool BinaryFileIArchive::is_loading()
    {  return true; }
 
+   inline unsigned int BinaryFileIArchive::version() const
+   {  return version_; }
+
+   inline void BinaryFileIArchive::setVersion(unsigned int version)
+   {  version_ = version; }
+
    // Inline non-static method templates
 
    /*
@@ -10,6 +10,11 @@
 namespace Util
 {
 
+   /*
+   * Tag at the beginning of a file header (see BinaryFileIArchive.cpp).
+   */
+   static const char HeaderTag[8] = {'S','P','C','_','A','R','C','H'};
+
    /*
    * Constructor.
    */
@@ -53,4 +58,14 @@ namespace Util
    std::ofstream& BinaryFileOArchive::file()
    {  return *filePtr_; }
 
+   /*
+   * Write header tag and version.
+   */
+   void BinaryFileOArchive::writeHeader(unsigned int version)
+   {
+      pack(HeaderTag, 8);
+      pack(version);
+      version_ = version;
+   }
+
 }
@@ -67,6 +67,22 @@ namespace Util
       */
       std::ofstream& file();
 
+      /**
+      * Write a file header, and set the archive version.
+      *
+      * The header contains a fixed tag followed by the version, and 
+      * may be read by BinaryFileIArchive::readHeader(). It should be
+      * written at the beginning of a file.
+      *
+      * \param version archive version
+      */
+      void writeHeader(unsigned int version);
+
+      /**
+      * Get the archive version.
+      */
+      unsigned int version() const;
+
       /**
       * Save one object.
       */
@@ -129,6 +145,9 @@ namespace Util
    inline bool BinaryFileOArchive::is_loading()
    {  return false; }
 
+   inline unsigned int BinaryFileOArchive::version() const
+   {  return version_; }
+
    // Inline non-static methods
 
    /*
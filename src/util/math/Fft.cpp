@@ -0,0 +1,159 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "Fft.h"
+#include <util/math/Constants.h>
+
+#include <cmath>
+
+namespace Util
+{
+
+   /*
+   * Constructor.
+   */
+   Fft::Fft()
+    : line_(),
+      work_(),
+      butterfly_(),
+      dimensions_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   Fft::~Fft()
+   {}
+
+   /*
+   * Set grid dimensions, and compute twiddle factors.
+   */
+   void Fft::setDimensions(const IntVector& dimensions)
+   {
+      int i, k, n;
+      int maxN = 0;
+      for (i = 0; i < Dimension; ++i) {
+         if (dimensions[i] <= 0) {
+            UTIL_THROW("Fft dimensions must be positive");
+         }
+         if (dimensions[i] > maxN) {
+            maxN = dimensions[i];
+         }
+      }
+      dimensions_ = dimensions;
+
+      double angle;
+      for (i = 0; i < Dimension; ++i) {
+         n = dimensions_[i];
+         if (twiddles_[i].isAllocated()) {
+            twiddles_[i].deallocate();
+         }
+         twiddles_[i].allocate(n);
+         for (k = 0; k < n; ++k) {
+            angle = 2.0*Constants::Pi*double(k)/double(n);
+            twiddles_[i][k] = std::complex<double>(cos(angle), sin(angle));
+         }
+      }
+      if (line_.isAllocated()) {
+         line_.deallocate();
+         work_.deallocate();
+         butterfly_.deallocate();
+      }
+      line_.allocate(maxN);
+      work_.allocate(maxN);
+      butterfly_.allocate(maxN);
+   }
+
+   /*
+   * Transform data in place, one axis at a time.
+   */
+   void Fft::transform(std::complex<double>* data)
+   {
+      int stride[Dimension];
+      stride[Dimension - 1] = 1;
+      int i, j, k;
+      for (i = Dimension - 1; i > 0; --i) {
+         stride[i - 1] = stride[i]*dimensions_[i];
+      }
+      int size = stride[0]*dimensions_[0];
+
+      int n, s, begin, nLine;
+      std::complex<double>* first;
+      for (i = 0; i < Dimension; ++i) {
+         n = dimensions_[i];
+         if (n == 1) continue;
+         s = stride[i];
+
+         // Each line along axis i begins at a point with x_i = 0
+         nLine = size/n;
+         for (j = 0; j < nLine; ++j) {
+            begin = (j/s)*s*n + j%s;
+            first = data + begin;
+            for (k = 0; k < n; ++k) {
+               line_[k] = first[k*s];
+            }
+            transform(&line_[0], 1, &work_[0], n, 1, &twiddles_[i][0], n);
+            for (k = 0; k < n; ++k) {
+               first[k*s] = work_[k];
+            }
+         }
+      }
+   }
+
+   /*
+   * Recursive transform (private).
+   */
+   void Fft::transform(const std::complex<double>* in, int stride,
+                       std::complex<double>* out, int n, int twStride,
+                       const std::complex<double>* twiddles, int N)
+   {
+      if (n == 1) {
+         out[0] = in[0];
+         return;
+      }
+
+      // Find smallest prime factor p of n
+      int p = 2;
+      while (n % p != 0) {
+         if (p*p > n) {
+            p = n;
+            break;
+         }
+         ++p;
+      }
+      int m = n/p;
+
+      // Transform the p decimated subsequences of length m
+      int r;
+      for (r = 0; r < p; ++r) {
+         transform(in + r*stride, stride*p, out + r*m, m, twStride*p,
+                   twiddles, N);
+      }
+
+      // Radix-p butterflies. For each k, the inputs out[k + r*m] and
+      // outputs out[k + q*m] occupy the same elements.
+      int k, q, j;
+      std::complex<double> sum;
+      for (k = 0; k < m; ++k) {
+         for (r = 0; r < p; ++r) {
+            butterfly_[r] = out[k + r*m];
+            if (r > 0 && k > 0) {
+               butterfly_[r] *= twiddles[(r*k*twStride) % N];
+            }
+         }
+         for (q = 0; q < p; ++q) {
+            sum = butterfly_[0];
+            for (r = 1; r < p; ++r) {
+               j = (int)((long(r)*long(q*m)*long(twStride)) % long(N));
+               sum += butterfly_[r]*twiddles[j];
+            }
+            out[k + q*m] = sum;
+         }
+      }
+   }
+
+}
@@ -0,0 +1,118 @@
+#ifndef UTIL_FFT_H
+#define UTIL_FFT_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/containers/DArray.h>
+#include <util/space/IntVector.h>
+#include <util/space/Dimension.h>
+#include <util/global.h>
+
+#include <complex>
+
+namespace Util
+{
+
+   /**
+   * Fast Fourier transform of complex data on a 3D periodic grid.
+   *
+   * This class computes the discrete Fourier transform
+   * \f[
+   *     F(m) = \sum_{x} f(x) \exp( 2 \pi i \sum_{j} m_j x_j / n_j )
+   * \f]
+   * in place, where \f$n_j\f$ is the grid dimension along axis j. Grid
+   * points are ordered as in a C array, with the last index most rapidly
+   * varying, consistent with Util::Grid. The sign of the exponent is
+   * chosen to match the definition of Fourier amplitudes used by the
+   * structure factor analyzers.
+   *
+   * Each one-dimensional transform uses a recursive mixed-radix
+   * Cooley-Tukey algorithm. Dimensions that are products of small primes
+   * are most efficient. A prime dimension p requires O(p^2) operations.
+   *
+   * \ingroup Math_Module
+   */
+   class Fft
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      Fft();
+
+      /**
+      * Destructor.
+      */
+      ~Fft();
+
+      /**
+      * Set grid dimensions, and allocate and compute twiddle factors.
+      *
+      * \param dimensions  number of grid points along each axis
+      */
+      void setDimensions(const IntVector& dimensions);
+
+      /**
+      * Transform data in place.
+      *
+      * \param data  array of dimensions[0]*dimensions[1]*dimensions[2]
+      *              complex values, ordered with the last index fastest
+      */
+      void transform(std::complex<double>* data);
+
+      /**
+      * Get the grid dimensions.
+      */
+      const IntVector& dimensions() const;
+
+   private:
+
+      /// Twiddle factors exp(2 pi i k/n) for each axis.
+      DArray< std::complex<double> > twiddles_[Dimension];
+
+      /// Copy of one grid line (input of a one-dimensional transform).
+      DArray< std::complex<double> > line_;
+
+      /// Transformed grid line.
+      DArray< std::complex<double> > work_;
+
+      /// Workspace for the butterflies of one radix.
+      DArray< std::complex<double> > butterfly_;
+
+      /// Number of grid points along each axis.
+      IntVector dimensions_;
+
+      /**
+      * Recursive out-of-place transform of a strided subsequence.
+      *
+      * \param in  first input element
+      * \param stride  stride between input elements
+      * \param out  output array (contiguous, n elements)
+      * \param n  length of this subsequence
+      * \param twStride  stride in twiddle table, equal to N/n
+      * \param twiddles  twiddle factors for full length N
+      * \param N  full length of line
+      */
+      void transform(const std::complex<double>* in, int stride,
+                     std::complex<double>* out, int n, int twStride,
+                     const std::complex<double>* twiddles, int N);
+
+   };
+
+   // Inline member function
+
+   /*
+   * Get the grid dimensions.
+   */
+   inline const IntVector& Fft::dimensions() const
+   {  return dimensions_; }
+
+}
+#endif
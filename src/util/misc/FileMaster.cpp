@@ -256,14 +256,19 @@ namespace Util
    void 
    FileMaster::openRestartOFile(const std::string& name, std::ofstream& out,
                                 std::ios_base::openmode mode) const
+   {  open(restartOFileName(name), out, mode); }
+
+   /*
+   * Get the path to an output restart file.
+   */
+   std::string FileMaster::restartOFileName(const std::string& name) const
    {
-      // Construct filename = outputPrefix_ + name
       std::string filename(rootPrefix_);
       if (hasDirectoryId_) {
-         filename = directoryIdPrefix_;
+         filename += directoryIdPrefix_;
       }
       filename += name;
-      open(filename, out, mode);
+      return filename;
    }
 
    /*
@@ -290,16 +295,20 @@ namespace Util
    FileMaster::openOutputFile(const std::string& name, 
                               std::ofstream& out, 
                               std::ios_base::openmode mode) const
+   {  open(outputFileName(name), out, mode); }
+
+   /*
+   * Get the path to an output data file.
+   */
+   std::string FileMaster::outputFileName(const std::string& name) const
    {
-      // Construct path
       std::string filename(rootPrefix_);
       if (hasDirectoryId_) {
          filename += directoryIdPrefix_;
       }
       filename += outputPrefix_;
       filename += name;
-
-      open(filename, out, mode);
+      return filename;
    }
 
    /*
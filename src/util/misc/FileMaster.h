@@ -322,6 +322,16 @@ namespace Util
                        std::ios_base::openmode mode = std::ios_base::out) 
       const;
 
+      /**
+      * Get the path to an output restart file.
+      *
+      * Returns the path used by openRestartOFile, constructed by
+      * concatenating: [rootPrefix] + [directoryIdPrefix] + name 
+      *
+      * \param name base file name
+      */
+      std::string restartOFileName(const std::string& name) const;
+
       /**
       * Open an input file.
       *
@@ -352,6 +362,18 @@ namespace Util
                      std::ios_base::openmode mode = std::ios_base::out) 
       const;
 
+      /**
+      * Get the path to an output file.
+      *
+      * Returns the path used by openOutputFile, constructed by
+      * concatenating: [rootPrefix] + [directoryIdPrefix] + outputPrefix
+      * + filename. This may be used to open a file by other means, such
+      * as MPI-IO.
+      *
+      * \param filename  file name, without any prefix
+      */
+      std::string outputFileName(const std::string& filename) const;
+
       //@}
       /// \name Control Files
       //@{
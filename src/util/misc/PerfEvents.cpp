@@ -0,0 +1,152 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "PerfEvents.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace Util
+{
+
+   #ifdef __linux__
+   namespace 
+   {
+
+      /*
+      * Open one user space hardware counter for the calling thread.
+      */
+      int openCounter(unsigned long long config, int groupFd)
+      {
+         struct perf_event_attr attr;
+         std::memset(&attr, 0, sizeof(attr));
+         attr.size = sizeof(attr);
+         attr.type = PERF_TYPE_HARDWARE;
+         attr.config = config;
+         attr.disabled = (groupFd < 0) ? 1 : 0;
+         attr.exclude_kernel = 1;
+         attr.exclude_hv = 1;
+         attr.read_format = PERF_FORMAT_GROUP;
+         return (int) syscall(__NR_perf_event_open, &attr, 0, -1, 
+                              groupFd, 0);
+      }
+
+   }
+   #endif
+
+   /*
+   * Constructor.
+   */
+   PerfEvents::PerfEvents()
+    : fd_(-1)
+   {
+      for (int i = 0; i < NEvent; ++i) {
+         memberFds_[i] = -1;
+      }
+   }
+
+   /*
+   * Destructor.
+   */
+   PerfEvents::~PerfEvents()
+   {  close(); }
+
+   /*
+   * Open and start counters, if available.
+   */
+   bool PerfEvents::open()
+   {
+      if (isOpen()) return true;
+      #ifdef __linux__
+      unsigned long long configs[NEvent];
+      configs[Cycles] = PERF_COUNT_HW_CPU_CYCLES;
+      configs[CacheMisses] = PERF_COUNT_HW_CACHE_MISSES;
+      configs[BranchMisses] = PERF_COUNT_HW_BRANCH_MISSES;
+
+      // The cycle counter leads the group, and is also stored in
+      // memberFds_[Cycles], so that close() may treat all alike.
+      fd_ = openCounter(configs[Cycles], -1);
+      if (fd_ < 0) {
+         return false;
+      }
+      memberFds_[Cycles] = fd_;
+      for (int i = 1; i < NEvent; ++i) {
+         memberFds_[i] = openCounter(configs[i], fd_);
+         if (memberFds_[i] < 0) {
+            close();
+            return false;
+         }
+      }
+      ioctl(fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+      return true;
+      #else
+      return false;
+      #endif
+   }
+
+   /*
+   * Close counters.
+   */
+   void PerfEvents::close()
+   {
+      #ifdef __linux__
+      for (int i = NEvent - 1; i >= 0; --i) {
+         if (memberFds_[i] >= 0) {
+            ::close(memberFds_[i]);
+            memberFds_[i] = -1;
+         }
+      }
+      #endif
+      fd_ = -1;
+   }
+
+   /*
+   * Read current values of all counters.
+   */
+   void PerfEvents::read(double* values) const
+   {
+      #ifdef __linux__
+      if (isOpen()) {
+         // Group read format: number of events, then values in order.
+         unsigned long long buffer[NEvent + 1];
+         if (::read(fd_, buffer, sizeof(buffer)) == sizeof(buffer)) {
+            for (int i = 0; i < NEvent; ++i) {
+               values[i] = double(buffer[i + 1]);
+            }
+            return;
+         }
+      }
+      #endif
+      for (int i = 0; i < NEvent; ++i) {
+         values[i] = 0.0;
+      }
+   }
+
+   /*
+   * Return name of an event.
+   */
+   const char* PerfEvents::name(Event event)
+   {
+      switch (event) {
+      case Cycles:
+         return "cycles";
+      case CacheMisses:
+         return "cacheMisses";
+      case BranchMisses:
+         return "branchMisses";
+      default:
+         return "";
+      }
+   }
+
+}
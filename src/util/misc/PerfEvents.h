@@ -0,0 +1,112 @@
+#ifndef UTIL_PERF_EVENTS_H
+#define UTIL_PERF_EVENTS_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/global.h>
+
+namespace Util
+{
+
+   /**
+   * Hardware performance counters for the calling thread.
+   *
+   * A PerfEvents object opens a group of Linux perf_event counters for 
+   * CPU cycles, cache misses and branch misses, which count events in
+   * user space for the thread that called open(). All counters in the
+   * group are read together by a single system call.
+   *
+   * Counters are opened without the perf_event inherit flag, so work 
+   * done by other threads, such as the OpenMP worker threads of a
+   * parallel region, is not counted. Inheritance would not help here:
+   * it applies only to threads created after open(), whereas OpenMP 
+   * implementations normally create a pool of threads once and reuse 
+   * it, and many kernels do not allow inherited counters to be read 
+   * as a group. Wall clock time should be used to measure the cost of 
+   * multi-threaded code.
+   *
+   * Hardware counters are not available on other operating systems, or
+   * if access is denied by the kernel (e.g., by the setting of 
+   * /proc/sys/kernel/perf_event_paranoid, or within some containers).
+   * In this case, open() returns false, and read() returns zeros.
+   *
+   * \ingroup Misc_Module
+   */
+   class PerfEvents
+   {
+
+   public:
+
+      /**
+      * Identifiers for events.
+      */
+      enum Event {Cycles, CacheMisses, BranchMisses, NEvent};
+
+      /**
+      * Constructor.
+      */
+      PerfEvents();
+
+      /**
+      * Destructor.
+      *
+      * Closes counters, if open.
+      */
+      ~PerfEvents();
+
+      /**
+      * Open and start counters, if available.
+      *
+      * \return true if the counters are available, false otherwise.
+      */
+      bool open();
+
+      /**
+      * Close counters.
+      */
+      void close();
+
+      /**
+      * Read current values of all counters.
+      *
+      * \param values array of NEvent counter values (output)
+      */
+      void read(double* values) const;
+
+      /**
+      * Are the counters open?
+      */
+      bool isOpen() const;
+
+      /**
+      * Return name of an event.
+      *
+      * \param event event identifier
+      */
+      static const char* name(Event event);
+
+   private:
+
+      /// File descriptor of group leader (cycles), or -1.
+      int fd_;
+
+      /// File descriptors of other members of the group, or -1.
+      int memberFds_[NEvent];
+
+   };
+
+   // Inline function
+
+   /*
+   * Are the counters open?
+   */
+   inline bool PerfEvents::isOpen() const
+   {  return (fd_ >= 0); }
+
+}
+#endif
@@ -0,0 +1,255 @@
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include "ParticleMesh.h"
+#include <util/math/Constants.h>
+
+#include <cmath>
+
+namespace Util
+{
+
+   /*
+   * Constructor.
+   */
+   ParticleMesh::ParticleMesh()
+    : data_(),
+      fft_(),
+      grid_(),
+      order_(0),
+      nField_(0),
+      nGrid_(0)
+   {}
+
+   /*
+   * Destructor.
+   */
+   ParticleMesh::~ParticleMesh()
+   {}
+
+   /*
+   * Set grid dimensions, assignment order and number of fields.
+   */
+   void ParticleMesh::setParam(const IntVector& dimensions, int order,
+                               int nField)
+   {
+      if (order < 1 || order > 4) {
+         UTIL_THROW("Assignment order must be 1, 2, 3 or 4");
+      }
+      if (nField < 1) {
+         UTIL_THROW("nField must be positive");
+      }
+      grid_.setDimensions(dimensions);
+      fft_.setDimensions(dimensions);
+      order_ = order;
+      nField_ = nField;
+      nGrid_ = (nField + 1)/2;
+
+      if (data_.isAllocated()) {
+         data_.deallocate();
+      }
+      data_.allocate(nGrid_*grid_.size());
+
+      // Deconvolution factors 1/[sin(x)/x]^order, with x = pi*m/n
+      int i, k, m, n, j;
+      double x, w;
+      for (i = 0; i < Dimension; ++i) {
+         n = dimensions[i];
+         if (deconvolution_[i].isAllocated()) {
+            deconvolution_[i].deallocate();
+         }
+         deconvolution_[i].allocate(n);
+         for (k = 0; k < n; ++k) {
+            m = (2*k < n) ? k : k - n;
+            if (m == 0) {
+               w = 1.0;
+            } else {
+               x = Constants::Pi*double(m)/double(n);
+               w = sin(x)/x;
+            }
+            x = 1.0;
+            for (j = 0; j < order_; ++j) {
+               x *= w;
+            }
+            deconvolution_[i][k] = 1.0/x;
+         }
+      }
+      clear();
+   }
+
+   /*
+   * Set all grids to zero.
+   */
+   void ParticleMesh::clear()
+   {
+      int size = data_.capacity();
+      for (int i = 0; i < size; ++i) {
+         data_[i] = std::complex<double>(0.0, 0.0);
+      }
+   }
+
+   /*
+   * Add a weighted particle to one field.
+   */
+   void ParticleMesh::spread(const Vector& position, int fieldId,
+                             double weight)
+   {
+      assert(fieldId >= 0 && fieldId < nField_);
+
+      // Find first grid point and weights along each axis
+      int first[Dimension];
+      double weights[Dimension][4];
+      double u, d;
+      int i, n;
+      for (i = 0; i < Dimension; ++i) {
+         n = grid_.dimension(i);
+         u = position[i]*double(n);
+         switch (order_) {
+         case 1:
+            first[i] = int(floor(u + 0.5));
+            weights[i][0] = 1.0;
+            break;
+         case 2:
+            first[i] = int(floor(u));
+            d = u - double(first[i]);
+            weights[i][0] = 1.0 - d;
+            weights[i][1] = d;
+            break;
+         case 3:
+            first[i] = int(floor(u + 0.5));
+            d = u - double(first[i]);
+            weights[i][0] = 0.5*(0.5 - d)*(0.5 - d);
+            weights[i][1] = 0.75 - d*d;
+            weights[i][2] = 0.5*(0.5 + d)*(0.5 + d);
+            first[i] -= 1;
+            break;
+         default:
+            first[i] = int(floor(u));
+            d = u - double(first[i]);
+            weights[i][0] = (1.0 - d)*(1.0 - d)*(1.0 - d)/6.0;
+            weights[i][1] = (4.0 - 6.0*d*d + 3.0*d*d*d)/6.0;
+            weights[i][2] = (1.0 + 3.0*d + 3.0*d*d - 3.0*d*d*d)/6.0;
+            weights[i][3] = d*d*d/6.0;
+            first[i] -= 1;
+         }
+         first[i] = first[i] % n;
+         if (first[i] < 0) {
+            first[i] += n;
+         }
+      }
+
+      // Add weights to the real or imaginary part of the packed grid
+      std::complex<double>* grid = &data_[(fieldId/2)*grid_.size()];
+      bool isReal = (fieldId % 2 == 0);
+      int n1 = grid_.dimension(1);
+      int n2 = grid_.dimension(2);
+      int i0, i1, i2, j0, j1, j2;
+      double w0, w01, w;
+      j0 = first[0];
+      for (i0 = 0; i0 < order_; ++i0) {
+         w0 = weight*weights[0][i0];
+         j1 = first[1];
+         for (i1 = 0; i1 < order_; ++i1) {
+            w01 = w0*weights[1][i1];
+            j2 = first[2];
+            for (i2 = 0; i2 < order_; ++i2) {
+               w = w01*weights[2][i2];
+               if (isReal) {
+                  grid[(j0*n1 + j1)*n2 + j2] += std::complex<double>(w, 0.0);
+               } else {
+                  grid[(j0*n1 + j1)*n2 + j2] += std::complex<double>(0.0, w);
+               }
+               if (++j2 == n2) j2 = 0;
+            }
+            if (++j1 == n1) j1 = 0;
+         }
+         if (++j0 == grid_.dimension(0)) j0 = 0;
+      }
+   }
+
+   #ifdef UTIL_MPI
+   /*
+   * Add grids from all processors, on the root processor.
+   */
+   void ParticleMesh::reduce(MPI::Intracomm& communicator, int root)
+   {
+      int size = data_.capacity();
+      DArray< std::complex<double> > total;
+      total.allocate(size);
+      communicator.Reduce(&data_[0], &total[0], 2*size, MPI::DOUBLE,
+                          MPI::SUM, root);
+      if (communicator.Get_rank() == root) {
+         for (int i = 0; i < size; ++i) {
+            data_[i] = total[i];
+         }
+      }
+   }
+   #endif
+
+   /*
+   * Fourier transform all grids.
+   */
+   void ParticleMesh::transform()
+   {
+      int size = grid_.size();
+      for (int i = 0; i < nGrid_; ++i) {
+         fft_.transform(&data_[i*size]);
+      }
+   }
+
+   /*
+   * Get a deconvolved Fourier amplitude of one field.
+   */
+   std::complex<double>
+   ParticleMesh::amplitude(int fieldId, const IntVector& waveIntVector)
+   const
+   {
+      assert(fieldId >= 0 && fieldId < nField_);
+      assert(isValidWave(waveIntVector));
+
+      // Grid points for m and -m, and deconvolution factor
+      IntVector plus, minus;
+      double factor = 1.0;
+      int i, n;
+      for (i = 0; i < Dimension; ++i) {
+         n = grid_.dimension(i);
+         plus[i] = waveIntVector[i];
+         if (plus[i] < 0) plus[i] += n;
+         minus[i] = plus[i] == 0 ? 0 : n - plus[i];
+         factor *= deconvolution_[i][plus[i]];
+      }
+
+      // Separate the two real fields packed in one complex grid.
+      // For F = A + iB, A(m) = [F(m) + F*(-m)]/2, B(m) = [F(m) - F*(-m)]/2i.
+      const std::complex<double>* grid = &data_[(fieldId/2)*grid_.size()];
+      std::complex<double> f = grid[grid_.rank(plus)];
+      std::complex<double> g = std::conj(grid[grid_.rank(minus)]);
+      std::complex<double> value;
+      if (fieldId % 2 == 0) {
+         value = 0.5*(f + g);
+      } else {
+         value = (f - g)/(2.0*Constants::Im);
+      }
+      return factor*value;
+   }
+
+   /*
+   * Is a wavevector resolved by this mesh?
+   */
+   bool ParticleMesh::isValidWave(const IntVector& waveIntVector) const
+   {
+      int i, m;
+      for (i = 0; i < Dimension; ++i) {
+         m = waveIntVector[i] < 0 ? -waveIntVector[i] : waveIntVector[i];
+         if (2*m >= grid_.dimension(i)) {
+            return false;
+         }
+      }
+      return true;
+   }
+
+}
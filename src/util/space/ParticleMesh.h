@@ -0,0 +1,195 @@
+#ifndef UTIL_PARTICLE_MESH_H
+#define UTIL_PARTICLE_MESH_H
+
+/*
+* Simpatico - Simulation Package for Polymeric and Molecular Liquids
+*
+* Copyright 2010 - 2014, The Regents of the University of Minnesota
+* Distributed under the terms of the GNU General Public License.
+*/
+
+#include <util/space/Grid.h>          // member
+#include <util/space/IntVector.h>     // member
+#include <util/space/Vector.h>        // argument
+#include <util/space/Dimension.h>
+#include <util/math/Fft.h>            // member
+#include <util/containers/DArray.h>   // member template
+#include <util/global.h>
+
+#include <complex>
+
+namespace Util
+{
+
+   /**
+   * Fourier amplitudes of particle densities, computed on a mesh.
+   *
+   * A ParticleMesh estimates Fourier amplitudes
+   * \f[
+   *     \rho_{f}(m) = \sum_{i} w_i \exp( 2 \pi i m \cdot s_i )
+   * \f]
+   * for one or more fields f, in which \f$s_i\f$ is the position of
+   * particle i in generalized coordinates (in the range [0,1) along each
+   * axis), \f$w_i\f$ is a weight, and m is an IntVector of Miller indices.
+   * Each particle is assigned to the grid points near its position using
+   * a B-spline assignment function of order 1 (nearest grid point), 2
+   * (cloud in cell), 3 (triangular shaped cloud) or 4. Each grid is then
+   * transformed with an Fft, and each amplitude is divided by the Fourier
+   * transform of the assignment function to correct for the smoothing
+   * introduced by assignment. The remaining error, caused by aliasing,
+   * decreases rapidly with increasing order and with decreasing ratio of
+   * |m_j| to the grid dimension n_j.
+   *
+   * Two real fields are packed into each complex grid, and separated after
+   * the transform. Amplitudes are available for all wavevectors with
+   * 2|m_j| < n_j for all j.
+   *
+   * Usage:
+   * \code
+   *    ParticleMesh mesh;
+   *    mesh.setParam(dimensions, order, nField);
+   *    mesh.clear();
+   *    for (each particle) {
+   *       mesh.spread(position, fieldId);
+   *    }
+   *    mesh.transform();
+   *    std::complex<double> rho = mesh.amplitude(fieldId, waveIntVector);
+   * \endcode
+   *
+   * \ingroup Space_Module
+   */
+   class ParticleMesh
+   {
+
+   public:
+
+      /**
+      * Constructor.
+      */
+      ParticleMesh();
+
+      /**
+      * Destructor.
+      */
+      ~ParticleMesh();
+
+      /**
+      * Set grid dimensions, assignment order and number of fields.
+      *
+      * Allocates grids and computes deconvolution factors.
+      *
+      * \param dimensions  number of grid points along each axis
+      * \param order  order of assignment function (1 <= order <= 4)
+      * \param nField  number of fields (e.g., number of atom types)
+      */
+      void setParam(const IntVector& dimensions, int order, int nField);
+
+      /**
+      * Set all grids to zero.
+      */
+      void clear();
+
+      /**
+      * Add a weighted particle to one field.
+      *
+      * \param position  position in generalized coordinates
+      * \param fieldId  index of field, 0 <= fieldId < nField
+      * \param weight  weight of particle
+      */
+      void spread(const Vector& position, int fieldId, double weight = 1.0);
+
+      #ifdef UTIL_MPI
+      /**
+      * Add grids from all processors, on the root processor.
+      *
+      * \param communicator MPI communicator
+      * \param root rank of MPI root processor for reduction
+      */
+      void reduce(MPI::Intracomm& communicator, int root);
+      #endif
+
+      /**
+      * Fourier transform all grids.
+      */
+      void transform();
+
+      /**
+      * Get a deconvolved Fourier amplitude of one field.
+      *
+      * Must be called after transform().
+      *
+      * \param fieldId  index of field
+      * \param waveIntVector  Miller indices, with 2|m_j| < n_j
+      */
+      std::complex<double>
+      amplitude(int fieldId, const IntVector& waveIntVector) const;
+
+      /**
+      * Is a wavevector resolved by this mesh (2|m_j| < n_j for all j)?
+      *
+      * \param waveIntVector  Miller indices of wavevector
+      */
+      bool isValidWave(const IntVector& waveIntVector) const;
+
+      /**
+      * Get the grid dimensions.
+      */
+      const IntVector& dimensions() const;
+
+      /**
+      * Get the order of the assignment function.
+      */
+      int order() const;
+
+      /**
+      * Get the number of fields.
+      */
+      int nField() const;
+
+   private:
+
+      /// Packed complex grids, nGrid blocks of grid_.size() values.
+      DArray< std::complex<double> > data_;
+
+      /// Inverse Fourier transform of assignment function, for each axis.
+      DArray<double> deconvolution_[Dimension];
+
+      /// Fast Fourier transform.
+      Fft fft_;
+
+      /// Grid (dimensions and ranks).
+      Grid grid_;
+
+      /// Order of assignment function.
+      int order_;
+
+      /// Number of real fields.
+      int nField_;
+
+      /// Number of complex grids, equal to (nField + 1)/2.
+      int nGrid_;
+
+   };
+
+   // Inline member functions
+
+   /*
+   * Get the grid dimensions.
+   */
+   inline const IntVector& ParticleMesh::dimensions() const
+   {  return fft_.dimensions(); }
+
+   /*
+   * Get the order of the assignment function.
+   */
+   inline int ParticleMesh::order() const
+   {  return order_; }
+
+   /*
+   * Get the number of fields.
+   */
+   inline int ParticleMesh::nField() const
+   {  return nField_; }
+
+}
+#endif
@@ -1,7 +1,7 @@
 
 util_space_=util/space/Grid.cpp \
     util/space/IntVector.cpp util/space/Tensor.cpp \
-    util/space/Vector.cpp 
+    util/space/Vector.cpp util/space/ParticleMesh.cpp 
 
 util_space_SRCS=\
      $(addprefix $(SRC_DIR)/, $(util_space_))
@@ -4,6 +4,7 @@
 #include "AverageTest.h"
 #include "AutoCorrTest.h"
 #include "AutoCorrArrayTest.h"
+#include "MultiTauArrayTest.h"
 
 #include <test/CompositeTestRunner.h>
 
@@ -11,6 +12,7 @@ TEST_COMPOSITE_BEGIN(AccumulatorTestComposite)
 TEST_COMPOSITE_ADD_UNIT(AverageTest)
 TEST_COMPOSITE_ADD_UNIT(AutoCorrTest)
 TEST_COMPOSITE_ADD_UNIT(AutoCorrArrayTest)
+TEST_COMPOSITE_ADD_UNIT(MultiTauArrayTest)
 TEST_COMPOSITE_END
 
 #endif
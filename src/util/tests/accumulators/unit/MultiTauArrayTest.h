@@ -0,0 +1,216 @@
+#ifndef MULTI_TAU_ARRAY_TEST_H
+#define MULTI_TAU_ARRAY_TEST_H
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <util/accumulators/MultiTauArray.h>
+#include <util/accumulators/fftAutoCorr.h>
+#include <util/containers/DArray.h>
+#include <util/space/Vector.h>
+#include <util/random/Random.h>
+#include <util/archives/MemoryOArchive.h>
+#include <util/archives/MemoryIArchive.h>
+#include <util/archives/MemoryCounter.h>
+
+#include <iostream>
+#include <fstream>
+#include <cmath>
+
+using namespace Util;
+
+class MultiTauArrayTest : public UnitTest
+{
+
+   MultiTauArray<Vector, double> accumulator_;
+
+   // Random walk trajectories, with values_[i*nEnsemble_ + s] = x_s(i)
+   DArray<Vector> values_;
+
+   int nEnsemble_;
+   int nSample_;
+
+public:
+
+   void setUp() 
+   { 
+      std::ifstream paramFile;
+      openInputFile("in/MultiTauArray", paramFile); 
+      accumulator_.readParam(paramFile);
+      paramFile.close();
+
+      nEnsemble_ = accumulator_.nEnsemble();
+      nSample_ = 300;
+      values_.allocate(nSample_*nEnsemble_);
+      Random random;
+      random.setSeed(7283);
+      int i, s, k;
+      for (s = 0; s < nEnsemble_; ++s) {
+         values_[s] = Vector::Zero;
+      }
+      for (i = 1; i < nSample_; ++i) {
+         for (s = 0; s < nEnsemble_; ++s) {
+            values_[i*nEnsemble_ + s] = values_[(i-1)*nEnsemble_ + s];
+            for (k = 0; k < Dimension; ++k) {
+               values_[i*nEnsemble_ + s][k] += random.uniform(-0.5, 0.5);
+            }
+         }
+      }
+   }
+
+   void tearDown() 
+   {}
+
+   // Sample the first n values of all sequences
+   void sample(MultiTauArray<Vector, double>& accumulator, int n)
+   {
+      DArray<Vector> data;
+      data.allocate(nEnsemble_);
+      int i, s;
+      for (i = 0; i < n; ++i) {
+         for (s = 0; s < nEnsemble_; ++s) {
+            data[s] = values_[i*nEnsemble_ + s];
+         }
+         accumulator.sample(data);
+      }
+   }
+
+   // Direct average over pairs of samples i, i + t with i a multiple
+   // of interval, for all i + t < n.
+   double direct(int t, long interval, int n, bool isMeanSqDisp)
+   {
+      double sum = 0.0;
+      long count = 0;
+      Vector diff;
+      int i, s;
+      for (i = 0; i + t < n; i += interval) {
+         for (s = 0; s < nEnsemble_; ++s) {
+            const Vector& a = values_[i*nEnsemble_ + s];
+            const Vector& b = values_[(i + t)*nEnsemble_ + s];
+            if (isMeanSqDisp) {
+               diff.subtract(b, a);
+               sum += diff.square();
+            } else {
+               sum += a.dot(b);
+            }
+         }
+         ++count;
+      }
+      return sum/double(count*nEnsemble_);
+   }
+
+   // Compare all accumulated delays to direct averages
+   bool compare(MultiTauArray<Vector, double>& accumulator, int n,
+                bool isMeanSqDisp)
+   {
+      int stageId, j, t;
+      long interval;
+      for (stageId = 0; stageId < accumulator.nStage(); ++stageId) {
+         interval = accumulator.stageInterval(stageId);
+         for (j = accumulator.firstDelay(stageId); 
+              j < accumulator.bufferCapacity(); ++j) {
+            if (accumulator.nCorr(stageId, j) > 0) {
+               t = j*interval;
+               if (std::abs(accumulator.value(stageId, j) 
+                   - direct(t, interval, n, isMeanSqDisp)) > 1.0E-8) {
+                  return false;
+               }
+            }
+         }
+      }
+      return true;
+   }
+
+   void testReadParam() 
+   {
+      printMethod(TEST_FUNC);
+      TEST_ASSERT(accumulator_.bufferCapacity() == 8);
+      TEST_ASSERT(accumulator_.blockFactor() == 2);
+      TEST_ASSERT(accumulator_.nEnsemble() == 5);
+   }
+
+   void testAutoCorr() 
+   {
+      printMethod(TEST_FUNC);
+      sample(accumulator_, nSample_);
+      TEST_ASSERT(accumulator_.nSample() == nSample_);
+      TEST_ASSERT(accumulator_.nStage() == 7);
+      TEST_ASSERT(compare(accumulator_, nSample_, false));
+   }
+
+   void testMeanSqDisp() 
+   {
+      printMethod(TEST_FUNC);
+      accumulator_.setMeanSqDisp(true);
+      sample(accumulator_, nSample_);
+      TEST_ASSERT(compare(accumulator_, nSample_, true));
+   }
+
+   void testSerialize() 
+   {
+      printMethod(TEST_FUNC);
+      accumulator_.setMeanSqDisp(true);
+      sample(accumulator_, 100);
+
+      int size = memorySize(accumulator_);
+      MemoryOArchive u;
+      u.allocate(size);
+      u << accumulator_;
+      TEST_ASSERT(u.cursor() == u.begin() + size);
+
+      MemoryIArchive v;
+      v = u;
+      MultiTauArray<Vector, double> clone;
+      v >> clone;
+      TEST_ASSERT(clone.nSample() == 100);
+      TEST_ASSERT(clone.nStage() == accumulator_.nStage());
+
+      // Continue sampling from the clone 
+      DArray<Vector> data;
+      data.allocate(nEnsemble_);
+      int i, s;
+      for (i = 100; i < nSample_; ++i) {
+         for (s = 0; s < nEnsemble_; ++s) {
+            data[s] = values_[i*nEnsemble_ + s];
+         }
+         clone.sample(data);
+      }
+      TEST_ASSERT(compare(clone, nSample_, true));
+   }
+
+   void testFftAutoCorr() 
+   {
+      printMethod(TEST_FUNC);
+
+      // Store each component of each sequence as a separate sequence
+      int nSequence = nEnsemble_*Dimension;
+      DArray<double> x;
+      x.allocate(nSequence*nSample_);
+      int i, s, k;
+      for (s = 0; s < nEnsemble_; ++s) {
+         for (k = 0; k < Dimension; ++k) {
+            for (i = 0; i < nSample_; ++i) {
+               x[(s*Dimension + k)*nSample_ + i] = values_[i*nEnsemble_ + s][k];
+            }
+         }
+      }
+      DArray<double> corr;
+      corr.allocate(40);
+      fftAutoCorr(x, nSequence, nSample_, corr);
+      for (i = 0; i < corr.capacity(); ++i) {
+         TEST_ASSERT(std::abs(Dimension*corr[i] 
+                     - direct(i, 1, nSample_, false)) < 1.0E-8);
+      }
+   }
+
+};
+
+TEST_BEGIN(MultiTauArrayTest)
+TEST_ADD(MultiTauArrayTest, testReadParam)
+TEST_ADD(MultiTauArrayTest, testAutoCorr)
+TEST_ADD(MultiTauArrayTest, testMeanSqDisp)
+TEST_ADD(MultiTauArrayTest, testSerialize)
+TEST_ADD(MultiTauArrayTest, testFftAutoCorr)
+TEST_END(MultiTauArrayTest)
+
+#endif
@@ -30,6 +30,7 @@ public:
    void testOArchiveConstructor1();
    void testOArchiveConstructor2();
    void testPack();
+   void testHeader();
 
 };
 
@@ -135,10 +136,61 @@ void BinaryFileArchiveTest::testPack()
    }
 }
 
+void BinaryFileArchiveTest::testHeader()
+{
+   printMethod(TEST_FUNC);
+   std::string s1("first string"), s2;
+   int i1 = 7, i2;
+
+   // File with header
+   {
+      BinaryFileOArchive v;
+      openOutputFile("binary", v.file());
+      v.writeHeader(3);
+      TEST_ASSERT(v.version() == 3);
+      v << s1;
+      v << i1;
+      v.file().close();
+   }
+   {
+      BinaryFileIArchive u;
+      openInputFile("binary", u.file());
+      TEST_ASSERT(u.readHeader() == 3);
+      TEST_ASSERT(u.version() == 3);
+      u >> s2;
+      u >> i2;
+      TEST_ASSERT(s1 == s2);
+      TEST_ASSERT(i1 == i2);
+   }
+
+   // File without header: read position must be unchanged
+   {
+      BinaryFileOArchive v;
+      openOutputFile("binary", v.file());
+      v << s1;
+      v << i1;
+      v.file().close();
+   }
+   {
+      BinaryFileIArchive u;
+      openInputFile("binary", u.file());
+      u.setVersion(5);
+      TEST_ASSERT(u.readHeader() == 0);
+      TEST_ASSERT(u.version() == 0);
+      s2 = "";
+      i2 = 0;
+      u >> s2;
+      u >> i2;
+      TEST_ASSERT(s1 == s2);
+      TEST_ASSERT(i1 == i2);
+   }
+}
+
 TEST_BEGIN(BinaryFileArchiveTest)
 TEST_ADD(BinaryFileArchiveTest, testOArchiveConstructor1)
 TEST_ADD(BinaryFileArchiveTest, testOArchiveConstructor2)
 TEST_ADD(BinaryFileArchiveTest, testPack)
+TEST_ADD(BinaryFileArchiveTest, testHeader)
 TEST_END(BinaryFileArchiveTest)
 
 #endif
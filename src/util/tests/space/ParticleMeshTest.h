@@ -0,0 +1,156 @@
+#ifndef PARTICLE_MESH_TEST_H
+#define PARTICLE_MESH_TEST_H
+
+#include <util/space/ParticleMesh.h>
+#include <util/space/Grid.h>
+#include <util/space/IntVector.h>
+#include <util/space/Vector.h>
+#include <util/math/Fft.h>
+#include <util/math/Constants.h>
+#include <util/containers/DArray.h>
+#include <util/random/Random.h>
+
+#include <test/UnitTest.h>
+#include <test/UnitTestRunner.h>
+
+#include <complex>
+
+using namespace Util;
+
+class ParticleMeshTest : public UnitTest
+{
+
+public:
+
+   void setUp()
+   {}
+
+   void tearDown()
+   {}
+
+   void testFft()
+   {
+      printMethod(TEST_FUNC);
+
+      // Dimensions include odd primes and a power of 2
+      IntVector dimensions;
+      dimensions[0] = 6;
+      dimensions[1] = 5;
+      dimensions[2] = 8;
+      Grid grid(dimensions);
+      int size = grid.size();
+
+      Random random;
+      random.setSeed(8347);
+      DArray< std::complex<double> > data;
+      DArray< std::complex<double> > copy;
+      data.allocate(size);
+      copy.allocate(size);
+      int i, j, k;
+      for (i = 0; i < size; ++i) {
+         data[i] = std::complex<double>(random.uniform(-1.0, 1.0),
+                                        random.uniform(-1.0, 1.0));
+         copy[i] = data[i];
+      }
+
+      Fft fft;
+      fft.setDimensions(dimensions);
+      fft.transform(&data[0]);
+
+      // Compare to a direct sum
+      IntVector m, x;
+      std::complex<double> sum;
+      double product;
+      for (i = 0; i < size; ++i) {
+         m = grid.position(i);
+         sum = std::complex<double>(0.0, 0.0);
+         for (j = 0; j < size; ++j) {
+            x = grid.position(j);
+            product = 0.0;
+            for (k = 0; k < Dimension; ++k) {
+               product += double(m[k]*x[k])/double(dimensions[k]);
+            }
+            product *= 2.0*Constants::Pi;
+            sum += copy[j]*exp(product*Constants::Im);
+         }
+         TEST_ASSERT(std::abs(sum - data[i]) < 1.0E-10);
+      }
+   }
+
+   void testAmplitude()
+   {
+      printMethod(TEST_FUNC);
+
+      IntVector dimensions;
+      dimensions[0] = 32;
+      dimensions[1] = 30;
+      dimensions[2] = 27;
+      int nField = 3;
+      int nParticle = 200;
+
+      // Random particles, in generalized coordinates
+      Random random;
+      random.setSeed(1934);
+      DArray<Vector> positions;
+      DArray<int> fieldIds;
+      positions.allocate(nParticle);
+      fieldIds.allocate(nParticle);
+      int i, j, k, order;
+      for (i = 0; i < nParticle; ++i) {
+         for (j = 0; j < Dimension; ++j) {
+            positions[i][j] = random.uniform(0.0, 1.0);
+         }
+         fieldIds[i] = random.uniformInt(0, nField);
+      }
+
+      // Check a few wavevectors, for each assignment order. The error is
+      // dominated by aliasing, and should decrease with increasing order.
+      IntVector waves[3];
+      waves[0] = IntVector(1, 0, 0);
+      waves[1] = IntVector(2, -1, 3);
+      waves[2] = IntVector(-3, 2, 1);
+      ParticleMesh mesh;
+      std::complex<double> exact, value;
+      double product, error;
+      double maxError[5];
+      for (order = 1; order <= 4; ++order) {
+         mesh.setParam(dimensions, order, nField);
+         for (i = 0; i < nParticle; ++i) {
+            mesh.spread(positions[i], fieldIds[i]);
+         }
+         mesh.transform();
+         maxError[order] = 0.0;
+         for (k = 0; k < 3; ++k) {
+            TEST_ASSERT(mesh.isValidWave(waves[k]));
+            for (j = 0; j < nField; ++j) {
+               exact = std::complex<double>(0.0, 0.0);
+               for (i = 0; i < nParticle; ++i) {
+                  if (fieldIds[i] == j) {
+                     product = 2.0*Constants::Pi*positions[i].dot(
+                               Vector(waves[k][0], waves[k][1], waves[k][2]));
+                     exact += exp(product*Constants::Im);
+                  }
+               }
+               value = mesh.amplitude(j, waves[k]);
+               error = std::abs(value - exact);
+               if (error > maxError[order]) {
+                  maxError[order] = error;
+               }
+            }
+         }
+      }
+      TEST_ASSERT(maxError[2] < maxError[1]);
+      TEST_ASSERT(maxError[3] < maxError[2]);
+      TEST_ASSERT(maxError[4] < maxError[3]);
+      TEST_ASSERT(maxError[4] < 1.0E-2);
+      TEST_ASSERT(!mesh.isValidWave(IntVector(16, 0, 0)));
+   }
+
+};
+
+TEST_BEGIN(ParticleMeshTest)
+TEST_ADD(ParticleMeshTest, testFft)
+TEST_ADD(ParticleMeshTest, testAmplitude)
+TEST_END(ParticleMeshTest)
+
+#endif
@@ -7,12 +7,14 @@
 #include "IntVectorTest.h"
 #include "TensorTest.h"
 #include "GridTest.h"
+#include "ParticleMeshTest.h"
 
 TEST_COMPOSITE_BEGIN(SpaceTestComposite)
 TEST_COMPOSITE_ADD_UNIT(VectorTest);
 TEST_COMPOSITE_ADD_UNIT(IntVectorTest);
 TEST_COMPOSITE_ADD_UNIT(TensorTest);
 TEST_COMPOSITE_ADD_UNIT(GridTest);
+TEST_COMPOSITE_ADD_UNIT(ParticleMeshTest);
 TEST_COMPOSITE_END
 
 #endif